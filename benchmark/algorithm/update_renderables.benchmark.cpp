@@ -0,0 +1,157 @@
+#include <benchmark/benchmark.h>
+
+#include <mbgl/algorithm/update_renderables.hpp>
+
+#include <memory>
+#include <unordered_map>
+
+using namespace mbgl;
+
+namespace {
+
+// A minimal stand-in for TilePyramid's data tile store. The algorithm's cost
+// is dominated by getTile lookups, so the benchmarks count them and report
+// the count per ideal tile alongside wall time.
+struct SyntheticTileData {
+    bool renderable = false;
+    bool triedOptional = false;
+
+    bool isRenderable() const {
+        return renderable;
+    }
+    bool hasTriedOptional() const {
+        return triedOptional;
+    }
+};
+
+struct SyntheticPyramid {
+    std::unordered_map<OverscaledTileID, std::unique_ptr<SyntheticTileData>> dataTiles;
+    std::vector<UnwrappedTileID> idealTiles;
+    uint64_t lookups = 0;
+
+    SyntheticTileData* addTile(const OverscaledTileID& tileID, bool renderable) {
+        auto& tile = dataTiles[tileID];
+        if (!tile) {
+            tile = std::make_unique<SyntheticTileData>();
+        }
+        tile->renderable = renderable;
+        return tile.get();
+    }
+
+    void run(uint8_t dataTileZoom) {
+        algorithm::updateRenderables(
+            [&](const auto& tileID) -> SyntheticTileData* {
+                lookups++;
+                auto it = dataTiles.find(tileID);
+                return it != dataTiles.end() ? it->second.get() : nullptr;
+            },
+            [&](const auto& tileID) { return addTile(tileID, false); },
+            [](auto&, Resource::Necessity) {},
+            [](const auto&, auto&) {},
+            idealTiles, { 0, 16 }, dataTileZoom);
+    }
+};
+
+// A width×width block of ideal tiles at the given zoom, anchored at the
+// origin so the block shares ancestors the way a real viewport does.
+SyntheticPyramid makePyramid(uint8_t zoom, uint32_t width) {
+    SyntheticPyramid pyramid;
+    for (uint32_t x = 0; x < width; ++x) {
+        for (uint32_t y = 0; y < width; ++y) {
+            pyramid.idealTiles.emplace_back(zoom, x, y);
+        }
+    }
+    return pyramid;
+}
+
+uint64_t random(uint64_t& seed) {
+    seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+    return seed >> 33;
+}
+
+void runScenario(benchmark::State& state, double completeness) {
+    const uint8_t zoom = 14;
+    const uint32_t width = state.range(0);
+    auto pyramid = makePyramid(zoom, width);
+
+    // Mark a pseudo-random subset of the ideal tiles renderable, plus their
+    // parents two levels up as the stale-cache fallback a deep-zoom
+    // animation would find.
+    uint64_t seed = 1;
+    for (const auto& idealTile : pyramid.idealTiles) {
+        if (double(random(seed) % 1024) < completeness * 1024) {
+            pyramid.addTile(OverscaledTileID(zoom, idealTile.canonical), true);
+        } else {
+            pyramid.addTile(OverscaledTileID(zoom - 2, idealTile.canonical.scaledTo(zoom - 2)),
+                            true);
+        }
+    }
+
+    uint64_t iterations = 0;
+    while (state.KeepRunning()) {
+        pyramid.run(zoom);
+        iterations++;
+    }
+
+    state.SetComplexityN(pyramid.idealTiles.size());
+    state.counters["lookups"] = pyramid.lookups / double(iterations);
+    state.counters["lookups/tile"] =
+        pyramid.lookups / double(iterations) / pyramid.idealTiles.size();
+}
+
+} // namespace
+
+static void UpdateRenderables_EmptyCache(benchmark::State& state) {
+    const uint8_t zoom = 14;
+    auto pyramid = makePyramid(zoom, state.range(0));
+
+    uint64_t iterations = 0;
+    while (state.KeepRunning()) {
+        // Created placeholder tiles change the lookup pattern of later
+        // frames; start every iteration cold.
+        pyramid.dataTiles.clear();
+        pyramid.run(zoom);
+        iterations++;
+    }
+
+    state.SetComplexityN(pyramid.idealTiles.size());
+    state.counters["lookups"] = pyramid.lookups / double(iterations);
+    state.counters["lookups/tile"] =
+        pyramid.lookups / double(iterations) / pyramid.idealTiles.size();
+}
+
+static void UpdateRenderables_CompleteCache(benchmark::State& state) {
+    const uint8_t zoom = 14;
+    auto pyramid = makePyramid(zoom, state.range(0));
+    for (const auto& idealTile : pyramid.idealTiles) {
+        pyramid.addTile(OverscaledTileID(zoom, idealTile.canonical), true);
+    }
+
+    uint64_t iterations = 0;
+    while (state.KeepRunning()) {
+        pyramid.run(zoom);
+        iterations++;
+    }
+
+    state.SetComplexityN(pyramid.idealTiles.size());
+    state.counters["lookups"] = pyramid.lookups / double(iterations);
+    state.counters["lookups/tile"] =
+        pyramid.lookups / double(iterations) / pyramid.idealTiles.size();
+}
+
+static void UpdateRenderables_SparseCache(benchmark::State& state) {
+    runScenario(state, 0.5);
+}
+
+BENCHMARK(UpdateRenderables_EmptyCache)
+    ->RangeMultiplier(2)
+    ->Range(4, 32)
+    ->Complexity(benchmark::oN);
+BENCHMARK(UpdateRenderables_CompleteCache)
+    ->RangeMultiplier(2)
+    ->Range(4, 32)
+    ->Complexity(benchmark::oN);
+BENCHMARK(UpdateRenderables_SparseCache)
+    ->RangeMultiplier(2)
+    ->Range(4, 32)
+    ->Complexity(benchmark::oN);
@@ -0,0 +1,120 @@
+#include <benchmark/benchmark.h>
+
+#include <mbgl/benchmark/util.hpp>
+#include <mbgl/map/map.hpp>
+#include <mbgl/map/backend_scope.hpp>
+#include <mbgl/gl/context.hpp>
+#include <mbgl/gl/headless_backend.hpp>
+#include <mbgl/gl/offscreen_view.hpp>
+#include <mbgl/util/default_thread_pool.hpp>
+#include <mbgl/storage/default_file_source.hpp>
+#include <mbgl/storage/network_status.hpp>
+#include <mbgl/util/chrono.hpp>
+#include <mbgl/util/io.hpp>
+#include <mbgl/util/run_loop.hpp>
+
+#include <algorithm>
+#include <sstream>
+#include <vector>
+
+using namespace mbgl;
+
+namespace {
+
+struct CameraKeyframe {
+    LatLng center;
+    double zoom;
+    double bearing;
+    double pitch;
+};
+
+// A recorded-style camera path over Manhattan (whose tiles are in the
+// offline fixture cache): a straight pan, a zoom out and back in, and a
+// rotation with increasing pitch. Together the segments exercise tile
+// loads, cross-zoom rendering, and the rotated/pitched matrix paths.
+std::vector<CameraKeyframe> cameraPath() {
+    std::vector<CameraKeyframe> keyframes;
+
+    const LatLng start { 40.726989, -73.992857 };
+
+    for (std::size_t i = 0; i < 20; ++i) {
+        keyframes.push_back({ { start.latitude() + 0.0005 * i, start.longitude() + 0.0005 * i },
+                              15, 0, 0 });
+    }
+
+    for (std::size_t i = 0; i < 20; ++i) {
+        const double offset = i < 10 ? i : 20 - i;
+        keyframes.push_back({ start, 15 - 0.4 * offset, 0, 0 });
+    }
+
+    for (std::size_t i = 0; i < 20; ++i) {
+        keyframes.push_back({ start, 15, 18.0 * i, 3.0 * i });
+    }
+
+    return keyframes;
+}
+
+class RenderBenchmark {
+public:
+    RenderBenchmark() {
+        NetworkStatus::Set(NetworkStatus::Status::Offline);
+        fileSource.setAccessToken("foobar");
+
+        map.setStyleJSON(util::read_file("benchmark/fixtures/api/query_style.json"));
+    }
+
+    util::RunLoop loop;
+    HeadlessBackend backend;
+    BackendScope scope { backend };
+    OffscreenView view{ backend.getContext(), { 1000, 1000 } };
+    DefaultFileSource fileSource{ "benchmark/fixtures/api/cache.db", "." };
+    ThreadPool threadPool{ 4 };
+    Map map{ backend, view.getSize(), 1, fileSource, threadPool, MapMode::Still };
+};
+
+double percentile(std::vector<double> samples, double p) {
+    if (samples.empty()) {
+        return 0;
+    }
+    std::sort(samples.begin(), samples.end());
+    return samples[static_cast<std::size_t>(p * (samples.size() - 1))];
+}
+
+} // end namespace
+
+static void API_renderCameraPath(::benchmark::State& state) {
+    RenderBenchmark bench;
+    const std::vector<CameraKeyframe> path = cameraPath();
+
+    std::vector<double> frameTimes;
+    std::size_t drawCalls = 0;
+    std::size_t frames = 0;
+
+    while (state.KeepRunning()) {
+        for (const auto& keyframe : path) {
+            bench.map.setLatLngZoom(keyframe.center, keyframe.zoom);
+            bench.map.setBearing(keyframe.bearing);
+            bench.map.setPitch(keyframe.pitch);
+
+            gl::Context& context = bench.backend.getContext();
+            const std::size_t drawCallsBefore = context.renderStats.drawCalls;
+            const TimePoint frameStart = Clock::now();
+
+            mbgl::benchmark::render(bench.map, bench.view);
+
+            frameTimes.push_back(
+                std::chrono::duration<double, std::milli>(Clock::now() - frameStart).count());
+            drawCalls += context.renderStats.drawCalls - drawCallsBefore;
+            ++frames;
+        }
+    }
+
+    std::ostringstream label;
+    label << "frame_ms p50=" << percentile(frameTimes, 0.50)
+          << " p95=" << percentile(frameTimes, 0.95)
+          << " p99=" << percentile(frameTimes, 0.99)
+          << " draw_calls/frame=" << (frames ? drawCalls / frames : 0);
+    state.SetLabel(label.str().c_str());
+}
+
+BENCHMARK(API_renderCameraPath);
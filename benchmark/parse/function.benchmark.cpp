@@ -0,0 +1,48 @@
+#include <benchmark/benchmark.h>
+
+#include <mbgl/style/function/compiled_stops.hpp>
+#include <mbgl/style/function/exponential_stops.hpp>
+
+using namespace mbgl;
+using namespace mbgl::style;
+
+static ExponentialStops<float> makeStops(float base) {
+    std::map<float, float> stops;
+    for (int i = 0; i < 8; ++i) {
+        stops.emplace(i * 10.0f, i * 100.0f);
+    }
+    return { std::move(stops), base };
+}
+
+// The input sweeps across the stop domain so that neither the branch
+// predictor nor the binary search sees a constant value, as when iterating
+// the features of a data-driven tile layer.
+template <class Stops>
+static void evaluateSweep(benchmark::State& state, const Stops& stops) {
+    float z = 0.0f;
+    while (state.KeepRunning()) {
+        benchmark::DoNotOptimize(stops.evaluate(Value(double(z))));
+        z = z < 70.0f ? z + 0.13f : 0.0f;
+    }
+}
+
+static void Parse_EvaluateLinearStops(benchmark::State& state) {
+    evaluateSweep(state, makeStops(1.0f));
+}
+
+static void Parse_EvaluateCompiledLinearStops(benchmark::State& state) {
+    evaluateSweep(state, CompiledExponentialStops<float>(makeStops(1.0f)));
+}
+
+static void Parse_EvaluateExponentialStops(benchmark::State& state) {
+    evaluateSweep(state, makeStops(1.75f));
+}
+
+static void Parse_EvaluateCompiledExponentialStops(benchmark::State& state) {
+    evaluateSweep(state, CompiledExponentialStops<float>(makeStops(1.75f)));
+}
+
+BENCHMARK(Parse_EvaluateLinearStops);
+BENCHMARK(Parse_EvaluateCompiledLinearStops);
+BENCHMARK(Parse_EvaluateExponentialStops);
+BENCHMARK(Parse_EvaluateCompiledExponentialStops);
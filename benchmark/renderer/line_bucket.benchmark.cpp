@@ -0,0 +1,65 @@
+#include <benchmark/benchmark.h>
+
+#include <mbgl/map/mode.hpp>
+#include <mbgl/renderer/line_bucket.hpp>
+#include <mbgl/style/bucket_parameters.hpp>
+#include <mbgl/util/constants.hpp>
+
+#include <algorithm>
+#include <random>
+
+using namespace mbgl;
+
+namespace {
+
+class RoadFeature : public GeometryTileFeature {
+public:
+    FeatureType getType() const override {
+        return FeatureType::LineString;
+    }
+    optional<Value> getValue(const std::string&) const override {
+        return {};
+    }
+    GeometryCollection getGeometries() const override {
+        return {};
+    }
+};
+
+// Generates a deterministic set of polylines resembling a road-dense tile:
+// many lines with hundreds of vertices each and a mix of gentle and sharp
+// turns, so all join code paths are exercised.
+GeometryCollection representativeRoads() {
+    GeometryCollection roads;
+
+    std::minstd_rand engine(42);
+    std::uniform_int_distribution<int32_t> position(0, util::EXTENT - 1);
+    std::uniform_int_distribution<int32_t> step(-128, 128);
+
+    for (std::size_t line = 0; line < 60; ++line) {
+        GeometryCoordinates coordinates;
+        int32_t x = position(engine);
+        int32_t y = position(engine);
+        for (std::size_t i = 0; i < 200; ++i) {
+            x = std::min<int32_t>(std::max<int32_t>(x + step(engine), 0), util::EXTENT - 1);
+            y = std::min<int32_t>(std::max<int32_t>(y + step(engine), 0), util::EXTENT - 1);
+            coordinates.emplace_back(x, y);
+        }
+        roads.push_back(std::move(coordinates));
+    }
+
+    return roads;
+}
+
+} // namespace
+
+static void LineBucket_AddRoadGeometry(benchmark::State& state) {
+    const GeometryCollection roads = representativeRoads();
+    const RoadFeature feature;
+
+    while (state.KeepRunning()) {
+        LineBucket bucket { { { 0, 0, 0 }, MapMode::Still }, {}, {} };
+        bucket.addFeature(feature, roads);
+    }
+}
+
+BENCHMARK(LineBucket_AddRoadGeometry);
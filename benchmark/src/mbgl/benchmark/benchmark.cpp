@@ -1,12 +1,52 @@
 #include <mbgl/benchmark.hpp>
+#include <mbgl/benchmark/regression_gate.hpp>
 
 #include <benchmark/benchmark.h>
 
+#include <cstdio>
+
 namespace mbgl {
 
 int runBenchmark(int argc, char* argv[]) {
+    benchmark::GateOptions options;
+    const bool gate = benchmark::parseGateOptions(argc, argv, options);
+
     ::benchmark::Initialize(&argc, argv);
-    ::benchmark::RunSpecifiedBenchmarks();
+
+    if (!gate) {
+        ::benchmark::RunSpecifiedBenchmarks();
+        return 0;
+    }
+
+    // Gate mode: repeat the suite until confidence intervals tighten, then
+    // either record the samples as the new baseline or fail on statistically
+    // significant regressions against the recorded one.
+    const benchmark::ResultMap results = benchmark::runWithRepetitions(options);
+
+    if (options.record) {
+        if (!benchmark::writeBaseline(options.baselinePath, results)) {
+            std::fprintf(stderr, "[gate] could not write baseline %s\n",
+                         options.baselinePath.c_str());
+            return 1;
+        }
+        std::fprintf(stderr, "[gate] recorded baseline %s\n", options.baselinePath.c_str());
+        return 0;
+    }
+
+    benchmark::ResultMap baseline;
+    if (!benchmark::readBaseline(options.baselinePath, baseline)) {
+        std::fprintf(stderr, "[gate] could not read baseline %s\n",
+                     options.baselinePath.c_str());
+        return 1;
+    }
+
+    const std::size_t regressions =
+        benchmark::compareAgainstBaseline(baseline, results, options.threshold);
+    if (regressions > 0) {
+        std::fprintf(stderr, "[gate] %zu benchmark(s) regressed beyond %.0f%%\n",
+                     regressions, options.threshold * 100);
+        return 1;
+    }
     return 0;
 }
 
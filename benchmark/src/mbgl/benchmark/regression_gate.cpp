@@ -0,0 +1,242 @@
+#include <mbgl/benchmark/regression_gate.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <rapidjson/document.h>
+#include <rapidjson/stringbuffer.h>
+#include <rapidjson/writer.h>
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+
+namespace mbgl {
+namespace benchmark {
+
+namespace {
+
+double mean(const std::vector<double>& samples) {
+    double sum = 0;
+    for (const double sample : samples) {
+        sum += sample;
+    }
+    return sum / samples.size();
+}
+
+double variance(const std::vector<double>& samples) {
+    if (samples.size() < 2) {
+        return 0;
+    }
+    const double m = mean(samples);
+    double sum = 0;
+    for (const double sample : samples) {
+        sum += (sample - m) * (sample - m);
+    }
+    return sum / (samples.size() - 1);
+}
+
+// Two-sided 95% critical values of Student's t-distribution; the last entry
+// approximates the normal limit for larger sample sizes.
+double tCritical(double degreesOfFreedom) {
+    static const double table[] = {
+        12.71, 4.30, 3.18, 2.78, 2.57, 2.45, 2.36, 2.31, 2.26, 2.23,
+        2.20,  2.18, 2.16, 2.14, 2.13, 2.12, 2.11, 2.10, 2.09, 2.09,
+    };
+    const std::size_t index = static_cast<std::size_t>(degreesOfFreedom);
+    if (index < 1) {
+        return table[0];
+    }
+    if (index > sizeof(table) / sizeof(table[0])) {
+        return 1.96;
+    }
+    return table[index - 1];
+}
+
+// 95% confidence interval half-width around the sample mean.
+double confidenceHalfWidth(const std::vector<double>& samples) {
+    if (samples.size() < 2) {
+        return 0;
+    }
+    return tCritical(samples.size() - 1) *
+           std::sqrt(variance(samples) / samples.size());
+}
+
+// Welch's t-test: true when the two sample means differ significantly at the
+// 95% level without assuming equal variances.
+bool significantlyDifferent(const std::vector<double>& a, const std::vector<double>& b) {
+    if (a.size() < 2 || b.size() < 2) {
+        return true; // Too few samples to claim noise; let the threshold decide.
+    }
+
+    const double varA = variance(a) / a.size();
+    const double varB = variance(b) / b.size();
+    if (varA + varB == 0) {
+        return mean(a) != mean(b);
+    }
+
+    const double t = std::abs(mean(a) - mean(b)) / std::sqrt(varA + varB);
+    const double degreesOfFreedom =
+        (varA + varB) * (varA + varB) /
+        (varA * varA / (a.size() - 1) + varB * varB / (b.size() - 1));
+    return t > tCritical(degreesOfFreedom);
+}
+
+// Captures per-iteration CPU times instead of printing them.
+class CollectingReporter : public ::benchmark::BenchmarkReporter {
+public:
+    explicit CollectingReporter(ResultMap& results_) : results(results_) {
+    }
+
+    bool ReportContext(const Context&) override {
+        return true;
+    }
+
+    void ReportRuns(const std::vector<Run>& runs) override {
+        for (const Run& run : runs) {
+            if (run.iterations == 0) {
+                continue;
+            }
+            results[run.benchmark_name].push_back(
+                run.cpu_accumulated_time * 1e9 / run.iterations);
+        }
+    }
+
+private:
+    ResultMap& results;
+};
+
+bool allIntervalsTight(const ResultMap& results, double targetInterval) {
+    for (const auto& entry : results) {
+        const double m = mean(entry.second);
+        if (m > 0 && confidenceHalfWidth(entry.second) / m > targetInterval) {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+bool parseGateOptions(int& argc, char* argv[], GateOptions& options) {
+    int out = 1;
+    for (int i = 1; i < argc; i++) {
+        const char* arg = argv[i];
+        if (std::strncmp(arg, "--benchmark_baseline=", 21) == 0) {
+            options.baselinePath = arg + 21;
+        } else if (std::strcmp(arg, "--benchmark_record_baseline") == 0) {
+            options.record = true;
+        } else if (std::strncmp(arg, "--benchmark_threshold=", 22) == 0) {
+            options.threshold = std::atof(arg + 22);
+        } else {
+            argv[out++] = argv[i];
+        }
+    }
+    argc = out;
+    return !options.baselinePath.empty();
+}
+
+ResultMap runWithRepetitions(const GateOptions& options) {
+    ResultMap results;
+    CollectingReporter reporter(results);
+
+    for (std::size_t repetition = 0; repetition < options.maxRepetitions; repetition++) {
+        std::fprintf(stderr, "[gate] repetition %zu/%zu\n",
+                     repetition + 1, options.maxRepetitions);
+        ::benchmark::RunSpecifiedBenchmarks(&reporter);
+
+        if (repetition + 1 >= options.minRepetitions &&
+            allIntervalsTight(results, options.targetInterval)) {
+            break;
+        }
+    }
+
+    return results;
+}
+
+bool writeBaseline(const std::string& path, const ResultMap& results) {
+    rapidjson::StringBuffer buffer;
+    rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
+
+    writer.StartObject();
+    writer.Key("benchmarks");
+    writer.StartObject();
+    for (const auto& entry : results) {
+        writer.Key(entry.first.c_str());
+        writer.StartArray();
+        for (const double sample : entry.second) {
+            writer.Double(sample);
+        }
+        writer.EndArray();
+    }
+    writer.EndObject();
+    writer.EndObject();
+
+    std::ofstream file(path, std::ios::trunc);
+    if (!file) {
+        return false;
+    }
+    file << buffer.GetString() << std::endl;
+    return static_cast<bool>(file);
+}
+
+bool readBaseline(const std::string& path, ResultMap& results) {
+    std::ifstream file(path);
+    if (!file) {
+        return false;
+    }
+    std::stringstream contents;
+    contents << file.rdbuf();
+
+    rapidjson::Document document;
+    document.Parse<0>(contents.str().c_str());
+    if (document.HasParseError() || !document.IsObject() ||
+        !document.HasMember("benchmarks") || !document["benchmarks"].IsObject()) {
+        return false;
+    }
+
+    for (const auto& entry : document["benchmarks"].GetObject()) {
+        if (!entry.value.IsArray()) {
+            return false;
+        }
+        std::vector<double>& samples = results[entry.name.GetString()];
+        for (const auto& sample : entry.value.GetArray()) {
+            samples.push_back(sample.GetDouble());
+        }
+    }
+    return true;
+}
+
+std::size_t compareAgainstBaseline(const ResultMap& baseline,
+                                   const ResultMap& current,
+                                   double threshold) {
+    std::size_t regressions = 0;
+
+    for (const auto& entry : current) {
+        const auto it = baseline.find(entry.first);
+        if (it == baseline.end()) {
+            std::fprintf(stderr, "[gate] %-60s NEW (no baseline)\n", entry.first.c_str());
+            continue;
+        }
+
+        const double baselineMean = mean(it->second);
+        const double currentMean = mean(entry.second);
+        const double change = baselineMean > 0 ? (currentMean - baselineMean) / baselineMean : 0;
+
+        if (change > threshold && significantlyDifferent(it->second, entry.second)) {
+            regressions++;
+            std::fprintf(stderr, "[gate] %-60s FAIL %+.1f%% (%.0fns -> %.0fns)\n",
+                         entry.first.c_str(), change * 100, baselineMean, currentMean);
+        } else {
+            std::fprintf(stderr, "[gate] %-60s ok   %+.1f%%\n",
+                         entry.first.c_str(), change * 100);
+        }
+    }
+
+    return regressions;
+}
+
+} // namespace benchmark
+} // namespace mbgl
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <map>
+#include <string>
+#include <vector>
+
+namespace mbgl {
+namespace benchmark {
+
+// Per-iteration CPU times in nanoseconds, one sample per repetition of the
+// suite, keyed by benchmark name.
+using ResultMap = std::map<std::string, std::vector<double>>;
+
+struct GateOptions {
+    std::string baselinePath;
+
+    // Record a new baseline instead of comparing against one.
+    bool record = false;
+
+    // A benchmark fails the gate when it is statistically significantly
+    // slower than its baseline by more than this fraction.
+    double threshold = 0.05;
+
+    // The suite is repeated until every benchmark's 95% confidence interval
+    // half-width is within this fraction of its mean, bounded by
+    // [minRepetitions, maxRepetitions].
+    double targetInterval = 0.02;
+    std::size_t minRepetitions = 3;
+    std::size_t maxRepetitions = 10;
+};
+
+// Parses and strips --benchmark_baseline=<file>, --benchmark_record_baseline,
+// and --benchmark_threshold=<fraction> from argv, leaving the remaining
+// arguments for benchmark::Initialize. Returns true when a baseline path was
+// given, i.e. the gate is active.
+bool parseGateOptions(int& argc, char* argv[], GateOptions&);
+
+// Runs the registered benchmarks repeatedly per GateOptions and collects one
+// sample per benchmark per repetition.
+ResultMap runWithRepetitions(const GateOptions&);
+
+bool writeBaseline(const std::string& path, const ResultMap&);
+bool readBaseline(const std::string& path, ResultMap&);
+
+// Compares current results against the baseline with a Welch's t-test,
+// printing a verdict per benchmark. Returns the number of statistically
+// significant regressions beyond the threshold.
+std::size_t compareAgainstBaseline(const ResultMap& baseline,
+                                   const ResultMap& current,
+                                   double threshold);
+
+} // namespace benchmark
+} // namespace mbgl
@@ -0,0 +1,158 @@
+#include <mbgl/benchmark/synthetic_tile.hpp>
+#include <mbgl/util/string.hpp>
+
+#include <protozero/pbf_writer.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace mbgl {
+namespace benchmark {
+
+namespace {
+
+// Layer 3 / Feature 2 / Value 4 and their inner fields, per the Mapbox
+// Vector Tile 2.x specification.
+enum : protozero::pbf_tag_type {
+    TileLayer = 3,
+    LayerVersion = 15,
+    LayerName = 1,
+    LayerFeature = 2,
+    LayerKey = 3,
+    LayerValue = 4,
+    LayerExtent = 5,
+    FeatureID = 1,
+    FeatureTags = 2,
+    FeatureType_ = 3,
+    FeatureGeometry = 4,
+    ValueString = 1,
+};
+
+// Small deterministic generator; identical options produce identical tiles.
+struct SplitMix {
+    uint64_t state;
+
+    uint32_t next(uint32_t bound) {
+        state += 0x9e3779b97f4a7c15ULL;
+        uint64_t z = state;
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+        return static_cast<uint32_t>((z ^ (z >> 31)) % bound);
+    }
+};
+
+uint32_t zigzag(int32_t value) {
+    return protozero::encode_zigzag32(value);
+}
+
+uint32_t commandInteger(uint32_t id, uint32_t count) {
+    return (id & 0x7) | (count << 3);
+}
+
+void appendDelta(std::vector<uint32_t>& geometry, int32_t& cursorX, int32_t& cursorY,
+                 int32_t x, int32_t y) {
+    geometry.push_back(zigzag(x - cursorX));
+    geometry.push_back(zigzag(y - cursorY));
+    cursorX = x;
+    cursorY = y;
+}
+
+std::vector<uint32_t> makeGeometry(const SyntheticTileOptions& options, SplitMix& random) {
+    const int32_t extent = static_cast<int32_t>(options.extent);
+    const uint32_t vertices = std::max<std::size_t>(options.verticesPerFeature, 3);
+    std::vector<uint32_t> geometry;
+    int32_t cursorX = 0;
+    int32_t cursorY = 0;
+
+    switch (options.geometryType) {
+    case FeatureType::Point: {
+        // A multipoint scattered across the tile.
+        geometry.push_back(commandInteger(1, vertices)); // MoveTo
+        for (uint32_t i = 0; i < vertices; i++) {
+            appendDelta(geometry, cursorX, cursorY,
+                        random.next(options.extent), random.next(options.extent));
+        }
+        break;
+    }
+    case FeatureType::LineString: {
+        // A random walk with short segments, the shape of road geometry.
+        int32_t x = random.next(options.extent);
+        int32_t y = random.next(options.extent);
+        geometry.push_back(commandInteger(1, 1)); // MoveTo
+        appendDelta(geometry, cursorX, cursorY, x, y);
+        geometry.push_back(commandInteger(2, vertices - 1)); // LineTo
+        for (uint32_t i = 1; i < vertices; i++) {
+            x = std::min(std::max(x + static_cast<int32_t>(random.next(129)) - 64, 0), extent - 1);
+            y = std::min(std::max(y + static_cast<int32_t>(random.next(129)) - 64, 0), extent - 1);
+            appendDelta(geometry, cursorX, cursorY, x, y);
+        }
+        break;
+    }
+    default: {
+        // A regular clockwise ring around a random center, the shape of
+        // building footprints.
+        const int32_t radius = 16 + static_cast<int32_t>(random.next(112));
+        const int32_t centerX = radius + random.next(options.extent - 2 * radius);
+        const int32_t centerY = radius + random.next(options.extent - 2 * radius);
+        geometry.push_back(commandInteger(1, 1)); // MoveTo
+        appendDelta(geometry, cursorX, cursorY, centerX + radius, centerY);
+        geometry.push_back(commandInteger(2, vertices - 1)); // LineTo
+        for (uint32_t i = 1; i < vertices; i++) {
+            const double angle = -2.0 * M_PI * i / vertices;
+            appendDelta(geometry, cursorX, cursorY,
+                        centerX + static_cast<int32_t>(radius * std::cos(angle)),
+                        centerY + static_cast<int32_t>(radius * std::sin(angle)));
+        }
+        geometry.push_back(commandInteger(7, 1)); // ClosePath
+        break;
+    }
+    }
+
+    return geometry;
+}
+
+} // namespace
+
+std::string generateSyntheticTile(const SyntheticTileOptions& options) {
+    std::string data;
+    protozero::pbf_writer tile(data);
+    SplitMix random { options.seed };
+
+    for (std::size_t layerIndex = 0; layerIndex < options.layerCount; layerIndex++) {
+        protozero::pbf_writer layer(tile, TileLayer);
+        layer.add_uint32(LayerVersion, 2);
+        layer.add_string(LayerName, "synthetic_" + util::toString(layerIndex));
+        layer.add_uint32(LayerExtent, options.extent);
+
+        for (std::size_t key = 0; key < options.propertyKeyCount; key++) {
+            layer.add_string(LayerKey, "key_" + util::toString(key));
+        }
+        for (std::size_t value = 0; value < options.propertyValueCardinality; value++) {
+            protozero::pbf_writer valueWriter(layer, LayerValue);
+            valueWriter.add_string(ValueString, "value_" + util::toString(value));
+        }
+
+        for (std::size_t featureIndex = 0; featureIndex < options.featuresPerLayer; featureIndex++) {
+            const std::vector<uint32_t> geometry = makeGeometry(options, random);
+
+            std::vector<uint32_t> tags;
+            tags.reserve(options.propertyKeyCount * 2);
+            for (std::size_t key = 0; key < options.propertyKeyCount; key++) {
+                tags.push_back(static_cast<uint32_t>(key));
+                tags.push_back(random.next(options.propertyValueCardinality));
+            }
+
+            protozero::pbf_writer feature(layer, LayerFeature);
+            feature.add_uint64(FeatureID, featureIndex + 1);
+            feature.add_packed_uint32(FeatureTags, tags.begin(), tags.end());
+            feature.add_enum(FeatureType_, static_cast<int32_t>(options.geometryType));
+            feature.add_packed_uint32(FeatureGeometry, geometry.begin(), geometry.end());
+        }
+    }
+
+    return data;
+}
+
+} // namespace benchmark
+} // namespace mbgl
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <mbgl/util/geometry.hpp>
+
+#include <cstdint>
+#include <string>
+
+namespace mbgl {
+namespace benchmark {
+
+// Parameters of a generated vector tile. Checked-in fixtures pin one point
+// in the workload space; generated tiles let a benchmark sweep a single
+// axis — feature count, vertex density, property cardinality, layer count —
+// while holding the others fixed, which is what exposes nonlinear scaling.
+struct SyntheticTileOptions {
+    std::size_t layerCount = 1;
+    std::size_t featuresPerLayer = 512;
+
+    // Vertices per feature: line length, ring size, or multipoint size.
+    std::size_t verticesPerFeature = 8;
+
+    // Distinct property keys per layer and distinct values per key; every
+    // feature carries one tag per key.
+    std::size_t propertyKeyCount = 4;
+    std::size_t propertyValueCardinality = 16;
+
+    FeatureType geometryType = FeatureType::LineString;
+    uint32_t extent = 4096;
+
+    // Seed of the deterministic generator, so a parameter sweep re-runs on
+    // identical geometry.
+    uint64_t seed = 1;
+};
+
+// Returns the serialized Mapbox Vector Tile.
+std::string generateSyntheticTile(const SyntheticTileOptions&);
+
+} // namespace benchmark
+} // namespace mbgl
@@ -0,0 +1,110 @@
+#include <benchmark/benchmark.h>
+
+#include <mbgl/text/collision_tile.hpp>
+#include <mbgl/text/collision_feature.hpp>
+#include <mbgl/util/constants.hpp>
+
+#include <random>
+#include <sstream>
+#include <vector>
+
+using namespace mbgl;
+
+namespace {
+
+// Generates a deterministic set of point-placed label boxes resembling a
+// dense POI tile, so placement repeatedly probes well-populated grid cells.
+// The boxes land in `store`, as they would in a SymbolLayout's slab.
+std::vector<CollisionFeature> denseLabels(CollisionBoxStore& store, std::size_t count) {
+    std::vector<CollisionFeature> features;
+    features.reserve(count);
+
+    std::minstd_rand engine(42);
+    std::uniform_int_distribution<int32_t> position(0, util::EXTENT - 1);
+
+    for (std::size_t i = 0; i < count; ++i) {
+        GeometryCoordinates line = {{ { position(engine), position(engine) } }};
+        Anchor anchor(line[0].x, line[0].y, 0.0f, 0.5f);
+        features.emplace_back(store, line, anchor,
+                              /* top */ -12.0f, /* bottom */ 12.0f,
+                              /* left */ -48.0f, /* right */ 48.0f,
+                              /* boxScale */ 1.0f, /* padding */ 2.0f,
+                              style::SymbolPlacementType::Point,
+                              IndexedSubfeature { i, "source", "bucket", i },
+                              /* straight */ false);
+    }
+
+    return features;
+}
+
+} // namespace
+
+static void CollisionTile_PlaceFeatures(benchmark::State& state) {
+    CollisionBoxStore collisionBoxes;
+    const std::vector<CollisionFeature> features = denseLabels(collisionBoxes, 2000);
+
+    while (state.KeepRunning()) {
+        // Rotated placement, as during a rotation animation.
+        CollisionTile collisionTile({ 0.3f, 0.0f, false });
+
+        for (const CollisionFeature& feature : features) {
+            const float placementScale = collisionTile.placeFeature(feature, collisionBoxes, false, false);
+            collisionTile.insertFeature(feature, collisionBoxes, placementScale, false);
+        }
+    }
+}
+
+static void CollisionTile_QueryRenderedSymbols(benchmark::State& state) {
+    CollisionBoxStore collisionBoxes;
+    std::vector<CollisionFeature> features = denseLabels(collisionBoxes, 2000);
+
+    CollisionTile collisionTile({ 0.3f, 0.0f, false });
+    for (const CollisionFeature& feature : features) {
+        const float placementScale = collisionTile.placeFeature(feature, collisionBoxes, false, false);
+        collisionTile.insertFeature(feature, collisionBoxes, placementScale, false);
+    }
+
+    const GeometryCoordinates queryGeometry = {
+        { 2048, 2048 }, { 2560, 2048 }, { 2560, 2560 }, { 2048, 2560 }
+    };
+
+    while (state.KeepRunning()) {
+        benchmark::DoNotOptimize(collisionTile.queryRenderedSymbols(queryGeometry, 1.0f));
+    }
+}
+
+static void CollisionTile_RotationSweep(benchmark::State& state) {
+    CollisionBoxStore collisionBoxes;
+    const std::vector<CollisionFeature> features = denseLabels(collisionBoxes, 2000);
+
+    uint64_t gridQueries = 0;
+    uint64_t passes = 0;
+
+    while (state.KeepRunning()) {
+        // One full placement pass per 10-degree step of a rotation — the
+        // work a rotation gesture replays against every visible tile, since
+        // each angle change invalidates the previous placement.
+        for (int degrees = 0; degrees < 360; degrees += 10) {
+            CollisionTile collisionTile({ static_cast<float>(degrees * util::DEG2RAD), 0.0f, false });
+
+            for (const CollisionFeature& feature : features) {
+                const float placementScale = collisionTile.placeFeature(feature, collisionBoxes, false, false);
+                collisionTile.insertFeature(feature, collisionBoxes, placementScale, false);
+            }
+
+            gridQueries += collisionTile.gridQueryCount();
+            ++passes;
+        }
+    }
+
+    // Items are placement passes, so items/s is the per-pass rate.
+    state.SetItemsProcessed(passes);
+
+    std::ostringstream label;
+    label << "grid_queries/pass=" << (passes > 0 ? gridQueries / passes : 0);
+    state.SetLabel(label.str().c_str());
+}
+
+BENCHMARK(CollisionTile_PlaceFeatures);
+BENCHMARK(CollisionTile_QueryRenderedSymbols);
+BENCHMARK(CollisionTile_RotationSweep);
@@ -0,0 +1,267 @@
+#include <benchmark/benchmark.h>
+
+#include <mbgl/benchmark/synthetic_tile.hpp>
+#include <mbgl/map/mode.hpp>
+#include <mbgl/renderer/fill_bucket.hpp>
+#include <mbgl/renderer/line_bucket.hpp>
+#include <mbgl/style/bucket_parameters.hpp>
+#include <mbgl/tile/vector_tile_data.hpp>
+#include <mbgl/util/io.hpp>
+
+#include <protozero/pbf_reader.hpp>
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace mbgl;
+
+namespace {
+
+// Real tiles from the streets fixture set: the whole-world z0 tile carries
+// every layer of the source at once (heavy on polygons), and the z10
+// Manhattan tile is dominated by dense road and building geometry. Each
+// stage of the pipeline is timed separately so a regression shows up in the
+// stage that caused it.
+constexpr const char* worldTilePath = "benchmark/fixtures/tile_pipeline/0-0-0.vector.pbf";
+constexpr const char* urbanTilePath = "benchmark/fixtures/tile_pipeline/10-163-395.vector.pbf";
+
+std::vector<std::string> layerNames(const std::string& data) {
+    std::vector<std::string> names;
+    protozero::pbf_reader tile_pbf(data);
+    while (tile_pbf.next(3)) {
+        protozero::pbf_reader layer_pbf = tile_pbf.get_message();
+        while (layer_pbf.next(1)) {
+            names.push_back(layer_pbf.get_string());
+            break;
+        }
+    }
+    return names;
+}
+
+// Layer contents parsed from the same raw bytes are shared process-wide, so
+// each iteration works on a fresh copy of the string to give the tile a new
+// identity; the copy itself is cheap next to the parse it forces.
+std::unique_ptr<VectorTileData> freshTile(const std::string& raw) {
+    return std::make_unique<VectorTileData>(std::make_shared<const std::string>(raw));
+}
+
+class StubFeature : public GeometryTileFeature {
+public:
+    StubFeature(FeatureType type_) : type(type_) {
+    }
+
+    FeatureType getType() const override { return type; }
+    optional<Value> getValue(const std::string&) const override { return {}; }
+    GeometryCollection getGeometries() const override { return {}; }
+
+private:
+    FeatureType type;
+};
+
+// The decoded (type, geometry) pairs of every feature in the tile, as the
+// bucket stages receive them from layout.
+std::vector<std::pair<FeatureType, GeometryCollection>> decodeGeometries(const std::string& raw) {
+    std::vector<std::pair<FeatureType, GeometryCollection>> result;
+    auto tile = freshTile(raw);
+    for (const auto& name : layerNames(raw)) {
+        const GeometryTileLayer* layer = tile->getLayer(name);
+        for (std::size_t i = 0; i < layer->featureCount(); ++i) {
+            auto feature = layer->getFeature(i);
+            result.emplace_back(feature->getType(), feature->getGeometries());
+        }
+    }
+    return result;
+}
+
+void parseStage(const std::string& raw, const std::vector<std::string>& names) {
+    auto tile = freshTile(raw);
+    for (const auto& name : names) {
+        const GeometryTileLayer* layer = tile->getLayer(name);
+        for (std::size_t i = 0; i < layer->featureCount(); ++i) {
+            ::benchmark::DoNotOptimize(layer->getFeature(i)->getType());
+        }
+    }
+}
+
+void geometryStage(const GeometryTileData& tile, const std::vector<std::string>& names) {
+    for (const auto& name : names) {
+        const GeometryTileLayer* layer = tile.getLayer(name);
+        for (std::size_t i = 0; i < layer->featureCount(); ++i) {
+            ::benchmark::DoNotOptimize(layer->getFeature(i)->getGeometries());
+        }
+    }
+}
+
+void propertyStage(const GeometryTileData& tile, const std::vector<std::string>& names) {
+    for (const auto& name : names) {
+        const GeometryTileLayer* layer = tile.getLayer(name);
+        for (std::size_t i = 0; i < layer->featureCount(); ++i) {
+            // Properties are cached per feature object, so a fresh feature is
+            // created each time to measure the decode rather than the cache.
+            ::benchmark::DoNotOptimize(layer->getFeature(i)->getProperties().size());
+        }
+    }
+}
+
+void bucketStage(const std::vector<std::pair<FeatureType, GeometryCollection>>& features) {
+    const style::BucketParameters parameters { { 0, 0, 0 }, MapMode::Still };
+    LineBucket lineBucket { parameters, {}, {} };
+    FillBucket fillBucket { parameters, {} };
+
+    const StubFeature lineFeature(FeatureType::LineString);
+    const StubFeature fillFeature(FeatureType::Polygon);
+
+    for (const auto& feature : features) {
+        if (feature.first == FeatureType::LineString) {
+            lineBucket.addFeature(lineFeature, feature.second);
+        } else if (feature.first == FeatureType::Polygon) {
+            fillBucket.addFeature(fillFeature, feature.second);
+        }
+    }
+}
+
+} // namespace
+
+static void TilePipeline_Parse_World(::benchmark::State& state) {
+    const std::string raw = util::read_file(worldTilePath);
+    const std::vector<std::string> names = layerNames(raw);
+
+    while (state.KeepRunning()) {
+        parseStage(raw, names);
+    }
+}
+
+static void TilePipeline_Parse_Urban(::benchmark::State& state) {
+    const std::string raw = util::read_file(urbanTilePath);
+    const std::vector<std::string> names = layerNames(raw);
+
+    while (state.KeepRunning()) {
+        parseStage(raw, names);
+    }
+}
+
+static void TilePipeline_GeometryDecode_World(::benchmark::State& state) {
+    const std::string raw = util::read_file(worldTilePath);
+    const std::vector<std::string> names = layerNames(raw);
+    const auto tile = freshTile(raw);
+
+    while (state.KeepRunning()) {
+        geometryStage(*tile, names);
+    }
+}
+
+static void TilePipeline_GeometryDecode_Urban(::benchmark::State& state) {
+    const std::string raw = util::read_file(urbanTilePath);
+    const std::vector<std::string> names = layerNames(raw);
+    const auto tile = freshTile(raw);
+
+    while (state.KeepRunning()) {
+        geometryStage(*tile, names);
+    }
+}
+
+static void TilePipeline_PropertyDecode_World(::benchmark::State& state) {
+    const std::string raw = util::read_file(worldTilePath);
+    const std::vector<std::string> names = layerNames(raw);
+    const auto tile = freshTile(raw);
+
+    while (state.KeepRunning()) {
+        propertyStage(*tile, names);
+    }
+}
+
+static void TilePipeline_PropertyDecode_Urban(::benchmark::State& state) {
+    const std::string raw = util::read_file(urbanTilePath);
+    const std::vector<std::string> names = layerNames(raw);
+    const auto tile = freshTile(raw);
+
+    while (state.KeepRunning()) {
+        propertyStage(*tile, names);
+    }
+}
+
+static void TilePipeline_Buckets_World(::benchmark::State& state) {
+    const auto features = decodeGeometries(util::read_file(worldTilePath));
+
+    while (state.KeepRunning()) {
+        bucketStage(features);
+    }
+}
+
+static void TilePipeline_Buckets_Urban(::benchmark::State& state) {
+    const auto features = decodeGeometries(util::read_file(urbanTilePath));
+
+    while (state.KeepRunning()) {
+        bucketStage(features);
+    }
+}
+
+// Synthetic tiles sweep one workload axis at a time while the fixture tiles
+// above pin realistic content. Items processed is set to the feature count,
+// so a superlinear stage shows up as falling items/s along the sweep.
+
+static void TilePipeline_Synthetic_FeatureCount(::benchmark::State& state) {
+    mbgl::benchmark::SyntheticTileOptions options;
+    options.featuresPerLayer = state.range_x();
+    const auto features = decodeGeometries(mbgl::benchmark::generateSyntheticTile(options));
+
+    while (state.KeepRunning()) {
+        bucketStage(features);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range_x());
+}
+
+static void TilePipeline_Synthetic_VertexDensity(::benchmark::State& state) {
+    mbgl::benchmark::SyntheticTileOptions options;
+    options.verticesPerFeature = state.range_x();
+    const auto features = decodeGeometries(mbgl::benchmark::generateSyntheticTile(options));
+
+    while (state.KeepRunning()) {
+        bucketStage(features);
+    }
+    // Items are vertices here, so linear scaling in vertex count holds
+    // items/s flat.
+    state.SetItemsProcessed(state.iterations() * options.featuresPerLayer * state.range_x());
+}
+
+static void TilePipeline_Synthetic_PropertyCardinality(::benchmark::State& state) {
+    mbgl::benchmark::SyntheticTileOptions options;
+    options.propertyKeyCount = 8;
+    options.propertyValueCardinality = state.range_x();
+    const std::string raw = mbgl::benchmark::generateSyntheticTile(options);
+    const std::vector<std::string> names = layerNames(raw);
+    const auto tile = freshTile(raw);
+
+    while (state.KeepRunning()) {
+        propertyStage(*tile, names);
+    }
+    state.SetItemsProcessed(state.iterations() * options.featuresPerLayer);
+}
+
+static void TilePipeline_Synthetic_LayerCount(::benchmark::State& state) {
+    mbgl::benchmark::SyntheticTileOptions options;
+    options.layerCount = state.range_x();
+    options.featuresPerLayer = 128;
+    const std::string raw = mbgl::benchmark::generateSyntheticTile(options);
+    const std::vector<std::string> names = layerNames(raw);
+
+    while (state.KeepRunning()) {
+        parseStage(raw, names);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range_x());
+}
+
+BENCHMARK(TilePipeline_Parse_World);
+BENCHMARK(TilePipeline_Parse_Urban);
+BENCHMARK(TilePipeline_GeometryDecode_World);
+BENCHMARK(TilePipeline_GeometryDecode_Urban);
+BENCHMARK(TilePipeline_PropertyDecode_World);
+BENCHMARK(TilePipeline_PropertyDecode_Urban);
+BENCHMARK(TilePipeline_Buckets_World);
+BENCHMARK(TilePipeline_Buckets_Urban);
+BENCHMARK(TilePipeline_Synthetic_FeatureCount)->Range(64, 8192);
+BENCHMARK(TilePipeline_Synthetic_VertexDensity)->Range(4, 256);
+BENCHMARK(TilePipeline_Synthetic_PropertyCardinality)->Range(4, 1024);
+BENCHMARK(TilePipeline_Synthetic_LayerCount)->Range(1, 32);
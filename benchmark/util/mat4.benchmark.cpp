@@ -0,0 +1,54 @@
+#include <benchmark/benchmark.h>
+
+#include <mbgl/util/mat4.hpp>
+
+using namespace mbgl;
+
+namespace {
+
+mat4 makeMatrix(uint64_t seed) {
+    mat4 m;
+    for (auto& value : m) {
+        seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+        value = (double((seed >> 11) & 0xFFFFFFFF) / double(0xFFFFFFFF)) * 20.0 - 10.0;
+    }
+    return m;
+}
+
+} // namespace
+
+static void Util_MatrixMultiply(benchmark::State& state) {
+    const mat4 a = makeMatrix(1);
+    const mat4 b = makeMatrix(2);
+    mat4 out;
+
+    while (state.KeepRunning()) {
+        matrix::multiply(out, a, b);
+        benchmark::DoNotOptimize(out);
+    }
+}
+
+static void Util_MatrixTransformMat4(benchmark::State& state) {
+    const mat4 m = makeMatrix(1);
+    const vec4 p = { { 1.5, -2.5, 3.5, 1.0 } };
+    vec4 out;
+
+    while (state.KeepRunning()) {
+        matrix::transformMat4(out, p, m);
+        benchmark::DoNotOptimize(out);
+    }
+}
+
+static void Util_MatrixInvert(benchmark::State& state) {
+    mat4 a = makeMatrix(1);
+    mat4 out;
+
+    while (state.KeepRunning()) {
+        benchmark::DoNotOptimize(matrix::invert(out, a));
+        benchmark::DoNotOptimize(out);
+    }
+}
+
+BENCHMARK(Util_MatrixMultiply);
+BENCHMARK(Util_MatrixTransformMat4);
+BENCHMARK(Util_MatrixInvert);
@@ -0,0 +1,47 @@
+#include <benchmark/benchmark.h>
+
+#include <mbgl/util/image.hpp>
+#include <mbgl/util/premultiply.hpp>
+
+using namespace mbgl;
+
+namespace {
+
+UnassociatedImage makeImage(const Size size) {
+    UnassociatedImage image(size);
+    uint8_t value = 0;
+    for (size_t i = 0; i < image.bytes(); i++) {
+        image.data[i] = value++;
+    }
+    return image;
+}
+
+} // namespace
+
+static void Util_Premultiply(benchmark::State& state) {
+    // A 512×512 @2x raster tile.
+    const Size size { 1024, 1024 };
+
+    while (state.KeepRunning()) {
+        state.PauseTiming();
+        UnassociatedImage src = makeImage(size);
+        state.ResumeTiming();
+
+        benchmark::DoNotOptimize(util::premultiply(std::move(src)));
+    }
+}
+
+static void Util_Unpremultiply(benchmark::State& state) {
+    const Size size { 1024, 1024 };
+
+    while (state.KeepRunning()) {
+        state.PauseTiming();
+        PremultipliedImage src = util::premultiply(makeImage(size));
+        state.ResumeTiming();
+
+        benchmark::DoNotOptimize(util::unpremultiply(std::move(src)));
+    }
+}
+
+BENCHMARK(Util_Premultiply);
+BENCHMARK(Util_Unpremultiply);
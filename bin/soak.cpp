@@ -0,0 +1,398 @@
+#include <mbgl/map/map.hpp>
+#include <mbgl/map/backend_scope.hpp>
+#include <mbgl/util/run_loop.hpp>
+#include <mbgl/util/timer.hpp>
+#include <mbgl/util/memory_stats.hpp>
+#include <mbgl/util/tile_latency.hpp>
+#include <mbgl/util/performance_counters.hpp>
+
+#include <mbgl/gl/headless_backend.hpp>
+#include <mbgl/gl/offscreen_view.hpp>
+#include <mbgl/util/default_thread_pool.hpp>
+#include <mbgl/storage/default_file_source.hpp>
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wunknown-pragmas"
+#pragma GCC diagnostic ignored "-Wunused-local-typedefs"
+#pragma GCC diagnostic ignored "-Wshadow"
+#include <boost/program_options.hpp>
+#pragma GCC diagnostic pop
+
+namespace po = boost::program_options;
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <vector>
+
+// Replays recorded session traces against Map + HeadlessBackend at
+// accelerated speed and fails when a runtime invariant is violated, so
+// endurance regressions (worker starvation, cache growth, latency creep)
+// surface in an overnight CI run instead of in the field.
+//
+// A trace is a text file of camera keyframes, one per line:
+//
+//     <seconds> <lon> <lat> <zoom> [<bearing> [<pitch>]]
+//
+// with '#' starting a comment. Timestamps are relative to the session start;
+// --speed divides the gaps between them. Several instances replay the same
+// trace against independent Maps sharing one GL context and one worker pool,
+// which is the contention pattern that starves workers in production.
+
+namespace {
+
+struct Keyframe {
+    double time = 0;
+    double lon = 0;
+    double lat = 0;
+    double zoom = 0;
+    double bearing = 0;
+    double pitch = 0;
+};
+
+std::vector<Keyframe> parseTrace(std::istream& in) {
+    std::vector<Keyframe> keyframes;
+    std::string line;
+    while (std::getline(in, line)) {
+        const auto hash = line.find('#');
+        if (hash != std::string::npos) {
+            line.resize(hash);
+        }
+        std::istringstream fields(line);
+        Keyframe keyframe;
+        if (fields >> keyframe.time >> keyframe.lon >> keyframe.lat >> keyframe.zoom) {
+            fields >> keyframe.bearing >> keyframe.pitch;
+            keyframes.push_back(keyframe);
+        }
+    }
+    return keyframes;
+}
+
+// Wraps a FileSource and holds each response for a delay drawn from a
+// log-normal distribution, reproducing production network timing against a
+// warm local cache. A median of zero forwards responses untouched.
+class LatencyFileSource : public mbgl::FileSource {
+public:
+    LatencyFileSource(mbgl::FileSource& inner_, double medianMs_, double sigma_)
+        : inner(inner_),
+          medianMs(medianMs_),
+          delays(std::log(medianMs_ > 0 ? medianMs_ : 1), sigma_) {
+    }
+
+    std::unique_ptr<mbgl::AsyncRequest> request(const mbgl::Resource& resource, Callback callback) override {
+        if (medianMs <= 0) {
+            return inner.request(resource, std::move(callback));
+        }
+        return std::make_unique<DelayedRequest>(*this, resource, std::move(callback));
+    }
+
+    mbgl::optional<mbgl::Tileset> getCachedTileset(const std::string& url) override {
+        return inner.getCachedTileset(url);
+    }
+
+    void putCachedTileset(const std::string& url, const mbgl::Tileset& tileset,
+                          mbgl::optional<mbgl::Timestamp> expires) override {
+        inner.putCachedTileset(url, tileset, expires);
+    }
+
+    bool supportsOptionalRequests() const override {
+        return inner.supportsOptionalRequests();
+    }
+
+private:
+    class DelayedRequest : public mbgl::AsyncRequest {
+    public:
+        DelayedRequest(LatencyFileSource& parent, const mbgl::Resource& resource, Callback callback_)
+            : callback(std::move(callback_)) {
+            request = parent.inner.request(resource, [this, &parent](mbgl::Response response) {
+                timer.start(mbgl::Milliseconds(parent.sampleDelay()), mbgl::Duration::zero(),
+                            [this, response] { callback(response); });
+            });
+        }
+
+    private:
+        Callback callback;
+        std::unique_ptr<mbgl::AsyncRequest> request;
+        mbgl::util::Timer timer;
+    };
+
+    int64_t sampleDelay() {
+        return static_cast<int64_t>(delays(rng));
+    }
+
+    mbgl::FileSource& inner;
+    const double medianMs;
+    std::lognormal_distribution<double> delays;
+    std::mt19937 rng { std::random_device{}() };
+};
+
+// The smallest bucket upper bound at or above the requested quantile of a
+// power-of-two latency histogram; an upper bound on the true percentile.
+uint64_t percentileMilliseconds(const mbgl::TileStageHistogram& histogram, double quantile) {
+    if (histogram.samples == 0) {
+        return 0;
+    }
+    const uint64_t target = static_cast<uint64_t>(std::ceil(histogram.samples * quantile));
+    uint64_t cumulative = 0;
+    for (std::size_t i = 0; i < histogram.counts.size(); i++) {
+        cumulative += histogram.counts[i];
+        if (cumulative >= target) {
+            if (i + 1 == histogram.counts.size()) {
+                break;
+            }
+            return uint64_t(1) << i;
+        }
+    }
+    return histogram.maxMilliseconds;
+}
+
+} // namespace
+
+int main(int argc, char *argv[]) {
+    std::string style_path;
+    std::string trace_path;
+    uint32_t instances = 1;
+    uint32_t loops = 1;
+    double speed = 10;
+    double networkMedian = 0;
+    double networkSigma = 0.5;
+
+    uint32_t pixelRatio = 1;
+    uint32_t width = 512;
+    uint32_t height = 512;
+    std::string cache_file = "cache.sqlite";
+    std::string asset_root = ".";
+    std::string token;
+
+    uint64_t maxQueueDepth = 0;
+    uint64_t maxMemoryMB = 0;
+    uint64_t maxP99 = 0;
+
+    po::options_description desc("Allowed options");
+    desc.add_options()
+        ("style,s", po::value(&style_path)->required()->value_name("json"), "Map stylesheet")
+        ("trace", po::value(&trace_path)->required()->value_name("file"), "Camera trace file")
+        ("instances,i", po::value(&instances)->value_name("number")->default_value(instances), "Concurrent map instances")
+        ("loops,l", po::value(&loops)->value_name("number")->default_value(loops), "Times each instance replays the trace")
+        ("speed", po::value(&speed)->value_name("factor")->default_value(speed), "Trace playback acceleration")
+        ("network-median", po::value(&networkMedian)->value_name("ms")->default_value(networkMedian), "Median injected network delay (0 disables)")
+        ("network-sigma", po::value(&networkSigma)->value_name("number")->default_value(networkSigma), "Log-normal sigma of the injected delay")
+        ("width,w", po::value(&width)->value_name("pixels")->default_value(width), "Image width")
+        ("height,h", po::value(&height)->value_name("pixels")->default_value(height), "Image height")
+        ("ratio,r", po::value(&pixelRatio)->value_name("number")->default_value(pixelRatio), "Image scale factor")
+        ("token,t", po::value(&token)->value_name("key")->default_value(token), "Mapbox access token")
+        ("cache,d", po::value(&cache_file)->value_name("file")->default_value(cache_file), "Cache database file name")
+        ("assets,d", po::value(&asset_root)->value_name("file")->default_value(asset_root), "Directory to which asset:// URLs will resolve")
+        ("max-queue-depth", po::value(&maxQueueDepth)->value_name("number")->default_value(maxQueueDepth), "Fail if the worker queue exceeds this depth (0 disables)")
+        ("max-memory-mb", po::value(&maxMemoryMB)->value_name("MB")->default_value(maxMemoryMB), "Fail if tracked memory exceeds this ceiling (0 disables)")
+        ("max-p99-ms", po::value(&maxP99)->value_name("ms")->default_value(maxP99), "Fail if any processing stage's p99 exceeds this (0 disables)")
+    ;
+
+    try {
+        po::variables_map vm;
+        po::store(po::parse_command_line(argc, argv, desc), vm);
+        po::notify(vm);
+    } catch(std::exception& e) {
+        std::cout << "Error: " << e.what() << std::endl << desc;
+        exit(1);
+    }
+
+    std::ifstream traceFile(trace_path);
+    if (!traceFile) {
+        std::cout << "Error: cannot open trace " << trace_path << std::endl;
+        exit(1);
+    }
+    const std::vector<Keyframe> trace = parseTrace(traceFile);
+    if (trace.empty()) {
+        std::cout << "Error: trace " << trace_path << " contains no keyframes" << std::endl;
+        exit(1);
+    }
+    if (instances == 0 || loops == 0 || speed <= 0) {
+        std::cout << "Error: instances, loops and speed must be positive" << std::endl;
+        exit(1);
+    }
+
+    using namespace mbgl;
+
+    util::RunLoop loop;
+    DefaultFileSource cachedSource(cache_file, asset_root);
+
+    if (!token.size()) {
+        const char *token_ptr = getenv("MAPBOX_ACCESS_TOKEN");
+        if (token_ptr) {
+            token = token_ptr;
+        }
+    }
+    if (token.size()) {
+        cachedSource.setAccessToken(std::string(token));
+    }
+
+    LatencyFileSource fileSource(cachedSource, networkMedian, networkSigma);
+
+    HeadlessBackend backend;
+    BackendScope scope { backend };
+    OffscreenView view(backend.getContext(), { width * pixelRatio, height * pixelRatio });
+    ThreadPool threadPool(4);
+
+    if (style_path.find("://") == std::string::npos) {
+        style_path = std::string("file://") + style_path;
+    }
+
+    // All instances render through one shared context; Shared mode keeps the
+    // context's state cache valid across them.
+    const GLContextMode contextMode =
+        instances > 1 ? GLContextMode::Shared : GLContextMode::Unique;
+
+    std::vector<std::unique_ptr<Map>> maps;
+    for (uint32_t i = 0; i < instances; i++) {
+        maps.push_back(std::make_unique<Map>(backend, Size { width, height }, pixelRatio,
+                                             fileSource, threadPool, MapMode::Still, contextMode));
+        maps.back()->setStyleURL(style_path);
+    }
+
+    util::resetTileLatencyStats();
+    util::resetMemoryPeaks();
+
+    uint64_t framesRendered = 0;
+    int exitCode = 0;
+
+    auto fail = [&](const std::string& reason) {
+        std::cout << "Invariant violated after " << framesRendered << " frames: " << reason << std::endl;
+        exitCode = 1;
+        loop.stop();
+    };
+
+    // Per-frame checks; the latency percentiles are aggregates and are only
+    // meaningful at the end of the run.
+    auto checkInvariants = [&] {
+        if (maxQueueDepth > 0) {
+            const auto counters = util::getPerformanceCounters();
+            if (counters.workerQueueDepth > maxQueueDepth) {
+                fail("worker queue depth " + std::to_string(counters.workerQueueDepth) +
+                     " exceeds " + std::to_string(maxQueueDepth));
+                return false;
+            }
+        }
+        if (maxMemoryMB > 0) {
+            const auto memory = util::getMemoryStats();
+            uint64_t totalBytes = 0;
+            for (const auto bytes : memory.currentBytes) {
+                totalBytes += bytes;
+            }
+            if (totalBytes > maxMemoryMB * 1024 * 1024) {
+                fail("tracked memory " + std::to_string(totalBytes / (1024 * 1024)) +
+                     " MB exceeds " + std::to_string(maxMemoryMB) + " MB");
+                return false;
+            }
+        }
+        return true;
+    };
+
+    // Each instance steps through the trace on its own timer, rendering a
+    // still frame per keyframe; the next keyframe is scheduled only once the
+    // previous render completed, so a slow render shows up as fewer frames,
+    // never as overlapping renderStill calls.
+    struct Instance {
+        Map* map = nullptr;
+        std::size_t keyframe = 0;
+        uint32_t loopsRemaining = 0;
+        util::Timer timer;
+    };
+
+    std::vector<std::unique_ptr<Instance>> running;
+    std::size_t finished = 0;
+
+    std::function<void (Instance&)> scheduleNext = [&](Instance& instance) {
+        if (instance.keyframe == trace.size()) {
+            instance.keyframe = 0;
+            if (--instance.loopsRemaining == 0) {
+                if (++finished == running.size()) {
+                    loop.stop();
+                }
+                return;
+            }
+        }
+
+        const Keyframe& keyframe = trace[instance.keyframe];
+        const double previousTime = instance.keyframe > 0 ? trace[instance.keyframe - 1].time : 0;
+        const auto delay = Milliseconds(
+            static_cast<int64_t>(std::max(0.0, keyframe.time - previousTime) * 1000 / speed));
+
+        Instance* self = &instance;
+        instance.timer.start(delay, Duration::zero(), [&, self] {
+            const Keyframe& frame = trace[self->keyframe];
+            self->map->setLatLngZoom({ frame.lat, frame.lon }, frame.zoom);
+            self->map->setBearing(frame.bearing);
+            self->map->setPitch(frame.pitch);
+
+            self->map->renderStill(view, [&, self](std::exception_ptr error) {
+                try {
+                    if (error) {
+                        std::rethrow_exception(error);
+                    }
+                } catch(std::exception& e) {
+                    fail(std::string("render error: ") + e.what());
+                    return;
+                }
+
+                framesRendered++;
+                self->keyframe++;
+                if (checkInvariants()) {
+                    scheduleNext(*self);
+                }
+            });
+        });
+    };
+
+    for (auto& map : maps) {
+        auto instance = std::make_unique<Instance>();
+        instance->map = map.get();
+        instance->loopsRemaining = loops;
+        running.push_back(std::move(instance));
+    }
+    for (auto& instance : running) {
+        scheduleNext(*instance);
+    }
+
+    loop.run();
+
+    const auto latency = util::getTileLatencyStats();
+    const auto memory = util::getMemoryStats();
+
+    static const std::array<const char*, TileLatencyStats::stageCount> stageNames {{
+        "network", "layout", "placement", "upload", "raster decode"
+    }};
+    static const std::array<const char*, MemoryStats::categoryCount> categoryNames {{
+        "buckets", "atlases", "tile cache", "database"
+    }};
+
+    std::cout << framesRendered << " frames across " << instances << " instance(s)" << std::endl;
+    for (std::size_t i = 0; i < latency.stages.size(); i++) {
+        const auto& histogram = latency.stages[i];
+        if (histogram.samples == 0) {
+            continue;
+        }
+        const uint64_t p99 = percentileMilliseconds(histogram, 0.99);
+        std::cout << stageNames[i] << ": " << histogram.samples << " samples, p50 <= "
+                  << percentileMilliseconds(histogram, 0.5) << " ms, p99 <= " << p99
+                  << " ms, max " << histogram.maxMilliseconds << " ms" << std::endl;
+
+        // Network latency is whatever the trace injected; only processing
+        // stages are held to the ceiling.
+        if (maxP99 > 0 && i != static_cast<std::size_t>(TileStage::Network) && p99 > maxP99) {
+            std::cout << "Invariant violated: " << stageNames[i] << " p99 " << p99
+                      << " ms exceeds " << maxP99 << " ms" << std::endl;
+            exitCode = 1;
+        }
+    }
+    for (std::size_t i = 0; i < memory.peakBytes.size(); i++) {
+        std::cout << categoryNames[i] << ": peak " << memory.peakBytes[i] / 1024 << " KB"
+                  << std::endl;
+    }
+
+    return exitCode;
+}
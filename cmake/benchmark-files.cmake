@@ -1,20 +1,42 @@
 # Do not edit. Regenerate this with ./scripts/generate-benchmark-files.sh
 
 set(MBGL_BENCHMARK_FILES
+    # algorithm
+    benchmark/algorithm/update_renderables.benchmark.cpp
+
     # api
     benchmark/api/query.benchmark.cpp
+    benchmark/api/render.benchmark.cpp
 
     # include/mbgl
     benchmark/include/mbgl/benchmark.hpp
 
     # parse
     benchmark/parse/filter.benchmark.cpp
+    benchmark/parse/function.benchmark.cpp
+
+    # renderer
+    benchmark/renderer/line_bucket.benchmark.cpp
 
     # src
     benchmark/src/main.cpp
 
     # src/mbgl/benchmark
     benchmark/src/mbgl/benchmark/benchmark.cpp
+    benchmark/src/mbgl/benchmark/regression_gate.cpp
+    benchmark/src/mbgl/benchmark/regression_gate.hpp
+    benchmark/src/mbgl/benchmark/synthetic_tile.cpp
+    benchmark/src/mbgl/benchmark/synthetic_tile.hpp
     benchmark/src/mbgl/benchmark/util.cpp
     benchmark/src/mbgl/benchmark/util.hpp
+
+    # text
+    benchmark/text/collision_tile.benchmark.cpp
+
+    # tile
+    benchmark/tile/tile_pipeline.benchmark.cpp
+
+    # util
+    benchmark/util/mat4.benchmark.cpp
+    benchmark/util/premultiply.benchmark.cpp
 )
@@ -18,6 +18,7 @@ target_link_libraries(mbgl-benchmark
 )
 
 target_add_mason_package(mbgl-benchmark PRIVATE benchmark)
+target_add_mason_package(mbgl-benchmark PRIVATE protozero)
 target_add_mason_package(mbgl-benchmark PRIVATE rapidjson)
 
 mbgl_platform_benchmark()
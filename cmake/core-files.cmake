@@ -7,13 +7,19 @@ set(MBGL_CORE_FILES
     src/mbgl/actor/actor.hpp
     src/mbgl/actor/actor_ref.hpp
     src/mbgl/actor/mailbox.cpp
+    src/mbgl/actor/message.cpp
     src/mbgl/actor/message.hpp
+    src/mbgl/actor/replay_scheduler.cpp
+    src/mbgl/actor/replay_scheduler.hpp
+    src/mbgl/actor/task.hpp
 
     # algorithm
+    src/mbgl/algorithm/clip_id_cache.hpp
     src/mbgl/algorithm/covered_by_children.hpp
     src/mbgl/algorithm/generate_clip_ids.cpp
     src/mbgl/algorithm/generate_clip_ids.hpp
     src/mbgl/algorithm/generate_clip_ids_impl.hpp
+    src/mbgl/algorithm/tile_eviction.hpp
     src/mbgl/algorithm/update_renderables.hpp
 
     # annotation
@@ -64,10 +70,12 @@ set(MBGL_CORE_FILES
     src/mbgl/gl/draw_mode.hpp
     src/mbgl/gl/extension.hpp
     src/mbgl/gl/features.hpp
+    src/mbgl/gl/fence_sync_extension.hpp
     src/mbgl/gl/framebuffer.hpp
     src/mbgl/gl/gl.cpp
     src/mbgl/gl/gl.hpp
     src/mbgl/gl/index_buffer.hpp
+    src/mbgl/gl/instanced_arrays_extension.hpp
     src/mbgl/gl/object.cpp
     src/mbgl/gl/object.hpp
     src/mbgl/gl/primitives.hpp
@@ -80,6 +88,7 @@ set(MBGL_CORE_FILES
     src/mbgl/gl/stencil_mode.cpp
     src/mbgl/gl/stencil_mode.hpp
     src/mbgl/gl/texture.hpp
+    src/mbgl/gl/timer_query_extension.hpp
     src/mbgl/gl/types.hpp
     src/mbgl/gl/uniform.cpp
     src/mbgl/gl/uniform.hpp
@@ -111,7 +120,11 @@ set(MBGL_CORE_FILES
     include/mbgl/map/view.hpp
     src/mbgl/map/backend.cpp
     src/mbgl/map/backend_scope.cpp
+    src/mbgl/map/feature_query.cpp
+    src/mbgl/map/feature_query.hpp
     src/mbgl/map/map.cpp
+    src/mbgl/map/session_snapshot.cpp
+    src/mbgl/map/session_snapshot.hpp
     src/mbgl/map/transform.cpp
     src/mbgl/map/transform.hpp
     src/mbgl/map/transform_state.cpp
@@ -139,11 +152,13 @@ set(MBGL_CORE_FILES
     src/mbgl/programs/collision_box_program.cpp
     src/mbgl/programs/collision_box_program.hpp
     src/mbgl/programs/debug_program.hpp
+    src/mbgl/programs/fill_extrusion_program.hpp
     src/mbgl/programs/fill_program.cpp
     src/mbgl/programs/fill_program.hpp
     src/mbgl/programs/line_program.cpp
     src/mbgl/programs/line_program.hpp
     src/mbgl/programs/program.hpp
+    src/mbgl/programs/program_list.hpp
     src/mbgl/programs/program_parameters.hpp
     src/mbgl/programs/programs.hpp
     src/mbgl/programs/raster_program.cpp
@@ -160,8 +175,14 @@ set(MBGL_CORE_FILES
     src/mbgl/renderer/debug_bucket.hpp
     src/mbgl/renderer/fill_bucket.cpp
     src/mbgl/renderer/fill_bucket.hpp
+    src/mbgl/renderer/fill_extrusion_bucket.cpp
+    src/mbgl/renderer/fill_extrusion_bucket.hpp
+    src/mbgl/renderer/frame_damage.cpp
+    src/mbgl/renderer/frame_damage.hpp
     src/mbgl/renderer/frame_history.cpp
     src/mbgl/renderer/frame_history.hpp
+    src/mbgl/renderer/frame_pacer.cpp
+    src/mbgl/renderer/frame_pacer.hpp
     src/mbgl/renderer/line_bucket.cpp
     src/mbgl/renderer/line_bucket.hpp
     src/mbgl/renderer/paint_parameters.hpp
@@ -172,6 +193,7 @@ set(MBGL_CORE_FILES
     src/mbgl/renderer/painter_clipping.cpp
     src/mbgl/renderer/painter_debug.cpp
     src/mbgl/renderer/painter_fill.cpp
+    src/mbgl/renderer/painter_fill_extrusion.cpp
     src/mbgl/renderer/painter_line.cpp
     src/mbgl/renderer/painter_raster.cpp
     src/mbgl/renderer/painter_symbol.cpp
@@ -193,6 +215,8 @@ set(MBGL_CORE_FILES
     src/mbgl/shaders/debug.hpp
     src/mbgl/shaders/fill.cpp
     src/mbgl/shaders/fill.hpp
+    src/mbgl/shaders/fill_extrusion.cpp
+    src/mbgl/shaders/fill_extrusion.hpp
     src/mbgl/shaders/fill_outline.cpp
     src/mbgl/shaders/fill_outline.hpp
     src/mbgl/shaders/fill_outline_pattern.cpp
@@ -228,6 +252,7 @@ set(MBGL_CORE_FILES
     # storage
     include/mbgl/storage/default_file_source.hpp
     include/mbgl/storage/file_source.hpp
+    include/mbgl/storage/network_quality.hpp
     include/mbgl/storage/network_status.hpp
     include/mbgl/storage/offline.hpp
     include/mbgl/storage/online_file_source.hpp
@@ -236,6 +261,7 @@ set(MBGL_CORE_FILES
     src/mbgl/storage/asset_file_source.hpp
     src/mbgl/storage/http_file_source.hpp
     src/mbgl/storage/local_file_source.hpp
+    src/mbgl/storage/network_quality.cpp
     src/mbgl/storage/network_status.cpp
     src/mbgl/storage/resource.cpp
     src/mbgl/storage/response.cpp
@@ -257,9 +283,12 @@ set(MBGL_CORE_FILES
     src/mbgl/style/cascade_parameters.hpp
     src/mbgl/style/class_dictionary.cpp
     src/mbgl/style/class_dictionary.hpp
+    src/mbgl/style/compiled_filter.cpp
+    src/mbgl/style/compiled_filter.hpp
     src/mbgl/style/cross_faded_property_evaluator.cpp
     src/mbgl/style/cross_faded_property_evaluator.hpp
     src/mbgl/style/data_driven_property_evaluator.hpp
+    src/mbgl/style/feature_state.hpp
     src/mbgl/style/group_by_layout.cpp
     src/mbgl/style/group_by_layout.hpp
     src/mbgl/style/layer.cpp
@@ -308,6 +337,7 @@ set(MBGL_CORE_FILES
     # style/function
     include/mbgl/style/function/camera_function.hpp
     include/mbgl/style/function/categorical_stops.hpp
+    include/mbgl/style/function/compiled_stops.hpp
     include/mbgl/style/function/composite_categorical_stops.hpp
     include/mbgl/style/function/composite_exponential_stops.hpp
     include/mbgl/style/function/composite_function.hpp
@@ -325,6 +355,7 @@ set(MBGL_CORE_FILES
     include/mbgl/style/layers/custom_layer.hpp
     include/mbgl/style/layers/fill_extrusion_layer.hpp
     include/mbgl/style/layers/fill_layer.hpp
+    include/mbgl/style/layers/heatmap_layer.hpp
     include/mbgl/style/layers/line_layer.hpp
     include/mbgl/style/layers/raster_layer.hpp
     include/mbgl/style/layers/symbol_layer.hpp
@@ -351,6 +382,11 @@ set(MBGL_CORE_FILES
     src/mbgl/style/layers/fill_layer_impl.hpp
     src/mbgl/style/layers/fill_layer_properties.cpp
     src/mbgl/style/layers/fill_layer_properties.hpp
+    src/mbgl/style/layers/heatmap_layer.cpp
+    src/mbgl/style/layers/heatmap_layer_impl.cpp
+    src/mbgl/style/layers/heatmap_layer_impl.hpp
+    src/mbgl/style/layers/heatmap_layer_properties.cpp
+    src/mbgl/style/layers/heatmap_layer_properties.hpp
     src/mbgl/style/layers/line_layer.cpp
     src/mbgl/style/layers/line_layer_impl.cpp
     src/mbgl/style/layers/line_layer_impl.hpp
@@ -389,6 +425,8 @@ set(MBGL_CORE_FILES
     src/mbgl/text/collision_feature.hpp
     src/mbgl/text/collision_tile.cpp
     src/mbgl/text/collision_tile.hpp
+    src/mbgl/text/distance_transform.cpp
+    src/mbgl/text/distance_transform.hpp
     src/mbgl/text/get_anchors.cpp
     src/mbgl/text/get_anchors.hpp
     src/mbgl/text/glyph.cpp
@@ -401,13 +439,20 @@ set(MBGL_CORE_FILES
     src/mbgl/text/glyph_range.hpp
     src/mbgl/text/glyph_set.cpp
     src/mbgl/text/glyph_set.hpp
+    src/mbgl/text/local_glyph_rasterizer.hpp
     src/mbgl/text/placement_config.hpp
     src/mbgl/text/quads.cpp
     src/mbgl/text/quads.hpp
     src/mbgl/text/shaping.cpp
     src/mbgl/text/shaping.hpp
+    src/mbgl/text/shaping_cache.cpp
+    src/mbgl/text/shaping_cache.hpp
 
     # tile
+    src/mbgl/tile/attribute_index.cpp
+    src/mbgl/tile/attribute_index.hpp
+    src/mbgl/tile/binary_tile_data.cpp
+    src/mbgl/tile/binary_tile_data.hpp
     src/mbgl/tile/geojson_tile.cpp
     src/mbgl/tile/geojson_tile.hpp
     src/mbgl/tile/geometry_tile.cpp
@@ -431,6 +476,7 @@ set(MBGL_CORE_FILES
     src/mbgl/tile/tile_observer.hpp
     src/mbgl/tile/vector_tile.cpp
     src/mbgl/tile/vector_tile.hpp
+    src/mbgl/tile/vector_tile_data.hpp
 
     # util
     include/mbgl/util/async_request.hpp
@@ -451,18 +497,25 @@ set(MBGL_CORE_FILES
     include/mbgl/util/geometry.hpp
     include/mbgl/util/ignore.hpp
     include/mbgl/util/image.hpp
+    include/mbgl/util/image_buffer_pool.hpp
     include/mbgl/util/interpolate.hpp
     include/mbgl/util/logging.hpp
+    include/mbgl/util/memory_stats.hpp
     include/mbgl/util/noncopyable.hpp
     include/mbgl/util/optional.hpp
+    include/mbgl/util/performance_counters.hpp
     include/mbgl/util/platform.hpp
     include/mbgl/util/projection.hpp
     include/mbgl/util/range.hpp
+    include/mbgl/util/render_statistics.hpp
     include/mbgl/util/run_loop.hpp
     include/mbgl/util/size.hpp
+    include/mbgl/util/startup_timeline.hpp
     include/mbgl/util/string.hpp
+    include/mbgl/util/tile_latency.hpp
     include/mbgl/util/tileset.hpp
     include/mbgl/util/timer.hpp
+    include/mbgl/util/trace.hpp
     include/mbgl/util/traits.hpp
     include/mbgl/util/unitbezier.hpp
     include/mbgl/util/util.hpp
@@ -470,10 +523,14 @@ set(MBGL_CORE_FILES
     include/mbgl/util/work_request.hpp
     include/mbgl/util/work_task.hpp
     include/mbgl/util/work_task_impl.hpp
+    src/mbgl/util/arena.cpp
+    src/mbgl/util/arena.hpp
     src/mbgl/util/chrono.cpp
     src/mbgl/util/clip_id.cpp
     src/mbgl/util/clip_id.hpp
     src/mbgl/util/color.cpp
+    src/mbgl/util/compressed_image.cpp
+    src/mbgl/util/compressed_image.hpp
     src/mbgl/util/compression.cpp
     src/mbgl/util/constants.cpp
     src/mbgl/util/convert.cpp
@@ -491,12 +548,17 @@ set(MBGL_CORE_FILES
     src/mbgl/util/http_timeout.hpp
     src/mbgl/util/i18n.cpp
     src/mbgl/util/i18n.hpp
+    src/mbgl/util/image_buffer_pool.cpp
     src/mbgl/util/indexed_tuple.hpp
+    src/mbgl/util/interned_string.cpp
+    src/mbgl/util/interned_string.hpp
     src/mbgl/util/interpolate.cpp
     src/mbgl/util/intersection_tests.cpp
     src/mbgl/util/intersection_tests.hpp
     src/mbgl/util/io.cpp
     src/mbgl/util/io.hpp
+    src/mbgl/util/itoa.cpp
+    src/mbgl/util/itoa.hpp
     src/mbgl/util/logging.cpp
     src/mbgl/util/mapbox.cpp
     src/mbgl/util/mapbox.hpp
@@ -507,12 +569,17 @@ set(MBGL_CORE_FILES
     src/mbgl/util/mat4.cpp
     src/mbgl/util/mat4.hpp
     src/mbgl/util/math.hpp
+    src/mbgl/util/memory_stats.cpp
     src/mbgl/util/offscreen_texture.cpp
     src/mbgl/util/offscreen_texture.hpp
+    src/mbgl/util/performance_counters.cpp
     src/mbgl/util/premultiply.cpp
     src/mbgl/util/premultiply.hpp
     src/mbgl/util/rapidjson.hpp
     src/mbgl/util/rect.hpp
+    src/mbgl/util/shared_parse_cache.hpp
+    src/mbgl/util/small_vector.hpp
+    src/mbgl/util/startup_timeline.cpp
     src/mbgl/util/std.hpp
     src/mbgl/util/stopwatch.cpp
     src/mbgl/util/stopwatch.hpp
@@ -524,7 +591,9 @@ set(MBGL_CORE_FILES
     src/mbgl/util/tile_coordinate.hpp
     src/mbgl/util/tile_cover.cpp
     src/mbgl/util/tile_cover.hpp
+    src/mbgl/util/tile_latency.cpp
     src/mbgl/util/token.hpp
+    src/mbgl/util/trace.cpp
     src/mbgl/util/type_list.hpp
     src/mbgl/util/url.cpp
     src/mbgl/util/url.hpp
@@ -9,6 +9,8 @@ target_sources(mbgl-glfw
     PRIVATE platform/glfw/settings_json.cpp
     PRIVATE platform/default/mbgl/util/default_styles.hpp
     PRIVATE platform/default/mbgl/util/default_styles.cpp
+    PRIVATE platform/default/mbgl/util/frame_scheduler.hpp
+    PRIVATE platform/default/mbgl/util/frame_scheduler.cpp
 )
 
 target_compile_options(mbgl-glfw
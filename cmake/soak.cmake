@@ -0,0 +1,22 @@
+add_executable(mbgl-soak
+    bin/soak.cpp
+)
+
+target_compile_options(mbgl-soak
+    PRIVATE -fvisibility-inlines-hidden
+)
+
+target_include_directories(mbgl-soak
+    PRIVATE platform/default
+)
+
+target_link_libraries(mbgl-soak
+    PRIVATE mbgl-core
+)
+
+target_add_mason_package(mbgl-soak PRIVATE boost)
+target_add_mason_package(mbgl-soak PRIVATE boost_libprogram_options)
+
+mbgl_platform_soak()
+
+create_source_groups(mbgl-soak)
@@ -4,11 +4,15 @@ set(MBGL_TEST_FILES
     # actor
     test/actor/actor.test.cpp
     test/actor/actor_ref.test.cpp
+    test/actor/replay_scheduler.test.cpp
+    test/actor/task.test.cpp
 
     # algorithm
+    test/algorithm/clip_id_cache.test.cpp
     test/algorithm/covered_by_children.test.cpp
     test/algorithm/generate_clip_ids.test.cpp
     test/algorithm/mock.hpp
+    test/algorithm/tile_eviction.test.cpp
     test/algorithm/update_renderables.test.cpp
 
     # api
@@ -25,12 +29,14 @@ set(MBGL_TEST_FILES
     # gl
     test/gl/bucket.test.cpp
     test/gl/object.test.cpp
+    test/gl/vertex_buffer.test.cpp
 
     # include/mbgl
     test/include/mbgl/test.hpp
 
     # map
     test/map/map.test.cpp
+    test/map/session_snapshot.test.cpp
     test/map/transform.test.cpp
 
     # math
@@ -41,6 +47,9 @@ set(MBGL_TEST_FILES
     # programs
     test/programs/binary_program.test.cpp
 
+    # renderer
+    test/renderer/frame_damage.test.cpp
+
     # sprite
     test/sprite/sprite_atlas.test.cpp
     test/sprite/sprite_image.test.cpp
@@ -69,6 +78,7 @@ set(MBGL_TEST_FILES
     test/storage/headers.test.cpp
     test/storage/http_file_source.test.cpp
     test/storage/local_file_source.test.cpp
+    test/storage/network_quality.test.cpp
     test/storage/offline.test.cpp
     test/storage/offline_database.test.cpp
     test/storage/offline_download.test.cpp
@@ -83,10 +93,12 @@ set(MBGL_TEST_FILES
     test/style/conversion/stringify.test.cpp
 
     # style
+    test/style/compiled_filter.test.cpp
     test/style/filter.test.cpp
 
     # style/function
     test/style/function/camera_function.test.cpp
+    test/style/function/compiled_stops.test.cpp
     test/style/function/composite_function.test.cpp
     test/style/function/source_function.test.cpp
 
@@ -100,12 +112,15 @@ set(MBGL_TEST_FILES
     test/style/tile_source.test.cpp
 
     # text
+    test/text/distance_transform.test.cpp
     test/text/glyph_atlas.test.cpp
     test/text/glyph_pbf.test.cpp
     test/text/quads.test.cpp
 
     # tile
     test/tile/annotation_tile.test.cpp
+    test/tile/attribute_index.test.cpp
+    test/tile/binary_tile_data.test.cpp
     test/tile/geojson_tile.test.cpp
     test/tile/geometry_tile_data.test.cpp
     test/tile/raster_tile.test.cpp
@@ -114,23 +129,38 @@ set(MBGL_TEST_FILES
     test/tile/vector_tile.test.cpp
 
     # util
+    test/util/arena.test.cpp
     test/util/async_task.test.cpp
+    test/util/compressed_image.test.cpp
+    test/util/compression.test.cpp
     test/util/geo.test.cpp
     test/util/http_timeout.test.cpp
     test/util/image.test.cpp
+    test/util/image_buffer_pool.test.cpp
+    test/util/interned_string.test.cpp
+    test/util/itoa.test.cpp
     test/util/mapbox.test.cpp
+    test/util/mat4.test.cpp
     test/util/memory.test.cpp
+    test/util/memory_stats.test.cpp
     test/util/merge_lines.test.cpp
     test/util/number_conversions.test.cpp
     test/util/offscreen_texture.test.cpp
+    test/util/performance_counters.test.cpp
     test/util/projection.test.cpp
     test/util/run_loop.test.cpp
+    test/util/shared_parse_cache.test.cpp
+    test/util/small_vector.test.cpp
+    test/util/startup_timeline.test.cpp
     test/util/text_conversions.test.cpp
     test/util/thread.test.cpp
     test/util/thread_local.test.cpp
     test/util/tile_cover.test.cpp
+    test/util/tile_latency.test.cpp
     test/util/timer.test.cpp
     test/util/token.test.cpp
+    test/util/trace.test.cpp
     test/util/url.test.cpp
+    test/util/utf.test.cpp
     test/util/work_queue.test.cpp
 )
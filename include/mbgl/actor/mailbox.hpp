@@ -1,8 +1,8 @@
 #pragma once
 
+#include <atomic>
 #include <memory>
 #include <mutex>
-#include <queue>
 
 namespace mbgl {
 
@@ -11,23 +11,64 @@ class Message;
 
 class Mailbox : public std::enable_shared_from_this<Mailbox> {
 public:
+    // Scheduling class for schedulers that support it; classes are served
+    // strictly in declaration order. `RenderCritical` work blocks the
+    // current frame (e.g. parsing a tile the viewport is waiting on),
+    // `Regular` work is visible but not frame-blocking, `Prefetch` is
+    // speculative work for tiles that may become visible, and `Low` is
+    // background housekeeping. Raising the priority of a mailbox whose
+    // wakeup is already queued takes effect immediately; lowering it takes
+    // effect the next time the mailbox is scheduled.
+    enum class Priority : uint8_t {
+        RenderCritical,
+        Regular,
+        Prefetch,
+        Low,
+    };
+
     Mailbox(Scheduler&);
+    ~Mailbox();
 
     void push(std::unique_ptr<Message>);
 
+    void setPriority(Priority priority_) { priority = priority_; }
+    Priority getPriority() const { return priority; }
+
     void close();
     void receive();
 
+    // Processes exactly one message. Used by schedulers that need
+    // deterministic wakeup granularity (see ReplayScheduler); the regular
+    // drain budget includes a wall-clock cap that varies run to run.
+    void receiveOne();
+
     static void maybeReceive(std::weak_ptr<Mailbox>);
+    static void maybeReceiveOne(std::weak_ptr<Mailbox>);
 
 private:
+    // Messages live in an intrusive MPSC linked queue (Vyukov-style):
+    // producers enqueue with a single atomic exchange, and the scheduler
+    // guarantees at most one concurrent receive(), which is the lone consumer.
+    struct Node;
+
+    std::unique_ptr<Message> pop();
+    void receive(std::size_t maximumMessages, bool useTimeBudget);
+
     Scheduler& scheduler;
 
+    std::atomic<Priority> priority { Priority::Regular };
+
     std::mutex closingMutex;
     bool closing { false };
 
-    std::mutex queueMutex;
-    std::queue<std::unique_ptr<Message>> queue;
+    std::atomic<Node*> tail;
+    Node* head;
+
+    // Pushed-but-unprocessed message count. The push that raises it from zero
+    // schedules the mailbox, and a receive that leaves it above zero
+    // re-schedules it, so exactly one scheduling token is outstanding
+    // whenever the queue is non-empty.
+    std::atomic<std::size_t> pendingMessages { 0 };
 };
 
 } // namespace mbgl
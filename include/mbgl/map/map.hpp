@@ -8,6 +8,10 @@
 #include <mbgl/util/feature.hpp>
 #include <mbgl/util/noncopyable.hpp>
 #include <mbgl/util/size.hpp>
+#include <mbgl/util/memory_stats.hpp>
+#include <mbgl/util/render_statistics.hpp>
+#include <mbgl/util/startup_timeline.hpp>
+#include <mbgl/util/tile_latency.hpp>
 #include <mbgl/annotation/annotation.hpp>
 #include <mbgl/style/transition_options.hpp>
 #include <mbgl/map/camera.hpp>
@@ -57,6 +61,15 @@ public:
     // Main render function.
     void render(View&);
 
+    // Renders the best frame available right now, regardless of map mode, and
+    // returns whether it was complete (style loaded, no transitions or
+    // animations in progress). Unlike render(), no follow-up repaint is
+    // scheduled; hosts that own their frame loop call this every frame and
+    // keep calling while it returns false. A non-zero budget bounds
+    // discretionary per-frame work (e.g. tile buffer uploads), so a frame
+    // never exceeds the host's deadline by much.
+    bool renderOnce(View&, Milliseconds budget = Milliseconds(0));
+
     // Styling
     void addClass(const std::string&);
     void removeClass(const std::string&);
@@ -168,6 +181,11 @@ public:
     void updateAnnotation(AnnotationID, const Annotation&);
     void removeAnnotation(AnnotationID);
 
+    // Add or remove a batch of annotations with a single map update, rather
+    // than one per annotation.
+    AnnotationIDs addAnnotations(const std::vector<Annotation>&);
+    void removeAnnotations(const AnnotationIDs&);
+
     // Sources
     std::vector<style::Source*> getSources();
     style::Source* getSource(const std::string& sourceID);
@@ -179,6 +197,7 @@ public:
     style::Layer* getLayer(const std::string& layerID);
     void addLayer(std::unique_ptr<style::Layer>, const optional<std::string>& beforeLayerID = {});
     std::unique_ptr<style::Layer> removeLayer(const std::string& layerID);
+    void moveLayer(const std::string& layerID, const optional<std::string>& beforeLayerID = {});
 
     // Add image, bound to the style
     void addImage(const std::string&, std::unique_ptr<const SpriteImage>);
@@ -196,7 +215,28 @@ public:
     std::vector<Feature> queryRenderedFeatures(const ScreenCoordinate&, const RenderedQueryOptions& options = {});
     std::vector<Feature> queryRenderedFeatures(const ScreenBox&,        const RenderedQueryOptions& options = {});
 
-    AnnotationIDs queryPointAnnotations(const ScreenBox&);
+    // Asynchronous variant for large queries: snapshots the currently
+    // rendered state, executes the per-tile lookups on the worker scheduler,
+    // and invokes the callback on the map thread. Issuing a new asynchronous
+    // query supersedes a pending one, whose callback is then never invoked.
+    using QueryFeaturesCallback = std::function<void (std::vector<Feature>)>;
+    void queryRenderedFeatures(const ScreenBox&, const RenderedQueryOptions&, QueryFeaturesCallback);
+
+    // Point annotations within the box, optionally inflated by `radius`
+    // pixels on every side (a finger-sized tap target around a tap point).
+    AnnotationIDs queryPointAnnotations(const ScreenBox&, double radius = 0);
+
+    // Session snapshots. createSessionSnapshot serializes the camera, the
+    // style's identity, and the currently loaded vector tiles in the
+    // pre-decoded binary tile format; it returns an empty string when no
+    // style is loaded. restoreSessionSnapshot applies the camera immediately
+    // and, once a matching style has loaded, seeds the saved tiles into its
+    // sources so the first frame lays out without a network fetch or pbf
+    // decode; the regular request path refreshes them behind it. A snapshot
+    // taken against a different style, or written by an incompatible build,
+    // is silently dropped.
+    std::string createSessionSnapshot() const;
+    void restoreSessionSnapshot(const std::string&);
 
     // Memory
     void setSourceTileCacheSize(size_t);
@@ -207,6 +247,35 @@ public:
     void cycleDebugOptions();
     MapDebugOptions getDebug() const;
 
+    // Per-layer GPU render times, in milliseconds, for the most recent frame
+    // whose timer queries have resolved. Collected only while the
+    // MapDebugOptions::GPUTiming flag is set and the driver supports GPU
+    // timer queries; empty otherwise.
+    std::vector<std::pair<std::string, double>> getGPULayerTimings() const;
+
+    // Counters of the GL work issued by the most recently rendered frame:
+    // draw calls, program switches, and texture binds that survived state
+    // deduplication, and bytes uploaded to the GPU.
+    RenderStatistics getRenderStatistics() const;
+
+    // Tile pipeline latency histograms — network, layout, placement, upload —
+    // aggregated process-wide since startup or the last reset. Intended for
+    // telemetry: sample at session end, reset at session start.
+    TileLatencyStats getTileLatencyStats() const;
+    void resetTileLatencyStats();
+
+    // Per-subsystem heap breakdown — buckets, atlases, tile cache, database —
+    // aggregated process-wide. Peaks persist until resetMemoryPeaks().
+    MemoryStats getMemoryStats() const;
+    void resetMemoryPeaks();
+
+    // Cold-start milestones — file source ready, style parsed, first tile
+    // requested/parsed/uploaded, first full frame — relative to library load
+    // or the last resetStartupTimeline(). Only the first occurrence of each
+    // milestone is recorded.
+    StartupTimeline getStartupTimeline() const;
+    void resetStartupTimeline();
+
     bool isFullyLoaded() const;
     void dumpDebugLogs() const;
 
@@ -49,6 +49,14 @@ enum class MapDebugOptions : EnumType {
     StencilClip = 1 << 6,
     DepthBuffer = 1 << 7,
 #endif // MBGL_USE_GLES2
+    // Measures the GPU time spent in each layer's draws with timer queries,
+    // where the driver supports them. Results are retrieved asynchronously;
+    // see Map::getGPULayerTimings().
+    GPUTiming  = 1 << 8,
+    // Draws an on-screen readout of live performance counters: a frame time
+    // graph, the GL work of the last frame, the worker queue depth, and
+    // cache hit rates.
+    PerformanceHUD = 1 << 9,
 };
 
 constexpr MapDebugOptions operator|(MapDebugOptions lhs, MapDebugOptions rhs) {
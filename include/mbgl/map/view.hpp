@@ -15,6 +15,14 @@ public:
     // calling .bind() repeatedly is a no-op and that the appropriate gl::Context values are
     // set to the current state.
     virtual void bind() = 0;
+
+    // Returns the age of the currently bound buffer in frames: 1 means it still
+    // holds the previous frame, 2 the one before that, and so on. 0 means its
+    // content is undefined and the whole buffer must be redrawn. Views backed by
+    // surfaces with EGL_EXT_buffer_age (or an equivalent) can override this to
+    // enable partial repaints; the default keeps them disabled. Only valid after
+    // bind() has been called for the current frame.
+    virtual uint32_t getBufferAge() const { return 0; }
 };
 
 } // namespace mbgl
@@ -40,6 +40,30 @@ public:
 
     std::unique_ptr<AsyncRequest> request(const Resource&, Callback) override;
 
+    /*
+     * Parsed TileJSON manifests, persisted in the offline database across
+     * sessions. The lookup is synchronous (a single indexed read on the
+     * database thread), so a source whose manifest was seen in an earlier
+     * session can request tiles immediately instead of waiting out the
+     * manifest round trip; the raw manifest is still revalidated by the
+     * caller through the regular request path.
+     */
+    optional<Tileset> getCachedTileset(const std::string& url) override;
+    void putCachedTileset(const std::string& url, const Tileset&, optional<Timestamp> expires) override;
+
+    /*
+     * Warm the cache with everything a style needs except tiles.
+     *
+     * Walks the style's dependency graph in the background — the style
+     * document, its TileJSON and GeoJSON sources, the sprite, and every
+     * glyph range of every font stack — and stores the responses in the
+     * ambient cache, so the first map open of a known style needs no
+     * network. Resources already cached are not re-fetched. Requests are
+     * issued at low priority and do not compete with interactive map loads.
+     * Preloading the same style URL again restarts the walk.
+     */
+    void preloadStyle(const std::string& styleURL, float pixelRatio = 1.0f);
+
     /*
      * Retrieve all regions in the offline database.
      *
@@ -109,12 +133,60 @@ public:
      */
     void deleteOfflineRegion(OfflineRegion&&, std::function<void (std::exception_ptr)>);
 
+    /*
+     * Merge a secondary offline database — a pre-baked pack built with the
+     * same schema, e.g. one distributed alongside the application for fleet
+     * provisioning — into the main database, without re-downloading any of
+     * its resources.
+     *
+     * Resources already present locally are kept; the pack's regions are
+     * re-created here and passed to the callback, which will be executed on
+     * the database thread; it is the responsibility of the SDK bindings to
+     * re-execute a user-provided callback on the main thread.
+     */
+    void mergeOfflineDatabase(const std::string& sideDatabasePath,
+                              std::function<void (std::exception_ptr,
+                                                  optional<std::vector<OfflineRegion>>)>);
+
     /*
      * Changing or bypassing this limit without permission from Mapbox is prohibited
      * by the Mapbox Terms of Service.
      */
     void setOfflineMapboxTileCountLimit(uint64_t) const;
 
+    /*
+     * Set the size in bytes of the in-memory cache of recently used responses.
+     *
+     * This cache sits in front of the offline database and avoids disk reads
+     * for resources requested again shortly after they were last seen, e.g.
+     * tiles revisited when zooming out and back in. Setting the size to zero
+     * disables it.
+     */
+    void setMaximumMemoryCacheSize(uint64_t) const;
+
+    /*
+     * Set the stale-while-revalidate window for cached network resources.
+     *
+     * A resource stale by less than this window keeps being served from cache
+     * and is revalidated only once the window closes, batching its conditional
+     * request with others that went stale around the same time — e.g. after
+     * the application resumes. Defaults to zero (revalidate as soon as a
+     * resource goes stale).
+     */
+    void setRevalidationWindow(Duration) const;
+
+    /*
+     * Cap network transfer bandwidth for one class of resources, in bytes
+     * per second.
+     *
+     * Budgets are enforced per resource kind with token-bucket scheduling,
+     * so e.g. glyph and sprite fetches can be capped without slowing the
+     * tile fetches sharing a metered link, and low-priority prefetch
+     * traffic within a capped kind always yields to interactive fetches.
+     * A rate of zero removes the cap. Defaults to uncapped for every kind.
+     */
+    void setTransferRateLimit(Resource::Kind, uint64_t bytesPerSecond) const;
+
     /*
      * Pause file request activity.
      *
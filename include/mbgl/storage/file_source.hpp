@@ -3,11 +3,15 @@
 #include <mbgl/storage/response.hpp>
 #include <mbgl/storage/resource.hpp>
 
+#include <mbgl/util/chrono.hpp>
 #include <mbgl/util/noncopyable.hpp>
+#include <mbgl/util/optional.hpp>
 #include <mbgl/util/async_request.hpp>
+#include <mbgl/util/tileset.hpp>
 
 #include <functional>
 #include <memory>
+#include <string>
 
 namespace mbgl {
 
@@ -24,6 +28,16 @@ public:
     // not be executed.
     virtual std::unique_ptr<AsyncRequest> request(const Resource&, Callback) = 0;
 
+    // Parsed TileJSON manifests, cached across sessions so that a source's
+    // tiles can be requested without waiting for the manifest round trip.
+    // Callers that use a cached tileset must still request() the manifest to
+    // revalidate it. File sources without persistent storage keep the
+    // defaults: every lookup misses and stores are dropped.
+    virtual optional<Tileset> getCachedTileset(const std::string&) {
+        return {};
+    }
+    virtual void putCachedTileset(const std::string&, const Tileset&, optional<Timestamp>) {}
+
     // When a file source supports optional requests, it must return true.
     // Optional requests are requests that aren't as urgent, but could be useful, e.g.
     // to cover part of the map while loading. The FileSource should only do cheap actions to
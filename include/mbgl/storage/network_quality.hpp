@@ -0,0 +1,56 @@
+#pragma once
+
+#include <mbgl/util/chrono.hpp>
+
+#include <cstdint>
+#include <mutex>
+
+namespace mbgl {
+
+// Passive estimate of the network quality the process is actually seeing,
+// fed by OnlineFileSource with the size and duration of every completed
+// transfer. Latency and downstream bandwidth are smoothed with exponentially
+// weighted moving averages; Get() folds them into a coarse level the tile
+// pipeline uses to adapt — a poor network shrinks the predictive prefetch
+// window, leans on the cached low-zoom ancestors instead, and backs retries
+// off earlier.
+class NetworkQuality {
+public:
+    enum class Level : uint8_t {
+        // Not enough completed transfers to judge.
+        Unknown,
+        Good,
+        // Noticeably slow (roughly congested 3G): smoothed latency above
+        // 300ms or bandwidth below 128 KB/s.
+        Degraded,
+        // Barely usable (roughly 2G): smoothed latency above one second or
+        // bandwidth below 32 KB/s.
+        Poor,
+    };
+
+    static Level Get();
+
+    // Smoothed completion latency of recent transfers.
+    static Duration GetLatency();
+
+    // Smoothed goodput of recent data-bearing transfers, in bytes per second.
+    static uint64_t GetDownstreamBandwidth();
+
+    // Feeds one completed transfer into the estimate. Callable from any
+    // thread. Small responses (validation hits, empty tiles) update only the
+    // latency average; their duration is dominated by round trips, not
+    // bandwidth.
+    static void RecordTransfer(uint64_t bytes, Duration elapsed);
+
+    // Discards the estimate, e.g. after a connectivity change made it stale.
+    static void Reset();
+
+private:
+    static std::mutex mtx;
+    static double smoothedLatencyMs;
+    static double smoothedBytesPerSecond;
+    static uint32_t latencySamples;
+    static uint32_t bandwidthSamples;
+};
+
+} // namespace mbgl
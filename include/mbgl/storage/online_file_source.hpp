@@ -20,6 +20,28 @@ public:
         std::function<std::unique_ptr<AsyncRequest>(Resource::Kind, std::string&&, std::function<void(std::string&&)>)>;
     void setResourceTransform(ResourceTransform&& cb);
 
+    /*
+     * Set the stale-while-revalidate window. A resource stale by less than
+     * this window keeps being served from cache and is revalidated only once
+     * the window closes, batching its conditional request with others that
+     * went stale around the same time. Defaults to zero (revalidate as soon
+     * as a resource goes stale).
+     */
+    void setRevalidationWindow(Duration);
+
+    /*
+     * Cap the transfer rate for one class of resources, in bytes per second.
+     *
+     * Each capped kind gets a token bucket holding up to one second of
+     * budget; transfers are admitted while the bucket is positive and debit
+     * it with the bytes they actually moved, so sustained traffic of that
+     * kind averages out to the budget. Low-priority requests (e.g. prefetch
+     * traffic) are admitted only while the bucket has headroom to spare, so
+     * they never drain it under interactive fetches of the same kind. A rate
+     * of zero removes the cap. Defaults to uncapped for every kind.
+     */
+    void setTransferRateLimit(Resource::Kind, uint64_t bytesPerSecond);
+
     std::unique_ptr<AsyncRequest> request(const Resource&, Callback) override;
 
 private:
@@ -34,6 +34,14 @@ public:
         Required = true,
     };
 
+    // A relative weight for transports that can prioritize concurrent
+    // transfers, e.g. HTTP/2 stream weights. Low-priority requests still
+    // complete; they just yield bandwidth to regular ones while competing.
+    enum Priority : bool {
+        Regular = false,
+        Low = true,
+    };
+
     Resource(Kind kind_, std::string url_, optional<TileData> tileData_ = {}, Necessity necessity_ = Required)
         : kind(kind_),
           necessity(necessity_),
@@ -58,11 +66,17 @@ public:
 
     Kind kind;
     Necessity necessity;
+    Priority priority = Regular;
     std::string url;
 
     // Includes auxiliary data if this is a tile request.
     optional<TileData> tileData;
 
+    // Accept header value expressing a media-type preference, e.g. WebP
+    // ahead of PNG for raster tiles on platforms whose decoder supports it.
+    // Transports that speak HTTP send it verbatim; others ignore it.
+    optional<std::string> accept = {};
+
     optional<Timestamp> priorModified = {};
     optional<Timestamp> priorExpires = {};
     optional<std::string> priorEtag = {};
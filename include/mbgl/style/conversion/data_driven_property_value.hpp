@@ -26,6 +26,9 @@ struct Converter<DataDrivenPropertyValue<T>> {
             if (!function) {
                 return {};
             }
+            if (optional<T> constant = constantFold(*function)) {
+                return DataDrivenPropertyValue<T>(*constant);
+            }
             return DataDrivenPropertyValue<T>(*function);
         } else {
             optional<CompositeFunction<T>> composite = convert<CompositeFunction<T>>(value, error);
@@ -36,6 +39,9 @@ struct Converter<DataDrivenPropertyValue<T>> {
             if (!source) {
                 return {};
             }
+            if (optional<T> constant = constantFold(*source)) {
+                return DataDrivenPropertyValue<T>(*constant);
+            }
             return DataDrivenPropertyValue<T>(*source);
         }
     }
@@ -260,6 +260,42 @@ struct Converter<SourceFunction<T>> {
     }
 };
 
+// Machine-generated styles commonly expand constants into single-stop
+// functions. Such functions can only ever produce one value, so the
+// PropertyValue converters collapse them back into plain constants, saving
+// the function storage and the per-frame stop lookup.
+
+template <class T>
+optional<T> constantFold(const CameraFunction<T>& function) {
+    // The zoom input is always numeric, so a single exponential or interval
+    // stop applies at every zoom level.
+    return function.stops.match([](const auto& stops) -> optional<T> {
+        if (stops.stops.size() != 1) {
+            return {};
+        }
+        return stops.stops.begin()->second;
+    });
+}
+
+template <class T>
+optional<T> constantFold(const SourceFunction<T>& function) {
+    // A source function falls back to its default value for features that
+    // lack the property (or hold one outside the stop domain), so it is
+    // constant only when a single stop produces that same default.
+    if (!function.defaultValue) {
+        return {};
+    }
+    return function.stops.match(
+        [](const IdentityStops<T>&) -> optional<T> { return {}; },
+        [&](const auto& stops) -> optional<T> {
+            if (stops.stops.size() != 1 ||
+                !(stops.stops.begin()->second == *function.defaultValue)) {
+                return {};
+            }
+            return stops.stops.begin()->second;
+        });
+}
+
 template <class S>
 struct CompositeValue : std::pair<float, S> {
     using std::pair<float, S>::pair;
@@ -67,7 +67,7 @@ struct Converter<GeoJSONOptions> {
         const auto clusterRadiusValue = objectMember(value, "clusterRadius");
         if (clusterRadiusValue) {
             if (toNumber(*clusterRadiusValue)) {
-                options.clusterRadius = static_cast<double>(*toNumber(*clusterRadiusValue));
+                options.clusterRadius = static_cast<uint16_t>(*toNumber(*clusterRadiusValue));
             } else {
                 error = { "GeoJSON source clusterRadius value must be a number" };
                 return {};
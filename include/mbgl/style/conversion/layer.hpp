@@ -4,6 +4,7 @@
 #include <mbgl/style/layers/background_layer.hpp>
 #include <mbgl/style/layers/circle_layer.hpp>
 #include <mbgl/style/layers/fill_layer.hpp>
+#include <mbgl/style/layers/heatmap_layer.hpp>
 #include <mbgl/style/layers/line_layer.hpp>
 #include <mbgl/style/layers/raster_layer.hpp>
 #include <mbgl/style/layers/symbol_layer.hpp>
@@ -98,6 +99,8 @@ public:
             converted = convertVectorLayer<CircleLayer>(*id, value, error);
         } else if (*type == "symbol") {
             converted = convertVectorLayer<SymbolLayer>(*id, value, error);
+        } else if (*type == "heatmap") {
+            converted = convertVectorLayer<HeatmapLayer>(*id, value, error);
         } else if (*type == "raster") {
             converted = convertRasterLayer(*id, value, error);
         } else if (*type == "background") {
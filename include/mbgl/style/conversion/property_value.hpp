@@ -20,6 +20,9 @@ struct Converter<PropertyValue<T>> {
             if (!function) {
                 return {};
             }
+            if (optional<T> constant = constantFold(*function)) {
+                return { *constant };
+            }
             return { *function };
         } else {
             optional<T> constant = convert<T>(value, error);
@@ -0,0 +1,141 @@
+#pragma once
+
+#include <mbgl/style/function/exponential_stops.hpp>
+#include <mbgl/style/function/interval_stops.hpp>
+#include <mbgl/util/variant.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <vector>
+
+namespace mbgl {
+namespace style {
+
+/*
+   Flat, precomputed forms of the interpolating stop types.
+
+   The map-based stops are convenient to parse and compare, but evaluating
+   them per feature during bucket population means a tree walk plus up to two
+   std::pow calls per property per feature. Compiling the stops once per
+   binder replaces that with a binary search over a contiguous array and a
+   single multiply (plus one pow for bases other than 1), which matters when
+   a data-driven property is evaluated for tens of thousands of features.
+
+   The compiled types mirror the `evaluate(const Value&)` interface of the
+   stop types they are built from and must produce identical results.
+*/
+
+template <class T>
+class CompiledExponentialStops {
+public:
+    explicit CompiledExponentialStops(const ExponentialStops<T>& source)
+        : base(source.base) {
+        domain.reserve(source.stops.size());
+        values.reserve(source.stops.size());
+        for (const auto& stop : source.stops) {
+            domain.push_back(stop.first);
+            values.push_back(stop.second);
+        }
+        if (!domain.empty()) {
+            inverseDifference.reserve(domain.size() - 1);
+        }
+        for (std::size_t i = 1; i < domain.size(); ++i) {
+            const float difference = domain[i] - domain[i - 1];
+            inverseDifference.push_back(base == 1.0f
+                ? 1.0f / difference
+                : 1.0f / (std::pow(base, difference) - 1.0f));
+        }
+    }
+
+    optional<T> evaluate(const Value& value) const {
+        if (domain.empty()) {
+            assert(false);
+            return T();
+        }
+
+        optional<float> z = numericValue<float>(value);
+        if (!z) {
+            return T();
+        }
+
+        const auto it = std::upper_bound(domain.begin(), domain.end(), *z);
+        if (it == domain.end()) {
+            return values.back();
+        } else if (it == domain.begin()) {
+            return values.front();
+        }
+
+        const std::size_t index = it - domain.begin();
+        const float progress = *z - domain[index - 1];
+        const float t = (base == 1.0f ? progress : std::pow(base, progress) - 1.0f)
+            * inverseDifference[index - 1];
+        return util::interpolate(values[index - 1], values[index], t);
+    }
+
+private:
+    std::vector<float> domain;
+    std::vector<T> values;
+    std::vector<float> inverseDifference;
+    float base;
+};
+
+template <class T>
+class CompiledIntervalStops {
+public:
+    explicit CompiledIntervalStops(const IntervalStops<T>& source) {
+        domain.reserve(source.stops.size());
+        values.reserve(source.stops.size());
+        for (const auto& stop : source.stops) {
+            domain.push_back(stop.first);
+            values.push_back(stop.second);
+        }
+    }
+
+    optional<T> evaluate(const Value& value) const {
+        if (domain.empty()) {
+            assert(false);
+            return {};
+        }
+
+        optional<float> z = numericValue<float>(value);
+        if (!z) {
+            return {};
+        }
+
+        const auto it = std::upper_bound(domain.begin(), domain.end(), *z);
+        if (it == domain.begin()) {
+            return values.front();
+        }
+        return values[it - domain.begin() - 1];
+    }
+
+private:
+    std::vector<float> domain;
+    std::vector<T> values;
+};
+
+template <class T>
+using CompiledStops = variant<
+    CompiledExponentialStops<T>,
+    CompiledIntervalStops<T>>;
+
+// Compiles the interpolating alternatives of a stops variant. Categorical and
+// identity stops have no precomputable structure and are left to be evaluated
+// directly.
+template <class T, class Stops>
+optional<CompiledStops<T>> compileStops(const Stops& stops) {
+    return stops.match(
+        [] (const ExponentialStops<T>& s) -> optional<CompiledStops<T>> {
+            return CompiledStops<T>(CompiledExponentialStops<T>(s));
+        },
+        [] (const IntervalStops<T>& s) -> optional<CompiledStops<T>> {
+            return CompiledStops<T>(CompiledIntervalStops<T>(s));
+        },
+        [] (const auto&) -> optional<CompiledStops<T>> {
+            return {};
+        });
+}
+
+} // namespace style
+} // namespace mbgl
@@ -17,6 +17,7 @@ class RasterLayer;
 class BackgroundLayer;
 class CustomLayer;
 class FillExtrusionLayer;
+class HeatmapLayer;
 
 /**
  * The runtime representation of a [layer](https://www.mapbox.com/mapbox-gl-style-spec/#layers) from the Mapbox Style
@@ -45,6 +46,7 @@ protected:
         Background,
         Custom,
         FillExtrusion,
+        Heatmap,
     };
 
     class Impl;
@@ -100,6 +102,8 @@ public:
             return visitor(*as<CustomLayer>());
         case Type::FillExtrusion:
             return visitor(*as<FillExtrusionLayer>());
+        case Type::Heatmap:
+            return visitor(*as<HeatmapLayer>());
         }
     }
 
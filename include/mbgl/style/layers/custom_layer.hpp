@@ -2,6 +2,8 @@
 
 #include <mbgl/style/layer.hpp>
 
+#include <array>
+
 namespace mbgl {
 namespace style {
 
@@ -26,6 +28,11 @@ struct CustomLayerRenderParameters {
     double bearing;
     double pitch;
     double fieldOfView;
+    // The projection matrix the map itself is rendering with this frame. It
+    // maps from world coordinates — pixels in the map plane at the current
+    // zoom level — to GL clip space, so content drawn with it interleaves
+    // correctly with map layers instead of requiring a separate surface.
+    std::array<double, 16> projectionMatrix;
 };
 
 /**
@@ -0,0 +1,71 @@
+// This file is generated. Do not edit.
+
+#pragma once
+
+#include <mbgl/style/layer.hpp>
+#include <mbgl/style/filter.hpp>
+#include <mbgl/style/property_value.hpp>
+#include <mbgl/style/data_driven_property_value.hpp>
+
+#include <mbgl/util/color.hpp>
+
+namespace mbgl {
+namespace style {
+
+class TransitionOptions;
+
+class HeatmapLayer : public Layer {
+public:
+    HeatmapLayer(const std::string& layerID, const std::string& sourceID);
+    ~HeatmapLayer() final;
+
+    // Source
+    const std::string& getSourceID() const;
+    const std::string& getSourceLayer() const;
+    void setSourceLayer(const std::string& sourceLayer);
+
+    void setFilter(const Filter&);
+    const Filter& getFilter() const;
+
+    // Paint properties
+
+    static PropertyValue<float> getDefaultHeatmapRadius();
+    PropertyValue<float> getHeatmapRadius(const optional<std::string>& klass = {}) const;
+    void setHeatmapRadius(PropertyValue<float>, const optional<std::string>& klass = {});
+    void setHeatmapRadiusTransition(const TransitionOptions&, const optional<std::string>& klass = {});
+    TransitionOptions getHeatmapRadiusTransition(const optional<std::string>& klass = {}) const;
+
+    static DataDrivenPropertyValue<float> getDefaultHeatmapWeight();
+    DataDrivenPropertyValue<float> getHeatmapWeight(const optional<std::string>& klass = {}) const;
+    void setHeatmapWeight(DataDrivenPropertyValue<float>, const optional<std::string>& klass = {});
+    void setHeatmapWeightTransition(const TransitionOptions&, const optional<std::string>& klass = {});
+    TransitionOptions getHeatmapWeightTransition(const optional<std::string>& klass = {}) const;
+
+    static PropertyValue<float> getDefaultHeatmapIntensity();
+    PropertyValue<float> getHeatmapIntensity(const optional<std::string>& klass = {}) const;
+    void setHeatmapIntensity(PropertyValue<float>, const optional<std::string>& klass = {});
+    void setHeatmapIntensityTransition(const TransitionOptions&, const optional<std::string>& klass = {});
+    TransitionOptions getHeatmapIntensityTransition(const optional<std::string>& klass = {}) const;
+
+    static PropertyValue<float> getDefaultHeatmapOpacity();
+    PropertyValue<float> getHeatmapOpacity(const optional<std::string>& klass = {}) const;
+    void setHeatmapOpacity(PropertyValue<float>, const optional<std::string>& klass = {});
+    void setHeatmapOpacityTransition(const TransitionOptions&, const optional<std::string>& klass = {});
+    TransitionOptions getHeatmapOpacityTransition(const optional<std::string>& klass = {}) const;
+
+    // Private implementation
+
+    class Impl;
+    Impl* const impl;
+
+    HeatmapLayer(const Impl&);
+    HeatmapLayer(const HeatmapLayer&) = delete;
+};
+
+template <>
+inline bool Layer::is<HeatmapLayer>() const {
+    return type == Type::Heatmap;
+}
+
+} // namespace style
+} // namespace mbgl
@@ -30,6 +30,7 @@ public:
     bool isConstant()       const { return value.which() == 1; }
     bool isCameraFunction() const { return value.which() == 2; }
     bool isDataDriven()     const { return false; }
+    bool isZoomConstant()   const { return !isCameraFunction(); }
 
     const                T & asConstant()       const { return value.template get<               T >(); }
     const CameraFunction<T>& asCameraFunction() const { return value.template get<CameraFunction<T>>(); }
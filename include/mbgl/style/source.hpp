@@ -1,5 +1,6 @@
 #pragma once
 
+#include <mbgl/util/chrono.hpp>
 #include <mbgl/util/feature.hpp>
 #include <mbgl/util/noncopyable.hpp>
 #include <mbgl/util/optional.hpp>
@@ -60,6 +61,30 @@ public:
 
     std::vector<Feature> querySourceFeatures(const SourceQueryOptions& options = {});
 
+    // Opts this source's tiles into hash indexes over the given feature
+    // attributes: querySourceFeatures then answers an equality filter on an
+    // indexed attribute with a probe instead of scanning every feature.
+    // Indexes are built lazily, per tile and source layer, on the first such
+    // query. Pass an empty vector to drop the indexes again.
+    void setQueryAttributeIndexes(std::vector<std::string> attributes);
+
+    // Sets (or, with an empty map, clears) runtime state for the feature
+    // with the given numeric id. State values take precedence over the
+    // feature's own attributes when data-driven paint properties are
+    // evaluated, and a change rewrites only the affected features' vertex
+    // ranges — no tile relayout. Typical use: a categorical paint function
+    // on a state attribute such as "hover".
+    void setFeatureState(uint64_t featureID, const PropertyMap& state);
+
+    // Caps how often this source re-evaluates its tile cover. By default
+    // every map update re-runs the evaluation; with an interval set, updates
+    // within it are skipped as long as the camera stays within the same
+    // tiles at the same zoom, bearing and pitch and no tile changed in the
+    // meantime. A camera move that could change the cover always updates
+    // immediately. Useful for sources whose content justifies no per-frame
+    // work, such as a raster source refreshed on the order of minutes.
+    void setMinimumUpdateInterval(Duration interval);
+
     // Private implementation
     class Impl;
     const std::unique_ptr<Impl> baseImpl;
@@ -1,9 +1,12 @@
 #pragma once
 
 #include <mbgl/style/source.hpp>
+#include <mbgl/util/feature.hpp>
 #include <mbgl/util/geojson.hpp>
 #include <mbgl/util/optional.hpp>
 
+#include <vector>
+
 #include <mapbox/geojson.hpp>
 
 namespace mapbox {
@@ -30,9 +33,16 @@ struct GeoJSONOptions {
     uint16_t buffer = 128;
     double tolerance = 0.375;
 
-    // Supercluster options
+    // Supercluster options.
+    //
+    // When `cluster` is enabled and the data is a feature collection of
+    // points, the source builds a hierarchical cluster index at load time and
+    // each tile emits aggregated cluster features (carrying point_count
+    // properties) instead of the raw points, keeping low-zoom feature counts
+    // independent of the input size. Clustering stops above `clusterMaxZoom`,
+    // where the original features are emitted.
     bool cluster = false;
-    uint16_t clusterRadius = 50;
+    uint16_t clusterRadius = 50; // Radius in points at which features cluster.
     uint8_t clusterMaxZoom = 17;
 };
 
@@ -43,6 +53,15 @@ public:
     void setURL(const std::string& url);
     void setGeoJSON(const GeoJSON&);
 
+    // Applies a diff to the current data: each feature in `addOrUpdate`
+    // replaces the existing feature with the same id (or is appended), and
+    // features whose id is listed in `remove` are dropped. Only tiles whose
+    // clipped output actually changes are re-laid-out, so frequent small
+    // updates to a large source don't re-tessellate the whole viewport.
+    // Requires the current data to be a feature collection.
+    void updateFeatures(const std::vector<Feature>& addOrUpdate,
+                        const std::vector<FeatureIdentifier>& remove = {});
+
     optional<std::string> getURL() const;
 
     // Private implementation
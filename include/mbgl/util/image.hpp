@@ -2,6 +2,7 @@
 
 #include <mbgl/util/noncopyable.hpp>
 #include <mbgl/util/geometry.hpp>
+#include <mbgl/util/image_buffer_pool.hpp>
 #include <mbgl/util/size.hpp>
 
 #include <string>
@@ -23,18 +24,18 @@ public:
 
     Image(Size size_)
         : size(std::move(size_)),
-          data(std::make_unique<uint8_t[]>(bytes())) {}
+          data(util::allocateImageBuffer(bytes())) {}
 
     Image(Size size_, const uint8_t* srcData, std::size_t srcLength)
         : size(std::move(size_)) {
         if (srcLength != bytes()) {
             throw std::invalid_argument("mismatched image size");
         }
-        data = std::make_unique<uint8_t[]>(bytes());
+        data = util::allocateImageBuffer(bytes());
         std::copy(srcData, srcData + srcLength, data.get());
     }
 
-    Image(Size size_, std::unique_ptr<uint8_t[]> data_)
+    Image(Size size_, util::ImageBuffer data_)
         : size(std::move(size_)),
           data(std::move(data_)) {}
 
@@ -117,7 +118,7 @@ public:
 
     Size size;
     static constexpr size_t channels = Mode == ImageAlphaMode::Exclusive ? 1 : 4;
-    std::unique_ptr<uint8_t[]> data;
+    util::ImageBuffer data;
 };
 
 using UnassociatedImage = Image<ImageAlphaMode::Unassociated>;
@@ -125,7 +126,18 @@ using PremultipliedImage = Image<ImageAlphaMode::Premultiplied>;
 using AlphaImage = Image<ImageAlphaMode::Exclusive>;
 
 // TODO: don't use std::string for binary data.
-PremultipliedImage decodeImage(const std::string&);
+// Decodes an encoded PNG, JPEG, or WebP image. If `maxDimension` is non-zero,
+// decoders with cheap decode-time scaling (currently libjpeg's DCT scaling)
+// may downscale by powers of two as long as both result dimensions stay at or
+// above `maxDimension`. Pass the size at which the image will be displayed to
+// cut decode time and texture memory for oversized sources; images are never
+// upscaled.
+PremultipliedImage decodeImage(const std::string&, uint32_t maxDimension = 0);
+
+// Accept header value advertising the formats decodeImage() can handle, in
+// preference order. Defined alongside each platform's decodeImage; sent with
+// raster tile requests so servers that can encode cheaper formats (WebP) do.
+const char* imageAcceptHeader();
 std::string encodePNG(const PremultipliedImage&);
 
 } // namespace mbgl
@@ -0,0 +1,30 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace mbgl {
+namespace util {
+
+// Deleter for image pixel buffers. Returns tile-sized buffers to the
+// process-wide pool instead of freeing them.
+struct ImageBufferDeleter {
+    void operator()(uint8_t*) const;
+};
+
+// Pixel storage for Image<>. Buffers at or above the pooling threshold are
+// drawn from a size-classed pool shared by the image decoders and framebuffer
+// readbacks, so steady-state raster panning recycles a handful of tile-sized
+// allocations instead of churning the heap.
+using ImageBuffer = std::unique_ptr<uint8_t[], ImageBufferDeleter>;
+
+// Returns a zero-filled buffer of at least `bytes` bytes.
+ImageBuffer allocateImageBuffer(std::size_t bytes);
+
+// Frees all idle pooled buffers. Called on memory pressure; buffers still
+// owned by live images are unaffected.
+void shrinkImageBufferPool();
+
+} // namespace util
+} // namespace mbgl
@@ -0,0 +1,124 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace mbgl {
+
+// Subsystems whose heap use is accounted separately. Buckets covers the
+// CPU-side vertex and index vectors of render buckets; Atlases the pixel
+// storage of the sprite, glyph, and line atlases; TileCache the retained
+// tiles of every source's cache; Database the memory held by the offline
+// database's SQLite connection, including its prepared statement cache.
+enum class MemoryCategory : std::size_t {
+    Buckets = 0,
+    Atlases,
+    TileCache,
+    Database,
+};
+
+// Per-subsystem byte counts aggregated process-wide. Current values track
+// live allocations; peaks persist until resetMemoryPeaks().
+struct MemoryStats {
+    static constexpr std::size_t categoryCount = 4;
+
+    std::array<uint64_t, categoryCount> currentBytes {{}};
+    std::array<uint64_t, categoryCount> peakBytes {{}};
+
+    uint64_t forCategory(MemoryCategory category) const {
+        return currentBytes[static_cast<std::size_t>(category)];
+    }
+
+    uint64_t peakForCategory(MemoryCategory category) const {
+        return peakBytes[static_cast<std::size_t>(category)];
+    }
+};
+
+namespace util {
+
+// Adjust a category's byte count. Callable from any thread.
+void recordMemoryAllocation(MemoryCategory, std::size_t bytes);
+void recordMemoryDeallocation(MemoryCategory, std::size_t bytes);
+
+// Overwrite a category's byte count with an externally measured value, for
+// subsystems whose allocator cannot be instrumented directly (SQLite).
+void setMemoryUsage(MemoryCategory, std::size_t bytes);
+
+// Returns a copy of the current process-wide breakdown.
+MemoryStats getMemoryStats();
+
+// Resets the peak values to the current ones.
+void resetMemoryPeaks();
+
+// std::allocator drop-in that attributes a container's storage to a
+// category.
+template <typename T, MemoryCategory Category>
+class TrackingAllocator {
+public:
+    using value_type = T;
+
+    TrackingAllocator() = default;
+
+    template <typename U>
+    TrackingAllocator(const TrackingAllocator<U, Category>&) {
+    }
+
+    // allocator_traits cannot rebind automatically across the non-type
+    // category parameter.
+    template <typename U>
+    struct rebind {
+        using other = TrackingAllocator<U, Category>;
+    };
+
+    T* allocate(std::size_t n) {
+        recordMemoryAllocation(Category, n * sizeof(T));
+        return static_cast<T*>(::operator new(n * sizeof(T)));
+    }
+
+    void deallocate(T* ptr, std::size_t n) {
+        recordMemoryDeallocation(Category, n * sizeof(T));
+        ::operator delete(ptr);
+    }
+};
+
+template <typename T, typename U, MemoryCategory Category>
+bool operator==(const TrackingAllocator<T, Category>&, const TrackingAllocator<U, Category>&) {
+    return true;
+}
+
+template <typename T, typename U, MemoryCategory Category>
+bool operator!=(const TrackingAllocator<T, Category>&, const TrackingAllocator<U, Category>&) {
+    return false;
+}
+
+// Attributes a fixed-size allocation owned by the enclosing object for that
+// object's lifetime.
+class TrackedMemory {
+public:
+    TrackedMemory(MemoryCategory category_, std::size_t bytes_)
+        : category(category_), bytes(bytes_) {
+        recordMemoryAllocation(category, bytes);
+    }
+
+    ~TrackedMemory() {
+        recordMemoryDeallocation(category, bytes);
+    }
+
+    // Re-attributes the allocation after the owner resized it.
+    void update(std::size_t newBytes) {
+        recordMemoryDeallocation(category, bytes);
+        bytes = newBytes;
+        recordMemoryAllocation(category, bytes);
+    }
+
+    TrackedMemory(const TrackedMemory&) = delete;
+    TrackedMemory& operator=(const TrackedMemory&) = delete;
+
+private:
+    const MemoryCategory category;
+    std::size_t bytes;
+};
+
+} // namespace util
+} // namespace mbgl
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace mbgl {
+
+// Caches whose lookup outcomes are counted separately. TileCache covers the
+// retained-tile caches of every source; ParseCache the process-wide memo of
+// decoded glyph and sprite responses.
+enum class CacheKind : std::size_t {
+    TileCache = 0,
+    ParseCache,
+};
+
+// Process-wide runtime counters, sampled by the performance HUD
+// (MapDebugOptions::PerformanceHUD). Cache counts accumulate monotonically;
+// the queue depth is a gauge.
+struct PerformanceCounters {
+    static constexpr std::size_t cacheKindCount = 2;
+
+    // Mailboxes scheduled on the worker pool but not yet claimed by a worker
+    // thread.
+    uint64_t workerQueueDepth = 0;
+
+    std::array<uint64_t, cacheKindCount> cacheHits {{}};
+    std::array<uint64_t, cacheKindCount> cacheMisses {{}};
+
+    uint64_t hitsFor(CacheKind kind) const {
+        return cacheHits[static_cast<std::size_t>(kind)];
+    }
+
+    uint64_t missesFor(CacheKind kind) const {
+        return cacheMisses[static_cast<std::size_t>(kind)];
+    }
+};
+
+namespace util {
+
+// Overwrites the worker queue depth gauge. Callable from any thread. A
+// process running several pools sees the most recently active one, which is
+// sufficient for a debug readout.
+void setWorkerQueueDepth(std::size_t);
+
+// Counts one cache lookup. Callable from any thread.
+void recordCacheLookup(CacheKind, bool hit);
+
+// Returns a copy of the current process-wide counters.
+PerformanceCounters getPerformanceCounters();
+
+} // namespace util
+} // namespace mbgl
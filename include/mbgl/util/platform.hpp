@@ -23,6 +23,15 @@ void setCurrentThreadName(const std::string& name);
 // Makes the current thread low priority.
 void makeThreadLowPriority();
 
+// Prefers the performance ("big") cores for the current thread on
+// heterogeneous CPUs, or the equivalent QoS class where the platform
+// schedules by class rather than affinity. No-op on homogeneous CPUs.
+void bindThreadToPerformanceCores();
+
+// Prefers the efficiency ("LITTLE") cores for the current thread; the
+// counterpart of bindThreadToPerformanceCores().
+void bindThreadToEfficiencyCores();
+
 // Shows an alpha image with the specified dimensions in a named window.
 void showDebugImage(std::string name, const char *data, size_t width, size_t height);
 
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <cstdint>
+
+namespace mbgl {
+
+// Counters of the GL work a frame issued after state deduplication: calls
+// the driver actually received, not calls the render code attempted. The
+// context accumulates them monotonically; per-frame numbers are the
+// difference between two snapshots.
+struct RenderStatistics {
+    uint64_t drawCalls = 0;
+
+    // Shader program changes that survived the context's redundant-state
+    // check.
+    uint64_t programSwitches = 0;
+
+    // Texture bindings that survived the context's redundant-state check.
+    uint64_t textureBinds = 0;
+
+    // Bytes sent to the GPU through buffer and texture uploads.
+    uint64_t bytesUploaded = 0;
+
+    RenderStatistics operator-(const RenderStatistics& rhs) const {
+        return { drawCalls - rhs.drawCalls,
+                 programSwitches - rhs.programSwitches,
+                 textureBinds - rhs.textureBinds,
+                 bytesUploaded - rhs.bytesUploaded };
+    }
+};
+
+} // namespace mbgl
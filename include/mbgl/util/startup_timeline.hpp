@@ -0,0 +1,56 @@
+#pragma once
+
+#include <mbgl/util/chrono.hpp>
+
+#include <array>
+#include <cstddef>
+
+namespace mbgl {
+
+// Cold-start milestones recorded process-wide on the way to the first fully
+// rendered map. Only the first occurrence of each milestone counts, so the
+// timeline describes the cold path even when more maps, styles, or tiles
+// follow.
+enum class StartupMilestone : std::size_t {
+    FileSourceReady = 0,
+    StyleParsed,
+    FirstTileRequested,
+    FirstTileParsed,
+    FirstTileUploaded,
+    FirstFrame,
+};
+
+// Monotonic milestone timestamps, relative to the timeline epoch: library
+// load, or the last resetStartupTimeline(). The differences between
+// consecutive recorded milestones attribute time-to-first-map to the stage
+// that spent it.
+struct StartupTimeline {
+    static constexpr std::size_t milestoneCount = 6;
+
+    std::array<Duration, milestoneCount> sinceEpoch {{}};
+    std::array<bool, milestoneCount> recorded {{}};
+
+    Duration forMilestone(StartupMilestone milestone) const {
+        return sinceEpoch[static_cast<std::size_t>(milestone)];
+    }
+
+    bool isRecorded(StartupMilestone milestone) const {
+        return recorded[static_cast<std::size_t>(milestone)];
+    }
+};
+
+namespace util {
+
+// Records a milestone at the current monotonic time; every call after the
+// first for a given milestone is ignored. Callable from any thread.
+void markStartupMilestone(StartupMilestone);
+
+// Returns a copy of the milestones recorded so far.
+StartupTimeline getStartupTimeline();
+
+// Clears all milestones and restarts the epoch, so a host app can measure a
+// warm restart with the same machinery.
+void resetStartupTimeline();
+
+} // namespace util
+} // namespace mbgl
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <mbgl/util/chrono.hpp>
+
+#include <array>
+#include <cstdint>
+#include <cstddef>
+
+namespace mbgl {
+
+// Stages of the tile pipeline for which latency is recorded. Network covers
+// everything between issuing a tile request and receiving its response —
+// request queueing, the transfer itself, or a cache/database read. Layout is
+// the worker-side pass over the raw tile (parsing is lazy and interleaved
+// with bucket construction, so the two are measured together). Placement is
+// symbol collision placement, and Upload is the transfer of one bucket's
+// buffers to the GPU. RasterDecode is the worker-side image decode of a
+// raster tile (raster tiles skip Layout/Placement).
+enum class TileStage : std::size_t {
+    Network = 0,
+    Layout,
+    Placement,
+    Upload,
+    RasterDecode,
+};
+
+// Latency distribution for one pipeline stage. Buckets are powers of two:
+// counts[i] holds samples that took [2^(i-1), 2^i) milliseconds, counts[0]
+// everything under a millisecond, and the last bucket is open-ended.
+struct TileStageHistogram {
+    static constexpr std::size_t bucketCount = 16;
+
+    std::array<uint64_t, bucketCount> counts {{}};
+    uint64_t samples = 0;
+    uint64_t totalMilliseconds = 0;
+    uint64_t maxMilliseconds = 0;
+};
+
+// Per-stage latency histograms aggregated since startup or the last reset.
+struct TileLatencyStats {
+    static constexpr std::size_t stageCount = 5;
+
+    std::array<TileStageHistogram, stageCount> stages;
+
+    const TileStageHistogram& forStage(TileStage stage) const {
+        return stages[static_cast<std::size_t>(stage)];
+    }
+};
+
+namespace util {
+
+// Adds one sample to the process-wide aggregate. Callable from any thread.
+void recordTileStageLatency(TileStage, Duration);
+
+// Returns a copy of the aggregate accumulated since the last reset.
+TileLatencyStats getTileLatencyStats();
+
+// Starts a fresh aggregation session.
+void resetTileLatencyStats();
+
+} // namespace util
+} // namespace mbgl
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <mbgl/util/chrono.hpp>
+
+#include <cstdint>
+#include <string>
+
+namespace mbgl {
+namespace util {
+
+// Structured event tracing across threads. While a capture is running,
+// instrumented scopes append complete events — name, time span, thread, and
+// optional tile/correlation arguments — to a fixed-capacity per-thread
+// buffer. Appends are lock-free: each buffer is written only by its owner
+// thread, which publishes the new count with a release store, so workers pay
+// a few plain stores per event and never contend on a shared lock.
+// stopTracing() serializes everything recorded since startTracing() in the
+// chrome://tracing JSON format, giving a single timeline that follows a slow
+// tile across threads from network response to bucket upload.
+
+void startTracing();
+
+// Stops recording and returns the capture as chrome://tracing JSON.
+std::string stopTracing();
+
+bool isTracing();
+
+// Records a complete event spanning [start, end] on the calling thread. The
+// name must outlive the capture (pass a string literal). A non-zero
+// correlationID and a non-null detail (a tile id, truncated to 31
+// characters) become event arguments. No-op unless a capture is running.
+void recordTraceEvent(const char* name,
+                      TimePoint start,
+                      TimePoint end,
+                      uint64_t correlationID = 0,
+                      const char* detail = nullptr);
+
+// Records the enclosing scope as a trace event.
+class TraceScope {
+public:
+    TraceScope(const char* name_, uint64_t correlationID_ = 0, std::string detail_ = {})
+        : name(name_),
+          correlationID(correlationID_),
+          detail(std::move(detail_)),
+          start(Clock::now()) {
+    }
+
+    ~TraceScope() {
+        recordTraceEvent(name, start, Clock::now(), correlationID,
+                         detail.empty() ? nullptr : detail.c_str());
+    }
+
+    TraceScope(const TraceScope&) = delete;
+    TraceScope& operator=(const TraceScope&) = delete;
+
+private:
+    const char* name;
+    uint64_t correlationID;
+    std::string detail;
+    TimePoint start;
+};
+
+} // namespace util
+} // namespace mbgl
@@ -53,6 +53,7 @@ macro(mbgl_platform_core)
         PRIVATE platform/android/src/thread.cpp
         PRIVATE platform/default/string_stdlib.cpp
         PRIVATE platform/default/bidi.cpp
+        PRIVATE platform/default/local_glyph_rasterizer.cpp
         PRIVATE platform/default/utf.cpp
 
         # Image handling
@@ -68,6 +69,10 @@ macro(mbgl_platform_core)
         PRIVATE platform/default/mbgl/util/shared_thread_pool.hpp
         PRIVATE platform/default/mbgl/util/default_thread_pool.cpp
         PRIVATE platform/default/mbgl/util/default_thread_pool.hpp
+
+        # Shared file source
+        PRIVATE platform/default/mbgl/util/shared_file_source.cpp
+        PRIVATE platform/default/mbgl/util/shared_file_source.hpp
     )
 
     target_include_directories(mbgl-core
@@ -118,7 +118,7 @@ PremultipliedImage Bitmap::GetImage(jni::JNIEnv& env, jni::Object<Bitmap> bitmap
 
     // Copy the Android Bitmap into the PremultipliedImage.
     auto pixels =
-        std::make_unique<uint8_t[]>(info.width * info.height * PremultipliedImage::channels);
+        util::allocateImageBuffer(info.width * info.height * PremultipliedImage::channels);
     for (uint32_t y = 0; y < info.height; y++) {
         auto begin = guard.get() + y * info.stride;
         std::copy(begin, begin + info.width * PremultipliedImage::channels,
@@ -8,7 +8,7 @@
 
 namespace mbgl {
 
-PremultipliedImage decodeImage(const std::string& string) {
+PremultipliedImage decodeImage(const std::string& string, uint32_t) {
     auto env{ android::AttachEnv() };
 
     auto array = jni::Array<jni::jbyte>::New(*env, string.size());
@@ -19,4 +19,9 @@ PremultipliedImage decodeImage(const std::string& string) {
     return android::Bitmap::GetImage(*env, bitmap);
 }
 
+const char* imageAcceptHeader() {
+    // BitmapFactory decodes WebP on all supported Android versions.
+    return "image/webp,image/png;q=0.9,image/jpeg;q=0.8,image/*;q=0.5";
+}
+
 } // namespace mbgl
@@ -28,7 +28,8 @@ CGImageRef CGImageFromMGLPremultipliedImage(mbgl::PremultipliedImage&& src) {
     // over ownership of the memory.
     CGDataProviderHandle provider(CGDataProviderCreateWithData(
         NULL, src.data.get(), src.bytes(), [](void*, const void* data, size_t) {
-            delete[] reinterpret_cast<const decltype(src.data)::element_type*>(data);
+            decltype(src.data)::deleter_type()(
+                const_cast<uint8_t*>(reinterpret_cast<const uint8_t*>(data)));
         }));
     if (!provider) {
         return nil;
@@ -83,7 +84,7 @@ mbgl::PremultipliedImage MGLPremultipliedImageFromCGImage(CGImageRef src) {
 
 namespace mbgl {
 
-PremultipliedImage decodeImage(const std::string& source) {
+PremultipliedImage decodeImage(const std::string& source, uint32_t) {
     CFDataHandle data(CFDataCreateWithBytesNoCopy(
         kCFAllocatorDefault, reinterpret_cast<const unsigned char*>(source.data()), source.size(),
         kCFAllocatorNull));
@@ -104,4 +105,9 @@ PremultipliedImage decodeImage(const std::string& source) {
     return MGLPremultipliedImageFromCGImage(*image);
 }
 
+const char* imageAcceptHeader() {
+    // ImageIO has no WebP codec.
+    return "image/png,image/jpeg;q=0.9,image/*;q=0.5";
+}
+
 } // namespace mbgl
@@ -22,5 +22,16 @@ void makeThreadLowPriority() {
     [[NSThread currentThread] setThreadPriority:0.0];
 }
 
+// Darwin schedules heterogeneous cores by QoS class rather than explicit
+// affinity; map our placement hints onto the closest classes.
+
+void bindThreadToPerformanceCores() {
+    pthread_set_qos_class_self_np(QOS_CLASS_USER_INTERACTIVE, 0);
+}
+
+void bindThreadToEfficiencyCores() {
+    pthread_set_qos_class_self_np(QOS_CLASS_UTILITY, 0);
+}
+
 }
 }
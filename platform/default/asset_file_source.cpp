@@ -1,24 +1,226 @@
 #include <mbgl/storage/asset_file_source.hpp>
 #include <mbgl/storage/response.hpp>
+#include <mbgl/util/optional.hpp>
 #include <mbgl/util/string.hpp>
 #include <mbgl/util/thread.hpp>
 #include <mbgl/util/url.hpp>
 #include <mbgl/util/util.hpp>
 #include <mbgl/util/io.hpp>
 
+#include <zlib.h>
+
 #include <sys/types.h>
 #include <sys/stat.h>
+#include <sys/mman.h>
+#include <fcntl.h>
 #include <unistd.h>
 
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <unordered_map>
+
 namespace mbgl {
 
+namespace {
+
+// A minimal read-only view of a zip archive. The file is mapped once and the
+// central directory is parsed into a hash index up front, so each request
+// costs a lookup plus a single copy (or raw inflate) out of the mapping,
+// instead of an open/read/close per resource.
+//
+// Zip64 archives (> 4 GB or > 65535 entries) and encrypted entries are not
+// supported.
+class ZipArchive {
+public:
+    explicit ZipArchive(const std::string& path) {
+        const int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            throw std::runtime_error("failed to open zip archive");
+        }
+
+        struct stat buf;
+        if (::fstat(fd, &buf) != 0) {
+            ::close(fd);
+            throw std::runtime_error("failed to stat zip archive");
+        }
+
+        size = static_cast<std::size_t>(buf.st_size);
+        data = static_cast<const uint8_t*>(::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0));
+        ::close(fd);
+
+        if (data == MAP_FAILED) {
+            throw std::runtime_error("failed to map zip archive");
+        }
+
+        try {
+            buildIndex();
+        } catch (...) {
+            ::munmap(const_cast<uint8_t*>(data), size);
+            throw;
+        }
+    }
+
+    ~ZipArchive() {
+        ::munmap(const_cast<uint8_t*>(data), size);
+    }
+
+    optional<std::string> read(const std::string& path) const {
+        auto it = index.find(path);
+        if (it == index.end()) {
+            return {};
+        }
+
+        const Entry& entry = it->second;
+
+        // The local header's name and extra fields may differ in length from
+        // the central directory's copies, so the data offset has to be
+        // computed from the local header itself.
+        const uint8_t* local = at(entry.localHeaderOffset, 30);
+        if (read32(local) != 0x04034b50) {
+            throw std::runtime_error("corrupt zip entry");
+        }
+
+        const uint8_t* fileData =
+            at(entry.localHeaderOffset + 30 + read16(local + 26) + read16(local + 28),
+               entry.compressedSize);
+
+        switch (entry.method) {
+        case 0: // stored
+            return std::string(reinterpret_cast<const char*>(fileData), entry.compressedSize);
+        case 8: // deflated
+            return inflateRaw(fileData, entry.compressedSize, entry.uncompressedSize);
+        default:
+            throw std::runtime_error("unsupported zip compression method");
+        }
+    }
+
+private:
+    struct Entry {
+        uint32_t localHeaderOffset;
+        uint32_t compressedSize;
+        uint32_t uncompressedSize;
+        uint16_t method;
+    };
+
+    static uint16_t read16(const uint8_t* p) {
+        return uint16_t(p[0]) | uint16_t(p[1]) << 8;
+    }
+
+    static uint32_t read32(const uint8_t* p) {
+        return uint32_t(p[0]) | uint32_t(p[1]) << 8 | uint32_t(p[2]) << 16 | uint32_t(p[3]) << 24;
+    }
+
+    const uint8_t* at(std::size_t offset, std::size_t length) const {
+        if (offset > size || length > size - offset) {
+            throw std::runtime_error("corrupt zip archive");
+        }
+        return data + offset;
+    }
+
+    void buildIndex() {
+        // The end-of-central-directory record is at the tail of the file,
+        // preceding a comment of up to 64 KB; scan backwards for it.
+        if (size < 22) {
+            throw std::runtime_error("not a zip archive");
+        }
+
+        std::size_t eocd = size - 22;
+        const std::size_t stop = size >= std::size_t(22 + 65535) ? size - 22 - 65535 : 0;
+        while (read32(data + eocd) != 0x06054b50) {
+            if (eocd == stop) {
+                throw std::runtime_error("not a zip archive");
+            }
+            eocd--;
+        }
+
+        const uint16_t entryCount = read16(data + eocd + 10);
+        std::size_t offset = read32(data + eocd + 16);
+
+        index.reserve(entryCount);
+
+        for (uint16_t i = 0; i < entryCount; i++) {
+            const uint8_t* header = at(offset, 46);
+            if (read32(header) != 0x02014b50) {
+                throw std::runtime_error("corrupt zip central directory");
+            }
+
+            const uint16_t nameLength = read16(header + 28);
+            std::string name(reinterpret_cast<const char*>(at(offset + 46, nameLength)), nameLength);
+            offset += std::size_t(46) + nameLength + read16(header + 30) + read16(header + 32);
+
+            // Skip directories and encrypted entries.
+            if ((!name.empty() && name.back() == '/') || (read16(header + 8) & 0x1)) {
+                continue;
+            }
+
+            Entry entry;
+            entry.method = read16(header + 10);
+            entry.compressedSize = read32(header + 20);
+            entry.uncompressedSize = read32(header + 24);
+            entry.localHeaderOffset = read32(header + 42);
+
+            index.emplace(std::move(name), entry);
+        }
+    }
+
+    static std::string inflateRaw(const uint8_t* in, std::size_t inSize, std::size_t outSize) {
+        z_stream stream;
+        memset(&stream, 0, sizeof(stream));
+
+        // Negative window bits: zip entries are raw deflate, with no zlib wrapper.
+        if (inflateInit2(&stream, -MAX_WBITS) != Z_OK) {
+            throw std::runtime_error("failed to initialize inflate");
+        }
+
+        std::string result;
+        result.resize(outSize);
+
+        stream.next_in = const_cast<Bytef*>(in);
+        stream.avail_in = uInt(inSize);
+        stream.next_out = reinterpret_cast<Bytef*>(&result[0]);
+        stream.avail_out = uInt(outSize);
+
+        const int code = inflate(&stream, Z_FINISH);
+        const bool complete = code == Z_STREAM_END && stream.total_out == outSize;
+        inflateEnd(&stream);
+
+        if (!complete) {
+            throw std::runtime_error("corrupt zip entry data");
+        }
+
+        return result;
+    }
+
+    const uint8_t* data = nullptr;
+    std::size_t size = 0;
+    std::unordered_map<std::string, Entry> index;
+};
+
+} // namespace
+
 class AssetFileSource::Impl {
 public:
     Impl(std::string root_)
         : root(std::move(root_)) {
+        // A root that is a regular file rather than a directory is a zip
+        // archive bundling the assets.
+        struct stat buf;
+        if (stat(root.c_str(), &buf) == 0 && S_ISREG(buf.st_mode)) {
+            try {
+                archive = std::make_unique<ZipArchive>(root);
+            } catch (...) {
+                archiveError = std::current_exception();
+            }
+        }
     }
 
     void request(const std::string& url, FileSource::Callback callback) {
+        if (archive || archiveError) {
+            callback(requestFromArchive(url));
+            return;
+        }
+
         std::string path;
 
         if (url.size() <= 8 || url[8] == '/') {
@@ -52,7 +254,44 @@ public:
     }
 
 private:
+    Response requestFromArchive(const std::string& url) {
+        Response response;
+
+        if (archiveError) {
+            response.error = std::make_unique<Response::Error>(
+                Response::Error::Reason::Other,
+                util::toString(archiveError));
+            return response;
+        }
+
+        const std::string path = mbgl::util::percentDecode(url.size() > 8 ? url.substr(8) : "");
+
+        try {
+            optional<std::string> data = archive->read(path);
+            if (!data) {
+                // Archives produced by zipping the asset directory itself keep
+                // the directory name as a leading path component; accept that
+                // layout as well.
+                data = archive->read("assets/" + path);
+            }
+
+            if (!data) {
+                response.error = std::make_unique<Response::Error>(Response::Error::Reason::NotFound);
+            } else {
+                response.data = std::make_shared<std::string>(std::move(*data));
+            }
+        } catch (...) {
+            response.error = std::make_unique<Response::Error>(
+                Response::Error::Reason::Other,
+                util::toString(std::current_exception()));
+        }
+
+        return response;
+    }
+
     std::string root;
+    std::unique_ptr<ZipArchive> archive;
+    std::exception_ptr archiveError;
 };
 
 AssetFileSource::AssetFileSource(const std::string& root)
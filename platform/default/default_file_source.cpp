@@ -6,11 +6,17 @@
 #include <mbgl/storage/offline_download.hpp>
 
 #include <mbgl/util/platform.hpp>
+#include <mbgl/util/run_loop.hpp>
+#include <mbgl/util/startup_timeline.hpp>
 #include <mbgl/util/url.hpp>
 #include <mbgl/util/thread.hpp>
+#include <mbgl/util/timer.hpp>
 #include <mbgl/util/work_request.hpp>
+#include <mbgl/util/string.hpp>
+#include <mbgl/util/logging.hpp>
 
 #include <cassert>
+#include <list>
 
 namespace {
 
@@ -20,6 +26,12 @@ bool isAssetURL(const std::string& url) {
     return std::equal(assetProtocol.begin(), assetProtocol.end(), url.begin());
 }
 
+// Cached responses are buffered and written to the database in groups, so
+// that a burst of tile responses costs one transaction commit rather than
+// one per response.
+const std::size_t putBatchSize = 32;
+const mbgl::Milliseconds putBatchInterval(200);
+
 } // namespace
 
 namespace mbgl {
@@ -30,6 +42,17 @@ public:
         : offlineDatabase(cachePath, maximumCacheSize) {
     }
 
+    ~Impl() {
+        // Flushing may result in exceptions, but we're in a destructor, so we
+        // can't throw anything.
+        try {
+            flushPendingPuts();
+        } catch (...) {
+            Log::Error(Event::Database, "Unexpected error flushing cached responses: %s",
+                       util::toString(std::current_exception()).c_str());
+        }
+    }
+
     void setAPIBaseURL(const std::string& url) {
         onlineFileSource.setAPIBaseURL(url);
     }
@@ -50,6 +73,14 @@ public:
         onlineFileSource.setResourceTransform(std::move(transform));
     }
 
+    void setRevalidationWindow(Duration window) {
+        onlineFileSource.setRevalidationWindow(window);
+    }
+
+    void setTransferRateLimit(Resource::Kind kind, uint64_t bytesPerSecond) {
+        onlineFileSource.setTransferRateLimit(kind, bytesPerSecond);
+    }
+
     void listRegions(std::function<void (std::exception_ptr, optional<std::vector<OfflineRegion>>)> callback) {
         try {
             callback({}, offlineDatabase.listRegions());
@@ -96,6 +127,15 @@ public:
         }
     }
 
+    void mergeDatabase(const std::string& sideDatabasePath,
+                       std::function<void (std::exception_ptr, optional<std::vector<OfflineRegion>>)> callback) {
+        try {
+            callback({}, offlineDatabase.mergeDatabase(sideDatabasePath));
+        } catch (...) {
+            callback(std::current_exception(), {});
+        }
+    }
+
     void setRegionObserver(int64_t regionID, std::unique_ptr<OfflineRegionObserver> observer) {
         getDownload(regionID).setObserver(std::move(observer));
     }
@@ -104,12 +144,61 @@ public:
         getDownload(regionID).setState(state);
     }
 
+    void preloadStyle(const std::string& styleURL, float pixelRatio) {
+        // Drops a completed (or superseded) preload once its download has
+        // unwound; erasing from inside the download's own observer callback
+        // would destroy it mid-call.
+        class PreloadObserver : public OfflineRegionObserver {
+        public:
+            PreloadObserver(Impl& impl_, std::string styleURL_, OfflineDownload* download_)
+                : impl(impl_), styleURL(std::move(styleURL_)), download(download_) {
+            }
+
+            void statusChanged(OfflineRegionStatus status) override {
+                if (status.complete() && status.downloadState == OfflineRegionDownloadState::Inactive) {
+                    Impl* impl_ = &impl;
+                    std::string url = styleURL;
+                    // Compared only, never dereferenced: a restarted preload
+                    // may have replaced this download by the time this runs.
+                    OfflineDownload* self = download;
+                    util::RunLoop::Get()->invoke([impl_, url, self] {
+                        auto it = impl_->preloads.find(url);
+                        if (it != impl_->preloads.end() && it->second.get() == self) {
+                            impl_->preloads.erase(it);
+                        }
+                    });
+                }
+            }
+
+        private:
+            Impl& impl;
+            std::string styleURL;
+            OfflineDownload* download;
+        };
+
+        // Starting a preload for a style replaces any still in progress.
+        auto download = std::make_unique<OfflineDownload>(styleURL, pixelRatio,
+                                                          offlineDatabase, onlineFileSource);
+        download->setObserver(std::make_unique<PreloadObserver>(*this, styleURL, download.get()));
+        download->setState(OfflineRegionDownloadState::Active);
+        preloads[styleURL] = std::move(download);
+    }
+
     void request(AsyncRequest* req, Resource resource, Callback callback) {
         Resource revalidation = resource;
 
         const bool hasPrior = resource.priorEtag || resource.priorModified || resource.priorExpires;
         if (!hasPrior || resource.necessity == Resource::Optional) {
-            auto offlineResponse = offlineDatabase.get(resource);
+            auto offlineResponse = getCachedResponse(resource);
+            if (!offlineResponse) {
+                offlineResponse = getPendingPut(resource);
+            }
+            if (!offlineResponse) {
+                offlineResponse = offlineDatabase.get(resource);
+                if (offlineResponse) {
+                    cacheResponse(resource, *offlineResponse);
+                }
+            }
 
             if (resource.necessity == Resource::Optional && !offlineResponse) {
                 // Ensure there's always a response that we can send, so the caller knows that
@@ -130,7 +219,7 @@ public:
 
         if (resource.necessity == Resource::Required) {
             tasks[req] = onlineFileSource.request(revalidation, [=] (Response onlineResponse) {
-                this->offlineDatabase.put(revalidation, onlineResponse);
+                this->put(revalidation, onlineResponse);
                 callback(onlineResponse);
             });
         }
@@ -144,11 +233,122 @@ public:
         offlineDatabase.setOfflineMapboxTileCountLimit(limit);
     }
 
+    optional<Tileset> getCachedTileset(const std::string& url) {
+        return offlineDatabase.getTileset(url);
+    }
+
+    void putCachedTileset(const std::string& url, const Tileset& tileset, optional<Timestamp> expires) {
+        offlineDatabase.putTileset(url, tileset, expires);
+    }
+
+    void setMaximumMemoryCacheSize(uint64_t size) {
+        maximumMemoryCacheSize = size;
+        evictMemoryCache();
+    }
+
     void put(const Resource& resource, const Response& response) {
-        offlineDatabase.put(resource, response);
+        // The database skips errored responses; skipping them here too keeps
+        // the buffer an exact preview of what will be committed.
+        if (response.error) {
+            return;
+        }
+
+        cacheResponse(resource, response);
+
+        pendingPuts.emplace_back(resource, response);
+
+        if (pendingPuts.size() >= putBatchSize) {
+            flushPendingPuts();
+        } else if (pendingPuts.size() == 1) {
+            putFlushTimer.start(putBatchInterval, Duration::zero(), [this] {
+                flushPendingPuts();
+            });
+        }
     }
 
 private:
+    // A response still waiting in the write-behind buffer must be visible to
+    // reads, or a request racing the flush timer would miss the cache.
+    optional<Response> getPendingPut(const Resource& resource) const {
+        for (auto it = pendingPuts.rbegin(); it != pendingPuts.rend(); ++it) {
+            // A 304 carries no data; until it's written, readers fall through to
+            // the database and see the prior expiration, which is harmless.
+            if (it->first.url == resource.url && !it->second.notModified) {
+                return it->second;
+            }
+        }
+        return {};
+    }
+
+    // A hot tier in front of SQLite: responses decoded recently are served
+    // straight from memory, skipping the disk read and decompression that a
+    // database hit would repeat.
+    optional<Response> getCachedResponse(const Resource& resource) {
+        auto it = memoryCache.find(resource.url);
+        if (it == memoryCache.end()) {
+            return {};
+        }
+
+        memoryCacheOrder.splice(memoryCacheOrder.begin(), memoryCacheOrder, it->second.second);
+        return it->second.first;
+    }
+
+    void cacheResponse(const Resource& resource, const Response& response) {
+        if (response.notModified) {
+            // A 304 carries no data; refresh the validity of what we have.
+            auto it = memoryCache.find(resource.url);
+            if (it != memoryCache.end()) {
+                it->second.first.expires = response.expires;
+            }
+            return;
+        }
+
+        auto it = memoryCache.find(resource.url);
+        if (it != memoryCache.end()) {
+            memoryCacheSize -= cachedResponseSize(it->first, it->second.first);
+            memoryCacheOrder.erase(it->second.second);
+            memoryCache.erase(it);
+        }
+
+        const uint64_t size = cachedResponseSize(resource.url, response);
+        if (size > maximumMemoryCacheSize) {
+            return;
+        }
+
+        memoryCacheOrder.push_front(resource.url);
+        memoryCache.emplace(resource.url, std::make_pair(response, memoryCacheOrder.begin()));
+        memoryCacheSize += size;
+
+        evictMemoryCache();
+    }
+
+    void evictMemoryCache() {
+        while (memoryCacheSize > maximumMemoryCacheSize && !memoryCacheOrder.empty()) {
+            auto it = memoryCache.find(memoryCacheOrder.back());
+            assert(it != memoryCache.end());
+            memoryCacheSize -= cachedResponseSize(it->first, it->second.first);
+            memoryCache.erase(it);
+            memoryCacheOrder.pop_back();
+        }
+    }
+
+    static uint64_t cachedResponseSize(const std::string& url, const Response& response) {
+        // Approximate: the payload plus the two copies of the key. Fixed
+        // per-entry bookkeeping is noise next to tile payloads.
+        return (response.data ? response.data->size() : 0) + 2 * url.size();
+    }
+
+    void flushPendingPuts() {
+        putFlushTimer.stop();
+        if (pendingPuts.empty()) {
+            return;
+        }
+
+        std::vector<std::pair<Resource, Response>> batch;
+        batch.swap(pendingPuts);
+        offlineDatabase.putBatch(batch);
+    }
+
     OfflineDownload& getDownload(int64_t regionID) {
         auto it = downloads.find(regionID);
         if (it != downloads.end()) {
@@ -160,8 +360,15 @@ private:
 
     OfflineDatabase offlineDatabase;
     OnlineFileSource onlineFileSource;
+    std::vector<std::pair<Resource, Response>> pendingPuts;
+    util::Timer putFlushTimer;
+    std::list<std::string> memoryCacheOrder;
+    std::unordered_map<std::string, std::pair<Response, std::list<std::string>::iterator>> memoryCache;
+    uint64_t memoryCacheSize = 0;
+    uint64_t maximumMemoryCacheSize = util::DEFAULT_MAX_MEMORY_CACHE_SIZE;
     std::unordered_map<AsyncRequest*, std::unique_ptr<AsyncRequest>> tasks;
     std::unordered_map<int64_t, std::unique_ptr<OfflineDownload>> downloads;
+    std::unordered_map<std::string, std::unique_ptr<OfflineDownload>> preloads;
 };
 
 DefaultFileSource::DefaultFileSource(const std::string& cachePath,
@@ -171,6 +378,7 @@ DefaultFileSource::DefaultFileSource(const std::string& cachePath,
             cachePath, maximumCacheSize)),
       assetFileSource(std::make_unique<AssetFileSource>(assetRoot)),
       localFileSource(std::make_unique<LocalFileSource>()) {
+    util::markStartupMilestone(StartupMilestone::FileSourceReady);
 }
 
 DefaultFileSource::~DefaultFileSource() = default;
@@ -227,6 +435,18 @@ std::unique_ptr<AsyncRequest> DefaultFileSource::request(const Resource& resourc
     }
 }
 
+void DefaultFileSource::preloadStyle(const std::string& styleURL, float pixelRatio) {
+    thread->invoke(&Impl::preloadStyle, styleURL, pixelRatio);
+}
+
+optional<Tileset> DefaultFileSource::getCachedTileset(const std::string& url) {
+    return thread->invokeSync(&Impl::getCachedTileset, url);
+}
+
+void DefaultFileSource::putCachedTileset(const std::string& url, const Tileset& tileset, optional<Timestamp> expires) {
+    thread->invoke(&Impl::putCachedTileset, url, tileset, expires);
+}
+
 void DefaultFileSource::listOfflineRegions(std::function<void (std::exception_ptr, optional<std::vector<OfflineRegion>>)> callback) {
     thread->invoke(&Impl::listRegions, callback);
 }
@@ -247,6 +467,11 @@ void DefaultFileSource::deleteOfflineRegion(OfflineRegion&& region, std::functio
     thread->invoke(&Impl::deleteRegion, std::move(region), callback);
 }
 
+void DefaultFileSource::mergeOfflineDatabase(const std::string& sideDatabasePath,
+                                             std::function<void (std::exception_ptr, optional<std::vector<OfflineRegion>>)> callback) {
+    thread->invoke(&Impl::mergeDatabase, sideDatabasePath, callback);
+}
+
 void DefaultFileSource::setOfflineRegionObserver(OfflineRegion& region, std::unique_ptr<OfflineRegionObserver> observer) {
     thread->invoke(&Impl::setRegionObserver, region.getID(), std::move(observer));
 }
@@ -263,6 +488,18 @@ void DefaultFileSource::setOfflineMapboxTileCountLimit(uint64_t limit) const {
     thread->invokeSync(&Impl::setOfflineMapboxTileCountLimit, limit);
 }
 
+void DefaultFileSource::setMaximumMemoryCacheSize(uint64_t size) const {
+    thread->invoke(&Impl::setMaximumMemoryCacheSize, size);
+}
+
+void DefaultFileSource::setRevalidationWindow(Duration window) const {
+    thread->invoke(&Impl::setRevalidationWindow, window);
+}
+
+void DefaultFileSource::setTransferRateLimit(Resource::Kind kind, uint64_t bytesPerSecond) const {
+    thread->invoke(&Impl::setTransferRateLimit, kind, bytesPerSecond);
+}
+
 void DefaultFileSource::pause() {
     thread->pause();
 }
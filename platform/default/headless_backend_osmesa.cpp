@@ -21,6 +21,10 @@ struct OSMesaImpl : public HeadlessBackend::Impl {
         }
     }
 
+    void* glContextHandle() const final {
+        return glContext;
+    }
+
     OSMesaContext glContext = nullptr;
     GLubyte fakeBuffer = 0;
 };
@@ -36,10 +40,11 @@ bool HeadlessBackend::hasDisplay() {
 void HeadlessBackend::createContext() {
     assert(!hasContext());
 
+    OSMesaContext shareList = static_cast<OSMesaContext>(shareContext);
 #if OSMESA_MAJOR_VERSION * 100 + OSMESA_MINOR_VERSION >= 305
-    OSMesaContext glContext = OSMesaCreateContextExt(OSMESA_RGBA, 16, 0, 0, nullptr);
+    OSMesaContext glContext = OSMesaCreateContextExt(OSMESA_RGBA, 16, 0, 0, shareList);
 #else
-    OSMesaContext glContext = OSMesaCreateContext(OSMESA_RGBA, nullptr);
+    OSMesaContext glContext = OSMesaCreateContext(OSMESA_RGBA, shareList);
 #endif
     if (glContext == nullptr) {
         throw std::runtime_error("Error creating GL context object.");
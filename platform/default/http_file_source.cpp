@@ -102,6 +102,12 @@ HTTPFileSource::Impl::Impl() {
     handleError(curl_multi_setopt(multi, CURLMOPT_SOCKETDATA, this));
     handleError(curl_multi_setopt(multi, CURLMOPT_TIMERFUNCTION, startTimeout));
     handleError(curl_multi_setopt(multi, CURLMOPT_TIMERDATA, this));
+#if LIBCURL_VERSION_NUM >= ((7) << 16 | (43) << 8 | 0) // Added in 7.43.0
+    // Multiplex concurrent transfers to the same host over a single HTTP/2
+    // connection, so a burst of tile/glyph/sprite requests pays for one TLS
+    // handshake per host rather than one per connection.
+    handleError(curl_multi_setopt(multi, CURLMOPT_PIPELINING, CURLPIPE_MULTIPLEX));
+#endif
 }
 
 HTTPFileSource::Impl::~Impl() {
@@ -240,6 +246,11 @@ HTTPRequest::HTTPRequest(HTTPFileSource::Impl* context_, Resource resource_, Fil
         headers = curl_slist_append(headers, time.c_str());
     }
 
+    if (resource.accept) {
+        const std::string header = std::string("Accept: ") + *resource.accept;
+        headers = curl_slist_append(headers, header.c_str());
+    }
+
     if (headers) {
         curl_easy_setopt(handle, CURLOPT_HTTPHEADER, headers);
     }
@@ -260,6 +271,21 @@ HTTPRequest::HTTPRequest(HTTPFileSource::Impl* context_, Resource resource_, Fil
 #endif
     handleError(curl_easy_setopt(handle, CURLOPT_USERAGENT, "MapboxGL/1.0"));
     handleError(curl_easy_setopt(handle, CURLOPT_SHARE, context->share));
+#if LIBCURL_VERSION_NUM >= ((7) << 16 | (47) << 8 | 0) // CURL_HTTP_VERSION_2TLS added in 7.47.0
+    // Negotiate HTTP/2 where the server offers it; plain HTTP stays on 1.1.
+    handleError(curl_easy_setopt(handle, CURLOPT_HTTP_VERSION, CURL_HTTP_VERSION_2TLS));
+#endif
+#if LIBCURL_VERSION_NUM >= ((7) << 16 | (43) << 8 | 0) // Added in 7.43.0
+    // Prefer waiting briefly for an existing connection to become available
+    // for multiplexing over opening another connection to the same host.
+    handleError(curl_easy_setopt(handle, CURLOPT_PIPEWAIT, 1L));
+#endif
+#if LIBCURL_VERSION_NUM >= ((7) << 16 | (46) << 8 | 0) // Added in 7.46.0
+    // HTTP/2 stream weights range from 1 to 256; give background requests a
+    // quarter of the bandwidth of regular ones while they compete.
+    handleError(curl_easy_setopt(handle, CURLOPT_STREAM_WEIGHT,
+                                 resource.priority == Resource::Low ? 32L : 128L));
+#endif
 
     // Start requesting the information.
     handleError(curl_multi_add_handle(context->multi, handle));
@@ -329,6 +355,19 @@ size_t HTTPRequest::headerCallback(char *const buffer, const size_t size, const
     } else if ((begin = headerMatches("expires: ", buffer, length)) != std::string::npos) {
         const std::string value { buffer + begin, length - begin - 2 }; // remove \r\n
         baton->response->expires = Timestamp{ Seconds(curl_getdate(value.c_str(), nullptr)) };
+    } else if ((begin = headerMatches("content-length: ", buffer, length)) != std::string::npos) {
+        // Reserve the response buffer up front so the appends in writeCallback
+        // don't reallocate and copy the accumulated body as the transfer grows.
+        // With compressed transfer encodings this is the compressed size, which
+        // still serves as a useful lower bound.
+        const std::string value { buffer + begin, length - begin - 2 }; // remove \r\n
+        const unsigned long bodySize = strtoul(value.c_str(), nullptr, 10);
+        if (bodySize > 0 && bodySize < 128 * 1024 * 1024) {
+            if (!baton->data) {
+                baton->data = std::make_shared<std::string>();
+            }
+            baton->data->reserve(bodySize);
+        }
     } else if ((begin = headerMatches("retry-after: ", buffer, length)) != std::string::npos) {
         baton->retryAfter = std::string(buffer + begin, length - begin - 2); // remove \r\n
     } else if ((begin = headerMatches("x-rate-limit-reset: ", buffer, length)) != std::string::npos) {
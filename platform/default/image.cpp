@@ -9,9 +9,9 @@ PremultipliedImage decodeWebP(const uint8_t*, size_t);
 #endif // !defined(__ANDROID__) && !defined(__APPLE__)
 
 PremultipliedImage decodePNG(const uint8_t*, size_t);
-PremultipliedImage decodeJPEG(const uint8_t*, size_t);
+PremultipliedImage decodeJPEG(const uint8_t*, size_t, uint32_t maxDimension);
 
-PremultipliedImage decodeImage(const std::string& string) {
+PremultipliedImage decodeImage(const std::string& string, uint32_t maxDimension) {
     const uint8_t* data = reinterpret_cast<const uint8_t*>(string.data());
     const size_t size = string.size();
 
@@ -35,11 +35,19 @@ PremultipliedImage decodeImage(const std::string& string) {
     if (size >= 2) {
         uint16_t magic = ((data[0] << 8) | data[1]) & 0xffff;
         if (magic == 0xFFD8) {
-            return decodeJPEG(data, size);
+            return decodeJPEG(data, size, maxDimension);
         }
     }
 
     throw std::runtime_error("unsupported image type");
 }
 
+const char* imageAcceptHeader() {
+#if !defined(__ANDROID__) && !defined(__APPLE__)
+    return "image/webp,image/png;q=0.9,image/jpeg;q=0.8,image/*;q=0.5";
+#else
+    return "image/png,image/jpeg;q=0.9,image/*;q=0.5";
+#endif // !defined(__ANDROID__) && !defined(__APPLE__)
+}
+
 } // namespace mbgl
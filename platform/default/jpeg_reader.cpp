@@ -89,7 +89,7 @@ struct jpeg_info_guard {
     jpeg_decompress_struct* i_;
 };
 
-PremultipliedImage decodeJPEG(const uint8_t* data, size_t size) {
+PremultipliedImage decodeJPEG(const uint8_t* data, size_t size, uint32_t maxDimension) {
     util::CharArrayBuffer dataBuffer { reinterpret_cast<const char*>(data), size };
     std::istream stream(&dataBuffer);
 
@@ -106,6 +106,19 @@ PremultipliedImage decodeJPEG(const uint8_t* data, size_t size) {
     if (ret != JPEG_HEADER_OK)
         throw std::runtime_error("JPEG Reader: failed to read header");
 
+    if (maxDimension > 0) {
+        // libjpeg scales by 1/2, 1/4 or 1/8 during the IDCT at almost no
+        // cost. Pick the largest reduction that keeps both dimensions at or
+        // above the requested display size.
+        cinfo.scale_num = 1;
+        cinfo.scale_denom = 1;
+        while (cinfo.scale_denom < 8 &&
+               cinfo.image_width / (cinfo.scale_denom * 2) >= maxDimension &&
+               cinfo.image_height / (cinfo.scale_denom * 2) >= maxDimension) {
+            cinfo.scale_denom *= 2;
+        }
+    }
+
     jpeg_start_decompress(&cinfo);
 
     if (cinfo.out_color_space == JCS_UNKNOWN)
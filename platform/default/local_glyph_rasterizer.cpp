@@ -0,0 +1,25 @@
+#include <mbgl/text/local_glyph_rasterizer.hpp>
+
+namespace mbgl {
+
+// The default implementation has no platform font rendering API to draw on,
+// so it never offers to rasterize anything and all glyphs are fetched via
+// GlyphPBF.
+
+class LocalGlyphRasterizer::Impl {
+};
+
+LocalGlyphRasterizer::LocalGlyphRasterizer(const optional<std::string>&) {
+}
+
+LocalGlyphRasterizer::~LocalGlyphRasterizer() = default;
+
+bool LocalGlyphRasterizer::canRasterizeGlyph(const FontStack&, GlyphID) {
+    return false;
+}
+
+SDFGlyph LocalGlyphRasterizer::rasterizeGlyph(const FontStack&, GlyphID) {
+    return SDFGlyph();
+}
+
+} // namespace mbgl
@@ -4,11 +4,50 @@
 #include <mbgl/map/backend_scope.hpp>
 
 #include <cassert>
+#include <mutex>
 #include <stdexcept>
 #include <type_traits>
+#include <vector>
 
 namespace mbgl {
 
+namespace {
+
+// Contexts released by destroyed backends, kept for reuse by the next
+// backend on the same display. Creating a headless GL context costs on the
+// order of 100 ms, which dominates suites that construct one backend per
+// test case or benchmark repetition. Reuse is safe because a fresh
+// gl::Context starts with all state marked dirty, so leftover GL server
+// state is re-set on first use; the GL objects themselves were deleted when
+// the releasing backend reset its gl::Context.
+struct PooledContext {
+    // Keeps the display open for as long as the pooled context exists.
+    std::shared_ptr<HeadlessDisplay> display;
+    std::unique_ptr<HeadlessBackend::Impl> impl;
+};
+
+std::mutex contextPoolMutex;
+std::vector<PooledContext> contextPool;
+
+// More simultaneously-live backends than this is rare; beyond it, released
+// contexts are destroyed as before.
+constexpr std::size_t maxPooledContexts = 4;
+
+} // namespace
+
+std::shared_ptr<HeadlessDisplay> HeadlessBackend::getSharedDisplay() {
+    static std::mutex mutex;
+    static std::weak_ptr<HeadlessDisplay> cached;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    auto display = cached.lock();
+    if (!display) {
+        display = std::make_shared<HeadlessDisplay>();
+        cached = display;
+    }
+    return display;
+}
+
 HeadlessBackend::HeadlessBackend() {
 }
 
@@ -16,9 +55,30 @@ HeadlessBackend::HeadlessBackend(std::shared_ptr<HeadlessDisplay> display_)
         : display(std::move(display_)) {
 }
 
+HeadlessBackend::HeadlessBackend(const HeadlessBackend& shareWith)
+        : display(shareWith.display) {
+    if (!shareWith.impl) {
+        throw std::runtime_error("Backend to share with has no context");
+    }
+    shareContext = shareWith.impl->glContextHandle();
+    if (!shareContext) {
+        throw std::runtime_error("Platform does not support context sharing");
+    }
+}
+
 HeadlessBackend::~HeadlessBackend() {
     BackendScope scope(*this);
     context.reset();
+
+    // The now-empty context can serve the next backend on this display.
+    // Contexts sharing another context's object namespace are tied to their
+    // share partner's lifetime and are not reusable.
+    if (impl && !shareContext) {
+        std::lock_guard<std::mutex> lock(contextPoolMutex);
+        if (contextPool.size() < maxPooledContexts) {
+            contextPool.push_back({ display, std::move(impl) });
+        }
+    }
 }
 
 void HeadlessBackend::activate() {
@@ -28,7 +88,19 @@ void HeadlessBackend::activate() {
         if (!hasDisplay()) {
             throw std::runtime_error("Display is not set");
         }
-        createContext();
+        if (!shareContext) {
+            std::lock_guard<std::mutex> lock(contextPoolMutex);
+            for (auto it = contextPool.begin(); it != contextPool.end(); ++it) {
+                if (it->display == display) {
+                    impl = std::move(it->impl);
+                    contextPool.erase(it);
+                    break;
+                }
+            }
+        }
+        if (!hasContext()) {
+            createContext();
+        }
     }
 
     assert(hasContext());
@@ -13,8 +13,24 @@ class HeadlessBackend : public Backend {
 public:
     HeadlessBackend();
     HeadlessBackend(std::shared_ptr<HeadlessDisplay>);
+
+    // Creates a backend whose GL context shares its object namespace
+    // (textures, buffers, programs) with the given backend's context, so
+    // resources uploaded once can be used by several backends. The other
+    // backend must have been activated at least once so that its context
+    // exists. Concurrent use of shared contexts follows the usual GL rules:
+    // each context on its own thread, object handoff synchronized by the
+    // caller.
+    explicit HeadlessBackend(const HeadlessBackend& shareWith);
+
     ~HeadlessBackend() override;
 
+    // The display shared by default-constructed backends. Opening a display
+    // is expensive; every headless backend in the process can use the same
+    // one. Kept alive only while referenced, so an idle process does not
+    // hold the display open.
+    static std::shared_ptr<HeadlessDisplay> getSharedDisplay();
+
     void updateAssumedState() override;
 
     void invalidate() override;
@@ -23,6 +39,9 @@ public:
         virtual ~Impl() {}
         virtual void activateContext() = 0;
         virtual void deactivateContext() {}
+        // The platform's context handle, used as the share list when creating
+        // a context that shares this one's object namespace.
+        virtual void* glContextHandle() const { return nullptr; }
     };
 
 private:
@@ -40,6 +59,9 @@ private:
     std::shared_ptr<HeadlessDisplay> display;
     std::unique_ptr<Impl> impl;
 
+    // Context to share the object namespace with, if any.
+    void* shareContext = nullptr;
+
     bool active = false;
 };
 
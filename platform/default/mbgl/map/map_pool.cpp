@@ -0,0 +1,142 @@
+#include <mbgl/map/map_pool.hpp>
+#include <mbgl/gl/headless_backend.hpp>
+#include <mbgl/gl/offscreen_view.hpp>
+#include <mbgl/map/backend_scope.hpp>
+#include <mbgl/map/map.hpp>
+
+#include <algorithm>
+#include <cassert>
+
+namespace mbgl {
+
+class MapPool::Entry {
+public:
+    Entry(FileSource& fileSource, Scheduler& scheduler, float pixelRatio, const std::string& programCacheDir)
+        : map(backend, { 512, 512 }, pixelRatio, fileSource, scheduler, MapMode::Still,
+              GLContextMode::Unique, ConstrainMode::HeightOnly, ViewportMode::Default,
+              programCacheDir) {
+    }
+
+    HeadlessBackend backend;
+    Map map;
+
+    // Recreated only when a request needs a different framebuffer size; the
+    // common fixed-size farm workload reuses one framebuffer per map.
+    std::unique_ptr<OffscreenView> view;
+
+    // The style currently resident on this map. Requests matching it skip
+    // the restyle entirely, which is the expensive path the pool avoids.
+    std::string styleURL;
+    std::string styleJSON;
+
+    bool busy = false;
+    uint64_t lastUsed = 0;
+};
+
+MapPool::MapPool(FileSource& fileSource_,
+                 Scheduler& scheduler_,
+                 std::size_t numMaps,
+                 float pixelRatio_,
+                 const std::string& programCacheDir_)
+    : fileSource(fileSource_),
+      scheduler(scheduler_),
+      pixelRatio(pixelRatio_),
+      programCacheDir(programCacheDir_) {
+    assert(numMaps > 0);
+    entries.reserve(numMaps);
+    for (std::size_t i = 0; i < numMaps; i++) {
+        entries.push_back(std::make_unique<Entry>(fileSource, scheduler, pixelRatio, programCacheDir));
+    }
+}
+
+MapPool::~MapPool() = default;
+
+std::size_t MapPool::size() const {
+    return entries.size();
+}
+
+std::size_t MapPool::idleCount() const {
+    return static_cast<std::size_t>(std::count_if(
+        entries.begin(), entries.end(), [](const auto& entry) { return !entry->busy; }));
+}
+
+MapPool::Entry* MapPool::acquire(const StillRequest& request) {
+    Entry* lru = nullptr;
+    for (const auto& entry : entries) {
+        if (entry->busy) {
+            continue;
+        }
+        const bool warm = !request.styleJSON.empty() ? entry->styleJSON == request.styleJSON
+                                                     : entry->styleURL == request.styleURL;
+        if (warm) {
+            return entry.get();
+        }
+        if (!lru || entry->lastUsed < lru->lastUsed) {
+            lru = entry.get();
+        }
+    }
+    return lru;
+}
+
+void MapPool::renderStill(StillRequest request, StillImageCallback callback) {
+    if (Entry* entry = acquire(request)) {
+        dispatch(*entry, std::move(request), std::move(callback));
+    } else {
+        queued.emplace_back(std::move(request), std::move(callback));
+    }
+}
+
+void MapPool::dispatch(Entry& entry, StillRequest request, StillImageCallback callback) {
+    entry.busy = true;
+    entry.lastUsed = ++useCounter;
+
+    if (!request.styleJSON.empty()) {
+        if (entry.styleJSON != request.styleJSON) {
+            entry.map.setStyleJSON(request.styleJSON);
+            entry.styleJSON = request.styleJSON;
+            entry.styleURL.clear();
+        }
+    } else if (entry.styleURL != request.styleURL) {
+        entry.map.setStyleURL(request.styleURL);
+        entry.styleURL = request.styleURL;
+        entry.styleJSON.clear();
+    }
+
+    entry.map.setSize(request.size);
+    entry.map.jumpTo(request.camera);
+    entry.map.setDebug(request.debug);
+
+    const Size framebufferSize = { static_cast<uint32_t>(request.size.width * pixelRatio),
+                                   static_cast<uint32_t>(request.size.height * pixelRatio) };
+    {
+        BackendScope guard(entry.backend);
+        if (!entry.view || entry.view->getSize() != framebufferSize) {
+            entry.view = std::make_unique<OffscreenView>(entry.backend.getContext(), framebufferSize);
+        }
+    }
+
+    entry.map.renderStill(*entry.view, [this, &entry, callback](std::exception_ptr error) {
+        PremultipliedImage image;
+        if (!error) {
+            BackendScope guard(entry.backend);
+            image = entry.view->readStillImage();
+        }
+
+        entry.busy = false;
+        callback(error, std::move(image));
+
+        // The callback may have submitted follow-up work; dispatch whatever
+        // is still queued onto whatever is now idle, oldest first.
+        while (!queued.empty()) {
+            Entry* idle = acquire(queued.front().first);
+            if (!idle) {
+                break;
+            }
+            auto next = std::move(queued.front());
+            queued.pop_front();
+            dispatch(*idle, std::move(next.first), std::move(next.second));
+        }
+    });
+}
+
+} // namespace mbgl
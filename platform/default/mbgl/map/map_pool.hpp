@@ -0,0 +1,76 @@
+#pragma once
+
+#include <mbgl/map/camera.hpp>
+#include <mbgl/map/mode.hpp>
+#include <mbgl/util/image.hpp>
+#include <mbgl/util/noncopyable.hpp>
+#include <mbgl/util/size.hpp>
+
+#include <deque>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace mbgl {
+
+class FileSource;
+class Scheduler;
+
+// A pool of warm still-mode maps for render servers. Each pooled map keeps
+// its parsed style, sprites, and glyphs resident between requests, so a
+// request whose style is already warm on some map pays only for camera/size
+// changes and tile loads — not for re-parsing the style and re-fetching its
+// resources. All maps share the caller's FileSource, and therefore a single
+// cache/offline database.
+//
+// The pool is single-threaded, like Map itself: construct it and call
+// renderStill() from the thread running the RunLoop, and callbacks arrive on
+// that thread. Requests that find every map busy are queued and dispatched
+// in order as maps become idle.
+class MapPool : private util::noncopyable {
+public:
+    MapPool(FileSource&,
+            Scheduler&,
+            std::size_t numMaps,
+            float pixelRatio = 1,
+            const std::string& programCacheDir = "");
+    ~MapPool();
+
+    class StillRequest {
+    public:
+        // Exactly one of styleURL/styleJSON should be set; styleJSON wins
+        // when both are.
+        std::string styleURL;
+        std::string styleJSON;
+        CameraOptions camera;
+        Size size = { 512, 512 };
+        MapDebugOptions debug = MapDebugOptions::NoDebug;
+    };
+
+    using StillImageCallback = std::function<void(std::exception_ptr, PremultipliedImage)>;
+    void renderStill(StillRequest, StillImageCallback);
+
+    std::size_t size() const;
+    std::size_t idleCount() const;
+
+private:
+    class Entry;
+
+    // Prefers an idle map that already has the requested style resident;
+    // otherwise restyles the least-recently-used idle map. Null when every
+    // map is busy.
+    Entry* acquire(const StillRequest&);
+    void dispatch(Entry&, StillRequest, StillImageCallback);
+
+    FileSource& fileSource;
+    Scheduler& scheduler;
+    const float pixelRatio;
+    const std::string programCacheDir;
+
+    std::vector<std::unique_ptr<Entry>> entries;
+    std::deque<std::pair<StillRequest, StillImageCallback>> queued;
+    uint64_t useCounter = 0;
+};
+
+} // namespace mbgl
@@ -5,9 +5,14 @@
 #include <mbgl/util/string.hpp>
 #include <mbgl/util/chrono.hpp>
 #include <mbgl/util/logging.hpp>
+#include <mbgl/util/memory_stats.hpp>
 
 #include "sqlite3.hpp"
 
+#include <rapidjson/document.h>
+#include <rapidjson/stringbuffer.h>
+#include <rapidjson/writer.h>
+
 namespace mbgl {
 
 OfflineDatabase::Statement::~Statement() {
@@ -36,6 +41,10 @@ void OfflineDatabase::connect(int flags) {
     db = std::make_unique<mapbox::sqlite::Database>(path.c_str(), flags);
     db->setBusyTimeout(Milliseconds::max());
     db->exec("PRAGMA foreign_keys = ON");
+
+    // The journal mode is persistent, but the sync level is per-connection,
+    // so it has to be re-applied every time we open the database.
+    db->exec("PRAGMA synchronous = NORMAL");
 }
 
 void OfflineDatabase::ensureSchema() {
@@ -49,7 +58,9 @@ void OfflineDatabase::ensureSchema() {
             case 2: migrateToVersion3(); // fall through
             case 3: // no-op and fall through
             case 4: migrateToVersion5(); // fall through
-            case 5: return;
+            case 5: migrateToVersion6(); // fall through
+            case 6: migrateToVersion7(); // fall through
+            case 7: return;
             default: throw std::runtime_error("unknown schema version");
             }
 
@@ -80,10 +91,10 @@ void OfflineDatabase::ensureSchema() {
 
         // If you change the schema you must write a migration from the previous version.
         db->exec("PRAGMA auto_vacuum = INCREMENTAL");
-        db->exec("PRAGMA journal_mode = DELETE");
-        db->exec("PRAGMA synchronous = FULL");
+        db->exec("PRAGMA journal_mode = WAL");
+        db->exec("PRAGMA synchronous = NORMAL");
         db->exec(schema);
-        db->exec("PRAGMA user_version = 5");
+        db->exec("PRAGMA user_version = 7");
     } catch (...) {
         Log::Error(Event::Database, "Unexpected error creating database schema: %s", util::toString(std::current_exception()).c_str());
         throw;
@@ -126,6 +137,28 @@ void OfflineDatabase::migrateToVersion5() {
     db->exec("PRAGMA user_version = 5");
 }
 
+// Schema version 6 reinstates WAL journaling and NORMAL sync, now that the
+// mode-switching churn that motivated the v5 revert is behind us. WAL lets
+// cache reads proceed while a put transaction is committing instead of
+// queuing behind it, and under WAL a NORMAL sync commit can't corrupt the
+// database — at worst the last commit is lost on power failure, which is
+// acceptable for a cache.
+
+void OfflineDatabase::migrateToVersion6() {
+    db->exec("PRAGMA journal_mode = WAL");
+    db->exec("PRAGMA synchronous = NORMAL");
+    db->exec("PRAGMA user_version = 6");
+}
+
+// Schema version 7 adds the tilesets table: parsed TileJSON manifests that
+// tile sources load optimistically at startup, removing the manifest round
+// trip from the cold start critical path.
+
+void OfflineDatabase::migrateToVersion7() {
+    db->exec("CREATE TABLE tilesets (url TEXT NOT NULL PRIMARY KEY, data BLOB NOT NULL, expires INTEGER)");
+    db->exec("PRAGMA user_version = 7");
+}
+
 OfflineDatabase::Statement OfflineDatabase::getStatement(const char * sql) {
     auto it = statements.find(sql);
 
@@ -133,7 +166,15 @@ OfflineDatabase::Statement OfflineDatabase::getStatement(const char * sql) {
         return Statement(*it->second);
     }
 
-    return Statement(*statements.emplace(sql, std::make_unique<mapbox::sqlite::Statement>(db->prepare(sql))).first->second);
+    it = statements.emplace(sql, std::make_unique<mapbox::sqlite::Statement>(db->prepare(sql))).first;
+
+    // SQLite allocates through its own allocator, so its memory — page cache,
+    // prepared statements, and all — is sampled rather than tracked per
+    // allocation. Preparing a statement is the growth event worth resampling
+    // on; the steady state is dominated by the bounded page cache.
+    util::setMemoryUsage(MemoryCategory::Database, mapbox::sqlite::memoryUsed());
+
+    return Statement(*it->second);
 }
 
 optional<Response> OfflineDatabase::get(const Resource& resource) {
@@ -163,6 +204,124 @@ std::pair<bool, uint64_t> OfflineDatabase::put(const Resource& resource, const R
     return putInternal(resource, response, true);
 }
 
+void OfflineDatabase::putBatch(const std::vector<std::pair<Resource, Response>>& entries) {
+    if (entries.empty()) {
+        return;
+    }
+
+    mapbox::sqlite::Transaction transaction(*db, mapbox::sqlite::Transaction::Immediate);
+    batching = true;
+
+    try {
+        for (const auto& entry : entries) {
+            putInternal(entry.first, entry.second, true);
+        }
+    } catch (...) {
+        batching = false;
+        throw;
+    }
+
+    batching = false;
+    transaction.commit();
+}
+
+namespace {
+
+// Tileset blobs are stored as JSON, like region definitions. A blob that
+// fails to parse or validate is treated as a cache miss.
+std::string encodeTileset(const Tileset& tileset) {
+    rapidjson::GenericDocument<rapidjson::UTF8<>, rapidjson::CrtAllocator> doc;
+    doc.SetObject();
+
+    rapidjson::GenericValue<rapidjson::UTF8<>, rapidjson::CrtAllocator> tiles(rapidjson::kArrayType);
+    for (const auto& url : tileset.tiles) {
+        tiles.PushBack(rapidjson::StringRef(url.data(), url.length()), doc.GetAllocator());
+    }
+    doc.AddMember("tiles", tiles, doc.GetAllocator());
+
+    doc.AddMember("min_zoom", tileset.zoomRange.min, doc.GetAllocator());
+    doc.AddMember("max_zoom", tileset.zoomRange.max, doc.GetAllocator());
+    doc.AddMember("attribution", rapidjson::StringRef(tileset.attribution.data(), tileset.attribution.length()), doc.GetAllocator());
+    doc.AddMember("tms", tileset.scheme == Tileset::Scheme::TMS, doc.GetAllocator());
+
+    rapidjson::StringBuffer buffer;
+    rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
+    doc.Accept(writer);
+    return { buffer.GetString(), buffer.GetSize() };
+}
+
+optional<Tileset> decodeTileset(const std::string& blob) {
+    rapidjson::GenericDocument<rapidjson::UTF8<>, rapidjson::CrtAllocator> doc;
+    doc.Parse<0>(blob.c_str());
+
+    if (doc.HasParseError() || !doc.IsObject() ||
+        !doc.HasMember("tiles") || !doc["tiles"].IsArray() ||
+        !doc.HasMember("min_zoom") || !doc["min_zoom"].IsUint() ||
+        !doc.HasMember("max_zoom") || !doc["max_zoom"].IsUint() ||
+        !doc.HasMember("attribution") || !doc["attribution"].IsString() ||
+        !doc.HasMember("tms") || !doc["tms"].IsBool()) {
+        return {};
+    }
+
+    Tileset tileset;
+    for (const auto& url : doc["tiles"].GetArray()) {
+        if (!url.IsString()) {
+            return {};
+        }
+        tileset.tiles.emplace_back(url.GetString(), url.GetStringLength());
+    }
+    tileset.zoomRange = { static_cast<uint8_t>(doc["min_zoom"].GetUint()),
+                          static_cast<uint8_t>(doc["max_zoom"].GetUint()) };
+    tileset.attribution = { doc["attribution"].GetString(), doc["attribution"].GetStringLength() };
+    tileset.scheme = doc["tms"].GetBool() ? Tileset::Scheme::TMS : Tileset::Scheme::XYZ;
+    return { std::move(tileset) };
+}
+
+// How long past its expiration an entry may still be served. A manifest's
+// tile URLs can rotate; serving one arbitrarily stale would point every tile
+// request at dead URLs before the revalidation corrects it.
+constexpr Seconds tilesetGracePeriod = Seconds(60 * 60 * 24 * 7);
+
+} // namespace
+
+optional<Tileset> OfflineDatabase::getTileset(const std::string& url) {
+    // clang-format off
+    Statement stmt = getStatement(
+        //       0       1
+        "SELECT data, expires "
+        "FROM tilesets "
+        "WHERE url = ?");
+    // clang-format on
+
+    stmt->bind(1, url);
+
+    if (!stmt->run()) {
+        return {};
+    }
+
+    optional<Timestamp> expires = stmt->get<optional<Timestamp>>(1);
+    if (expires && *expires + tilesetGracePeriod < util::now()) {
+        return {};
+    }
+
+    return decodeTileset(stmt->get<std::string>(0));
+}
+
+void OfflineDatabase::putTileset(const std::string& url, const Tileset& tileset, optional<Timestamp> expires) {
+    // clang-format off
+    Statement stmt = getStatement(
+        "REPLACE INTO tilesets (url, data, expires) "
+        "VALUES                (?1,  ?2,   ?3) ");
+    // clang-format on
+
+    const std::string data = encodeTileset(tileset);
+
+    stmt->bind(1, url);
+    stmt->bindBlob(2, data.data(), data.size(), false);
+    stmt->bind(3, expires);
+    stmt->run();
+}
+
 std::pair<bool, uint64_t> OfflineDatabase::putInternal(const Resource& resource, const Response& response, bool evict_) {
     if (response.error) {
         return { false, 0 };
@@ -280,8 +439,13 @@ bool OfflineDatabase::putResource(const Resource& resource,
     // We can't use REPLACE because it would change the id value.
 
     // Begin an immediate-mode transaction to ensure that two writers do not attempt
-    // to INSERT a resource at the same moment.
-    mapbox::sqlite::Transaction transaction(*db, mapbox::sqlite::Transaction::Immediate);
+    // to INSERT a resource at the same moment. When we're inside putBatch(), its
+    // transaction already guarantees this, and SQLite transactions cannot nest.
+    std::unique_ptr<mapbox::sqlite::Transaction> transaction;
+    if (!batching) {
+        transaction = std::make_unique<mapbox::sqlite::Transaction>(
+            *db, mapbox::sqlite::Transaction::Immediate);
+    }
 
     // clang-format off
     Statement update = getStatement(
@@ -313,7 +477,9 @@ bool OfflineDatabase::putResource(const Resource& resource,
 
     update->run();
     if (update->changes() != 0) {
-        transaction.commit();
+        if (transaction) {
+            transaction->commit();
+        }
         return false;
     }
 
@@ -339,7 +505,9 @@ bool OfflineDatabase::putResource(const Resource& resource,
     }
 
     insert->run();
-    transaction.commit();
+    if (transaction) {
+        transaction->commit();
+    }
 
     return true;
 }
@@ -463,8 +631,13 @@ bool OfflineDatabase::putTile(const Resource::TileData& tile,
     // We can't use REPLACE because it would change the id value.
 
     // Begin an immediate-mode transaction to ensure that two writers do not attempt
-    // to INSERT a resource at the same moment.
-    mapbox::sqlite::Transaction transaction(*db, mapbox::sqlite::Transaction::Immediate);
+    // to INSERT a resource at the same moment. When we're inside putBatch(), its
+    // transaction already guarantees this, and SQLite transactions cannot nest.
+    std::unique_ptr<mapbox::sqlite::Transaction> transaction;
+    if (!batching) {
+        transaction = std::make_unique<mapbox::sqlite::Transaction>(
+            *db, mapbox::sqlite::Transaction::Immediate);
+    }
 
     // clang-format off
     Statement update = getStatement(
@@ -502,7 +675,9 @@ bool OfflineDatabase::putTile(const Resource::TileData& tile,
 
     update->run();
     if (update->changes() != 0) {
-        transaction.commit();
+        if (transaction) {
+            transaction->commit();
+        }
         return false;
     }
 
@@ -531,7 +706,9 @@ bool OfflineDatabase::putTile(const Resource::TileData& tile,
     }
 
     insert->run();
-    transaction.commit();
+    if (transaction) {
+        transaction->commit();
+    }
 
     return true;
 }
@@ -598,6 +775,119 @@ void OfflineDatabase::deleteRegion(OfflineRegion&& region) {
     offlineMapboxTileCount = {};
 }
 
+std::vector<OfflineRegion> OfflineDatabase::mergeDatabase(const std::string& sideDatabasePath) {
+    {
+        auto stmt = db->prepare("ATTACH DATABASE ?1 AS side");
+        stmt.bind(1, sideDatabasePath);
+        stmt.run();
+    }
+
+    try {
+        {
+            auto stmt = db->prepare("PRAGMA side.user_version");
+            stmt.run();
+            // Version 7 only adds the `tilesets` table; the resources, tiles
+            // and regions tables the merge reads are identical in version 6,
+            // so packs of either vintage are accepted.
+            const int version = stmt.get<int>(0);
+            if (version != 6 && version != 7) {
+                throw std::runtime_error("sideloaded database has an incompatible schema version");
+            }
+        }
+
+        std::vector<OfflineRegion> result = mergeSideloadedRegions();
+        db->exec("DETACH DATABASE side");
+        return result;
+    } catch (...) {
+        db->exec("DETACH DATABASE side");
+        throw;
+    }
+}
+
+std::vector<OfflineRegion> OfflineDatabase::mergeSideloadedRegions() {
+    mapbox::sqlite::Transaction transaction(*db, mapbox::sqlite::Transaction::Immediate);
+
+    // Bulk-copy the pack's resources and tiles. On a URL collision the copy
+    // already in this database wins: a pack is a snapshot, so anything cached
+    // here is at least as current.
+    // clang-format off
+    db->exec("INSERT OR IGNORE INTO resources (url, kind, expires, modified, etag, data, compressed, accessed) "
+             "SELECT                           url, kind, expires, modified, etag, data, compressed, accessed "
+             "FROM side.resources");
+    db->exec("INSERT OR IGNORE INTO tiles (url_template, pixel_ratio, z, x, y, expires, modified, etag, data, compressed, accessed) "
+             "SELECT                       url_template, pixel_ratio, z, x, y, expires, modified, etag, data, compressed, accessed "
+             "FROM side.tiles");
+    // clang-format on
+
+    std::vector<OfflineRegion> result;
+
+    // Statements referencing the attached database can't go through the
+    // statement cache; they become invalid once it is detached.
+    auto sideRegions = db->prepare("SELECT id, definition, description FROM side.regions");
+
+    while (sideRegions.run()) {
+        const int64_t sideRegionID = sideRegions.get<int64_t>(0);
+        const std::string definition = sideRegions.get<std::string>(1);
+        const std::vector<uint8_t> description = sideRegions.get<std::vector<uint8_t>>(2);
+
+        {
+            // A region identical to one already installed would only duplicate
+            // its bookkeeping rows; skip it.
+            auto existing = db->prepare("SELECT id FROM regions WHERE definition = ?1 AND description = ?2");
+            existing.bind(1, definition);
+            existing.bindBlob(2, description);
+            if (existing.run()) {
+                continue;
+            }
+        }
+
+        auto insertRegion = db->prepare("INSERT INTO regions (definition, description) VALUES (?1, ?2)");
+        insertRegion.bind(1, definition);
+        insertRegion.bindBlob(2, description);
+        insertRegion.run();
+        const int64_t regionID = insertRegion.lastInsertRowId();
+
+        // clang-format off
+        auto markResources = db->prepare(
+            "INSERT OR IGNORE INTO region_resources (region_id, resource_id) "
+            "SELECT ?1, resources.id "
+            "FROM side.region_resources "
+            "JOIN side.resources ON side.region_resources.resource_id = side.resources.id "
+            "JOIN resources      ON resources.url = side.resources.url "
+            "WHERE side.region_resources.region_id = ?2");
+        // clang-format on
+        markResources.bind(1, regionID);
+        markResources.bind(2, sideRegionID);
+        markResources.run();
+
+        // clang-format off
+        auto markTiles = db->prepare(
+            "INSERT OR IGNORE INTO region_tiles (region_id, tile_id) "
+            "SELECT ?1, tiles.id "
+            "FROM side.region_tiles "
+            "JOIN side.tiles ON side.region_tiles.tile_id = side.tiles.id "
+            "JOIN tiles      ON tiles.url_template = side.tiles.url_template "
+            "               AND tiles.pixel_ratio  = side.tiles.pixel_ratio "
+            "               AND tiles.z            = side.tiles.z "
+            "               AND tiles.x            = side.tiles.x "
+            "               AND tiles.y            = side.tiles.y "
+            "WHERE side.region_tiles.region_id = ?2");
+        // clang-format on
+        markTiles.bind(1, regionID);
+        markTiles.bind(2, sideRegionID);
+        markTiles.run();
+
+        result.push_back(OfflineRegion(regionID, decodeOfflineRegionDefinition(definition), description));
+    }
+
+    transaction.commit();
+
+    // Ensure that the cached offlineTileCount value is recalculated.
+    offlineMapboxTileCount = {};
+
+    return result;
+}
+
 optional<std::pair<Response, uint64_t>> OfflineDatabase::getRegionResource(int64_t regionID, const Resource& resource) {
     auto response = getInternal(resource);
 
@@ -632,6 +922,35 @@ uint64_t OfflineDatabase::putRegionResource(int64_t regionID, const Resource& re
     return size;
 }
 
+void OfflineDatabase::putRegionResources(int64_t regionID,
+                                         const std::vector<std::pair<Resource, Response>>& entries,
+                                         OfflineRegionStatus& status) {
+    if (entries.empty()) {
+        return;
+    }
+
+    mapbox::sqlite::Transaction transaction(*db, mapbox::sqlite::Transaction::Immediate);
+    batching = true;
+
+    try {
+        for (const auto& entry : entries) {
+            uint64_t size = putRegionResource(regionID, entry.first, entry.second);
+            status.completedResourceCount++;
+            status.completedResourceSize += size;
+            if (entry.first.kind == Resource::Kind::Tile) {
+                status.completedTileCount += 1;
+                status.completedTileSize += size;
+            }
+        }
+    } catch (...) {
+        batching = false;
+        throw;
+    }
+
+    batching = false;
+    transaction.commit();
+}
+
 bool OfflineDatabase::markUsed(int64_t regionID, const Resource& resource) {
     if (resource.kind == Resource::Kind::Tile) {
         // clang-format off
@@ -2,7 +2,9 @@
 
 #include <mbgl/storage/resource.hpp>
 #include <mbgl/storage/offline.hpp>
+#include <mbgl/util/chrono.hpp>
 #include <mbgl/util/noncopyable.hpp>
+#include <mbgl/util/tileset.hpp>
 #include <mbgl/util/optional.hpp>
 #include <mbgl/util/constants.hpp>
 #include <mbgl/util/mapbox.hpp>
@@ -35,6 +37,17 @@ public:
     // Return value is (inserted, stored size)
     std::pair<bool, uint64_t> put(const Resource&, const Response&);
 
+    // Stores several resources within a single transaction, so that a burst of
+    // responses costs one fsync rather than one per response.
+    void putBatch(const std::vector<std::pair<Resource, Response>>&);
+
+    // Parsed TileJSON manifests, keyed by source URL. getTileset serves an
+    // entry even past its expiration — the caller revalidates over the
+    // network regardless — but not one expired longer than the grace period,
+    // after which the manifest's tile URLs can no longer be trusted.
+    optional<Tileset> getTileset(const std::string& url);
+    void putTileset(const std::string& url, const Tileset&, optional<Timestamp> expires);
+
     std::vector<OfflineRegion> listRegions();
 
     OfflineRegion createRegion(const OfflineRegionDefinition&,
@@ -44,11 +57,28 @@ public:
 
     void deleteRegion(OfflineRegion&&);
 
+    /*
+     * Merge the contents of a secondary database — a pre-baked offline pack
+     * using the same schema — into this one, copying over any resources and
+     * tiles not already present (on a URL collision the existing copy wins)
+     * and re-creating the pack's regions. Returns the regions added by the
+     * merge; a region identical to one already installed is skipped.
+     */
+    std::vector<OfflineRegion> mergeDatabase(const std::string& sideDatabasePath);
+
     // Return value is (response, stored size)
     optional<std::pair<Response, uint64_t>> getRegionResource(int64_t regionID, const Resource&);
     optional<int64_t> hasRegionResource(int64_t regionID, const Resource&);
     uint64_t putRegionResource(int64_t regionID, const Resource&, const Response&);
 
+    // Stores several region resources within a single transaction and folds
+    // their completed counts and sizes into the given status. Used by
+    // OfflineDownload so that a region install costs one fsync per batch
+    // rather than one per resource.
+    void putRegionResources(int64_t regionID,
+                            const std::vector<std::pair<Resource, Response>>&,
+                            OfflineRegionStatus&);
+
     OfflineRegionDefinition getRegionDefinition(int64_t regionID);
     OfflineRegionStatus getRegionCompletedStatus(int64_t regionID);
 
@@ -64,6 +94,9 @@ private:
     void removeExisting();
     void migrateToVersion3();
     void migrateToVersion5();
+    void migrateToVersion6();
+    void migrateToVersion7();
+    std::vector<OfflineRegion> mergeSideloadedRegions();
 
     class Statement {
     public:
@@ -109,6 +142,11 @@ private:
 
     uint64_t maximumCacheSize;
 
+    // Set while putBatch() holds its transaction, so that putResource() and
+    // putTile() skip their own per-put transactions; SQLite transactions
+    // cannot nest.
+    bool batching = false;
+
     uint64_t offlineMapboxTileCountLimit = util::mapbox::DEFAULT_OFFLINE_TILE_COUNT_LIMIT;
     optional<uint64_t> offlineMapboxTileCount;
 
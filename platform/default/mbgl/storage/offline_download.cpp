@@ -17,6 +17,9 @@
 
 namespace mbgl {
 
+constexpr uint32_t OfflineDownload::maximumOverlappingRequests;
+constexpr uint32_t OfflineDownload::resourcesBatchSize;
+
 OfflineDownload::OfflineDownload(int64_t id_,
                                  OfflineRegionDefinition&& definition_,
                                  OfflineDatabase& offlineDatabase_,
@@ -28,6 +31,18 @@ OfflineDownload::OfflineDownload(int64_t id_,
     setObserver(nullptr);
 }
 
+OfflineDownload::OfflineDownload(std::string styleURL,
+                                 float pixelRatio,
+                                 OfflineDatabase& offlineDatabase_,
+                                 FileSource& onlineFileSource_)
+    : id(0),
+      definition(std::move(styleURL), LatLngBounds::empty(), 0, 0, pixelRatio),
+      offlineDatabase(offlineDatabase_),
+      onlineFileSource(onlineFileSource_),
+      ambient(true) {
+    setObserver(nullptr);
+}
+
 OfflineDownload::~OfflineDownload() = default;
 
 void OfflineDownload::setObserver(std::unique_ptr<OfflineRegionObserver> observer_) {
@@ -217,29 +232,84 @@ void OfflineDownload::activateDownload() {
    the first few errors is fruitless anyway.
 */
 void OfflineDownload::continueDownload() {
+    if (resourcesRemaining.empty() && requests.empty()) {
+        // Nothing left in flight; commit whatever is buffered before deciding
+        // whether the region is complete.
+        flushResourcesBuffer();
+    }
+
     if (resourcesRemaining.empty() && status.complete()) {
         setState(OfflineRegionDownloadState::Inactive);
         return;
     }
 
-    while (!resourcesRemaining.empty() && requests.size() < HTTPFileSource::maximumConcurrentRequests()) {
+    while (!resourcesRemaining.empty() && requests.size() < maximumOverlappingRequests) {
         ensureResource(resourcesRemaining.front());
         resourcesRemaining.pop_front();
     }
 }
 
 void OfflineDownload::deactivateDownload() {
+    // Keep the progress made so far; a paused download resumes from here.
+    flushResourcesBuffer();
+
     requiredSourceURLs.clear();
     resourcesRemaining.clear();
     requests.clear();
 }
 
+void OfflineDownload::flushResourcesBuffer() {
+    if (resourcesBuffer.empty()) {
+        return;
+    }
+
+    if (ambient) {
+        // Preloaded resources belong to the ambient cache, not to a region's
+        // bookkeeping; the batch still costs a single transaction.
+        offlineDatabase.putBatch(resourcesBuffer);
+        for (const auto& entry : resourcesBuffer) {
+            status.completedResourceCount++;
+            status.completedResourceSize += entry.second.data ? entry.second.data->size() : 0;
+        }
+        resourcesBuffer.clear();
+        observer->statusChanged(status);
+        return;
+    }
+
+    offlineDatabase.putRegionResources(id, resourcesBuffer, status);
+
+    // Remember one of the tiles just committed so the Mapbox tile count limit
+    // can be re-checked against the updated count; the limit is enforced per
+    // flush rather than per response.
+    optional<Resource> committedTile;
+    for (const auto& entry : resourcesBuffer) {
+        if (entry.first.kind == Resource::Kind::Tile) {
+            committedTile = entry.first;
+            break;
+        }
+    }
+
+    resourcesBuffer.clear();
+
+    observer->statusChanged(status);
+
+    if (committedTile) {
+        checkTileCountLimit(*committedTile);
+    }
+}
+
 void OfflineDownload::queueResource(Resource resource) {
     status.requiredResourceCount++;
     resourcesRemaining.push_front(std::move(resource));
 }
 
 void OfflineDownload::queueTiles(SourceType type, uint16_t tileSize, const Tileset& tileset) {
+    // Which tiles a session needs depends on the camera, not the style;
+    // preloads warm only the style-level resources.
+    if (ambient) {
+        return;
+    }
+
     for (const auto& tile : definition.tileCover(type, tileSize, tileset.zoomRange)) {
         status.requiredResourceCount++;
         resourcesRemaining.push_back(
@@ -254,6 +324,16 @@ void OfflineDownload::ensureResource(const Resource& resource,
         requests.erase(workRequestsIt);
 
         auto getResourceSizeInDatabase = [&] () -> optional<int64_t> {
+            if (ambient) {
+                optional<Response> ambientResponse = offlineDatabase.get(resource);
+                if (!ambientResponse) {
+                    return {};
+                }
+                if (callback) {
+                    callback(*ambientResponse);
+                }
+                return ambientResponse->data ? static_cast<int64_t>(ambientResponse->data->size()) : 0;
+            }
             if (!callback) {
                 return offlineDatabase.hasRegionResource(id, resource);
             }
@@ -283,8 +363,13 @@ void OfflineDownload::ensureResource(const Resource& resource,
             return;
         }
 
+        // Region downloads happen in the background; let interactive map
+        // requests win transfer priority over them.
+        Resource backgroundResource = resource;
+        backgroundResource.priority = Resource::Low;
+
         auto fileRequestsIt = requests.insert(requests.begin(), nullptr);
-        *fileRequestsIt = onlineFileSource.request(resource, [=](Response onlineResponse) {
+        *fileRequestsIt = onlineFileSource.request(backgroundResource, [=](Response onlineResponse) {
             if (onlineResponse.error) {
                 observer->responseError(*onlineResponse.error);
                 return;
@@ -296,18 +381,13 @@ void OfflineDownload::ensureResource(const Resource& resource,
                 callback(onlineResponse);
             }
 
-            status.completedResourceCount++;
-            uint64_t resourceSize = offlineDatabase.putRegionResource(id, resource, onlineResponse);
-            status.completedResourceSize += resourceSize;
-            if (resource.kind == Resource::Kind::Tile) {
-                status.completedTileCount += 1;
-                status.completedTileSize += resourceSize;
-            }
-
-            observer->statusChanged(status);
+            // Buffer the response instead of writing it immediately;
+            // flushResourcesBuffer() commits a whole batch in one
+            // transaction.
+            resourcesBuffer.emplace_back(resource, std::move(onlineResponse));
 
-            if (checkTileCountLimit(resource)) {
-                return;
+            if (resourcesBuffer.size() >= resourcesBatchSize) {
+                flushResourcesBuffer();
             }
 
             continueDownload();
@@ -2,18 +2,20 @@
 
 #include <mbgl/storage/offline.hpp>
 #include <mbgl/storage/resource.hpp>
+#include <mbgl/storage/response.hpp>
 
 #include <list>
 #include <unordered_set>
 #include <memory>
 #include <deque>
+#include <vector>
+#include <utility>
 
 namespace mbgl {
 
 class OfflineDatabase;
 class FileSource;
 class AsyncRequest;
-class Response;
 class Tileset;
 
 namespace style {
@@ -28,6 +30,16 @@ class Parser;
 class OfflineDownload {
 public:
     OfflineDownload(int64_t id, OfflineRegionDefinition&&, OfflineDatabase& offline, FileSource& online);
+
+    /*
+     * Ambient preload: walks the style's dependency graph like a region
+     * download, but stores the responses in the ambient cache instead of a
+     * region's bookkeeping, and skips tiles (they depend on the camera, not
+     * the style). Used to warm the cache for a style the application knows
+     * it will open.
+     */
+    OfflineDownload(std::string styleURL, float pixelRatio, OfflineDatabase& offline, FileSource& online);
+
     ~OfflineDownload();
 
     void setObserver(std::unique_ptr<OfflineRegionObserver>);
@@ -35,6 +47,16 @@ public:
 
     OfflineRegionStatus getStatus() const;
 
+    /*
+     * Number of overlapping resource fetches. This intentionally exceeds the
+     * HTTP layer's active-request limit: the surplus queues inside
+     * OnlineFileSource, so a finished transfer is replaced immediately
+     * instead of waiting for a round trip through our run loop. Region
+     * transfers are issued at low priority, so interactive map loads still
+     * win the connection.
+     */
+    static constexpr uint32_t maximumOverlappingRequests = 64;
+
 private:
     void activateDownload();
     void continueDownload();
@@ -48,16 +70,35 @@ private:
     void ensureResource(const Resource&, std::function<void (Response)> = {});
     bool checkTileCountLimit(const Resource& resource);
 
+    /*
+     * Write all buffered responses to the database in one transaction and
+     * fold them into `status`, notifying the observer of the new totals.
+     */
+    void flushResourcesBuffer();
+
+    /*
+     * Number of responses buffered before they are committed to the database
+     * in a single transaction. Small enough that progress reports stay
+     * responsive and little is lost if we're killed; large enough that the
+     * per-transaction fsync cost is amortized.
+     */
+    static constexpr uint32_t resourcesBatchSize = 64;
+
     int64_t id;
     OfflineRegionDefinition definition;
     OfflineDatabase& offlineDatabase;
     FileSource& onlineFileSource;
+
+    // True for ambient preloads; resources then bypass the region tables and
+    // land in the ambient cache, and no tiles are queued.
+    const bool ambient = false;
     OfflineRegionStatus status;
     std::unique_ptr<OfflineRegionObserver> observer;
 
     std::list<std::unique_ptr<AsyncRequest>> requests;
     std::unordered_set<std::string> requiredSourceURLs;
     std::deque<Resource> resourcesRemaining;
+    std::vector<std::pair<Resource, Response>> resourcesBuffer;
 
     void queueResource(Resource);
     void queueTiles(SourceType, uint16_t tileSize, const Tileset&);
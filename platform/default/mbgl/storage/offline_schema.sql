@@ -27,6 +27,12 @@ CREATE TABLE tiles (
   UNIQUE (url_template, pixel_ratio, z, x, y)
 );
 
+CREATE TABLE tilesets (                    -- Parsed TileJSON manifests, served optimistically at startup
+  url TEXT NOT NULL PRIMARY KEY,           -- while the raw manifest is revalidated over the network.
+  data BLOB NOT NULL,
+  expires INTEGER
+);
+
 CREATE TABLE regions (
   id INTEGER NOT NULL PRIMARY KEY AUTOINCREMENT,
   definition TEXT NOT NULL,   -- JSON formatted definition of region. Regions may be of variant types:
@@ -1,32 +1,56 @@
 #include <mbgl/util/default_thread_pool.hpp>
-#include <mbgl/actor/mailbox.hpp>
+#include <mbgl/util/performance_counters.hpp>
 #include <mbgl/util/platform.hpp>
 #include <mbgl/util/string.hpp>
 
 namespace mbgl {
 
 ThreadPool::ThreadPool(std::size_t count) {
+    workers.reserve(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        workers.push_back(std::make_unique<Worker>());
+    }
+
     threads.reserve(count);
     for (std::size_t i = 0; i < count; ++i) {
         threads.emplace_back([this, i]() {
             platform::setCurrentThreadName(std::string{ "Worker " } + util::toString(i + 1));
 
+            // Tile parsing dominates these workers and is frequently
+            // frame-blocking; on big.LITTLE parts it should not land on an
+            // efficiency core while performance cores idle.
+            platform::bindThreadToPerformanceCores();
+
             while (true) {
-                std::unique_lock<std::mutex> lock(mutex);
+                std::weak_ptr<Mailbox> mailbox;
 
-                cv.wait(lock, [this] {
-                    return !queue.empty() || terminate;
-                });
+                // Deferred classes only get a thread when no higher-class
+                // work is runnable on any worker.
+                if (takeRegularTask(i, mailbox) ||
+                    takeDeferredTask(prefetchQueue, prefetchMutex, Mailbox::Priority::Prefetch, mailbox) ||
+                    takeDeferredTask(lowPriorityQueue, lowPriorityMutex, Mailbox::Priority::Low, mailbox)) {
+                    Mailbox::maybeReceive(mailbox);
+                    continue;
+                }
 
+                std::unique_lock<std::mutex> lock(sleepMutex);
                 if (terminate) {
                     return;
                 }
+                if (pending.load() > 0) {
+                    // Work arrived between the scan and taking the lock.
+                    continue;
+                }
 
-                auto mailbox = queue.front();
-                queue.pop();
-                lock.unlock();
+                sleepers++;
+                cv.wait(lock, [this] {
+                    return pending.load() > 0 || terminate;
+                });
+                sleepers--;
 
-                Mailbox::maybeReceive(mailbox);
+                if (terminate) {
+                    return;
+                }
             }
         });
     }
@@ -34,7 +58,7 @@ ThreadPool::ThreadPool(std::size_t count) {
 
 ThreadPool::~ThreadPool() {
     {
-        std::lock_guard<std::mutex> lock(mutex);
+        std::lock_guard<std::mutex> lock(sleepMutex);
         terminate = true;
     }
 
@@ -46,12 +70,90 @@ ThreadPool::~ThreadPool() {
 }
 
 void ThreadPool::schedule(std::weak_ptr<Mailbox> mailbox) {
-    {
-        std::lock_guard<std::mutex> lock(mutex);
-        queue.push(mailbox);
+    auto locked = mailbox.lock();
+    const Mailbox::Priority priority =
+        locked ? locked->getPriority() : Mailbox::Priority::Regular;
+
+    if (workers.empty() || priority == Mailbox::Priority::Low) {
+        std::lock_guard<std::mutex> lock(lowPriorityMutex);
+        lowPriorityQueue.push_back(std::move(mailbox));
+    } else if (priority == Mailbox::Priority::Prefetch) {
+        std::lock_guard<std::mutex> lock(prefetchMutex);
+        prefetchQueue.push_back(std::move(mailbox));
+    } else {
+        Worker& worker = *workers[nextWorker++ % workers.size()];
+        std::lock_guard<std::mutex> lock(worker.mutex);
+        if (priority == Mailbox::Priority::RenderCritical) {
+            // Frame-blocking work overtakes whatever regular work is queued.
+            worker.queue.push_front(std::move(mailbox));
+        } else {
+            worker.queue.push_back(std::move(mailbox));
+        }
+    }
+
+    util::setWorkerQueueDepth(++pending);
+
+    // Only take the sleep lock when somebody is actually asleep; on a busy
+    // pool scheduling touches nothing but the target queue's own lock.
+    if (sleepers.load() > 0) {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        cv.notify_one();
+    }
+}
+
+bool ThreadPool::takeRegularTask(std::size_t preferred, std::weak_ptr<Mailbox>& result) {
+    const std::size_t count = workers.size();
+
+    for (std::size_t offset = 0; offset < count; ++offset) {
+        Worker& worker = *workers[(preferred + offset) % count];
+        std::lock_guard<std::mutex> lock(worker.mutex);
+
+        if (worker.queue.empty()) {
+            continue;
+        }
+
+        if (offset == 0) {
+            result = std::move(worker.queue.front());
+            worker.queue.pop_front();
+        } else {
+            // Steal from the opposite end, away from where the victim pops
+            // and where the render-critical entries are.
+            result = std::move(worker.queue.back());
+            worker.queue.pop_back();
+        }
+
+        util::setWorkerQueueDepth(--pending);
+        return true;
+    }
+
+    return false;
+}
+
+bool ThreadPool::takeDeferredTask(std::deque<std::weak_ptr<Mailbox>>& queue,
+                                  std::mutex& mutex,
+                                  Mailbox::Priority queueClass,
+                                  std::weak_ptr<Mailbox>& result) {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    if (queue.empty()) {
+        return false;
+    }
+
+    // Honor priority raises that happened after enqueueing: a mailbox
+    // boosted above this queue's class jumps ahead of the FIFO order.
+    auto it = queue.begin();
+    for (auto candidate = queue.begin(); candidate != queue.end(); ++candidate) {
+        auto locked = candidate->lock();
+        if (locked && locked->getPriority() < queueClass) {
+            it = candidate;
+            break;
+        }
     }
 
-    cv.notify_one();
+    result = std::move(*it);
+    queue.erase(it);
+    util::setWorkerQueueDepth(--pending);
+    return true;
 }
 
 } // namespace mbgl
@@ -1,14 +1,35 @@
 #pragma once
 
+#include <mbgl/actor/mailbox.hpp>
 #include <mbgl/actor/scheduler.hpp>
 
+#include <atomic>
 #include <condition_variable>
+#include <deque>
+#include <memory>
 #include <mutex>
-#include <queue>
 #include <thread>
+#include <vector>
 
 namespace mbgl {
 
+/*
+    A `Scheduler` distributing mailboxes over per-worker deques. Incoming work
+    is spread round-robin across the workers; each worker drains its own deque
+    in FIFO order and steals from the back of a neighbor's when it runs dry,
+    so under a tile burst producers and consumers contend on N queue locks
+    instead of serializing on one.
+
+    Mailbox priority classes are served strictly in order: `RenderCritical`
+    wakeups go to the front of a worker deque and `Regular` ones to the back,
+    while `Prefetch` and `Low` wakeups each wait in a shared deferred queue
+    that is only consulted when no higher-class work is runnable anywhere.
+    Within a class, dispatch is in arrival order, which for tile work is
+    deadline order. A mailbox whose priority is raised while its wakeup is
+    still in a deferred queue jumps ahead of that queue's FIFO order, so e.g.
+    a prefetched tile that scrolls into view is parsed next rather than
+    behind the rest of the prefetch backlog.
+*/
 class ThreadPool : public Scheduler {
 public:
     ThreadPool(std::size_t count);
@@ -17,9 +38,34 @@ public:
     void schedule(std::weak_ptr<Mailbox>) override;
 
 private:
+    // A worker's deque is guarded by its own mutex rather than being
+    // lock-free: mailboxes are scheduled from arbitrary threads, not only
+    // from the owning worker, so there is no single-producer end to exploit.
+    struct Worker {
+        std::deque<std::weak_ptr<Mailbox>> queue;
+        std::mutex mutex;
+    };
+
+    bool takeRegularTask(std::size_t preferred, std::weak_ptr<Mailbox>&);
+    bool takeDeferredTask(std::deque<std::weak_ptr<Mailbox>>&, std::mutex&,
+                          Mailbox::Priority queueClass, std::weak_ptr<Mailbox>&);
+
+    std::vector<std::unique_ptr<Worker>> workers;
     std::vector<std::thread> threads;
-    std::queue<std::weak_ptr<Mailbox>> queue;
-    std::mutex mutex;
+
+    std::deque<std::weak_ptr<Mailbox>> prefetchQueue;
+    std::mutex prefetchMutex;
+
+    std::deque<std::weak_ptr<Mailbox>> lowPriorityQueue;
+    std::mutex lowPriorityMutex;
+
+    std::atomic<std::size_t> nextWorker { 0 };
+
+    // Number of scheduled-but-unclaimed mailboxes; used only to decide
+    // whether an idle worker may go to sleep.
+    std::atomic<int> pending { 0 };
+    std::atomic<int> sleepers { 0 };
+    std::mutex sleepMutex;
     std::condition_variable cv;
     bool terminate { false };
 };
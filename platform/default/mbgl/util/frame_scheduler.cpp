@@ -0,0 +1,72 @@
+#include <mbgl/util/frame_scheduler.hpp>
+
+#include <algorithm>
+
+namespace mbgl {
+namespace util {
+
+FrameScheduler::FrameScheduler(Duration refreshInterval_)
+    : refreshInterval(refreshInterval_),
+      margin(refreshInterval_ / 8),
+      // Until measured, assume a frame needs half the interval; the estimate
+      // converges within a few frames and this errs on starting early.
+      estimatedFrameTime(refreshInterval_ / 2),
+      minimumSlack(Duration::max()) {
+}
+
+Duration FrameScheduler::timeUntilFrameStart(TimePoint now) const {
+    if (nextDeadline == TimePoint()) {
+        return Duration::zero();
+    }
+    const TimePoint latestStart = nextDeadline - estimatedFrameTime - margin;
+    return std::max(latestStart - now, Duration::zero());
+}
+
+void FrameScheduler::frameStarted(TimePoint now) {
+    frameStart = now;
+}
+
+void FrameScheduler::frameRendered(TimePoint now) {
+    // Exponentially-weighted so a single slow frame (style change, tile
+    // burst) doesn't permanently drag the start time earlier.
+    const Duration frameTime = now - frameStart;
+    estimatedFrameTime += (frameTime - estimatedFrameTime) / 8;
+
+    if (nextDeadline != TimePoint()) {
+        const Duration slack = nextDeadline - now;
+        minimumSlack = std::min(minimumSlack, slack);
+        totalSlack += slack;
+        frames++;
+        if (slack < Duration::zero()) {
+            missedDeadlines++;
+        }
+    }
+}
+
+void FrameScheduler::framePresented(TimePoint now) {
+    // On a vsync-throttled swap the presentation time is refresh-aligned;
+    // re-anchoring here keeps the predicted deadline phase-locked to the
+    // display without a platform vsync API.
+    nextDeadline = now + refreshInterval;
+}
+
+FrameScheduler::Statistics FrameScheduler::getStatistics() const {
+    Statistics stats;
+    stats.refreshInterval = refreshInterval;
+    stats.estimatedFrameTime = estimatedFrameTime;
+    stats.minimumSlack = frames > 0 ? minimumSlack : Duration::zero();
+    stats.averageSlack = frames > 0 ? totalSlack / static_cast<int64_t>(frames) : Duration::zero();
+    stats.frames = frames;
+    stats.missedDeadlines = missedDeadlines;
+    return stats;
+}
+
+void FrameScheduler::resetStatistics() {
+    minimumSlack = Duration::max();
+    totalSlack = Duration::zero();
+    frames = 0;
+    missedDeadlines = 0;
+}
+
+} // namespace util
+} // namespace mbgl
@@ -0,0 +1,83 @@
+#pragma once
+
+#include <mbgl/util/chrono.hpp>
+#include <mbgl/util/noncopyable.hpp>
+
+#include <cstdint>
+
+namespace mbgl {
+namespace util {
+
+// Paces a host render loop against the display refresh. A loop that renders
+// the moment it is invalidated samples input as early as possible and then
+// sits blocked on vsync, which maximizes input-to-photon latency; this
+// scheduler instead computes how long the loop can afford to wait before
+// starting a frame so it still completes just ahead of the upcoming refresh
+// deadline. The achieved slack per frame is recorded, so hosts that must
+// prove bounded latency can read it off instead of instrumenting the loop
+// themselves.
+//
+// The scheduler has no display dependency: the host tells it the refresh
+// interval and feeds it three timestamps per frame (started, rendered,
+// presented). On a vsync-throttled swap chain the "presented" timestamp is
+// when the swap returned, which is aligned with the refresh and anchors the
+// deadline prediction for the next frame.
+class FrameScheduler : private util::noncopyable {
+public:
+    explicit FrameScheduler(Duration refreshInterval);
+
+    // How long the loop should wait before starting the next frame. Zero
+    // until enough frames have been observed to anchor the refresh phase,
+    // and always zero-clamped: a late caller should start immediately.
+    Duration timeUntilFrameStart(TimePoint now) const;
+
+    // Immediately before the frame's input sampling and render work.
+    void frameStarted(TimePoint now);
+
+    // After the frame's CPU work is done, before handing it to the display.
+    void frameRendered(TimePoint now);
+
+    // After the frame was handed to the display (the swap returned).
+    void framePresented(TimePoint now);
+
+    struct Statistics {
+        Duration refreshInterval = Duration::zero();
+
+        // Current estimate of the time a frame needs from start to rendered.
+        Duration estimatedFrameTime = Duration::zero();
+
+        // Time spent between finishing a frame and its refresh deadline,
+        // since the last reset. The minimum is the proven latency bound:
+        // a negative minimum means a deadline was missed.
+        Duration minimumSlack = Duration::zero();
+        Duration averageSlack = Duration::zero();
+
+        uint64_t frames = 0;
+        uint64_t missedDeadlines = 0;
+    };
+
+    Statistics getStatistics() const;
+    void resetStatistics();
+
+private:
+    const Duration refreshInterval;
+
+    // Subtracted from the deadline on top of the frame-time estimate to
+    // absorb estimate error and wakeup jitter.
+    const Duration margin;
+
+    // Predicted time of the upcoming refresh; epoch until the first frame
+    // has been presented.
+    TimePoint nextDeadline;
+
+    TimePoint frameStart;
+    Duration estimatedFrameTime;
+
+    Duration minimumSlack;
+    Duration totalSlack = Duration::zero();
+    uint64_t frames = 0;
+    uint64_t missedDeadlines = 0;
+};
+
+} // namespace util
+} // namespace mbgl
@@ -0,0 +1,15 @@
+#include "shared_file_source.hpp"
+
+namespace mbgl {
+
+std::shared_ptr<DefaultFileSource> sharedFileSource(const std::string& cachePath,
+                                                    const std::string& assetRoot) {
+    static std::weak_ptr<DefaultFileSource> weak;
+    auto fileSource = weak.lock();
+    if (!fileSource) {
+        weak = fileSource = std::make_shared<DefaultFileSource>(cachePath, assetRoot);
+    }
+    return fileSource;
+}
+
+} // namespace mbgl
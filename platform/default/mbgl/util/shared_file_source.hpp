@@ -0,0 +1,24 @@
+#pragma once
+
+#include <mbgl/storage/default_file_source.hpp>
+
+#include <memory>
+#include <string>
+
+namespace mbgl {
+
+/*
+ * A process-wide DefaultFileSource, for applications running several maps at
+ * once. Maps constructed over the same file source share one offline
+ * database, one in-memory response cache and one connection pool, so three
+ * views of the same style download and store everything once.
+ *
+ * Like sharedThreadPool(), the instance lives as long as someone holds the
+ * returned shared_ptr and is recreated on the next call after that. The
+ * paths of the call that creates the instance win; callers must agree on
+ * them for the lifetime of the process.
+ */
+std::shared_ptr<DefaultFileSource> sharedFileSource(const std::string& cachePath,
+                                                    const std::string& assetRoot);
+
+} // namespace mbgl
@@ -1,5 +1,6 @@
 #include <mbgl/storage/online_file_source.hpp>
 #include <mbgl/storage/http_file_source.hpp>
+#include <mbgl/storage/network_quality.hpp>
 #include <mbgl/storage/network_status.hpp>
 
 #include <mbgl/storage/response.hpp>
@@ -14,10 +15,12 @@
 #include <mbgl/util/noncopyable.hpp>
 #include <mbgl/util/timer.hpp>
 #include <mbgl/util/http_timeout.hpp>
+#include <mbgl/util/string.hpp>
 
 #include <algorithm>
 #include <cassert>
 #include <list>
+#include <map>
 #include <unordered_set>
 #include <unordered_map>
 
@@ -38,6 +41,11 @@ public:
     OnlineFileSource::Impl& impl;
     Resource resource;
     std::unique_ptr<AsyncRequest> request;
+
+    // Set while this request is waiting on a transfer shared through the
+    // dedupe map in OnlineFileSource::Impl.
+    optional<std::string> transferKey;
+
     util::Timer timer;
     Callback callback;
 
@@ -53,6 +61,23 @@ public:
     optional<Timestamp> retryAfter;
 };
 
+namespace {
+
+// A transfer is shared only between requests that would put identical
+// revalidation headers on the wire; otherwise a 304 produced by one
+// requester's etag could reach another whose cached copy doesn't match it.
+std::string makeTransferKey(const Resource& resource) {
+    std::string key = resource.url;
+    if (resource.priorEtag) {
+        key += "#etag=" + *resource.priorEtag;
+    } else if (resource.priorModified) {
+        key += "#modified=" + util::toString(resource.priorModified->time_since_epoch().count());
+    }
+    return key;
+}
+
+} // namespace
+
 class OnlineFileSource::Impl {
 public:
     Impl() {
@@ -83,12 +108,24 @@ public:
     void remove(OnlineFileRequest* request) {
         allRequests.erase(request);
         if (activeRequests.erase(request)) {
-            activatePendingRequest();
+            // If other requests observe the same transfer, hand the active
+            // slot to one of them and let the transfer continue; otherwise
+            // the slot frees up for a pending request.
+            optional<std::string> key = request->transferKey;
+            detachFromTransfer(request);
+            auto it = key ? inFlightTransfers.find(*key) : inFlightTransfers.end();
+            if (it != inFlightTransfers.end() && !it->second.observers.empty()) {
+                activeRequests.insert(it->second.observers.front());
+            } else {
+                activatePendingRequest();
+            }
         } else {
             auto it = pendingRequestsMap.find(request);
             if (it != pendingRequestsMap.end()) {
                 pendingRequestsList.erase(it->second);
                 pendingRequestsMap.erase(it);
+            } else {
+                detachFromTransfer(request);
             }
         }
         assert(pendingRequestsMap.size() == pendingRequestsList.size());
@@ -99,8 +136,14 @@ public:
         assert(activeRequests.find(request) == activeRequests.end());
         assert(!request->request);
 
-        if (activeRequests.size() >= HTTPFileSource::maximumConcurrentRequests()) {
+        if (attachToInFlightTransfer(request)) {
+            return;
+        }
+
+        if (activeRequests.size() >= HTTPFileSource::maximumConcurrentRequests() ||
+            !mayActivate(request->resource)) {
             queueRequest(request);
+            scheduleRateWakeup();
         } else {
             activateRequest(request);
         }
@@ -113,28 +156,36 @@ public:
     }
 
     void activateRequest(OnlineFileRequest* request) {
+        if (attachToInFlightTransfer(request)) {
+            return;
+        }
+
         activeRequests.insert(request);
-        request->request = httpFileSource.request(request->resource, [=] (Response response) {
-            activeRequests.erase(request);
-            activatePendingRequest();
-            request->request.reset();
-            request->completed(response);
+
+        const std::string key = makeTransferKey(request->resource);
+        Transfer& transfer = inFlightTransfers[key];
+        transfer.observers.push_back(request);
+        transfer.kind = request->resource.kind;
+        request->transferKey = key;
+        transfer.request = httpFileSource.request(request->resource, [this, key] (Response response) {
+            completeTransfer(key, std::move(response));
         });
         assert(pendingRequestsMap.size() == pendingRequestsList.size());
     }
 
     void activatePendingRequest() {
-        if (pendingRequestsList.empty()) {
-            return;
-        }
-
-        OnlineFileRequest* request = pendingRequestsList.front();
-        pendingRequestsList.pop_front();
-
-        pendingRequestsMap.erase(request);
+        // Activating a request may merely attach it to an in-flight transfer,
+        // which doesn't occupy the freed slot; keep going until it's taken.
+        while (activeRequests.size() < HTTPFileSource::maximumConcurrentRequests()) {
+            OnlineFileRequest* request = takeAdmissiblePendingRequest();
+            if (!request) {
+                break;
+            }
 
-        activateRequest(request);
-        assert(pendingRequestsMap.size() == pendingRequestsList.size());
+            activateRequest(request);
+            assert(pendingRequestsMap.size() == pendingRequestsList.size());
+        }
+        scheduleRateWakeup();
     }
 
     bool isPending(OnlineFileRequest* request) {
@@ -149,8 +200,220 @@ public:
         resourceTransform = std::move(transform);
     }
 
+    void setRevalidationWindow(Duration window) {
+        revalidationWindow = window;
+    }
+
+    Duration getRevalidationWindow() const {
+        return revalidationWindow;
+    }
+
+    void setTransferRateLimit(Resource::Kind kind, uint64_t bytesPerSecond) {
+        if (bytesPerSecond == 0) {
+            rateClasses.erase(kind);
+        } else {
+            auto it = rateClasses.find(kind);
+            if (it == rateClasses.end()) {
+                // A fresh bucket starts full, so a newly set cap shapes
+                // sustained traffic without delaying the next fetch.
+                rateClasses.emplace(kind,
+                                    RateClass{ bytesPerSecond, double(bytesPerSecond), Clock::now() });
+            } else {
+                it->second.bytesPerSecond = bytesPerSecond;
+                it->second.balance = std::min(it->second.balance, double(bytesPerSecond));
+            }
+        }
+        activatePendingRequest();
+    }
+
 private:
+    // An open network transfer and the requests observing it. The observer
+    // that opened the transfer holds a slot in `activeRequests`; later
+    // requesters of the same resource ride along instead of hitting the wire.
+    struct Transfer {
+        std::unique_ptr<AsyncRequest> request;
+        std::list<OnlineFileRequest*> observers;
+        Resource::Kind kind = Resource::Kind::Unknown;
+        TimePoint start = Clock::now();
+    };
+
+    // Token bucket shaping one class of resources. Response sizes aren't
+    // known up front, so a transfer is admitted while the bucket is positive
+    // and debits the bytes it actually moved on completion; the balance may
+    // go negative and subsequent admissions wait for the refill to catch up.
+    struct RateClass {
+        uint64_t bytesPerSecond;
+        double balance;
+        TimePoint lastRefill;
+    };
+
+    static void refill(RateClass& rateClass, TimePoint now) {
+        const double elapsed = std::chrono::duration<double>(now - rateClass.lastRefill).count();
+        rateClass.balance = std::min(rateClass.balance + elapsed * rateClass.bytesPerSecond,
+                                     double(rateClass.bytesPerSecond));
+        rateClass.lastRefill = now;
+    }
+
+    // Low-priority (prefetch) traffic is admitted only while the bucket
+    // holds at least half a burst, so background work never drains it under
+    // the interactive fetches of the same kind.
+    static double admissionThreshold(const RateClass& rateClass, Resource::Priority priority) {
+        return priority == Resource::Priority::Low ? rateClass.bytesPerSecond / 2.0 : 0.0;
+    }
+
+    bool mayActivate(const Resource& resource) {
+        auto it = rateClasses.find(resource.kind);
+        if (it == rateClasses.end()) {
+            return true;
+        }
+        refill(it->second, Clock::now());
+        return it->second.balance > admissionThreshold(it->second, resource.priority);
+    }
+
+    void chargeTransfer(Resource::Kind kind, const Response& response) {
+        auto it = rateClasses.find(kind);
+        if (it == rateClasses.end()) {
+            return;
+        }
+        RateClass& rateClass = it->second;
+        refill(rateClass, Clock::now());
+        const double bytes = response.data ? double(response.data->size()) : 0.0;
+        // Clamp the deficit to one burst so a single oversized response
+        // delays followers by at most one refill period instead of stalling
+        // the whole class.
+        rateClass.balance =
+            std::max(rateClass.balance - bytes, -double(rateClass.bytesPerSecond));
+    }
+
+    OnlineFileRequest* takeAdmissiblePendingRequest() {
+        // Regular-priority requests drain first, so a shaped class spends its
+        // budget on interactive fetches before queued prefetch traffic; FIFO
+        // order is preserved within a priority.
+        for (const auto priority : { Resource::Priority::Regular, Resource::Priority::Low }) {
+            for (auto it = pendingRequestsList.begin(); it != pendingRequestsList.end(); ++it) {
+                OnlineFileRequest* request = *it;
+                if (request->resource.priority != priority || !mayActivate(request->resource)) {
+                    continue;
+                }
+                pendingRequestsList.erase(it);
+                pendingRequestsMap.erase(request);
+                return request;
+            }
+        }
+        return nullptr;
+    }
+
+    void scheduleRateWakeup() {
+        if (pendingRequestsList.empty() ||
+            activeRequests.size() >= HTTPFileSource::maximumConcurrentRequests()) {
+            rateWakeupTimer.stop();
+            return;
+        }
+
+        // The queue is non-empty with slots to spare, so every pending
+        // request is waiting on tokens; wake up when the first bucket
+        // refills past its admission threshold.
+        optional<Duration> wait;
+        const TimePoint now = Clock::now();
+        for (OnlineFileRequest* request : pendingRequestsList) {
+            auto it = rateClasses.find(request->resource.kind);
+            if (it == rateClasses.end()) {
+                continue;
+            }
+            RateClass& rateClass = it->second;
+            refill(rateClass, now);
+            const double deficit =
+                admissionThreshold(rateClass, request->resource.priority) - rateClass.balance;
+            const auto needed = std::chrono::duration_cast<Duration>(std::chrono::duration<double>(
+                std::max(deficit, 0.0) / rateClass.bytesPerSecond));
+            if (!wait || needed < *wait) {
+                wait = needed;
+            }
+        }
+
+        if (wait) {
+            rateWakeupTimer.start(std::max<Duration>(*wait, Milliseconds(1)), Duration::zero(),
+                                  [this] { activatePendingRequest(); });
+        }
+    }
+
+    bool attachToInFlightTransfer(OnlineFileRequest* request) {
+        if (request->transferKey) {
+            // Already observing a transfer.
+            return true;
+        }
+
+        auto it = inFlightTransfers.find(makeTransferKey(request->resource));
+        if (it == inFlightTransfers.end()) {
+            return false;
+        }
+
+        it->second.observers.push_back(request);
+        request->transferKey = it->first;
+        return true;
+    }
+
+    void detachFromTransfer(OnlineFileRequest* request) {
+        if (!request->transferKey) {
+            return;
+        }
+
+        auto it = inFlightTransfers.find(*request->transferKey);
+        request->transferKey = {};
+        if (it == inFlightTransfers.end()) {
+            return;
+        }
+
+        it->second.observers.remove(request);
+        if (it->second.observers.empty()) {
+            // The last requester went away; cancel the underlying transfer.
+            inFlightTransfers.erase(it);
+        }
+    }
+
+    void completeTransfer(const std::string& key, Response response) {
+        auto it = inFlightTransfers.find(key);
+        assert(it != inFlightTransfers.end());
+
+        chargeTransfer(it->second.kind, response);
+
+        // Feed the passive network quality estimate. Errors say nothing
+        // about speed; everything else does, including 304s, whose duration
+        // is a clean round-trip sample.
+        if (!response.error) {
+            NetworkQuality::RecordTransfer(response.data ? response.data->size() : 0,
+                                           Clock::now() - it->second.start);
+        }
+
+        // Move the observer list out so that a callback re-requesting the same
+        // resource starts a fresh transfer rather than joining this finished one.
+        std::list<OnlineFileRequest*> observers = std::move(it->second.observers);
+        std::unique_ptr<AsyncRequest> transferRequest = std::move(it->second.request);
+        inFlightTransfers.erase(it);
+
+        for (OnlineFileRequest* observer : observers) {
+            observer->transferKey = {};
+            activeRequests.erase(observer);
+        }
+        activatePendingRequest();
+
+        // Completing a request may delete it — or any other observer — so check
+        // that each one is still registered before delivering the response.
+        while (!observers.empty()) {
+            OnlineFileRequest* observer = observers.front();
+            observers.pop_front();
+            if (allRequests.find(observer) != allRequests.end()) {
+                observer->completed(response);
+            }
+        }
+    }
+
+    std::unordered_map<std::string, Transfer> inFlightTransfers;
+
     void networkIsReachableAgain() {
+        // Whatever network we were measuring is not the one we're on now.
+        NetworkQuality::Reset();
+
         for (auto& request : allRequests) {
             request->networkIsReachableAgain();
         }
@@ -158,6 +421,10 @@ private:
 
     ResourceTransform resourceTransform;
 
+    // Stale-while-revalidate window applied to conditional revalidations;
+    // zero keeps them firing the moment a resource goes stale.
+    Duration revalidationWindow = Duration::zero();
+
     /**
      * The lifetime of a request is:
      *
@@ -174,6 +441,11 @@ private:
     std::unordered_map<OnlineFileRequest*, std::list<OnlineFileRequest*>::iterator> pendingRequestsMap;
     std::unordered_set<OnlineFileRequest*> activeRequests;
 
+    // Transfer rate budgets for shaped resource kinds; kinds without an
+    // entry are uncapped.
+    std::map<Resource::Kind, RateClass> rateClasses;
+    util::Timer rateWakeupTimer;
+
     HTTPFileSource httpFileSource;
     util::AsyncTask reachability { std::bind(&Impl::networkIsReachableAgain, this) };
 };
@@ -220,6 +492,14 @@ void OnlineFileSource::setResourceTransform(ResourceTransform&& transform) {
     impl->setResourceTransform(std::move(transform));
 }
 
+void OnlineFileSource::setRevalidationWindow(Duration window) {
+    impl->setRevalidationWindow(window);
+}
+
+void OnlineFileSource::setTransferRateLimit(Resource::Kind kind, uint64_t bytesPerSecond) {
+    impl->setTransferRateLimit(kind, bytesPerSecond);
+}
+
 OnlineFileRequest::OnlineFileRequest(Resource resource_, Callback callback_, OnlineFileSource::Impl& impl_)
     : impl(impl_),
       resource(std::move(resource_)),
@@ -291,6 +571,15 @@ void OnlineFileRequest::schedule(optional<Timestamp> expires) {
         return;
     }
 
+    // Conditional revalidations of resources that were fetched in one burst
+    // would otherwise all fire the moment their shared max-age passes; spread
+    // them out, and honor the configured stale-while-revalidate window. An
+    // unconditional fetch is left untouched — its timing is observable (the
+    // response has no validators to suppress a full transfer).
+    if (resource.priorEtag || resource.priorModified) {
+        timeout = http::revalidationTimeout(timeout, impl.getRevalidationWindow());
+    }
+
     // Emulate a Connection error when the Offline mode is forced with
     // a really long timeout. The request will get re-triggered when
     // the NetworkStatus is set back to Online.
@@ -141,6 +141,11 @@ Statement Database::prepare(const char *query) {
     return Statement(this, query);
 }
 
+uint64_t memoryUsed() {
+    const int64_t used = sqlite3_memory_used();
+    return (used < 0 ? 0 : used);
+}
+
 Statement::Statement(Database *db, const char *sql)
     : impl(std::make_unique<StatementImpl>(db->impl->db, sql))
 {
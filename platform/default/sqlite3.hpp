@@ -35,6 +35,10 @@ class DatabaseImpl;
 class Statement;
 class StatementImpl;
 
+// Bytes of heap memory currently held by SQLite across all connections in
+// this process.
+uint64_t memoryUsed();
+
 class Database {
 private:
     Database(const Database &) = delete;
@@ -1,10 +1,15 @@
 #include <mbgl/util/platform.hpp>
 #include <mbgl/util/logging.hpp>
 
+#include <algorithm>
+#include <fstream>
+#include <limits>
 #include <string>
+#include <vector>
 
 #include <pthread.h>
 #include <sched.h>
+#include <unistd.h>
 
 namespace mbgl {
 namespace platform {
@@ -33,5 +38,68 @@ void makeThreadLowPriority() {
     }
 }
 
+namespace {
+
+// Classifies cores by their maximum frequency: on big.LITTLE parts the
+// performance cluster reports a strictly higher cpuinfo_max_freq. Returns
+// false when the machine is homogeneous (or sysfs is unreadable), in which
+// case pinning would only hurt.
+bool cpuSetForCores(bool performance, cpu_set_t& set) {
+    const long count = sysconf(_SC_NPROCESSORS_CONF);
+    if (count <= 1 || count > CPU_SETSIZE) {
+        return false;
+    }
+
+    std::vector<uint64_t> frequencies(count, 0);
+    uint64_t maximum = 0;
+    uint64_t minimum = std::numeric_limits<uint64_t>::max();
+    for (long cpu = 0; cpu < count; ++cpu) {
+        std::ifstream file("/sys/devices/system/cpu/cpu" + std::to_string(cpu) +
+                           "/cpufreq/cpuinfo_max_freq");
+        if (!(file >> frequencies[cpu])) {
+            return false;
+        }
+        maximum = std::max(maximum, frequencies[cpu]);
+        minimum = std::min(minimum, frequencies[cpu]);
+    }
+
+    if (minimum == maximum) {
+        return false;
+    }
+
+    CPU_ZERO(&set);
+    for (long cpu = 0; cpu < count; ++cpu) {
+        if ((frequencies[cpu] == maximum) == performance) {
+            CPU_SET(cpu, &set);
+        }
+    }
+    return true;
+}
+
+void bindThreadToCores(bool performance) {
+    static cpu_set_t performanceSet, efficiencySet;
+    static const bool heterogeneous =
+        cpuSetForCores(true, performanceSet) && cpuSetForCores(false, efficiencySet);
+
+    if (!heterogeneous) {
+        return;
+    }
+
+    const cpu_set_t& set = performance ? performanceSet : efficiencySet;
+    if (sched_setaffinity(0, sizeof(cpu_set_t), &set) != 0) {
+        Log::Warning(Event::General, "Couldn't set thread affinity");
+    }
+}
+
+} // namespace
+
+void bindThreadToPerformanceCores() {
+    bindThreadToCores(true);
+}
+
+void bindThreadToEfficiencyCores() {
+    bindThreadToCores(false);
+}
+
 } // namespace platform
 } // namespace mbgl
@@ -4,44 +4,154 @@
 
 #include <uv.h>
 
+#include <map>
+#include <memory>
+#include <vector>
+
 namespace mbgl {
 namespace util {
 
-class Timer::Impl {
+namespace {
+
+// Pending deadlines are rounded up to this boundary, so timers going off
+// around the same time share a single loop iteration instead of each
+// producing their own wakeup. Kept well below the 20% tolerance our timing
+// expectations allow on the shortest timers in use.
+constexpr uint64_t coalescingGranularityMilliseconds = 5;
+
+uint64_t roundUpToGranularity(uint64_t time) {
+    time += coalescingGranularityMilliseconds - 1;
+    return time - (time % coalescingGranularityMilliseconds);
+}
+
+} // namespace
+
+class TimerHub;
+
+// The per-timer state the hub tracks; kept apart from Timer::Impl so the hub
+// does not need access to Timer's private nested class.
+struct TimerEntry {
+    std::function<void()> cb;
+    uint64_t repeat = 0;
+
+    bool active = false;
+    std::multimap<uint64_t, TimerEntry*>::iterator position;
+};
+
+/*
+    Multiplexes all `Timer`s of a thread onto a single uv_timer. Earlier, every
+    `Timer` owned its own uv_timer, and with a timeout per HTTP request plus a
+    debounce timer per tile worker that added up to hundreds of kernel timers
+    producing spurious wakeups. The hub keeps pending deadlines sorted, arms
+    the one uv_timer for the earliest of them rounded up to the coalescing
+    granularity, and delivers everything that became due in one batch.
+
+    The hub is created on demand and shared by the `Timer`s of the thread;
+    when the last one goes away it closes its handle, before the `RunLoop`
+    (which all timers of a thread live under) is torn down.
+*/
+class TimerHub : public std::enable_shared_from_this<TimerHub> {
 public:
-    Impl() : timer(new uv_timer_t) {
+    static std::shared_ptr<TimerHub> get() {
+        static thread_local std::weak_ptr<TimerHub> cached;
+        auto hub = cached.lock();
+        if (!hub) {
+            hub = std::make_shared<TimerHub>();
+            cached = hub;
+        }
+        return hub;
+    }
+
+    TimerHub() : timer(new uv_timer_t) {
         uv_loop_t* loop = reinterpret_cast<uv_loop_t*>(RunLoop::getLoopHandle());
         if (uv_timer_init(loop, timer) != 0) {
             throw std::runtime_error("Failed to initialize timer.");
         }
 
-        handle()->data = this;
+        timer->data = this;
         uv_unref(handle());
     }
 
-    ~Impl() {
+    ~TimerHub() {
+        uv_timer_stop(timer);
         uv_close(handle(), [](uv_handle_t* h) {
             delete reinterpret_cast<uv_timer_t*>(h);
         });
     }
 
-    void start(uint64_t timeout, uint64_t repeat, std::function<void ()>&& cb_) {
-        cb = std::move(cb_);
-        if (uv_timer_start(timer, timerCallback, timeout, repeat) != 0) {
-            throw std::runtime_error("Failed to start timer.");
-        }
+    void add(TimerEntry* entry, uint64_t timeout) {
+        entry->position = deadlines.emplace(uv_now(timer->loop) + timeout, entry);
+        entry->active = true;
+        reschedule();
     }
 
-    void stop() {
-        cb = nullptr;
-        if (uv_timer_stop(timer) != 0) {
-            throw std::runtime_error("Failed to stop timer.");
+    void remove(TimerEntry* entry) {
+        if (entry->active) {
+            deadlines.erase(entry->position);
+            entry->active = false;
+            reschedule();
+        }
+
+        // Drop it from an in-progress batch, in case a timer callback stops
+        // or destroys another timer that was due in the same batch.
+        for (auto& pending : firing) {
+            if (pending == entry) {
+                pending = nullptr;
+            }
         }
     }
 
 private:
-    static void timerCallback(uv_timer_t* handle) {
-        reinterpret_cast<Impl*>(handle->data)->cb();
+    void reschedule() {
+        if (deadlines.empty()) {
+            uv_timer_stop(timer);
+            return;
+        }
+
+        const uint64_t now = uv_now(timer->loop);
+        const uint64_t next = roundUpToGranularity(deadlines.begin()->first);
+        if (uv_timer_start(timer, fire, next > now ? next - now : 0, 0) != 0) {
+            throw std::runtime_error("Failed to start timer.");
+        }
+    }
+
+    static void fire(uv_timer_t* t) {
+        auto hub = reinterpret_cast<TimerHub*>(t->data);
+        // A callback may destroy the last Timer of the thread and with it the
+        // hub's last owner; keep the hub alive until the batch is done.
+        auto self = hub->shared_from_this();
+        hub->fired();
+    }
+
+    void fired() {
+        const uint64_t now = uv_now(timer->loop);
+
+        // Collect the batch before invoking anything: callbacks may start,
+        // stop, or destroy timers, all of which mutate the deadline map.
+        for (auto it = deadlines.begin(); it != deadlines.end() && it->first <= now;) {
+            TimerEntry* entry = it->second;
+            it = deadlines.erase(it);
+            entry->active = false;
+            if (entry->repeat > 0) {
+                entry->position = deadlines.emplace(now + entry->repeat, entry);
+                entry->active = true;
+            }
+            firing.push_back(entry);
+        }
+
+        for (auto& pending : firing) {
+            if (pending) {
+                // Invoke through a copy: the callback may restart its own
+                // timer, replacing the stored function mid-call.
+                std::function<void()> cb = pending->cb;
+                if (cb) {
+                    cb();
+                }
+            }
+        }
+        firing.clear();
+
+        reschedule();
     }
 
     uv_handle_t* handle() {
@@ -50,7 +160,35 @@ private:
 
     uv_timer_t* timer;
 
-    std::function<void()> cb;
+    std::multimap<uint64_t, TimerEntry*> deadlines;
+    std::vector<TimerEntry*> firing;
+};
+
+class Timer::Impl {
+public:
+    Impl() : hub(TimerHub::get()) {
+    }
+
+    ~Impl() {
+        stop();
+    }
+
+    void start(uint64_t timeout, uint64_t repeat, std::function<void()>&& cb) {
+        stop();
+        entry.cb = std::move(cb);
+        entry.repeat = repeat;
+        hub->add(&entry, timeout);
+    }
+
+    void stop() {
+        entry.cb = nullptr;
+        entry.repeat = 0;
+        hub->remove(&entry);
+    }
+
+private:
+    std::shared_ptr<TimerHub> hub;
+    TimerEntry entry;
 };
 
 Timer::Timer()
@@ -1,15 +1,111 @@
 #include <mbgl/util/utf.hpp>
 
-#include <memory>
-#include <locale>
-#include <codecvt>
+#include <cstdint>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__aarch64__)
+#include <arm_neon.h>
+#endif
 
 namespace mbgl {
 namespace util {
 
+// Hand-rolled decoder instead of std::wstring_convert, which dispatches
+// through the codecvt facet one character at a time. ASCII runs are widened
+// sixteen bytes per step where SIMD is available; multi-byte sequences —
+// the common case for CJK labels — take a branch-light scalar path.
+// Malformed input decodes to U+FFFD rather than throwing, so a corrupt
+// label cannot abort tile layout.
 std::u16string utf8_to_utf16::convert(std::string const& utf8) {
-    std::wstring_convert<std::codecvt_utf8_utf16<char16_t>, char16_t> converter;
-    return converter.from_bytes(utf8);
+    std::u16string result;
+    result.reserve(utf8.size());
+
+    const auto* pos = reinterpret_cast<const uint8_t*>(utf8.data());
+    const uint8_t* end = pos + utf8.size();
+
+    while (pos != end) {
+#if defined(__SSE2__)
+        while (end - pos >= 16) {
+            const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pos));
+            if (_mm_movemask_epi8(chunk) != 0) {
+                break;
+            }
+            const __m128i zero = _mm_setzero_si128();
+            alignas(16) uint16_t wide[16];
+            _mm_store_si128(reinterpret_cast<__m128i*>(wide), _mm_unpacklo_epi8(chunk, zero));
+            _mm_store_si128(reinterpret_cast<__m128i*>(wide + 8), _mm_unpackhi_epi8(chunk, zero));
+            result.append(reinterpret_cast<const char16_t*>(wide), 16);
+            pos += 16;
+        }
+#elif defined(__aarch64__)
+        while (end - pos >= 16) {
+            const uint8x16_t chunk = vld1q_u8(pos);
+            if (vmaxvq_u8(chunk) >= 0x80) {
+                break;
+            }
+            uint16_t wide[16];
+            vst1q_u16(wide, vmovl_u8(vget_low_u8(chunk)));
+            vst1q_u16(wide + 8, vmovl_u8(vget_high_u8(chunk)));
+            result.append(reinterpret_cast<const char16_t*>(wide), 16);
+            pos += 16;
+        }
+#endif
+        if (pos == end) {
+            break;
+        }
+
+        const uint8_t lead = *pos++;
+        if (lead < 0x80) {
+            result += static_cast<char16_t>(lead);
+            continue;
+        }
+
+        // Decode the continuation bytes of a multi-byte sequence. Overlong
+        // encodings, truncated sequences, stray continuation bytes, and
+        // codepoints beyond U+10FFFF all land on the replacement character.
+        uint32_t codepoint;
+        int continuations;
+        if ((lead & 0xE0) == 0xC0) {
+            codepoint = lead & 0x1F;
+            continuations = 1;
+        } else if ((lead & 0xF0) == 0xE0) {
+            codepoint = lead & 0x0F;
+            continuations = 2;
+        } else if ((lead & 0xF8) == 0xF0) {
+            codepoint = lead & 0x07;
+            continuations = 3;
+        } else {
+            result += u'�';
+            continue;
+        }
+
+        bool valid = true;
+        for (int i = 0; valid && i < continuations; i++) {
+            if (pos == end || (*pos & 0xC0) != 0x80) {
+                valid = false;
+            } else {
+                codepoint = (codepoint << 6) | (*pos++ & 0x3F);
+            }
+        }
+
+        static const uint32_t minima[] = { 0x80, 0x800, 0x10000 };
+        if (!valid || codepoint < minima[continuations - 1] || codepoint > 0x10FFFF ||
+            (codepoint >= 0xD800 && codepoint <= 0xDFFF)) {
+            result += u'�';
+            continue;
+        }
+
+        if (codepoint >= 0x10000) {
+            codepoint -= 0x10000;
+            result += static_cast<char16_t>(0xD800 + (codepoint >> 10));
+            result += static_cast<char16_t>(0xDC00 + (codepoint & 0x3FF));
+        } else {
+            result += static_cast<char16_t>(codepoint);
+        }
+    }
+
+    return result;
 }
 
 } // namespace util
@@ -10,16 +10,32 @@ extern "C"
 namespace mbgl {
 
 PremultipliedImage decodeWebP(const uint8_t* data, size_t size) {
-    int width = 0, height = 0;
-    if (WebPGetInfo(data, size, &width, &height) == 0) {
+    WebPDecoderConfig config;
+    if (WebPInitDecoderConfig(&config) == 0) {
+        throw std::runtime_error("failed to initialize WebP decoder configuration");
+    }
+
+    if (WebPGetFeatures(data, size, &config.input) != VP8_STATUS_OK) {
         throw std::runtime_error("failed to retrieve WebP basic header information");
     }
 
-    int stride = width * 4;
-    size_t webpSize = stride * height;
-    auto webp = std::make_unique<uint8_t[]>(webpSize);
+    const int width = config.input.width;
+    const int height = config.input.height;
+
+    const int stride = width * 4;
+    const size_t webpSize = stride * height;
+    auto webp = util::allocateImageBuffer(webpSize);
+
+    // Decode straight into our buffer, using libwebp's internal
+    // multi-threading to split rows across cores.
+    config.options.use_threads = 1;
+    config.output.colorspace = MODE_RGBA;
+    config.output.is_external_memory = 1;
+    config.output.u.RGBA.rgba = webp.get();
+    config.output.u.RGBA.stride = stride;
+    config.output.u.RGBA.size = webpSize;
 
-    if (!WebPDecodeRGBAInto(data, size, webp.get(), webpSize, stride)) {
+    if (WebPDecode(data, size, &config) != VP8_STATUS_OK) {
         throw std::runtime_error("failed to decode WebP data");
     }
 
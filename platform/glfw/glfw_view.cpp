@@ -11,7 +11,9 @@
 #include <mbgl/map/camera.hpp>
 
 #include <cassert>
+#include <chrono>
 #include <cstdlib>
+#include <thread>
 
 void glfwError(int error, const char *description) {
     mbgl::Log::Error(mbgl::Event::OpenGL, "GLFW error (%i): %s", error, description);
@@ -84,6 +86,11 @@ GLFWView::GLFWView(bool fullscreen_, bool benchmark_)
     glfwGetFramebufferSize(window, &fbWidth, &fbHeight);
     pixelRatio = static_cast<float>(fbWidth) / width;
 
+    const GLFWvidmode* mode = glfwGetVideoMode(monitor ? monitor : glfwGetPrimaryMonitor());
+    const int refreshRate = mode && mode->refreshRate > 0 ? mode->refreshRate : 60;
+    frameScheduler = std::make_unique<mbgl::util::FrameScheduler>(
+        std::chrono::duration_cast<mbgl::Duration>(std::chrono::duration<double>(1.0 / refreshRate)));
+
     glfwMakeContextCurrent(nullptr);
 
     printf("\n");
@@ -450,14 +457,28 @@ void GLFWView::run() {
         glfwPollEvents();
 
         if (dirty) {
+            if (!benchmark) {
+                // The loop blocks for vsync in glfwSwapBuffers either way;
+                // waiting before the render instead of after means input is
+                // sampled as late as the frame-time estimate allows, which
+                // is what bounds input-to-photon latency.
+                const auto wait = frameScheduler->timeUntilFrameStart(mbgl::Clock::now());
+                if (wait > mbgl::Duration::zero()) {
+                    std::this_thread::sleep_for(wait);
+                }
+            }
+
             const double started = glfwGetTime();
+            frameScheduler->frameStarted(mbgl::Clock::now());
 
             activate();
             mbgl::BackendScope scope { *this, mbgl::BackendScope::ScopeType::Implicit };
 
             map->render(*this);
+            frameScheduler->frameRendered(mbgl::Clock::now());
 
             glfwSwapBuffers(window);
+            frameScheduler->framePresented(mbgl::Clock::now());
 
             report(1000 * (glfwGetTime() - started));
             if (benchmark) {
@@ -468,7 +489,10 @@ void GLFWView::run() {
         }
     };
 
-    frameTick.start(mbgl::Duration::zero(), mbgl::Milliseconds(1000 / 60), callback);
+    frameTick.start(mbgl::Duration::zero(),
+                    std::chrono::duration_cast<mbgl::Milliseconds>(
+                        frameScheduler->getStatistics().refreshInterval),
+                    callback);
 #if defined(__APPLE__)
     while (!glfwWindowShouldClose(window)) runLoop.run();
 #else
@@ -514,6 +538,17 @@ void GLFWView::report(float duration) {
         frameTime /= frames;
         mbgl::Log::Info(mbgl::Event::OpenGL, "Frame time: %6.2fms (%6.2f fps)", frameTime,
             1000 / frameTime);
+
+        // The minimum slack over the interval is the proven latency bound;
+        // negative means at least one frame missed its refresh deadline.
+        const auto stats = frameScheduler->getStatistics();
+        using ms = std::chrono::duration<double, std::milli>;
+        mbgl::Log::Info(mbgl::Event::OpenGL,
+            "Frame slack: %6.2fms avg, %6.2fms min (%llu missed deadlines)",
+            ms(stats.averageSlack).count(), ms(stats.minimumSlack).count(),
+            static_cast<unsigned long long>(stats.missedDeadlines));
+        frameScheduler->resetStatistics();
+
         frames = 0;
         frameTime = 0;
         lastReported = currentTime;
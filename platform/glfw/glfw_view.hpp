@@ -3,10 +3,13 @@
 #include <mbgl/map/map.hpp>
 #include <mbgl/map/view.hpp>
 #include <mbgl/map/backend.hpp>
+#include <mbgl/util/frame_scheduler.hpp>
 #include <mbgl/util/run_loop.hpp>
 #include <mbgl/util/timer.hpp>
 #include <mbgl/util/geometry.hpp>
 
+#include <memory>
+
 #if MBGL_USE_GLES2
 #define GLFW_INCLUDE_ES2
 #endif
@@ -111,6 +114,10 @@ private:
     mbgl::util::RunLoop runLoop;
     mbgl::util::Timer frameTick;
 
+    // Paces render starts against the display refresh; constructed once the
+    // window exists and the monitor's refresh rate is known.
+    std::unique_ptr<mbgl::util::FrameScheduler> frameScheduler;
+
     GLFWwindow *window = nullptr;
     bool dirty = false;
 };
@@ -41,6 +41,7 @@ macro(mbgl_platform_core)
         PRIVATE platform/darwin/src/nsthread.mm
         PRIVATE platform/darwin/src/string_nsstring.mm
         PRIVATE platform/default/bidi.cpp
+        PRIVATE platform/default/local_glyph_rasterizer.cpp
         PRIVATE platform/default/utf.cpp
 
         # Image handling
@@ -62,6 +63,10 @@ macro(mbgl_platform_core)
         PRIVATE platform/default/mbgl/util/shared_thread_pool.hpp
         PRIVATE platform/default/mbgl/util/default_thread_pool.cpp
         PRIVATE platform/default/mbgl/util/default_thread_pool.cpp
+
+        # Shared file source
+        PRIVATE platform/default/mbgl/util/shared_file_source.cpp
+        PRIVATE platform/default/mbgl/util/shared_file_source.hpp
     )
 
     target_add_mason_package(mbgl-core PUBLIC geojson)
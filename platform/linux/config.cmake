@@ -69,6 +69,7 @@ macro(mbgl_platform_core)
         PRIVATE platform/default/string_stdlib.cpp
         PRIVATE platform/default/thread.cpp
         PRIVATE platform/default/bidi.cpp
+        PRIVATE platform/default/local_glyph_rasterizer.cpp
         PRIVATE platform/default/utf.cpp
 
         # Image handling
@@ -85,6 +86,10 @@ macro(mbgl_platform_core)
         PRIVATE platform/default/mbgl/gl/offscreen_view.cpp
         PRIVATE platform/default/mbgl/gl/offscreen_view.hpp
 
+        # Still-image render server
+        PRIVATE platform/default/mbgl/map/map_pool.cpp
+        PRIVATE platform/default/mbgl/map/map_pool.hpp
+
         # Thread pool
         PRIVATE platform/default/mbgl/util/default_thread_pool.cpp
         PRIVATE platform/default/mbgl/util/default_thread_pool.cpp
@@ -136,6 +141,13 @@ macro(mbgl_platform_offline)
 endmacro()
 
 
+macro(mbgl_platform_soak)
+    target_link_libraries(mbgl-soak
+        PRIVATE mbgl-loop-uv
+    )
+endmacro()
+
+
 macro(mbgl_platform_test)
     target_sources(mbgl-test
         PRIVATE platform/default/mbgl/test/main.cpp
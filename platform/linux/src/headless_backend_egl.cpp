@@ -67,7 +67,7 @@ gl::ProcAddress HeadlessBackend::initializeExtension(const char* name) {
 
 bool HeadlessBackend::hasDisplay() {
     if (!display) {
-        display.reset(new HeadlessDisplay);
+        display = getSharedDisplay();
     }
     return bool(display);
 };
@@ -37,6 +37,7 @@ macro(mbgl_platform_core)
         PRIVATE platform/darwin/src/nsthread.mm
         PRIVATE platform/darwin/src/string_nsstring.mm
         PRIVATE platform/default/bidi.cpp
+        PRIVATE platform/default/local_glyph_rasterizer.cpp
         PRIVATE platform/default/utf.cpp
 
         # Image handling
@@ -53,11 +54,19 @@ macro(mbgl_platform_core)
         PRIVATE platform/default/mbgl/gl/offscreen_view.cpp
         PRIVATE platform/default/mbgl/gl/offscreen_view.hpp
 
+        # Still-image render server
+        PRIVATE platform/default/mbgl/map/map_pool.cpp
+        PRIVATE platform/default/mbgl/map/map_pool.hpp
+
         # Thread pool
         PRIVATE platform/default/mbgl/util/shared_thread_pool.cpp
         PRIVATE platform/default/mbgl/util/shared_thread_pool.hpp
         PRIVATE platform/default/mbgl/util/default_thread_pool.cpp
         PRIVATE platform/default/mbgl/util/default_thread_pool.cpp
+
+        # Shared file source
+        PRIVATE platform/default/mbgl/util/shared_file_source.cpp
+        PRIVATE platform/default/mbgl/util/shared_file_source.hpp
     )
 
     target_add_mason_package(mbgl-core PUBLIC geojson)
@@ -107,6 +116,13 @@ macro(mbgl_platform_offline)
 endmacro()
 
 
+macro(mbgl_platform_soak)
+    target_link_libraries(mbgl-soak
+        PRIVATE mbgl-loop-darwin
+    )
+endmacro()
+
+
 macro(mbgl_platform_test)
     target_sources(mbgl-test
         PRIVATE platform/default/mbgl/test/main.cpp
@@ -29,10 +29,19 @@ struct NodeMap::RenderOptions {
     mbgl::MapDebugOptions debugOptions = mbgl::MapDebugOptions::NoDebug;
 };
 
+struct NodeMap::QueuedRender {
+    QueuedRender(RenderOptions options_, std::unique_ptr<Nan::Callback> callback_)
+        : options(std::move(options_)), callback(std::move(callback_)) {}
+
+    RenderOptions options;
+    std::unique_ptr<Nan::Callback> callback;
+};
+
 Nan::Persistent<v8::Function> NodeMap::constructor;
 
 static std::shared_ptr<mbgl::HeadlessDisplay> sharedDisplay() {
-    static auto display = std::make_shared<mbgl::HeadlessDisplay>();
+    // Retains the process-wide display for the lifetime of the module.
+    static auto display = mbgl::HeadlessBackend::getSharedDisplay();
     return display;
 }
 
@@ -326,7 +335,7 @@ NodeMap::RenderOptions NodeMap::ParseOptions(v8::Local<v8::Object> obj) {
  * @param {Array<string>} [options.classes=[]] style classes
  * @param {Function} callback
  * @returns {undefined} calls callback
- * @throws {Error} if stylesheet is not loaded or if map is already rendering
+ * @throws {Error} if stylesheet is not loaded or if the render queue is full
  */
 void NodeMap::Render(const Nan::FunctionCallbackInfo<v8::Value>& info) {
     auto nodeMap = Nan::ObjectWrap::Unwrap<NodeMap>(info.Holder());
@@ -344,12 +353,21 @@ void NodeMap::Render(const Nan::FunctionCallbackInfo<v8::Value>& info) {
         return Nan::ThrowTypeError("Style is not loaded");
     }
 
+    auto options = ParseOptions(Nan::To<v8::Object>(info[0]).ToLocalChecked());
+
     if (nodeMap->callback) {
-        return Nan::ThrowError("Map is currently rendering an image");
+        // A render is already in flight; hold this request and start it when
+        // the map becomes idle, so callers can pipeline renders without a
+        // scheduler of their own.
+        if (nodeMap->queuedRenders.size() >= maxQueuedRenders) {
+            return Nan::ThrowError("Map render queue is full");
+        }
+        nodeMap->queuedRenders.push(std::make_unique<QueuedRender>(
+            std::move(options), std::make_unique<Nan::Callback>(info[1].As<v8::Function>())));
+        info.GetReturnValue().SetUndefined();
+        return;
     }
 
-    auto options = ParseOptions(Nan::To<v8::Object>(info[0]).ToLocalChecked());
-
     assert(!nodeMap->callback);
     assert(!nodeMap->image.data);
     nodeMap->callback = std::make_unique<Nan::Callback>(info[1].As<v8::Function>());
@@ -457,15 +475,21 @@ void NodeMap::renderFinished() {
 
         cb->Call(1, argv);
     } else if (img.data) {
+        const size_t bytes = img.bytes();
         v8::Local<v8::Object> pixels = Nan::NewBuffer(
-            reinterpret_cast<char *>(img.data.get()), img.bytes(),
-            // Retain the data until the buffer is deleted.
-            [](char *, void * hint) {
-                delete [] reinterpret_cast<uint8_t*>(hint);
+            reinterpret_cast<char *>(img.data.get()), bytes,
+            // Retain the data until the buffer is deleted. The pixels live
+            // outside the V8 heap, so tell the GC their weight here and take
+            // it back when the buffer dies — otherwise a burst of renders
+            // looks free to the GC while the process balloons.
+            [](char * data, void * hint) {
+                Nan::AdjustExternalMemory(-static_cast<int>(reinterpret_cast<uintptr_t>(hint)));
+                delete [] reinterpret_cast<uint8_t*>(data);
             },
-            img.data.get()
+            reinterpret_cast<void*>(static_cast<uintptr_t>(bytes))
         ).ToLocalChecked();
         img.data.release();
+        Nan::AdjustExternalMemory(static_cast<int>(bytes));
 
         v8::Local<v8::Value> argv[] = {
             Nan::Null(),
@@ -478,6 +502,21 @@ void NodeMap::renderFinished() {
         };
         cb->Call(1, argv);
     }
+
+    // The map is idle again; begin the next queued render, unless the
+    // callback above already started one of its own.
+    if (map && !callback && !queuedRenders.empty()) {
+        auto next = std::move(queuedRenders.front());
+        queuedRenders.pop();
+        callback = std::move(next->callback);
+        try {
+            startRender(std::move(next->options));
+        } catch (const std::exception& ex) {
+            auto failed = std::move(callback);
+            v8::Local<v8::Value> argv[] = { Nan::Error(ex.what()) };
+            failed->Call(1, argv);
+        }
+    }
 }
 
 /**
@@ -501,6 +540,17 @@ void NodeMap::Release(const Nan::FunctionCallbackInfo<v8::Value>& info) {
 void NodeMap::release() {
     if (!map) throw mbgl::util::Exception(releasedMessage());
 
+    // Fail queued renders; their callbacks would otherwise never fire.
+    if (!queuedRenders.empty()) {
+        Nan::HandleScope scope;
+        while (!queuedRenders.empty()) {
+            auto queued = std::move(queuedRenders.front());
+            queuedRenders.pop();
+            v8::Local<v8::Value> argv[] = { Nan::Error(releasedMessage()) };
+            queued->callback->Call(1, argv);
+        }
+    }
+
     uv_close(reinterpret_cast<uv_handle_t *>(async), [] (uv_handle_t *h) {
         delete reinterpret_cast<uv_async_t *>(h);
     });
@@ -643,7 +693,7 @@ void NodeMap::AddImage(const Nan::FunctionCallbackInfo<v8::Value>& info) {
         return Nan::ThrowTypeError("Image size does not match buffer size");
     }
 
-    std::unique_ptr<uint8_t[]> data = std::make_unique<uint8_t[]>(imageLength);
+    auto data = mbgl::util::allocateImageBuffer(imageLength);
     std::copy(imageDataBuffer, imageDataBuffer + imageLength, data.get());
     mbgl::PremultipliedImage cPremultipliedImage({ imageWidth, imageHeight}, std::move(data));
 
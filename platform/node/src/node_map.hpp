@@ -8,6 +8,7 @@
 #include <mbgl/gl/offscreen_view.hpp>
 
 #include <exception>
+#include <queue>
 
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wunused-parameter"
@@ -27,6 +28,7 @@ class NodeMap : public Nan::ObjectWrap,
                 public mbgl::FileSource {
 public:
     struct RenderOptions;
+    struct QueuedRender;
     class RenderWorker;
 
     NodeMap(v8::Local<v8::Object>);
@@ -76,6 +78,12 @@ public:
     mbgl::PremultipliedImage image;
     std::unique_ptr<Nan::Callback> callback;
 
+    // Renders submitted while one is in flight wait here and start in order
+    // as the map becomes idle. Bounded so a consumer that can't keep up gets
+    // an error instead of unbounded queue growth.
+    std::queue<std::unique_ptr<QueuedRender>> queuedRenders;
+    static constexpr std::size_t maxQueuedRenders = 8;
+
     // Async for delivering the notifications of render completion.
     uv_async_t *async;
 
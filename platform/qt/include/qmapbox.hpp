@@ -91,6 +91,7 @@ struct Q_DECL_EXPORT CustomLayerRenderParameters {
     double bearing;
     double pitch;
     double altitude;
+    double projectionMatrix[16];
 };
 
 typedef void (*CustomLayerInitializeFunction)(void* context) ;
@@ -29,6 +29,7 @@ set(MBGL_QT_FILES
 
     # Misc
     PRIVATE platform/default/logging_stderr.cpp
+    PRIVATE platform/default/local_glyph_rasterizer.cpp
 
     # Thread pool
     PRIVATE platform/default/mbgl/util/shared_thread_pool.cpp
@@ -36,6 +37,14 @@ set(MBGL_QT_FILES
     PRIVATE platform/default/mbgl/util/default_thread_pool.cpp
     PRIVATE platform/default/mbgl/util/default_thread_pool.hpp
 
+    # Shared file source
+    PRIVATE platform/default/mbgl/util/shared_file_source.cpp
+    PRIVATE platform/default/mbgl/util/shared_file_source.hpp
+
+    # Frame pacing for hosts that drive their own render loop
+    PRIVATE platform/default/mbgl/util/frame_scheduler.cpp
+    PRIVATE platform/default/mbgl/util/frame_scheduler.hpp
+
     # Platform integration
     PRIVATE platform/qt/src/async_task.cpp
     PRIVATE platform/qt/src/async_task_impl.hpp
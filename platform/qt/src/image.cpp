@@ -24,7 +24,7 @@ PremultipliedImage decodeJPEG(const uint8_t*, size_t);
 PremultipliedImage decodeWebP(const uint8_t*, size_t);
 #endif
 
-PremultipliedImage decodeImage(const std::string& string) {
+PremultipliedImage decodeImage(const std::string& string, uint32_t) {
     const uint8_t* data = reinterpret_cast<const uint8_t*>(string.data());
     const size_t size = string.size();
 
@@ -54,10 +54,15 @@ PremultipliedImage decodeImage(const std::string& string) {
         throw std::runtime_error("Unsupported image type");
     }
 
-    auto img = std::make_unique<uint8_t[]>(image.byteCount());
+    auto img = util::allocateImageBuffer(image.byteCount());
     memcpy(img.get(), image.constBits(), image.byteCount());
 
     return { { static_cast<uint32_t>(image.width()), static_cast<uint32_t>(image.height()) },
              std::move(img) };
 }
+
+const char* imageAcceptHeader() {
+    // WebP decodes either through the bundled reader or a Qt image plugin.
+    return "image/webp,image/png;q=0.9,image/jpeg;q=0.8,image/*;q=0.5";
+}
 }
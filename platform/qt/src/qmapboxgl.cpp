@@ -92,7 +92,7 @@ std::unique_ptr<const mbgl::SpriteImage> toSpriteImage(const QImage &sprite) {
         .rgbSwapped()
         .convertToFormat(QImage::Format_ARGB32_Premultiplied);
 
-    auto img = std::make_unique<uint8_t[]>(swapped.byteCount());
+    auto img = mbgl::util::allocateImageBuffer(swapped.byteCount());
     memcpy(img.get(), swapped.constBits(), swapped.byteCount());
 
     return std::make_unique<mbgl::SpriteImage>(
@@ -61,6 +61,10 @@ public:
         mailbox->push(actor::makeMessage(object, fn, std::forward<Args>(args)...));
     }
 
+    void setPriority(Mailbox::Priority priority) {
+        mailbox->setPriority(priority);
+    }
+
     ActorRef<std::decay_t<Object>> self() {
         return ActorRef<std::decay_t<Object>>(object, mailbox);
     }
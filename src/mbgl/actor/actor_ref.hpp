@@ -35,6 +35,38 @@ public:
         }
     }
 
+    // Like `invoke`, but the message is dropped once `token` is cancelled:
+    // immediately if it already is, or at delivery time if cancellation
+    // happens while the message is queued.
+    template <typename Fn, class... Args>
+    void invokeGuarded(const TaskToken& token, Fn fn, Args&&... args) {
+        if (token.cancelled()) {
+            return;
+        }
+        if (auto mailbox = weakMailbox.lock()) {
+            mailbox->push(actor::makeGuardedMessage(token, object, fn, std::forward<Args>(args)...));
+        }
+    }
+
+    /*
+        Invoke `fn` on this actor and deliver its return value to `replyFn` on
+        `replyTo`, with both hops guarded by `token`. Continuations compose by
+        having the reply handler issue the next `invokeWithReply`, in place of
+        a nested callback with shared_ptr-captured state; one
+        `TaskScope::cancel()` then stops every pending hop of the chain.
+    */
+    template <class ReplyObject, typename ReplyFn, typename Fn, class... Args>
+    void invokeWithReply(const TaskToken& token, ActorRef<ReplyObject> replyTo, ReplyFn replyFn,
+                         Fn fn, Args&&... args) {
+        if (token.cancelled()) {
+            return;
+        }
+        if (auto mailbox = weakMailbox.lock()) {
+            mailbox->push(actor::makeReplyMessage(token, object, fn, std::move(replyTo), replyFn,
+                                                  std::forward<Args>(args)...));
+        }
+    }
+
 private:
     Object& object;
     std::weak_ptr<Mailbox> weakMailbox;
@@ -2,21 +2,58 @@
 #include <mbgl/actor/message.hpp>
 #include <mbgl/actor/scheduler.hpp>
 
+#include <mbgl/util/chrono.hpp>
+
 #include <cassert>
 
 namespace mbgl {
 
+namespace {
+
+// Per-wakeup drain budget. Processing several queued messages per wakeup
+// amortizes the scheduler round-trip (e.g. fifty glyph-availability
+// notifications arriving back to back), while the caps bound how long one
+// mailbox can monopolize a worker before yielding to the others; hitting
+// either cap re-schedules the mailbox behind them.
+constexpr std::size_t messagesPerWakeup = 64;
+constexpr Milliseconds timeBudgetPerWakeup { 1 };
+
+} // namespace
+
+struct Mailbox::Node {
+    std::atomic<Node*> next { nullptr };
+    std::unique_ptr<Message> message;
+};
+
 Mailbox::Mailbox(Scheduler& scheduler_)
     : scheduler(scheduler_) {
+    // The queue always retains one consumed-out stub node, so producers never
+    // touch the head and the consumer never touches the tail.
+    head = new Node();
+    tail.store(head, std::memory_order_relaxed);
+}
+
+Mailbox::~Mailbox() {
+    while (head) {
+        Node* next = head->next.load(std::memory_order_relaxed);
+        delete head;
+        head = next;
+    }
 }
 
 void Mailbox::push(std::unique_ptr<Message> message) {
     assert(!closing);
 
-    std::lock_guard<std::mutex> queueLock(queueMutex);
-    bool wasEmpty = queue.empty();
-    queue.push(std::move(message));
-    if (wasEmpty) {
+    Node* node = new Node();
+    node->message = std::move(message);
+
+    // A single exchange claims our slot; the release store links the node in
+    // for the consumer. Between the two, the consumer can briefly see the
+    // queue as shorter than the counter says — pop() waits that window out.
+    Node* prev = tail.exchange(node, std::memory_order_acq_rel);
+    prev->next.store(node, std::memory_order_release);
+
+    if (pendingMessages.fetch_add(1, std::memory_order_acq_rel) == 0) {
         scheduler.schedule(shared_from_this());
     }
 }
@@ -28,34 +65,68 @@ void Mailbox::close() {
 }
 
 void Mailbox::receive() {
+    receive(messagesPerWakeup, true);
+}
+
+void Mailbox::receiveOne() {
+    receive(1, false);
+}
+
+void Mailbox::receive(std::size_t maximumMessages, bool useTimeBudget) {
     std::lock_guard<std::mutex> closingLock(closingMutex);
 
     if (closing) {
         return;
     }
 
-    std::unique_ptr<Message> message;
-    bool wasEmpty;
-
-    {
-        std::lock_guard<std::mutex> queueLock(queueMutex);
-        assert(!queue.empty());
-        message = std::move(queue.front());
-        queue.pop();
-        wasEmpty = queue.empty();
-    }
+    const auto start = Clock::now();
+    std::size_t processed = 0;
 
-    (*message)();
+    do {
+        std::unique_ptr<Message> message = pop();
+        assert(message);
+        (*message)();
+        ++processed;
+        // The counter stays above the processed count for as long as more
+        // messages are queued; it is only decremented when the drain ends,
+        // which keeps the scheduling token held and prevents a second
+        // concurrent receive().
+    } while (processed < maximumMessages &&
+             pendingMessages.load(std::memory_order_acquire) > processed &&
+             (!useTimeBudget || Clock::now() - start < timeBudgetPerWakeup));
 
-    if (!wasEmpty) {
+    if (pendingMessages.fetch_sub(processed, std::memory_order_acq_rel) > processed) {
         scheduler.schedule(shared_from_this());
     }
 }
 
+std::unique_ptr<Message> Mailbox::pop() {
+    // Being scheduled implies a message was pushed, but its producer may be
+    // between the tail exchange and linking the node; spin out that window.
+    Node* next = head->next.load(std::memory_order_acquire);
+    while (!next) {
+        next = head->next.load(std::memory_order_acquire);
+    }
+
+    std::unique_ptr<Message> message = std::move(next->message);
+
+    // The consumed node becomes the new stub.
+    delete head;
+    head = next;
+
+    return message;
+}
+
 void Mailbox::maybeReceive(std::weak_ptr<Mailbox> mailbox) {
     if (auto locked = mailbox.lock()) {
         locked->receive();
     }
 }
 
+void Mailbox::maybeReceiveOne(std::weak_ptr<Mailbox> mailbox) {
+    if (auto locked = mailbox.lock()) {
+        locked->receiveOne();
+    }
+}
+
 } // namespace mbgl
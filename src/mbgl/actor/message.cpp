@@ -0,0 +1,94 @@
+#include <mbgl/actor/message.hpp>
+
+#include <array>
+#include <new>
+
+namespace mbgl {
+
+namespace {
+
+// Message storage is recycled through thread-local free lists segregated by
+// size class rather than returned to the heap. Messages are allocated on the
+// sending thread and freed on the receiving thread, so a shared pool would
+// need synchronization on every send; with per-thread lists there is none.
+// Worker threads both consume and produce messages in roughly equal measure,
+// and that is where nearly all of the message rate is, so blocks circulate
+// where they are needed. A mostly-sending thread (the foreground) simply
+// falls through to the heap, and each list is capped so a mostly-receiving
+// thread cannot hoard memory.
+
+constexpr std::array<std::size_t, 3> sizeClasses {{ 64, 128, 256 }};
+constexpr std::size_t maximumBlocksPerClass = 32;
+
+struct FreeBlock {
+    FreeBlock* next;
+};
+
+class FreeLists {
+public:
+    ~FreeLists() {
+        for (FreeBlock* block : heads) {
+            while (block) {
+                FreeBlock* next = block->next;
+                ::operator delete(block);
+                block = next;
+            }
+        }
+    }
+
+    void* take(std::size_t index) {
+        FreeBlock* block = heads[index];
+        if (!block) {
+            return ::operator new(sizeClasses[index]);
+        }
+        heads[index] = block->next;
+        counts[index]--;
+        return block;
+    }
+
+    bool put(std::size_t index, void* ptr) {
+        if (counts[index] >= maximumBlocksPerClass) {
+            return false;
+        }
+        auto* block = static_cast<FreeBlock*>(ptr);
+        block->next = heads[index];
+        heads[index] = block;
+        counts[index]++;
+        return true;
+    }
+
+private:
+    std::array<FreeBlock*, sizeClasses.size()> heads {{}};
+    std::array<std::size_t, sizeClasses.size()> counts {{}};
+};
+
+thread_local FreeLists freeLists;
+
+bool sizeClassIndex(std::size_t size, std::size_t& index) {
+    for (index = 0; index < sizeClasses.size(); ++index) {
+        if (size <= sizeClasses[index]) {
+            return true;
+        }
+    }
+    return false;
+}
+
+} // namespace
+
+void* Message::operator new(std::size_t size) {
+    std::size_t index;
+    if (sizeClassIndex(size, index)) {
+        return freeLists.take(index);
+    }
+    return ::operator new(size);
+}
+
+void Message::operator delete(void* ptr, std::size_t size) {
+    std::size_t index;
+    if (sizeClassIndex(size, index) && freeLists.put(index, ptr)) {
+        return;
+    }
+    ::operator delete(ptr);
+}
+
+} // namespace mbgl
@@ -1,5 +1,9 @@
 #pragma once
 
+#include <mbgl/actor/task.hpp>
+
+#include <cstddef>
+#include <memory>
 #include <utility>
 
 namespace mbgl {
@@ -11,6 +15,12 @@ class Message {
 public:
     virtual ~Message() = default;
     virtual void operator()() = 0;
+
+    // Messages are small, short-lived, and sent at a very high rate during
+    // tile loads; these route their storage through per-thread recycling
+    // lists instead of malloc/free (see message.cpp).
+    static void* operator new(std::size_t);
+    static void operator delete(void*, std::size_t);
 };
 
 template <class Object, class MemberFn, class ArgsTuple>
@@ -36,6 +46,63 @@ public:
     ArgsTuple argsTuple;
 };
 
+// A message that is dropped undelivered once its `TaskToken` is cancelled.
+template <class Object, class MemberFn, class ArgsTuple>
+class GuardedMessageImpl : public MessageImpl<Object, MemberFn, ArgsTuple> {
+public:
+    GuardedMessageImpl(TaskToken token_, Object& object_, MemberFn memberFn_, ArgsTuple argsTuple_)
+      : MessageImpl<Object, MemberFn, ArgsTuple>(object_, memberFn_, std::move(argsTuple_)),
+        token(std::move(token_)) {
+    }
+
+    void operator()() override {
+        if (!token.cancelled()) {
+            MessageImpl<Object, MemberFn, ArgsTuple>::operator()();
+        }
+    }
+
+private:
+    TaskToken token;
+};
+
+// A message that invokes a member function and forwards its return value to
+// another actor, guarded by a `TaskToken` at both hops. `ReplyRef` is an
+// `ActorRef` of the receiving actor; it is a template parameter only to
+// avoid a circular include.
+template <class Object, class MemberFn, class ArgsTuple, class ReplyRef, class ReplyMemberFn>
+class ReplyMessageImpl : public Message {
+public:
+    ReplyMessageImpl(TaskToken token_, Object& object_, MemberFn memberFn_, ArgsTuple argsTuple_,
+                     ReplyRef replyTo_, ReplyMemberFn replyMemberFn_)
+      : token(std::move(token_)),
+        object(object_),
+        memberFn(memberFn_),
+        argsTuple(std::move(argsTuple_)),
+        replyTo(std::move(replyTo_)),
+        replyMemberFn(replyMemberFn_) {
+    }
+
+    void operator()() override {
+        if (!token.cancelled()) {
+            reply(std::make_index_sequence<std::tuple_size<ArgsTuple>::value>());
+        }
+    }
+
+private:
+    template <std::size_t... I>
+    void reply(std::index_sequence<I...>) {
+        replyTo.invokeGuarded(token, replyMemberFn,
+                              (object.*memberFn)(std::move(std::get<I>(argsTuple))...));
+    }
+
+    TaskToken token;
+    Object& object;
+    MemberFn memberFn;
+    ArgsTuple argsTuple;
+    ReplyRef replyTo;
+    ReplyMemberFn replyMemberFn;
+};
+
 namespace actor {
 
 template <class Object, class MemberFn, class... Args>
@@ -44,5 +111,20 @@ std::unique_ptr<Message> makeMessage(Object& object, MemberFn memberFn, Args&&..
     return std::make_unique<MessageImpl<Object, MemberFn, decltype(tuple)>>(object, memberFn, std::move(tuple));
 }
 
+template <class Object, class MemberFn, class... Args>
+std::unique_ptr<Message> makeGuardedMessage(TaskToken token, Object& object, MemberFn memberFn, Args&&... args) {
+    auto tuple = std::make_tuple(std::forward<Args>(args)...);
+    return std::make_unique<GuardedMessageImpl<Object, MemberFn, decltype(tuple)>>(
+        std::move(token), object, memberFn, std::move(tuple));
+}
+
+template <class Object, class MemberFn, class ReplyRef, class ReplyMemberFn, class... Args>
+std::unique_ptr<Message> makeReplyMessage(TaskToken token, Object& object, MemberFn memberFn,
+                                          ReplyRef replyTo, ReplyMemberFn replyMemberFn, Args&&... args) {
+    auto tuple = std::make_tuple(std::forward<Args>(args)...);
+    return std::make_unique<ReplyMessageImpl<Object, MemberFn, decltype(tuple), ReplyRef, ReplyMemberFn>>(
+        std::move(token), object, memberFn, std::move(tuple), std::move(replyTo), replyMemberFn);
+}
+
 } // namespace actor
 } // namespace mbgl
@@ -0,0 +1,71 @@
+#include <mbgl/actor/replay_scheduler.hpp>
+#include <mbgl/actor/mailbox.hpp>
+
+namespace mbgl {
+
+ReplayScheduler::ReplayScheduler(std::vector<uint64_t> trace_)
+    : trace(std::move(trace_)),
+      replaying(true) {
+}
+
+void ReplayScheduler::schedule(std::weak_ptr<Mailbox> mailbox) {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    auto locked = mailbox.lock();
+    if (!locked) {
+        return;
+    }
+
+    auto it = ids.find(locked.get());
+    if (it == ids.end()) {
+        it = ids.emplace(locked.get(), nextId++).first;
+    }
+
+    pending.push_back({ it->second, std::move(mailbox) });
+}
+
+std::size_t ReplayScheduler::runPending() {
+    std::size_t executed = 0;
+
+    Wakeup wakeup;
+    while (takeNext(wakeup)) {
+        Mailbox::maybeReceiveOne(wakeup.mailbox);
+        ++executed;
+    }
+
+    return executed;
+}
+
+bool ReplayScheduler::takeNext(Wakeup& result) {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    if (pending.empty()) {
+        return false;
+    }
+
+    if (replaying && cursor < trace.size()) {
+        const uint64_t want = trace[cursor];
+        for (auto it = pending.begin(); it != pending.end(); ++it) {
+            if (it->id == want) {
+                result = std::move(*it);
+                pending.erase(it);
+                ++cursor;
+                return true;
+            }
+        }
+        // The wakeup the trace calls for has not been scheduled yet; running
+        // anything else now would diverge from the recorded order.
+        return false;
+    }
+
+    result = std::move(pending.front());
+    pending.pop_front();
+
+    if (!replaying) {
+        trace.push_back(result.id);
+    }
+
+    return true;
+}
+
+} // namespace mbgl
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <mbgl/actor/scheduler.hpp>
+
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace mbgl {
+
+/*
+    A `Scheduler` for deterministic record/replay of actor message
+    interleavings, for performance debugging: tile pipeline behavior depends
+    on the order in which worker messages interleave, which differs run to
+    run under the thread pool. This scheduler executes everything on the
+    driving thread, one message per wakeup, and either records the resulting
+    order as a trace or enforces the order of a previously recorded trace, so
+    a run that produced a latency spike can be re-executed exactly under a
+    profiler and bisected.
+
+    Mailboxes are identified by the order of their first wakeup, so a replay
+    must issue the same external sends in the same order as the recording —
+    which is the intended use: a fixed test drive with varying internal
+    interleavings. Trace entries past the scheduled wakeups (or vice versa)
+    simply fall back to arrival order.
+*/
+class ReplayScheduler : public Scheduler {
+public:
+    // Record mode: runPending() executes wakeups in arrival order and
+    // appends each to the trace.
+    ReplayScheduler() = default;
+
+    // Replay mode: runPending() executes wakeups in the order of `trace_`,
+    // continuing in arrival order once the trace is exhausted.
+    explicit ReplayScheduler(std::vector<uint64_t> trace_);
+
+    void schedule(std::weak_ptr<Mailbox>) override;
+
+    // Executes queued wakeups on the calling thread until none is runnable
+    // (in replay mode: until the next trace entry is not yet runnable).
+    // Returns the number of messages executed.
+    std::size_t runPending();
+
+    // The executed wakeup order; in record mode this is the trace to save.
+    const std::vector<uint64_t>& getTrace() const {
+        return trace;
+    }
+
+private:
+    struct Wakeup {
+        uint64_t id;
+        std::weak_ptr<Mailbox> mailbox;
+    };
+
+    bool takeNext(Wakeup&);
+
+    std::mutex mutex;
+    std::deque<Wakeup> pending;
+    std::unordered_map<Mailbox*, uint64_t> ids;
+    uint64_t nextId = 0;
+
+    std::vector<uint64_t> trace;
+    std::size_t cursor = 0;
+    const bool replaying = false;
+};
+
+} // namespace mbgl
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <mbgl/util/noncopyable.hpp>
+
+#include <atomic>
+#include <memory>
+#include <utility>
+
+namespace mbgl {
+
+/*
+    Cooperative cancellation for multi-step actor flows.
+
+    A `TaskScope` is owned by the object whose lifetime bounds a chain of
+    asynchronous work -- typically a tile. Work scheduled on its behalf
+    captures a `TaskToken` from the scope; cancelling the scope (which its
+    destructor also does) flips a single shared flag, so cancellation is O(1)
+    no matter how many continuations are in flight, and each of them drops
+    out at its next token check instead of computing a result nobody wants.
+
+    Tokens are value objects: safe to copy into messages and across threads,
+    and safe to keep after the scope is gone, at which point they continue to
+    read as cancelled.
+*/
+
+class TaskToken {
+public:
+    // A default-constructed token belongs to no scope and never cancels.
+    TaskToken() = default;
+
+    bool cancelled() const {
+        return flag && flag->load();
+    }
+
+private:
+    friend class TaskScope;
+
+    explicit TaskToken(std::shared_ptr<const std::atomic<bool>> flag_)
+        : flag(std::move(flag_)) {
+    }
+
+    std::shared_ptr<const std::atomic<bool>> flag;
+};
+
+class TaskScope : private util::noncopyable {
+public:
+    TaskScope()
+        : flag(std::make_shared<std::atomic<bool>>(false)) {
+    }
+
+    ~TaskScope() {
+        cancel();
+    }
+
+    void cancel() {
+        flag->store(true);
+    }
+
+    TaskToken token() const {
+        return TaskToken(flag);
+    }
+
+private:
+    std::shared_ptr<std::atomic<bool>> flag;
+};
+
+} // namespace mbgl
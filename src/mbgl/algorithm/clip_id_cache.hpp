@@ -0,0 +1,92 @@
+#pragma once
+
+#include <mbgl/tile/tile_id.hpp>
+#include <mbgl/util/clip_id.hpp>
+
+#include <map>
+#include <vector>
+
+namespace mbgl {
+namespace algorithm {
+
+/**
+ * Remembers the clip ID assignment of the previous frame. The set of used
+ * render tiles only changes when tiles load or the camera crosses a tile
+ * boundary, so on most frames the assignment can be replayed verbatim instead
+ * of re-running the generator's sorting, leaf matching, and stencil merging.
+ */
+class ClipIDCache {
+public:
+    /** Replays the previous frame's clip IDs onto the given renderable maps
+        and returns true when every map's sequence of used tile IDs is
+        unchanged since capture(). Leaves the renderables untouched and
+        returns false otherwise. */
+    template <typename RenderableMaps>
+    bool reuse(const RenderableMaps& maps) const {
+        if (maps.size() != tileIDs.size()) {
+            return false;
+        }
+
+        std::size_t i = 0;
+        for (const auto* renderables : maps) {
+            const auto& ids = tileIDs[i++];
+            auto id = ids.begin();
+            for (const auto& pair : *renderables) {
+                if (!pair.second.used) {
+                    continue;
+                }
+                if (id == ids.end() || !(pair.first == *id)) {
+                    return false;
+                }
+                ++id;
+            }
+            if (id != ids.end()) {
+                return false;
+            }
+        }
+
+        i = 0;
+        for (auto* renderables : maps) {
+            auto clip = clips[i++].begin();
+            for (auto& pair : *renderables) {
+                if (pair.second.used) {
+                    pair.second.clip = *clip++;
+                }
+            }
+        }
+
+        return true;
+    }
+
+    /** Records the used tile IDs, their freshly generated clip IDs, and the
+        merged stencil map so that subsequent identical frames can reuse(). */
+    template <typename RenderableMaps>
+    void capture(const RenderableMaps& maps, std::map<UnwrappedTileID, ClipID> stencils_) {
+        tileIDs.clear();
+        clips.clear();
+        stencils = std::move(stencils_);
+
+        for (const auto* renderables : maps) {
+            tileIDs.emplace_back();
+            clips.emplace_back();
+            for (const auto& pair : *renderables) {
+                if (pair.second.used) {
+                    tileIDs.back().push_back(pair.first);
+                    clips.back().push_back(pair.second.clip);
+                }
+            }
+        }
+    }
+
+    const std::map<UnwrappedTileID, ClipID>& getStencils() const {
+        return stencils;
+    }
+
+private:
+    std::vector<std::vector<UnwrappedTileID>> tileIDs;
+    std::vector<std::vector<ClipID>> clips;
+    std::map<UnwrappedTileID, ClipID> stencils;
+};
+
+} // namespace algorithm
+} // namespace mbgl
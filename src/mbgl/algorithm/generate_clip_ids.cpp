@@ -14,7 +14,8 @@
 namespace mbgl {
 namespace algorithm {
 
-ClipIDGenerator::Leaf::Leaf(ClipID& clip_) : clip(clip_) {
+ClipIDGenerator::Leaf::Leaf(ClipID& clip_, const util::ArenaAllocator<CanonicalTileID>& allocator)
+    : children(allocator), clip(clip_) {
 }
 
 void ClipIDGenerator::Leaf::add(const CanonicalTileID& p) {
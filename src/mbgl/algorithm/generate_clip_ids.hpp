@@ -1,6 +1,7 @@
 #pragma once
 
 #include <mbgl/tile/tile_id.hpp>
+#include <mbgl/util/arena.hpp>
 #include <mbgl/util/clip_id.hpp>
 
 #include <unordered_set>
@@ -13,18 +14,38 @@ namespace algorithm {
 class ClipIDGenerator {
 private:
     struct Leaf {
-        Leaf(ClipID&);
+        using Children = std::unordered_set<CanonicalTileID,
+                                            std::hash<CanonicalTileID>,
+                                            std::equal_to<CanonicalTileID>,
+                                            util::ArenaAllocator<CanonicalTileID>>;
+
+        Leaf(ClipID&, const util::ArenaAllocator<CanonicalTileID>&);
         void add(const CanonicalTileID &p);
         bool operator==(const Leaf &other) const;
 
-        std::unordered_set<CanonicalTileID> children;
+        Children children;
         ClipID& clip;
     };
 
+    using Pool = std::unordered_multimap<UnwrappedTileID,
+                                         Leaf,
+                                         std::hash<UnwrappedTileID>,
+                                         std::equal_to<UnwrappedTileID>,
+                                         util::ArenaAllocator<std::pair<const UnwrappedTileID, Leaf>>>;
+
+    // A generator lives for one frame and its bookkeeping dies with it, so
+    // the pool and the per-leaf child sets come out of the frame arena
+    // instead of hitting the heap once per renderable tile.
+    util::Arena& arena;
     uint8_t bit_offset = 0;
-    std::unordered_multimap<UnwrappedTileID, Leaf> pool;
+    Pool pool;
 
 public:
+    explicit ClipIDGenerator(util::Arena& arena_)
+        : arena(arena_),
+          pool(util::ArenaAllocator<std::pair<const UnwrappedTileID, Leaf>>(arena_)) {
+    }
+
     template <typename Renderables>
     void update(Renderables& renderables);
 
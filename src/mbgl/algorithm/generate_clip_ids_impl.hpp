@@ -4,15 +4,63 @@
 #include <mbgl/math/log2.hpp>
 #include <mbgl/util/logging.hpp>
 
+#include <algorithm>
+#include <vector>
+
 namespace mbgl {
 namespace algorithm {
 
+// Two tiles of the same source can only fight over stencil values where
+// their buffered regions overlap on screen: when one is an ancestor of the
+// other, or where tile buffers spill across a shared edge or corner. Tiles
+// at least one tile apart at the finer zoom can never touch, because
+// buffers are smaller than a tile.
+inline bool tilesConflict(const UnwrappedTileID& a, const UnwrappedTileID& b) {
+    const uint8_t z = std::max(a.canonical.z, b.canonical.z);
+
+    const int64_t ax0 = ((int64_t(a.wrap) << a.canonical.z) + a.canonical.x) << (z - a.canonical.z);
+    const int64_t ay0 = int64_t(a.canonical.y) << (z - a.canonical.z);
+    const int64_t ax1 = ax0 + (int64_t(1) << (z - a.canonical.z));
+    const int64_t ay1 = ay0 + (int64_t(1) << (z - a.canonical.z));
+
+    const int64_t bx0 = ((int64_t(b.wrap) << b.canonical.z) + b.canonical.x) << (z - b.canonical.z);
+    const int64_t by0 = int64_t(b.canonical.y) << (z - b.canonical.z);
+    const int64_t bx1 = bx0 + (int64_t(1) << (z - b.canonical.z));
+    const int64_t by1 = by0 + (int64_t(1) << (z - b.canonical.z));
+
+    return ax0 <= bx1 && bx0 <= ax1 && ay0 <= by1 && by0 <= ay1;
+}
+
 template <typename Renderables>
 void ClipIDGenerator::update(Renderables& renderables) {
     std::size_t size = 0;
 
     const auto end = renderables.end();
-    for (auto it = renderables.begin(); it != end; it++) {
+
+    // A tile that conflicts with no other used tile of its source can never
+    // be double-drawn, so it needs no stencil clipping at all: it keeps an
+    // empty clip ID, no stencil mask is drawn for it, and the painter
+    // disables the stencil test when drawing it. Sparse overlay sources are
+    // the common case — most of their tiles have no on-screen neighbor.
+    std::vector<uint8_t, util::ArenaAllocator<uint8_t>> needsClip(
+        renderables.size(), 0, util::ArenaAllocator<uint8_t>(arena));
+    {
+        std::size_t i = 0;
+        for (auto it = renderables.begin(); it != end; ++it, ++i) {
+            if (!it->second.used) {
+                continue;
+            }
+            std::size_t j = i + 1;
+            for (auto jt = std::next(it); jt != end; ++jt, ++j) {
+                if (jt->second.used && tilesConflict(it->first, jt->first)) {
+                    needsClip[i] = needsClip[j] = 1;
+                }
+            }
+        }
+    }
+
+    std::size_t index = 0;
+    for (auto it = renderables.begin(); it != end; it++, index++) {
         auto& tileID = it->first;
         auto& renderable = it->second;
         if (!renderable.used) {
@@ -20,7 +68,10 @@ void ClipIDGenerator::update(Renderables& renderables) {
         }
 
         renderable.clip = {};
-        Leaf leaf{ renderable.clip };
+        if (!needsClip[index]) {
+            continue;
+        }
+        Leaf leaf{ renderable.clip, util::ArenaAllocator<CanonicalTileID>(arena) };
 
         // Try to add all remaining ids as children. We sorted the tile list
         // by z earlier, so all preceding items cannot be children of the current
@@ -54,22 +105,57 @@ void ClipIDGenerator::update(Renderables& renderables) {
     }
 
     if (size > 0) {
-        const uint32_t bit_count = util::ceil_log2(size + 1);
+        // Color the conflict graph of this source's new tiles instead of
+        // numbering them sequentially. Only conflicting tiles need distinct
+        // references, so distant tiles share a value and the band width grows
+        // with the depth of nesting and local adjacency rather than with
+        // log2 of the tile count, leaving stencil bits for more sources.
+        struct Assignment {
+            const UnwrappedTileID& id;
+            uint8_t reference;
+        };
+        std::vector<Assignment> assignments;
+        assignments.reserve(size);
+        uint8_t max_reference = 0;
+        index = 0;
+        for (auto& pair : renderables) {
+            const std::size_t i = index++;
+            auto& renderable = pair.second;
+            if (!renderable.used || !needsClip[i] || !renderable.clip.reference.none()) {
+                continue;
+            }
+            // Reference 0 is reserved to distinguish between areas without
+            // any tiles whatsoever and the current area.
+            uint64_t forbidden = 1;
+            for (const auto& assignment : assignments) {
+                if (tilesConflict(pair.first, assignment.id)) {
+                    forbidden |= 1ull << assignment.reference;
+                }
+            }
+            uint8_t reference = 1;
+            while (reference < 63 && ((forbidden >> reference) & 1)) {
+                reference++;
+            }
+            assignments.push_back({ pair.first, reference });
+            max_reference = std::max(max_reference, reference);
+        }
+
+        const uint32_t bit_count = util::ceil_log2(uint64_t(max_reference) + 1);
         const std::bitset<8> mask = uint64_t(((1ul << bit_count) - 1) << bit_offset);
 
-        // We are starting our count with 1 since we need at least 1 bit set to distinguish between
-        // areas without any tiles whatsoever and the current area.
-        uint8_t count = 1;
+        auto assignment = assignments.begin();
+        index = 0;
         for (auto& pair : renderables) {
+            const std::size_t i = index++;
             auto& renderable = pair.second;
-            if (!renderable.used) {
+            if (!renderable.used || !needsClip[i]) {
                 continue;
             }
             renderable.clip.mask |= mask;
 
             // Assign only to clip IDs that have no value yet.
             if (renderable.clip.reference.none()) {
-                renderable.clip.reference = uint32_t(count++) << bit_offset;
+                renderable.clip.reference = uint32_t(assignment++->reference) << bit_offset;
             }
         }
 
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <mbgl/tile/tile_id.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+namespace mbgl {
+namespace algorithm {
+
+// Scores a retained tile by how unlikely it is to be re-used from the current
+// viewport; the tile cache evicts the highest-scoring tile first. The score
+// combines:
+//
+//  * the zoom delta between the tile and the current zoom, so ancestors and
+//    descendants of the viewport — the tiles a zoom-out-and-back-in gesture
+//    revisits — rank just above the current cover;
+//  * the distance from the viewport center to the tile's extent, measured in
+//    the tile's own units, so any tile containing the center scores a zero
+//    distance regardless of its zoom;
+//  * a logarithmic discount for tiles that have been revived from the cache
+//    before, since past revisits predict future ones without ever pinning a
+//    tile outright.
+//
+// centerX/centerY are the viewport center in world coordinates at zoom 0,
+// i.e. tile coordinates divided by 2^zoom. Wrapped copies of the world are
+// not considered; for them the distance term simply saturates.
+inline double tileEvictionScore(const OverscaledTileID& tileID,
+                                const double currentZoom,
+                                const double centerX,
+                                const double centerY,
+                                const uint32_t revisits) {
+    const double scale = std::pow(2.0, tileID.canonical.z);
+    const double cx = centerX * scale;
+    const double cy = centerY * scale;
+    const double dx = std::max({ tileID.canonical.x - cx, 0.0, cx - (tileID.canonical.x + 1) });
+    const double dy = std::max({ tileID.canonical.y - cy, 0.0, cy - (tileID.canonical.y + 1) });
+    const double distance = std::sqrt(dx * dx + dy * dy);
+
+    const double zoomDelta = std::abs(double(tileID.overscaledZ) - currentZoom);
+
+    return zoomDelta + distance - std::log2(1.0 + double(revisits));
+}
+
+} // namespace algorithm
+} // namespace mbgl
@@ -12,10 +12,51 @@
 
 #include <boost/function_output_iterator.hpp>
 
+#include <algorithm>
+
 namespace mbgl {
 
 using namespace style;
 
+namespace {
+
+LatLngBounds boundsForPoint(const Point<double>& point) {
+    return LatLngBounds::singleton({ point.y, point.x });
+}
+
+// Computes the bounds of a shape annotation's geometry.
+struct ShapeBounds {
+    LatLngBounds bounds = LatLngBounds::empty();
+
+    void operator()(const Point<double>& point) {
+        bounds.extend({ point.y, point.x });
+    }
+
+    template <typename Container>
+    void operator()(const Container& container) {
+        for (const auto& element : container) {
+            operator()(element);
+        }
+    }
+};
+
+LatLngBounds boundsForShape(const ShapeAnnotationGeometry& geometry) {
+    ShapeBounds visitor;
+    ShapeAnnotationGeometry::visit(geometry, [&] (const auto& shape) {
+        visitor(shape);
+    });
+    return visitor.bounds;
+}
+
+// LatLngBounds::intersects is exclusive of the boundary, which would miss
+// tiles for annotations lying exactly on a tile edge.
+bool overlaps(const LatLngBounds& a, const LatLngBounds& b) {
+    return a.north() >= b.south() && b.north() >= a.south() &&
+           a.east() >= b.west() && b.east() >= a.west();
+}
+
+} // namespace
+
 const std::string AnnotationManager::SourceID = "com.mapbox.annotations";
 const std::string AnnotationManager::PointLayerID = "com.mapbox.annotations.points";
 
@@ -54,9 +95,11 @@ Update AnnotationManager::updateAnnotation(const AnnotationID& id, const Annotat
 
 void AnnotationManager::removeAnnotation(const AnnotationID& id) {
     if (symbolAnnotations.find(id) != symbolAnnotations.end()) {
+        dirtyBounds.extend(boundsForPoint(symbolAnnotations.at(id)->annotation.geometry));
         symbolTree.remove(symbolAnnotations.at(id));
         symbolAnnotations.erase(id);
     } else if (shapeAnnotations.find(id) != shapeAnnotations.end()) {
+        dirtyBounds.extend(boundsForShape(shapeAnnotations.at(id)->geometry()));
         obsoleteShapeAnnotationLayers.insert(shapeAnnotations.at(id)->layerID);
         shapeAnnotations.erase(id);
     } else {
@@ -64,28 +107,47 @@ void AnnotationManager::removeAnnotation(const AnnotationID& id) {
     }
 }
 
+AnnotationIDs AnnotationManager::addAnnotations(const std::vector<Annotation>& annotations, const uint8_t maxZoom) {
+    AnnotationIDs ids;
+    ids.reserve(annotations.size());
+    for (const auto& annotation : annotations) {
+        ids.push_back(addAnnotation(annotation, maxZoom));
+    }
+    return ids;
+}
+
+void AnnotationManager::removeAnnotations(const AnnotationIDs& ids) {
+    for (const auto& id : ids) {
+        removeAnnotation(id);
+    }
+}
+
 void AnnotationManager::add(const AnnotationID& id, const SymbolAnnotation& annotation, const uint8_t) {
     auto impl = std::make_shared<SymbolAnnotationImpl>(id, annotation);
     symbolTree.insert(impl);
     symbolAnnotations.emplace(id, impl);
+    dirtyBounds.extend(boundsForPoint(annotation.geometry));
 }
 
 void AnnotationManager::add(const AnnotationID& id, const LineAnnotation& annotation, const uint8_t maxZoom) {
     ShapeAnnotationImpl& impl = *shapeAnnotations.emplace(id,
         std::make_unique<LineAnnotationImpl>(id, annotation, maxZoom)).first->second;
     obsoleteShapeAnnotationLayers.erase(impl.layerID);
+    dirtyBounds.extend(boundsForShape(impl.geometry()));
 }
 
 void AnnotationManager::add(const AnnotationID& id, const FillAnnotation& annotation, const uint8_t maxZoom) {
     ShapeAnnotationImpl& impl = *shapeAnnotations.emplace(id,
         std::make_unique<FillAnnotationImpl>(id, annotation, maxZoom)).first->second;
     obsoleteShapeAnnotationLayers.erase(impl.layerID);
+    dirtyBounds.extend(boundsForShape(impl.geometry()));
 }
 
 void AnnotationManager::add(const AnnotationID& id, const StyleSourcedAnnotation& annotation, const uint8_t maxZoom) {
     ShapeAnnotationImpl& impl = *shapeAnnotations.emplace(id,
         std::make_unique<StyleSourcedAnnotationImpl>(id, annotation, maxZoom)).first->second;
     obsoleteShapeAnnotationLayers.erase(impl.layerID);
+    dirtyBounds.extend(boundsForShape(impl.geometry()));
 }
 
 Update AnnotationManager::update(const AnnotationID& id, const SymbolAnnotation& annotation, const uint8_t maxZoom) {
@@ -206,9 +268,29 @@ void AnnotationManager::updateStyle(Style& style) {
 }
 
 void AnnotationManager::updateData() {
+    if (dirtyBounds.isEmpty()) {
+        return;
+    }
+
+    // Only regenerate tiles that actually touch a changed annotation;
+    // dragging one of 20k markers used to rebuild every annotation tile.
     for (auto& tile : tiles) {
-        tile->setData(getTileData(tile->id.canonical));
+        if (overlaps(LatLngBounds(tile->id.canonical), dirtyBounds)) {
+            tile->setData(getTileData(tile->id.canonical));
+        }
     }
+
+    dirtyBounds = LatLngBounds::empty();
+}
+
+AnnotationIDs AnnotationManager::queryPointAnnotations(const LatLngBounds& bounds) const {
+    AnnotationIDs ids;
+    symbolTree.query(boost::geometry::index::intersects(bounds),
+        boost::make_function_output_iterator([&](const auto& val){
+            ids.push_back(val->id);
+        }));
+    std::sort(ids.begin(), ids.end());
+    return ids;
 }
 
 void AnnotationManager::addTile(AnnotationTile& tile) {
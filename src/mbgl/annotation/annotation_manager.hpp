@@ -4,6 +4,7 @@
 #include <mbgl/annotation/symbol_annotation_impl.hpp>
 #include <mbgl/sprite/sprite_atlas.hpp>
 #include <mbgl/map/update.hpp>
+#include <mbgl/util/geo.hpp>
 #include <mbgl/util/noncopyable.hpp>
 
 #include <string>
@@ -12,7 +13,6 @@
 
 namespace mbgl {
 
-class LatLngBounds;
 class AnnotationTile;
 class AnnotationTileData;
 class SymbolAnnotationImpl;
@@ -31,6 +31,12 @@ public:
     Update updateAnnotation(const AnnotationID&, const Annotation&, const uint8_t maxZoom);
     void removeAnnotation(const AnnotationID&);
 
+    // Bulk variants. Each annotation still updates the R-tree and dirty
+    // bounds individually, but the affected tiles are only regenerated once
+    // per batch (by the next updateData()) rather than once per annotation.
+    AnnotationIDs addAnnotations(const std::vector<Annotation>&, const uint8_t maxZoom);
+    void removeAnnotations(const AnnotationIDs&);
+
     void addIcon(const std::string& name, std::shared_ptr<const SpriteImage>);
     void removeIcon(const std::string& name);
     double getTopOffsetPixelsForIcon(const std::string& name);
@@ -39,6 +45,11 @@ public:
     void updateStyle(style::Style&);
     void updateData();
 
+    // Point annotations whose location falls within `bounds`, in ascending
+    // ID order. Answered straight from the R-tree, which add/update/remove
+    // keep current, so hit-testing does not touch tile data at all.
+    AnnotationIDs queryPointAnnotations(const LatLngBounds&) const;
+
     void addTile(AnnotationTile&);
     void removeTile(AnnotationTile&);
 
@@ -62,6 +73,10 @@ private:
 
     AnnotationID nextID = 0;
 
+    // Union of the regions whose annotations changed since the last
+    // updateData(); only tiles touching it are regenerated.
+    LatLngBounds dirtyBounds = LatLngBounds::empty();
+
     using SymbolAnnotationTree = boost::geometry::index::rtree<std::shared_ptr<const SymbolAnnotationImpl>, boost::geometry::index::rstar<16, 4>>;
     // Unlike std::unordered_map, std::map is guaranteed to sort by AnnotationID, ensuring that older annotations are below newer annotations.
     // <https://github.com/mapbox/mapbox-gl-native/issues/5691>
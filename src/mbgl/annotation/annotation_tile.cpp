@@ -19,7 +19,9 @@ AnnotationTile::~AnnotationTile() {
     annotationManager.removeTile(*this);
 }
 
-void AnnotationTile::setNecessity(Necessity) {}
+void AnnotationTile::setNecessity(Necessity necessity) {
+    GeometryTile::setNecessity(necessity);
+}
 
 AnnotationTileFeature::AnnotationTileFeature(const AnnotationID id_,
                                              FeatureType type_, GeometryCollection geometries_,
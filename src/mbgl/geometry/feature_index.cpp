@@ -1,5 +1,4 @@
 #include <mbgl/geometry/feature_index.hpp>
-#include <mbgl/style/style.hpp>
 #include <mbgl/style/layer.hpp>
 #include <mbgl/style/layer_impl.hpp>
 #include <mbgl/style/layers/symbol_layer.hpp>
@@ -18,6 +17,8 @@
 
 namespace mbgl {
 
+constexpr std::size_t IndexedSubfeature::noGeometry;
+
 FeatureIndex::FeatureIndex()
     : grid(util::EXTENT, 16, 0) {
 }
@@ -26,12 +27,34 @@ void FeatureIndex::insert(const GeometryCollection& geometries,
                           std::size_t index,
                           const std::string& sourceLayerName,
                           const std::string& bucketName) {
+    const std::size_t geometryIndex = packedGeometries.size();
+    PackedGeometry packed { static_cast<uint32_t>(packedRings.size()), 0 };
+    for (const auto& ring : geometries) {
+        packedRings.push_back({ static_cast<uint32_t>(packedVertices.size()),
+                                static_cast<uint32_t>(packedVertices.size() + ring.size()) });
+        packedVertices.insert(packedVertices.end(), ring.begin(), ring.end());
+    }
+    packed.ringsEnd = static_cast<uint32_t>(packedRings.size());
+    packedGeometries.push_back(packed);
+
     for (const auto& ring : geometries) {
-        grid.insert(IndexedSubfeature { index, sourceLayerName, bucketName, sortIndex++ },
+        grid.insert(IndexedSubfeature { index, sourceLayerName, bucketName, sortIndex++, geometryIndex },
                     mapbox::geometry::envelope(ring));
     }
 }
 
+GeometryCollection FeatureIndex::materializeGeometry(std::size_t geometryIndex) const {
+    const PackedGeometry& packed = packedGeometries.at(geometryIndex);
+    GeometryCollection geometries;
+    geometries.reserve(packed.ringsEnd - packed.ringsBegin);
+    for (uint32_t i = packed.ringsBegin; i < packed.ringsEnd; i++) {
+        const PackedRing& ring = packedRings[i];
+        geometries.emplace_back(packedVertices.begin() + ring.begin,
+                                packedVertices.begin() + ring.end);
+    }
+    return geometries;
+}
+
 static bool vectorContains(const std::vector<std::string>& vector, const std::string& s) {
     return std::find(vector.begin(), vector.end(), s) != vector.end();
 }
@@ -62,13 +85,14 @@ void FeatureIndex::query(
         const RenderedQueryOptions& queryOptions,
         const GeometryTileData& geometryTileData,
         const CanonicalTileID& tileID,
-        const style::Style& style,
+        const std::unordered_map<std::string, const style::Layer*>& layers,
+        const float additionalQueryRadius,
         const CollisionTile* collisionTile) const {
 
     mapbox::geometry::box<int16_t> box = mapbox::geometry::envelope(queryGeometry);
 
     const float pixelsToTileUnits = util::EXTENT / tileSize / scale;
-    const int16_t additionalRadius = std::min<int16_t>(util::EXTENT, std::ceil(style.getQueryRadius() * pixelsToTileUnits));
+    const int16_t additionalRadius = std::min<int16_t>(util::EXTENT, std::ceil(additionalQueryRadius * pixelsToTileUnits));
     std::vector<IndexedSubfeature> features = grid.query({ box.min - additionalRadius, box.max + additionalRadius });
 
     std::sort(features.begin(), features.end(), topDown);
@@ -79,7 +103,7 @@ void FeatureIndex::query(
         if (indexedFeature.sortIndex == previousSortIndex) continue;
         previousSortIndex = indexedFeature.sortIndex;
 
-        addFeature(result, indexedFeature, queryGeometry, queryOptions, geometryTileData, tileID, style, bearing, pixelsToTileUnits);
+        addFeature(result, indexedFeature, queryGeometry, queryOptions, geometryTileData, tileID, layers, bearing, pixelsToTileUnits);
     }
 
     // Query symbol features, if they've been placed.
@@ -90,7 +114,7 @@ void FeatureIndex::query(
     std::vector<IndexedSubfeature> symbolFeatures = collisionTile->queryRenderedSymbols(queryGeometry, scale);
     std::sort(symbolFeatures.begin(), symbolFeatures.end(), topDownSymbols);
     for (const auto& symbolFeature : symbolFeatures) {
-        addFeature(result, symbolFeature, queryGeometry, queryOptions, geometryTileData, tileID, style, bearing, pixelsToTileUnits);
+        addFeature(result, symbolFeature, queryGeometry, queryOptions, geometryTileData, tileID, layers, bearing, pixelsToTileUnits);
     }
 }
 
@@ -101,7 +125,7 @@ void FeatureIndex::addFeature(
     const RenderedQueryOptions& options,
     const GeometryTileData& geometryTileData,
     const CanonicalTileID& tileID,
-    const style::Style& style,
+    const std::unordered_map<std::string, const style::Layer*>& layers,
     const float bearing,
     const float pixelsToTileUnits) const {
 
@@ -110,29 +134,50 @@ void FeatureIndex::addFeature(
         return;
     }
 
-    auto sourceLayer = geometryTileData.getLayer(indexedFeature.sourceLayerName);
-    assert(sourceLayer);
-
-    auto geometryTileFeature = sourceLayer->getFeature(indexedFeature.index);
-    assert(geometryTileFeature);
+    // Both the geometry and the pbf-backed feature are materialized lazily:
+    // the geometry comes from the packed arena and is only needed for the
+    // intersection test, while the feature itself is only decoded once a
+    // layer actually passes that test.
+    optional<GeometryCollection> geometries;
+    std::unique_ptr<GeometryTileFeature> geometryTileFeature;
+
+    const auto getFeature = [&] () -> GeometryTileFeature& {
+        if (!geometryTileFeature) {
+            auto sourceLayer = geometryTileData.getLayer(indexedFeature.sourceLayerName);
+            assert(sourceLayer);
+            geometryTileFeature = sourceLayer->getFeature(indexedFeature.index);
+            assert(geometryTileFeature);
+        }
+        return *geometryTileFeature;
+    };
 
     for (const auto& layerID : layerIDs) {
         if (options.layerIDs && !vectorContains(*options.layerIDs, layerID)) {
             continue;
         }
 
-        auto styleLayer = style.getLayer(layerID);
-        if (!styleLayer ||
-            (!styleLayer->is<style::SymbolLayer>() &&
-             !styleLayer->baseImpl->queryIntersectsGeometry(queryGeometry, geometryTileFeature->getGeometries(), bearing, pixelsToTileUnits))) {
+        auto layerIt = layers.find(layerID);
+        const style::Layer* styleLayer = layerIt != layers.end() ? layerIt->second : nullptr;
+        if (!styleLayer) {
             continue;
         }
 
-        if (options.filter && !(*options.filter)(*geometryTileFeature)) {
+        if (!styleLayer->is<style::SymbolLayer>()) {
+            if (!geometries) {
+                geometries = indexedFeature.geometryIndex != IndexedSubfeature::noGeometry
+                    ? materializeGeometry(indexedFeature.geometryIndex)
+                    : getFeature().getGeometries();
+            }
+            if (!styleLayer->baseImpl->queryIntersectsGeometry(queryGeometry, *geometries, bearing, pixelsToTileUnits)) {
+                continue;
+            }
+        }
+
+        if (options.filter && !(*options.filter)(getFeature())) {
             continue;
         }
 
-        result[layerID].push_back(convertFeature(*geometryTileFeature, tileID));
+        result[layerID].push_back(convertFeature(getFeature(), tileID));
     }
 }
 
@@ -162,4 +207,18 @@ void FeatureIndex::setBucketLayerIDs(const std::string& bucketName, const std::v
     bucketLayerIDs[bucketName] = layerIDs;
 }
 
+std::size_t FeatureIndex::byteSize() const {
+    std::size_t size = grid.byteSize();
+    size += packedVertices.size() * sizeof(GeometryCoordinate);
+    size += packedRings.size() * sizeof(PackedRing);
+    size += packedGeometries.size() * sizeof(PackedGeometry);
+    for (const auto& pair : bucketLayerIDs) {
+        size += pair.first.size();
+        for (const auto& layerID : pair.second) {
+            size += layerID.size() + sizeof(std::string);
+        }
+    }
+    return size;
+}
+
 } // namespace mbgl
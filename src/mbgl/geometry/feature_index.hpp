@@ -8,13 +8,14 @@
 #include <vector>
 #include <string>
 #include <unordered_map>
+#include <limits>
 
 namespace mbgl {
 
 class RenderedQueryOptions;
 
 namespace style {
-class Style;
+class Layer;
 } // namespace style
 
 class CollisionTile;
@@ -27,6 +28,12 @@ public:
     std::string sourceLayerName;
     std::string bucketName;
     size_t sortIndex;
+
+    // Position of this feature's geometry in the owning FeatureIndex's packed
+    // arena, or `noGeometry` for symbol features surfaced through the
+    // collision tile, which are never intersection-tested.
+    static constexpr std::size_t noGeometry = std::numeric_limits<std::size_t>::max();
+    std::size_t geometryIndex = noGeometry;
 };
 
 class FeatureIndex {
@@ -35,6 +42,10 @@ public:
 
     void insert(const GeometryCollection&, std::size_t index, const std::string& sourceLayerName, const std::string& bucketName);
 
+    // `layers` maps layer ID to style layer for every layer the query may
+    // touch; `additionalQueryRadius` is the style's query radius in pixels.
+    // Taking these instead of the Style itself lets a query run against
+    // cloned layers off the main thread.
     void query(
             std::unordered_map<std::string, std::vector<Feature>>& result,
             const GeometryCoordinates& queryGeometry,
@@ -44,7 +55,8 @@ public:
             const RenderedQueryOptions& options,
             const GeometryTileData&,
             const CanonicalTileID&,
-            const style::Style&,
+            const std::unordered_map<std::string, const style::Layer*>& layers,
+            const float additionalQueryRadius,
             const CollisionTile*) const;
 
     static optional<GeometryCoordinates> translateQueryGeometry(
@@ -56,6 +68,9 @@ public:
 
     void setBucketLayerIDs(const std::string& bucketName, const std::vector<std::string>& layerIDs);
 
+    // Approximate heap footprint of the index, used for tile cache accounting.
+    std::size_t byteSize() const;
+
 private:
     void addFeature(
             std::unordered_map<std::string, std::vector<Feature>>& result,
@@ -64,13 +79,31 @@ private:
             const RenderedQueryOptions& options,
             const GeometryTileData&,
             const CanonicalTileID&,
-            const style::Style&,
+            const std::unordered_map<std::string, const style::Layer*>& layers,
             const float bearing,
             const float pixelsToTileUnits) const;
 
+    // Rebuilds a GeometryCollection from the packed arena.
+    GeometryCollection materializeGeometry(std::size_t geometryIndex) const;
+
     GridIndex<IndexedSubfeature> grid;
     unsigned int sortIndex = 0;
 
+    // Packed arena of the decoded feature geometries inserted at layout time.
+    // Queries intersection-test against these flat buffers instead of
+    // re-decoding geometry from the vector tile for every candidate.
+    struct PackedRing {
+        uint32_t begin;
+        uint32_t end;
+    };
+    struct PackedGeometry {
+        uint32_t ringsBegin;
+        uint32_t ringsEnd;
+    };
+    std::vector<GeometryCoordinate> packedVertices;
+    std::vector<PackedRing> packedRings;
+    std::vector<PackedGeometry> packedGeometries;
+
     std::unordered_map<std::string, std::vector<std::string>> bucketLayerIDs;
 };
 } // namespace mbgl
@@ -5,6 +5,7 @@
 
 #include <boost/functional/hash.hpp>
 
+#include <algorithm>
 #include <sstream>
 #include <cmath>
 
@@ -30,20 +31,49 @@ LinePatternPos LineAtlas::getDashPosition(const std::vector<float>& dasharray,
     if (it == positions.end()) {
         auto inserted = positions.emplace(key, addDash(dasharray, patternCap));
         assert(inserted.second);
-        return inserted.first->second;
+        return inserted.first->second.position;
     } else {
-        return it->second;
+        it->second.lastUse = ++useTick;
+        return it->second.position;
     }
 }
 
-LinePatternPos LineAtlas::addDash(const std::vector<float>& dasharray, LinePatternCap patternCap) {
+optional<uint32_t> LineAtlas::recycleRow(const uint8_t height) {
+    auto lru = positions.end();
+    for (auto it = positions.begin(); it != positions.end(); ++it) {
+        if (it->second.height != height) {
+            continue;
+        }
+        if (lru == positions.end() || it->second.lastUse < lru->second.lastUse) {
+            lru = it;
+        }
+    }
+
+    if (lru == positions.end()) {
+        return {};
+    }
+
+    const uint32_t row = lru->second.row;
+    positions.erase(lru);
+    return row;
+}
+
+LineAtlas::DashEntry LineAtlas::addDash(const std::vector<float>& dasharray, LinePatternCap patternCap) {
     const uint8_t n = patternCap == LinePatternCap::Round ? 7 : 0;
     const uint8_t dashheight = 2 * n + 1;
     const uint8_t offset = 128;
 
-    if (nextRow + dashheight > image.size.height) {
+    uint32_t startRow;
+    if (nextRow + dashheight <= image.size.height) {
+        startRow = nextRow;
+        nextRow += dashheight;
+    } else if (auto recycled = recycleRow(dashheight)) {
+        // The atlas is full; reuse the band of the least recently used
+        // pattern with the same cap style.
+        startRow = *recycled;
+    } else {
         Log::Warning(Event::OpenGL, "line atlas bitmap overflow");
-        return LinePatternPos();
+        return { LinePatternPos(), 0, 0, ++useTick };
     }
 
     float length = 0;
@@ -58,7 +88,7 @@ LinePatternPos LineAtlas::addDash(const std::vector<float>& dasharray, LinePatte
     bool oddLength = dasharray.size() % 2 == 1;
 
     for (int y = -n; y <= n; y++) {
-        int row = nextRow + n + y;
+        int row = startRow + n + y;
         int index = image.size.width * row;
 
         float left = 0;
@@ -106,15 +136,24 @@ LinePatternPos LineAtlas::addDash(const std::vector<float>& dasharray, LinePatte
     }
 
     LinePatternPos position;
-    position.y = (0.5 + nextRow + n) / image.size.height;
+    position.y = (0.5 + startRow + n) / image.size.height;
     position.height = (2.0 * n) / image.size.height;
     position.width = length;
 
-    nextRow += dashheight;
-
     dirty = true;
+    markDirty(startRow, startRow + dashheight);
 
-    return position;
+    return { position, startRow, dashheight, ++useTick };
+}
+
+void LineAtlas::markDirty(const uint32_t top, const uint32_t bottom) {
+    if (dirtyTop == dirtyBottom) {
+        dirtyTop = top;
+        dirtyBottom = bottom;
+    } else {
+        dirtyTop = std::min(dirtyTop, top);
+        dirtyBottom = std::max(dirtyBottom, bottom);
+    }
 }
 
 Size LineAtlas::getSize() const {
@@ -125,10 +164,18 @@ void LineAtlas::upload(gl::Context& context, gl::TextureUnit unit) {
     if (!texture) {
         texture = context.createTexture(image, unit);
     } else if (dirty) {
-        context.updateTexture(*texture, image, unit);
+        // Only re-send the rows touched since the last upload; a new dash
+        // pattern dirties just its band of the atlas.
+        if (dirtyBottom > dirtyTop) {
+            context.updateTextureBand(*texture, image, dirtyTop, dirtyBottom - dirtyTop, unit);
+        } else {
+            context.updateTexture(*texture, image, unit);
+        }
     }
 
     dirty = false;
+    dirtyTop = 0;
+    dirtyBottom = 0;
 }
 
 void LineAtlas::bind(gl::Context& context, gl::TextureUnit unit) {
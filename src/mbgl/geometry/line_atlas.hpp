@@ -3,6 +3,7 @@
 #include <mbgl/gl/texture.hpp>
 #include <mbgl/gl/object.hpp>
 #include <mbgl/util/image.hpp>
+#include <mbgl/util/memory_stats.hpp>
 #include <mbgl/util/optional.hpp>
 
 #include <vector>
@@ -40,16 +41,38 @@ public:
     void upload(gl::Context&, gl::TextureUnit unit);
 
     LinePatternPos getDashPosition(const std::vector<float>&, LinePatternCap);
-    LinePatternPos addDash(const std::vector<float>& dasharray, LinePatternCap);
 
     Size getSize() const;
 
 private:
+    struct DashEntry {
+        LinePatternPos position;
+        uint32_t row;     // Top row of the rasterized band.
+        uint8_t height;   // Band height in rows.
+        uint64_t lastUse; // Tick of the most recent lookup.
+    };
+
+    DashEntry addDash(const std::vector<float>& dasharray, LinePatternCap);
+
+    // Frees the least recently used entry of matching band height and returns
+    // its top row, or nullopt when no entry of that height exists yet.
+    optional<uint32_t> recycleRow(uint8_t height);
+
+    // Extends the range of rows re-uploaded on the next upload().
+    void markDirty(uint32_t top, uint32_t bottom);
+
     const AlphaImage image;
+    util::TrackedMemory imageMemory { MemoryCategory::Atlases, image.bytes() };
     bool dirty;
+
+    // Row range touched since the last upload; empty iff both are equal.
+    uint32_t dirtyTop = 0;
+    uint32_t dirtyBottom = 0;
+
     mbgl::optional<gl::Texture> texture;
     uint32_t nextRow = 0;
-    std::unordered_map<size_t, LinePatternPos> positions;
+    uint64_t useTick = 0;
+    std::unordered_map<size_t, DashEntry> positions;
 };
 
 } // namespace mbgl
@@ -270,6 +270,17 @@ public:
         return Bindings { As::Type::variableBinding(buffer, Index<As>)... };
     }
 
+    // Whether every binding sources a vertex buffer. Only then does a vertex
+    // array object capture the complete attribute state for these bindings.
+    static bool allVariable(const Bindings& bindings) {
+        bool result = true;
+        util::ignore({ (result = result &&
+                            bindings.template get<As>()
+                                .template is<typename As::Type::VariableBinding>(),
+                        0)... });
+        return result;
+    }
+
     static void bind(Context& context,
                      const Locations& locations,
                      VariableBindings& oldBindings,
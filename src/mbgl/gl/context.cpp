@@ -3,7 +3,11 @@
 #include <mbgl/gl/gl.hpp>
 #include <mbgl/gl/debugging_extension.hpp>
 #include <mbgl/gl/vertex_array_extension.hpp>
+#include <mbgl/gl/instanced_arrays_extension.hpp>
+#include <mbgl/gl/fence_sync_extension.hpp>
+#include <mbgl/gl/timer_query_extension.hpp>
 #include <mbgl/gl/program_binary_extension.hpp>
+#include <mbgl/util/compressed_image.hpp>
 #include <mbgl/util/traits.hpp>
 #include <mbgl/util/std.hpp>
 #include <mbgl/util/logging.hpp>
@@ -64,10 +68,24 @@ void Context::initializeExtensions(const std::function<gl::ProcAddress(const cha
         if (!disableVAOExtension) {
             vertexArray = std::make_unique<extension::VertexArray>(fn);
         }
+        instancedArrays = std::make_unique<extension::InstancedArrays>(fn);
+        fenceSync = std::make_unique<extension::FenceSync>(fn);
+        timerQuery = std::make_unique<extension::TimerQuery>(fn);
 #if MBGL_HAS_BINARY_PROGRAMS
         programBinary = std::make_unique<extension::ProgramBinary>(fn);
 #endif
 
+        // ETC2 decoding adds no new entry points; it is advertised via
+        // GL_ARB_ES3_compatibility on desktop GL and is core in OpenGL ES 3.
+        etc2TextureSupport = strstr(extensions, "GL_ARB_ES3_compatibility") != nullptr ||
+                             strstr(extensions, "GL_OES_compressed_ETC2") != nullptr;
+#if MBGL_USE_GLES2
+        if (const char* version =
+                reinterpret_cast<const char*>(MBGL_CHECK_ERROR(glGetString(GL_VERSION)))) {
+            etc2TextureSupport |= strstr(version, "OpenGL ES 3.") != nullptr;
+        }
+#endif
+
         if (!supportsVertexArrays()) {
             Log::Warning(Event::OpenGL, "Not using Vertex Array Objects");
         }
@@ -170,9 +188,16 @@ UniqueBuffer Context::createVertexBuffer(const void* data, std::size_t size) {
     UniqueBuffer result { std::move(id), { this } };
     vertexBuffer = result;
     MBGL_CHECK_ERROR(glBufferData(GL_ARRAY_BUFFER, size, data, GL_STATIC_DRAW));
+    renderStats.bytesUploaded += size;
     return result;
 }
 
+void Context::updateVertexBuffer(UniqueBuffer& buffer, std::size_t offset, const void* data, std::size_t size) {
+    vertexBuffer = buffer;
+    MBGL_CHECK_ERROR(glBufferSubData(GL_ARRAY_BUFFER, offset, size, data));
+    renderStats.bytesUploaded += size;
+}
+
 UniqueBuffer Context::createIndexBuffer(const void* data, std::size_t size) {
     BufferID id = 0;
     MBGL_CHECK_ERROR(glGenBuffers(1, &id));
@@ -180,6 +205,7 @@ UniqueBuffer Context::createIndexBuffer(const void* data, std::size_t size) {
     vertexArrayObject = 0;
     elementBuffer = result;
     MBGL_CHECK_ERROR(glBufferData(GL_ELEMENT_ARRAY_BUFFER, size, data, GL_STATIC_DRAW));
+    renderStats.bytesUploaded += size;
     return result;
 }
 
@@ -201,6 +227,38 @@ bool Context::supportsVertexArrays() const {
            vertexArray->deleteVertexArrays;
 }
 
+bool Context::supportsInstancedArrays() const {
+    return instancedArrays &&
+           instancedArrays->drawArraysInstanced &&
+           instancedArrays->drawElementsInstanced &&
+           instancedArrays->vertexAttribDivisor;
+}
+
+bool Context::supportsFenceSync() const {
+    return fenceSync &&
+           fenceSync->fenceSync &&
+           fenceSync->clientWaitSync &&
+           fenceSync->deleteSync;
+}
+
+bool Context::supportsTimeElapsedQueries() const {
+    return timerQuery &&
+           timerQuery->genQueries &&
+           timerQuery->deleteQueries &&
+           timerQuery->beginQuery &&
+           timerQuery->endQuery &&
+           timerQuery->getQueryObjectuiv &&
+           timerQuery->getQueryObjectui64v;
+}
+
+std::string Context::rendererSignature() const {
+    const char* renderer =
+        reinterpret_cast<const char*>(MBGL_CHECK_ERROR(glGetString(GL_RENDERER)));
+    const char* version =
+        reinterpret_cast<const char*>(MBGL_CHECK_ERROR(glGetString(GL_VERSION)));
+    return std::string(renderer ? renderer : "") + "/" + (version ? version : "");
+}
+
 #if MBGL_HAS_BINARY_PROGRAMS
 bool Context::supportsProgramBinaries() const {
     return programBinary && programBinary->programBinary && programBinary->getProgramBinary;
@@ -253,14 +311,48 @@ UniqueRenderbuffer Context::createRenderbuffer(const RenderbufferType type, cons
     return renderbuffer;
 }
 
-std::unique_ptr<uint8_t[]> Context::readFramebuffer(const Size size, const TextureFormat format, const bool flip) {
+util::ImageBuffer Context::readFramebuffer(const Size size, const TextureFormat format, const bool flip) {
     const size_t stride = size.width * (format == TextureFormat::RGBA ? 4 : 1);
-    auto data = std::make_unique<uint8_t[]>(stride * size.height);
+    auto data = util::allocateImageBuffer(stride * size.height);
 
 #if not MBGL_USE_GLES2
     // When reading data from the framebuffer, make sure that we are storing the values
     // tightly packed into the buffer to avoid buffer overruns.
     pixelStorePack = { 1 };
+
+    // Read through a pixel pack buffer. Drivers can DMA the pack into buffer
+    // storage instead of taking the slow client-memory path of glReadPixels,
+    // and the row flip happens while copying out of the mapped buffer rather
+    // than as a second in-place pass. The buffer stays on the context for
+    // reuse; headless snapshot rendering reads the same size every frame.
+    if (!packBuffer || packBufferSize < stride * size.height) {
+        BufferID id = 0;
+        MBGL_CHECK_ERROR(glGenBuffers(1, &id));
+        packBuffer = UniqueBuffer{ std::move(id), { this } };
+        packBufferSize = stride * size.height;
+        MBGL_CHECK_ERROR(glBindBuffer(GL_PIXEL_PACK_BUFFER, *packBuffer));
+        MBGL_CHECK_ERROR(
+            glBufferData(GL_PIXEL_PACK_BUFFER, packBufferSize, nullptr, GL_STREAM_READ));
+    } else {
+        MBGL_CHECK_ERROR(glBindBuffer(GL_PIXEL_PACK_BUFFER, *packBuffer));
+    }
+
+    MBGL_CHECK_ERROR(glReadPixels(0, 0, size.width, size.height, static_cast<GLenum>(format),
+                                  GL_UNSIGNED_BYTE, nullptr));
+
+    if (const auto* mapped = reinterpret_cast<const uint8_t*>(
+            MBGL_CHECK_ERROR(glMapBuffer(GL_PIXEL_PACK_BUFFER, GL_READ_ONLY)))) {
+        for (int32_t i = 0; i < static_cast<int32_t>(size.height); i++) {
+            std::memcpy(data.get() + i * stride,
+                        mapped + (flip ? size.height - 1 - i : i) * stride, stride);
+        }
+        MBGL_CHECK_ERROR(glUnmapBuffer(GL_PIXEL_PACK_BUFFER));
+        MBGL_CHECK_ERROR(glBindBuffer(GL_PIXEL_PACK_BUFFER, 0));
+        return data;
+    }
+
+    // Mapping failed (e.g. after a context loss); fall back to a direct read.
+    MBGL_CHECK_ERROR(glBindBuffer(GL_PIXEL_PACK_BUFFER, 0));
 #endif // MBGL_USE_GLES2
 
     MBGL_CHECK_ERROR(glReadPixels(0, 0, size.width, size.height, static_cast<GLenum>(format),
@@ -397,13 +489,64 @@ Context::createTexture(const Size size, const void* data, TextureFormat format,
     return obj;
 }
 
+#ifndef GL_COMPRESSED_RGB8_ETC2
+#define GL_COMPRESSED_RGB8_ETC2 0x9274
+#endif
+#ifndef GL_COMPRESSED_RGBA8_ETC2_EAC
+#define GL_COMPRESSED_RGBA8_ETC2_EAC 0x9278
+#endif
+
+Texture Context::createCompressedTexture(const CompressedImage& image, TextureUnit unit) {
+    auto obj = createTexture();
+    activeTexture = unit;
+    ++renderStats.textureBinds;
+    texture[unit] = obj;
+    renderStats.bytesUploaded += image.dataSize;
+    const GLenum internalFormat = image.format == CompressedImage::Format::ETC2RGBA8
+                                      ? GL_COMPRESSED_RGBA8_ETC2_EAC
+                                      : GL_COMPRESSED_RGB8_ETC2;
+    MBGL_CHECK_ERROR(glCompressedTexImage2D(GL_TEXTURE_2D, 0, internalFormat, image.size.width,
+                                            image.size.height, 0,
+                                            static_cast<GLsizei>(image.dataSize), image.data()));
+    MBGL_CHECK_ERROR(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE));
+    MBGL_CHECK_ERROR(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE));
+    MBGL_CHECK_ERROR(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST));
+    MBGL_CHECK_ERROR(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST));
+    return { image.size, std::move(obj) };
+}
+
 void Context::updateTexture(
     TextureID id, const Size size, const void* data, TextureFormat format, TextureUnit unit) {
     activeTexture = unit;
+    if (texture[unit] != id) {
+        ++renderStats.textureBinds;
+    }
     texture[unit] = id;
     MBGL_CHECK_ERROR(glTexImage2D(GL_TEXTURE_2D, 0, static_cast<GLenum>(format), size.width,
                                   size.height, 0, static_cast<GLenum>(format), GL_UNSIGNED_BYTE,
                                   data));
+    if (data) {
+        renderStats.bytesUploaded +=
+            std::size_t(size.width) * size.height * (format == TextureFormat::RGBA ? 4 : 1);
+    }
+}
+
+void Context::updateTextureBand(TextureID id,
+                                const Size size,
+                                const uint32_t y,
+                                const uint32_t height,
+                                const void* data,
+                                TextureFormat format,
+                                TextureUnit unit) {
+    activeTexture = unit;
+    if (texture[unit] != id) {
+        ++renderStats.textureBinds;
+    }
+    texture[unit] = id;
+    MBGL_CHECK_ERROR(glTexSubImage2D(GL_TEXTURE_2D, 0, 0, y, size.width, height,
+                                     static_cast<GLenum>(format), GL_UNSIGNED_BYTE, data));
+    renderStats.bytesUploaded +=
+        std::size_t(size.width) * height * (format == TextureFormat::RGBA ? 4 : 1);
 }
 
 void Context::bindTexture(Texture& obj,
@@ -414,6 +557,9 @@ void Context::bindTexture(Texture& obj,
                           TextureWrap wrapY) {
     if (filter != obj.filter || mipmap != obj.mipmap || wrapX != obj.wrapX || wrapY != obj.wrapY) {
         activeTexture = unit;
+        if (texture[unit] != obj.texture) {
+            ++renderStats.textureBinds;
+        }
         texture[unit] = obj.texture;
 
         if (filter != obj.filter || mipmap != obj.mipmap) {
@@ -445,6 +591,7 @@ void Context::bindTexture(Texture& obj,
         // We are checking first to avoid setting the active texture without a subsequent
         // texture bind.
         activeTexture = unit;
+        ++renderStats.textureBinds;
         texture[unit] = obj.texture;
     }
 }
@@ -452,7 +599,25 @@ void Context::bindTexture(Texture& obj,
 void Context::reset() {
     std::copy(pooledTextures.begin(), pooledTextures.end(), std::back_inserter(abandonedTextures));
     pooledTextures.resize(0);
+#if not MBGL_USE_GLES2
+    packBuffer = {};
+    packBufferSize = 0;
+#endif // MBGL_USE_GLES2
     performCleanup();
+
+    // The context is being torn down; delete retired objects without waiting
+    // on their fences.
+    while (!retirements.empty()) {
+        auto& entry = retirements.front();
+        if (!entry.buffers.empty()) {
+            MBGL_CHECK_ERROR(glDeleteBuffers(int(entry.buffers.size()), entry.buffers.data()));
+        }
+        if (!entry.textures.empty()) {
+            MBGL_CHECK_ERROR(glDeleteTextures(int(entry.textures.size()), entry.textures.data()));
+        }
+        MBGL_CHECK_ERROR(fenceSync->deleteSync(entry.sync));
+        retirements.pop_front();
+    }
 }
 
 void Context::setDirtyState() {
@@ -477,6 +642,8 @@ void Context::setDirtyState() {
     program.setDirty();
     lineWidth.setDirty();
     activeTexture.setDirty();
+    scissorTest.setDirty();
+    scissorBox.setDirty();
 #if not MBGL_USE_GLES2
     pointSize.setDirty();
     pixelZoom.setDirty();
@@ -585,6 +752,7 @@ void Context::setColorMode(const ColorMode& color) {
 void Context::draw(PrimitiveType primitiveType,
                    std::size_t indexOffset,
                    std::size_t indexLength) {
+    ++renderStats.drawCalls;
     MBGL_CHECK_ERROR(glDrawElements(
         static_cast<GLenum>(primitiveType),
         static_cast<GLsizei>(indexLength),
@@ -614,8 +782,6 @@ void Context::performCleanup() {
                 elementBuffer.setDirty();
             }
         }
-        MBGL_CHECK_ERROR(glDeleteBuffers(int(abandonedBuffers.size()), abandonedBuffers.data()));
-        abandonedBuffers.clear();
     }
 
     if (!abandonedTextures.empty()) {
@@ -624,8 +790,50 @@ void Context::performCleanup() {
                 activeTexture.setDirty();
             }
         }
-        MBGL_CHECK_ERROR(glDeleteTextures(int(abandonedTextures.size()), abandonedTextures.data()));
-        abandonedTextures.clear();
+    }
+
+    if (!abandonedBuffers.empty() || !abandonedTextures.empty()) {
+        // When fence syncs are available, deletion is deferred until the GPU
+        // has passed a fence inserted behind the frame that last used the
+        // objects. Deleting them right away can force an implicit sync on
+        // tiled renderers when many tiles retire at once.
+        if (supportsFenceSync()) {
+            if (void* sync = fenceSync->fenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0)) {
+                retirements.push_back(
+                    { sync, std::move(abandonedBuffers), std::move(abandonedTextures) });
+                abandonedBuffers.clear();
+                abandonedTextures.clear();
+            }
+        }
+        if (!abandonedBuffers.empty()) {
+            MBGL_CHECK_ERROR(
+                glDeleteBuffers(int(abandonedBuffers.size()), abandonedBuffers.data()));
+            abandonedBuffers.clear();
+        }
+        if (!abandonedTextures.empty()) {
+            MBGL_CHECK_ERROR(
+                glDeleteTextures(int(abandonedTextures.size()), abandonedTextures.data()));
+            abandonedTextures.clear();
+        }
+    }
+
+    // Delete retired objects whose fences the GPU has passed. Entries are in
+    // submission order, so stop at the first fence that is still pending.
+    while (!retirements.empty()) {
+        auto& entry = retirements.front();
+        const GLenum status =
+            MBGL_CHECK_ERROR(fenceSync->clientWaitSync(entry.sync, 0, 0));
+        if (status != GL_ALREADY_SIGNALED && status != GL_CONDITION_SATISFIED) {
+            break;
+        }
+        if (!entry.buffers.empty()) {
+            MBGL_CHECK_ERROR(glDeleteBuffers(int(entry.buffers.size()), entry.buffers.data()));
+        }
+        if (!entry.textures.empty()) {
+            MBGL_CHECK_ERROR(glDeleteTextures(int(entry.textures.size()), entry.textures.data()));
+        }
+        MBGL_CHECK_ERROR(fenceSync->deleteSync(entry.sync));
+        retirements.pop_front();
     }
 
     if (!abandonedVertexArrays.empty()) {
@@ -14,11 +14,14 @@
 #include <mbgl/gl/depth_mode.hpp>
 #include <mbgl/gl/stencil_mode.hpp>
 #include <mbgl/gl/color_mode.hpp>
+#include <mbgl/util/image_buffer_pool.hpp>
 #include <mbgl/util/noncopyable.hpp>
+#include <mbgl/util/render_statistics.hpp>
 
 
 #include <functional>
 #include <memory>
+#include <deque>
 #include <vector>
 #include <array>
 #include <string>
@@ -26,6 +29,7 @@
 namespace mbgl {
 
 class View;
+class CompressedImage;
 
 namespace gl {
 
@@ -36,6 +40,9 @@ namespace extension {
 class VertexArray;
 class Debugging;
 class ProgramBinary;
+class InstancedArrays;
+class FenceSync;
+class TimerQuery;
 } // namespace extension
 
 class Context : private util::noncopyable {
@@ -57,28 +64,75 @@ public:
     bool supportsVertexArrays() const;
     UniqueVertexArray createVertexArray();
 
+    bool supportsInstancedArrays() const;
+
+    bool supportsFenceSync() const;
+
+    bool supportsTimeElapsedQueries() const;
+
 #if MBGL_HAS_BINARY_PROGRAMS
     bool supportsProgramBinaries() const;
 #else
     constexpr bool supportsProgramBinaries() const { return false; }
 #endif
+
+    // A string identifying the driver this context talks to. Program binaries
+    // are driver-specific, so cached binaries are keyed by it.
+    std::string rendererSignature() const;
     optional<std::pair<BinaryProgramFormat, std::string>> getBinaryProgram(ProgramID) const;
 
+    // Consumes the CPU-side storage: the vector is taken by value, so a
+    // moved-in slab is released as soon as the data is on the GPU, ending the
+    // window where the CPU and GPU copies are both resident. A caller that
+    // needs to keep the vertices for later reads passes a copy, which shares
+    // the slab rather than duplicating it.
     template <class Vertex, class DrawMode>
-    VertexBuffer<Vertex, DrawMode> createVertexBuffer(VertexVector<Vertex, DrawMode>&& v) {
+    VertexBuffer<Vertex, DrawMode> createVertexBuffer(VertexVector<Vertex, DrawMode> v) {
         return VertexBuffer<Vertex, DrawMode> {
             v.vertexSize(),
             createVertexBuffer(v.data(), v.byteSize())
         };
     }
 
+    // Overwrites `vertexCount` vertices starting at `vertexOffset` in an
+    // already-created buffer; the rest of the buffer is left untouched.
+    template <class Vertex, class DrawMode>
+    void updateVertexBuffer(VertexBuffer<Vertex, DrawMode>& buffer,
+                            std::size_t vertexOffset,
+                            const Vertex* data,
+                            std::size_t vertexCount) {
+        updateVertexBuffer(buffer.buffer, vertexOffset * sizeof(Vertex), data, vertexCount * sizeof(Vertex));
+    }
+
+    // Consumes the CPU-side storage, like createVertexBuffer above.
     template <class DrawMode>
-    IndexBuffer<DrawMode> createIndexBuffer(IndexVector<DrawMode>&& v) {
+    IndexBuffer<DrawMode> createIndexBuffer(IndexVector<DrawMode> v) {
         return IndexBuffer<DrawMode> {
             createIndexBuffer(v.data(), v.byteSize())
         };
     }
 
+    // Creates a buffer for a vertex layout decided at runtime; `data` holds
+    // `vertexCount` vertices of `vertexSize` bytes each.
+    InterleavedVertexBuffer createInterleavedVertexBuffer(std::size_t vertexSize,
+                                                          std::size_t vertexCount,
+                                                          const void* data) {
+        return InterleavedVertexBuffer {
+            vertexSize,
+            vertexCount,
+            createVertexBuffer(data, vertexSize * vertexCount)
+        };
+    }
+
+    // Overwrites `size` bytes starting at `byteOffset`; the caller accounts
+    // for the buffer's stride when updating a single attribute.
+    void updateInterleavedVertexBuffer(InterleavedVertexBuffer& buffer,
+                                       std::size_t byteOffset,
+                                       const void* data,
+                                       std::size_t size) {
+        updateVertexBuffer(buffer.buffer, byteOffset, data, size);
+    }
+
     template <RenderbufferType type>
     Renderbuffer<type> createRenderbuffer(const Size size) {
         static_assert(type == RenderbufferType::RGBA || type == RenderbufferType::DepthStencil,
@@ -124,6 +178,21 @@ public:
         obj.size = image.size;
     }
 
+    // Re-uploads rows [y, y + height) of an image whose size matches the
+    // texture. OpenGL ES 2 has no GL_UNPACK_ROW_LENGTH, so partial updates
+    // are restricted to full-width row bands.
+    template <typename Image>
+    void updateTextureBand(
+        Texture& obj, const Image& image, uint32_t y, uint32_t height, TextureUnit unit = 0) {
+        assert(obj.size == image.size);
+        assert(y + height <= image.size.height);
+        auto format = image.channels == 4 ? TextureFormat::RGBA : TextureFormat::Alpha;
+        updateTextureBand(obj.texture.get(), image.size, y, height,
+                          image.data.get() +
+                              static_cast<std::size_t>(y) * image.size.width * image.channels,
+                          format, unit);
+    }
+
     // Creates an empty texture with the specified dimensions.
     Texture createTexture(const Size size,
                           TextureFormat format = TextureFormat::RGBA,
@@ -131,6 +200,15 @@ public:
         return { size, createTexture(size, nullptr, format, unit) };
     }
 
+    // Whether ETC2 compressed textures can be uploaded.
+    bool supportsETC2Textures() const {
+        return etc2TextureSupport;
+    }
+
+    // Creates a texture from a compressed payload, uploading it as-is.
+    // Callers must check supportsETC2Textures() first.
+    Texture createCompressedTexture(const CompressedImage&, TextureUnit unit = 0);
+
     void bindTexture(Texture&,
                      TextureUnit = 0,
                      TextureFilter = TextureFilter::Nearest,
@@ -156,6 +234,11 @@ public:
               std::size_t indexOffset,
               std::size_t indexLength);
 
+    // Running counts of the deduplicated GL work issued through this
+    // context. Never reset by the context itself; instrumentation samples
+    // them before and after a frame.
+    RenderStatistics renderStats;
+
     // Actually remove the objects we marked as abandoned with the above methods.
     // Only call this while the OpenGL context is exclusive to this thread.
     void performCleanup();
@@ -171,7 +254,8 @@ public:
             && abandonedBuffers.empty()
             && abandonedTextures.empty()
             && abandonedVertexArrays.empty()
-            && abandonedFramebuffers.empty();
+            && abandonedFramebuffers.empty()
+            && retirements.empty();
     }
 
     void setDirtyState();
@@ -184,22 +268,36 @@ public:
         return vertexArray.get();
     }
 
+    extension::InstancedArrays* getInstancedArraysExtension() const {
+        return instancedArrays.get();
+    }
+
+    extension::TimerQuery* getTimerQueryExtension() const {
+        return timerQuery.get();
+    }
+
 private:
     std::unique_ptr<extension::Debugging> debugging;
     std::unique_ptr<extension::VertexArray> vertexArray;
+    std::unique_ptr<extension::InstancedArrays> instancedArrays;
+    std::unique_ptr<extension::FenceSync> fenceSync;
+    std::unique_ptr<extension::TimerQuery> timerQuery;
 #if MBGL_HAS_BINARY_PROGRAMS
     std::unique_ptr<extension::ProgramBinary> programBinary;
 #endif
+    bool etc2TextureSupport = false;
 
 public:
     State<value::ActiveTexture> activeTexture;
     State<value::BindFramebuffer> bindFramebuffer;
     State<value::Viewport> viewport;
-    std::array<State<value::BindTexture>, 2> texture;
+    std::array<State<value::BindTexture>, 3> texture;
     State<value::BindVertexArray, const Context&> vertexArrayObject { *this };
     State<value::Program> program;
     State<value::BindVertexBuffer> vertexBuffer;
     State<value::BindElementBuffer> elementBuffer;
+    State<value::ScissorTest> scissorTest;
+    State<value::ScissorBox> scissorBox;
 
 #if not MBGL_USE_GLES2
     State<value::PixelZoom> pixelZoom;
@@ -234,12 +332,15 @@ private:
 #endif // MBGL_USE_GLES2
 
     UniqueBuffer createVertexBuffer(const void* data, std::size_t size);
+    void updateVertexBuffer(UniqueBuffer& buffer, std::size_t offset, const void* data, std::size_t size);
     UniqueBuffer createIndexBuffer(const void* data, std::size_t size);
     UniqueTexture createTexture(Size size, const void* data, TextureFormat, TextureUnit);
     void updateTexture(TextureID, Size size, const void* data, TextureFormat, TextureUnit);
+    void updateTextureBand(
+        TextureID, Size size, uint32_t y, uint32_t height, const void* data, TextureFormat, TextureUnit);
     UniqueFramebuffer createFramebuffer();
     UniqueRenderbuffer createRenderbuffer(RenderbufferType, Size size);
-    std::unique_ptr<uint8_t[]> readFramebuffer(Size, TextureFormat, bool flip);
+    util::ImageBuffer readFramebuffer(Size, TextureFormat, bool flip);
 #if not MBGL_USE_GLES2
     void drawPixels(Size size, const void* data, TextureFormat);
 #endif // MBGL_USE_GLES2
@@ -254,6 +355,12 @@ private:
 
     std::vector<TextureID> pooledTextures;
 
+#if not MBGL_USE_GLES2
+    // Reused pixel pack buffer for framebuffer readback.
+    optional<UniqueBuffer> packBuffer;
+    std::size_t packBufferSize = 0;
+#endif // MBGL_USE_GLES2
+
     std::vector<ProgramID> abandonedPrograms;
     std::vector<ShaderID> abandonedShaders;
     std::vector<BufferID> abandonedBuffers;
@@ -262,6 +369,16 @@ private:
     std::vector<FramebufferID> abandonedFramebuffers;
     std::vector<RenderbufferID> abandonedRenderbuffers;
 
+    // Buffers and textures awaiting deletion behind a fence sync. Deleting
+    // objects the GPU may still read from forces an implicit sync on tiled
+    // renderers; these are only deleted once their fence has been passed.
+    struct Retirement {
+        void* sync;
+        std::vector<BufferID> buffers;
+        std::vector<TextureID> textures;
+    };
+    std::deque<Retirement> retirements;
+
 public:
     // For testing
     bool disableVAOExtension = false;
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <mbgl/gl/extension.hpp>
+#include <mbgl/gl/gl.hpp>
+
+#include <cstdint>
+
+#define GL_SYNC_GPU_COMMANDS_COMPLETE     0x9117
+#define GL_ALREADY_SIGNALED               0x911A
+#define GL_TIMEOUT_EXPIRED                0x911B
+#define GL_CONDITION_SATISFIED            0x911C
+#define GL_WAIT_FAILED                    0x911D
+
+namespace mbgl {
+namespace gl {
+namespace extension {
+
+class FenceSync {
+public:
+    // GLsync is only declared by GL 3.2+/ES 3 headers; the opaque pointer it
+    // stands for works everywhere.
+    using SyncID = void*;
+
+    template <typename Fn>
+    FenceSync(const Fn& loadExtension)
+        : fenceSync(loadExtension({ { "GL_ARB_sync", "glFenceSync" },
+                                    { "GL_APPLE_sync", "glFenceSyncAPPLE" } })),
+          clientWaitSync(loadExtension({ { "GL_ARB_sync", "glClientWaitSync" },
+                                         { "GL_APPLE_sync", "glClientWaitSyncAPPLE" } })),
+          deleteSync(loadExtension({ { "GL_ARB_sync", "glDeleteSync" },
+                                     { "GL_APPLE_sync", "glDeleteSyncAPPLE" } })) {
+    }
+
+    const ExtensionFunction<SyncID(GLenum condition, GLbitfield flags)> fenceSync;
+
+    const ExtensionFunction<GLenum(SyncID sync, GLbitfield flags, uint64_t timeout)>
+        clientWaitSync;
+
+    const ExtensionFunction<void(SyncID sync)> deleteSync;
+};
+
+} // namespace extension
+} // namespace gl
+} // namespace mbgl
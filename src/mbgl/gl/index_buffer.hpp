@@ -3,12 +3,17 @@
 #include <mbgl/gl/object.hpp>
 #include <mbgl/gl/draw_mode.hpp>
 #include <mbgl/util/ignore.hpp>
+#include <mbgl/util/memory_stats.hpp>
 
+#include <cstring>
+#include <memory>
 #include <vector>
 
 namespace mbgl {
 namespace gl {
 
+// Index storage is held in a reference-counted slab with the same
+// copy-shares, mutation-detaches semantics as VertexVector.
 template <class DrawMode>
 class IndexVector {
 public:
@@ -17,17 +22,45 @@ public:
     template <class... Args>
     void emplace_back(Args&&... args) {
         static_assert(sizeof...(args) == groupSize, "wrong buffer element count");
-        util::ignore({(v.emplace_back(std::forward<Args>(args)), 0)...});
+        Contents& writable = detach();
+        util::ignore({(writable.emplace_back(std::forward<Args>(args)), 0)...});
     }
 
-    std::size_t indexSize() const { return v.size(); }
-    std::size_t byteSize() const { return v.size() * sizeof(uint16_t); }
+    std::size_t indexSize() const { return contents ? contents->size() : 0; }
+    std::size_t byteSize() const { return indexSize() * sizeof(uint16_t); }
 
-    bool empty() const { return v.empty(); }
-    const uint16_t* data() const { return v.data(); }
+    bool empty() const { return indexSize() == 0; }
+    const uint16_t* data() const { return contents ? contents->data() : nullptr; }
+
+    // Adopts `other`'s slab when the contents are identical, releasing this
+    // vector's copy; both vectors then reference one immutable slab.
+    bool tryShareWith(const IndexVector& other) {
+        if (contents == other.contents) {
+            return true;
+        }
+        if (byteSize() != other.byteSize()) {
+            return false;
+        }
+        if (byteSize() != 0 && std::memcmp(data(), other.data(), byteSize()) != 0) {
+            return false;
+        }
+        contents = other.contents;
+        return true;
+    }
 
 private:
-    std::vector<uint16_t> v;
+    using Contents = std::vector<uint16_t, util::TrackingAllocator<uint16_t, MemoryCategory::Buckets>>;
+
+    Contents& detach() {
+        if (!contents) {
+            contents = std::make_shared<Contents>();
+        } else if (contents.use_count() > 1) {
+            contents = std::make_shared<Contents>(*contents);
+        }
+        return *contents;
+    }
+
+    std::shared_ptr<Contents> contents;
 };
 
 template <class DrawMode>
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <mbgl/gl/extension.hpp>
+#include <mbgl/gl/gl.hpp>
+
+namespace mbgl {
+namespace gl {
+namespace extension {
+
+class InstancedArrays {
+public:
+    template <typename Fn>
+    InstancedArrays(const Fn& loadExtension)
+        : drawArraysInstanced(
+              loadExtension({ { "GL_ARB_instanced_arrays", "glDrawArraysInstanced" },
+                              { "GL_EXT_instanced_arrays", "glDrawArraysInstancedEXT" },
+                              { "GL_ANGLE_instanced_arrays", "glDrawArraysInstancedANGLE" } })),
+          drawElementsInstanced(
+              loadExtension({ { "GL_ARB_instanced_arrays", "glDrawElementsInstanced" },
+                              { "GL_EXT_instanced_arrays", "glDrawElementsInstancedEXT" },
+                              { "GL_ANGLE_instanced_arrays", "glDrawElementsInstancedANGLE" } })),
+          vertexAttribDivisor(
+              loadExtension({ { "GL_ARB_instanced_arrays", "glVertexAttribDivisorARB" },
+                              { "GL_EXT_instanced_arrays", "glVertexAttribDivisorEXT" },
+                              { "GL_ANGLE_instanced_arrays", "glVertexAttribDivisorANGLE" } })) {
+    }
+
+    const ExtensionFunction<void(GLenum mode, GLint first, GLsizei count, GLsizei primcount)>
+        drawArraysInstanced;
+
+    const ExtensionFunction<void(
+        GLenum mode, GLsizei count, GLenum type, const GLvoid* indices, GLsizei primcount)>
+        drawElementsInstanced;
+
+    const ExtensionFunction<void(GLuint index, GLuint divisor)> vertexAttribDivisor;
+};
+
+} // namespace extension
+} // namespace gl
+} // namespace mbgl
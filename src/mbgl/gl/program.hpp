@@ -58,7 +58,8 @@ public:
             const std::string cachePath =
                 shaders::programCachePath(programParameters, name);
             const std::string identifier =
-                shaders::programIdentifier(vertexSource, fragmentSource_);
+                shaders::programIdentifier(vertexSource, fragmentSource_,
+                                           context.rendererSignature());
 
             try {
                 if (auto cachedBinaryProgram = util::readFile(cachePath)) {
@@ -126,6 +127,9 @@ public:
         context.setStencilMode(stencilMode);
         context.setColorMode(colorMode);
 
+        if (context.program != program) {
+            ++context.renderStats.programSwitches;
+        }
         context.program = program;
 
         Uniforms::bind(uniformsState, std::move(uniformValues));
@@ -44,6 +44,16 @@ public:
                 context.elementBuffer.setDirty();
                 context.elementBuffer = indexBuffer_;
             }
+            // If this segment was last drawn with the same buffer bindings,
+            // the VAO just bound already captures all attribute pointer and
+            // enable state, and per-attribute setup can be skipped entirely.
+            // Constant attribute values are context rather than VAO state, so
+            // any constant binding disqualifies the fast path.
+            if (attributeBindings == attributeBindings_ &&
+                Attributes::allVariable(attributeBindings_)) {
+                return;
+            }
+            attributeBindings = attributeBindings_;
         } else {
             // No VAO support. Force attributes to be rebound.
             context.elementBuffer = indexBuffer_;
@@ -60,6 +70,7 @@ public:
 private:
     mutable optional<UniqueVertexArray> vao;
     mutable optional<BufferID> indexBuffer;
+    mutable optional<typename Attributes::Bindings> attributeBindings;
     mutable typename Attributes::VariableBindings variableBindings;
 };
 
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <mbgl/gl/extension.hpp>
+#include <mbgl/gl/gl.hpp>
+
+#include <cstdint>
+
+#ifndef GL_QUERY_RESULT
+#define GL_QUERY_RESULT                   0x8866
+#endif
+#ifndef GL_QUERY_RESULT_AVAILABLE
+#define GL_QUERY_RESULT_AVAILABLE         0x8867
+#endif
+#ifndef GL_TIME_ELAPSED
+#define GL_TIME_ELAPSED                   0x88BF
+#endif
+
+namespace mbgl {
+namespace gl {
+namespace extension {
+
+// Asynchronous GPU elapsed-time queries: GL_EXT_disjoint_timer_query on ES,
+// GL_ARB_timer_query on desktop GL. Results become available only after the
+// GPU has retired the bracketed commands, typically one or more frames after
+// the query was issued, so callers must poll QUERY_RESULT_AVAILABLE rather
+// than read the result in the same frame.
+class TimerQuery {
+public:
+    template <typename Fn>
+    TimerQuery(const Fn& loadExtension)
+        : genQueries(loadExtension({ { "GL_ARB_timer_query", "glGenQueries" },
+                                     { "GL_EXT_disjoint_timer_query", "glGenQueriesEXT" } })),
+          deleteQueries(loadExtension({ { "GL_ARB_timer_query", "glDeleteQueries" },
+                                        { "GL_EXT_disjoint_timer_query", "glDeleteQueriesEXT" } })),
+          beginQuery(loadExtension({ { "GL_ARB_timer_query", "glBeginQuery" },
+                                     { "GL_EXT_disjoint_timer_query", "glBeginQueryEXT" } })),
+          endQuery(loadExtension({ { "GL_ARB_timer_query", "glEndQuery" },
+                                   { "GL_EXT_disjoint_timer_query", "glEndQueryEXT" } })),
+          getQueryObjectuiv(loadExtension({ { "GL_ARB_timer_query", "glGetQueryObjectuiv" },
+                                            { "GL_EXT_disjoint_timer_query", "glGetQueryObjectuivEXT" } })),
+          getQueryObjectui64v(loadExtension({ { "GL_ARB_timer_query", "glGetQueryObjectui64v" },
+                                              { "GL_EXT_disjoint_timer_query", "glGetQueryObjectui64vEXT" } })) {
+    }
+
+    const ExtensionFunction<void(GLsizei n, GLuint* ids)> genQueries;
+    const ExtensionFunction<void(GLsizei n, const GLuint* ids)> deleteQueries;
+    const ExtensionFunction<void(GLenum target, GLuint id)> beginQuery;
+    const ExtensionFunction<void(GLenum target)> endQuery;
+    const ExtensionFunction<void(GLuint id, GLenum pname, GLuint* params)> getQueryObjectuiv;
+    const ExtensionFunction<void(GLuint id, GLenum pname, uint64_t* params)> getQueryObjectui64v;
+};
+
+} // namespace extension
+} // namespace gl
+} // namespace mbgl
@@ -190,6 +190,28 @@ constexpr bool operator==(const Viewport::Type& a, const Viewport::Type& b) {
     return !(a != b);
 }
 
+struct ScissorTest {
+    using Type = bool;
+    static const constexpr Type Default = false;
+    static void Set(const Type&);
+    static Type Get();
+};
+
+struct ScissorBox {
+    struct Type {
+        int32_t x;
+        int32_t y;
+        Size size;
+    };
+    static const constexpr Type Default = { 0, 0, { 0, 0 } };
+    static void Set(const Type&);
+    static Type Get();
+};
+
+constexpr bool operator!=(const ScissorBox::Type& a, const ScissorBox::Type& b) {
+    return a.x != b.x || a.y != b.y || a.size != b.size;
+}
+
 struct BindFramebuffer {
     using Type = FramebufferID;
     static const constexpr Type Default = 0;
@@ -4,12 +4,20 @@
 #include <mbgl/gl/primitives.hpp>
 #include <mbgl/gl/draw_mode.hpp>
 #include <mbgl/util/ignore.hpp>
+#include <mbgl/util/memory_stats.hpp>
 
+#include <cstring>
+#include <memory>
 #include <vector>
 
 namespace mbgl {
 namespace gl {
 
+// Vertex storage is held in a reference-counted slab: copying a VertexVector
+// shares the slab, and a shared slab is treated as immutable — any mutation
+// through a sharing vector first detaches it onto a private copy. This lets
+// styled layers whose evaluated data came out identical keep a single
+// resident copy instead of one per layer.
 template <class V, class DrawMode = Indexed>
 class VertexVector {
 public:
@@ -19,17 +27,51 @@ public:
     template <class... Args>
     void emplace_back(Args&&... args) {
         static_assert(sizeof...(args) == groupSize, "wrong buffer element count");
-        util::ignore({(v.emplace_back(std::forward<Args>(args)), 0)...});
+        Contents& writable = detach();
+        util::ignore({(writable.emplace_back(std::forward<Args>(args)), 0)...});
     }
 
-    std::size_t vertexSize() const { return v.size(); }
-    std::size_t byteSize() const { return v.size() * sizeof(Vertex); }
+    std::size_t vertexSize() const { return contents ? contents->size() : 0; }
+    std::size_t byteSize() const { return vertexSize() * sizeof(Vertex); }
 
-    bool empty() const { return v.empty(); }
-    const Vertex* data() const { return v.data(); }
+    bool empty() const { return vertexSize() == 0; }
+    const Vertex* data() const { return contents ? contents->data() : nullptr; }
+
+    // Write access to the vertices; copies the slab first if it is shared.
+    Vertex* mutableData() { return detach().data(); }
+
+    // Adopts `other`'s slab when the contents are byte-identical, releasing
+    // this vector's copy; both vectors then reference one immutable slab.
+    bool tryShareWith(const VertexVector& other) {
+        if (contents == other.contents) {
+            return true;
+        }
+        if (byteSize() != other.byteSize()) {
+            return false;
+        }
+        if (byteSize() != 0 && std::memcmp(data(), other.data(), byteSize()) != 0) {
+            return false;
+        }
+        contents = other.contents;
+        return true;
+    }
 
 private:
-    std::vector<Vertex> v;
+    // Bucket vertex storage dominates CPU-side render memory; attributing it
+    // lets telemetry report a per-subsystem heap breakdown. A shared slab is
+    // attributed once, no matter how many vectors reference it.
+    using Contents = std::vector<Vertex, util::TrackingAllocator<Vertex, MemoryCategory::Buckets>>;
+
+    Contents& detach() {
+        if (!contents) {
+            contents = std::make_shared<Contents>();
+        } else if (contents.use_count() > 1) {
+            contents = std::make_shared<Contents>(*contents);
+        }
+        return *contents;
+    }
+
+    std::shared_ptr<Contents> contents;
 };
 
 template <class V, class DrawMode = Indexed>
@@ -42,5 +84,16 @@ public:
     UniqueBuffer buffer;
 };
 
+// A vertex buffer whose layout is decided at runtime: `vertexSize` bytes per
+// vertex, with each attribute placed at a byte offset within that stride.
+// Used where the set of interleaved attributes is only known once the style
+// is evaluated, e.g. the data-driven paint properties of a layer.
+class InterleavedVertexBuffer {
+public:
+    std::size_t vertexSize;
+    std::size_t vertexCount;
+    UniqueBuffer buffer;
+};
+
 } // namespace gl
 } // namespace mbgl
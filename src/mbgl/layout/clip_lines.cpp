@@ -5,10 +5,11 @@
 namespace mbgl {
 namespace util {
 
-GeometryCollection clipLines(const GeometryCollection &lines,
+ArenaVector<GeometryCoordinates> clipLines(Arena& arena,
+        const GeometryCollection &lines,
         const int16_t x1, const int16_t y1, const int16_t x2, const int16_t y2) {
 
-    GeometryCollection clippedLines;
+    ArenaVector<GeometryCoordinates> clippedLines{ArenaAllocator<GeometryCoordinates>(arena)};
 
     for (auto& line : lines) {
 
@@ -4,12 +4,16 @@
 #include <string>
 #include <vector>
 #include <mbgl/tile/geometry_tile_data.hpp>
+#include <mbgl/util/arena.hpp>
 
 namespace mbgl {
 namespace util {
 
 
-GeometryCollection clipLines(const GeometryCollection &lines,
+// The clipped lines are layout scratch: the arena backs the collection, and
+// the caller reclaims it wholesale once the symbols are built.
+ArenaVector<GeometryCoordinates> clipLines(Arena&,
+        const GeometryCollection &lines,
         const int16_t x1, const int16_t y1, const int16_t x2, const int16_t y2);
 
 } // end namespace util
@@ -1,8 +1,11 @@
 #include <mbgl/layout/merge_lines.hpp>
 #include <mbgl/layout/symbol_feature.hpp>
+#include <mbgl/tile/geometry_tile_data.hpp>
 
 #include <boost/functional/hash.hpp>
 
+#include <unordered_map>
+
 namespace mbgl {
 namespace util {
 
@@ -42,8 +45,8 @@ size_t mergeFromLeft(std::vector<SymbolFeature>& features,
     return index;
 }
 
-size_t getKey(const std::u16string& text, const GeometryCoordinate& coord) {
-    auto hash = std::hash<std::u16string>()(text);
+size_t getKey(const size_t textHash, const GeometryCoordinate& coord) {
+    auto hash = textHash;
     boost::hash_combine(hash, coord.x);
     boost::hash_combine(hash, coord.y);
     return hash;
@@ -53,6 +56,10 @@ void mergeLines(std::vector<SymbolFeature>& features) {
     Index leftIndex;
     Index rightIndex;
 
+    // Every feature inserts at most one entry into each index.
+    leftIndex.reserve(features.size());
+    rightIndex.reserve(features.size());
+
     for (size_t k = 0; k < features.size(); k++) {
         SymbolFeature& feature = features[k];
         GeometryCollection& geometry = feature.geometry;
@@ -61,8 +68,12 @@ void mergeLines(std::vector<SymbolFeature>& features) {
             continue;
         }
 
-        const size_t leftKey = getKey(*feature.text, geometry[0].front());
-        const size_t rightKey = getKey(*feature.text, geometry[0].back());
+        // Hash the label text once per feature; the per-endpoint keys only
+        // mix in the endpoint coordinates.
+        const size_t textHash = std::hash<std::u16string>()(*feature.text);
+
+        const size_t leftKey = getKey(textHash, geometry[0].front());
+        const size_t rightKey = getKey(textHash, geometry[0].back());
 
         const auto left = rightIndex.find(leftKey);
         const auto right = leftIndex.find(rightKey);
@@ -75,7 +86,7 @@ void mergeLines(std::vector<SymbolFeature>& features) {
 
             leftIndex.erase(leftKey);
             rightIndex.erase(rightKey);
-            rightIndex[getKey(*feature.text, features[i].geometry[0].back())] = i;
+            rightIndex[getKey(textHash, features[i].geometry[0].back())] = i;
 
         } else if (left != rightIndex.end()) {
             // found mergeable line adjacent to the start of the current line, merge
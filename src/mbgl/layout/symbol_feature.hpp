@@ -11,13 +11,16 @@ namespace mbgl {
 class SymbolFeature : public GeometryTileFeature {
 public:
     SymbolFeature(std::unique_ptr<GeometryTileFeature> feature_) :
-        feature(std::move(feature_)),
-        geometry(feature->getGeometries()) // we need a mutable copy of the geometry for mergeLines()
+        feature(std::move(feature_))
+        // Geometry is decoded separately, once the feature is known to yield
+        // a symbol (see SymbolLayout's constructor); most features of a dense
+        // source layer never get that far, and their decode would be wasted.
+        // We keep a mutable copy of the geometry for mergeLines().
     {}
     
     FeatureType getType() const override { return feature->getType(); }
     optional<Value> getValue(const std::string& key) const override { return feature->getValue(key); };
-    std::unordered_map<std::string,Value> getProperties() const override { return feature->getProperties(); };
+    const PropertyMap& getProperties() const override { return feature->getProperties(); };
     optional<FeatureIdentifier> getID() const override { return feature->getID(); };
     GeometryCollection getGeometries() const override { return geometry; };
 
@@ -5,7 +5,9 @@ namespace mbgl {
 
 using namespace style;
 
-SymbolInstance::SymbolInstance(Anchor& anchor,
+SymbolInstance::SymbolInstance(CollisionBoxStore& collisionBoxes,
+                               SymbolQuadStore& symbolQuads,
+                               Anchor& anchor,
                                const GeometryCoordinates& line,
                                const std::pair<Shaping, Shaping>& shapedTextOrientations,
                                const PositionedIcon& shapedIcon,
@@ -29,25 +31,31 @@ SymbolInstance::SymbolInstance(Anchor& anchor,
 
 
     // Create the collision features that will be used to check whether this symbol instance can be placed
-    textCollisionFeature(line, anchor, shapedTextOrientations.second ?: shapedTextOrientations.first, textBoxScale, textPadding, textPlacement, indexedFeature),
-    iconCollisionFeature(line, anchor, shapedIcon, iconBoxScale, iconPadding, iconPlacement, indexedFeature),
+    textCollisionFeature(collisionBoxes, line, anchor, shapedTextOrientations.second ?: shapedTextOrientations.first, textBoxScale, textPadding, textPlacement, indexedFeature),
+    iconCollisionFeature(collisionBoxes, line, anchor, shapedIcon, iconBoxScale, iconPadding, iconPlacement, indexedFeature),
     featureIndex(featureIndex_) {
         
     
 
-    // Create the quads used for rendering the icon and glyphs.
+    // Create the quads used for rendering the icon and glyphs. Glyph quads
+    // are quantized into the tile-wide store; the instance only keeps the
+    // index range.
     if (addToBuffers) {
         if (shapedIcon) {
-            iconQuad = getIconQuad(anchor, shapedIcon, line, layout, layoutTextSize, iconPlacement, shapedTextOrientations.first);
+            iconQuad = QuantizedSymbolQuad(getIconQuad(anchor, shapedIcon, line, layout, layoutTextSize, iconPlacement, shapedTextOrientations.first));
         }
+        quadStart = static_cast<uint32_t>(symbolQuads.size());
         if (shapedTextOrientations.first) {
-            auto quads = getGlyphQuads(anchor, shapedTextOrientations.first, textBoxScale, line, layout, textPlacement, face);
-            glyphQuads.insert(glyphQuads.end(), quads.begin(), quads.end());
+            for (const auto& quad : getGlyphQuads(anchor, shapedTextOrientations.first, textBoxScale, line, layout, textPlacement, face)) {
+                symbolQuads.emplace_back(quad);
+            }
         }
         if (shapedTextOrientations.second) {
-            auto quads = getGlyphQuads(anchor, shapedTextOrientations.second, textBoxScale, line, layout, textPlacement, face);
-            glyphQuads.insert(glyphQuads.end(), quads.begin(), quads.end());
+            for (const auto& quad : getGlyphQuads(anchor, shapedTextOrientations.second, textBoxScale, line, layout, textPlacement, face)) {
+                symbolQuads.emplace_back(quad);
+            }
         }
+        quadCount = static_cast<uint32_t>(symbolQuads.size()) - quadStart;
     }
 
     if (shapedTextOrientations.first && shapedTextOrientations.second) {
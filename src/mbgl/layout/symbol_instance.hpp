@@ -12,7 +12,9 @@ class IndexedSubfeature;
 
 class SymbolInstance {
 public:
-    SymbolInstance(Anchor& anchor,
+    SymbolInstance(CollisionBoxStore&,
+                   SymbolQuadStore&,
+                   Anchor& anchor,
                    const GeometryCoordinates& line,
                    const std::pair<Shaping, Shaping>& shapedTextOrientations,
                    const PositionedIcon& shapedIcon,
@@ -34,8 +36,10 @@ public:
     uint32_t index;
     bool hasText;
     bool hasIcon;
-    SymbolQuads glyphQuads;
-    optional<SymbolQuad> iconQuad;
+    // The instance's glyph quads within the tile's SymbolQuadStore.
+    uint32_t quadStart = 0;
+    uint32_t quadCount = 0;
+    optional<QuantizedSymbolQuad> iconQuad;
     CollisionFeature textCollisionFeature;
     CollisionFeature iconCollisionFeature;
     WritingModeType writingModes;
@@ -2,6 +2,7 @@
 #include <mbgl/layout/merge_lines.hpp>
 #include <mbgl/layout/clip_lines.hpp>
 #include <mbgl/renderer/symbol_bucket.hpp>
+#include <mbgl/style/compiled_filter.hpp>
 #include <mbgl/style/filter_evaluator.hpp>
 #include <mbgl/style/bucket_parameters.hpp>
 #include <mbgl/style/layers/symbol_layer.hpp>
@@ -10,6 +11,7 @@
 #include <mbgl/text/get_anchors.hpp>
 #include <mbgl/text/collision_tile.hpp>
 #include <mbgl/text/shaping.hpp>
+#include <mbgl/text/shaping_cache.hpp>
 #include <mbgl/util/constants.hpp>
 #include <mbgl/util/utf.hpp>
 #include <mbgl/util/token.hpp>
@@ -37,17 +39,32 @@ static bool has(const style::SymbolLayoutProperties::PossiblyEvaluated& layout)
     );
 }
 
+// Pre-placement density culling, point placement only. At low zoom a POI
+// source can put tens of thousands of symbols into one tile, of which
+// placement keeps a few percent — after full shaping cost has been paid for
+// every one. Dense layers are therefore run through a coarse screen-space
+// grid before shaping: at most `densityCellCapacity` features are admitted
+// per cell, in feature order, which tiled sources emit by rank. The capacity
+// is several times what placement can fit into a cell, so the grid only
+// sheds candidates that had no chance of being placed.
+static constexpr uint32_t densityCellSizePixels = 64;
+static constexpr uint8_t densityCellCapacity = 4;
+static constexpr std::size_t densityCullMinimumFeatures = 1024;
+
 SymbolLayout::SymbolLayout(const BucketParameters& parameters,
                            const std::vector<const Layer*>& layers,
                            const GeometryTileLayer& sourceLayer,
                            IconDependencies& iconDependencies,
                            uintptr_t _spriteAtlasMapIndex,
                            GlyphDependencies& glyphDependencies)
-    : sourceLayerName(sourceLayer.getName()),
+    : compareText(CompareTextMap::allocator_type(arena)),
+      sourceLayerName(sourceLayer.getName()),
       bucketName(layers.at(0)->getID()),
       overscaling(parameters.tileID.overscaleFactor()),
       zoom(parameters.tileID.overscaledZ),
       mode(parameters.mode),
+      token(parameters.token),
+      glyphAtlasIdentity(parameters.glyphAtlasIdentity),
       spriteAtlasMapIndex(_spriteAtlasMapIndex),
       tileSize(util::tileSize * overscaling),
       tilePixelRatio(float(util::EXTENT) / tileSize),
@@ -95,16 +112,51 @@ SymbolLayout::SymbolLayout(const BucketParameters& parameters,
     }
 
     // Determine glyph dependencies
+    const CompiledFilter filter { leader.filter, sourceLayer };
     const size_t featureCount = sourceLayer.featureCount();
-    for (size_t i = 0; i < featureCount; ++i) {
+
+    // Overlap-allowing layers render everything, so culling would drop
+    // visible symbols there; everywhere else it only pre-empts placement.
+    const bool cullByDensity = layout.get<SymbolPlacement>() == SymbolPlacementType::Point &&
+        !layout.get<TextAllowOverlap>() && !layout.get<IconAllowOverlap>() &&
+        featureCount >= densityCullMinimumFeatures;
+    const int32_t densityCells = util::max(1u, tileSize / densityCellSizePixels);
+    std::vector<uint8_t> densityCellCounts;
+    if (cullByDensity) {
+        densityCellCounts.resize(densityCells * densityCells, 0);
+    }
+
+    // Tokens are only substituted when the field is constant across the
+    // layer, so the template can be compiled once, on the first matching
+    // feature, instead of re-parsed per feature.
+    optional<util::TokenTemplate> textTemplate;
+    optional<util::TokenTemplate> iconTemplate;
+
+    for (size_t i = 0; !token.cancelled() && i < featureCount; ++i) {
         auto feature = sourceLayer.getFeature(i);
-        if (!leader.filter(feature->getType(), feature->getID(), [&] (const auto& key) { return feature->getValue(key); }))
+        if (!filter(*feature))
             continue;
         
         SymbolFeature ft(std::move(feature));
 
         ft.index = i;
 
+        // Decoding a point anchor is far cheaper than evaluating and shaping
+        // text, so the grid check runs first and a full cell skips both.
+        uint8_t* densityCell = nullptr;
+        if (cullByDensity) {
+            ft.geometry = ft.feature->getGeometries();
+            if (!ft.geometry.empty() && !ft.geometry.front().empty()) {
+                const GeometryCoordinate& anchor = ft.geometry.front().front();
+                const int32_t cellX = util::clamp(int32_t(anchor.x) * densityCells / util::EXTENT, 0, densityCells - 1);
+                const int32_t cellY = util::clamp(int32_t(anchor.y) * densityCells / util::EXTENT, 0, densityCells - 1);
+                densityCell = &densityCellCounts[cellY * densityCells + cellX];
+                if (*densityCell >= densityCellCapacity) {
+                    continue;
+                }
+            }
+        }
+
         auto getValue = [&ft](const std::string& key) -> std::string {
             auto value = ft.getValue(key);
             if (!value)
@@ -125,7 +177,12 @@ SymbolLayout::SymbolLayout(const BucketParameters& parameters,
         if (hasText) {
             std::string u8string = layout.evaluate<TextField>(zoom, ft);
             if (layout.get<TextField>().isConstant()) {
-                u8string = util::replaceTokens(u8string, getValue);
+                if (!textTemplate) {
+                    textTemplate = util::TokenTemplate(u8string);
+                }
+                if (textTemplate->hasTokens()) {
+                    u8string = textTemplate->apply(getValue);
+                }
             }
             
             auto textTransform = layout.evaluate<TextTransform>(zoom, ft);
@@ -150,13 +207,24 @@ SymbolLayout::SymbolLayout(const BucketParameters& parameters,
         if (hasIcon) {
             std::string icon = layout.evaluate<IconImage>(zoom, ft);
             if (layout.get<IconImage>().isConstant()) {
-                icon = util::replaceTokens(icon, getValue);
+                if (!iconTemplate) {
+                    iconTemplate = util::TokenTemplate(icon);
+                }
+                if (iconTemplate->hasTokens()) {
+                    icon = iconTemplate->apply(getValue);
+                }
             }
             ft.icon = icon;
             iconDependencies.insert(*ft.icon);
         }
 
         if (ft.text || ft.icon) {
+            if (ft.geometry.empty()) {
+                ft.geometry = ft.feature->getGeometries();
+            }
+            if (densityCell) {
+                ++*densityCell;
+            }
             features.push_back(std::move(ft));
         }
     }
@@ -170,7 +238,7 @@ bool SymbolLayout::hasSymbolInstances() const {
     return !symbolInstances.empty();
 }
 
-void SymbolLayout::prepare(const GlyphPositionMap& glyphs, const IconAtlasMap& iconMap) {
+void SymbolLayout::prepare(const GlyphPositionMap& glyphs, const IconAtlasMap& iconMap, BiDi& bidi) {
     float horizontalAlign = 0.5;
     float verticalAlign = 0.5;
 
@@ -217,6 +285,11 @@ void SymbolLayout::prepare(const GlyphPositionMap& glyphs, const IconAtlasMap& i
         layout.get<SymbolPlacement>() == SymbolPlacementType::Line;
 
     for (auto it = features.begin(); it != features.end(); ++it) {
+        // Shaping dominates layout cost; stop mid-layer once the tile is
+        // gone. Break rather than return so the arena scratch below is
+        // still reclaimed.
+        if (token.cancelled()) break;
+
         auto& feature = *it;
         if (feature.geometry.empty()) continue;
 
@@ -230,8 +303,12 @@ void SymbolLayout::prepare(const GlyphPositionMap& glyphs, const IconAtlasMap& i
             if (glyphPositions != glyphs.end()) { // If there are no glyphs available for this feature, skip shaping
                 auto applyShaping = [&] (const std::u16string& text, WritingModeType writingMode) {
                     const float oneEm = 24.0f;
-                    const Shaping result = getShaping(
-                        /* string */ text,
+
+                    const ShapingCache::Key key {
+                        /* text */ text,
+                        /* fontStack */ layout.get<TextFont>(),
+                        /* glyphSource */ glyphAtlasIdentity,
+                        /* writingMode */ writingMode,
                         /* maxWidth: ems */ layout.get<SymbolPlacement>() != SymbolPlacementType::Line ?
                             layout.get<TextMaxWidth>() * oneEm : 0,
                         /* lineHeight: ems */ layout.get<TextLineHeight>() * oneEm,
@@ -239,12 +316,30 @@ void SymbolLayout::prepare(const GlyphPositionMap& glyphs, const IconAtlasMap& i
                         /* verticalAlign */ verticalAlign,
                         /* justify */ justify,
                         /* spacing: ems */ layout.get<TextLetterSpacing>() * oneEm,
-                        /* translate */ Point<float>(layout.evaluate<TextOffset>(zoom, feature)[0] * oneEm, layout.evaluate<TextOffset>(zoom, feature)[1] * oneEm),
+                        /* translate */ Point<float>(layout.evaluate<TextOffset>(zoom, feature)[0] * oneEm, layout.evaluate<TextOffset>(zoom, feature)[1] * oneEm)
+                    };
+
+                    // Repeated street names across features and tiles shape to
+                    // the same result, so consult the cache first.
+                    if (optional<Shaping> cached = ShapingCache::shared().get(key)) {
+                        return *cached;
+                    }
+
+                    const Shaping result = getShaping(
+                        /* string */ key.text,
+                        /* maxWidth: ems */ key.maxWidth,
+                        /* lineHeight: ems */ key.lineHeight,
+                        /* horizontalAlign */ horizontalAlign,
+                        /* verticalAlign */ verticalAlign,
+                        /* justify */ justify,
+                        /* spacing: ems */ key.spacing,
+                        /* translate */ key.translate,
                         /* verticalHeight */ oneEm,
                         /* writingMode */ writingMode,
                         /* bidirectional algorithm object */ bidi,
                         /* glyphs */ glyphPositions->second);
 
+                    ShapingCache::shared().put(key, result);
                     return result;
                 };
 
@@ -287,6 +382,7 @@ void SymbolLayout::prepare(const GlyphPositionMap& glyphs, const IconAtlasMap& i
     }
 
     compareText.clear();
+    arena.reset();
 }
 
 void SymbolLayout::addFeature(const std::size_t index,
@@ -345,7 +441,7 @@ void SymbolLayout::addFeature(const std::size_t index,
 
         const bool addToBuffers = mode == MapMode::Still || withinPlus0;
 
-        symbolInstances.emplace_back(anchor, line, shapedTextOrientations, shapedIcon,
+        symbolInstances.emplace_back(collisionBoxes, symbolQuads, anchor, line, shapedTextOrientations, shapedIcon,
                 layout.evaluate(zoom, feature), layoutTextSize,
                 addToBuffers, symbolInstances.size(),
                 textBoxScale, textPadding, textPlacement,
@@ -356,18 +452,19 @@ void SymbolLayout::addFeature(const std::size_t index,
     const auto& type = feature.getType();
 
     if (layout.get<SymbolPlacement>() == SymbolPlacementType::Line) {
-        auto clippedLines = util::clipLines(feature.geometry, 0, 0, util::EXTENT, util::EXTENT);
+        auto clippedLines = util::clipLines(arena, feature.geometry, 0, 0, util::EXTENT, util::EXTENT);
         for (const auto& line : clippedLines) {
-            Anchors anchors = getAnchors(line,
-                                         symbolSpacing,
-                                         textMaxAngle,
-                                         (shapedTextOrientations.second ?: shapedTextOrientations.first).left,
-                                         (shapedTextOrientations.second ?: shapedTextOrientations.first).right,
-                                         shapedIcon.left,
-                                         shapedIcon.right,
-                                         glyphSize,
-                                         textMaxBoxScale,
-                                         overscaling);
+            auto anchors = getAnchors(arena,
+                                      line,
+                                      symbolSpacing,
+                                      textMaxAngle,
+                                      (shapedTextOrientations.second ?: shapedTextOrientations.first).left,
+                                      (shapedTextOrientations.second ?: shapedTextOrientations.first).right,
+                                      shapedIcon.left,
+                                      shapedIcon.right,
+                                      glyphSize,
+                                      textMaxBoxScale,
+                                      overscaling);
 
             for (auto& anchor : anchors) {
                 if (!feature.text || !anchorIsTooClose(*feature.text, textRepeatDistance, anchor)) {
@@ -407,17 +504,17 @@ void SymbolLayout::addFeature(const std::size_t index,
 }
 
 bool SymbolLayout::anchorIsTooClose(const std::u16string& text, const float repeatDistance, const Anchor& anchor) {
-    if (compareText.find(text) == compareText.end()) {
-        compareText.emplace(text, Anchors());
+    auto it = compareText.find(text);
+    if (it == compareText.end()) {
+        it = compareText.emplace(text, CompareAnchors(util::ArenaAllocator<Anchor>(arena))).first;
     } else {
-        auto otherAnchors = compareText.find(text)->second;
-        for (const Anchor& otherAnchor : otherAnchors) {
+        for (const Anchor& otherAnchor : it->second) {
             if (util::dist<float>(anchor.point, otherAnchor.point) < repeatDistance) {
                 return true;
             }
         }
     }
-    compareText[text].push_back(anchor);
+    it->second.push_back(anchor);
     return false;
 }
 
@@ -467,11 +564,11 @@ std::unique_ptr<SymbolBucket> SymbolLayout::place(CollisionTile& collisionTile)
         // Calculate the scales at which the text and icon can be placed without collision.
 
         float glyphScale = hasText ?
-            collisionTile.placeFeature(symbolInstance.textCollisionFeature,
+            collisionTile.placeFeature(symbolInstance.textCollisionFeature, collisionBoxes,
                     layout.get<TextAllowOverlap>(), layout.get<SymbolAvoidEdges>()) :
             collisionTile.minScale;
         float iconScale = hasIcon ?
-            collisionTile.placeFeature(symbolInstance.iconCollisionFeature,
+            collisionTile.placeFeature(symbolInstance.iconCollisionFeature, collisionBoxes,
                     layout.get<IconAllowOverlap>(), layout.get<SymbolAvoidEdges>()) :
             collisionTile.minScale;
 
@@ -492,11 +589,12 @@ std::unique_ptr<SymbolBucket> SymbolLayout::place(CollisionTile& collisionTile)
 
         if (hasText) {
             const float placementZoom = util::max(util::log2(glyphScale) + zoom, 0.0f);
-            collisionTile.insertFeature(symbolInstance.textCollisionFeature, glyphScale, layout.get<TextIgnorePlacement>());
+            collisionTile.insertFeature(symbolInstance.textCollisionFeature, collisionBoxes, glyphScale, layout.get<TextIgnorePlacement>());
             if (glyphScale < collisionTile.maxScale) {
-                for (const auto& symbol : symbolInstance.glyphQuads) {
+                for (uint32_t i = 0; i < symbolInstance.quadCount; i++) {
                     addSymbol(
-                        bucket->text, *bucket->textSizeBinder, symbol, feature, placementZoom,
+                        bucket->text, *bucket->textSizeBinder,
+                        symbolQuads[symbolInstance.quadStart + i], feature, placementZoom,
                         keepUpright, textPlacement, collisionTile.config.angle, symbolInstance.writingModes);
                 }
             }
@@ -504,7 +602,7 @@ std::unique_ptr<SymbolBucket> SymbolLayout::place(CollisionTile& collisionTile)
 
         if (hasIcon) {
             const float placementZoom = util::max(util::log2(iconScale) + zoom, 0.0f);
-            collisionTile.insertFeature(symbolInstance.iconCollisionFeature, iconScale, layout.get<IconIgnorePlacement>());
+            collisionTile.insertFeature(symbolInstance.iconCollisionFeature, collisionBoxes, iconScale, layout.get<IconIgnorePlacement>());
             if (iconScale < collisionTile.maxScale && symbolInstance.iconQuad) {
                 addSymbol(
                     bucket->icon, *bucket->iconSizeBinder, *symbolInstance.iconQuad, feature, placementZoom,
@@ -518,6 +616,17 @@ std::unique_ptr<SymbolBucket> SymbolLayout::place(CollisionTile& collisionTile)
         }
     }
 
+    // Collapse byte-identical data-driven buffers of different styled layers
+    // onto shared slabs; placement rebuilds the bucket on every rotation, so
+    // the duplicates would otherwise stay resident for the life of the tile.
+    auto& binders = bucket->paintPropertyBinders;
+    for (auto it = binders.begin(); it != binders.end(); ++it) {
+        for (auto prev = binders.begin(); prev != it; ++prev) {
+            it->second.first.shareVertexVectorsWith(prev->second.first);
+            it->second.second.shareVertexVectorsWith(prev->second.second);
+        }
+    }
+
     if (collisionTile.config.debug) {
         addToDebugBuffers(collisionTile, *bucket);
     }
@@ -528,7 +637,7 @@ std::unique_ptr<SymbolBucket> SymbolLayout::place(CollisionTile& collisionTile)
 template <typename Buffer>
 void SymbolLayout::addSymbol(Buffer& buffer,
                              SymbolSizeBinder& sizeBinder,
-                             const SymbolQuad& symbol,
+                             const QuantizedSymbolQuad& symbol,
                              const SymbolFeature& feature,
                              const float placementZoom,
                              const bool keepUpright,
@@ -537,15 +646,20 @@ void SymbolLayout::addSymbol(Buffer& buffer,
                              const WritingModeType writingModes) {
     constexpr const uint16_t vertexLength = 4;
 
-    const auto &tl = symbol.tl;
-    const auto &tr = symbol.tr;
-    const auto &bl = symbol.bl;
-    const auto &br = symbol.br;
+    // Dequantize the stored 1/64 px corner offsets; vertex() re-quantizes
+    // with the same factor, so this round-trips exactly.
+    const auto dequantize = [](const Point<int16_t>& offset) {
+        return Point<float>(offset.x / 64.0f, offset.y / 64.0f);
+    };
+    const Point<float> tl = dequantize(symbol.tl);
+    const Point<float> tr = dequantize(symbol.tr);
+    const Point<float> bl = dequantize(symbol.bl);
+    const Point<float> br = dequantize(symbol.br);
     const auto &tex = symbol.tex;
 
     float minZoom = util::max(zoom + util::log2(symbol.minScale), placementZoom);
     float maxZoom = util::min(zoom + util::log2(symbol.maxScale), util::MAX_ZOOM_F);
-    const auto &anchorPoint = symbol.anchorPoint;
+    const Point<float> anchorPoint(symbol.anchorPoint.x, symbol.anchorPoint.y);
 
     // drop incorrectly oriented glyphs
     const float a = std::fmod(symbol.anchorAngle + placementAngle + M_PI, M_PI * 2);
@@ -579,8 +693,8 @@ void SymbolLayout::addSymbol(Buffer& buffer,
     assert(segment.vertexLength <= std::numeric_limits<uint16_t>::max());
     uint16_t index = segment.vertexLength;
 
-    // Encode angle of glyph
-    uint8_t glyphAngle = std::round((symbol.glyphAngle / (M_PI * 2)) * 256);
+    // Angle of glyph, already encoded at quantization time
+    uint8_t glyphAngle = symbol.glyphAngle;
 
     // coordinates (2 triangles)
     buffer.vertices.emplace_back(SymbolLayoutAttributes::vertex(anchorPoint, tl, tex.x, tex.y,
@@ -613,8 +727,9 @@ void SymbolLayout::addToDebugBuffers(CollisionTile& collisionTile, SymbolBucket&
     auto& collisionBox = bucket.collisionBox;
 
     for (const SymbolInstance &symbolInstance : symbolInstances) {
-        auto populateCollisionBox = [&](const auto& feature) {
-            for (const CollisionBox &box : feature.boxes) {
+        auto populateCollisionBox = [&](const CollisionFeature& feature) {
+            for (uint32_t i = 0; i < feature.boxCount; i++) {
+                const CollisionBox& box = collisionBoxes[feature.boxStart + i];
                 auto& anchor = box.anchor;
 
                 Point<float> tl{box.x1, box.y1 * yStretch};
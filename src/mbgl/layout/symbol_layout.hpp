@@ -1,5 +1,6 @@
 #pragma once
 
+#include <mbgl/actor/task.hpp>
 #include <mbgl/map/mode.hpp>
 #include <mbgl/style/layers/symbol_layer_properties.hpp>
 #include <mbgl/layout/symbol_feature.hpp>
@@ -7,6 +8,7 @@
 #include <mbgl/text/bidi.hpp>
 #include <mbgl/style/layers/symbol_layer_impl.hpp>
 #include <mbgl/programs/symbol_program.hpp>
+#include <mbgl/util/arena.hpp>
 
 #include <memory>
 #include <map>
@@ -35,7 +37,10 @@ public:
                  uintptr_t,
                  GlyphDependencies&);
 
-    void prepare(const GlyphPositionMap& glyphs, const IconAtlasMap& icons);
+    // The BiDi object is owned by the GeometryTileWorker so that its ICU
+    // transform objects are set up once per worker rather than once per
+    // layout; it must only be used from the worker's thread.
+    void prepare(const GlyphPositionMap& glyphs, const IconAtlasMap& icons, BiDi&);
 
     std::unique_ptr<SymbolBucket> place(CollisionTile&);
 
@@ -59,7 +64,17 @@ private:
                     const GlyphPositions& face);
 
     bool anchorIsTooClose(const std::u16string& text, const float repeatDistance, const Anchor&);
-    std::map<std::u16string, std::vector<Anchor>> compareText;
+
+    // Bump arena for layout scratch: clipped lines, anchor candidates, and
+    // the per-text anchor lists below. All of it dies when prepare() ends,
+    // so it is reclaimed with a single reset there instead of thousands of
+    // frees contending on malloc across worker threads.
+    util::Arena arena;
+
+    using CompareAnchors = util::ArenaVector<Anchor>;
+    using CompareTextMap = std::map<std::u16string, CompareAnchors, std::less<std::u16string>,
+        util::ArenaAllocator<std::pair<const std::u16string, CompareAnchors>>>;
+    CompareTextMap compareText;
 
     void addToDebugBuffers(CollisionTile&, SymbolBucket&);
 
@@ -67,7 +82,7 @@ private:
     template <typename Buffer>
     void addSymbol(Buffer&,
                    SymbolSizeBinder& sizeBinder,
-                   const SymbolQuad&,
+                   const QuantizedSymbolQuad&,
                    const SymbolFeature& feature,
                    float scale,
                    const bool keepUpright,
@@ -81,6 +96,14 @@ private:
     const float zoom;
     const MapMode mode;
 
+    // The owning tile's cancellation token; checked per feature so that
+    // decode and shaping of an abandoned tile stop mid-layer.
+    const TaskToken token;
+
+    // Identity of the glyph source shaped against; part of every shaping
+    // cache key. See BucketParameters::glyphAtlasIdentity.
+    const uintptr_t glyphAtlasIdentity;
+
     style::SymbolLayoutProperties::PossiblyEvaluated layout;
     
     uintptr_t spriteAtlasMapIndex; // Actually a pointer to the SpriteAtlas for this symbol's layer, but don't use it from worker threads!
@@ -94,10 +117,19 @@ private:
     style::TextSize::UnevaluatedType textSize;
     style::IconSize::UnevaluatedType iconSize;
 
+    // Slab holding the collision boxes of every symbol instance in this tile.
+    // Instances reference their boxes by index range, so placement — which
+    // runs on every rotation for the lifetime of the tile — walks one
+    // contiguous array. Outlives prepare(), unlike the arena scratch above.
+    CollisionBoxStore collisionBoxes;
+
+    // Slab holding the quantized glyph quads of every symbol instance in this
+    // tile, referenced by index range for the same reason.
+    SymbolQuadStore symbolQuads;
+
     std::vector<SymbolInstance> symbolInstances;
     std::vector<SymbolFeature> features;
 
-    BiDi bidi; // Consider moving this up to geometry tile worker to reduce reinstantiation costs; use of BiDi/ubiditransform object must be constrained to one thread
 };
 
 } // namespace mbgl
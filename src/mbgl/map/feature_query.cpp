@@ -0,0 +1,51 @@
+#include <mbgl/map/feature_query.hpp>
+#include <mbgl/geometry/feature_index.hpp>
+#include <mbgl/style/layer.hpp>
+
+#include <iterator>
+#include <unordered_map>
+
+namespace mbgl {
+
+std::vector<Feature> FeatureQuerySnapshot::execute(const TaskToken& token) const {
+    std::unordered_map<std::string, std::vector<Feature>> resultsByLayer;
+
+    std::unordered_map<std::string, const style::Layer*> layersByID;
+    layersByID.reserve(layers.size());
+    for (const auto& layer : layers) {
+        layersByID.emplace(layer->getID(), layer.get());
+    }
+
+    for (const auto& tile : tiles) {
+        if (token.cancelled()) {
+            return {};
+        }
+
+        tile.data.featureIndex->query(resultsByLayer,
+                                      tile.queryGeometry,
+                                      bearing,
+                                      tile.tileSize,
+                                      tile.scale,
+                                      options,
+                                      *tile.data.data,
+                                      tile.tileID,
+                                      layersByID,
+                                      queryRadius,
+                                      tile.data.collisionTile.get());
+    }
+
+    std::vector<Feature> result;
+    for (const auto& layer : layers) {
+        auto it = resultsByLayer.find(layer->getID());
+        if (it != resultsByLayer.end()) {
+            std::move(it->second.begin(), it->second.end(), std::back_inserter(result));
+        }
+    }
+    return result;
+}
+
+std::vector<Feature> FeatureQueryWorker::execute(FeatureQuerySnapshot snapshot, TaskToken token) {
+    return snapshot.execute(token);
+}
+
+} // namespace mbgl
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <mbgl/map/query.hpp>
+#include <mbgl/actor/task.hpp>
+#include <mbgl/actor/actor_ref.hpp>
+#include <mbgl/tile/tile_id.hpp>
+#include <mbgl/tile/geometry_tile_data.hpp>
+#include <mbgl/util/feature.hpp>
+
+#include <memory>
+#include <vector>
+
+namespace mbgl {
+
+class FeatureIndex;
+class CollisionTile;
+
+namespace style {
+class Layer;
+} // namespace style
+
+// The per-tile state a rendered-features query reads. The pointees are
+// shared with the owning tile but are replaced wholesale rather than mutated
+// in place, and any lazy parsing is forced up front (see
+// GeometryTileData::prepareForQuery), so they can be read from any thread.
+class FeatureQueryData {
+public:
+    std::shared_ptr<const FeatureIndex> featureIndex;
+    std::shared_ptr<const GeometryTileData> data;
+    std::shared_ptr<const CollisionTile> collisionTile;
+};
+
+// A self-contained capture of everything one rendered-features query reads:
+// cloned style layers (freezing their currently evaluated properties), each
+// candidate tile's index and data, and the query geometry already projected
+// into every tile's own coordinate space. Built on the map thread, executable
+// on any other.
+class FeatureQuerySnapshot {
+public:
+    class Tile {
+    public:
+        CanonicalTileID tileID;
+        GeometryCoordinates queryGeometry;
+        double tileSize;
+        double scale;
+        FeatureQueryData data;
+    };
+
+    // Rendered layers in style order, restricted to the queried layer IDs
+    // when the options name any.
+    std::vector<std::unique_ptr<style::Layer>> layers;
+    float queryRadius = 0;
+    float bearing = 0;
+    RenderedQueryOptions options;
+    std::vector<Tile> tiles;
+
+    // Runs the per-tile queries and merges the results in style layer order.
+    // Bails out with an empty result once the token reads as cancelled.
+    std::vector<Feature> execute(const TaskToken&) const;
+};
+
+// Background actor executing query snapshots on the worker scheduler, so
+// large queries don't stall the map thread.
+class FeatureQueryWorker {
+public:
+    FeatureQueryWorker(ActorRef<FeatureQueryWorker>) {
+    }
+
+    std::vector<Feature> execute(FeatureQuerySnapshot, TaskToken);
+};
+
+} // namespace mbgl
@@ -5,10 +5,13 @@
 #include <mbgl/map/backend_scope.hpp>
 #include <mbgl/map/transform.hpp>
 #include <mbgl/map/transform_state.hpp>
+#include <mbgl/map/session_snapshot.hpp>
 #include <mbgl/annotation/annotation_manager.hpp>
 #include <mbgl/style/style.hpp>
 #include <mbgl/style/source.hpp>
+#include <mbgl/style/source_impl.hpp>
 #include <mbgl/style/layer.hpp>
+#include <mbgl/style/layer_impl.hpp>
 #include <mbgl/style/observer.hpp>
 #include <mbgl/style/transition_options.hpp>
 #include <mbgl/style/update_parameters.hpp>
@@ -17,17 +20,24 @@
 #include <mbgl/storage/resource.hpp>
 #include <mbgl/storage/response.hpp>
 #include <mbgl/util/exception.hpp>
+#include <mbgl/util/image_buffer_pool.hpp>
 #include <mbgl/util/projection.hpp>
 #include <mbgl/util/math.hpp>
 #include <mbgl/util/exception.hpp>
 #include <mbgl/util/async_task.hpp>
 #include <mbgl/util/mapbox.hpp>
 #include <mbgl/util/tile_coordinate.hpp>
+#include <mbgl/util/run_loop.hpp>
+#include <mbgl/map/feature_query.hpp>
+#include <mbgl/actor/actor.hpp>
 #include <mbgl/actor/scheduler.hpp>
 #include <mbgl/util/logging.hpp>
+#include <mbgl/util/startup_timeline.hpp>
 #include <mbgl/util/string.hpp>
 #include <mbgl/math/log2.hpp>
 
+#include <algorithm>
+
 namespace mbgl {
 
 using namespace style;
@@ -70,6 +80,9 @@ public:
     void renderStill();
 
     void loadStyleJSON(const std::string&);
+    void applySessionSnapshot();
+
+    void onFeatureQueryResult(std::vector<Feature>);
 
     Map& map;
     MapObserver& observer;
@@ -100,11 +113,30 @@ public:
 
     std::unique_ptr<AsyncRequest> styleRequest;
 
+    // A restored session snapshot waiting for its style to load; applied (or
+    // dropped, if the style doesn't match) by applySessionSnapshot().
+    optional<SessionSnapshot> pendingSessionSnapshot;
+
     size_t sourceCacheSize;
     bool loading = false;
 
     util::AsyncTask asyncInvalidate;
     std::unique_ptr<StillImageRequest> stillImageRequest;
+
+    // One-shot render state for Map::renderOnce: the frame deadline handed
+    // to the painter, and a flag suppressing the follow-up repaint that the
+    // continuous render path would otherwise schedule.
+    Duration frameBudget = Duration::zero();
+    bool oneShotRender = false;
+
+    // Asynchronous feature query state: a background worker executing query
+    // snapshots on the worker scheduler, a mailbox receiving its replies on
+    // the map thread, and a task scope whose replacement supersedes (cancels)
+    // any still-pending query. All created lazily on the first async query.
+    std::shared_ptr<Mailbox> selfMailbox;
+    std::unique_ptr<Actor<FeatureQueryWorker>> featureQueryWorker;
+    std::unique_ptr<TaskScope> featureQueryScope;
+    Map::QueryFeaturesCallback featureQueryCallback;
 };
 
 Map::Map(Backend& backend,
@@ -222,6 +254,21 @@ void Map::render(View& view) {
     impl->render(view);
 }
 
+bool Map::renderOnce(View& view, Milliseconds budget) {
+    if (!impl->style) {
+        return false;
+    }
+
+    impl->oneShotRender = true;
+    impl->frameBudget = budget;
+    impl->render(view);
+    impl->frameBudget = Duration::zero();
+    impl->oneShotRender = false;
+
+    return impl->style->isLoaded() && !impl->style->hasTransitions() &&
+           impl->painter && !impl->painter->needsAnimation();
+}
+
 void Map::Impl::render(View& view) {
     if (!style) {
         return;
@@ -265,6 +312,14 @@ void Map::Impl::render(View& view) {
 
     style->updateTiles(parameters);
 
+    // Anything beyond a plain repaint can change what arbitrary pixels look
+    // like; the painter's damage tracking needs to know about it.
+    const bool styleChanged = updateFlags & Update::Classes
+        || updateFlags & Update::RecalculateStyle
+        || updateFlags & Update::Layout
+        || updateFlags & Update::AnnotationStyle
+        || updateFlags & Update::AnnotationData;
+
     updateFlags = Update::Nothing;
 
     gl::Context& context = backend.getContext();
@@ -272,7 +327,7 @@ void Map::Impl::render(View& view) {
         painter = std::make_unique<Painter>(context, transform.getState(), pixelRatio, programCacheDir);
     }
 
-    if (mode == MapMode::Continuous) {
+    if (mode == MapMode::Continuous || oneShotRender) {
         if (renderState == RenderState::Never) {
             observer.onWillStartRenderingMap();
         }
@@ -283,7 +338,9 @@ void Map::Impl::render(View& view) {
                               pixelRatio,
                               mode,
                               contextMode,
-                              debugOptions };
+                              debugOptions,
+                              styleChanged,
+                              frameBudget };
 
         backend.updateAssumedState();
 
@@ -303,6 +360,7 @@ void Map::Impl::render(View& view) {
             observer.onDidFinishRenderingMap(MapObserver::RenderMode::Full);
             if (loading) {
                 loading = false;
+                util::markStartupMilestone(StartupMilestone::FirstFrame);
                 observer.onDidFinishLoadingMap();
             }
         }
@@ -314,8 +372,9 @@ void Map::Impl::render(View& view) {
         }
 
         // Only schedule an update if we need to paint another frame due to transitions or
-        // animations that are still in progress
-        if (flags != Update::Nothing) {
+        // animations that are still in progress. One-shot renders never schedule
+        // follow-up frames; the caller polls renderOnce() instead.
+        if (flags != Update::Nothing && !oneShotRender) {
             onUpdate(flags);
         }
     } else if (stillImageRequest && style->isLoaded()) {
@@ -323,7 +382,8 @@ void Map::Impl::render(View& view) {
                               pixelRatio,
                               mode,
                               contextMode,
-                              debugOptions };
+                              debugOptions,
+                              styleChanged };
 
         backend.updateAssumedState();
 
@@ -406,7 +466,12 @@ void Map::setStyleJSON(const std::string& json) {
     impl->styleJSON.clear();
     impl->styleMutated = false;
 
-    impl->style = std::make_unique<Style>(impl->fileSource, impl->pixelRatio);
+    // Keep the existing style object if there is one: Style::setJSON diffs
+    // the incoming JSON against the applied style, so e.g. a theme toggle
+    // that only changes paint values keeps its sources, tiles and buckets.
+    if (!impl->style) {
+        impl->style = std::make_unique<Style>(impl->fileSource, impl->pixelRatio);
+    }
 
     impl->loadStyleJSON(json);
 }
@@ -416,6 +481,8 @@ void Map::Impl::loadStyleJSON(const std::string& json) {
     style->setJSON(json);
     styleJSON = json;
 
+    applySessionSnapshot();
+
     // force style cascade, causing all pending transitions to complete.
     style->cascade(Clock::now(), mode);
 
@@ -438,6 +505,109 @@ std::string Map::getStyleJSON() const {
     return impl->styleJSON;
 }
 
+#pragma mark - Session snapshots
+
+std::string Map::createSessionSnapshot() const {
+    if (!impl->style || !impl->style->loaded) {
+        return {};
+    }
+
+    SessionSnapshot snapshot;
+    snapshot.latLng = getLatLng();
+    snapshot.zoom = getZoom();
+    snapshot.bearing = getBearing();
+    snapshot.pitch = getPitch();
+    snapshot.styleURL = impl->styleURL;
+    snapshot.styleJSONHash = SessionSnapshot::hashJSON(impl->styleJSON);
+
+    for (const Source* source : impl->style->getSources()) {
+        if (source->baseImpl->type != SourceType::Vector) {
+            continue;
+        }
+
+        // Only the source layers the style actually references are worth
+        // carrying over; anything else would be decoded and then discarded
+        // by the next layout.
+        std::vector<std::string> layerNames;
+        for (const Layer* layer : impl->style->getLayers()) {
+            const auto& layerImpl = *layer->baseImpl;
+            if (layerImpl.source == source->baseImpl->id && !layerImpl.sourceLayer.empty() &&
+                std::find(layerNames.begin(), layerNames.end(), layerImpl.sourceLayer) ==
+                    layerNames.end()) {
+                layerNames.push_back(layerImpl.sourceLayer);
+            }
+        }
+        if (layerNames.empty()) {
+            continue;
+        }
+
+        SessionSnapshot::SourceEntry entry;
+        entry.sourceID = source->baseImpl->id;
+        for (auto& tile : source->baseImpl->serializeTileData(layerNames)) {
+            entry.tiles.push_back(SessionSnapshot::TileEntry { tile.first, std::move(tile.second) });
+        }
+        if (!entry.tiles.empty()) {
+            snapshot.sources.push_back(std::move(entry));
+        }
+    }
+
+    return snapshot.encode();
+}
+
+void Map::restoreSessionSnapshot(const std::string& blob) {
+    optional<SessionSnapshot> snapshot = SessionSnapshot::decode(blob);
+    if (!snapshot) {
+        return;
+    }
+
+    // Restore the camera first — the saved tiles cover the saved viewport, so
+    // the seeded data is only useful there. Going through the public setters
+    // marks the camera mutated, so the style's defaults won't later override
+    // the restored position.
+    setZoom(snapshot->zoom);
+    setLatLng(snapshot->latLng);
+    setBearing(snapshot->bearing);
+    setPitch(snapshot->pitch);
+
+    impl->pendingSessionSnapshot = std::move(*snapshot);
+
+    // If a style is already applied, seed right away; otherwise the snapshot
+    // waits for loadStyleJSON.
+    impl->applySessionSnapshot();
+}
+
+void Map::Impl::applySessionSnapshot() {
+    if (!pendingSessionSnapshot || !style || styleJSON.empty()) {
+        return;
+    }
+
+    SessionSnapshot snapshot = std::move(*pendingSessionSnapshot);
+    pendingSessionSnapshot = {};
+
+    // Tiles are only seeded into the style they were serialized against;
+    // accepting either the URL or the JSON content hash covers both the
+    // setStyleURL and setStyleJSON load paths.
+    const bool matchesURL = !snapshot.styleURL.empty() && snapshot.styleURL == styleURL;
+    if (!matchesURL && snapshot.styleJSONHash != SessionSnapshot::hashJSON(styleJSON)) {
+        return;
+    }
+
+    for (auto& sourceEntry : snapshot.sources) {
+        Source* source = style->getSource(sourceEntry.sourceID);
+        if (!source || source->baseImpl->type != SourceType::Vector) {
+            continue;
+        }
+
+        std::map<OverscaledTileID, std::shared_ptr<const std::string>> tiles;
+        for (auto& tile : sourceEntry.tiles) {
+            tiles.emplace(tile.id, std::make_shared<const std::string>(std::move(tile.data)));
+        }
+        source->baseImpl->seedTileData(std::move(tiles));
+    }
+
+    onUpdate(Update::Repaint);
+}
+
 #pragma mark - Transitions
 
 void Map::cancelTransitions() {
@@ -863,6 +1033,17 @@ void Map::removeAnnotation(AnnotationID annotation) {
     impl->onUpdate(Update::AnnotationStyle | Update::AnnotationData);
 }
 
+AnnotationIDs Map::addAnnotations(const std::vector<Annotation>& annotations) {
+    auto result = impl->annotationManager->addAnnotations(annotations, getMaxZoom());
+    impl->onUpdate(Update::AnnotationStyle | Update::AnnotationData);
+    return result;
+}
+
+void Map::removeAnnotations(const AnnotationIDs& annotations) {
+    impl->annotationManager->removeAnnotations(annotations);
+    impl->onUpdate(Update::AnnotationStyle | Update::AnnotationData);
+}
+
 #pragma mark - Feature query api
 
 std::vector<Feature> Map::queryRenderedFeatures(const ScreenCoordinate& point, const RenderedQueryOptions& options) {
@@ -891,21 +1072,66 @@ std::vector<Feature> Map::queryRenderedFeatures(const ScreenBox& box, const Rend
     );
 }
 
-AnnotationIDs Map::queryPointAnnotations(const ScreenBox& box) {
-    RenderedQueryOptions options;
-    options.layerIDs = {{ AnnotationManager::PointLayerID }};
-    auto features = queryRenderedFeatures(box, options);
-    std::set<AnnotationID> set;
-    for (auto &feature : features) {
-        assert(feature.id);
-        assert(feature.id->is<uint64_t>());
-        assert(feature.id->get<uint64_t>() <= std::numeric_limits<AnnotationID>::max());
-        set.insert(static_cast<AnnotationID>(feature.id->get<uint64_t>()));
+void Map::queryRenderedFeatures(const ScreenBox& box, const RenderedQueryOptions& options, QueryFeaturesCallback callback) {
+    if (!callback) {
+        return;
+    }
+    if (!impl->style) {
+        callback({});
+        return;
+    }
+
+    auto snapshot = impl->style->makeQuerySnapshot(
+        {
+            box.min,
+            { box.max.x, box.min.y },
+            box.max,
+            { box.min.x, box.max.y },
+            box.min
+        },
+        impl->transform.getState(),
+        options);
+
+    // Supersede any still-pending query: replacing the scope cancels its
+    // token, dropping both the queued work and the queued reply.
+    impl->featureQueryScope = std::make_unique<TaskScope>();
+    impl->featureQueryCallback = std::move(callback);
+
+    if (!impl->featureQueryWorker) {
+        impl->selfMailbox = std::make_shared<Mailbox>(*util::RunLoop::Get());
+        impl->featureQueryWorker = std::make_unique<Actor<FeatureQueryWorker>>(impl->scheduler);
+    }
+
+    TaskToken token = impl->featureQueryScope->token();
+    impl->featureQueryWorker->self().invokeWithReply(token,
+                                                     ActorRef<Map::Impl>(*impl, impl->selfMailbox),
+                                                     &Map::Impl::onFeatureQueryResult,
+                                                     &FeatureQueryWorker::execute,
+                                                     std::move(snapshot),
+                                                     token);
+}
+
+void Map::Impl::onFeatureQueryResult(std::vector<Feature> result) {
+    if (!featureQueryCallback) {
+        return;
     }
-    AnnotationIDs ids;
-    ids.reserve(set.size());
-    std::move(set.begin(), set.end(), std::back_inserter(ids));
-    return ids;
+    auto callback = std::move(featureQueryCallback);
+    featureQueryCallback = nullptr;
+    callback(std::move(result));
+}
+
+AnnotationIDs Map::queryPointAnnotations(const ScreenBox& box, double radius) {
+    // Hit-test against the annotation manager's R-tree directly instead of
+    // going through the generic rendered-features query. The point layer
+    // renders with allow-overlap, so every point annotation in the box is
+    // visible, and a geographic containment test answers the tap without
+    // scanning tile feature indexes.
+    LatLngBounds bounds = LatLngBounds::empty();
+    bounds.extend(impl->transform.screenCoordinateToLatLng({ box.min.x - radius, box.min.y - radius }));
+    bounds.extend(impl->transform.screenCoordinateToLatLng({ box.max.x + radius, box.min.y - radius }));
+    bounds.extend(impl->transform.screenCoordinateToLatLng({ box.min.x - radius, box.max.y + radius }));
+    bounds.extend(impl->transform.screenCoordinateToLatLng({ box.max.x + radius, box.max.y + radius }));
+    return impl->annotationManager->queryPointAnnotations(bounds);
 }
 
 #pragma mark - Style API
@@ -975,6 +1201,20 @@ std::unique_ptr<Layer> Map::removeLayer(const std::string& id) {
     return removedLayer;
 }
 
+void Map::moveLayer(const std::string& id, const optional<std::string>& before) {
+    if (!impl->style) {
+        return;
+    }
+
+    impl->styleMutated = true;
+
+    // Only the render order changes; Update::Classes keeps damage tracking
+    // honest without queueing any worker-side relayout. The now-empty cascade
+    // batch makes the cascade itself a no-op.
+    impl->style->moveLayer(id, before);
+    impl->onUpdate(Update::Classes);
+}
+
 void Map::addImage(const std::string& name, std::unique_ptr<const SpriteImage> image) {
     if (!impl->style) {
         return;
@@ -1074,6 +1314,43 @@ MapDebugOptions Map::getDebug() const {
     return impl->debugOptions;
 }
 
+std::vector<std::pair<std::string, double>> Map::getGPULayerTimings() const {
+    std::vector<std::pair<std::string, double>> result;
+    if (impl->painter) {
+        const auto& timings = impl->painter->getGPULayerTimings();
+        result.assign(timings.begin(), timings.end());
+    }
+    return result;
+}
+
+RenderStatistics Map::getRenderStatistics() const {
+    return impl->painter ? impl->painter->getRenderStatistics() : RenderStatistics();
+}
+
+TileLatencyStats Map::getTileLatencyStats() const {
+    return util::getTileLatencyStats();
+}
+
+void Map::resetTileLatencyStats() {
+    util::resetTileLatencyStats();
+}
+
+MemoryStats Map::getMemoryStats() const {
+    return util::getMemoryStats();
+}
+
+void Map::resetMemoryPeaks() {
+    util::resetMemoryPeaks();
+}
+
+StartupTimeline Map::getStartupTimeline() const {
+    return util::getStartupTimeline();
+}
+
+void Map::resetStartupTimeline() {
+    util::resetStartupTimeline();
+}
+
 bool Map::isFullyLoaded() const {
     return impl->style ? impl->style->isLoaded() : false;
 }
@@ -1131,6 +1408,7 @@ void Map::setSourceTileCacheSize(size_t size) {
 }
 
 void Map::onLowMemory() {
+    util::shrinkImageBufferPool();
     if (impl->painter) {
         BackendScope guard(impl->backend);
         impl->painter->cleanup();
@@ -0,0 +1,159 @@
+#include <mbgl/map/session_snapshot.hpp>
+
+#include <cstring>
+
+namespace mbgl {
+
+namespace {
+
+// "MBGLSS" + two-digit format version.
+constexpr char magic[8] = { 'M', 'B', 'G', 'L', 'S', 'S', '0', '1' };
+
+class Writer {
+public:
+    template <typename T>
+    void write(T value) {
+        out.append(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+
+    void writeString(const std::string& string) {
+        write<uint32_t>(static_cast<uint32_t>(string.size()));
+        out.append(string);
+    }
+
+    std::string out;
+};
+
+class Reader {
+public:
+    Reader(const char* pos_, const char* end_) : pos(pos_), end(end_) {
+    }
+
+    template <typename T>
+    optional<T> read() {
+        if (end - pos < static_cast<ptrdiff_t>(sizeof(T))) {
+            return {};
+        }
+        T value;
+        std::memcpy(&value, pos, sizeof(T));
+        pos += sizeof(T);
+        return value;
+    }
+
+    optional<std::string> readString() {
+        optional<uint32_t> length = read<uint32_t>();
+        if (!length || end - pos < static_cast<ptrdiff_t>(*length)) {
+            return {};
+        }
+        std::string string(pos, *length);
+        pos += *length;
+        return string;
+    }
+
+private:
+    const char* pos;
+    const char* end;
+};
+
+} // namespace
+
+std::string SessionSnapshot::encode() const {
+    Writer writer;
+    writer.out.append(magic, sizeof(magic));
+
+    writer.write<double>(latLng.latitude);
+    writer.write<double>(latLng.longitude);
+    writer.write<double>(zoom);
+    writer.write<double>(bearing);
+    writer.write<double>(pitch);
+
+    writer.writeString(styleURL);
+    writer.write<uint64_t>(styleJSONHash);
+
+    writer.write<uint32_t>(static_cast<uint32_t>(sources.size()));
+    for (const auto& source : sources) {
+        writer.writeString(source.sourceID);
+        writer.write<uint32_t>(static_cast<uint32_t>(source.tiles.size()));
+        for (const auto& tile : source.tiles) {
+            writer.write<uint8_t>(tile.id.overscaledZ);
+            writer.write<uint8_t>(tile.id.canonical.z);
+            writer.write<uint32_t>(tile.id.canonical.x);
+            writer.write<uint32_t>(tile.id.canonical.y);
+            writer.writeString(tile.data);
+        }
+    }
+
+    return std::move(writer.out);
+}
+
+optional<SessionSnapshot> SessionSnapshot::decode(const std::string& blob) {
+    if (blob.size() < sizeof(magic) || std::memcmp(blob.data(), magic, sizeof(magic)) != 0) {
+        return {};
+    }
+
+    Reader reader(blob.data() + sizeof(magic), blob.data() + blob.size());
+    SessionSnapshot snapshot;
+
+    optional<double> latitude = reader.read<double>();
+    optional<double> longitude = reader.read<double>();
+    optional<double> zoom = reader.read<double>();
+    optional<double> bearing = reader.read<double>();
+    optional<double> pitch = reader.read<double>();
+    if (!latitude || !longitude || !zoom || !bearing || !pitch) {
+        return {};
+    }
+    snapshot.latLng = LatLng(*latitude, *longitude);
+    snapshot.zoom = *zoom;
+    snapshot.bearing = *bearing;
+    snapshot.pitch = *pitch;
+
+    optional<std::string> styleURL = reader.readString();
+    optional<uint64_t> styleJSONHash = reader.read<uint64_t>();
+    if (!styleURL || !styleJSONHash) {
+        return {};
+    }
+    snapshot.styleURL = std::move(*styleURL);
+    snapshot.styleJSONHash = *styleJSONHash;
+
+    optional<uint32_t> sourceCount = reader.read<uint32_t>();
+    if (!sourceCount) {
+        return {};
+    }
+    for (uint32_t i = 0; i < *sourceCount; i++) {
+        optional<std::string> sourceID = reader.readString();
+        optional<uint32_t> tileCount = reader.read<uint32_t>();
+        if (!sourceID || !tileCount) {
+            return {};
+        }
+
+        SourceEntry source;
+        source.sourceID = std::move(*sourceID);
+        source.tiles.reserve(*tileCount);
+        for (uint32_t j = 0; j < *tileCount; j++) {
+            optional<uint8_t> overscaledZ = reader.read<uint8_t>();
+            optional<uint8_t> z = reader.read<uint8_t>();
+            optional<uint32_t> x = reader.read<uint32_t>();
+            optional<uint32_t> y = reader.read<uint32_t>();
+            optional<std::string> data = reader.readString();
+            if (!overscaledZ || !z || !x || !y || !data) {
+                return {};
+            }
+            source.tiles.push_back(
+                TileEntry{ OverscaledTileID(*overscaledZ, *z, *x, *y), std::move(*data) });
+        }
+        snapshot.sources.push_back(std::move(source));
+    }
+
+    return { std::move(snapshot) };
+}
+
+uint64_t SessionSnapshot::hashJSON(const std::string& json) {
+    uint64_t hash = 0xcbf29ce484222325ULL;
+    for (const char c : json) {
+        hash ^= static_cast<uint8_t>(c);
+        hash *= 0x100000001b3ULL;
+    }
+    return hash;
+}
+
+} // namespace mbgl
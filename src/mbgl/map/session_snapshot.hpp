@@ -0,0 +1,62 @@
+#pragma once
+
+#include <mbgl/tile/tile_id.hpp>
+#include <mbgl/util/geo.hpp>
+#include <mbgl/util/optional.hpp>
+
+#include <string>
+#include <vector>
+
+namespace mbgl {
+
+/*
+    A serialized map session: the camera, the identity of the applied style,
+    and the pre-decoded data of the tiles that were loaded when the snapshot
+    was taken.
+
+    Applications persist the blob returned by Map::createSessionSnapshot on
+    teardown and hand it to Map::restoreSessionSnapshot on the next launch.
+    The camera is applied immediately and the tile data is seeded into the
+    style's sources, so the first frame lays out from last session's tiles —
+    no network round trip, no pbf decode — while the regular request path
+    refreshes them behind it.
+
+    Tile payloads use the pre-decoded binary tile format (BinaryTileData),
+    which is style-independent; buckets themselves are not serialized because
+    their contents depend on the style's layout properties and paint binders.
+    The blob is host-endian and versioned by its magic bytes, like the tile
+    format; a blob from a different build layout simply fails to decode.
+*/
+class SessionSnapshot {
+public:
+    struct TileEntry {
+        OverscaledTileID id;
+        std::string data;
+    };
+
+    struct SourceEntry {
+        std::string sourceID;
+        std::vector<TileEntry> tiles;
+    };
+
+    LatLng latLng;
+    double zoom = 0;
+    double bearing = 0;
+    double pitch = 0;
+
+    // Identity of the style the tiles belong to: the URL when the style was
+    // loaded by URL, and a content hash of the JSON either way. Tiles are
+    // only seeded into a style matching one of the two.
+    std::string styleURL;
+    uint64_t styleJSONHash = 0;
+
+    std::vector<SourceEntry> sources;
+
+    std::string encode() const;
+    static optional<SessionSnapshot> decode(const std::string&);
+
+    // Stable (FNV-1a) hash of a style JSON document, usable across sessions.
+    static uint64_t hashJSON(const std::string&);
+};
+
+} // namespace mbgl
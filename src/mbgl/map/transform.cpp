@@ -12,6 +12,8 @@
 #include <mbgl/util/logging.hpp>
 #include <mbgl/util/platform.hpp>
 
+#include <algorithm>
+#include <array>
 #include <cstdio>
 #include <cmath>
 
@@ -37,6 +39,33 @@ static double _normalizeAngle(double angle, double anchorAngle)
     return angle;
 }
 
+namespace {
+
+// Fixed-step samples of an easing curve, taken once when a transition starts.
+// Per-frame evaluation then reduces to a table interpolation, so the cost of
+// advancing a camera animation is a small constant regardless of the curve,
+// instead of UnitBezier's iterative solve.
+class SampledEasing {
+public:
+    explicit SampledEasing(const util::UnitBezier& ease) {
+        for (std::size_t i = 0; i < samples.size(); i++) {
+            samples[i] = ease.solve(double(i) / double(samples.size() - 1), 0.001);
+        }
+    }
+
+    double solve(double t) const {
+        const double x = t * double(samples.size() - 1);
+        const std::size_t i = std::min(static_cast<std::size_t>(x), samples.size() - 2);
+        const double f = x - double(i);
+        return samples[i] * (1.0 - f) + samples[i + 1] * f;
+    }
+
+private:
+    std::array<double, 65> samples;
+};
+
+} // namespace
+
 Transform::Transform(MapObserver& observer_,
                      ConstrainMode constrainMode,
                      ViewportMode viewportMode)
@@ -577,14 +606,15 @@ void Transform::startTransition(const CameraOptions& camera,
     transitionStart = Clock::now();
     transitionDuration = duration;
 
-    transitionFrameFn = [isAnimated, animation, frame, anchor, anchorLatLng, this](const TimePoint now) {
+    const SampledEasing ease { animation.easing ? *animation.easing : util::DEFAULT_TRANSITION_EASE };
+
+    transitionFrameFn = [isAnimated, animation, frame, anchor, anchorLatLng, ease, this](const TimePoint now) {
         float t = isAnimated ? (std::chrono::duration<float>(now - transitionStart) / transitionDuration) : 1.0;
         Update result;
         if (t >= 1.0) {
             result = frame(1.0);
         } else {
-            util::UnitBezier ease = animation.easing ? *animation.easing : util::DEFAULT_TRANSITION_EASE;
-            result = frame(ease.solve(t, 0.001));
+            result = frame(ease.solve(t));
         }
 
         if (anchor) state.moveLatLng(anchorLatLng, *anchor);
@@ -22,6 +22,7 @@ inline uint16_t packUint8Pair(T a, T b) {
 
 MBGL_DEFINE_ATTRIBUTE(int16_t, 2, a_pos);
 MBGL_DEFINE_ATTRIBUTE(int16_t, 2, a_extrude);
+MBGL_DEFINE_ATTRIBUTE(int16_t, 3, a_normal);
 MBGL_DEFINE_ATTRIBUTE(int16_t, 4, a_pos_offset);
 MBGL_DEFINE_ATTRIBUTE(uint16_t, 2, a_texture_pos);
 
@@ -44,29 +45,34 @@ struct a_offset {
 
 // Paint attributes
 
+// Color components are packed into uint8 pairs (see packUint8Pair above), so
+// the attribute data never exceeds the uint16 range and can be stored as
+// uint16 rather than float. The values arrive in the shader unchanged, since
+// non-normalized integer attributes are converted directly to float.
+
 struct a_color {
     static auto name() { return "a_color"; }
-    using Type = gl::Attribute<float, 2>;
+    using Type = gl::Attribute<uint16_t, 2>;
 };
 
 struct a_fill_color {
     static auto name() { return "a_fill_color"; }
-    using Type = gl::Attribute<float, 2>;
+    using Type = gl::Attribute<uint16_t, 2>;
 };
 
 struct a_halo_color {
     static auto name() { return "a_halo_color"; }
-    using Type = gl::Attribute<float, 2>;
+    using Type = gl::Attribute<uint16_t, 2>;
 };
 
 struct a_stroke_color {
     static auto name() { return "a_stroke_color"; }
-    using Type = gl::Attribute<float, 2>;
+    using Type = gl::Attribute<uint16_t, 2>;
 };
 
 struct a_outline_color {
     static auto name() { return "a_outline_color"; }
-    using Type = gl::Attribute<float, 2>;
+    using Type = gl::Attribute<uint16_t, 2>;
 };
 
 struct a_opacity {
@@ -104,6 +110,11 @@ struct a_base {
     using Type = gl::Attribute<float, 1>;
 };
 
+struct a_weight {
+    static auto name() { return "a_weight"; }
+    using Type = gl::Attribute<float, 1>;
+};
+
 struct a_gap_width {
     static auto name() { return "a_gapwidth"; }
     using Type = gl::Attribute<float, 1>;
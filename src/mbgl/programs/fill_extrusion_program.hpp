@@ -0,0 +1,77 @@
+#pragma once
+
+#include <mbgl/programs/program.hpp>
+#include <mbgl/programs/attributes.hpp>
+#include <mbgl/programs/uniforms.hpp>
+#include <mbgl/shaders/fill_extrusion.hpp>
+#include <mbgl/util/geometry.hpp>
+#include <mbgl/util/mat4.hpp>
+#include <mbgl/style/layers/fill_extrusion_layer_properties.hpp>
+
+#include <cmath>
+
+namespace mbgl {
+
+namespace uniforms {
+MBGL_DEFINE_UNIFORM_VECTOR(float, 3, u_lightcolor);
+MBGL_DEFINE_UNIFORM_VECTOR(float, 3, u_lightpos);
+MBGL_DEFINE_UNIFORM_SCALAR(float,    u_lightintensity);
+} // namespace uniforms
+
+struct FillExtrusionLayoutAttributes : gl::Attributes<
+    attributes::a_pos,
+    attributes::a_normal>
+{};
+
+struct FillExtrusionUniforms : gl::Uniforms<
+    uniforms::u_matrix,
+    uniforms::u_opacity,
+    uniforms::u_lightcolor,
+    uniforms::u_lightpos,
+    uniforms::u_lightintensity>
+{};
+
+class FillExtrusionProgram : public Program<
+    shaders::fill_extrusion,
+    gl::Triangle,
+    FillExtrusionLayoutAttributes,
+    FillExtrusionUniforms,
+    style::FillExtrusionPaintProperties>
+{
+public:
+    using Program::Program;
+
+    /*
+     * @param p vertex position
+     * @param nx x component of the face normal
+     * @param ny y component of the face normal
+     * @param nz z component of the face normal
+     * @param t top/bottom selector: 1 places the vertex at the extrusion
+     *        height, 0 at the base
+     *
+     * The normal is flat-shaded, so all four vertices of a wall quad carry
+     * the same one. It is scaled by 2^14 to use the full int16 range; the
+     * lowest bit of the x component smuggles `t`, which the vertex shader
+     * recovers with mod(x, 2.0).
+     */
+    static LayoutVertex layoutVertex(Point<int16_t> p, double nx, double ny, double nz, unsigned short t) {
+        const auto factor = std::pow(2, 13);
+
+        return LayoutVertex {
+            {{
+                p.x,
+                p.y
+            }},
+            {{
+                static_cast<int16_t>(std::floor(nx * factor) * 2 + t),
+                static_cast<int16_t>(ny * factor * 2),
+                static_cast<int16_t>(nz * factor * 2)
+            }}
+        };
+    }
+};
+
+using FillExtrusionLayoutVertex = FillExtrusionProgram::LayoutVertex;
+using FillExtrusionAttributes = FillExtrusionProgram::Attributes;
+
+} // namespace mbgl
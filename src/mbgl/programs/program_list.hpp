@@ -0,0 +1,67 @@
+#pragma once
+
+#include <mbgl/programs/circle_program.hpp>
+#include <mbgl/programs/fill_program.hpp>
+#include <mbgl/programs/fill_extrusion_program.hpp>
+#include <mbgl/programs/line_program.hpp>
+#include <mbgl/programs/raster_program.hpp>
+#include <mbgl/programs/symbol_program.hpp>
+#include <mbgl/programs/debug_program.hpp>
+#include <mbgl/programs/collision_box_program.hpp>
+#include <mbgl/util/type_list.hpp>
+
+namespace mbgl {
+
+// The set of shader programs that Programs instantiates. Embedded builds can
+// define MBGL_PROGRAM_LIST to a TypeList of the programs their styles
+// actually use; Programs members for omitted programs collapse to empty
+// stubs whose draw() is a no-op, so neither the program template
+// instantiation nor the startup shader compile is paid for, and layers that
+// would need a pruned program simply don't render. FillProgram and
+// DebugProgram are used by the renderer itself (clipping masks and debug
+// overlays) and belong in every list.
+#ifndef MBGL_PROGRAM_LIST
+#define MBGL_PROGRAM_LIST                                                        \
+    ::mbgl::TypeList<::mbgl::CircleProgram,                                      \
+                     ::mbgl::FillProgram,                                        \
+                     ::mbgl::FillPatternProgram,                                 \
+                     ::mbgl::FillOutlineProgram,                                 \
+                     ::mbgl::FillOutlinePatternProgram,                          \
+                     ::mbgl::FillExtrusionProgram,                               \
+                     ::mbgl::LineProgram,                                        \
+                     ::mbgl::LineSDFProgram,                                     \
+                     ::mbgl::LinePatternProgram,                                 \
+                     ::mbgl::RasterProgram,                                      \
+                     ::mbgl::SymbolIconProgram,                                  \
+                     ::mbgl::SymbolSDFIconProgram,                               \
+                     ::mbgl::SymbolSDFTextProgram,                               \
+                     ::mbgl::DebugProgram,                                       \
+                     ::mbgl::CollisionBoxProgram>
+#endif
+
+using ProgramList = MBGL_PROGRAM_LIST;
+
+template <class P, bool = TypeListContains<ProgramList, P>::value>
+class ProgramHolder;
+
+// The program is part of the build's program list: behave exactly like it.
+template <class P>
+class ProgramHolder<P, true> : public P {
+public:
+    using P::P;
+};
+
+// The program was pruned from the build's program list: accept and discard
+// draw calls without ever instantiating the program template.
+template <class P>
+class ProgramHolder<P, false> {
+public:
+    ProgramHolder(gl::Context&, const ProgramParameters&) {
+    }
+
+    template <class... Args>
+    void draw(Args&&...) {
+    }
+};
+
+} // namespace mbgl
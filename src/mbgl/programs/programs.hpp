@@ -2,11 +2,13 @@
 
 #include <mbgl/programs/circle_program.hpp>
 #include <mbgl/programs/fill_program.hpp>
+#include <mbgl/programs/fill_extrusion_program.hpp>
 #include <mbgl/programs/line_program.hpp>
 #include <mbgl/programs/raster_program.hpp>
 #include <mbgl/programs/symbol_program.hpp>
 #include <mbgl/programs/debug_program.hpp>
 #include <mbgl/programs/collision_box_program.hpp>
+#include <mbgl/programs/program_list.hpp>
 #include <mbgl/programs/program_parameters.hpp>
 
 namespace mbgl {
@@ -19,6 +21,7 @@ public:
           fillPattern(context, programParameters),
           fillOutline(context, programParameters),
           fillOutlinePattern(context, programParameters),
+          fillExtrusion(context, programParameters),
           line(context, programParameters),
           lineSDF(context, programParameters),
           linePattern(context, programParameters),
@@ -30,21 +33,22 @@ public:
           collisionBox(context, ProgramParameters(programParameters.pixelRatio, false, programParameters.cacheDir)) {
     }
 
-    CircleProgram circle;
-    FillProgram fill;
-    FillPatternProgram fillPattern;
-    FillOutlineProgram fillOutline;
-    FillOutlinePatternProgram fillOutlinePattern;
-    LineProgram line;
-    LineSDFProgram lineSDF;
-    LinePatternProgram linePattern;
-    RasterProgram raster;
-    SymbolIconProgram symbolIcon;
-    SymbolSDFIconProgram symbolIconSDF;
-    SymbolSDFTextProgram symbolGlyph;
+    ProgramHolder<CircleProgram> circle;
+    ProgramHolder<FillProgram> fill;
+    ProgramHolder<FillPatternProgram> fillPattern;
+    ProgramHolder<FillOutlineProgram> fillOutline;
+    ProgramHolder<FillOutlinePatternProgram> fillOutlinePattern;
+    ProgramHolder<FillExtrusionProgram> fillExtrusion;
+    ProgramHolder<LineProgram> line;
+    ProgramHolder<LineSDFProgram> lineSDF;
+    ProgramHolder<LinePatternProgram> linePattern;
+    ProgramHolder<RasterProgram> raster;
+    ProgramHolder<SymbolIconProgram> symbolIcon;
+    ProgramHolder<SymbolSDFIconProgram> symbolIconSDF;
+    ProgramHolder<SymbolSDFTextProgram> symbolGlyph;
 
-    DebugProgram debug;
-    CollisionBoxProgram collisionBox;
+    ProgramHolder<DebugProgram> debug;
+    ProgramHolder<CollisionBoxProgram> collisionBox;
 };
 
 } // namespace mbgl
@@ -54,7 +54,7 @@ Values makeValues(const bool isText,
         uniforms::u_texsize::Value{ std::array<float, 2> {{ float(texsize.width) / 4, float(texsize.height) / 4 }} },
         uniforms::u_zoom::Value{ float(state.getZoom()) },
         uniforms::u_rotate_with_map::Value{ values.rotationAlignment == AlignmentType::Map },
-        uniforms::u_texture::Value{ 0 },
+        uniforms::u_texture::Value{ static_cast<gl::TextureUnit>(isText ? 2 : 0) },
         uniforms::u_fadetexture::Value{ 1 },
         uniforms::u_is_text::Value{ isText },
         std::forward<Args>(args)...
@@ -105,7 +105,8 @@ typename SymbolSDFProgram<PaintProperties>::UniformValues SymbolSDFProgram<Paint
         uniforms::u_bearing::Value{ -1.0f * state.getAngle() },
         uniforms::u_aspect_ratio::Value{ (state.getSize().width * 1.0f) / (state.getSize().height * 1.0f) },
         uniforms::u_pitch_with_map::Value{ values.pitchAlignment == AlignmentType::Map },
-        uniforms::u_is_halo::Value{ part == SymbolSDFPart::Halo }
+        uniforms::u_is_halo::Value{ part == SymbolSDFPart::Halo },
+        uniforms::u_is_combined::Value{ part == SymbolSDFPart::Combined }
     );
 }
 
@@ -35,6 +35,7 @@ MBGL_DEFINE_UNIFORM_SCALAR(gl::TextureUnit, u_texture);
 MBGL_DEFINE_UNIFORM_SCALAR(gl::TextureUnit, u_fadetexture);
 MBGL_DEFINE_UNIFORM_SCALAR(float, u_aspect_ratio);
 MBGL_DEFINE_UNIFORM_SCALAR(bool, u_is_halo);
+MBGL_DEFINE_UNIFORM_SCALAR(bool, u_is_combined);
 MBGL_DEFINE_UNIFORM_SCALAR(float, u_gamma_scale);
 
 MBGL_DEFINE_UNIFORM_SCALAR(bool, u_is_text);
@@ -412,7 +413,10 @@ public:
 
 enum class SymbolSDFPart {
     Fill = 1,
-    Halo = 0
+    Halo = 0,
+    // Halo and fill composited from one distance sample in a single draw;
+    // only valid when the two colors are constant and identical.
+    Combined = 2
 };
 
 template <class PaintProperties>
@@ -434,7 +438,8 @@ class SymbolSDFProgram : public SymbolProgram<
         uniforms::u_bearing,
         uniforms::u_aspect_ratio,
         uniforms::u_pitch_with_map,
-        uniforms::u_is_halo>,
+        uniforms::u_is_halo,
+        uniforms::u_is_combined>,
     PaintProperties>
 {
 public:
@@ -455,7 +460,8 @@ public:
             uniforms::u_bearing,
             uniforms::u_aspect_ratio,
             uniforms::u_pitch_with_map,
-            uniforms::u_is_halo>,
+            uniforms::u_is_halo,
+            uniforms::u_is_combined>,
         PaintProperties>;
     
     using UniformValues = typename BaseProgram::UniformValues;
@@ -1,17 +1,17 @@
 #pragma once
 
 #include <mbgl/renderer/render_pass.hpp>
+#include <mbgl/style/feature_state.hpp>
 #include <mbgl/util/noncopyable.hpp>
 #include <mbgl/tile/geometry_tile_data.hpp>
 
 #include <atomic>
+#include <mutex>
+#include <utility>
+#include <vector>
 
 namespace mbgl {
 
-class Painter;
-class PaintParameters;
-class RenderTile;
-
 namespace gl {
 class Context;
 } // namespace gl
@@ -32,18 +32,86 @@ public:
     // this only happens once when the bucket is being rendered for the first time.
     virtual void upload(gl::Context&) = 0;
 
-    // Every time this bucket is getting rendered, this function is called. This happens either
-    // once or twice (for Opaque and Transparent render passes).
-    virtual void render(Painter&, PaintParameters&, const style::Layer&, const RenderTile&) = 0;
-
     virtual bool hasData() const = 0;
 
+    // Approximate number of bytes upload() will transfer to the GPU. The
+    // painter uses this to spread uploads across frames.
+    virtual std::size_t uploadByteSize() const {
+        return 0;
+    }
+
+    // Approximate total bytes of vertex/index storage this bucket holds,
+    // regardless of which side of the upload they are on: before upload()
+    // they live in CPU-side vectors, afterwards in GL buffers of the same
+    // size. Tiles sum this for cache accounting.
+    std::size_t getMemoryUsage() const {
+        return uploadedByteSize + uploadByteSize();
+    }
+
+    // Whether this bucket's geometry is known to cover the entire tile extent,
+    // e.g. an ocean polygon clipped to the whole tile. The painter uses this to
+    // cull opaque draws that are completely hidden behind such a bucket.
+    virtual bool coversTile() const {
+        return false;
+    }
+
+    // Number of vertices currently in the bucket's layout vertex vector. Only
+    // meaningful while the bucket is being built on the worker, before the
+    // vertices are moved to the GPU by upload().
+    virtual std::size_t vertexCount() const {
+        return 0;
+    }
+
+    // When a relayout reuses this bucket's geometry (same layout key), the
+    // data-driven paint values baked into the per-feature attribute buffers
+    // may nonetheless have changed. stagePaintBinders() rebuilds the paint
+    // property binders on the worker, re-evaluating the given layers against
+    // the features recorded as (feature index, vertex count) entries, and
+    // stages the result. commitStagedPaintBinders() swaps the staged binders
+    // in; it runs on the tile's thread when the layout result is received, so
+    // the foreground never does per-feature work. Buckets without data-driven
+    // paint properties ignore both calls.
+    virtual void stagePaintBinders(const std::vector<const style::Layer*>&,
+                                   const GeometryTileLayer&,
+                                   const std::vector<std::pair<std::size_t, std::size_t>>&) {}
+    virtual void commitStagedPaintBinders() {}
+
+    // Re-evaluates data-driven paint values for the features whose state
+    // appears in the map and rewrites just their vertex ranges, in place or
+    // as buffer sub-uploads — no relayout. Runs on the thread that renders.
+    // Buckets without data-driven paint properties ignore the call.
+    virtual void updateFeatureStates(const style::FeatureStates&,
+                                     const GeometryTileLayer&,
+                                     gl::Context&) {}
+
+    // Vertex range each feature's attribute values occupy, recorded by the
+    // worker as the bucket is built; updateFeatureStates uses it to find the
+    // range belonging to a feature id. Only features with numeric ids are
+    // recorded, since feature state is keyed by id.
+    class FeatureVertexRange {
+    public:
+        uint64_t id;            // the feature's numeric id
+        std::size_t index;      // its position within the source layer
+        std::size_t begin;      // first vertex
+        std::size_t end;        // one past the last vertex
+    };
+    std::vector<FeatureVertexRange> featureVertexRanges;
+
     bool needsUpload() const {
         return !uploaded;
     }
 
 protected:
     std::atomic<bool> uploaded { false };
+
+    // Bytes moved into GL buffers by upload(); implementations add
+    // uploadByteSize() before moving their vectors out so getMemoryUsage()
+    // keeps counting the storage after it becomes GPU-resident.
+    std::size_t uploadedByteSize = 0;
+
+    // Guards the staged binder set of buckets that support rebinding; the
+    // active binders are only ever touched on the thread that renders.
+    std::mutex stagedPaintBindersMutex;
 };
 
 } // namespace mbgl
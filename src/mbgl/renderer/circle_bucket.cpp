@@ -1,5 +1,4 @@
 #include <mbgl/renderer/circle_bucket.hpp>
-#include <mbgl/renderer/painter.hpp>
 #include <mbgl/programs/circle_program.hpp>
 #include <mbgl/style/bucket_parameters.hpp>
 #include <mbgl/style/layers/circle_layer.hpp>
@@ -11,7 +10,8 @@ namespace mbgl {
 using namespace style;
 
 CircleBucket::CircleBucket(const BucketParameters& parameters, const std::vector<const Layer*>& layers)
-    : mode(parameters.mode) {
+    : mode(parameters.mode),
+      zoom(parameters.tileID.overscaledZ) {
     for (const auto& layer : layers) {
         paintPropertyBinders.emplace(
             std::piecewise_construct,
@@ -23,8 +23,15 @@ CircleBucket::CircleBucket(const BucketParameters& parameters, const std::vector
 }
 
 void CircleBucket::upload(gl::Context& context) {
-    vertexBuffer = context.createVertexBuffer(std::move(vertices));
-    indexBuffer = context.createIndexBuffer(std::move(triangles));
+    uploadedByteSize += uploadByteSize();
+
+    // Committing staged paint binders resets `uploaded` to get the new binder
+    // buffers onto the GPU; the layout buffers were moved out by the first
+    // upload and must not be recreated.
+    if (!vertexBuffer) {
+        vertexBuffer = context.createVertexBuffer(std::move(vertices));
+        indexBuffer = context.createIndexBuffer(std::move(triangles));
+    }
 
     for (auto& pair : paintPropertyBinders) {
         pair.second.upload(context);
@@ -33,11 +40,68 @@ void CircleBucket::upload(gl::Context& context) {
     uploaded = true;
 }
 
-void CircleBucket::render(Painter& painter,
-                        PaintParameters& parameters,
-                        const Layer& layer,
-                        const RenderTile& tile) {
-    painter.renderCircle(parameters, *this, *layer.as<CircleLayer>(), tile);
+std::size_t CircleBucket::vertexCount() const {
+    return vertices.vertexSize();
+}
+
+void CircleBucket::stagePaintBinders(const std::vector<const Layer*>& layers,
+                                     const GeometryTileLayer& geometryLayer,
+                                     const std::vector<std::pair<std::size_t, std::size_t>>& entries) {
+    std::map<std::string, CircleProgram::PaintPropertyBinders> staged;
+    for (const auto& layer : layers) {
+        staged.emplace(
+            std::piecewise_construct,
+            std::forward_as_tuple(layer->getID()),
+            std::forward_as_tuple(
+                layer->as<CircleLayer>()->impl->paint.evaluated,
+                zoom));
+    }
+
+    for (const auto& entry : entries) {
+        std::unique_ptr<GeometryTileFeature> feature = geometryLayer.getFeature(entry.first);
+        for (auto& pair : staged) {
+            pair.second.populateVertexVectors(*feature, entry.second);
+        }
+    }
+
+    for (auto it = staged.begin(); it != staged.end(); ++it) {
+        for (auto prev = staged.begin(); prev != it; ++prev) {
+            it->second.shareVertexVectorsWith(prev->second);
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(stagedPaintBindersMutex);
+    stagedPaintPropertyBinders = std::move(staged);
+}
+
+void CircleBucket::updateFeatureStates(const FeatureStates& states,
+                                       const GeometryTileLayer& geometryLayer,
+                                       gl::Context& context) {
+    for (const auto& range : featureVertexRanges) {
+        auto it = states.find(range.id);
+        if (it == states.end()) {
+            continue;
+        }
+        std::unique_ptr<GeometryTileFeature> feature = geometryLayer.getFeature(range.index);
+        FeatureStateFeature stateFeature(*feature, it->second);
+        for (auto& pair : paintPropertyBinders) {
+            pair.second.updateVertexRanges(stateFeature, range.begin, range.end, context);
+        }
+    }
+}
+
+void CircleBucket::commitStagedPaintBinders() {
+    std::lock_guard<std::mutex> lock(stagedPaintBindersMutex);
+    if (stagedPaintPropertyBinders.empty()) {
+        return;
+    }
+    paintPropertyBinders = std::move(stagedPaintPropertyBinders);
+    stagedPaintPropertyBinders.clear();
+    uploaded = false;
+}
+
+std::size_t CircleBucket::uploadByteSize() const {
+    return vertices.byteSize() + triangles.byteSize();
 }
 
 bool CircleBucket::hasData() const {
@@ -22,9 +22,19 @@ public:
     void addFeature(const GeometryTileFeature&,
                     const GeometryCollection&) override;
     bool hasData() const override;
+    std::size_t uploadByteSize() const override;
+    std::size_t vertexCount() const override;
+
+    void stagePaintBinders(const std::vector<const style::Layer*>&,
+                           const GeometryTileLayer&,
+                           const std::vector<std::pair<std::size_t, std::size_t>>&) override;
+    void commitStagedPaintBinders() override;
+
+    void updateFeatureStates(const style::FeatureStates&,
+                             const GeometryTileLayer&,
+                             gl::Context&) override;
 
     void upload(gl::Context&) override;
-    void render(Painter&, PaintParameters&, const style::Layer&, const RenderTile&) override;
 
     gl::VertexVector<CircleLayoutVertex> vertices;
     gl::IndexVector<gl::Triangles> triangles;
@@ -36,6 +46,10 @@ public:
     std::map<std::string, CircleProgram::PaintPropertyBinders> paintPropertyBinders;
 
     const MapMode mode;
+    const float zoom;
+
+private:
+    std::map<std::string, CircleProgram::PaintPropertyBinders> stagedPaintPropertyBinders;
 };
 
 } // namespace mbgl
@@ -1,13 +1,18 @@
 #include <mbgl/renderer/fill_bucket.hpp>
-#include <mbgl/renderer/painter.hpp>
 #include <mbgl/programs/fill_program.hpp>
 #include <mbgl/style/bucket_parameters.hpp>
 #include <mbgl/style/layers/fill_layer.hpp>
 #include <mbgl/style/layers/fill_layer_impl.hpp>
+#include <mbgl/util/constants.hpp>
 
 #include <mapbox/earcut.hpp>
 
+#include <algorithm>
 #include <cassert>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
 
 namespace mapbox {
 namespace util {
@@ -25,9 +30,120 @@ namespace mbgl {
 
 using namespace style;
 
+namespace {
+
+// Detects the common "clipped to the whole tile" polygon: a rectangular outer
+// ring whose bounding box contains the tile extent. Anything fancier would
+// amount to real coverage analysis, so non-rectangular rings are never treated
+// as covering.
+bool ringCoversTile(const GeometryCoordinates& ring) {
+    std::size_t size = ring.size();
+    if (size > 1 && ring.front() == ring.back()) {
+        size--;
+    }
+    if (size != 4) {
+        return false;
+    }
+
+    GeometryCoordinate min = ring[0];
+    GeometryCoordinate max = ring[0];
+    for (std::size_t i = 1; i < size; i++) {
+        min.x = std::min(min.x, ring[i].x);
+        min.y = std::min(min.y, ring[i].y);
+        max.x = std::max(max.x, ring[i].x);
+        max.y = std::max(max.y, ring[i].y);
+    }
+
+    if (min.x > 0 || min.y > 0 || max.x < util::EXTENT || max.y < util::EXTENT) {
+        return false;
+    }
+
+    // All four bounding box corners must be present for the ring to actually
+    // be that rectangle.
+    bool corners[2][2] = {{ false, false }, { false, false }};
+    for (std::size_t i = 0; i < size; i++) {
+        if ((ring[i].x != min.x && ring[i].x != max.x) ||
+            (ring[i].y != min.y && ring[i].y != max.y)) {
+            return false;
+        }
+        corners[ring[i].x == max.x][ring[i].y == max.y] = true;
+    }
+    return corners[0][0] && corners[0][1] && corners[1][0] && corners[1][1];
+}
+
+// Tessellating a large multipolygon can take upwards of 10ms, and the same
+// geometry is tessellated again for every overzoomed child tile that reuses
+// the parent's data. Since earcut's output only depends on the ring
+// coordinates, its triangle indices are cached process-wide, keyed by a 64-bit
+// FNV-1a fingerprint of the polygon; each entry keeps its ring data so a hit
+// is verified exactly rather than trusted to the hash. Only polygons above a
+// vertex threshold are cached: for small ones, hashing costs about as much as
+// tessellating.
+class TessellationCache {
+public:
+    static constexpr std::size_t minimumVertices = 256;
+    static constexpr std::size_t maximumEntries = 128;
+
+    using Indices = std::shared_ptr<const std::vector<uint32_t>>;
+
+    static uint64_t key(const GeometryCollection& polygon) {
+        uint64_t hash = 0xcbf29ce484222325ULL;
+        const auto update = [&] (uint64_t value) {
+            hash ^= value;
+            hash *= 0x100000001b3ULL;
+        };
+        for (const auto& ring : polygon) {
+            update(ring.size());
+            for (const auto& point : ring) {
+                update(static_cast<uint16_t>(point.x) | (static_cast<uint64_t>(static_cast<uint16_t>(point.y)) << 16));
+            }
+        }
+        return hash;
+    }
+
+    Indices get(uint64_t key_, const GeometryCollection& polygon) {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = entries.find(key_);
+        // The key is a bare hash, so a hit is only trusted once the stored
+        // ring data matches: a collision must never hand a feature another
+        // feature's triangles.
+        return it != entries.end() && it->second.polygon == polygon ? it->second.indices : nullptr;
+    }
+
+    void put(uint64_t key_, GeometryCollection polygon, Indices indices) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (entries.size() >= maximumEntries) {
+            entries.erase(entries.find(insertionOrder.front()));
+            insertionOrder.pop_front();
+        }
+        if (entries.emplace(key_, Entry { std::move(polygon), std::move(indices) }).second) {
+            insertionOrder.push_back(key_);
+        }
+    }
+
+private:
+    struct Entry {
+        GeometryCollection polygon;
+        Indices indices;
+    };
+
+    std::mutex mutex;
+    std::unordered_map<uint64_t, Entry> entries;
+    std::deque<uint64_t> insertionOrder;
+};
+
+TessellationCache& tessellationCache() {
+    static TessellationCache cache;
+    return cache;
+}
+
+} // namespace
+
 struct GeometryTooLongException : std::exception {};
 
-FillBucket::FillBucket(const BucketParameters& parameters, const std::vector<const Layer*>& layers) {
+FillBucket::FillBucket(const BucketParameters& parameters, const std::vector<const Layer*>& layers)
+    : zoom(parameters.tileID.overscaledZ),
+      token(parameters.token) {
     for (const auto& layer : layers) {
         paintPropertyBinders.emplace(
             std::piecewise_construct,
@@ -41,9 +157,20 @@ FillBucket::FillBucket(const BucketParameters& parameters, const std::vector<con
 void FillBucket::addFeature(const GeometryTileFeature& feature,
                             const GeometryCollection& geometry) {
     for (auto& polygon : classifyRings(geometry)) {
+        // A multipolygon can take tens of milliseconds to tessellate; if the
+        // tile was abandoned mid-feature, the partial bucket is discarded
+        // with it, so bail rather than finish.
+        if (token.cancelled()) {
+            return;
+        }
+
         // Optimize polygons with many interior rings for earcut tesselation.
         limitHoles(polygon, 500);
 
+        if (!tileCovered && polygon.size() == 1 && ringCoversTile(polygon[0])) {
+            tileCovered = true;
+        }
+
         std::size_t totalVertices = 0;
 
         for (const auto& ring : polygon) {
@@ -80,9 +207,19 @@ void FillBucket::addFeature(const GeometryTileFeature& feature,
             lineSegment.indexLength += nVertices * 2;
         }
 
-        std::vector<uint32_t> indices = mapbox::earcut(polygon);
+        TessellationCache::Indices indices;
+        if (totalVertices >= TessellationCache::minimumVertices) {
+            const uint64_t key = TessellationCache::key(polygon);
+            indices = tessellationCache().get(key, polygon);
+            if (!indices) {
+                indices = std::make_shared<const std::vector<uint32_t>>(mapbox::earcut(polygon));
+                tessellationCache().put(key, polygon, indices);
+            }
+        } else {
+            indices = std::make_shared<const std::vector<uint32_t>>(mapbox::earcut(polygon));
+        }
 
-        std::size_t nIndicies = indices.size();
+        std::size_t nIndicies = indices->size();
         assert(nIndicies % 3 == 0);
 
         if (triangleSegments.empty() || triangleSegments.back().vertexLength + totalVertices > std::numeric_limits<uint16_t>::max()) {
@@ -94,9 +231,9 @@ void FillBucket::addFeature(const GeometryTileFeature& feature,
         uint16_t triangleIndex = triangleSegment.vertexLength;
 
         for (uint32_t i = 0; i < nIndicies; i += 3) {
-            triangles.emplace_back(triangleIndex + indices[i],
-                                   triangleIndex + indices[i + 1],
-                                   triangleIndex + indices[i + 2]);
+            triangles.emplace_back(triangleIndex + (*indices)[i],
+                                   triangleIndex + (*indices)[i + 1],
+                                   triangleIndex + (*indices)[i + 2]);
         }
 
         triangleSegment.vertexLength += totalVertices;
@@ -109,9 +246,16 @@ void FillBucket::addFeature(const GeometryTileFeature& feature,
 }
 
 void FillBucket::upload(gl::Context& context) {
-    vertexBuffer = context.createVertexBuffer(std::move(vertices));
-    lineIndexBuffer = context.createIndexBuffer(std::move(lines));
-    triangleIndexBuffer = context.createIndexBuffer(std::move(triangles));
+    uploadedByteSize += uploadByteSize();
+
+    // Committing staged paint binders resets `uploaded` to get the new binder
+    // buffers onto the GPU; the layout buffers were moved out by the first
+    // upload and must not be recreated.
+    if (!vertexBuffer) {
+        vertexBuffer = context.createVertexBuffer(std::move(vertices));
+        lineIndexBuffer = context.createIndexBuffer(std::move(lines));
+        triangleIndexBuffer = context.createIndexBuffer(std::move(triangles));
+    }
 
     for (auto& pair : paintPropertyBinders) {
         pair.second.upload(context);
@@ -120,15 +264,79 @@ void FillBucket::upload(gl::Context& context) {
     uploaded = true;
 }
 
-void FillBucket::render(Painter& painter,
-                        PaintParameters& parameters,
-                        const Layer& layer,
-                        const RenderTile& tile) {
-    painter.renderFill(parameters, *this, *layer.as<FillLayer>(), tile);
+std::size_t FillBucket::vertexCount() const {
+    return vertices.vertexSize();
+}
+
+void FillBucket::stagePaintBinders(const std::vector<const Layer*>& layers,
+                                   const GeometryTileLayer& geometryLayer,
+                                   const std::vector<std::pair<std::size_t, std::size_t>>& entries) {
+    std::map<std::string, FillProgram::PaintPropertyBinders> staged;
+    for (const auto& layer : layers) {
+        staged.emplace(
+            std::piecewise_construct,
+            std::forward_as_tuple(layer->getID()),
+            std::forward_as_tuple(
+                layer->as<FillLayer>()->impl->paint.evaluated,
+                zoom));
+    }
+
+    for (const auto& entry : entries) {
+        std::unique_ptr<GeometryTileFeature> feature = geometryLayer.getFeature(entry.first);
+        for (auto& pair : staged) {
+            pair.second.populateVertexVectors(*feature, entry.second);
+        }
+    }
+
+    // Styled layers over the same features often differ only in filters or
+    // constant properties, leaving their data-driven buffers byte-identical;
+    // collapse those onto shared slabs before publishing the staged set.
+    for (auto it = staged.begin(); it != staged.end(); ++it) {
+        for (auto prev = staged.begin(); prev != it; ++prev) {
+            it->second.shareVertexVectorsWith(prev->second);
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(stagedPaintBindersMutex);
+    stagedPaintPropertyBinders = std::move(staged);
+}
+
+void FillBucket::updateFeatureStates(const FeatureStates& states,
+                                     const GeometryTileLayer& geometryLayer,
+                                     gl::Context& context) {
+    for (const auto& range : featureVertexRanges) {
+        auto it = states.find(range.id);
+        if (it == states.end()) {
+            continue;
+        }
+        std::unique_ptr<GeometryTileFeature> feature = geometryLayer.getFeature(range.index);
+        FeatureStateFeature stateFeature(*feature, it->second);
+        for (auto& pair : paintPropertyBinders) {
+            pair.second.updateVertexRanges(stateFeature, range.begin, range.end, context);
+        }
+    }
+}
+
+void FillBucket::commitStagedPaintBinders() {
+    std::lock_guard<std::mutex> lock(stagedPaintBindersMutex);
+    if (stagedPaintPropertyBinders.empty()) {
+        return;
+    }
+    paintPropertyBinders = std::move(stagedPaintPropertyBinders);
+    stagedPaintPropertyBinders.clear();
+    uploaded = false;
 }
 
 bool FillBucket::hasData() const {
     return !triangleSegments.empty() || !lineSegments.empty();
 }
 
+bool FillBucket::coversTile() const {
+    return tileCovered;
+}
+
+std::size_t FillBucket::uploadByteSize() const {
+    return vertices.byteSize() + lines.byteSize() + triangles.byteSize();
+}
+
 } // namespace mbgl
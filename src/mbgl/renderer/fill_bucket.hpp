@@ -1,5 +1,6 @@
 #pragma once
 
+#include <mbgl/actor/task.hpp>
 #include <mbgl/renderer/bucket.hpp>
 #include <mbgl/tile/geometry_tile_data.hpp>
 #include <mbgl/gl/vertex_buffer.hpp>
@@ -23,9 +24,20 @@ public:
     void addFeature(const GeometryTileFeature&,
                     const GeometryCollection&) override;
     bool hasData() const override;
+    bool coversTile() const override;
+    std::size_t uploadByteSize() const override;
+    std::size_t vertexCount() const override;
+
+    void stagePaintBinders(const std::vector<const style::Layer*>&,
+                           const GeometryTileLayer&,
+                           const std::vector<std::pair<std::size_t, std::size_t>>&) override;
+    void commitStagedPaintBinders() override;
+
+    void updateFeatureStates(const style::FeatureStates&,
+                             const GeometryTileLayer&,
+                             gl::Context&) override;
 
     void upload(gl::Context&) override;
-    void render(Painter&, PaintParameters&, const style::Layer&, const RenderTile&) override;
 
     gl::VertexVector<FillLayoutVertex> vertices;
     gl::IndexVector<gl::Lines> lines;
@@ -38,6 +50,12 @@ public:
     optional<gl::IndexBuffer<gl::Triangles>> triangleIndexBuffer;
 
     std::map<std::string, FillProgram::PaintPropertyBinders> paintPropertyBinders;
+
+private:
+    std::map<std::string, FillProgram::PaintPropertyBinders> stagedPaintPropertyBinders;
+    const float zoom;
+    const TaskToken token;
+    bool tileCovered = false;
 };
 
 } // namespace mbgl
@@ -0,0 +1,249 @@
+#include <mbgl/renderer/fill_extrusion_bucket.hpp>
+#include <mbgl/programs/fill_extrusion_program.hpp>
+#include <mbgl/style/bucket_parameters.hpp>
+#include <mbgl/style/layers/fill_extrusion_layer.hpp>
+#include <mbgl/style/layers/fill_extrusion_layer_impl.hpp>
+#include <mbgl/util/constants.hpp>
+#include <mbgl/util/math.hpp>
+
+#include <mapbox/earcut.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <memory>
+
+namespace mapbox {
+namespace util {
+template <> struct nth<0, mbgl::GeometryCoordinate> {
+    static int64_t get(const mbgl::GeometryCoordinate& t) { return t.x; };
+};
+
+template <> struct nth<1, mbgl::GeometryCoordinate> {
+    static int64_t get(const mbgl::GeometryCoordinate& t) { return t.y; };
+};
+} // namespace util
+} // namespace mapbox
+
+namespace mbgl {
+
+using namespace style;
+
+namespace {
+
+// An axis-aligned edge outside the tile extent is where the clip cut the
+// polygon, not a real wall: the neighboring tile renders the actual geometry
+// there, so emitting the cross-section would only waste vertices.
+bool isBoundaryEdge(const GeometryCoordinate& p1, const GeometryCoordinate& p2) {
+    return (p1.x == p2.x && (p1.x < 0 || p1.x > util::EXTENT)) ||
+           (p1.y == p2.y && (p1.y < 0 || p1.y > util::EXTENT));
+}
+
+} // namespace
+
+struct GeometryTooLongException : std::exception {};
+
+FillExtrusionBucket::FillExtrusionBucket(const BucketParameters& parameters, const std::vector<const Layer*>& layers)
+    : zoom(parameters.tileID.overscaledZ),
+      token(parameters.token) {
+    for (const auto& layer : layers) {
+        paintPropertyBinders.emplace(
+            std::piecewise_construct,
+            std::forward_as_tuple(layer->getID()),
+            std::forward_as_tuple(
+                layer->as<FillExtrusionLayer>()->impl->paint.evaluated,
+                parameters.tileID.overscaledZ));
+    }
+}
+
+void FillExtrusionBucket::addFeature(const GeometryTileFeature& feature,
+                                     const GeometryCollection& geometry) {
+    for (auto& polygon : classifyRings(geometry)) {
+        // Extruded footprints tessellate like fills; drop out mid-feature if
+        // the tile was abandoned, as the partial bucket is discarded with it.
+        if (token.cancelled()) {
+            return;
+        }
+
+        // Optimize polygons with many interior rings for earcut tesselation.
+        limitHoles(polygon, 500);
+
+        std::size_t totalVertices = 0;
+
+        for (const auto& ring : polygon) {
+            totalVertices += ring.size();
+            if (totalVertices > std::numeric_limits<uint16_t>::max())
+                throw GeometryTooLongException();
+        }
+
+        // Walls. Each ring edge becomes one quad whose four vertices are
+        // shared by its two triangles — per-face emission would cost six
+        // vertices per quad. The quads of one edge cannot share vertices with
+        // the next edge's because the flat-shaded normal differs per edge.
+        for (const auto& ring : polygon) {
+            std::size_t nVertices = ring.size();
+            if (nVertices < 2)
+                continue;
+
+            for (std::size_t i = 0; i < nVertices; i++) {
+                const GeometryCoordinate& p1 = ring[i];
+                const GeometryCoordinate& p2 = ring[(i + 1) % nVertices];
+
+                if (p1 == p2 || isBoundaryEdge(p1, p2)) {
+                    continue;
+                }
+
+                // Flat-shaded normal: the edge's unit perpendicular, shared
+                // by all four vertices of the quad.
+                const double dx = p2.x - p1.x;
+                const double dy = p2.y - p1.y;
+                const double length = std::sqrt(dx * dx + dy * dy);
+                const double nx = -dy / length;
+                const double ny = dx / length;
+
+                if (triangleSegments.empty() || triangleSegments.back().vertexLength + 4 > std::numeric_limits<uint16_t>::max()) {
+                    triangleSegments.emplace_back(vertices.vertexSize(), triangles.indexSize());
+                }
+
+                auto& segment = triangleSegments.back();
+                assert(segment.vertexLength <= std::numeric_limits<uint16_t>::max());
+                uint16_t index = segment.vertexLength;
+
+                vertices.emplace_back(FillExtrusionProgram::layoutVertex(p1, nx, ny, 0, 0));
+                vertices.emplace_back(FillExtrusionProgram::layoutVertex(p1, nx, ny, 0, 1));
+                vertices.emplace_back(FillExtrusionProgram::layoutVertex(p2, nx, ny, 0, 0));
+                vertices.emplace_back(FillExtrusionProgram::layoutVertex(p2, nx, ny, 0, 1));
+
+                triangles.emplace_back(index, index + 1, index + 2);
+                triangles.emplace_back(index + 1, index + 2, index + 3);
+
+                segment.vertexLength += 4;
+                segment.indexLength += 6;
+            }
+        }
+
+        // Roof. Every ring vertex is emitted exactly once with the up normal
+        // and shared between all triangles earcut assigns it to.
+        if (triangleSegments.empty() || triangleSegments.back().vertexLength + totalVertices > std::numeric_limits<uint16_t>::max()) {
+            triangleSegments.emplace_back(vertices.vertexSize(), triangles.indexSize());
+        }
+
+        auto& roofSegment = triangleSegments.back();
+        assert(roofSegment.vertexLength <= std::numeric_limits<uint16_t>::max());
+        uint16_t roofIndex = roofSegment.vertexLength;
+
+        for (const auto& ring : polygon) {
+            for (const auto& p : ring) {
+                vertices.emplace_back(FillExtrusionProgram::layoutVertex(p, 0, 0, 1, 1));
+            }
+        }
+
+        std::vector<uint32_t> indices = mapbox::earcut(polygon);
+
+        std::size_t nIndicies = indices.size();
+        assert(nIndicies % 3 == 0);
+
+        for (uint32_t i = 0; i < nIndicies; i += 3) {
+            triangles.emplace_back(roofIndex + indices[i],
+                                   roofIndex + indices[i + 1],
+                                   roofIndex + indices[i + 2]);
+        }
+
+        roofSegment.vertexLength += totalVertices;
+        roofSegment.indexLength += nIndicies;
+    }
+
+    for (auto& pair : paintPropertyBinders) {
+        pair.second.populateVertexVectors(feature, vertices.vertexSize());
+    }
+}
+
+void FillExtrusionBucket::upload(gl::Context& context) {
+    uploadedByteSize += uploadByteSize();
+
+    // Committing staged paint binders resets `uploaded` to get the new binder
+    // buffers onto the GPU; the layout buffers were moved out by the first
+    // upload and must not be recreated.
+    if (!vertexBuffer) {
+        vertexBuffer = context.createVertexBuffer(std::move(vertices));
+        triangleIndexBuffer = context.createIndexBuffer(std::move(triangles));
+    }
+
+    for (auto& pair : paintPropertyBinders) {
+        pair.second.upload(context);
+    }
+
+    uploaded = true;
+}
+
+std::size_t FillExtrusionBucket::vertexCount() const {
+    return vertices.vertexSize();
+}
+
+void FillExtrusionBucket::stagePaintBinders(const std::vector<const Layer*>& layers,
+                                            const GeometryTileLayer& geometryLayer,
+                                            const std::vector<std::pair<std::size_t, std::size_t>>& entries) {
+    std::map<std::string, FillExtrusionProgram::PaintPropertyBinders> staged;
+    for (const auto& layer : layers) {
+        staged.emplace(
+            std::piecewise_construct,
+            std::forward_as_tuple(layer->getID()),
+            std::forward_as_tuple(
+                layer->as<FillExtrusionLayer>()->impl->paint.evaluated,
+                zoom));
+    }
+
+    for (const auto& entry : entries) {
+        std::unique_ptr<GeometryTileFeature> feature = geometryLayer.getFeature(entry.first);
+        for (auto& pair : staged) {
+            pair.second.populateVertexVectors(*feature, entry.second);
+        }
+    }
+
+    // Styled layers over the same features often differ only in filters or
+    // constant properties, leaving their data-driven buffers byte-identical;
+    // collapse those onto shared slabs before publishing the staged set.
+    for (auto it = staged.begin(); it != staged.end(); ++it) {
+        for (auto prev = staged.begin(); prev != it; ++prev) {
+            it->second.shareVertexVectorsWith(prev->second);
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(stagedPaintBindersMutex);
+    stagedPaintPropertyBinders = std::move(staged);
+}
+
+void FillExtrusionBucket::updateFeatureStates(const FeatureStates& states,
+                                              const GeometryTileLayer& geometryLayer,
+                                              gl::Context& context) {
+    for (const auto& range : featureVertexRanges) {
+        auto it = states.find(range.id);
+        if (it == states.end()) {
+            continue;
+        }
+        std::unique_ptr<GeometryTileFeature> feature = geometryLayer.getFeature(range.index);
+        FeatureStateFeature stateFeature(*feature, it->second);
+        for (auto& pair : paintPropertyBinders) {
+            pair.second.updateVertexRanges(stateFeature, range.begin, range.end, context);
+        }
+    }
+}
+
+void FillExtrusionBucket::commitStagedPaintBinders() {
+    std::lock_guard<std::mutex> lock(stagedPaintBindersMutex);
+    if (stagedPaintPropertyBinders.empty()) {
+        return;
+    }
+    paintPropertyBinders = std::move(stagedPaintPropertyBinders);
+    stagedPaintPropertyBinders.clear();
+    uploaded = false;
+}
+
+bool FillExtrusionBucket::hasData() const {
+    return !triangleSegments.empty();
+}
+
+std::size_t FillExtrusionBucket::uploadByteSize() const {
+    return vertices.byteSize() + triangles.byteSize();
+}
+
+} // namespace mbgl
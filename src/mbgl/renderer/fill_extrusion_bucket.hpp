@@ -0,0 +1,56 @@
+#pragma once
+
+#include <mbgl/actor/task.hpp>
+#include <mbgl/renderer/bucket.hpp>
+#include <mbgl/tile/geometry_tile_data.hpp>
+#include <mbgl/gl/vertex_buffer.hpp>
+#include <mbgl/gl/index_buffer.hpp>
+#include <mbgl/gl/segment.hpp>
+#include <mbgl/programs/fill_extrusion_program.hpp>
+#include <mbgl/style/layers/fill_extrusion_layer_properties.hpp>
+
+#include <vector>
+
+namespace mbgl {
+
+namespace style {
+class BucketParameters;
+} // namespace style
+
+class FillExtrusionBucket : public Bucket {
+public:
+    FillExtrusionBucket(const style::BucketParameters&, const std::vector<const style::Layer*>&);
+
+    void addFeature(const GeometryTileFeature&,
+                    const GeometryCollection&) override;
+    bool hasData() const override;
+    std::size_t uploadByteSize() const override;
+    std::size_t vertexCount() const override;
+
+    void stagePaintBinders(const std::vector<const style::Layer*>&,
+                           const GeometryTileLayer&,
+                           const std::vector<std::pair<std::size_t, std::size_t>>&) override;
+    void commitStagedPaintBinders() override;
+
+    void updateFeatureStates(const style::FeatureStates&,
+                             const GeometryTileLayer&,
+                             gl::Context&) override;
+
+    void upload(gl::Context&) override;
+
+    gl::VertexVector<FillExtrusionLayoutVertex> vertices;
+    gl::IndexVector<gl::Triangles> triangles;
+    gl::SegmentVector<FillExtrusionAttributes> triangleSegments;
+
+    optional<gl::VertexBuffer<FillExtrusionLayoutVertex>> vertexBuffer;
+    optional<gl::IndexBuffer<gl::Triangles>> triangleIndexBuffer;
+
+    std::map<std::string, FillExtrusionProgram::PaintPropertyBinders> paintPropertyBinders;
+
+private:
+    std::map<std::string, FillExtrusionProgram::PaintPropertyBinders> stagedPaintPropertyBinders;
+    const float zoom;
+    const TaskToken token;
+};
+
+} // namespace mbgl
@@ -0,0 +1,162 @@
+#include <mbgl/renderer/frame_damage.hpp>
+
+#include <mbgl/util/constants.hpp>
+
+#include <algorithm>
+#include <cmath>
+
+namespace mbgl {
+
+constexpr std::size_t FrameDamage::maximumHistory;
+
+void FrameDamage::Box::extend(const Box& other) {
+    if (other.empty()) {
+        return;
+    }
+    x0 = std::min(x0, other.x0);
+    y0 = std::min(y0, other.y0);
+    x1 = std::max(x1, other.x1);
+    y1 = std::max(y1, other.y1);
+}
+
+FrameDamage::Box FrameDamage::boxForTile(const mat4& tileMatrix) {
+    const Box fullViewport { -1.0, -1.0, 1.0, 1.0 };
+
+    Box box;
+    const double corners[4][2] = {
+        { 0, 0 },
+        { util::EXTENT, 0 },
+        { 0, util::EXTENT },
+        { util::EXTENT, util::EXTENT },
+    };
+    for (const auto& corner : corners) {
+        const vec4 position {{ corner[0], corner[1], 0, 1 }};
+        vec4 clip;
+        matrix::transformMat4(clip, position, tileMatrix);
+        if (clip[3] <= 0) {
+            // A corner behind the camera makes the projected quad unbounded.
+            return fullViewport;
+        }
+        const Box projected { clip[0] / clip[3], clip[1] / clip[3],
+                              clip[0] / clip[3], clip[1] / clip[3] };
+        box.extend(projected);
+    }
+
+    box.x0 = std::max(box.x0, -1.0);
+    box.y0 = std::max(box.y0, -1.0);
+    box.x1 = std::min(box.x1, 1.0);
+    box.y1 = std::min(box.y1, 1.0);
+    return box;
+}
+
+void FrameDamage::beginFrame(const mat4& projMatrix, bool fullDamage) {
+    frameFullyDamaged = fullDamage || projMatrix != previousProjMatrix;
+    previousProjMatrix = projMatrix;
+    changedBox = Box();
+    tiles.clear();
+}
+
+void FrameDamage::addTile(const UnwrappedTileID& id, const mat4& tileMatrix, bool changed) {
+    // Tiles are recorded even in fully damaged frames so that the next frame
+    // can tell which of them are new.
+    auto it = tiles.find(id);
+    if (it == tiles.end()) {
+        it = tiles.emplace(id, boxForTile(tileMatrix)).first;
+    }
+    if (changed && !frameFullyDamaged) {
+        changedBox.extend(it->second);
+    }
+}
+
+FrameDamage::Damage FrameDamage::currentDamage() const {
+    if (frameFullyDamaged) {
+        return { true, {} };
+    }
+
+    Damage damage { false, changedBox };
+
+    // A tile entering or leaving the render order exposes pixels that were
+    // previously covered by something else (or by nothing at all).
+    for (const auto& tile : tiles) {
+        if (previousTiles.find(tile.first) == previousTiles.end()) {
+            damage.box.extend(tile.second);
+        }
+    }
+    for (const auto& tile : previousTiles) {
+        if (tiles.find(tile.first) == tiles.end()) {
+            damage.box.extend(tile.second);
+        }
+    }
+
+    return damage;
+}
+
+optional<FrameDamage::Region> FrameDamage::scissorRegion(uint32_t bufferAge,
+                                                         const Size& framebufferSize) const {
+    if (bufferAge == 0 || bufferAge - 1 > history.size()) {
+        return {};
+    }
+
+    Damage damage = currentDamage();
+    for (uint32_t i = 0; i < bufferAge - 1 && !damage.full; i++) {
+        damage.full |= history[i].full;
+        damage.box.extend(history[i].box);
+    }
+    if (damage.full) {
+        return {};
+    }
+    if (damage.box.empty()) {
+        return Region { 0, 0, { 0, 0 } };
+    }
+
+    // One pixel of slack on each side absorbs rasterization differences along
+    // the box edges.
+    const int32_t x0 = std::max<int32_t>(
+        std::floor((damage.box.x0 + 1.0) / 2.0 * framebufferSize.width) - 1, 0);
+    const int32_t y0 = std::max<int32_t>(
+        std::floor((damage.box.y0 + 1.0) / 2.0 * framebufferSize.height) - 1, 0);
+    const int32_t x1 = std::min<int32_t>(
+        std::ceil((damage.box.x1 + 1.0) / 2.0 * framebufferSize.width) + 1, framebufferSize.width);
+    const int32_t y1 = std::min<int32_t>(
+        std::ceil((damage.box.y1 + 1.0) / 2.0 * framebufferSize.height) + 1, framebufferSize.height);
+
+    return Region { x0, y0, { static_cast<uint32_t>(x1 - x0), static_cast<uint32_t>(y1 - y0) } };
+}
+
+bool FrameDamage::tileIntersects(const UnwrappedTileID& id,
+                                 const Region& region,
+                                 const Size& framebufferSize) const {
+    const auto it = tiles.find(id);
+    if (it == tiles.end()) {
+        return true;
+    }
+    const Box& box = it->second;
+    if (box.empty()) {
+        // Clamping to the viewport left nothing; the tile is offscreen.
+        return false;
+    }
+
+    // The same one pixel of slack that scissorRegion applies, so a tile is
+    // never culled out of a region it contributed to.
+    const double x0 = std::floor((box.x0 + 1.0) / 2.0 * framebufferSize.width) - 1;
+    const double y0 = std::floor((box.y0 + 1.0) / 2.0 * framebufferSize.height) - 1;
+    const double x1 = std::ceil((box.x1 + 1.0) / 2.0 * framebufferSize.width) + 1;
+    const double y1 = std::ceil((box.y1 + 1.0) / 2.0 * framebufferSize.height) + 1;
+
+    return x0 < region.x + static_cast<double>(region.size.width) &&
+           x1 > region.x &&
+           y0 < region.y + static_cast<double>(region.size.height) &&
+           y1 > region.y;
+}
+
+void FrameDamage::endFrame() {
+    history.emplace_front(currentDamage());
+    if (history.size() > maximumHistory) {
+        history.pop_back();
+    }
+
+    previousTiles = std::move(tiles);
+    tiles.clear();
+}
+
+} // namespace mbgl
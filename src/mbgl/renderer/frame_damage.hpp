@@ -0,0 +1,91 @@
+#pragma once
+
+#include <mbgl/tile/tile_id.hpp>
+#include <mbgl/util/mat4.hpp>
+#include <mbgl/util/optional.hpp>
+#include <mbgl/util/size.hpp>
+
+#include <deque>
+#include <map>
+
+namespace mbgl {
+
+// Tracks which parts of the framebuffer actually change from frame to frame,
+// so that surfaces reporting a buffer age (EGL_EXT_buffer_age and friends) can
+// be repainted with a scissor rect instead of in full. Damage is recorded as
+// tile bounding boxes in normalized device coordinates; anything that can
+// touch arbitrary pixels — a camera move, a style mutation, symbol fading —
+// marks the whole frame damaged instead.
+class FrameDamage {
+public:
+    // A scissor rect in framebuffer coordinates (origin bottom-left).
+    struct Region {
+        int32_t x;
+        int32_t y;
+        Size size;
+    };
+
+    // Starts a new frame. `fullDamage` marks the entire framebuffer as
+    // changed. A change of the projection matrix implies full damage as well,
+    // since recorded regions are only meaningful for a fixed camera.
+    void beginFrame(const mat4& projMatrix, bool fullDamage);
+
+    // Records a tile drawn this frame. `changed` is whether its contents
+    // differ from the previous frame, e.g. because freshly loaded data was
+    // uploaded. Tiles that appear in or disappear from the render order
+    // between frames are treated as changed implicitly.
+    void addTile(const UnwrappedTileID&, const mat4& tileMatrix, bool changed);
+
+    // Returns the framebuffer region that changed since the currently bound
+    // buffer was last presented, i.e. this frame's damage unioned with that of
+    // the previous `bufferAge - 1` frames. nullopt means the full framebuffer
+    // must be repainted, either because the buffer age is unknown (zero or
+    // older than the recorded history) or because one of the frames involved
+    // was fully damaged.
+    optional<Region> scissorRegion(uint32_t bufferAge, const Size& framebufferSize) const;
+
+    // Whether a tile recorded this frame can touch pixels inside the given
+    // scissor region. Draws for tiles entirely outside of it cannot change any
+    // pixel and can be skipped. Tiles that were not recorded count as
+    // intersecting.
+    bool tileIntersects(const UnwrappedTileID&, const Region&, const Size& framebufferSize) const;
+
+    // Finishes the frame, pushing its damage onto the history.
+    void endFrame();
+
+private:
+    // An axis-aligned bounding box in normalized device coordinates,
+    // initialized to empty.
+    struct Box {
+        double x0 = 1.0;
+        double y0 = 1.0;
+        double x1 = -1.0;
+        double y1 = -1.0;
+
+        void extend(const Box&);
+        bool empty() const {
+            return x1 < x0 || y1 < y0;
+        }
+    };
+
+    struct Damage {
+        bool full;
+        Box box;
+    };
+
+    static Box boxForTile(const mat4& tileMatrix);
+    Damage currentDamage() const;
+
+    mat4 previousProjMatrix {{ 0 }};
+    bool frameFullyDamaged = true;
+    Box changedBox;
+    std::map<UnwrappedTileID, Box> tiles;
+    std::map<UnwrappedTileID, Box> previousTiles;
+
+    // Damage of recently presented frames, most recent first. Buffer ages
+    // beyond this window fall back to a full repaint.
+    std::deque<Damage> history;
+    static constexpr std::size_t maximumHistory = 8;
+};
+
+} // namespace mbgl
@@ -36,18 +36,21 @@ void FrameHistory::record(const TimePoint& now, float zoom, const Duration& dura
         }
     }
 
+    // Only mark the texture dirty when an opacity value actually changed.
+    // Outside of an active fade the ramp is stable, so re-uploading it every
+    // frame would be wasted work.
     for (int16_t z = 0; z <= 255; z++) {
         std::chrono::duration<float> timeDiff = now - changeTimes[z];
         int32_t opacityChange = (duration == Milliseconds(0) ? 1 : (timeDiff / duration)) * 255;
-        if (z <= zoomIndex) {
-            opacities.data[z] = util::min(255, changeOpacities[z] + opacityChange);
-        } else {
-            opacities.data[z] = util::max(0, changeOpacities[z] - opacityChange);
+        const uint8_t opacity = z <= zoomIndex
+            ? util::min(255, changeOpacities[z] + opacityChange)
+            : util::max(0, changeOpacities[z] - opacityChange);
+        if (opacities.data[z] != opacity) {
+            opacities.data[z] = opacity;
+            dirty = true;
         }
     }
 
-    dirty = true;
-
     if (zoomIndex != previousZoomIndex) {
         previousZoomIndex = zoomIndex;
         previousTime = now;
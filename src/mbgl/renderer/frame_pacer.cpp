@@ -0,0 +1,39 @@
+#include <mbgl/renderer/frame_pacer.hpp>
+
+#include <algorithm>
+
+namespace mbgl {
+
+constexpr double FramePacer::minimumScale;
+
+// 60 Hz budget. Measuring the actual display refresh rate would need platform
+// hooks; 16 ms is the case we care about on every target.
+static const Duration targetFrameTime = Milliseconds(16);
+
+void FramePacer::beginFrame() {
+    frameStart = Clock::now();
+}
+
+void FramePacer::endFrame() {
+    const Duration frameTime = Clock::now() - frameStart;
+
+    // Exponential smoothing, so that a single hitch (shader compilation, a
+    // driver sync point) doesn't collapse quality for the frames that follow.
+    if (smoothedFrameTime == Duration::zero()) {
+        smoothedFrameTime = frameTime;
+    } else {
+        smoothedFrameTime = (smoothedFrameTime * 7 + frameTime) / 8;
+    }
+
+    if (smoothedFrameTime > targetFrameTime) {
+        const double ratio = std::chrono::duration<double>(targetFrameTime) /
+                             std::chrono::duration<double>(smoothedFrameTime);
+        scale = std::max(minimumScale, scale * ratio);
+    } else {
+        // Recover gradually; restoring all deferred work in one frame would
+        // itself blow the budget.
+        scale = std::min(1.0, scale * 1.25);
+    }
+}
+
+} // namespace mbgl
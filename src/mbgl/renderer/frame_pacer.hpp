@@ -0,0 +1,30 @@
+#pragma once
+
+#include <mbgl/util/chrono.hpp>
+
+namespace mbgl {
+
+// Tracks how long recent frames took on the render thread and derives a scale
+// factor for discretionary per-frame work. When frames run past the target
+// budget during animation, the scale drops so optional work (like bucket
+// uploads) is spread over more frames; when frames come in under budget again,
+// the scale recovers and full quality is restored.
+class FramePacer {
+public:
+    void beginFrame();
+    void endFrame();
+
+    // Multiplier in [minimumScale, 1] for discretionary per-frame work.
+    double workScale() const {
+        return scale;
+    }
+
+private:
+    static constexpr double minimumScale = 0.25;
+
+    TimePoint frameStart;
+    Duration smoothedFrameTime = Duration::zero();
+    double scale = 1.0;
+};
+
+} // namespace mbgl
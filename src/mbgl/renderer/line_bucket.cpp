@@ -1,5 +1,4 @@
 #include <mbgl/renderer/line_bucket.hpp>
-#include <mbgl/renderer/painter.hpp>
 #include <mbgl/style/layers/line_layer.hpp>
 #include <mbgl/style/bucket_parameters.hpp>
 #include <mbgl/style/layers/line_layer_impl.hpp>
@@ -16,6 +15,7 @@ LineBucket::LineBucket(const BucketParameters& parameters,
                        const std::vector<const Layer*>& layers,
                        const style::LineLayoutProperties& layout_)
     : layout(layout_.evaluate(PropertyEvaluationParameters(parameters.tileID.overscaledZ))),
+      zoom(parameters.tileID.overscaledZ),
       overscaling(parameters.tileID.overscaleFactor()) {
     for (const auto& layer : layers) {
         paintPropertyBinders.emplace(
@@ -82,6 +82,23 @@ void LineBucket::addGeometry(const GeometryCoordinates& coordinates, FeatureType
 
     const double sharpCornerOffset = SHARP_CORNER_OFFSET * (float(util::EXTENT) / (util::tileSize * overscaling));
 
+    // Structure-of-arrays pre-pass: every segment's unit normal is computed up
+    // front in one tight loop over the coordinate array. The join/cap loop
+    // below is dominated by branching, so hoisting the sqrt-heavy normal math
+    // out of it gives the compiler a straight-line kernel it can vectorize,
+    // and computes each normal exactly once.
+    std::vector<double> normalX(len - 1);
+    std::vector<double> normalY(len - 1);
+    for (std::size_t i = 0; i + 1 < len; ++i) {
+        const double dx = double(coordinates[i + 1].x) - coordinates[i].x;
+        const double dy = double(coordinates[i + 1].y) - coordinates[i].y;
+        const double mag = std::sqrt(dx * dx + dy * dy);
+        const double inv = mag != 0 ? 1.0 / mag : 0.0;
+        // The perpendicular of the unit direction vector.
+        normalX[i] = -dy * inv;
+        normalY[i] = dx * inv;
+    }
+
     const GeometryCoordinate firstCoordinate = coordinates.front();
     const LineCapType beginCap = layout.get<LineCap>();
     const LineCapType endCap = type == FeatureType::Polygon ? LineCapType::Butt : LineCapType(layout.get<LineCap>());
@@ -131,11 +148,17 @@ void LineBucket::addGeometry(const GeometryCoordinates& coordinates, FeatureType
 
         currentCoordinate = coordinates[i];
 
-        // Calculate the normal towards the next vertex in this line. In case
-        // there is no next vertex, pretend that the line is continuing straight,
+        // Look up the normal towards the next vertex in this line. The closing
+        // segment of a polygon connects back to coordinates[1] and isn't part
+        // of the precomputed arrays, so it is computed in place. In case there
+        // is no next vertex, pretend that the line is continuing straight,
         // meaning that we are just using the previous normal.
-        nextNormal = nextCoordinate ? util::perp(util::unit(convertPoint<double>(*nextCoordinate - *currentCoordinate)))
-                                : prevNormal;
+        nextNormal = nextCoordinate
+                         ? (i + 1 < len
+                                ? Point<double> { normalX[i], normalY[i] }
+                                : util::perp(util::unit(
+                                      convertPoint<double>(*nextCoordinate - *currentCoordinate))))
+                         : prevNormal;
 
         // If we still don't have a previous normal, this is the beginning of a
         // non-closed line, so we're doing a straight "join".
@@ -439,8 +462,15 @@ void LineBucket::addPieSliceVertex(const GeometryCoordinate& currentVertex,
 }
 
 void LineBucket::upload(gl::Context& context) {
-    vertexBuffer = context.createVertexBuffer(std::move(vertices));
-    indexBuffer = context.createIndexBuffer(std::move(triangles));
+    uploadedByteSize += uploadByteSize();
+
+    // Committing staged paint binders resets `uploaded` to get the new binder
+    // buffers onto the GPU; the layout buffers were moved out by the first
+    // upload and must not be recreated.
+    if (!vertexBuffer) {
+        vertexBuffer = context.createVertexBuffer(std::move(vertices));
+        indexBuffer = context.createIndexBuffer(std::move(triangles));
+    }
 
     for (auto& pair : paintPropertyBinders) {
         pair.second.upload(context);
@@ -449,11 +479,68 @@ void LineBucket::upload(gl::Context& context) {
     uploaded = true;
 }
 
-void LineBucket::render(Painter& painter,
-                        PaintParameters& parameters,
-                        const Layer& layer,
-                        const RenderTile& tile) {
-    painter.renderLine(parameters, *this, *layer.as<LineLayer>(), tile);
+std::size_t LineBucket::vertexCount() const {
+    return vertices.vertexSize();
+}
+
+void LineBucket::stagePaintBinders(const std::vector<const Layer*>& layers,
+                                   const GeometryTileLayer& geometryLayer,
+                                   const std::vector<std::pair<std::size_t, std::size_t>>& entries) {
+    std::map<std::string, LineProgram::PaintPropertyBinders> staged;
+    for (const auto& layer : layers) {
+        staged.emplace(
+            std::piecewise_construct,
+            std::forward_as_tuple(layer->getID()),
+            std::forward_as_tuple(
+                layer->as<LineLayer>()->impl->paint.evaluated,
+                zoom));
+    }
+
+    for (const auto& entry : entries) {
+        std::unique_ptr<GeometryTileFeature> feature = geometryLayer.getFeature(entry.first);
+        for (auto& pair : staged) {
+            pair.second.populateVertexVectors(*feature, entry.second);
+        }
+    }
+
+    for (auto it = staged.begin(); it != staged.end(); ++it) {
+        for (auto prev = staged.begin(); prev != it; ++prev) {
+            it->second.shareVertexVectorsWith(prev->second);
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(stagedPaintBindersMutex);
+    stagedPaintPropertyBinders = std::move(staged);
+}
+
+void LineBucket::updateFeatureStates(const FeatureStates& states,
+                                     const GeometryTileLayer& geometryLayer,
+                                     gl::Context& context) {
+    for (const auto& range : featureVertexRanges) {
+        auto it = states.find(range.id);
+        if (it == states.end()) {
+            continue;
+        }
+        std::unique_ptr<GeometryTileFeature> feature = geometryLayer.getFeature(range.index);
+        FeatureStateFeature stateFeature(*feature, it->second);
+        for (auto& pair : paintPropertyBinders) {
+            pair.second.updateVertexRanges(stateFeature, range.begin, range.end, context);
+        }
+    }
+}
+
+void LineBucket::commitStagedPaintBinders() {
+    std::lock_guard<std::mutex> lock(stagedPaintBindersMutex);
+    if (stagedPaintPropertyBinders.empty()) {
+        return;
+    }
+    paintPropertyBinders = std::move(stagedPaintPropertyBinders);
+    stagedPaintPropertyBinders.clear();
+    uploaded = false;
+}
+
+std::size_t LineBucket::uploadByteSize() const {
+    return vertices.byteSize() + triangles.byteSize();
 }
 
 bool LineBucket::hasData() const {
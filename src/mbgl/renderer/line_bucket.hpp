@@ -25,9 +25,19 @@ public:
     void addFeature(const GeometryTileFeature&,
                     const GeometryCollection&) override;
     bool hasData() const override;
+    std::size_t uploadByteSize() const override;
+    std::size_t vertexCount() const override;
+
+    void stagePaintBinders(const std::vector<const style::Layer*>&,
+                           const GeometryTileLayer&,
+                           const std::vector<std::pair<std::size_t, std::size_t>>&) override;
+    void commitStagedPaintBinders() override;
+
+    void updateFeatureStates(const style::FeatureStates&,
+                             const GeometryTileLayer&,
+                             gl::Context&) override;
 
     void upload(gl::Context&) override;
-    void render(Painter&, PaintParameters&, const style::Layer&, const RenderTile&) override;
 
     style::LineLayoutProperties::PossiblyEvaluated layout;
 
@@ -41,6 +51,9 @@ public:
     std::map<std::string, LineProgram::PaintPropertyBinders> paintPropertyBinders;
 
 private:
+    std::map<std::string, LineProgram::PaintPropertyBinders> stagedPaintPropertyBinders;
+    const float zoom;
+
     void addGeometry(const GeometryCoordinates&, FeatureType);
 
     struct TriangleElement {
@@ -5,10 +5,19 @@ namespace mbgl {
 class Programs;
 class View;
 
+namespace util {
+class Arena;
+} // namespace util
+
 class PaintParameters {
 public:
     Programs& programs;
     View& view;
+
+    // Frame-scoped bump allocator for render-loop transients. Owned by the
+    // Painter so its chunks survive across frames; reset before each frame.
+    // Anything allocated from it must not outlive the frame.
+    util::Arena& frameArena;
 };
 
 } // namespace mbgl
@@ -1,6 +1,12 @@
 #include <mbgl/renderer/painter.hpp>
 #include <mbgl/renderer/paint_parameters.hpp>
 #include <mbgl/renderer/render_tile.hpp>
+#include <mbgl/renderer/circle_bucket.hpp>
+#include <mbgl/renderer/fill_bucket.hpp>
+#include <mbgl/renderer/fill_extrusion_bucket.hpp>
+#include <mbgl/renderer/line_bucket.hpp>
+#include <mbgl/renderer/raster_bucket.hpp>
+#include <mbgl/renderer/symbol_bucket.hpp>
 
 #include <mbgl/style/source.hpp>
 #include <mbgl/style/source_impl.hpp>
@@ -8,12 +14,23 @@
 #include <mbgl/map/view.hpp>
 
 #include <mbgl/util/logging.hpp>
+#include <mbgl/util/startup_timeline.hpp>
+#include <mbgl/util/tile_latency.hpp>
+#include <mbgl/util/trace.hpp>
 #include <mbgl/gl/debugging.hpp>
+#include <mbgl/gl/timer_query_extension.hpp>
 
 #include <mbgl/style/style.hpp>
 #include <mbgl/style/layer_impl.hpp>
 
 #include <mbgl/style/layers/background_layer.hpp>
+#include <mbgl/style/layers/circle_layer.hpp>
+#include <mbgl/style/layers/fill_layer.hpp>
+#include <mbgl/style/layers/fill_layer_impl.hpp>
+#include <mbgl/style/layers/fill_extrusion_layer.hpp>
+#include <mbgl/style/layers/line_layer.hpp>
+#include <mbgl/style/layers/raster_layer.hpp>
+#include <mbgl/style/layers/symbol_layer.hpp>
 #include <mbgl/style/layers/custom_layer.hpp>
 #include <mbgl/style/layers/custom_layer_impl.hpp>
 
@@ -38,12 +55,18 @@
 #include <cassert>
 #include <algorithm>
 #include <iostream>
+#include <tuple>
 #include <unordered_set>
 
 namespace mbgl {
 
 using namespace style;
 
+// Maximum number of bucket bytes uploaded per frame in continuous mode. Sized
+// so a typical vector tile's buckets fit in one frame, while a burst of
+// finished tiles is spread over several frames instead of hitching one.
+static const std::size_t uploadBudgetPerFrame = 1024 * 1024;
+
 static gl::VertexVector<FillLayoutVertex> tileVertices() {
     gl::VertexVector<FillLayoutVertex> result;
     result.emplace_back(FillProgram::layoutVertex({ 0,            0 }));
@@ -102,10 +125,24 @@ Painter::Painter(gl::Context& context_,
 #endif
 }
 
-Painter::~Painter() = default;
+Painter::~Painter() {
+    // Query objects aren't tracked by the context's abandoned-object lists,
+    // so release them here, while the GL context is still current.
+    if (context.supportsTimeElapsedQueries()) {
+        auto& ext = *context.getTimerQueryExtension();
+        for (const auto& query : pendingGPUQueries) {
+            MBGL_CHECK_ERROR(ext.deleteQueries(1, &query.id));
+        }
+        for (const auto& id : pooledGPUQueries) {
+            MBGL_CHECK_ERROR(ext.deleteQueries(1, &id));
+        }
+    }
+}
 
 bool Painter::needsAnimation() const {
-    return frameHistory.needsAnimation(util::DEFAULT_FADE_DURATION);
+    // Deferred bucket uploads need another frame to make progress, even when
+    // nothing else is animating.
+    return frameHistory.needsAnimation(util::DEFAULT_FADE_DURATION) || uploadsPending;
 }
 
 void Painter::cleanup() {
@@ -114,6 +151,25 @@ void Painter::cleanup() {
 
 void Painter::render(const Style& style, const FrameData& frame_, View& view, SpriteAtlas& annotationSpriteAtlas) {
     frame = frame_;
+    // Invalidates everything the previous frame allocated from the arena.
+    frameArena.reset();
+    framePacer.beginFrame();
+    if (frame.debugOptions & MapDebugOptions::PerformanceHUD) {
+        // Sample the frame-to-frame interval rather than the render call's
+        // duration: a stutter spent outside render() is exactly what the HUD
+        // is meant to make visible.
+        if (lastFrameTimePoint) {
+            frameTimeHistory[frameTimeHistoryIndex] = std::chrono::duration<float, std::milli>(
+                frame.timePoint - *lastFrameTimePoint).count();
+            frameTimeHistoryIndex = (frameTimeHistoryIndex + 1) % frameTimeHistoryCount;
+        }
+        lastFrameTimePoint = frame.timePoint;
+    } else {
+        lastFrameTimePoint = {};
+    }
+    pollGPUTimings();
+    ++gpuTimingFrame;
+    const RenderStatistics statsAtFrameStart = context.renderStats;
     if (frame.contextMode == GLContextMode::Shared) {
         context.setDirtyState();
     }
@@ -124,16 +180,17 @@ void Painter::render(const Style& style, const FrameData& frame_, View& view, Sp
 #else
         *programs,
 #endif
-        view
+        view,
+        frameArena
     };
 
     glyphAtlas = style.glyphAtlas.get();
     spriteAtlas = style.spriteAtlas.get();
     lineAtlas = style.lineAtlas.get();
 
-    RenderData renderData = style.getRenderData(frame.debugOptions, state.getAngle());
-    const std::vector<RenderItem>& order = renderData.order;
-    const std::unordered_set<Source*>& sources = renderData.sources;
+    RenderData renderData = style.getRenderData(frame.debugOptions, state.getAngle(), frameArena);
+    const auto& order = renderData.order;
+    const auto& sources = renderData.sources;
 
     // Update the default matrices to the current viewport dimensions.
     state.getProjMatrix(projMatrix);
@@ -146,6 +203,32 @@ void Painter::render(const Style& style, const FrameData& frame_, View& view, Sp
     frameHistory.record(frame.timePoint, state.getZoom(),
         frame.mapMode == MapMode::Continuous ? util::DEFAULT_FADE_DURATION : Milliseconds(0));
 
+    // - DAMAGE TRACKING ---------------------------------------------------------------------------
+    // Records which tiles changed since the last frame so that, on surfaces
+    // reporting a buffer age, the repaint can be restricted to those regions.
+    {
+        bool fullDamage = frame.styleChanged
+            || frame.mapMode != MapMode::Continuous
+            || frame.contextMode == GLContextMode::Shared
+            || frame.debugOptions != MapDebugOptions::NoDebug
+            || needsAnimation();
+        for (const auto& item : order) {
+            // Symbol layers may place labels past their tile's extent, so
+            // changed symbol data damages the whole frame.
+            if (item.bucket && item.bucket->needsUpload() && item.layer.is<SymbolLayer>()) {
+                fullDamage = true;
+            }
+        }
+
+        frameDamage.beginFrame(projMatrix, fullDamage);
+        for (const auto& item : order) {
+            if (item.tile) {
+                frameDamage.addTile(item.tile->id, matrixForTile(item.tile->id),
+                                    item.bucket && item.bucket->needsUpload());
+            }
+        }
+    }
+
 
     // - UPLOAD PASS -------------------------------------------------------------------------------
     // Uploads all required buffers and images before we do any actual rendering.
@@ -159,9 +242,54 @@ void Painter::render(const Style& style, const FrameData& frame_, View& view, Sp
         frameHistory.upload(context, 0);
         annotationSpriteAtlas.upload(context, 0);
 
+        // Budget bucket uploads so a burst of finished tiles doesn't stall a
+        // single frame. At least one pending bucket is uploaded per frame so
+        // progress is guaranteed; smaller buckets may fill the remaining
+        // budget ahead of larger ones. Deferred buckets are skipped during
+        // rendering below and picked up on subsequent frames. Still-image
+        // renders are one-shot, so everything is uploaded right away there.
+        // The pacer shrinks the budget when recent frames ran long, spreading
+        // upload cost over more frames while animating.
+        std::size_t uploadBudget = uploadBudgetPerFrame;
+        if (frame.mapMode == MapMode::Continuous) {
+            uploadBudget = static_cast<std::size_t>(uploadBudget * framePacer.workScale());
+        }
+        // A frame-level deadline caps discretionary uploads in any mode: a
+        // budgeted one-shot render stops taking on new buckets once it has
+        // passed, leaving them for the caller's next frame.
+        const bool hasDeadline = frame.budget > Duration::zero();
+        const TimePoint deadline = frame.timePoint + frame.budget;
+        bool uploadedAny = false;
+        uploadsPending = false;
         for (const auto& item : order) {
             if (item.bucket && item.bucket->needsUpload()) {
+                const std::size_t byteSize = item.bucket->uploadByteSize();
+                if (uploadedAny &&
+                    ((byteSize > uploadBudget && frame.mapMode == MapMode::Continuous) ||
+                     (hasDeadline && Clock::now() >= deadline))) {
+                    uploadsPending = true;
+                    continue;
+                }
+                const TimePoint uploadStart = Clock::now();
                 item.bucket->upload(context);
+                const TimePoint uploadEnd = Clock::now();
+                util::recordTileStageLatency(TileStage::Upload, uploadEnd - uploadStart);
+                if (util::isTracing()) {
+                    util::recordTraceEvent("upload", uploadStart, uploadEnd, 0,
+                                           item.tile ? util::toString(item.tile->id).c_str() : nullptr);
+                }
+                util::markStartupMilestone(StartupMilestone::FirstTileUploaded);
+                uploadedAny = true;
+                uploadBudget -= std::min(byteSize, uploadBudget);
+            }
+        }
+
+        // Flush pending feature-state changes after the bucket uploads, so a
+        // freshly uploaded buffer is not immediately rewritten. Tiles without
+        // pending state return right away.
+        for (const auto& item : order) {
+            if (item.tile) {
+                item.tile->tile.uploadFeatureStates(context);
             }
         }
     }
@@ -172,6 +300,19 @@ void Painter::render(const Style& style, const FrameData& frame_, View& view, Sp
     {
         MBGL_DEBUG_GROUP(context, "clear");
         view.bind();
+
+        // When the bound buffer still holds a recently presented frame,
+        // restrict the repaint to the union of everything that changed since
+        // that frame; all other pixels already show the correct colors.
+        framebufferSize = context.viewport.getCurrentValue().size;
+        damageScissor = frameDamage.scissorRegion(view.getBufferAge(), framebufferSize);
+        if (damageScissor) {
+            context.scissorTest = true;
+            context.scissorBox = { damageScissor->x, damageScissor->y, damageScissor->size };
+        } else {
+            context.scissorTest = false;
+        }
+
         context.clear(paintMode() == PaintMode::Overdraw
                         ? Color::black()
                         : renderData.backgroundColor,
@@ -184,15 +325,30 @@ void Painter::render(const Style& style, const FrameData& frame_, View& view, Sp
     {
         MBGL_DEBUG_GROUP(context, "clip");
 
-        // Update all clipping IDs.
-        algorithm::ClipIDGenerator generator;
+        // Update all clipping IDs. The set of used render tiles only changes
+        // when tiles load or the camera crosses a tile boundary, so on most
+        // frames the previous assignment is replayed instead of regenerated.
+        std::vector<std::map<UnwrappedTileID, RenderTile>*> clippedRenderables;
+        for (const auto& source : sources) {
+            if (source->baseImpl->clipsTiles()) {
+                clippedRenderables.push_back(&source->baseImpl->getRenderTiles());
+            }
+        }
+        if (!clipIDCache.reuse(clippedRenderables)) {
+            algorithm::ClipIDGenerator generator(frameArena);
+            for (auto* renderables : clippedRenderables) {
+                generator.update(*renderables);
+            }
+            clipIDCache.capture(clippedRenderables, generator.getStencils());
+        }
+
         for (const auto& source : sources) {
-            source->baseImpl->startRender(generator, projMatrix, state);
+            source->baseImpl->startRender(projMatrix, state);
         }
 
         MBGL_DEBUG_GROUP(context, "clipping masks");
 
-        for (const auto& stencil : generator.getStencils()) {
+        for (const auto& stencil : clipIDCache.getStencils()) {
             MBGL_DEBUG_GROUP(context, std::string{ "mask: " } + util::toString(stencil.first));
             renderClippingMask(stencil.first, stencil.second);
         }
@@ -213,17 +369,83 @@ void Painter::render(const Style& style, const FrameData& frame_, View& view, Sp
 
     // - OPAQUE PASS -------------------------------------------------------------------------------
     // Render everything top-to-bottom by using reverse iterators. Render opaque objects first.
-    renderPass(parameters,
-               RenderPass::Opaque,
-               order.rbegin(), order.rend(),
-               0, 1);
+    // Each item carries its own depth range, so the depth buffer resolves
+    // occlusion regardless of draw order within this pass. That makes it safe
+    // to group items of the same layer type — and thus the same program and
+    // most GL state — across tiles and layers, turning per-item state
+    // switches into a handful of runs. The stable sort keeps the
+    // front-to-back order within each run, preserving most of the early-z
+    // benefit. Custom layers may issue arbitrary GL, so their presence
+    // disables reordering.
+    // Opaque items that lie entirely below a fully opaque fill covering their
+    // whole tile can be culled outright: the depth test would reject every one
+    // of their fragments anyway, so skipping the draw only saves vertex and
+    // state cost. Since the fill wrote its own depth, translucent-pass content
+    // of the culled layers (e.g. fill outlines) still resolves correctly.
+    opaqueItems.clear();
+    opaqueItems.reserve(order.size());
+    bool hasCustomLayer = false;
+    {
+        std::unordered_set<const RenderTile*,
+                           std::hash<const RenderTile*>,
+                           std::equal_to<const RenderTile*>,
+                           util::ArenaAllocator<const RenderTile*>>
+            coveredTiles{util::ArenaAllocator<const RenderTile*>(frameArena)};
+        uint32_t i = 0;
+        for (auto it = order.rbegin(); it != order.rend(); ++it, ++i) {
+            hasCustomLayer |= it->layer.is<CustomLayer>();
+            // Buckets whose upload was deferred by the budget have no GL
+            // buffers yet and can't be drawn this frame.
+            if (it->bucket && it->bucket->needsUpload()) {
+                continue;
+            }
+            if (it->tile && coveredTiles.count(it->tile)) {
+                continue;
+            }
+            opaqueItems.emplace_back(&*it, i);
+
+            if (it->tile && it->bucket && it->bucket->coversTile() &&
+                it->layer.is<FillLayer>() &&
+                it->layer.baseImpl->hasRenderPass(RenderPass::Opaque) &&
+                it->layer.as<FillLayer>()->impl->paint.evaluated.get<style::FillTranslate>() ==
+                    std::array<float, 2> {{ 0, 0 }}) {
+                coveredTiles.insert(it->tile);
+            }
+        }
+    }
+    if (!hasCustomLayer) {
+        // Sort by layer type first (one program per type), then by tile, so
+        // that consecutive items also share their tile matrix uniforms,
+        // stencil clip, and — for layers grouped into the same bucket — their
+        // vertex buffers. The dedupe in gl::Context and gl::Uniform::State
+        // then turns most of the per-item state setup into no-ops.
+        std::stable_sort(opaqueItems.begin(), opaqueItems.end(),
+                         [] (const RenderPassItem& a, const RenderPassItem& b) {
+                             return std::make_tuple(a.first->layer.type, a.first->tile) <
+                                    std::make_tuple(b.first->layer.type, b.first->tile);
+                         });
+    }
+    renderPass(parameters, RenderPass::Opaque, opaqueItems);
 
     // - TRANSLUCENT PASS --------------------------------------------------------------------------
     // Make a second pass, rendering translucent objects. This time, we render bottom-to-top.
-    renderPass(parameters,
-               RenderPass::Translucent,
-               order.begin(), order.end(),
-               static_cast<uint32_t>(order.size()) - 1, -1);
+    // Blending makes draw order part of the result here, so style order is
+    // preserved.
+    translucentItems.clear();
+    translucentItems.reserve(order.size());
+    {
+        uint32_t i = static_cast<uint32_t>(order.size()) - 1;
+        for (auto it = order.begin(); it != order.end(); ++it, --i) {
+            if (it->bucket && it->bucket->needsUpload()) {
+                continue;
+            }
+            translucentItems.emplace_back(&*it, i);
+        }
+    }
+    renderPass(parameters, RenderPass::Translucent, translucentItems);
+
+    context.scissorTest = false;
+    frameDamage.endFrame();
 
     if (debug::renderTree) { Log::Info(Event::Render, "}"); indent--; }
 
@@ -247,11 +469,17 @@ void Painter::render(const Style& style, const FrameData& frame_, View& view, Sp
     }
 #endif
 
+    if (frame.debugOptions & MapDebugOptions::PerformanceHUD) {
+        renderPerformanceHUD(parameters);
+    }
+
     // TODO: Find a better way to unbind VAOs after we're done with them without introducing
     // unnecessary bind(0)/bind(N) sequences.
     {
         MBGL_DEBUG_GROUP(context, "cleanup");
 
+        context.activeTexture = 2;
+        context.texture[2] = 0;
         context.activeTexture = 1;
         context.texture[1] = 0;
         context.activeTexture = 0;
@@ -259,13 +487,14 @@ void Painter::render(const Style& style, const FrameData& frame_, View& view, Sp
 
         context.vertexArrayObject = 0;
     }
+
+    frameRenderStats = context.renderStats - statsAtFrameStart;
+    framePacer.endFrame();
 }
 
-template <class Iterator>
 void Painter::renderPass(PaintParameters& parameters,
                          RenderPass pass_,
-                         Iterator it, Iterator end,
-                         uint32_t i, int8_t increment) {
+                         const std::vector<RenderPassItem>& items) {
     pass = pass_;
 
     MBGL_DEBUG_GROUP(context, pass == RenderPass::Opaque ? "opaque" : "translucent");
@@ -275,15 +504,31 @@ void Painter::renderPass(PaintParameters& parameters,
                   pass == RenderPass::Opaque ? "opaque" : "translucent");
     }
 
-    for (; it != end; ++it, i += increment) {
-        currentLayer = i;
+    const bool gpuTiming = (frame.debugOptions & MapDebugOptions::GPUTiming) &&
+                           context.supportsTimeElapsedQueries();
+
+    for (const auto& passItem : items) {
+        currentLayer = passItem.second;
 
-        const auto& item = *it;
+        const auto& item = *passItem.first;
         const Layer& layer = item.layer;
 
         if (!layer.baseImpl->hasRenderPass(pass))
             continue;
 
+        // When the repaint is scissored to the damaged region, draws for
+        // tiles entirely outside of it cannot change any pixel. Skipping
+        // them means a static layer stack under a few animating layers
+        // costs only the draws that overlap the animation.
+        if (damageScissor && item.tile &&
+            !frameDamage.tileIntersects(item.tile->id, *damageScissor, framebufferSize)) {
+            continue;
+        }
+
+        if (gpuTiming) {
+            beginGPUTiming(layer.baseImpl->id);
+        }
+
         if (layer.is<BackgroundLayer>()) {
             MBGL_DEBUG_GROUP(context, "background");
             renderBackground(parameters, *layer.as<BackgroundLayer>());
@@ -296,7 +541,7 @@ void Painter::renderPass(PaintParameters& parameters,
             context.setStencilMode(gl::StencilMode::disabled());
             context.setColorMode(colorModeForRenderPass());
 
-            layer.as<CustomLayer>()->impl->render(state);
+            layer.as<CustomLayer>()->impl->render(state, projMatrix);
 
             // Reset the view back to our original one, just in case the CustomLayer changed
             // the viewport or Framebuffer.
@@ -304,7 +549,39 @@ void Painter::renderPass(PaintParameters& parameters,
             context.setDirtyState();
         } else {
             MBGL_DEBUG_GROUP(context, layer.baseImpl->id + " - " + util::toString(item.tile->id));
-            item.bucket->render(*this, parameters, layer, *item.tile);
+            // The layer taxonomy is fixed, so dispatch on the type tag the
+            // same way Layer::accept does instead of bouncing through the
+            // bucket's vtable for every item of every frame. The bucket's
+            // concrete type is determined by the layer type that created it.
+            switch (layer.type) {
+            case Layer::Type::Fill:
+                renderFill(parameters, *static_cast<FillBucket*>(item.bucket), *layer.as<FillLayer>(), *item.tile);
+                break;
+            case Layer::Type::FillExtrusion:
+                renderFillExtrusion(parameters, *static_cast<FillExtrusionBucket*>(item.bucket), *layer.as<FillExtrusionLayer>(), *item.tile);
+                break;
+            case Layer::Type::Line:
+                renderLine(parameters, *static_cast<LineBucket*>(item.bucket), *layer.as<LineLayer>(), *item.tile);
+                break;
+            case Layer::Type::Circle:
+                renderCircle(parameters, *static_cast<CircleBucket*>(item.bucket), *layer.as<CircleLayer>(), *item.tile);
+                break;
+            case Layer::Type::Symbol:
+                renderSymbol(parameters, *static_cast<SymbolBucket*>(item.bucket), *layer.as<SymbolLayer>(), *item.tile);
+                break;
+            case Layer::Type::Raster:
+                renderRaster(parameters, *static_cast<RasterBucket*>(item.bucket), *layer.as<RasterLayer>(), *item.tile);
+                break;
+            default:
+                // Background and custom layers are handled above and never
+                // carry a bucket.
+                assert(false);
+                break;
+            }
+        }
+
+        if (gpuTiming) {
+            endGPUTiming();
         }
     }
 
@@ -314,9 +591,20 @@ void Painter::renderPass(PaintParameters& parameters,
 }
 
 mat4 Painter::matrixForTile(const UnwrappedTileID& tileID) {
+    if (projMatrix != tileMatrixCacheProjMatrix) {
+        tileMatrixCache.clear();
+        tileMatrixCacheProjMatrix = projMatrix;
+    }
+
+    auto it = tileMatrixCache.find(tileID);
+    if (it != tileMatrixCache.end()) {
+        return it->second;
+    }
+
     mat4 matrix;
     state.matrixFor(matrix, tileID);
     matrix::multiply(matrix, projMatrix, matrix);
+    tileMatrixCache.emplace(tileID, matrix);
     return matrix;
 }
 
@@ -327,6 +615,11 @@ gl::DepthMode Painter::depthModeForSublayer(uint8_t n, gl::DepthMode::Mask mask)
 }
 
 gl::StencilMode Painter::stencilModeForClipping(const ClipID& id) const {
+    // Tiles the clip ID generator found free of any overlap carry an empty
+    // clip; they render without a stencil mask, so skip the test entirely.
+    if (id.mask.none()) {
+        return gl::StencilMode::disabled();
+    }
     return gl::StencilMode {
         gl::StencilMode::Equal { static_cast<uint32_t>(id.mask.to_ulong()) },
         static_cast<int32_t>(id.reference.to_ulong()),
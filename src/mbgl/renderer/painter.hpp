@@ -4,7 +4,9 @@
 
 #include <mbgl/tile/tile_id.hpp>
 
+#include <mbgl/renderer/frame_damage.hpp>
 #include <mbgl/renderer/frame_history.hpp>
+#include <mbgl/renderer/frame_pacer.hpp>
 #include <mbgl/renderer/render_item.hpp>
 #include <mbgl/renderer/bucket.hpp>
 
@@ -16,11 +18,15 @@
 
 #include <mbgl/style/style.hpp>
 
+#include <mbgl/algorithm/clip_id_cache.hpp>
+
+#include <mbgl/util/arena.hpp>
 #include <mbgl/util/noncopyable.hpp>
 #include <mbgl/util/chrono.hpp>
 #include <mbgl/util/constants.hpp>
 
 #include <array>
+#include <deque>
 #include <vector>
 #include <set>
 #include <map>
@@ -37,6 +43,7 @@ class Tile;
 
 class DebugBucket;
 class FillBucket;
+class FillExtrusionBucket;
 class LineBucket;
 class CircleBucket;
 class SymbolBucket;
@@ -51,6 +58,7 @@ namespace style {
 class Style;
 class Source;
 class FillLayer;
+class FillExtrusionLayer;
 class LineLayer;
 class CircleLayer;
 class SymbolLayer;
@@ -64,6 +72,16 @@ struct FrameData {
     MapMode mapMode;
     GLContextMode contextMode;
     MapDebugOptions debugOptions;
+
+    // Whether anything beyond a plain repaint was updated since the last
+    // frame. Style mutations can change arbitrary pixels, so they invalidate
+    // the damage history used for partial repaints.
+    bool styleChanged = true;
+
+    // Deadline for discretionary per-frame work, measured from timePoint;
+    // zero means no deadline. Once it has passed, pending bucket uploads
+    // beyond the guaranteed first are deferred to a later frame.
+    Duration budget = Duration::zero();
 };
 
 class Painter : private util::noncopyable {
@@ -81,12 +99,17 @@ public:
     void renderClippingMask(const UnwrappedTileID&, const ClipID&);
     void renderTileDebug(const RenderTile&);
     void renderFill(PaintParameters&, FillBucket&, const style::FillLayer&, const RenderTile&);
+    void renderFillExtrusion(PaintParameters&, FillExtrusionBucket&, const style::FillExtrusionLayer&, const RenderTile&);
     void renderLine(PaintParameters&, LineBucket&, const style::LineLayer&, const RenderTile&);
     void renderCircle(PaintParameters&, CircleBucket&, const style::CircleLayer&, const RenderTile&);
     void renderSymbol(PaintParameters&, SymbolBucket&, const style::SymbolLayer&, const RenderTile&);
     void renderRaster(PaintParameters&, RasterBucket&, const style::RasterLayer&, const RenderTile&);
     void renderBackground(PaintParameters&, const style::BackgroundLayer&);
 
+    // Renders the performance HUD (MapDebugOptions::PerformanceHUD) on top
+    // of the finished frame.
+    void renderPerformanceHUD(PaintParameters&);
+
 #ifndef NDEBUG
     // Renders tile clip boundaries, using stencil buffer to calculate fill color.
     void renderClipMasks(PaintParameters&);
@@ -96,14 +119,34 @@ public:
 
     bool needsAnimation() const;
 
+    // Most recently resolved per-layer GPU times, in milliseconds, collected
+    // while MapDebugOptions::GPUTiming is set. Timer query results become
+    // available only after the GPU retires a frame, so the entries describe
+    // a recently completed frame rather than the one on screen.
+    const std::map<std::string, double>& getGPULayerTimings() const {
+        return gpuLayerTimings;
+    }
+
+    // Counters of the GL work issued by the most recently rendered frame.
+    const RenderStatistics& getRenderStatistics() const {
+        return frameRenderStats;
+    }
+
 private:
     std::vector<RenderItem> determineRenderOrder(const style::Style&);
 
-    template <class Iterator>
+    // A render item paired with its style-order depth index. The index feeds
+    // the per-layer depth range, so items can be reordered for state batching
+    // without changing their depth values.
+    using RenderPassItem = std::pair<const RenderItem*, uint32_t>;
+
     void renderPass(PaintParameters&,
                     RenderPass,
-                    Iterator it, Iterator end,
-                    uint32_t i, int8_t increment);
+                    const std::vector<RenderPassItem>&);
+
+    void beginGPUTiming(const std::string& layerID);
+    void endGPUTiming();
+    void pollGPUTimings();
 
     mat4 matrixForTile(const UnwrappedTileID&);
     gl::DepthMode depthModeForSublayer(uint8_t n, gl::DepthMode::Mask) const;
@@ -126,6 +169,13 @@ private:
 
     mat4 projMatrix;
 
+    // Caches the per-tile matrices handed out by matrixForTile() — hit for
+    // background, clipping, and debug draws every frame — while the
+    // projection matrix is unchanged, mirroring the render tile matrix cache
+    // in Source::Impl::startRender.
+    std::map<UnwrappedTileID, mat4> tileMatrixCache;
+    mat4 tileMatrixCacheProjMatrix = {{}};
+
     std::array<float, 2> pixelsToGLUnits;
 
     const mat4 identityMatrix = []{
@@ -152,6 +202,59 @@ private:
     LineAtlas* lineAtlas = nullptr;
 
     FrameHistory frameHistory;
+    FrameDamage frameDamage;
+    FramePacer framePacer;
+
+    // The damage scissor in effect for the current frame, if any, and the
+    // framebuffer size it refers to. Used to skip draws for tiles that lie
+    // entirely outside the repainted region.
+    optional<FrameDamage::Region> damageScissor;
+    Size framebufferSize = { 0, 0 };
+
+    // Whether the last frame's upload budget left buckets waiting.
+    bool uploadsPending = false;
+
+    // Per-frame render pass item lists. Members rather than locals so their
+    // allocations persist across frames.
+    std::vector<RenderPassItem> opaqueItems;
+    std::vector<RenderPassItem> translucentItems;
+
+    // Bump arena for render-loop transients: the frame's draw list, clip id
+    // bookkeeping, and similar containers that die with the frame. Reset at
+    // the start of each render(); chunks are retained, so a steady-state
+    // frame stops touching malloc entirely.
+    util::Arena frameArena;
+
+    // Clip ID assignment of the previous frame, replayed while the sources'
+    // used render tile sets are unchanged.
+    algorithm::ClipIDCache clipIDCache;
+
+    // GPU timing state (MapDebugOptions::GPUTiming). One time-elapsed query
+    // brackets each render item; results are polled at the start of later
+    // frames and aggregated by layer, and a frame's aggregate is published
+    // to gpuLayerTimings once all of its queries have resolved. Query
+    // objects are pooled for reuse.
+    struct GPUTimeQuery {
+        uint32_t id;
+        uint64_t frame;
+        std::string layerID;
+    };
+    std::deque<GPUTimeQuery> pendingGPUQueries;
+    std::vector<uint32_t> pooledGPUQueries;
+    uint64_t gpuTimingFrame = 0;
+    uint64_t gpuTimingResolvedFrame = 0;
+    std::map<std::string, double> gpuTimingAccumulator;
+    std::map<std::string, double> gpuLayerTimings;
+
+    RenderStatistics frameRenderStats;
+
+    // Ring of recent frame-to-frame intervals in milliseconds, feeding the
+    // performance HUD's frame time graph. Only maintained while the HUD is
+    // enabled.
+    static constexpr std::size_t frameTimeHistoryCount = 120;
+    std::array<float, frameTimeHistoryCount> frameTimeHistory {{}};
+    std::size_t frameTimeHistoryIndex = 0;
+    optional<TimePoint> lastFrameTimePoint;
 
     std::unique_ptr<Programs> programs;
 #ifndef NDEBUG
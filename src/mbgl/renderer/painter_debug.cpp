@@ -6,10 +6,17 @@
 #include <mbgl/tile/tile.hpp>
 #include <mbgl/programs/programs.hpp>
 #include <mbgl/programs/fill_program.hpp>
+#include <mbgl/geometry/debug_font_data.hpp>
 #include <mbgl/util/string.hpp>
+#include <mbgl/util/mat4.hpp>
+#include <mbgl/util/performance_counters.hpp>
 #include <mbgl/gl/debugging.hpp>
+#include <mbgl/gl/gl.hpp>
+#include <mbgl/gl/timer_query_extension.hpp>
 #include <mbgl/util/color.hpp>
 
+#include <cmath>
+
 namespace mbgl {
 
 using namespace style;
@@ -77,6 +84,164 @@ void Painter::renderTileDebug(const RenderTile& renderTile) {
     }
 }
 
+void Painter::renderPerformanceHUD(PaintParameters&) {
+    MBGL_DEBUG_GROUP(context, "performance hud");
+
+    gl::VertexVector<FillLayoutVertex> vertices;
+    gl::IndexVector<gl::Lines> indices;
+
+    auto addLine = [&] (Point<int16_t> from, Point<int16_t> to) {
+        vertices.emplace_back(FillProgram::layoutVertex(from));
+        vertices.emplace_back(FillProgram::layoutVertex(to));
+        indices.emplace_back(vertices.vertexSize() - 2, vertices.vertexSize() - 1);
+    };
+
+    auto addText = [&] (const std::string& text, double left, double baseline, double scale) {
+        for (uint8_t c : text) {
+            if (c < 32 || c >= 127)
+                continue;
+
+            optional<Point<int16_t>> prev;
+
+            const glyph& glyph = simplex[c - 32];
+            for (int32_t j = 0; j < glyph.length; j += 2) {
+                if (glyph.data[j] == -1 && glyph.data[j + 1] == -1) {
+                    prev = {};
+                } else {
+                    Point<int16_t> p {
+                        int16_t(::round(left + glyph.data[j] * scale)),
+                        int16_t(::round(baseline - glyph.data[j + 1] * scale))
+                    };
+
+                    vertices.emplace_back(FillProgram::layoutVertex(p));
+
+                    if (prev) {
+                        indices.emplace_back(vertices.vertexSize() - 2,
+                                             vertices.vertexSize() - 1);
+                    }
+
+                    prev = p;
+                }
+            }
+
+            left += glyph.width * scale;
+        }
+    };
+
+    auto toStringWithTenths = [] (double value) {
+        const uint64_t tenths = static_cast<uint64_t>(std::max(0.0, std::round(value * 10)));
+        return util::toString(tenths / 10) + "." + util::toString(tenths % 10);
+    };
+
+    auto toPercentage = [] (uint64_t hits, uint64_t misses) -> std::string {
+        const uint64_t total = hits + misses;
+        if (total == 0) {
+            return "-";
+        }
+        return util::toString(hits * 100 / total) + "% (" + util::toString(hits) + "/" +
+               util::toString(total) + ")";
+    };
+
+    // Frame time graph: one bar per recorded frame interval, oldest on the
+    // left, with a reference line at the 60 Hz budget.
+    const int16_t margin = 8;
+    const int16_t barWidth = 2;
+    const int16_t graphHeight = 64;
+    const double pixelsPerMillisecond = 2;
+    const int16_t graphWidth = int16_t(frameTimeHistoryCount) * barWidth;
+    const int16_t graphBottom = margin + graphHeight;
+
+    addLine({ margin, margin }, { int16_t(margin + graphWidth), margin });
+    addLine({ margin, graphBottom }, { int16_t(margin + graphWidth), graphBottom });
+    addLine({ margin, margin }, { margin, graphBottom });
+    addLine({ int16_t(margin + graphWidth), margin }, { int16_t(margin + graphWidth), graphBottom });
+
+    const int16_t budgetY = int16_t(graphBottom - ::round((1000.0 / 60) * pixelsPerMillisecond));
+    addLine({ margin, budgetY }, { int16_t(margin + graphWidth), budgetY });
+
+    float lastFrameTime = 0;
+    double totalFrameTime = 0;
+    std::size_t frameTimeSamples = 0;
+    for (std::size_t i = 0; i < frameTimeHistoryCount; i++) {
+        const float sample = frameTimeHistory[(frameTimeHistoryIndex + i) % frameTimeHistoryCount];
+        if (sample <= 0) {
+            continue;
+        }
+        lastFrameTime = sample;
+        totalFrameTime += sample;
+        frameTimeSamples++;
+
+        const int16_t barHeight = int16_t(
+            std::min(double(graphHeight), ::round(sample * pixelsPerMillisecond)));
+        const int16_t x = int16_t(margin + i * barWidth);
+        addLine({ x, graphBottom }, { x, int16_t(graphBottom - barHeight) });
+    }
+
+    // Counter readout. The GL statistics describe the previous frame — the
+    // current frame's counters aren't final until after this draw.
+    const PerformanceCounters counters = util::getPerformanceCounters();
+
+    const double textScale = 0.5;
+    const double lineHeight = 18;
+    double baseline = graphBottom + lineHeight;
+
+    auto addTextLine = [&] (const std::string& text) {
+        addText(text, margin, baseline, textScale);
+        baseline += lineHeight;
+    };
+
+    addTextLine("frame " + toStringWithTenths(lastFrameTime) + " ms / avg " +
+                toStringWithTenths(frameTimeSamples > 0 ? totalFrameTime / frameTimeSamples : 0) +
+                " ms");
+    addTextLine("draws " + util::toString(frameRenderStats.drawCalls) +
+                "  programs " + util::toString(frameRenderStats.programSwitches) +
+                "  binds " + util::toString(frameRenderStats.textureBinds));
+    addTextLine("upload " + toStringWithTenths(frameRenderStats.bytesUploaded / 1024.0) + " KB");
+    addTextLine("queued " + util::toString(counters.workerQueueDepth));
+    addTextLine("tile cache " + toPercentage(counters.hitsFor(CacheKind::TileCache),
+                                             counters.missesFor(CacheKind::TileCache)));
+    addTextLine("parse cache " + toPercentage(counters.hitsFor(CacheKind::ParseCache),
+                                              counters.missesFor(CacheKind::ParseCache)));
+
+    gl::SegmentVector<DebugAttributes> segments;
+    segments.emplace_back(0, 0, vertices.vertexSize(), indices.indexSize());
+
+    auto vertexBuffer = context.createVertexBuffer(std::move(vertices));
+    auto indexBuffer = context.createIndexBuffer(std::move(indices));
+
+    // Draw in logical pixels with the origin at the top left, independent of
+    // the map transform.
+    mat4 hudMatrix;
+    matrix::ortho(hudMatrix, 0, state.getSize().width, state.getSize().height, 0, 0, 1);
+
+    static const style::PaintProperties<>::Evaluated properties {};
+    static const DebugProgram::PaintPropertyBinders paintAttibuteData(properties, 0);
+
+    auto draw = [&] (Color color, float width) {
+        programs->debug.draw(
+            context,
+            gl::Lines { width * frame.pixelRatio },
+            gl::DepthMode::disabled(),
+            gl::StencilMode::disabled(),
+            gl::ColorMode::unblended(),
+            DebugProgram::UniformValues {
+                uniforms::u_matrix::Value{ hudMatrix },
+                uniforms::u_color::Value{ color }
+            },
+            vertexBuffer,
+            indexBuffer,
+            segments,
+            paintAttibuteData,
+            properties,
+            state.getZoom()
+        );
+    };
+
+    // A black underlay keeps the readout legible on any map content.
+    draw(Color::black(), 4.0f);
+    draw(Color::white(), 2.0f);
+}
+
 #ifndef NDEBUG
 void Painter::renderClipMasks(PaintParameters&) {
     context.setStencilMode(gl::StencilMode::disabled());
@@ -131,4 +296,65 @@ void Painter::renderDepthBuffer(PaintParameters&) {
 }
 #endif // NDEBUG
 
+void Painter::beginGPUTiming(const std::string& layerID) {
+    auto& ext = *context.getTimerQueryExtension();
+
+    uint32_t id;
+    if (!pooledGPUQueries.empty()) {
+        id = pooledGPUQueries.back();
+        pooledGPUQueries.pop_back();
+    } else {
+        MBGL_CHECK_ERROR(ext.genQueries(1, &id));
+    }
+
+    MBGL_CHECK_ERROR(ext.beginQuery(GL_TIME_ELAPSED, id));
+    pendingGPUQueries.push_back({ id, gpuTimingFrame, layerID });
+}
+
+void Painter::endGPUTiming() {
+    MBGL_CHECK_ERROR(context.getTimerQueryExtension()->endQuery(GL_TIME_ELAPSED));
+}
+
+void Painter::pollGPUTimings() {
+    if (pendingGPUQueries.empty() || !context.supportsTimeElapsedQueries()) {
+        return;
+    }
+
+    auto& ext = *context.getTimerQueryExtension();
+
+    // Queries complete in issue order, so drain from the front until one is
+    // still in flight.
+    while (!pendingGPUQueries.empty()) {
+        const GPUTimeQuery& query = pendingGPUQueries.front();
+
+        uint32_t available = 0;
+        MBGL_CHECK_ERROR(ext.getQueryObjectuiv(query.id, GL_QUERY_RESULT_AVAILABLE, &available));
+        if (!available) {
+            break;
+        }
+
+        uint64_t nanoseconds = 0;
+        MBGL_CHECK_ERROR(ext.getQueryObjectui64v(query.id, GL_QUERY_RESULT, &nanoseconds));
+
+        if (query.frame != gpuTimingResolvedFrame) {
+            if (!gpuTimingAccumulator.empty()) {
+                gpuLayerTimings = std::move(gpuTimingAccumulator);
+                gpuTimingAccumulator.clear();
+            }
+            gpuTimingResolvedFrame = query.frame;
+        }
+        gpuTimingAccumulator[query.layerID] += nanoseconds / 1e6;
+
+        pooledGPUQueries.push_back(query.id);
+        pendingGPUQueries.pop_front();
+    }
+
+    // With nothing left in flight, the frame being accumulated is complete:
+    // all of its queries were issued before this poll ran.
+    if (pendingGPUQueries.empty() && !gpuTimingAccumulator.empty()) {
+        gpuLayerTimings = std::move(gpuTimingAccumulator);
+        gpuTimingAccumulator.clear();
+    }
+}
+
 } // namespace mbgl
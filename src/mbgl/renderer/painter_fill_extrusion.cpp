@@ -0,0 +1,68 @@
+#include <mbgl/renderer/painter.hpp>
+#include <mbgl/renderer/paint_parameters.hpp>
+#include <mbgl/renderer/fill_extrusion_bucket.hpp>
+#include <mbgl/renderer/render_tile.hpp>
+#include <mbgl/style/layers/fill_extrusion_layer.hpp>
+#include <mbgl/style/layers/fill_extrusion_layer_impl.hpp>
+#include <mbgl/programs/programs.hpp>
+#include <mbgl/programs/fill_extrusion_program.hpp>
+#include <mbgl/util/constants.hpp>
+
+#include <cmath>
+
+namespace mbgl {
+
+using namespace style;
+
+void Painter::renderFillExtrusion(PaintParameters& parameters,
+                                  FillExtrusionBucket& bucket,
+                                  const FillExtrusionLayer& layer,
+                                  const RenderTile& tile) {
+    const FillExtrusionPaintProperties::Evaluated& properties = layer.impl->paint.evaluated;
+
+    if (pass != RenderPass::Translucent) {
+        return;
+    }
+
+    // Light at the style specification defaults: viewport-anchored, radial
+    // 1.15, azimuthal 210°, polar 30°, white, intensity 0.5. Until the style
+    // model grows a light property, only the viewport anchoring varies, so
+    // the direction is rotated against the current bearing here.
+    const float azimuthal = (210.0f + 90.0f) * util::DEG2RAD - state.getAngle();
+    const float polar = 30.0f * util::DEG2RAD;
+    const std::array<float, 3> lightPos = {{
+        1.15f * std::cos(azimuthal) * std::sin(polar),
+        1.15f * std::sin(azimuthal) * std::sin(polar),
+        1.15f * std::cos(polar)
+    }};
+
+    // A single pass with a read-write depth buffer sorts the extruded faces:
+    // walls and roofs of all buildings in the tile are emitted in one draw
+    // and occlude each other per-fragment, with no geometry sorting.
+    parameters.programs.fillExtrusion.draw(
+        context,
+        gl::Triangles(),
+        depthModeForSublayer(0, gl::DepthMode::ReadWrite),
+        stencilModeForClipping(tile.clip),
+        colorModeForRenderPass(),
+        FillExtrusionProgram::UniformValues {
+            uniforms::u_matrix::Value{
+                tile.translatedMatrix(properties.get<FillExtrusionTranslate>(),
+                                      properties.get<FillExtrusionTranslateAnchor>(),
+                                      state)
+            },
+            uniforms::u_opacity::Value{ properties.get<FillExtrusionOpacity>() },
+            uniforms::u_lightcolor::Value{ {{ 1.0f, 1.0f, 1.0f }} },
+            uniforms::u_lightpos::Value{ lightPos },
+            uniforms::u_lightintensity::Value{ 0.5f },
+        },
+        *bucket.vertexBuffer,
+        *bucket.triangleIndexBuffer,
+        bucket.triangleSegments,
+        bucket.paintPropertyBinders.at(layer.getID()),
+        properties,
+        state.getZoom()
+    );
+}
+
+} // namespace mbgl
@@ -52,8 +52,10 @@ void Painter::renderRaster(PaintParameters& parameters,
     const RasterProgram::PaintPropertyBinders paintAttributeData(properties, 0);
 
     assert(bucket.texture);
+    // There is no parent/child cross-fade: both samplers read the same tile
+    // texture (u_fade_t is constant 1), so point them at one unit instead of
+    // binding the texture twice.
     context.bindTexture(*bucket.texture, 0, gl::TextureFilter::Linear);
-    context.bindTexture(*bucket.texture, 1, gl::TextureFilter::Linear);
 
     parameters.programs.raster.draw(
         context,
@@ -64,7 +66,7 @@ void Painter::renderRaster(PaintParameters& parameters,
         RasterProgram::UniformValues {
             uniforms::u_matrix::Value{ tile.matrix },
             uniforms::u_image0::Value{ 0 },
-            uniforms::u_image1::Value{ 1 },
+            uniforms::u_image1::Value{ 0 },
             uniforms::u_opacity::Value{ properties.get<RasterOpacity>() },
             uniforms::u_fade_t::Value{ 1 },
             uniforms::u_brightness_low::Value{ properties.get<RasterBrightnessMin>() },
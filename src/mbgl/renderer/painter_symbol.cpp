@@ -77,24 +77,37 @@ void Painter::renderSymbol(PaintParameters& parameters,
         const Size texsize = atlas.getSize();
 
         if (bucket.sdfIcons) {
-            if (values.hasHalo) {
+            // When the halo and fill colors match, compositing both from one
+            // distance sample in a single draw is exact; with contrasting
+            // colors, two passes keep all halos underneath all fills.
+            if (values.hasHalo && values.hasFill && values.haloMatchesFill) {
                 draw(parameters.programs.symbolIconSDF,
-                     SymbolSDFIconProgram::uniformValues(false, values, texsize, pixelsToGLUnits, tile, state, SymbolSDFPart::Halo),
-                     bucket.icon,
-                     bucket.iconSizeBinder,
-                     values,
-                     bucket.paintPropertyBinders.at(layer.getID()).first,
-                     paintPropertyValues);
-            }
-
-            if (values.hasFill) {
-                draw(parameters.programs.symbolIconSDF,
-                     SymbolSDFIconProgram::uniformValues(false, values, texsize, pixelsToGLUnits, tile, state, SymbolSDFPart::Fill),
+                     SymbolSDFIconProgram::uniformValues(false, values, texsize, pixelsToGLUnits, tile, state, SymbolSDFPart::Combined),
                      bucket.icon,
                      bucket.iconSizeBinder,
                      values,
                      bucket.paintPropertyBinders.at(layer.getID()).first,
                      paintPropertyValues);
+            } else {
+                if (values.hasHalo) {
+                    draw(parameters.programs.symbolIconSDF,
+                         SymbolSDFIconProgram::uniformValues(false, values, texsize, pixelsToGLUnits, tile, state, SymbolSDFPart::Halo),
+                         bucket.icon,
+                         bucket.iconSizeBinder,
+                         values,
+                         bucket.paintPropertyBinders.at(layer.getID()).first,
+                         paintPropertyValues);
+                }
+
+                if (values.hasFill) {
+                    draw(parameters.programs.symbolIconSDF,
+                         SymbolSDFIconProgram::uniformValues(false, values, texsize, pixelsToGLUnits, tile, state, SymbolSDFPart::Fill),
+                         bucket.icon,
+                         bucket.iconSizeBinder,
+                         values,
+                         bucket.paintPropertyBinders.at(layer.getID()).first,
+                         paintPropertyValues);
+                }
             }
         } else {
             draw(parameters.programs.symbolIcon,
@@ -108,31 +121,43 @@ void Painter::renderSymbol(PaintParameters& parameters,
     }
 
     if (bucket.hasTextData()) {
-        glyphAtlas->bind(context, 0);
+        // The glyph atlas gets its own texture unit so that layers drawing
+        // both icons and text don't rebind unit 0 on every other draw call.
+        glyphAtlas->bind(context, 2);
 
         auto values = layer.impl->textPropertyValues(layout);
         auto paintPropertyValues = layer.impl->textPaintProperties();
 
         const Size texsize = glyphAtlas->getSize();
 
-        if (values.hasHalo) {
+        if (values.hasHalo && values.hasFill && values.haloMatchesFill) {
             draw(parameters.programs.symbolGlyph,
-                 SymbolSDFTextProgram::uniformValues(true, values, texsize, pixelsToGLUnits, tile, state, SymbolSDFPart::Halo),
+                 SymbolSDFTextProgram::uniformValues(true, values, texsize, pixelsToGLUnits, tile, state, SymbolSDFPart::Combined),
                  bucket.text,
                  bucket.textSizeBinder,
                  values,
                  bucket.paintPropertyBinders.at(layer.getID()).second,
                  paintPropertyValues);
-        }
+        } else {
+            if (values.hasHalo) {
+                draw(parameters.programs.symbolGlyph,
+                     SymbolSDFTextProgram::uniformValues(true, values, texsize, pixelsToGLUnits, tile, state, SymbolSDFPart::Halo),
+                     bucket.text,
+                     bucket.textSizeBinder,
+                     values,
+                     bucket.paintPropertyBinders.at(layer.getID()).second,
+                     paintPropertyValues);
+            }
 
-        if (values.hasFill) {
-            draw(parameters.programs.symbolGlyph,
-                 SymbolSDFTextProgram::uniformValues(true, values, texsize, pixelsToGLUnits, tile, state, SymbolSDFPart::Fill),
-                 bucket.text,
-                 bucket.textSizeBinder,
-                 values,
-                 bucket.paintPropertyBinders.at(layer.getID()).second,
-                 paintPropertyValues);
+            if (values.hasFill) {
+                draw(parameters.programs.symbolGlyph,
+                     SymbolSDFTextProgram::uniformValues(true, values, texsize, pixelsToGLUnits, tile, state, SymbolSDFPart::Fill),
+                     bucket.text,
+                     bucket.textSizeBinder,
+                     values,
+                     bucket.paintPropertyBinders.at(layer.getID()).second,
+                     paintPropertyValues);
+            }
         }
     }
 
@@ -1,8 +1,8 @@
 #include <mbgl/renderer/raster_bucket.hpp>
 #include <mbgl/style/layers/raster_layer.hpp>
 #include <mbgl/programs/raster_program.hpp>
-#include <mbgl/renderer/painter.hpp>
 #include <mbgl/gl/context.hpp>
+#include <mbgl/util/logging.hpp>
 
 namespace mbgl {
 
@@ -11,16 +11,34 @@ using namespace style;
 RasterBucket::RasterBucket(UnassociatedImage&& image_) : image(std::move(image_)) {
 }
 
+RasterBucket::RasterBucket(CompressedImage&& compressedImage_)
+    : compressedImage(std::move(compressedImage_)) {
+}
+
 void RasterBucket::upload(gl::Context& context) {
-    texture = context.createTexture(std::move(image));
+    uploadedByteSize += uploadByteSize();
+
+    if (compressedImage) {
+        if (context.supportsETC2Textures()) {
+            texture = context.createCompressedTexture(*compressedImage);
+        } else {
+            // We can't decode ETC2 on the CPU; show nothing rather than
+            // garbage. Sources serving compressed tiles are expected to be
+            // paired with clients that support them.
+            Log::Error(Event::OpenGL,
+                       "Dropping compressed raster tile: no ETC2 texture support");
+            image = UnassociatedImage({ 1, 1 });
+            texture = context.createTexture(std::move(image));
+        }
+        compressedImage = {};
+    } else {
+        texture = context.createTexture(std::move(image));
+    }
     uploaded = true;
 }
 
-void RasterBucket::render(Painter& painter,
-                          PaintParameters& parameters,
-                          const Layer& layer,
-                          const RenderTile& tile) {
-    painter.renderRaster(parameters, *this, *layer.as<RasterLayer>(), tile);
+std::size_t RasterBucket::uploadByteSize() const {
+    return compressedImage ? compressedImage->dataSize : image.bytes();
 }
 
 bool RasterBucket::hasData() const {
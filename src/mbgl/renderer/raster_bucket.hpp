@@ -1,6 +1,7 @@
 #pragma once
 
 #include <mbgl/renderer/bucket.hpp>
+#include <mbgl/util/compressed_image.hpp>
 #include <mbgl/util/image.hpp>
 #include <mbgl/util/optional.hpp>
 #include <mbgl/gl/texture.hpp>
@@ -10,12 +11,14 @@ namespace mbgl {
 class RasterBucket : public Bucket {
 public:
     RasterBucket(UnassociatedImage&&);
+    RasterBucket(CompressedImage&&);
 
     void upload(gl::Context&) override;
-    void render(Painter&, PaintParameters&, const style::Layer&, const RenderTile&) override;
     bool hasData() const override;
+    std::size_t uploadByteSize() const override;
 
     UnassociatedImage image;
+    optional<CompressedImage> compressedImage;
     optional<gl::Texture> texture;
 };
 
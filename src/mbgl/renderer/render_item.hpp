@@ -1,5 +1,6 @@
 #pragma once
 
+#include <mbgl/util/arena.hpp>
 #include <mbgl/util/color.hpp>
 
 #include <unordered_set>
@@ -28,11 +29,23 @@ public:
     const style::Layer& layer;
 };
 
+// The draw list for one frame. Rebuilt every frame and discarded wholesale at
+// the end of it, so its containers come out of the painter's frame arena.
 class RenderData {
 public:
+    using Sources = std::unordered_set<style::Source*,
+                                       std::hash<style::Source*>,
+                                       std::equal_to<style::Source*>,
+                                       util::ArenaAllocator<style::Source*>>;
+
+    explicit RenderData(util::Arena& arena)
+        : sources(util::ArenaAllocator<style::Source*>(arena)),
+          order(util::ArenaAllocator<RenderItem>(arena)) {
+    }
+
     Color backgroundColor;
-    std::unordered_set<style::Source*> sources;
-    std::vector<RenderItem> order;
+    Sources sources;
+    util::ArenaVector<RenderItem> order;
 };
 
 } // namespace mbgl
@@ -1,5 +1,4 @@
 #include <mbgl/renderer/symbol_bucket.hpp>
-#include <mbgl/renderer/painter.hpp>
 #include <mbgl/style/bucket_parameters.hpp>
 #include <mbgl/style/layers/symbol_layer.hpp>
 #include <mbgl/style/layers/symbol_layer_impl.hpp>
@@ -34,6 +33,8 @@ SymbolBucket::SymbolBucket(style::SymbolLayoutProperties::PossiblyEvaluated layo
 }
 
 void SymbolBucket::upload(gl::Context& context) {
+    uploadedByteSize += uploadByteSize();
+
     if (hasTextData()) {
         text.vertexBuffer = context.createVertexBuffer(std::move(text.vertices));
         text.indexBuffer = context.createIndexBuffer(std::move(text.triangles));
@@ -59,11 +60,10 @@ void SymbolBucket::upload(gl::Context& context) {
     uploaded = true;
 }
 
-void SymbolBucket::render(Painter& painter,
-                          PaintParameters& parameters,
-                          const Layer& layer,
-                          const RenderTile& tile) {
-    painter.renderSymbol(parameters, *this, *layer.as<SymbolLayer>(), tile);
+std::size_t SymbolBucket::uploadByteSize() const {
+    return text.vertices.byteSize() + text.triangles.byteSize()
+        + icon.vertices.byteSize() + icon.triangles.byteSize()
+        + collisionBox.vertices.byteSize() + collisionBox.lines.byteSize();
 }
 
 bool SymbolBucket::hasData() const {
@@ -35,11 +35,17 @@ std::string programCachePath(const ProgramParameters& parameters, const char* na
            (parameters.overdraw ? ".overdraw.pbf" : ".pbf");
 }
 
-std::string programIdentifier(const std::string& vertexSource, const std::string& fragmentSource) {
+std::string programIdentifier(const std::string& vertexSource,
+                              const std::string& fragmentSource,
+                              const std::string& rendererSignature) {
     std::ostringstream ss;
     ss << std::setfill('0') << std::setw(sizeof(size_t) * 2) << std::hex;
     ss << std::hash<std::string>()(vertexSource);
     ss << std::hash<std::string>()(fragmentSource);
+    // Program binaries are tied to the driver that produced them; keying the
+    // identifier by the renderer makes a driver update a clean cache miss
+    // rather than a binary load that fails every startup.
+    ss << std::hash<std::string>()(rendererSignature);
     return ss.str();
 }
 
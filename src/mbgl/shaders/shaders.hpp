@@ -11,7 +11,9 @@ namespace shaders {
 std::string fragmentSource(const ProgramParameters&, const char* fragmentSource);
 std::string vertexSource(const ProgramParameters&, const char* vertexSource);
 std::string programCachePath(const ProgramParameters&, const char* name);
-std::string programIdentifier(const std::string& vertexSource, const std::string& fragmentSource);
+std::string programIdentifier(const std::string& vertexSource,
+                              const std::string& fragmentSource,
+                              const std::string& rendererSignature);
 
 } // namespace shaders
 } // namespace mbgl
@@ -168,6 +168,7 @@ const char* symbol_sdf::fragmentSource = R"MBGL_SHADER(
 #define EDGE_GAMMA 0.105/DEVICE_PIXEL_RATIO
 
 uniform bool u_is_halo;
+uniform bool u_is_combined;
 varying highp vec4 fill_color;
 varying highp vec4 halo_color;
 varying lowp float opacity;
@@ -193,6 +194,9 @@ void main() {
 
     float fontScale = u_is_text ? v_size / 24.0 : v_size;
 
+    lowp float dist = texture2D(u_texture, v_tex).a;
+    lowp float fade_alpha = texture2D(u_fadetexture, v_fade_tex).a;
+
     lowp vec4 color = fill_color;
     highp float gamma = EDGE_GAMMA / (fontScale * u_gamma_scale);
     lowp float buff = (256.0 - 64.0) / 256.0;
@@ -202,12 +206,20 @@ void main() {
         buff = (6.0 - halo_width / fontScale) / SDF_PX;
     }
 
-    lowp float dist = texture2D(u_texture, v_tex).a;
-    lowp float fade_alpha = texture2D(u_fadetexture, v_fade_tex).a;
     highp float gamma_scaled = gamma * v_gamma_scale;
-    highp float alpha = smoothstep(buff - gamma_scaled, buff + gamma_scaled, dist) * fade_alpha;
+    highp float alpha = smoothstep(buff - gamma_scaled, buff + gamma_scaled, dist);
+
+    if (u_is_combined) {
+        // Halo and fill share a color, so both can be derived from the one
+        // distance sample; compositing fill over halo here matches the
+        // two-pass result exactly while halving the draw calls.
+        highp float halo_gamma = (halo_blur * 1.19 / SDF_PX + EDGE_GAMMA) / (fontScale * u_gamma_scale) * v_gamma_scale;
+        lowp float halo_buff = (6.0 - halo_width / fontScale) / SDF_PX;
+        highp float halo_alpha = smoothstep(halo_buff - halo_gamma, halo_buff + halo_gamma, dist);
+        alpha = alpha + halo_alpha * (1.0 - alpha);
+    }
 
-    gl_FragColor = color * (alpha * opacity);
+    gl_FragColor = color * (alpha * fade_alpha * opacity);
 
 #ifdef OVERDRAW_INSPECTOR
     gl_FragColor = vec4(1.0);
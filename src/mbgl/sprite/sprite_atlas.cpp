@@ -8,6 +8,7 @@
 #include <mbgl/util/std.hpp>
 #include <mbgl/util/constants.hpp>
 #include <mbgl/util/exception.hpp>
+#include <mbgl/util/shared_parse_cache.hpp>
 #include <mbgl/storage/file_source.hpp>
 #include <mbgl/storage/resource.hpp>
 #include <mbgl/storage/response.hpp>
@@ -20,9 +21,24 @@ namespace mbgl {
 
 static SpriteAtlasObserver nullObserver;
 
+namespace {
+
+// Parsed sprite sheets, shared across atlases. The Sprites map holds
+// shared_ptr<const SpriteImage>, so map views showing the same style also
+// share the decoded icon pixels, not just the parse work. A sheet rarely
+// exceeds a couple of megabytes decoded and most processes use a handful of
+// styles, so a small cache suffices.
+util::SharedParseCache<Sprites>& spriteParseCache() {
+    static util::SharedParseCache<Sprites> cache(8);
+    return cache;
+}
+
+} // namespace
+
 struct SpriteAtlas::Loader {
     std::shared_ptr<const std::string> image;
     std::shared_ptr<const std::string> json;
+    std::string url;
     std::unique_ptr<AsyncRequest> jsonRequest;
     std::unique_ptr<AsyncRequest> spriteRequest;
 };
@@ -64,6 +80,7 @@ void SpriteAtlas::load(const std::string& url, FileSource& fileSource) {
     }
 
     loader = std::make_unique<Loader>();
+    loader->url = Resource::spriteImage(url, pixelRatio).url;
 
     loader->jsonRequest = fileSource.request(Resource::spriteJSON(url, pixelRatio), [this](Response res) {
         if (res.error) {
@@ -102,18 +119,26 @@ void SpriteAtlas::emitSpriteLoadedIfComplete() {
         return;
     }
 
-    auto result = parseSprite(*loader->image, *loader->json);
-    if (result.is<Sprites>()) {
-        loaded = true;
-        setSprites(result.get<Sprites>());
-        observer->onSpriteLoaded();
-        for (auto requestor : requestors) {
-            requestor->onIconsAvailable(this, buildIconMap());
+    std::shared_ptr<const Sprites> sprites =
+        spriteParseCache().get(loader->url, { loader->image, loader->json });
+
+    if (!sprites) {
+        auto result = parseSprite(*loader->image, *loader->json);
+        if (result.is<std::exception_ptr>()) {
+            observer->onSpriteError(result.get<std::exception_ptr>());
+            return;
         }
-        requestors.clear();
-    } else {
-        observer->onSpriteError(result.get<std::exception_ptr>());
+        sprites = std::make_shared<const Sprites>(std::move(result.get<Sprites>()));
+        spriteParseCache().put(loader->url, { loader->image, loader->json }, sprites);
     }
+
+    loaded = true;
+    setSprites(*sprites);
+    observer->onSpriteLoaded();
+    for (auto requestor : requestors) {
+        requestor->onIconsAvailable(this, buildIconMap());
+    }
+    requestors.clear();
 }
 
 void SpriteAtlas::setObserver(SpriteAtlasObserver* observer_) {
@@ -297,6 +322,18 @@ void SpriteAtlas::copy(const Entry& entry, optional<Rect<uint16_t>> Entry::*entr
         PremultipliedImage::copy(src, image, { 0,     0 }, { x + w, y }, { 1, h }); // R
     }
 
+    // Union the changed rows (including the wrapped padding) into the dirty
+    // band so the next upload can re-send just this part of the atlas.
+    const uint32_t top = y > 0 ? y - 1 : 0;
+    const uint32_t bottom = std::min(y + h + 1, image.size.height);
+    if (dirtyBottom == dirtyTop) {
+        dirtyTop = top;
+        dirtyBottom = bottom;
+    } else {
+        dirtyTop = std::min(dirtyTop, top);
+        dirtyBottom = std::max(dirtyBottom, bottom);
+    }
+
     dirty = true;
 }
 
@@ -316,7 +353,13 @@ void SpriteAtlas::upload(gl::Context& context, gl::TextureUnit unit) {
     if (!texture) {
         texture = context.createTexture(image, unit);
     } else if (dirty) {
-        context.updateTexture(*texture, image, unit);
+        if (dirtyBottom > dirtyTop) {
+            // Adding one runtime icon only re-sends the affected rows rather
+            // than the whole atlas.
+            context.updateTextureBand(*texture, image, dirtyTop, dirtyBottom - dirtyTop, unit);
+        } else {
+            context.updateTexture(*texture, image, unit);
+        }
     }
 
 #if not MBGL_USE_GLES2
@@ -328,6 +371,8 @@ void SpriteAtlas::upload(gl::Context& context, gl::TextureUnit unit) {
 #endif // MBGL_USE_GLES2
 
     dirty = false;
+    dirtyTop = 0;
+    dirtyBottom = 0;
 }
 
 void SpriteAtlas::bind(bool linear, gl::Context& context, gl::TextureUnit unit) {
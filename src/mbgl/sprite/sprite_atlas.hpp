@@ -2,6 +2,7 @@
 
 #include <mbgl/geometry/binpack.hpp>
 #include <mbgl/gl/texture.hpp>
+#include <mbgl/util/memory_stats.hpp>
 #include <mbgl/util/noncopyable.hpp>
 #include <mbgl/util/optional.hpp>
 #include <mbgl/sprite/sprite_image.hpp>
@@ -127,8 +128,15 @@ private:
     std::unordered_map<std::string, Entry> entries;
     BinPack<uint16_t> bin;
     PremultipliedImage image;
+    util::TrackedMemory imageMemory { MemoryCategory::Atlases, image.bytes() };
     mbgl::optional<gl::Texture> texture;
     bool dirty;
+
+    // Row band of `image` changed since the last upload, unioned across
+    // copies. When the texture already exists, only these rows are re-sent
+    // instead of the whole atlas. Empty when dirtyBottom == dirtyTop.
+    uint32_t dirtyTop = 0;
+    uint32_t dirtyBottom = 0;
     
     std::set<IconRequestor*> requestors;
     IconMap icons;
@@ -7,9 +7,13 @@
 #include <mbgl/util/rapidjson.hpp>
 #include <mbgl/util/string.hpp>
 
+#include <algorithm>
+#include <atomic>
 #include <cmath>
 #include <limits>
 #include <sstream>
+#include <thread>
+#include <vector>
 
 namespace mbgl {
 
@@ -104,22 +108,75 @@ SpriteParseResult parseSprite(const std::string& image, const std::string& json)
     } else if (!doc.IsObject()) {
         return std::make_exception_ptr(std::runtime_error("Sprite JSON root must be an object"));
     } else {
+        // Collect the metrics serially — JSON access is cheap — then fan the
+        // per-icon extraction out across a scoped thread team, with this
+        // thread taking part: for large sheets the hundreds of image copies
+        // dominate parse time, and each reads only the shared decoded sheet.
+        struct IconTask {
+            std::string name;
+            uint16_t x;
+            uint16_t y;
+            uint16_t width;
+            uint16_t height;
+            double pixelRatio;
+            bool sdf;
+            SpriteImagePtr sprite;
+        };
+
+        std::vector<IconTask> iconTasks;
+
         for (const auto& property : doc.GetObject()) {
             const std::string name = { property.name.GetString(), property.name.GetStringLength() };
             const JSValue& value = property.value;
 
             if (value.IsObject()) {
-                const uint16_t x = getUInt16(value, "x", 0);
-                const uint16_t y = getUInt16(value, "y", 0);
-                const uint16_t width = getUInt16(value, "width", 0);
-                const uint16_t height = getUInt16(value, "height", 0);
-                const double pixelRatio = getDouble(value, "pixelRatio", 1);
-                const bool sdf = getBoolean(value, "sdf", false);
-
-                auto sprite = createSpriteImage(raster, x, y, width, height, pixelRatio, sdf);
-                if (sprite) {
-                    sprites.emplace(name, sprite);
+                iconTasks.push_back(IconTask {
+                    name,
+                    getUInt16(value, "x", 0),
+                    getUInt16(value, "y", 0),
+                    getUInt16(value, "width", 0),
+                    getUInt16(value, "height", 0),
+                    getDouble(value, "pixelRatio", 1),
+                    getBoolean(value, "sdf", false),
+                    nullptr
+                });
+            }
+        }
+
+        auto runIconTask = [&] (IconTask& task) {
+            task.sprite = createSpriteImage(raster, task.x, task.y, task.width, task.height,
+                                            task.pixelRatio, task.sdf);
+        };
+
+        const std::size_t concurrency = std::min<std::size_t>(
+            std::max<std::size_t>(std::thread::hardware_concurrency(), 1), iconTasks.size());
+
+        if (concurrency > 1) {
+            std::atomic<std::size_t> nextTask { 0 };
+            auto consumeTasks = [&] {
+                for (std::size_t i = nextTask++; i < iconTasks.size(); i = nextTask++) {
+                    runIconTask(iconTasks[i]);
                 }
+            };
+
+            std::vector<std::thread> team;
+            team.reserve(concurrency - 1);
+            for (std::size_t i = 0; i < concurrency - 1; ++i) {
+                team.emplace_back(consumeTasks);
+            }
+            consumeTasks();
+            for (auto& thread : team) {
+                thread.join();
+            }
+        } else {
+            for (auto& task : iconTasks) {
+                runIconTask(task);
+            }
+        }
+
+        for (auto& task : iconTasks) {
+            if (task.sprite) {
+                sprites.emplace(std::move(task.name), std::move(task.sprite));
             }
         }
     }
@@ -0,0 +1,93 @@
+#include <mbgl/storage/network_quality.hpp>
+
+namespace mbgl {
+
+namespace {
+
+// TCP-style smoothing: each new sample moves the average by an eighth.
+constexpr double alpha = 0.125;
+
+// Transfers smaller than this are dominated by round trips and carry no
+// bandwidth signal.
+constexpr uint64_t minBandwidthSampleBytes = 4096;
+
+// Completed transfers needed before the classification is trusted.
+constexpr uint32_t minSamples = 4;
+
+constexpr double degradedLatencyMs = 300;
+constexpr double poorLatencyMs = 1000;
+constexpr double degradedBytesPerSecond = 128 * 1024;
+constexpr double poorBytesPerSecond = 32 * 1024;
+
+} // namespace
+
+std::mutex NetworkQuality::mtx;
+double NetworkQuality::smoothedLatencyMs = 0;
+double NetworkQuality::smoothedBytesPerSecond = 0;
+uint32_t NetworkQuality::latencySamples = 0;
+uint32_t NetworkQuality::bandwidthSamples = 0;
+
+void NetworkQuality::RecordTransfer(uint64_t bytes, Duration elapsed) {
+    const double ms = std::chrono::duration<double, std::milli>(elapsed).count();
+    if (ms <= 0) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(mtx);
+    smoothedLatencyMs = latencySamples == 0
+                            ? ms
+                            : smoothedLatencyMs + alpha * (ms - smoothedLatencyMs);
+    latencySamples++;
+
+    if (bytes >= minBandwidthSampleBytes) {
+        const double bytesPerSecond = double(bytes) * 1000.0 / ms;
+        smoothedBytesPerSecond =
+            bandwidthSamples == 0
+                ? bytesPerSecond
+                : smoothedBytesPerSecond + alpha * (bytesPerSecond - smoothedBytesPerSecond);
+        bandwidthSamples++;
+    }
+}
+
+NetworkQuality::Level NetworkQuality::Get() {
+    std::lock_guard<std::mutex> lock(mtx);
+    if (latencySamples < minSamples) {
+        return Level::Unknown;
+    }
+
+    // The bandwidth average only participates once it has seen enough
+    // data-bearing transfers of its own; a burst of validation hits must not
+    // leave a stale bandwidth reading in charge.
+    const bool bandwidthKnown = bandwidthSamples >= minSamples;
+
+    if (smoothedLatencyMs > poorLatencyMs ||
+        (bandwidthKnown && smoothedBytesPerSecond < poorBytesPerSecond)) {
+        return Level::Poor;
+    }
+    if (smoothedLatencyMs > degradedLatencyMs ||
+        (bandwidthKnown && smoothedBytesPerSecond < degradedBytesPerSecond)) {
+        return Level::Degraded;
+    }
+    return Level::Good;
+}
+
+Duration NetworkQuality::GetLatency() {
+    std::lock_guard<std::mutex> lock(mtx);
+    return std::chrono::duration_cast<Duration>(
+        std::chrono::duration<double, std::milli>(smoothedLatencyMs));
+}
+
+uint64_t NetworkQuality::GetDownstreamBandwidth() {
+    std::lock_guard<std::mutex> lock(mtx);
+    return static_cast<uint64_t>(smoothedBytesPerSecond);
+}
+
+void NetworkQuality::Reset() {
+    std::lock_guard<std::mutex> lock(mtx);
+    smoothedLatencyMs = 0;
+    smoothedBytesPerSecond = 0;
+    latencySamples = 0;
+    bandwidthSamples = 0;
+}
+
+} // namespace mbgl
@@ -1,11 +1,14 @@
 #include <mapbox/geometry/box.hpp>
 #include <mbgl/storage/resource.hpp>
 #include <mbgl/util/constants.hpp>
+#include <mbgl/util/itoa.hpp>
 #include <mbgl/util/string.hpp>
 #include <mbgl/util/token.hpp>
 #include <mbgl/util/url.hpp>
 
 #include <cmath>
+#include <map>
+#include <vector>
 
 namespace mbgl {
 
@@ -39,6 +42,158 @@ static std::string getTileBBox(int32_t x, int32_t y, int8_t z) {
             util::toString(max.x) + "," + util::toString(max.y));
 }
 
+namespace {
+
+/*
+    A tile URL template split once into literal spans and tokens, so that
+    per-tile URL construction is appends and integer formatting into a
+    single reserved string instead of re-scanning the template for braces
+    and formatting coordinates through generic string conversion. Tiles are
+    requested in bursts against a handful of templates — one per source —
+    so compilations are cached per thread (the map thread and the FileSource
+    thread both construct tile resources).
+
+    The token grammar matches util::replaceTokens: an unterminated or
+    brace-containing token is kept literally, an unrecognized token name
+    expands to nothing.
+*/
+class TileURLTemplate {
+public:
+    static const TileURLTemplate& compile(const std::string& urlTemplate) {
+        static thread_local std::map<std::string, TileURLTemplate> cache;
+
+        auto it = cache.find(urlTemplate);
+        if (it == cache.end()) {
+            it = cache.emplace(urlTemplate, TileURLTemplate(urlTemplate)).first;
+        }
+        return it->second;
+    }
+
+    std::string assemble(float pixelRatio, int32_t x, int32_t y, int8_t z) const {
+        std::string url;
+        url.reserve(reserveSize);
+
+        char buffer[11];
+        for (const auto& segment : segments) {
+            switch (segment.token) {
+            case Token::Literal:
+                url.append(segment.literal);
+                break;
+            case Token::Z:
+                url.append(buffer, util::itoa(static_cast<int32_t>(z), buffer));
+                break;
+            case Token::X:
+                url.append(buffer, util::itoa(x, buffer));
+                break;
+            case Token::Y:
+                url.append(buffer, util::itoa(y, buffer));
+                break;
+            case Token::QuadKey:
+                url.append(getQuadKey(x, y, z));
+                break;
+            case Token::BBox:
+                url.append(getTileBBox(x, y, z));
+                break;
+            case Token::Prefix:
+                url += "0123456789abcdef"[x % 16];
+                url += "0123456789abcdef"[y % 16];
+                break;
+            case Token::Ratio:
+                if (pixelRatio > 1.0) {
+                    url.append("@2x");
+                }
+                break;
+            case Token::Unknown:
+                break;
+            }
+        }
+
+        return url;
+    }
+
+    bool supportsRatio() const {
+        return hasRatio;
+    }
+
+private:
+    enum class Token : uint8_t { Literal, Z, X, Y, QuadKey, BBox, Prefix, Ratio, Unknown };
+
+    struct Segment {
+        Token token;
+        std::string literal; // Only set for Token::Literal.
+    };
+
+    explicit TileURLTemplate(const std::string& urlTemplate) {
+        auto pos = urlTemplate.begin();
+        const auto end = urlTemplate.end();
+
+        while (pos != end) {
+            auto brace = std::find(pos, end, '{');
+            appendLiteral({ pos, brace });
+            pos = brace;
+            if (pos != end) {
+                for (brace++; brace != end && util::tokenReservedChars.find(*brace) == std::string::npos; brace++);
+                if (brace != end && *brace == '}') {
+                    appendToken({ pos + 1, brace });
+                    pos = brace + 1;
+                } else {
+                    appendLiteral({ pos, brace });
+                    pos = brace;
+                }
+            }
+        }
+    }
+
+    void appendLiteral(const std::string& literal) {
+        if (literal.empty()) {
+            return;
+        }
+        // Adjacent literals (e.g. around an unterminated brace) coalesce.
+        if (!segments.empty() && segments.back().token == Token::Literal) {
+            segments.back().literal.append(literal);
+        } else {
+            segments.push_back({ Token::Literal, literal });
+        }
+        reserveSize += literal.size();
+    }
+
+    void appendToken(const std::string& name) {
+        Token token = Token::Unknown;
+        size_t estimate = 0;
+        if (name == "z") {
+            token = Token::Z;
+            estimate = 2;
+        } else if (name == "x") {
+            token = Token::X;
+            estimate = 7;
+        } else if (name == "y") {
+            token = Token::Y;
+            estimate = 7;
+        } else if (name == "quadkey") {
+            token = Token::QuadKey;
+            estimate = 20;
+        } else if (name == "bbox-epsg-3857") {
+            token = Token::BBox;
+            estimate = 80;
+        } else if (name == "prefix") {
+            token = Token::Prefix;
+            estimate = 2;
+        } else if (name == "ratio") {
+            token = Token::Ratio;
+            hasRatio = true;
+            estimate = 3;
+        }
+        segments.push_back({ token, {} });
+        reserveSize += estimate;
+    }
+
+    std::vector<Segment> segments;
+    size_t reserveSize = 0;
+    bool hasRatio = false;
+};
+
+} // namespace
+
 Resource Resource::style(const std::string& url) {
     return Resource {
         Resource::Kind::Style,
@@ -89,37 +244,16 @@ Resource Resource::tile(const std::string& urlTemplate,
                         int8_t z,
                         Tileset::Scheme scheme,
                         Necessity necessity) {
-    bool supportsRatio = urlTemplate.find("{ratio}") != std::string::npos;
+    const TileURLTemplate& compiled = TileURLTemplate::compile(urlTemplate);
     if (scheme == Tileset::Scheme::TMS) {
         y = (1 << z) - y - 1;
     }
     return Resource {
         Resource::Kind::Tile,
-        util::replaceTokens(urlTemplate, [&](const std::string& token) {
-            if (token == "z") {
-                return util::toString(z);
-            } else if (token == "x") {
-                return util::toString(x);
-            } else if (token == "y") {
-                return util::toString(y);
-            } else if (token == "quadkey") {
-                return getQuadKey(x, y, z);
-            } else if (token == "bbox-epsg-3857") {
-                return getTileBBox(x, y, z);
-            } else if (token == "prefix") {
-                std::string prefix{ 2 };
-                prefix[0] = "0123456789abcdef"[x % 16];
-                prefix[1] = "0123456789abcdef"[y % 16];
-                return prefix;
-            } else if (token == "ratio") {
-                return std::string(pixelRatio > 1.0 ? "@2x" : "");
-            } else {
-                return std::string();
-            }
-        }),
+        compiled.assemble(pixelRatio, x, y, z),
         Resource::TileData {
             urlTemplate,
-            uint8_t(supportsRatio && pixelRatio > 1.0 ? 2 : 1),
+            uint8_t(compiled.supportsRatio() && pixelRatio > 1.0 ? 2 : 1),
             x,
             y,
             z
@@ -1,8 +1,11 @@
 #pragma once
 
+#include <mbgl/actor/task.hpp>
 #include <mbgl/map/mode.hpp>
 #include <mbgl/tile/tile_id.hpp>
 
+#include <cstdint>
+
 namespace mbgl {
 namespace style {
 
@@ -10,6 +13,17 @@ class BucketParameters {
 public:
     const OverscaledTileID tileID;
     const MapMode mode;
+
+    // The tile's cancellation token. Buckets and layouts keep a copy so that
+    // long feature loops (tessellation, shaping) can drop out mid-bucket once
+    // the tile is gone, instead of only between worker messages.
+    const TaskToken token;
+
+    // Identity of the glyph source (the owning style's GlyphAtlas) this tile
+    // shapes against. Used purely as a cache discriminator — never
+    // dereferenced — so styles with identically named fontstacks but
+    // different glyph endpoints don't share shaping results.
+    const uintptr_t glyphAtlasIdentity;
 };
 
 } // namespace style
@@ -0,0 +1,77 @@
+#include <mbgl/style/compiled_filter.hpp>
+#include <mbgl/style/filter_evaluator.hpp>
+
+namespace mbgl {
+namespace style {
+
+namespace {
+
+struct CollectFilterKeys {
+    std::vector<const std::string*>& keys;
+
+    void operator()(const EqualsFilter& f) { keys.push_back(&f.key); }
+    void operator()(const NotEqualsFilter& f) { keys.push_back(&f.key); }
+    void operator()(const LessThanFilter& f) { keys.push_back(&f.key); }
+    void operator()(const LessThanEqualsFilter& f) { keys.push_back(&f.key); }
+    void operator()(const GreaterThanFilter& f) { keys.push_back(&f.key); }
+    void operator()(const GreaterThanEqualsFilter& f) { keys.push_back(&f.key); }
+    void operator()(const InFilter& f) { keys.push_back(&f.key); }
+    void operator()(const NotInFilter& f) { keys.push_back(&f.key); }
+    void operator()(const HasFilter& f) { keys.push_back(&f.key); }
+    void operator()(const NotHasFilter& f) { keys.push_back(&f.key); }
+
+    void operator()(const AnyFilter& f) { collect(f.filters); }
+    void operator()(const AllFilter& f) { collect(f.filters); }
+    void operator()(const NoneFilter& f) { collect(f.filters); }
+
+    // Null, type, and identifier filters reference no property keys.
+    template <class F>
+    void operator()(const F&) {}
+
+    void collect(const std::vector<Filter>& filters) {
+        for (const auto& filter : filters) {
+            Filter::visit(filter, *this);
+        }
+    }
+};
+
+} // namespace
+
+CompiledFilter::CompiledFilter(const Filter& filter_, const GeometryTileLayer& layer)
+    : filter(filter_) {
+    if (!layer.hasKeyTable()) {
+        return;
+    }
+
+    std::vector<const std::string*> keys;
+    CollectFilterKeys collector { keys };
+    Filter::visit(filter, collector);
+
+    boundKeys.reserve(keys.size());
+    for (const std::string* key : keys) {
+        boundKeys.push_back(BoundKey { key, layer.getKeyIndex(*key) });
+    }
+}
+
+bool CompiledFilter::operator()(const GeometryTileFeature& feature) const {
+    return filter(feature.getType(), feature.getID(), [&] (const std::string& key) -> optional<Value> {
+        // The evaluator passes references to the filter's own key strings,
+        // so bound keys can be identified by address. The list is as short
+        // as the filter itself; a linear scan beats hashing.
+        for (const auto& bound : boundKeys) {
+            if (bound.key != &key) {
+                continue;
+            }
+            if (!bound.index) {
+                // The key table covers every property in the layer, so a
+                // key it does not contain is absent from every feature.
+                return {};
+            }
+            return feature.getValueForKeyIndex(*bound.index);
+        }
+        return feature.getValue(key);
+    });
+}
+
+} // namespace style
+} // namespace mbgl
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <mbgl/style/filter.hpp>
+#include <mbgl/tile/geometry_tile_data.hpp>
+
+#include <vector>
+
+namespace mbgl {
+namespace style {
+
+/*
+   A Filter bound to the key table of a particular tile layer.
+
+   Evaluating a filter calls back into the feature once per property key the
+   filter names, and for vector tile features every such call hashes the key
+   into the layer's key map. Binding the filter resolves each key to its
+   table index once, so per-feature evaluation compares integer tag keys
+   instead. Keys the table does not contain are answered without touching
+   the feature at all, and layers without a key table fall back to the
+   string path unchanged.
+
+   The referenced filter must outlive the CompiledFilter.
+*/
+class CompiledFilter {
+public:
+    CompiledFilter(const Filter&, const GeometryTileLayer&);
+
+    bool operator()(const GeometryTileFeature&) const;
+
+private:
+    struct BoundKey {
+        const std::string* key;
+        optional<uint32_t> index;
+    };
+
+    const Filter& filter;
+    std::vector<BoundKey> boundKeys;
+};
+
+} // namespace style
+} // namespace mbgl
@@ -0,0 +1,96 @@
+#pragma once
+
+#include <mbgl/tile/geometry_tile_data.hpp>
+#include <mbgl/util/feature.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace mbgl {
+namespace style {
+
+// Runtime key/value state attached to individual features, keyed by the
+// feature's numeric id. State is owned per source and consulted when
+// data-driven paint functions are evaluated, so changing it restyles a
+// feature (hover highlight, selection) without any relayout.
+//
+// One state holds a handful of entries, but a source can carry state for
+// thousands of features at once, so the entries live in a sorted flat
+// vector: no per-node heap blocks or hash buckets, and lookups are a binary
+// search over contiguous memory.
+class FeatureState {
+public:
+    FeatureState() = default;
+
+    // States arrive through the public API as a PropertyMap; the entries are
+    // copied once here and stay in key order from then on.
+    explicit FeatureState(const PropertyMap& values) {
+        entries.reserve(values.size());
+        for (const auto& pair : values) {
+            entries.emplace_back(pair.first, pair.second);
+        }
+        std::sort(entries.begin(), entries.end(),
+                  [](const auto& a, const auto& b) { return a.first < b.first; });
+    }
+
+    bool empty() const {
+        return entries.empty();
+    }
+
+    const Value* get(const std::string& key) const {
+        const auto it = std::lower_bound(
+            entries.begin(), entries.end(), key,
+            [](const auto& entry, const std::string& k) { return entry.first < k; });
+        return it != entries.end() && it->first == key ? &it->second : nullptr;
+    }
+
+private:
+    std::vector<std::pair<std::string, Value>> entries;
+};
+
+using FeatureStates = std::unordered_map<uint64_t, FeatureState>;
+
+// A feature as seen through its current state: state values take precedence
+// over the feature's own attributes, so a paint function keyed on a state
+// attribute re-evaluates against the latest state. An empty state leaves the
+// feature unchanged, which is how cleared features return to base values.
+class FeatureStateFeature : public GeometryTileFeature {
+public:
+    FeatureStateFeature(const GeometryTileFeature& feature_, const FeatureState& state_)
+        : feature(feature_), state(state_) {
+    }
+
+    FeatureType getType() const override {
+        return feature.getType();
+    }
+
+    optional<Value> getValue(const std::string& key) const override {
+        if (const Value* value = state.get(key)) {
+            return *value;
+        }
+        return feature.getValue(key);
+    }
+
+    const PropertyMap& getProperties() const override {
+        return feature.getProperties();
+    }
+
+    optional<FeatureIdentifier> getID() const override {
+        return feature.getID();
+    }
+
+    GeometryCollection getGeometries() const override {
+        return feature.getGeometries();
+    }
+
+private:
+    const GeometryTileFeature& feature;
+    const FeatureState& state;
+};
+
+} // namespace style
+} // namespace mbgl
@@ -32,15 +32,16 @@ std::string layoutKey(const Layer& layer) {
     return s.GetString();
 }
 
-std::vector<std::vector<const Layer*>> groupByLayout(const std::vector<std::unique_ptr<Layer>>& layers) {
+std::vector<LayoutGroup> groupByLayout(const std::vector<std::unique_ptr<Layer>>& layers) {
     std::unordered_map<std::string, std::vector<const Layer*>> map;
     for (auto& layer : layers) {
         map[layoutKey(*layer)].push_back(layer.get());
     }
 
-    std::vector<std::vector<const Layer*>> result;
+    std::vector<LayoutGroup> result;
+    result.reserve(map.size());
     for (auto& pair : map) {
-        result.push_back(pair.second);
+        result.push_back(LayoutGroup { pair.first, std::move(pair.second) });
     }
 
     return result;
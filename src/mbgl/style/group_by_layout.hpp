@@ -1,5 +1,6 @@
 #pragma once
 
+#include <string>
 #include <vector>
 #include <memory>
 
@@ -8,7 +9,21 @@ namespace style {
 
 class Layer;
 
-std::vector<std::vector<const Layer*>> groupByLayout(const std::vector<std::unique_ptr<Layer>>&);
+// Serializes the properties that determine a layer's layout: type, source,
+// source layer, zoom range, visibility, filter, and layout properties. Layers
+// with equal keys produce byte-identical buckets from the same tile data.
+std::string layoutKey(const Layer&);
+
+// Layers that share a layout key, and the key itself. The key is stable for
+// as long as the layers are unmodified, so callers can hold on to the
+// assignment across relayouts and key bucket caches on it instead of
+// re-serializing every layer.
+struct LayoutGroup {
+    std::string key;
+    std::vector<const Layer*> layers;
+};
+
+std::vector<LayoutGroup> groupByLayout(const std::vector<std::unique_ptr<Layer>>&);
 
 } // namespace style
 } // namespace mbgl
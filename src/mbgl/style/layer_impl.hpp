@@ -5,6 +5,7 @@
 #include <mbgl/style/filter.hpp>
 #include <mbgl/style/layer_observer.hpp>
 #include <mbgl/renderer/render_pass.hpp>
+#include <mbgl/util/interned_string.hpp>
 #include <mbgl/util/noncopyable.hpp>
 #include <mbgl/tile/geometry_tile_data.hpp>
 
@@ -78,6 +79,11 @@ public:
 
     void setObserver(LayerObserver*);
 
+    // Interned handle for `id`: per-frame bucket lookups hash this integer
+    // instead of the full id string. Resolved on first use; a layer's id
+    // never changes after creation (clones carry a fresh cache).
+    util::StringID internedID() const { return internedIDCache.get(id); }
+
 public:
     std::string id;
     std::string source;
@@ -98,6 +104,9 @@ protected:
     // Stores what render passes this layer is currently enabled for. This depends on the
     // evaluated StyleProperties object and is updated accordingly.
     RenderPass passes = RenderPass::None;
+
+private:
+    util::CachedStringID internedIDCache;
 };
 
 } // namespace style
@@ -48,7 +48,7 @@ void CustomLayer::Impl::deinitialize() {
     }
 }
 
-void CustomLayer::Impl::render(const TransformState& state) const {
+void CustomLayer::Impl::render(const TransformState& state, const mat4& projMatrix) const {
     assert(renderFn);
 
     CustomLayerRenderParameters parameters;
@@ -61,6 +61,9 @@ void CustomLayer::Impl::render(const TransformState& state) const {
     parameters.bearing = -state.getAngle() * util::RAD2DEG;
     parameters.pitch = state.getPitch();
     parameters.fieldOfView = state.getFieldOfView();
+    // Hand the layer the very matrix the map is drawing with, rather than
+    // having it reconstruct the camera from the angles above.
+    parameters.projectionMatrix = projMatrix;
 
     renderFn(context, parameters);
 }
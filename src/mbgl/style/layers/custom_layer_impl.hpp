@@ -2,6 +2,7 @@
 
 #include <mbgl/style/layer_impl.hpp>
 #include <mbgl/style/layers/custom_layer.hpp>
+#include <mbgl/util/mat4.hpp>
 
 namespace mbgl {
 
@@ -22,7 +23,7 @@ public:
 
     void initialize();
     void deinitialize();
-    void render(const TransformState&) const;
+    void render(const TransformState&, const mat4& projMatrix) const;
 
 private:
     std::unique_ptr<Layer> clone() const override;
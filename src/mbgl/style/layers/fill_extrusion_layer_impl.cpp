@@ -1,18 +1,27 @@
 #include <mbgl/style/layers/fill_extrusion_layer_impl.hpp>
-#include <mbgl/renderer/bucket.hpp>
+#include <mbgl/renderer/fill_extrusion_bucket.hpp>
 
 namespace mbgl {
 namespace style {
 
-void FillExtrusionLayer::Impl::cascade(const CascadeParameters&) {
+void FillExtrusionLayer::Impl::cascade(const CascadeParameters& parameters) {
+    paint.cascade(parameters);
 }
 
-bool FillExtrusionLayer::Impl::evaluate(const PropertyEvaluationParameters&) {
-    return false;
+bool FillExtrusionLayer::Impl::evaluate(const PropertyEvaluationParameters& parameters) {
+    paint.evaluate(parameters);
+
+    // Extrusions always go through the translucent pass: even at full
+    // opacity, the lit faces blend against whatever was drawn below while
+    // the camera moves.
+    passes = (paint.evaluated.get<FillExtrusionOpacity>() > 0)
+        ? RenderPass::Translucent : RenderPass::None;
+
+    return paint.hasTransition();
 }
 
-std::unique_ptr<Bucket> FillExtrusionLayer::Impl::createBucket(const BucketParameters&, const std::vector<const Layer*>&) const {
-    return nullptr;
+std::unique_ptr<Bucket> FillExtrusionLayer::Impl::createBucket(const BucketParameters& parameters, const std::vector<const Layer*>& layers) const {
+    return std::make_unique<FillExtrusionBucket>(parameters, layers);
 }
 
 } // namespace style
@@ -0,0 +1,19 @@
+#include <mbgl/style/layers/heatmap_layer_impl.hpp>
+#include <mbgl/renderer/bucket.hpp>
+
+namespace mbgl {
+namespace style {
+
+void HeatmapLayer::Impl::cascade(const CascadeParameters&) {
+}
+
+bool HeatmapLayer::Impl::evaluate(const PropertyEvaluationParameters&) {
+    return false;
+}
+
+std::unique_ptr<Bucket> HeatmapLayer::Impl::createBucket(const BucketParameters&, const std::vector<const Layer*>&) const {
+    return nullptr;
+}
+
+} // namespace style
+} // namespace mbgl
@@ -0,0 +1,37 @@
+// This file is generated. Edit scripts/generate-style-code.js, then run `make style-code`.
+
+#pragma once
+
+#include <mbgl/style/types.hpp>
+#include <mbgl/style/layout_property.hpp>
+#include <mbgl/style/paint_property.hpp>
+#include <mbgl/programs/attributes.hpp>
+
+namespace mbgl {
+namespace style {
+
+struct HeatmapRadius : PaintProperty<float> {
+    static float defaultValue() { return 30; }
+};
+
+struct HeatmapWeight : DataDrivenPaintProperty<float, attributes::a_weight> {
+    static float defaultValue() { return 1; }
+};
+
+struct HeatmapIntensity : PaintProperty<float> {
+    static float defaultValue() { return 1; }
+};
+
+struct HeatmapOpacity : PaintProperty<float> {
+    static float defaultValue() { return 1; }
+};
+
+class HeatmapPaintProperties : public PaintProperties<
+    HeatmapRadius,
+    HeatmapWeight,
+    HeatmapIntensity,
+    HeatmapOpacity
+> {};
+
+} // namespace style
+} // namespace mbgl
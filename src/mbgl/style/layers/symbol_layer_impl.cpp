@@ -79,7 +79,9 @@ SymbolPropertyValues SymbolLayer::Impl::iconPropertyValues(const SymbolLayoutPro
         1.0f,
         paint.evaluated.get<IconHaloColor>().constantOr(Color::black()).a > 0 &&
             paint.evaluated.get<IconHaloWidth>().constantOr(1),
-        paint.evaluated.get<IconColor>().constantOr(Color::black()).a > 0
+        paint.evaluated.get<IconColor>().constantOr(Color::black()).a > 0,
+        paint.evaluated.get<IconHaloColor>().isConstant() &&
+            paint.evaluated.get<IconHaloColor>().constant() == paint.evaluated.get<IconColor>().constant()
     };
 }
 
@@ -94,7 +96,9 @@ SymbolPropertyValues SymbolLayer::Impl::textPropertyValues(const SymbolLayoutPro
         24.0f,
         paint.evaluated.get<TextHaloColor>().constantOr(Color::black()).a > 0 &&
             paint.evaluated.get<TextHaloWidth>().constantOr(1),
-        paint.evaluated.get<TextColor>().constantOr(Color::black()).a > 0
+        paint.evaluated.get<TextColor>().constantOr(Color::black()).a > 0,
+        paint.evaluated.get<TextHaloColor>().isConstant() &&
+            paint.evaluated.get<TextHaloColor>().constant() == paint.evaluated.get<TextColor>().constant()
     };
 }
 
@@ -54,7 +54,12 @@ public:
     float sdfScale;   // Constant (1.0 or 24.0)
     
     bool hasHalo;
-    bool hasFill;    
+    bool hasFill;
+
+    // True when the halo and fill colors are constant and identical. Same-color
+    // compositing is order-independent across glyphs, so both can be derived
+    // from one distance sample in a single draw instead of two passes.
+    bool haloMatchesFill;
 };
 
 class SymbolLayer::Impl : public Layer::Impl {
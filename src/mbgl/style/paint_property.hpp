@@ -42,6 +42,8 @@ public:
 
     template <class Evaluator>
     auto evaluate(const Evaluator& evaluator, TimePoint now) {
+        evaluatedOnce = true;
+
         auto finalValue = value.evaluate(evaluator);
         if (!prior) {
             // No prior value.
@@ -70,6 +72,15 @@ public:
         return bool(prior);
     }
 
+    // Whether evaluate() may produce a different result than it did last
+    // frame. Zoom-constant values without an active transition cannot, so
+    // once evaluated they can be skipped until the next cascade replaces
+    // this object. Data-driven source functions are zoom-constant; camera
+    // and composite functions are not.
+    bool needsEvaluation() const {
+        return !evaluatedOnce || bool(prior) || !value.isZoomConstant();
+    }
+
     bool isUndefined() const {
         return value.isUndefined();
     }
@@ -83,6 +94,7 @@ private:
     TimePoint begin;
     TimePoint end;
     Value value;
+    bool evaluatedOnce = false;
 };
 
 template <class Value>
@@ -151,6 +163,7 @@ public:
     using EvaluatorType = PropertyEvaluator<T>;
     using EvaluatedType = T;
     static constexpr bool IsDataDriven = false;
+    static constexpr bool AlwaysEvaluate = false;
 };
 
 template <class T, class A>
@@ -162,6 +175,7 @@ public:
     using EvaluatorType = DataDrivenPropertyEvaluator<T>;
     using EvaluatedType = PossiblyEvaluatedPropertyValue<T>;
     static constexpr bool IsDataDriven = true;
+    static constexpr bool AlwaysEvaluate = false;
 
     using Type = T;
     using Attribute = A;
@@ -176,6 +190,9 @@ public:
     using EvaluatorType = CrossFadedPropertyEvaluator<T>;
     using EvaluatedType = Faded<T>;
     static constexpr bool IsDataDriven = false;
+    // The cross-fade factor follows the zoom history, so even constant
+    // values re-evaluate every frame.
+    static constexpr bool AlwaysEvaluate = true;
 };
 
 template <class P>
@@ -244,10 +261,15 @@ public:
             .evaluate(Evaluator(parameters, P::defaultValue()), parameters.now);
     }
 
+    // Evaluates in place: each property's result is assigned into its
+    // existing slot rather than rebuilding the whole Evaluated tuple, and
+    // properties whose result cannot have changed since the last frame are
+    // skipped entirely. This keeps per-frame transition evaluation free of
+    // heap traffic for everything but genuinely zoom-dependent values.
     void evaluate(const PropertyEvaluationParameters& parameters) {
-        evaluated = Evaluated {
-            evaluate<Ps>(parameters)...
-        };
+        util::ignore({
+            (evaluateInPlace<Ps>(parameters), 0)...
+        });
     }
 
     bool hasTransition() const {
@@ -256,6 +278,16 @@ public:
         return result;
     }
 
+private:
+    template <class P>
+    void evaluateInPlace(const PropertyEvaluationParameters& parameters) {
+        if (!P::AlwaysEvaluate && !unevaluated.template get<P>().needsEvaluation()) {
+            return;
+        }
+        evaluated.template get<P>() = evaluate<P>(parameters);
+    }
+
+public:
     Cascading cascading;
     Unevaluated unevaluated;
     Evaluated evaluated;
@@ -3,8 +3,15 @@
 #include <mbgl/programs/attributes.hpp>
 #include <mbgl/gl/attribute.hpp>
 #include <mbgl/gl/uniform.hpp>
+#include <mbgl/style/function/compiled_stops.hpp>
 #include <mbgl/util/type_list.hpp>
 
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <memory>
+#include <vector>
+
 namespace mbgl {
 namespace style {
 
@@ -22,22 +29,22 @@ inline std::array<float, 1> attributeValue(float v) {
 }
 
 /*
-    Encode a four-component color value into a pair of floats.  Since csscolorparser
-    uses 8-bit precision for each color component, for each float we use the upper 8
+    Encode a four-component color value into a pair of uint16's.  Since csscolorparser
+    uses 8-bit precision for each color component, for each value we use the upper 8
     bits for one component (e.g. (color.r * 255) * 256), and the lower 8 for another.
-    
+
     Also note that colors come in as floats 0..1, so we scale by 255.
 */
-inline std::array<float, 2> attributeValue(const Color& color) {
+inline std::array<uint16_t, 2> attributeValue(const Color& color) {
     return {{
-        static_cast<float>(mbgl::attributes::packUint8Pair(255 * color.r, 255 * color.g)),
-        static_cast<float>(mbgl::attributes::packUint8Pair(255 * color.b, 255 * color.a))
+        mbgl::attributes::packUint8Pair(255 * color.r, 255 * color.g),
+        mbgl::attributes::packUint8Pair(255 * color.b, 255 * color.a)
     }};
 }
 
-template <size_t N>
-std::array<float, N*2> zoomInterpolatedAttributeValue(const std::array<float, N>& min, const std::array<float, N>& max) {
-    std::array<float, N*2> result;
+template <class T, size_t N>
+std::array<T, N*2> zoomInterpolatedAttributeValue(const std::array<T, N>& min, const std::array<T, N>& max) {
+    std::array<T, N*2> result;
     for (size_t i = 0; i < N; i++) {
         result[i]   = min[i];
         result[i+N] = max[i];
@@ -82,10 +89,47 @@ public:
     using Attribute = ZoomInterpolatedAttributeType<A>;
     using AttributeBinding = typename Attribute::Binding;
 
+    using SourceVertexVector = gl::VertexVector<gl::detail::Vertex<A>>;
+    using CompositeVertexVector = gl::VertexVector<gl::detail::Vertex<Attribute>>;
+
     virtual ~PaintPropertyBinder() = default;
 
     virtual void populateVertexVector(const GeometryTileFeature& feature, std::size_t length) = 0;
-    virtual void upload(gl::Context& context) = 0;
+
+    // Interleaved upload: every data-driven binder of a layer contributes
+    // one attribute to a single vertex stream, so a vertex's paint
+    // attributes load from one contiguous spot instead of one buffer per
+    // property. A binder reports the bytes it adds to each vertex (zero for
+    // constant binders), hands out its evaluated data for assembly, and is
+    // then attached to the assembled buffer at its byte offset within the
+    // stride, at which point it releases its CPU-side copy.
+    virtual std::size_t vertexByteSize() const { return 0; }
+    virtual std::size_t vertexCount() const { return 0; }
+    virtual const uint8_t* vertexData() const { return nullptr; }
+    virtual void setInterleavedBuffer(gl::InterleavedVertexBuffer&, std::size_t) {}
+
+    // The evaluated vertex vector, exposed so binders built for different
+    // styled layers can collapse onto one shared slab when their data came
+    // out identical. Each accessor is null for binders without vertex data
+    // of that layout.
+    virtual SourceVertexVector* sourceVertexVector() { return nullptr; }
+    virtual CompositeVertexVector* compositeVertexVector() { return nullptr; }
+
+    // Shares this binder's vertex slab with `other`'s if both binders use the
+    // same strategy and evaluated to byte-identical vertex data.
+    void tryShareVertexVectorWith(PaintPropertyBinder& other) {
+        if (sourceVertexVector() && other.sourceVertexVector()) {
+            sourceVertexVector()->tryShareWith(*other.sourceVertexVector());
+        } else if (compositeVertexVector() && other.compositeVertexVector()) {
+            compositeVertexVector()->tryShareWith(*other.compositeVertexVector());
+        }
+    }
+
+    // Re-evaluates the property for `feature` and overwrites the vertices in
+    // [begin, end) with the result — in place before upload, as a buffer
+    // sub-upload afterwards. Used by feature-state changes to restyle one
+    // feature without touching the rest of the buffer.
+    virtual void updateVertexRange(const GeometryTileFeature&, std::size_t, std::size_t, gl::Context&) {}
     virtual AttributeBinding attributeBinding(const PossiblyEvaluatedPropertyValue<T>& currentValue) const = 0;
     virtual float interpolationFactor(float currentZoom) const = 0;
 
@@ -103,7 +147,6 @@ public:
     }
 
     void populateVertexVector(const GeometryTileFeature&, std::size_t) override {}
-    void upload(gl::Context&) override {}
 
     AttributeBinding attributeBinding(const PossiblyEvaluatedPropertyValue<T>& currentValue) const override {
         auto value = attributeValue(currentValue.constantOr(constant));
@@ -132,18 +175,51 @@ public:
 
     SourceFunctionPaintPropertyBinder(SourceFunction<T> function_, T defaultValue_)
         : function(std::move(function_)),
-          defaultValue(std::move(defaultValue_)) {
+          defaultValue(std::move(defaultValue_)),
+          compiledStops(compileStops<T>(function.stops)) {
     }
 
     void populateVertexVector(const GeometryTileFeature& feature, std::size_t length) override {
-        auto value = attributeValue(function.evaluate(feature, defaultValue));
+        auto value = attributeValue(evaluate(feature));
         for (std::size_t i = vertexVector.vertexSize(); i < length; ++i) {
             vertexVector.emplace_back(BaseVertex { value });
         }
     }
 
-    void upload(gl::Context& context) override {
-        vertexBuffer = context.createVertexBuffer(std::move(vertexVector));
+    typename PaintPropertyBinder<T, A>::SourceVertexVector* sourceVertexVector() override {
+        return &vertexVector;
+    }
+
+    std::size_t vertexByteSize() const override { return sizeof(BaseVertex); }
+    std::size_t vertexCount() const override { return vertexVector.vertexSize(); }
+    const uint8_t* vertexData() const override {
+        return reinterpret_cast<const uint8_t*>(vertexVector.data());
+    }
+
+    void setInterleavedBuffer(gl::InterleavedVertexBuffer& buffer, std::size_t attributeOffset_) override {
+        interleaved = &buffer;
+        attributeOffset = attributeOffset_;
+        vertexVector = {};
+    }
+
+    void updateVertexRange(const GeometryTileFeature& feature, std::size_t begin, std::size_t end,
+                           gl::Context& context) override {
+        auto value = attributeValue(evaluate(feature));
+        if (interleaved) {
+            // Every vertex of a feature carries the same attribute value, so
+            // the range refills with one small sub-upload per vertex, strided
+            // over the interleaved layout.
+            const BaseVertex vertex { value };
+            for (std::size_t i = begin; i < end && i < interleaved->vertexCount; ++i) {
+                context.updateInterleavedVertexBuffer(
+                    *interleaved, i * interleaved->vertexSize + attributeOffset, &vertex, sizeof(vertex));
+            }
+        } else {
+            BaseVertex* vertices = vertexVector.mutableData();
+            for (std::size_t i = begin; i < end && i < vertexVector.vertexSize(); ++i) {
+                vertices[i] = BaseVertex { value };
+            }
+        }
     }
 
     AttributeBinding attributeBinding(const PossiblyEvaluatedPropertyValue<T>& currentValue) const override {
@@ -153,7 +229,13 @@ public:
                 zoomInterpolatedAttributeValue(value, value)
             };
         } else {
-            return Attribute::variableBinding(*vertexBuffer, 0, BaseAttribute::Dimensions);
+            assert(interleaved);
+            return typename Attribute::VariableBinding {
+                interleaved->buffer,
+                interleaved->vertexSize,
+                attributeOffset,
+                BaseAttribute::Dimensions
+            };
         }
     }
 
@@ -162,10 +244,27 @@ public:
     }
 
 private:
+    // Evaluated on the compiled stops when the function has a compiled form;
+    // the result is identical to function.evaluate(feature, defaultValue).
+    T evaluate(const GeometryTileFeature& feature) const {
+        if (!compiledStops) {
+            return function.evaluate(feature, defaultValue);
+        }
+        optional<Value> v = feature.getValue(function.property);
+        if (!v) {
+            return function.defaultValue.value_or(defaultValue);
+        }
+        return compiledStops->match([&] (const auto& s) -> T {
+            return s.evaluate(*v).value_or(function.defaultValue.value_or(defaultValue));
+        });
+    }
+
     SourceFunction<T> function;
     T defaultValue;
+    optional<CompiledStops<T>> compiledStops;
     gl::VertexVector<BaseVertex> vertexVector;
-    optional<gl::VertexBuffer<BaseVertex>> vertexBuffer;
+    gl::InterleavedVertexBuffer* interleaved = nullptr;
+    std::size_t attributeOffset = 0;
 };
 
 template <class T, class A>
@@ -182,11 +281,13 @@ public:
     CompositeFunctionPaintPropertyBinder(CompositeFunction<T> function_, float zoom, T defaultValue_)
         : function(std::move(function_)),
           defaultValue(std::move(defaultValue_)),
-          coveringRanges(function.coveringRanges(zoom)) {
+          coveringRanges(function.coveringRanges(zoom)),
+          compiledMinStops(compileStops<T>(std::get<1>(coveringRanges).min)),
+          compiledMaxStops(compileStops<T>(std::get<1>(coveringRanges).max)) {
     }
 
     void populateVertexVector(const GeometryTileFeature& feature, std::size_t length) override {
-        Range<T> range = function.evaluate(std::get<1>(coveringRanges), feature, defaultValue);
+        Range<T> range = evaluate(feature);
         AttributeValue value = zoomInterpolatedAttributeValue(
             attributeValue(range.min),
             attributeValue(range.max));
@@ -195,8 +296,40 @@ public:
         }
     }
 
-    void upload(gl::Context& context) override {
-        vertexBuffer = context.createVertexBuffer(std::move(vertexVector));
+    typename PaintPropertyBinder<T, A>::CompositeVertexVector* compositeVertexVector() override {
+        return &vertexVector;
+    }
+
+    std::size_t vertexByteSize() const override { return sizeof(Vertex); }
+    std::size_t vertexCount() const override { return vertexVector.vertexSize(); }
+    const uint8_t* vertexData() const override {
+        return reinterpret_cast<const uint8_t*>(vertexVector.data());
+    }
+
+    void setInterleavedBuffer(gl::InterleavedVertexBuffer& buffer, std::size_t attributeOffset_) override {
+        interleaved = &buffer;
+        attributeOffset = attributeOffset_;
+        vertexVector = {};
+    }
+
+    void updateVertexRange(const GeometryTileFeature& feature, std::size_t begin, std::size_t end,
+                           gl::Context& context) override {
+        Range<T> range = evaluate(feature);
+        AttributeValue value = zoomInterpolatedAttributeValue(
+            attributeValue(range.min),
+            attributeValue(range.max));
+        if (interleaved) {
+            const Vertex vertex { value };
+            for (std::size_t i = begin; i < end && i < interleaved->vertexCount; ++i) {
+                context.updateInterleavedVertexBuffer(
+                    *interleaved, i * interleaved->vertexSize + attributeOffset, &vertex, sizeof(vertex));
+            }
+        } else {
+            Vertex* vertices = vertexVector.mutableData();
+            for (std::size_t i = begin; i < end && i < vertexVector.vertexSize(); ++i) {
+                vertices[i] = Vertex { value };
+            }
+        }
     }
 
     AttributeBinding attributeBinding(const PossiblyEvaluatedPropertyValue<T>& currentValue) const override {
@@ -206,7 +339,12 @@ public:
                 zoomInterpolatedAttributeValue(value, value)
             };
         } else {
-            return Attribute::variableBinding(*vertexBuffer, 0);
+            assert(interleaved);
+            return typename Attribute::VariableBinding {
+                interleaved->buffer,
+                interleaved->vertexSize,
+                attributeOffset
+            };
         }
     }
 
@@ -216,11 +354,36 @@ public:
 
 private:
     using InnerStops = typename CompositeFunction<T>::InnerStops;
+
+    // Evaluated on the compiled covering stops where they have a compiled
+    // form; the result is identical to
+    // function.evaluate(std::get<1>(coveringRanges), feature, defaultValue).
+    Range<T> evaluate(const GeometryTileFeature& feature) const {
+        optional<Value> v = feature.getValue(function.property);
+        if (!v) {
+            const T fallback = function.defaultValue.value_or(defaultValue);
+            return { fallback, fallback };
+        }
+        auto evaluateSide = [&] (const optional<CompiledStops<T>>& compiled, const InnerStops& stops) {
+            auto eval = [&] (const auto& s) -> T {
+                return s.evaluate(*v).value_or(function.defaultValue.value_or(defaultValue));
+            };
+            return compiled ? compiled->match(eval) : stops.match(eval);
+        };
+        return Range<T> {
+            evaluateSide(compiledMinStops, std::get<1>(coveringRanges).min),
+            evaluateSide(compiledMaxStops, std::get<1>(coveringRanges).max)
+        };
+    }
+
     CompositeFunction<T> function;
     T defaultValue;
     std::tuple<Range<float>, Range<InnerStops>> coveringRanges;
+    optional<CompiledStops<T>> compiledMinStops;
+    optional<CompiledStops<T>> compiledMaxStops;
     gl::VertexVector<Vertex> vertexVector;
-    optional<gl::VertexBuffer<Vertex>> vertexBuffer;
+    gl::InterleavedVertexBuffer* interleaved = nullptr;
+    std::size_t attributeOffset = 0;
 };
 
 template <class T, class A>
@@ -281,9 +444,55 @@ public:
         });
     }
 
+    // Styled layers frequently differ only in filters or constant properties,
+    // in which case their data-driven vertex vectors come out byte-identical.
+    // Shares those slabs with `other`'s so only one copy stays resident.
+    void shareVertexVectorsWith(PaintPropertyBinders& other) {
+        util::ignore({
+            (binders.template get<Ps>()->tryShareVertexVectorWith(*other.binders.template get<Ps>()), 0)...
+        });
+    }
+
     void upload(gl::Context& context) {
+        if (interleavedBuffer) {
+            // The binders released their CPU-side vectors when they were
+            // attached; there is nothing left to upload.
+            return;
+        }
+
+        std::size_t vertexSize = 0;
+        std::size_t count = 0;
         util::ignore({
-            (binders.template get<Ps>()->upload(context), 0)...
+            (vertexSize += binders.template get<Ps>()->vertexByteSize(),
+             count = std::max(count, binders.template get<Ps>()->vertexCount()), 0)...
+        });
+        if (vertexSize == 0) {
+            return;
+        }
+
+        // Assemble the per-property vectors into one interleaved stream and
+        // upload it as a single buffer; each data-driven binder is then bound
+        // at its byte offset within the stride. The binders release their
+        // CPU-side vectors once attached.
+        std::vector<uint8_t> data(vertexSize * count);
+        std::size_t offset = 0;
+        util::ignore({
+            (offset += interleave(*binders.template get<Ps>(), data, vertexSize, offset), 0)...
+        });
+
+        interleavedBuffer = std::make_unique<gl::InterleavedVertexBuffer>(
+            context.createInterleavedVertexBuffer(vertexSize, count, data.data()));
+
+        offset = 0;
+        util::ignore({
+            (offset += attach(*binders.template get<Ps>(), *interleavedBuffer, offset), 0)...
+        });
+    }
+
+    void updateVertexRanges(const GeometryTileFeature& feature, std::size_t begin, std::size_t end,
+                            gl::Context& context) {
+        util::ignore({
+            (binders.template get<Ps>()->updateVertexRange(feature, begin, end, context), 0)...
         });
     }
 
@@ -313,7 +522,38 @@ public:
     }
 
 private:
+    template <class T, class A>
+    static std::size_t interleave(PaintPropertyBinder<T, A>& binder,
+                                  std::vector<uint8_t>& data,
+                                  std::size_t vertexSize,
+                                  std::size_t offset) {
+        const std::size_t size = binder.vertexByteSize();
+        if (size > 0) {
+            const uint8_t* source = binder.vertexData();
+            const std::size_t count = binder.vertexCount();
+            for (std::size_t i = 0; i < count; ++i) {
+                std::memcpy(data.data() + i * vertexSize + offset, source + i * size, size);
+            }
+        }
+        return size;
+    }
+
+    template <class T, class A>
+    static std::size_t attach(PaintPropertyBinder<T, A>& binder,
+                              gl::InterleavedVertexBuffer& buffer,
+                              std::size_t offset) {
+        const std::size_t size = binder.vertexByteSize();
+        if (size > 0) {
+            binder.setInterleavedBuffer(buffer, offset);
+        }
+        return size;
+    }
+
     Binders binders;
+
+    // Owned here so the binders' pointers into it stay valid when the
+    // enclosing PaintPropertyBinders is moved.
+    std::unique_ptr<gl::InterleavedVertexBuffer> interleavedBuffer;
 };
 
 } // namespace style
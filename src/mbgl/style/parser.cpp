@@ -11,19 +11,157 @@
 
 #include <rapidjson/document.h>
 #include <rapidjson/error/en.h>
+#include <rapidjson/stringbuffer.h>
+#include <rapidjson/writer.h>
 
 #include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <list>
+#include <mutex>
 #include <set>
 #include <sstream>
+#include <thread>
 
 namespace mbgl {
 namespace style {
 
+namespace {
+
+// Styles are typically fixed per release but re-parsed whenever a map is
+// created, e.g. after an Android configuration change recreates the activity
+// within the same process. Cache the converted layers of the last few parsed
+// styles, keyed by the style JSON, and clone them on a hit instead of
+// re-running conversion; layer conversion dominates parse time. Sources
+// carry loading state and cannot be cloned, so they are always re-converted.
+class LayerSnapshotCache {
+public:
+    optional<std::vector<std::unique_ptr<Layer>>> get(const std::string& json) {
+        std::lock_guard<std::mutex> lock(mutex);
+
+        auto it = std::find_if(entries.begin(), entries.end(), [&] (const Entry& entry) {
+            return entry.json == json;
+        });
+        if (it == entries.end()) {
+            return {};
+        }
+
+        entries.splice(entries.begin(), entries, it);
+
+        std::vector<std::unique_ptr<Layer>> layers;
+        layers.reserve(entries.front().layers.size());
+        for (const auto& layer : entries.front().layers) {
+            layers.push_back(layer->baseImpl->clone());
+        }
+        return { std::move(layers) };
+    }
+
+    void put(const std::string& json, const std::vector<std::unique_ptr<Layer>>& layers) {
+        Entry entry { json, {} };
+        entry.layers.reserve(layers.size());
+        for (const auto& layer : layers) {
+            entry.layers.push_back(layer->baseImpl->clone());
+        }
+
+        std::lock_guard<std::mutex> lock(mutex);
+        entries.push_front(std::move(entry));
+        if (entries.size() > 3) {
+            entries.pop_back();
+        }
+    }
+
+private:
+    struct Entry {
+        std::string json;
+        std::vector<std::unique_ptr<Layer>> layers;
+    };
+
+    std::mutex mutex;
+    std::list<Entry> entries;
+};
+
+LayerSnapshotCache& layerSnapshotCache() {
+    static LayerSnapshotCache cache;
+    return cache;
+}
+
+// Whether any layer carries a class-specific "paint.<class>" block. Class
+// names are interned into a per-thread dictionary (ClassDictionary), so
+// converted layers with class paints hold thread-local ClassIDs; serving a
+// cached clone of them to a style on another thread would pair those IDs
+// with a dictionary that resolves the same names differently, and class
+// paints would silently stop cascading. Such styles bypass the cache.
+bool hasClassPaints(const JSValue& layersValue) {
+    if (!layersValue.IsArray()) {
+        return false;
+    }
+    for (const auto& layerValue : layersValue.GetArray()) {
+        if (!layerValue.IsObject()) {
+            continue;
+        }
+        for (const auto& property : layerValue.GetObject()) {
+            if (property.name.GetStringLength() > 6 &&
+                std::strncmp(property.name.GetString(), "paint.", 6) == 0) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+std::string stringify(const JSValue& value) {
+    rapidjson::StringBuffer buffer;
+    rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
+    value.Accept(writer);
+    return { buffer.GetString(), buffer.GetSize() };
+}
+
+// Serialization preserves member order, so a definition that merely reorders
+// its members compares as changed; that costs a rebuild, never correctness.
+Parser::LayerDefinition splitLayerDefinition(const JSValue& value) {
+    rapidjson::StringBuffer structural;
+    rapidjson::StringBuffer paint;
+    rapidjson::Writer<rapidjson::StringBuffer> structuralWriter(structural);
+    rapidjson::Writer<rapidjson::StringBuffer> paintWriter(paint);
+
+    Parser::LayerDefinition definition;
+
+    structuralWriter.StartObject();
+    paintWriter.StartObject();
+    for (const auto& property : value.GetObject()) {
+        const bool isPaint = property.name.GetStringLength() >= 5 &&
+            std::strncmp(property.name.GetString(), "paint", 5) == 0 &&
+            (property.name.GetStringLength() == 5 || property.name.GetString()[5] == '.');
+        auto& writer = isPaint ? paintWriter : structuralWriter;
+        writer.Key(property.name.GetString(), property.name.GetStringLength());
+        property.value.Accept(writer);
+    }
+    structuralWriter.EndObject();
+    paintWriter.EndObject();
+
+    definition.structural = { structural.GetString(), structural.GetSize() };
+    definition.paint = { paint.GetString(), paint.GetSize() };
+
+    if (value.HasMember("ref") && value["ref"].IsString()) {
+        definition.ref = { value["ref"].GetString(), value["ref"].GetStringLength() };
+    }
+
+    return definition;
+}
+
+} // namespace
+
 Parser::~Parser() = default;
 
 StyleParseResult Parser::parse(const std::string& json) {
     rapidjson::GenericDocument<rapidjson::UTF8<>, rapidjson::CrtAllocator> document;
-    document.Parse<0>(json.c_str());
+
+    // Parse in situ: string values alias into this mutable buffer instead of
+    // being copied into the document's allocator one by one. The buffer only
+    // needs to outlive the document, and everything below consumes the
+    // document before this function returns.
+    std::string buffer = json;
+    document.ParseInsitu(&buffer[0]);
 
     if (document.HasParseError()) {
         std::stringstream message;
@@ -87,7 +225,31 @@ StyleParseResult Parser::parse(const std::string& json) {
     }
 
     if (document.HasMember("layers")) {
-        parseLayers(document["layers"]);
+        const JSValue& layersValue = document["layers"];
+
+        // Capture serialized definitions independently of the snapshot cache,
+        // which skips the JSON walk entirely on a hit.
+        if (layersValue.IsArray()) {
+            for (const auto& layerValue : layersValue.GetArray()) {
+                if (layerValue.IsObject() && layerValue.HasMember("id") && layerValue["id"].IsString()) {
+                    const JSValue& id = layerValue["id"];
+                    layerDefinitions.emplace(std::string { id.GetString(), id.GetStringLength() },
+                                             splitLayerDefinition(layerValue));
+                }
+            }
+        }
+
+        if (hasClassPaints(layersValue)) {
+            parseLayers(layersValue);
+        } else {
+            optional<std::vector<std::unique_ptr<Layer>>> snapshot = layerSnapshotCache().get(json);
+            if (snapshot) {
+                layers = std::move(*snapshot);
+            } else {
+                parseLayers(layersValue);
+                layerSnapshotCache().put(json, layers);
+            }
+        }
     }
 
     if (document.HasMember("sprite")) {
@@ -125,10 +287,34 @@ void Parser::parseSources(const JSValue& value) {
         }
 
         sourcesMap.emplace(id, (*source).get());
+        sourceDefinitions.emplace(id, stringify(property.value));
         sources.emplace_back(std::move(*source));
     }
 }
 
+namespace {
+
+// Whether a layer can be converted off the calling thread. "ref" layers need
+// their referent converted first, and class-specific "paint.<class>" blocks
+// intern class names into a per-thread dictionary, so both must stay on the
+// thread that owns the style.
+bool isIndependentLayer(const JSValue& value) {
+    if (value.HasMember("ref")) {
+        return false;
+    }
+
+    for (const auto& property : value.GetObject()) {
+        if (property.name.GetStringLength() > 6 &&
+            std::strncmp(property.name.GetString(), "paint.", 6) == 0) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+} // namespace
+
 void Parser::parseLayers(const JSValue& value) {
     std::vector<std::string> ids;
 
@@ -164,6 +350,51 @@ void Parser::parseLayers(const JSValue& value) {
         ids.push_back(layerID);
     }
 
+    // Layer conversion dominates parse time on large styles, and independent
+    // layers have no data dependencies on each other, so fan their conversion
+    // out across a scoped thread team, with this thread taking part. A failed
+    // conversion leaves its slot empty; the serial pass below retries it so
+    // that the warning is reported from this thread.
+    struct Conversion {
+        const JSValue& value;
+        std::unique_ptr<Layer>& layer;
+    };
+    std::vector<Conversion> conversions;
+
+    for (const auto& id : ids) {
+        auto it = layersMap.find(id);
+        if (isIndependentLayer(it->second.first)) {
+            conversions.push_back({ it->second.first, it->second.second });
+        }
+    }
+
+    const std::size_t concurrency = std::min<std::size_t>(
+        std::max<std::size_t>(std::thread::hardware_concurrency(), 1), conversions.size());
+
+    if (concurrency > 1) {
+        std::atomic<std::size_t> nextTask { 0 };
+        auto consumeTasks = [&] {
+            for (std::size_t i = nextTask++; i < conversions.size(); i = nextTask++) {
+                conversion::Error error;
+                optional<std::unique_ptr<Layer>> converted =
+                    conversion::convert<std::unique_ptr<Layer>>(conversions[i].value, error);
+                if (converted) {
+                    conversions[i].layer = std::move(*converted);
+                }
+            }
+        };
+
+        std::vector<std::thread> team;
+        team.reserve(concurrency - 1);
+        for (std::size_t i = 0; i < concurrency - 1; ++i) {
+            team.emplace_back(consumeTasks);
+        }
+        consumeTasks();
+        for (auto& thread : team) {
+            thread.join();
+        }
+    }
+
     for (const auto& id : ids) {
         auto it = layersMap.find(id);
 
@@ -31,6 +31,21 @@ public:
     std::vector<std::unique_ptr<Source>> sources;
     std::vector<std::unique_ptr<Layer>> layers;
 
+    // A layer definition split for the structural diff in Style::setJSON:
+    // changing any member but paint requires a new object and new buckets,
+    // while paint blocks cascade onto existing ones. "ref" layers borrow
+    // their referent's layout, so the referent id is kept to propagate
+    // structural changes through reference chains.
+    struct LayerDefinition {
+        std::string structural;
+        std::string paint;
+        std::string ref;
+    };
+
+    // Serialized definitions keyed by id, filled during parse().
+    std::unordered_map<std::string, std::string> sourceDefinitions;
+    std::unordered_map<std::string, LayerDefinition> layerDefinitions;
+
     std::string name;
     LatLng latLng;
     double zoom = 0;
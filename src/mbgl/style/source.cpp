@@ -26,5 +26,17 @@ std::vector<Feature> Source::querySourceFeatures(const SourceQueryOptions& optio
     return baseImpl->querySourceFeatures(options);
 }
 
+void Source::setQueryAttributeIndexes(std::vector<std::string> attributes) {
+    baseImpl->setQueryAttributeIndexes(std::move(attributes));
+}
+
+void Source::setFeatureState(uint64_t featureID, const PropertyMap& state) {
+    baseImpl->setFeatureState(featureID, state);
+}
+
+void Source::setMinimumUpdateInterval(Duration interval) {
+    baseImpl->setMinimumUpdateInterval(interval);
+}
+
 } // namespace style
 } // namespace mbgl
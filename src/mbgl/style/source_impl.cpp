@@ -4,21 +4,23 @@
 #include <mbgl/renderer/render_tile.hpp>
 #include <mbgl/renderer/painter.hpp>
 #include <mbgl/style/update_parameters.hpp>
+#include <mbgl/storage/network_quality.hpp>
 #include <mbgl/text/placement_config.hpp>
 #include <mbgl/util/logging.hpp>
 #include <mbgl/math/clamp.hpp>
+#include <mbgl/util/constants.hpp>
 #include <mbgl/util/tile_cover.hpp>
 #include <mbgl/util/enum.hpp>
 #include <mbgl/map/query.hpp>
 #include <mbgl/style/query.hpp>
 
 #include <mbgl/algorithm/update_renderables.hpp>
-#include <mbgl/algorithm/generate_clip_ids.hpp>
-#include <mbgl/algorithm/generate_clip_ids_impl.hpp>
 
 #include <mapbox/geometry/envelope.hpp>
 
 #include <algorithm>
+#include <cmath>
+#include <cstdlib>
 
 namespace mbgl {
 namespace style {
@@ -53,22 +55,33 @@ void Source::Impl::detach() {
 void Source::Impl::invalidateTiles() {
     tiles.clear();
     renderTiles.clear();
+    tileMatrices.clear();
     cache.clear();
+    tilesChangedSinceUpdate = true;
 }
 
-void Source::Impl::startRender(algorithm::ClipIDGenerator& generator,
-                         const mat4& projMatrix,
-                         const TransformState& transform) {
-    if (type == SourceType::Vector ||
-        type == SourceType::GeoJSON ||
-        type == SourceType::Annotations) {
-        generator.update(renderTiles);
+bool Source::Impl::clipsTiles() const {
+    return type == SourceType::Vector ||
+           type == SourceType::GeoJSON ||
+           type == SourceType::Annotations;
+}
+
+void Source::Impl::startRender(const mat4& projMatrix, const TransformState& transform) {
+    if (projMatrix != tileMatricesProjMatrix) {
+        tileMatrices.clear();
+        tileMatricesProjMatrix = projMatrix;
     }
 
     for (auto& pair : renderTiles) {
         auto& tile = pair.second;
-        transform.matrixFor(tile.matrix, tile.id);
-        matrix::multiply(tile.matrix, projMatrix, tile.matrix);
+        auto it = tileMatrices.find(tile.id);
+        if (it != tileMatrices.end()) {
+            tile.matrix = it->second;
+        } else {
+            transform.matrixFor(tile.matrix, tile.id);
+            matrix::multiply(tile.matrix, projMatrix, tile.matrix);
+            tileMatrices.emplace(tile.id, tile.matrix);
+        }
     }
 }
 
@@ -85,6 +98,12 @@ std::map<UnwrappedTileID, RenderTile>& Source::Impl::getRenderTiles() {
     return renderTiles;
 }
 
+bool Source::Impl::UpdateInputs::operator==(const UpdateInputs& other) const {
+    return overscaledZoom == other.overscaledZoom && size == other.size &&
+           angle == other.angle && pitch == other.pitch &&
+           collisionDebug == other.collisionDebug && cornerTiles == other.cornerTiles;
+}
+
 void Source::Impl::updateTiles(const UpdateParameters& parameters) {
     if (!loaded) {
         return;
@@ -95,6 +114,82 @@ void Source::Impl::updateTiles(const UpdateParameters& parameters) {
 
     // Determine the overzooming/underzooming amounts and required tiles.
     int32_t overscaledZoom = util::coveringZoomLevel(parameters.transformState.getZoom(), type, tileSize);
+
+    // Crossing an integer zoom boundary mid-gesture swaps the entire ideal
+    // cover to the next pyramid level, and the resulting burst of fetch and
+    // layout work is what users perceive as a stutter at the boundary. A tile
+    // renders correctly within ±1 of its own zoom through the tile matrix
+    // alone — overscaled on the way up, underzoomed on the way down — so
+    // while the zoom is still moving the previous level is kept and the
+    // switch is deferred until the camera has settled briefly.
+    if (parameters.mode == MapMode::Continuous) {
+        static const Duration zoomSettleInterval = Milliseconds(200);
+        const TimePoint zoomNow = Clock::now();
+        const double zoom = parameters.transformState.getZoom();
+        if (zoom != lastObservedZoom) {
+            lastObservedZoom = zoom;
+            lastZoomChange = zoomNow;
+        }
+
+        if (appliedTileZoom && zoomNow - lastZoomChange < zoomSettleInterval &&
+            std::abs(overscaledZoom - *appliedTileZoom) == 1) {
+            overscaledZoom = *appliedTileZoom;
+            // Nothing repaints once the gesture ends, so request a frame when
+            // the settle interval elapses; that updateTiles pass applies the
+            // deferred level.
+            zoomSettleTimer.start(zoomSettleInterval, Duration::zero(), [this] {
+                if (!tiles.empty()) {
+                    observer->onTileChanged(base, tiles.begin()->first);
+                }
+            });
+        } else {
+            appliedTileZoom = overscaledZoom;
+            zoomSettleTimer.stop();
+        }
+    } else {
+        appliedTileZoom = overscaledZoom;
+    }
+
+    // Per-source update cadence. A source with a minimum update interval
+    // configured (say, a raster source whose weather data is fresh for half
+    // an hour) doesn't need the cover re-evaluated on every frame of a
+    // steady camera. Quantize the inputs that determine the cover and the
+    // placement config; while they match the previous update, no tile
+    // changed underneath the render tile set, and the interval is still
+    // open, there is nothing this pass could conclude differently.
+    if (parameters.mode == MapMode::Continuous && minimumUpdateInterval > Duration::zero()) {
+        UpdateInputs inputs {
+            overscaledZoom,
+            parameters.transformState.getSize(),
+            parameters.transformState.getAngle(),
+            parameters.transformState.getPitch(),
+            bool(parameters.debugOptions & MapDebugOptions::Collision),
+            {{}}
+        };
+
+        const int32_t quantizeZoom = util::clamp<int32_t>(overscaledZoom, zoomRange->min, zoomRange->max);
+        std::size_t corner = 0;
+        for (const auto& screenCorner : {
+                 ScreenCoordinate { 0, 0 },
+                 ScreenCoordinate { double(inputs.size.width), 0 },
+                 ScreenCoordinate { 0, double(inputs.size.height) },
+                 ScreenCoordinate { double(inputs.size.width), double(inputs.size.height) } }) {
+            const TileCoordinate coord = TileCoordinate::fromLatLng(
+                quantizeZoom, parameters.transformState.screenCoordinateToLatLng(screenCorner));
+            inputs.cornerTiles[corner++] = int64_t(std::floor(coord.p.x));
+            inputs.cornerTiles[corner++] = int64_t(std::floor(coord.p.y));
+        }
+
+        const TimePoint updateNow = Clock::now();
+        if (!tilesChangedSinceUpdate && lastUpdateInputs && inputs == *lastUpdateInputs &&
+            updateNow - lastFullUpdate < minimumUpdateInterval) {
+            return;
+        }
+        lastUpdateInputs = inputs;
+        lastFullUpdate = updateNow;
+    }
+    tilesChangedSinceUpdate = false;
+
     int32_t tileZoom = overscaledZoom;
 
     std::vector<UnwrappedTileID> idealTiles;
@@ -129,6 +224,30 @@ void Source::Impl::updateTiles(const UpdateParameters& parameters) {
             tile = createTile(tileID, parameters);
             if (tile) {
                 tile->setObserver(this);
+                for (const auto& state : featureStates) {
+                    tile->setFeatureState(state.first, state.second);
+                }
+                auto seed = seededTileData.find(tileID);
+                if (seed != seededTileData.end()) {
+                    tile->seedData(std::move(seed->second));
+                    seededTileData.erase(seed);
+                } else {
+                    // Overscaled variants of a tile render the same canonical
+                    // bytes; if another variant already holds them, seed the
+                    // new tile so its first layout runs without waiting for a
+                    // fetch that can only return the same data. The shared
+                    // layer registry makes re-decoding the seeded buffer all
+                    // but free, so only placement and scaling re-run.
+                    for (const auto& pair : tiles) {
+                        if (pair.first.canonical == tileID.canonical &&
+                            pair.first.overscaledZ != tileID.overscaledZ) {
+                            if (auto rawData = pair.second->getRawData()) {
+                                tile->seedData(std::move(rawData));
+                                break;
+                            }
+                        }
+                    }
+                }
             }
         }
         if (!tile) {
@@ -144,6 +263,81 @@ void Source::Impl::updateTiles(const UpdateParameters& parameters) {
     algorithm::updateRenderables(getTileFn, createTileFn, retainTileFn, renderTileFn,
                                  idealTiles, *zoomRange, tileZoom);
 
+    // Low-zoom ancestor prefetch: request the z4 (or lower) ancestors of the
+    // ideal tiles eagerly. They are tiny, usually cached, and renderable long
+    // before the ideal-zoom tiles arrive on slow connections, so the parent
+    // ascent in updateRenderables can show them scaled instead of leaving the
+    // map blank on cold start.
+    if (overscaledZoom >= zoomRange->min) {
+        const uint8_t prefetchZoom = std::min<uint8_t>(4, zoomRange->max);
+        if (prefetchZoom >= zoomRange->min && static_cast<int32_t>(prefetchZoom) < tileZoom) {
+            for (const auto& idealTile : idealTiles) {
+                const OverscaledTileID ancestorTileID =
+                    OverscaledTileID(tileZoom, idealTile.canonical).scaledTo(prefetchZoom);
+                if (retain.find(ancestorTileID) == retain.end()) {
+                    Tile* tile = createTileFn(ancestorTileID);
+                    if (tile) {
+                        retainTileFn(*tile, Resource::Necessity::Required);
+                    }
+                }
+            }
+        }
+    }
+
+    // Predictive prefetch: estimate the camera's velocity from the previous
+    // update and request the tiles covering the viewport a beat ahead at
+    // optional priority, so fetch and parse get a head start during fast pans
+    // instead of waiting for the tiles to become visible. The window adapts
+    // to the measured network: a degraded network gets half the lookahead,
+    // and a poor one gets none — there the low-zoom ancestors above are the
+    // only speculative traffic worth its bandwidth.
+    const NetworkQuality::Level networkQuality = NetworkQuality::Get();
+    if (parameters.mode == MapMode::Continuous && overscaledZoom >= zoomRange->min &&
+        networkQuality != NetworkQuality::Level::Poor) {
+        const TimePoint prefetchNow = Clock::now();
+        const LatLng center = parameters.transformState.getLatLng();
+
+        if (prefetchPrevCenter && prefetchPrevTime != TimePoint::min() && prefetchNow > prefetchPrevTime) {
+            const double dt = std::chrono::duration<double>(prefetchNow - prefetchPrevTime).count();
+            const double lookahead =
+                networkQuality == NetworkQuality::Level::Degraded ? 0.15 : 0.3; // seconds
+            const double dLat = (center.latitude - prefetchPrevCenter->latitude) / dt * lookahead;
+            const double dLng = (center.longitude - prefetchPrevCenter->longitude) / dt * lookahead;
+
+            // Stale samples (e.g. after an idle period) don't describe the
+            // current gesture; only extrapolate recent movement.
+            if (dt < 0.5 && (dLat != 0.0 || dLng != 0.0)) {
+                const Size size = parameters.transformState.getSize();
+                LatLngBounds predicted = LatLngBounds::empty();
+                for (const auto& corner : {
+                         ScreenCoordinate { 0, 0 },
+                         ScreenCoordinate { double(size.width), 0 },
+                         ScreenCoordinate { 0, double(size.height) },
+                         ScreenCoordinate { double(size.width), double(size.height) } }) {
+                    const LatLng shifted = parameters.transformState.screenCoordinateToLatLng(corner);
+                    predicted.extend(LatLng {
+                        util::clamp(shifted.latitude + dLat, -util::LATITUDE_MAX, util::LATITUDE_MAX),
+                        shifted.longitude + dLng });
+                }
+
+                const int32_t idealZoom = std::min<int32_t>(zoomRange->max, overscaledZoom);
+                for (const auto& unwrapped : util::tileCover(predicted, idealZoom)) {
+                    const OverscaledTileID dataTileID(tileZoom, unwrapped.canonical);
+                    if (retain.find(dataTileID) == retain.end()) {
+                        Tile* tile = createTileFn(dataTileID);
+                        if (tile) {
+                            retain.emplace(dataTileID);
+                            tile->setNecessity(Tile::Necessity::Optional);
+                        }
+                    }
+                }
+            }
+        }
+
+        prefetchPrevCenter = center;
+        prefetchPrevTime = prefetchNow;
+    }
+
     if (type != SourceType::Annotations) {
         size_t conservativeCacheSize =
             std::max((float)parameters.transformState.getSize().width / tileSize, 1.0f) *
@@ -151,6 +345,10 @@ void Source::Impl::updateTiles(const UpdateParameters& parameters) {
             (parameters.transformState.getMaxZoom() - parameters.transformState.getMinZoom() + 1) *
             0.5;
         cache.setSize(conservativeCacheSize);
+
+        const TileCoordinate center =
+            TileCoordinate::fromLatLng(0, parameters.transformState.getLatLng());
+        cache.setEvictionContext(parameters.transformState.getZoom(), center.p.x, center.p.y);
     }
 
     removeStaleTiles(retain);
@@ -159,8 +357,40 @@ void Source::Impl::updateTiles(const UpdateParameters& parameters) {
                                    parameters.transformState.getPitch(),
                                    parameters.debugOptions & MapDebugOptions::Collision };
 
+    // Re-running placement for every frame of a camera rotation costs a
+    // worker core while each result arrives a frame late anyway, and symbol
+    // fading hides the intermediate states. In continuous mode a changed
+    // config is therefore applied at most once per throttle interval; the
+    // timer flushes the last withheld config once the camera comes to rest.
+    static const Duration placementThrottleInterval = Milliseconds(300);
+    const TimePoint now = Clock::now();
+    if (parameters.mode != MapMode::Continuous || !appliedPlacementConfig ||
+        config == *appliedPlacementConfig ||
+        now - lastPlacementUpdate >= placementThrottleInterval) {
+        if (!appliedPlacementConfig || config != *appliedPlacementConfig) {
+            lastPlacementUpdate = now;
+        }
+        appliedPlacementConfig = config;
+        pendingPlacementConfig = {};
+        placementTimer.stop();
+    } else {
+        pendingPlacementConfig = config;
+        placementTimer.start(placementThrottleInterval - (now - lastPlacementUpdate),
+                             Duration::zero(), [this] {
+            if (!pendingPlacementConfig) {
+                return;
+            }
+            appliedPlacementConfig = *pendingPlacementConfig;
+            pendingPlacementConfig = {};
+            lastPlacementUpdate = Clock::now();
+            for (auto& pair : tiles) {
+                pair.second->setPlacementConfig(*appliedPlacementConfig);
+            }
+        });
+    }
+
     for (auto& pair : tiles) {
-        pair.second->setPlacementConfig(config);
+        pair.second->setPlacementConfig(*appliedPlacementConfig);
     }
 }
 
@@ -189,6 +419,7 @@ void Source::Impl::removeTiles() {
     if (!tiles.empty()) {
         removeStaleTiles({});
     }
+    tilesChangedSinceUpdate = true;
 }
 
 void Source::Impl::reloadTiles() {
@@ -197,16 +428,15 @@ void Source::Impl::reloadTiles() {
     for (auto& pair : tiles) {
         pair.second->redoLayout();
     }
+    tilesChangedSinceUpdate = true;
 }
 
-std::unordered_map<std::string, std::vector<Feature>> Source::Impl::queryRenderedFeatures(const ScreenLineString& geometry,
-                                           const TransformState& transformState,
-                                           const RenderedQueryOptions& options) const {
-    std::unordered_map<std::string, std::vector<Feature>> result;
-    if (renderTiles.empty() || geometry.empty()) {
-        return result;
-    }
-
+// Invokes `fn(renderTile, tileSpaceQueryGeometry)` for every render tile the
+// query geometry touches, in stable tile order.
+template <class Fn>
+void Source::Impl::forEachQueryTile(const ScreenLineString& geometry,
+                                    const TransformState& transformState,
+                                    Fn&& fn) const {
     LineString<double> queryGeometry;
 
     for (const auto& p : geometry) {
@@ -244,15 +474,55 @@ std::unordered_map<std::string, std::vector<Feature>> Source::Impl::queryRendere
             tileSpaceQueryGeometry.push_back(TileCoordinate::toGeometryCoordinate(renderTile.id, c));
         }
 
+        fn(renderTile, std::move(tileSpaceQueryGeometry));
+    }
+}
+
+std::unordered_map<std::string, std::vector<Feature>> Source::Impl::queryRenderedFeatures(const ScreenLineString& geometry,
+                                           const TransformState& transformState,
+                                           const std::unordered_map<std::string, const Layer*>& layers,
+                                           const float additionalQueryRadius,
+                                           const RenderedQueryOptions& options) const {
+    std::unordered_map<std::string, std::vector<Feature>> result;
+    if (renderTiles.empty() || geometry.empty()) {
+        return result;
+    }
+
+    forEachQueryTile(geometry, transformState,
+                     [&] (const RenderTile& renderTile, GeometryCoordinates tileSpaceQueryGeometry) {
         renderTile.tile.queryRenderedFeatures(result,
                                               tileSpaceQueryGeometry,
                                               transformState,
+                                              layers,
+                                              additionalQueryRadius,
                                               options);
-    }
+    });
 
     return result;
 }
 
+void Source::Impl::snapshotQueryTiles(FeatureQuerySnapshot& snapshot,
+                                      const ScreenLineString& geometry,
+                                      const TransformState& transformState) const {
+    if (renderTiles.empty() || geometry.empty()) {
+        return;
+    }
+
+    forEachQueryTile(geometry, transformState,
+                     [&] (const RenderTile& renderTile, GeometryCoordinates tileSpaceQueryGeometry) {
+        FeatureQueryData data = renderTile.tile.featureQueryData();
+        if (!data.featureIndex || !data.data) {
+            return;
+        }
+
+        snapshot.tiles.push_back({ renderTile.tile.id.canonical,
+                                   std::move(tileSpaceQueryGeometry),
+                                   util::tileSize * renderTile.tile.id.overscaleFactor(),
+                                   std::pow(2, transformState.getZoom() - renderTile.tile.id.overscaledZ),
+                                   std::move(data) });
+    });
+}
+
 std::vector<Feature> Source::Impl::querySourceFeatures(const SourceQueryOptions& options) {
 
     // Only VectorSource and GeoJSON source supported
@@ -264,18 +534,69 @@ std::vector<Feature> Source::Impl::querySourceFeatures(const SourceQueryOptions&
     std::vector<Feature> result;
 
     for (const auto& pair : tiles) {
-        pair.second->querySourceFeatures(result, options);
+        pair.second->querySourceFeatures(result, options, queryAttributeIndexes);
+    }
+
+    return result;
+}
+
+void Source::Impl::setQueryAttributeIndexes(std::vector<std::string> attributes) {
+    queryAttributeIndexes = std::move(attributes);
+}
+
+void Source::Impl::setFeatureState(uint64_t featureID, const PropertyMap& state) {
+    // Convert from the public API's map once; everything downstream works on
+    // the compact sorted representation.
+    FeatureState featureState(state);
+    if (featureState.empty()) {
+        featureStates.erase(featureID);
+    } else {
+        featureStates[featureID] = featureState;
+    }
+
+    // Cached tiles are updated too, so they revive with current state rather
+    // than values baked in before they were retained.
+    for (auto& pair : tiles) {
+        pair.second->setFeatureState(featureID, featureState);
+        onTileChanged(*pair.second);
     }
+    cache.forEach([&] (Tile& tile) {
+        tile.setFeatureState(featureID, state);
+    });
+}
 
+std::vector<std::pair<OverscaledTileID, std::string>>
+Source::Impl::serializeTileData(const std::vector<std::string>& layerNames) const {
+    std::vector<std::pair<OverscaledTileID, std::string>> result;
+    for (const auto& pair : tiles) {
+        // Tiles that haven't finished parsing, or that released their data
+        // under memory pressure, decline to serialize and are skipped.
+        optional<std::string> data = pair.second->serializeData(layerNames);
+        if (data) {
+            result.emplace_back(pair.first, std::move(*data));
+        }
+    }
     return result;
 }
 
+void Source::Impl::seedTileData(std::map<OverscaledTileID, std::shared_ptr<const std::string>> data) {
+    seededTileData = std::move(data);
+}
+
 void Source::Impl::setCacheSize(size_t size) {
     cache.setSize(size);
 }
 
+void Source::Impl::setMinimumUpdateInterval(Duration interval) {
+    minimumUpdateInterval = interval;
+    tilesChangedSinceUpdate = true;
+}
+
 void Source::Impl::onLowMemory() {
-    cache.clear();
+    // Dropping the CPU-side copies recovers most of the heap the cache pins
+    // while keeping the tiles' GPU buffers, so panning back does not have to
+    // re-fetch and re-parse everything.
+    cache.reduceMemoryUse();
 }
 
 void Source::Impl::setObserver(SourceObserver* observer_) {
@@ -283,10 +604,12 @@ void Source::Impl::setObserver(SourceObserver* observer_) {
 }
 
 void Source::Impl::onTileChanged(Tile& tile) {
+    tilesChangedSinceUpdate = true;
     observer->onTileChanged(base, tile.id);
 }
 
 void Source::Impl::onTileError(Tile& tile, std::exception_ptr error) {
+    tilesChangedSinceUpdate = true;
     observer->onTileError(base, tile.id, error);
 }
 
@@ -8,12 +8,19 @@
 #include <mbgl/tile/tile_cache.hpp>
 #include <mbgl/style/types.hpp>
 #include <mbgl/style/query.hpp>
+#include <mbgl/text/placement_config.hpp>
 
 #include <mbgl/util/noncopyable.hpp>
+#include <mbgl/util/chrono.hpp>
+#include <mbgl/util/geo.hpp>
+#include <mbgl/util/size.hpp>
+#include <mbgl/util/optional.hpp>
 #include <mbgl/util/mat4.hpp>
 #include <mbgl/util/feature.hpp>
 #include <mbgl/util/range.hpp>
+#include <mbgl/util/timer.hpp>
 
+#include <array>
 #include <memory>
 #include <unordered_map>
 #include <vector>
@@ -27,10 +34,6 @@ class TransformState;
 class RenderTile;
 class RenderedQueryOptions;
 
-namespace algorithm {
-class ClipIDGenerator;
-} // namespace algorithm
-
 namespace style {
 
 class UpdateParameters;
@@ -58,9 +61,11 @@ public:
     // data with fresh style information.
     void reloadTiles();
 
-    void startRender(algorithm::ClipIDGenerator&,
-                     const mat4& projMatrix,
-                     const TransformState&);
+    // Whether this source's tiles participate in stencil clipping, i.e.
+    // whether the clip ID generator needs to see its render tiles.
+    bool clipsTiles() const;
+
+    void startRender(const mat4& projMatrix, const TransformState&);
     void finishRender(Painter&);
 
     std::map<UnwrappedTileID, RenderTile>& getRenderTiles();
@@ -68,11 +73,31 @@ public:
     std::unordered_map<std::string, std::vector<Feature>>
     queryRenderedFeatures(const ScreenLineString& geometry,
                           const TransformState& transformState,
+                          const std::unordered_map<std::string, const Layer*>& layers,
+                          const float additionalQueryRadius,
                           const RenderedQueryOptions& options) const;
 
+    // Appends this source's candidate tiles (with the query geometry already
+    // projected into tile space) to an off-thread query snapshot.
+    void snapshotQueryTiles(FeatureQuerySnapshot&,
+                            const ScreenLineString& geometry,
+                            const TransformState& transformState) const;
+
     std::vector<Feature> querySourceFeatures(const SourceQueryOptions&);
+    void setQueryAttributeIndexes(std::vector<std::string>);
+
+    void setFeatureState(uint64_t featureID, const PropertyMap& state);
+
+    // Session snapshot support. serializeTileData re-encodes each loaded
+    // tile's parsed data (restricted to the named source layers) for
+    // Map::createSessionSnapshot; seedTileData stashes restored blobs, which
+    // are handed to matching tiles as they are created.
+    std::vector<std::pair<OverscaledTileID, std::string>>
+    serializeTileData(const std::vector<std::string>& layerNames) const;
+    void seedTileData(std::map<OverscaledTileID, std::shared_ptr<const std::string>>);
 
     void setCacheSize(size_t);
+    void setMinimumUpdateInterval(Duration);
     void onLowMemory();
 
     void setObserver(SourceObserver*);
@@ -103,6 +128,23 @@ protected:
 private:
     void removeStaleTiles(const std::set<OverscaledTileID>&);
 
+    // Attributes querySourceFeatures keeps hash indexes for; see
+    // Source::setQueryAttributeIndexes.
+    std::vector<std::string> queryAttributeIndexes;
+
+    // Current feature state by feature id; the authoritative copy from which
+    // newly created tiles are seeded. See Source::setFeatureState.
+    FeatureStates featureStates;
+
+    // Restored session snapshot blobs awaiting a tile request for their ID;
+    // consumed (and erased) as tiles are created.
+    std::map<OverscaledTileID, std::shared_ptr<const std::string>> seededTileData;
+
+    // Shared tile walk for the sync query and the snapshot builder; defined
+    // in the translation unit, which is its only user.
+    template <class Fn>
+    void forEachQueryTile(const ScreenLineString&, const TransformState&, Fn&&) const;
+
     // TileObserver implementation.
     void onTileChanged(Tile&) override;
     void onTileError(Tile&, std::exception_ptr) override;
@@ -111,6 +153,56 @@ private:
     virtual std::unique_ptr<Tile> createTile(const OverscaledTileID&, const UpdateParameters&) = 0;
 
     std::map<UnwrappedTileID, RenderTile> renderTiles;
+
+    // Per-tile matrices from the previous frame. They only change with the
+    // camera, so while the projection matrix is stable (fades, still frames)
+    // they are reused instead of recomputed.
+    std::map<UnwrappedTileID, mat4> tileMatrices;
+    mat4 tileMatricesProjMatrix = {{}};
+
+    // Update throttling state. The inputs below determine the tile cover and
+    // placement config; while they are unchanged, no tile changed underneath
+    // the render tile set, and the configured minimum update interval is
+    // still open, updateTiles returns without re-evaluating the cover. See
+    // Source::setMinimumUpdateInterval.
+    struct UpdateInputs {
+        int32_t overscaledZoom;
+        Size size;
+        double angle;
+        double pitch;
+        bool collisionDebug;
+        // Tile-quantized viewport corners; panning changes them only when a
+        // corner crosses a tile boundary.
+        std::array<int64_t, 8> cornerTiles;
+
+        bool operator==(const UpdateInputs&) const;
+    };
+    Duration minimumUpdateInterval = Duration::zero();
+    TimePoint lastFullUpdate = TimePoint::min();
+    optional<UpdateInputs> lastUpdateInputs;
+    bool tilesChangedSinceUpdate = false;
+
+    // Camera samples from the previous updateTiles call, used to estimate the
+    // viewport's velocity for predictive tile prefetch.
+    optional<LatLng> prefetchPrevCenter;
+    TimePoint prefetchPrevTime = TimePoint::min();
+
+    // Placement throttling state. In continuous mode, a changed placement
+    // config is applied at most once per throttle interval; the latest
+    // withheld config is flushed by the timer when the camera comes to rest.
+    optional<PlacementConfig> appliedPlacementConfig;
+    optional<PlacementConfig> pendingPlacementConfig;
+    TimePoint lastPlacementUpdate = TimePoint::min();
+    util::Timer placementTimer;
+
+    // Zoom settle state. Crossing an integer zoom boundary mid-gesture is
+    // deferred — the previous pyramid level keeps rendering within ±1 zoom
+    // through the tile matrix — until the zoom has stopped moving; the timer
+    // requests the frame that applies the deferred level.
+    optional<int32_t> appliedTileZoom;
+    double lastObservedZoom = 0;
+    TimePoint lastZoomChange = TimePoint::min();
+    util::Timer zoomSettleTimer;
 };
 
 } // namespace style
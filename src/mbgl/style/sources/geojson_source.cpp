@@ -18,6 +18,11 @@ void GeoJSONSource::setGeoJSON(const mapbox::geojson::geojson& geoJSON) {
     impl->setGeoJSON(geoJSON);
 }
 
+void GeoJSONSource::updateFeatures(const std::vector<Feature>& addOrUpdate,
+                                   const std::vector<FeatureIdentifier>& remove) {
+    impl->updateFeatures(addOrUpdate, remove);
+}
+
 optional<std::string> GeoJSONSource::getURL() const {
     return impl->getURL();
 }
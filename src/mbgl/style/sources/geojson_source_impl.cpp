@@ -60,6 +60,64 @@ void GeoJSONSource::Impl::setGeoJSON(const GeoJSON& geoJSON) {
 
 // Private implementation
 void GeoJSONSource::Impl::_setGeoJSON(const GeoJSON& geoJSON) {
+    features.clear();
+    featureIndexById.clear();
+    hasFeatureCollection = geoJSON.is<mapbox::geometry::feature_collection<double>>();
+    if (hasFeatureCollection) {
+        features = geoJSON.get<mapbox::geometry::feature_collection<double>>();
+        for (std::size_t i = 0; i < features.size(); i++) {
+            if (features[i].id) {
+                featureIndexById[*features[i].id] = i;
+            }
+        }
+    }
+
+    retile(geoJSON);
+}
+
+void GeoJSONSource::Impl::updateFeatures(const std::vector<Feature>& addOrUpdate,
+                                         const std::vector<FeatureIdentifier>& remove) {
+    if (!hasFeatureCollection) {
+        Log::Error(Event::General,
+                   "updateFeatures requires the source data to be a feature collection");
+        return;
+    }
+
+    for (const auto& id : remove) {
+        auto it = featureIndexById.find(id);
+        if (it == featureIndexById.end()) {
+            continue;
+        }
+        const std::size_t index = it->second;
+        featureIndexById.erase(it);
+        features.erase(features.begin() + index);
+        for (auto& entry : featureIndexById) {
+            if (entry.second > index) {
+                entry.second--;
+            }
+        }
+    }
+
+    for (const auto& feature : addOrUpdate) {
+        if (feature.id) {
+            auto it = featureIndexById.find(*feature.id);
+            if (it != featureIndexById.end()) {
+                features[it->second] = feature;
+                continue;
+            }
+            featureIndexById[*feature.id] = features.size();
+        }
+        features.push_back(feature);
+    }
+
+    // geojson-vt and supercluster can't patch their trees in place, so the
+    // index is rebuilt; the per-tile relayout — the expensive part — is
+    // skipped by GeoJSONTile::updateData for tiles whose clipped output is
+    // unchanged.
+    retile(GeoJSON { features });
+}
+
+void GeoJSONSource::Impl::retile(const GeoJSON& geoJSON) {
     double scale = util::EXTENT / util::tileSize;
 
     cache.clear();
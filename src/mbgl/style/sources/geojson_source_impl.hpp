@@ -3,6 +3,9 @@
 #include <mbgl/style/source_impl.hpp>
 #include <mbgl/style/sources/geojson_source.hpp>
 #include <mbgl/util/variant.hpp>
+#include <mbgl/util/feature.hpp>
+
+#include <map>
 #include <mbgl/tile/geojson_tile.hpp>
 
 namespace mbgl {
@@ -20,6 +23,8 @@ public:
     optional<std::string> getURL() const;
 
     void setGeoJSON(const GeoJSON&);
+    void updateFeatures(const std::vector<Feature>& addOrUpdate,
+                        const std::vector<FeatureIdentifier>& remove);
     void setTileData(GeoJSONTile&, const OverscaledTileID& tileID);
 
     void loadDescription(FileSource&) final;
@@ -32,11 +37,19 @@ public:
 
 private:
     void _setGeoJSON(const GeoJSON&);
+    void retile(const GeoJSON&);
 
     std::unique_ptr<Tile> createTile(const OverscaledTileID&, const UpdateParameters&) final;
 
     GeoJSONOptions options;
     optional<std::string> url;
+
+    // Current data and an id lookup into it, backing the diff update path.
+    // Only populated when the data is a feature collection.
+    mapbox::geometry::feature_collection<double> features;
+    std::map<FeatureIdentifier, std::size_t> featureIndexById;
+    bool hasFeatureCollection = false;
+
     std::unique_ptr<AsyncRequest> req;
     variant<GeoJSONVTPointer, SuperclusterPointer> geoJSONOrSupercluster;
 };
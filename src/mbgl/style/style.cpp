@@ -24,16 +24,20 @@
 #include <mbgl/geometry/line_atlas.hpp>
 #include <mbgl/renderer/render_item.hpp>
 #include <mbgl/renderer/render_tile.hpp>
+#include <mbgl/map/feature_query.hpp>
 #include <mbgl/util/constants.hpp>
 #include <mbgl/util/exception.hpp>
 #include <mbgl/util/geometry.hpp>
 #include <mbgl/util/string.hpp>
+#include <mbgl/util/startup_timeline.hpp>
 #include <mbgl/util/logging.hpp>
 #include <mbgl/util/math.hpp>
+#include <mbgl/util/rapidjson.hpp>
 #include <mbgl/math/minmax.hpp>
 #include <mbgl/map/query.hpp>
 
 #include <algorithm>
+#include <unordered_set>
 
 namespace mbgl {
 namespace style {
@@ -42,7 +46,7 @@ static Observer nullObserver;
 
 Style::Style(FileSource& fileSource_, float pixelRatio)
     : fileSource(fileSource_),
-      glyphAtlas(std::make_unique<GlyphAtlas>(Size{ 2048, 2048 }, fileSource)),
+      glyphAtlas(std::make_unique<GlyphAtlas>(Size{ 2048, 512 }, fileSource)),
       spriteAtlas(std::make_unique<SpriteAtlas>(Size{ 1024, 1024 }, pixelRatio)),
       lineAtlas(std::make_unique<LineAtlas>(Size{ 256, 512 })),
       observer(&nullObserver) {
@@ -68,6 +72,7 @@ Style::~Style() {
 bool Style::addClass(const std::string& className) {
     if (hasClass(className)) return false;
     classes.push_back(className);
+    updateBatch.cascadeAllLayers = true;
     return true;
 }
 
@@ -79,6 +84,7 @@ bool Style::removeClass(const std::string& className) {
     const auto it = std::find(classes.begin(), classes.end(), className);
     if (it != classes.end()) {
         classes.erase(it);
+        updateBatch.cascadeAllLayers = true;
         return true;
     }
     return false;
@@ -86,6 +92,7 @@ bool Style::removeClass(const std::string& className) {
 
 void Style::setClasses(const std::vector<std::string>& classNames) {
     classes = classNames;
+    updateBatch.cascadeAllLayers = true;
 }
 
 std::vector<std::string> Style::getClasses() const {
@@ -94,6 +101,7 @@ std::vector<std::string> Style::getClasses() const {
 
 void Style::setTransitionOptions(const TransitionOptions& options) {
     transitionOptions = options;
+    updateBatch.cascadeAllLayers = true;
 }
 
 TransitionOptions Style::getTransitionOptions() const {
@@ -101,16 +109,20 @@ TransitionOptions Style::getTransitionOptions() const {
 }
 
 void Style::setJSON(const std::string& json) {
-    sources.clear();
-    layers.clear();
-    classes.clear();
-    transitionOptions = {};
-    updateBatch = {};
-
     Parser parser;
     auto error = parser.parse(json);
 
     if (error) {
+        sources.clear();
+        layers.clear();
+        classes.clear();
+        transitionOptions = {};
+        updateBatch = {};
+        sourceDefinitions.clear();
+        layerDefinitions.clear();
+        spriteURL.clear();
+        glyphURL.clear();
+
         std::string message = "Failed to parse style: " + util::toString(error);
         Log::Error(Event::ParseStyle, message.c_str());
         observer->onStyleError(std::make_exception_ptr(util::StyleParseException(message)));
@@ -118,12 +130,33 @@ void Style::setJSON(const std::string& json) {
         return;
     }
 
-    for (auto& source : parser.sources) {
-        addSource(std::move(source));
-    }
+    if (loaded && parser.glyphURL == glyphURL) {
+        // A style is already applied; map unchanged sources and layers onto
+        // the existing objects — preserving loaded tile pyramids and buckets
+        // — and rebuild only what actually differs.
+        applyJSONDiff(parser);
+    } else {
+        if (loaded) {
+            // A changed glyph source invalidates everything the glyph atlas
+            // holds; rebuild from scratch rather than diff.
+            while (!layers.empty()) {
+                removeLayer(layers.back()->getID());
+            }
+            while (!sources.empty()) {
+                removeSource(sources.back()->getID());
+            }
+            classes.clear();
+            transitionOptions = {};
+            updateBatch = {};
+        }
+
+        for (auto& source : parser.sources) {
+            addSource(std::move(source));
+        }
 
-    for (auto& layer : parser.layers) {
-        addLayer(std::move(layer));
+        for (auto& layer : parser.layers) {
+            addLayer(std::move(layer));
+        }
     }
 
     name = parser.name;
@@ -133,10 +166,19 @@ void Style::setJSON(const std::string& json) {
     defaultPitch = parser.pitch;
 
     glyphAtlas->setURL(parser.glyphURL);
-    spriteAtlas->load(parser.spriteURL, fileSource);
+    if (!loaded || parser.spriteURL != spriteURL) {
+        spriteAtlas->load(parser.spriteURL, fileSource);
+    }
+    spriteURL = parser.spriteURL;
+    glyphURL = parser.glyphURL;
+
+    sourceDefinitions = std::move(parser.sourceDefinitions);
+    layerDefinitions = std::move(parser.layerDefinitions);
 
     loaded = true;
 
+    util::markStartupMilestone(StartupMilestone::StyleParsed);
+
     observer->onStyleLoaded();
 }
 
@@ -213,19 +255,24 @@ Layer* Style::addLayer(std::unique_ptr<Layer> layer, optional<std::string> befor
         throw std::runtime_error(std::string{"Layer "} + layer->getID() + " already exists");
     }
 
-    if (SymbolLayer* symbolLayer = layer->as<SymbolLayer>()) {
+    prepareLayer(*layer);
+
+    return layers.emplace(before ? findLayer(*before) : layers.end(), std::move(layer))->get();
+}
+
+void Style::prepareLayer(Layer& layer) {
+    if (SymbolLayer* symbolLayer = layer.as<SymbolLayer>()) {
         if (!symbolLayer->impl->spriteAtlas) {
             symbolLayer->impl->spriteAtlas = spriteAtlas.get();
         }
     }
 
-    if (CustomLayer* customLayer = layer->as<CustomLayer>()) {
+    if (CustomLayer* customLayer = layer.as<CustomLayer>()) {
         customLayer->impl->initialize();
     }
 
-    layer->baseImpl->setObserver(this);
-
-    return layers.emplace(before ? findLayer(*before) : layers.end(), std::move(layer))->get();
+    layer.baseImpl->setObserver(this);
+    updateBatch.cascadeLayerIDs.insert(layer.getID());
 }
 
 std::unique_ptr<Layer> Style::removeLayer(const std::string& id) {
@@ -246,6 +293,22 @@ std::unique_ptr<Layer> Style::removeLayer(const std::string& id) {
     return layer;
 }
 
+void Style::moveLayer(const std::string& id, optional<std::string> before) {
+    auto it = findLayer(id);
+    if (it == layers.end()) {
+        return;
+    }
+
+    // Render order is derived from the position in `layers` on every frame,
+    // and clip IDs are regenerated per frame as well, so moving a layer needs
+    // no cascade, no recalculation, and no tile relayout. Symbol placement
+    // priorities follow the order the workers last saw; they catch up with
+    // the next relayout.
+    std::unique_ptr<Layer> layer = std::move(layers[it - layers.begin()]);
+    layers.erase(it);
+    layers.emplace(before ? findLayer(*before) : layers.end(), std::move(layer));
+}
+
 std::string Style::getName() const {
     return name;
 }
@@ -287,6 +350,13 @@ void Style::relayout() {
 }
 
 void Style::cascade(const TimePoint& timePoint, MapMode mode) {
+    // Cascading is only needed when its inputs changed: the class list,
+    // the transition options, or a layer's paint properties. The batch
+    // records which layers are affected so unchanged ones are skipped.
+    if (!updateBatch.cascadeAllLayers && updateBatch.cascadeLayerIDs.empty()) {
+        return;
+    }
+
     // When in continuous mode, we can either have user- or style-defined
     // transitions. Still mode is always immediate.
     static const TransitionOptions immediateTransition {};
@@ -304,8 +374,13 @@ void Style::cascade(const TimePoint& timePoint, MapMode mode) {
     };
 
     for (const auto& layer : layers) {
-        layer->baseImpl->cascade(parameters);
+        if (updateBatch.cascadeAllLayers || updateBatch.cascadeLayerIDs.count(layer->baseImpl->id)) {
+            layer->baseImpl->cascade(parameters);
+        }
     }
+
+    updateBatch.cascadeAllLayers = false;
+    updateBatch.cascadeLayerIDs.clear();
 }
 
 void Style::recalculate(float z, const TimePoint& timePoint, MapMode mode) {
@@ -399,8 +474,8 @@ bool Style::isLoaded() const {
     return true;
 }
 
-RenderData Style::getRenderData(MapDebugOptions debugOptions, float angle) const {
-    RenderData result;
+RenderData Style::getRenderData(MapDebugOptions debugOptions, float angle, util::Arena& arena) const {
+    RenderData result(arena);
 
     for (const auto& source : sources) {
         if (source->baseImpl->enabled) {
@@ -447,7 +522,8 @@ RenderData Style::getRenderData(MapDebugOptions debugOptions, float angle) const
         // Sort symbol tiles in opposite y position, so tiles with overlapping
         // symbols are drawn on top of each other, with lower symbols being
         // drawn on top of higher symbols.
-        std::vector<std::reference_wrapper<RenderTile>> sortedTiles;
+        util::ArenaVector<std::reference_wrapper<RenderTile>> sortedTiles{
+            util::ArenaAllocator<std::reference_wrapper<RenderTile>>(arena)};
         std::transform(renderTiles.begin(), renderTiles.end(), std::back_inserter(sortedTiles),
                 [](auto& pair) { return std::ref(pair.second); });
         if (symbolLayer) {
@@ -511,6 +587,14 @@ std::vector<Feature> Style::queryRenderedFeatures(const ScreenLineString& geomet
         }
     }
 
+    std::unordered_map<std::string, const Layer*> layersByID;
+    layersByID.reserve(layers.size());
+    for (const auto& layer : layers) {
+        layersByID.emplace(layer->baseImpl->id, layer.get());
+    }
+
+    const float queryRadius = getQueryRadius();
+
     std::vector<Feature> result;
     std::unordered_map<std::string, std::vector<Feature>> resultsByLayer;
 
@@ -519,7 +603,7 @@ std::vector<Feature> Style::queryRenderedFeatures(const ScreenLineString& geomet
             continue;
         }
 
-        auto sourceResults = source->baseImpl->queryRenderedFeatures(geometry, transformState, options);
+        auto sourceResults = source->baseImpl->queryRenderedFeatures(geometry, transformState, layersByID, queryRadius, options);
         std::move(sourceResults.begin(), sourceResults.end(), std::inserter(resultsByLayer, resultsByLayer.begin()));
     }
 
@@ -541,6 +625,48 @@ std::vector<Feature> Style::queryRenderedFeatures(const ScreenLineString& geomet
     return result;
 }
 
+FeatureQuerySnapshot Style::makeQuerySnapshot(const ScreenLineString& geometry,
+                                              const TransformState& transformState,
+                                              const RenderedQueryOptions& options) const {
+    FeatureQuerySnapshot snapshot;
+    snapshot.options = options;
+    snapshot.bearing = transformState.getAngle();
+    snapshot.queryRadius = getQueryRadius();
+
+    std::unordered_set<std::string> sourceFilter;
+
+    if (options.layerIDs) {
+        for (const auto& layerID : *options.layerIDs) {
+            auto layer = getLayer(layerID);
+            if (layer) sourceFilter.emplace(layer->baseImpl->source);
+        }
+    }
+
+    // Clone the rendered layers (restricted to the requested ones), freezing
+    // their currently evaluated properties; non-rendered layers would be
+    // dropped from the final result anyway, so they are never queried.
+    for (const auto& layer : layers) {
+        if (!layer->baseImpl->needsRendering(zoomHistory.lastZoom)) {
+            continue;
+        }
+        if (options.layerIDs &&
+            std::find(options.layerIDs->begin(), options.layerIDs->end(), layer->baseImpl->id) == options.layerIDs->end()) {
+            continue;
+        }
+        snapshot.layers.push_back(layer->baseImpl->clone());
+    }
+
+    for (const auto& source : sources) {
+        if (!sourceFilter.empty() && sourceFilter.find(source->getID()) == sourceFilter.end()) {
+            continue;
+        }
+
+        source->baseImpl->snapshotQueryTiles(snapshot, geometry, transformState);
+    }
+
+    return snapshot;
+}
+
 float Style::getQueryRadius() const {
     float additionalRadius = 0;
     for (auto& layer : layers) {
@@ -645,6 +771,174 @@ struct QueueSourceReloadVisitor {
     }
 };
 
+namespace {
+
+bool isDataDriven(const JSValue& value) {
+    return value.IsObject() && value.HasMember("property");
+}
+
+// Whether a paint delta can cascade onto existing buckets. Constant paint
+// values feed uniforms and need no relayout, but data-driven functions are
+// baked into bucket attribute data by the worker, so a change to one — on
+// either side of the diff — requires the layer's source to relayout.
+bool paintDeltaRequiresRelayout(const std::string& oldJSON, const std::string& newJSON) {
+    JSDocument oldDoc;
+    JSDocument newDoc;
+    oldDoc.Parse<0>(oldJSON.c_str());
+    newDoc.Parse<0>(newJSON.c_str());
+    if (oldDoc.HasParseError() || newDoc.HasParseError() ||
+        !oldDoc.IsObject() || !newDoc.IsObject()) {
+        return true;
+    }
+
+    // The serialized paint definition is an object of paint blocks ("paint",
+    // "paint.<class>"), each holding property values.
+    const auto changedPropertyIsDataDriven = [] (const JSValue& from, const JSValue& to) {
+        for (const auto& block : from.GetObject()) {
+            if (!block.value.IsObject()) {
+                continue;
+            }
+            auto blockIt = to.FindMember(block.name);
+            const JSValue* toBlock =
+                blockIt != to.MemberEnd() && blockIt->value.IsObject() ? &blockIt->value : nullptr;
+            for (const auto& property : block.value.GetObject()) {
+                const JSValue* toValue = nullptr;
+                if (toBlock) {
+                    auto it = toBlock->FindMember(property.name);
+                    if (it != toBlock->MemberEnd()) {
+                        toValue = &it->value;
+                    }
+                }
+                if (toValue && *toValue == property.value) {
+                    continue;
+                }
+                if (isDataDriven(property.value) || (toValue && isDataDriven(*toValue))) {
+                    return true;
+                }
+            }
+        }
+        return false;
+    };
+
+    return changedPropertyIsDataDriven(oldDoc, newDoc) ||
+           changedPropertyIsDataDriven(newDoc, oldDoc);
+}
+
+} // namespace
+
+void Style::applyJSONDiff(Parser& parser) {
+    // setJSON replaces the whole style: runtime additions go away and
+    // cascade inputs reset, exactly as on a full load.
+    if (!classes.empty()) {
+        updateBatch.cascadeAllLayers = true;
+    }
+    classes.clear();
+    transitionOptions = {};
+
+    // Sources: keep objects whose definition is byte-identical, preserving
+    // their loaded tile pyramids; anything else is removed and re-added.
+    std::vector<std::string> sourceIDs;
+    sourceIDs.reserve(sources.size());
+    for (const auto& source : sources) {
+        sourceIDs.push_back(source->getID());
+    }
+    for (const auto& id : sourceIDs) {
+        auto incoming = parser.sourceDefinitions.find(id);
+        auto existing = sourceDefinitions.find(id);
+        if (incoming == parser.sourceDefinitions.end() ||
+            existing == sourceDefinitions.end() ||
+            existing->second != incoming->second) {
+            removeSource(id);
+        }
+    }
+    for (auto& source : parser.sources) {
+        if (!getSource(source->getID())) {
+            addSource(std::move(source));
+        }
+    }
+
+    // Layers whose structural members (anything but paint) changed need new
+    // objects and new buckets. "ref" layers borrow their referent's layout,
+    // so structural changes propagate through reference chains.
+    std::unordered_set<std::string> structurallyChanged;
+    for (const auto& pair : parser.layerDefinitions) {
+        auto existing = layerDefinitions.find(pair.first);
+        if (existing == layerDefinitions.end() ||
+            existing->second.structural != pair.second.structural) {
+            structurallyChanged.insert(pair.first);
+        }
+    }
+    bool propagated = true;
+    while (propagated) {
+        propagated = false;
+        for (const auto& pair : parser.layerDefinitions) {
+            if (!pair.second.ref.empty() &&
+                !structurallyChanged.count(pair.first) &&
+                structurallyChanged.count(pair.second.ref)) {
+                structurallyChanged.insert(pair.first);
+                propagated = true;
+            }
+        }
+    }
+
+    // Rebuild the layer vector in the incoming order; render order follows
+    // the vector position per frame, so reordering alone costs nothing.
+    std::vector<std::unique_ptr<Layer>> newLayers;
+    newLayers.reserve(parser.layers.size());
+
+    for (auto& parsed : parser.layers) {
+        const std::string id = parsed->getID();
+
+        std::unique_ptr<Layer> existing;
+        auto it = findLayer(id);
+        if (it != layers.end()) {
+            existing = std::move(layers[it - layers.begin()]);
+            layers.erase(it);
+        }
+
+        auto incomingDef = parser.layerDefinitions.find(id);
+        auto existingDef = layerDefinitions.find(id);
+        const bool reusable = existing &&
+            incomingDef != parser.layerDefinitions.end() &&
+            existingDef != layerDefinitions.end() &&
+            !structurallyChanged.count(id);
+
+        if (!reusable) {
+            // New or structurally changed: fresh object, fresh buckets.
+            if (existing) {
+                if (CustomLayer* customLayer = existing->as<CustomLayer>()) {
+                    customLayer->impl->deinitialize();
+                }
+            }
+            prepareLayer(*parsed);
+            parsed->accept(QueueSourceReloadVisitor { updateBatch });
+            newLayers.push_back(std::move(parsed));
+        } else if (existingDef->second.paint != incomingDef->second.paint) {
+            // Paint-only delta: swap in the freshly parsed object. Buckets
+            // are keyed by the interned layer id, so they survive, and the
+            // new cascading paint reaches them on the next cascade.
+            if (paintDeltaRequiresRelayout(existingDef->second.paint, incomingDef->second.paint)) {
+                parsed->accept(QueueSourceReloadVisitor { updateBatch });
+            }
+            prepareLayer(*parsed);
+            newLayers.push_back(std::move(parsed));
+        } else {
+            // Identical definition: keep the existing object untouched.
+            newLayers.push_back(std::move(existing));
+        }
+    }
+
+    // Whatever remains was removed from the style; a kept source must
+    // rebuild its tiles without the layer's buckets.
+    for (const auto& removed : layers) {
+        if (CustomLayer* customLayer = removed->as<CustomLayer>()) {
+            customLayer->impl->deinitialize();
+        }
+        removed->accept(QueueSourceReloadVisitor { updateBatch });
+    }
+    layers = std::move(newLayers);
+}
+
 void Style::onLayerFilterChanged(Layer& layer) {
     layer.accept(QueueSourceReloadVisitor { updateBatch });
     observer->onUpdate(Update::Layout);
@@ -655,11 +949,13 @@ void Style::onLayerVisibilityChanged(Layer& layer) {
     observer->onUpdate(Update::RecalculateStyle | Update::Layout);
 }
 
-void Style::onLayerPaintPropertyChanged(Layer&) {
+void Style::onLayerPaintPropertyChanged(Layer& layer) {
+    updateBatch.cascadeLayerIDs.insert(layer.getID());
     observer->onUpdate(Update::RecalculateStyle | Update::Classes);
 }
 
 void Style::onLayerDataDrivenPaintPropertyChanged(Layer& layer) {
+    updateBatch.cascadeLayerIDs.insert(layer.getID());
     layer.accept(QueueSourceReloadVisitor { updateBatch });
     observer->onUpdate(Update::RecalculateStyle | Update::Classes | Update::Layout);
 }
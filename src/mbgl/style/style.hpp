@@ -2,6 +2,7 @@
 
 #include <mbgl/style/transition_options.hpp>
 #include <mbgl/style/observer.hpp>
+#include <mbgl/style/parser.hpp>
 #include <mbgl/style/source_observer.hpp>
 #include <mbgl/style/layer_observer.hpp>
 #include <mbgl/style/update_batch.hpp>
@@ -30,6 +31,11 @@ class LineAtlas;
 class RenderData;
 class TransformState;
 class RenderedQueryOptions;
+class FeatureQuerySnapshot;
+
+namespace util {
+class Arena;
+} // namespace util
 
 namespace style {
 
@@ -78,6 +84,8 @@ public:
     Layer* addLayer(std::unique_ptr<Layer>,
                     optional<std::string> beforeLayerID = {});
     std::unique_ptr<Layer> removeLayer(const std::string& layerID);
+    void moveLayer(const std::string& layerID,
+                   optional<std::string> beforeLayerID = {});
 
     std::string getName() const;
     LatLng getDefaultLatLng() const;
@@ -95,12 +103,21 @@ public:
     bool hasClass(const std::string&) const;
     std::vector<std::string> getClasses() const;
 
-    RenderData getRenderData(MapDebugOptions, float angle) const;
+    // The returned RenderData's containers are backed by the passed frame
+    // arena and are only valid until it is reset.
+    RenderData getRenderData(MapDebugOptions, float angle, util::Arena&) const;
 
     std::vector<Feature> queryRenderedFeatures(const ScreenLineString& geometry,
                                                const TransformState& transformState,
                                                const RenderedQueryOptions& options) const;
 
+    // Captures everything an asynchronous rendered-features query needs —
+    // cloned layers, per-tile indexes, projected geometry — so it can run on
+    // a worker thread without touching the live style.
+    FeatureQuerySnapshot makeQuerySnapshot(const ScreenLineString& geometry,
+                                           const TransformState& transformState,
+                                           const RenderedQueryOptions& options) const;
+
     float getQueryRadius() const;
 
     void setSourceTileCacheSize(size_t);
@@ -119,6 +136,17 @@ private:
     std::vector<std::string> classes;
     TransitionOptions transitionOptions;
 
+    // Serialized definitions of the currently applied style, so a later
+    // setJSON can map unchanged sources and layers onto existing objects
+    // instead of rebuilding them.
+    std::unordered_map<std::string, std::string> sourceDefinitions;
+    std::unordered_map<std::string, Parser::LayerDefinition> layerDefinitions;
+    std::string spriteURL;
+    std::string glyphURL;
+
+    void applyJSONDiff(Parser&);
+    void prepareLayer(Layer&);
+
     // Defaults
     std::string name;
     LatLng defaultLatLng;
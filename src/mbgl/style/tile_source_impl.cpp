@@ -62,7 +62,19 @@ void TileSourceImpl::loadDescription(FileSource& fileSource) {
     }
 
     const std::string& url = urlOrTileset.get<std::string>();
-    req = fileSource.request(Resource::source(url), [this, url](Response res) {
+
+    // Serve the manifest parsed in an earlier session right away, so tile
+    // requests start without waiting out the TileJSON round trip. The request
+    // below still revalidates it; should the manifest have changed in the
+    // meantime, the tiles-changed handling in the callback reloads the tiles.
+    optional<Tileset> cachedTileset = fileSource.getCachedTileset(url);
+    if (cachedTileset) {
+        tileset = *cachedTileset;
+        loaded = true;
+        observer->onSourceLoaded(base);
+    }
+
+    req = fileSource.request(Resource::source(url), [this, url, &fileSource](Response res) {
         if (res.error) {
             observer->onSourceError(base, std::make_exception_ptr(std::runtime_error(res.error->message)));
         } else if (res.notModified) {
@@ -103,6 +115,8 @@ void TileSourceImpl::loadDescription(FileSource& fileSource) {
                 // Center/bounds changed: We're not using these values currently
             }
 
+            fileSource.putCachedTileset(url, newTileset, res.expires);
+
             tileset = newTileset;
             loaded = true;
 
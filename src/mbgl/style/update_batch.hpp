@@ -9,6 +9,13 @@ namespace style {
 class UpdateBatch {
 public:
     std::unordered_set<std::string> sourceIDs;
+
+    // Layers whose paint properties changed since the last cascade. When a
+    // change affects every layer at once (class or transition options), the
+    // flag is set instead of enumerating the IDs. The flag starts out set so
+    // that a freshly parsed style is cascaded in full.
+    std::unordered_set<std::string> cascadeLayerIDs;
+    bool cascadeAllLayers = true;
 };
 
 } // namespace style
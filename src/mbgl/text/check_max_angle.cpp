@@ -2,6 +2,7 @@
 #include <mbgl/geometry/anchor.hpp>
 #include <mbgl/util/math.hpp>
 
+#include <deque>
 #include <queue>
 
 namespace mbgl{
@@ -13,7 +14,8 @@ struct Corner {
     float angleDelta;
 };
 
-bool checkMaxAngle(const GeometryCoordinates& line,
+bool checkMaxAngle(util::Arena& arena,
+                   const GeometryCoordinates& line,
                    const Anchor& anchor,
                    const float labelLength,
                    const float windowSize,
@@ -41,7 +43,8 @@ bool checkMaxAngle(const GeometryCoordinates& line,
     index++;
 
     // store recent corners and their total angle difference
-    std::queue<Corner> recentCorners;
+    std::queue<Corner, std::deque<Corner, util::ArenaAllocator<Corner>>> recentCorners{
+        std::deque<Corner, util::ArenaAllocator<Corner>>(util::ArenaAllocator<Corner>(arena))};
     float recentAngleDelta = 0;
 
      // move forwards by the length of the label and check angles along the way
@@ -1,12 +1,14 @@
 #pragma once
 
 #include <mbgl/tile/geometry_tile_data.hpp>
+#include <mbgl/util/arena.hpp>
 
 namespace mbgl {
 
 class Anchor;
 
-bool checkMaxAngle(const GeometryCoordinates& line,
+bool checkMaxAngle(util::Arena&,
+                   const GeometryCoordinates& line,
                    const Anchor& anchor,
                    const float labelLength,
                    const float windowSize,
@@ -3,7 +3,8 @@
 
 namespace mbgl {
 
-CollisionFeature::CollisionFeature(const GeometryCoordinates& line,
+CollisionFeature::CollisionFeature(CollisionBoxStore& store,
+                                   const GeometryCoordinates& line,
                                    const Anchor& anchor,
                                    const float top,
                                    const float bottom,
@@ -14,7 +15,8 @@ CollisionFeature::CollisionFeature(const GeometryCoordinates& line,
                                    const style::SymbolPlacementType placement,
                                    IndexedSubfeature indexedFeature_,
                                    const bool straight)
-        : indexedFeature(std::move(indexedFeature_)) {
+        : boxStart(static_cast<uint32_t>(store.size())),
+          indexedFeature(std::move(indexedFeature_)) {
     if (top == 0 && bottom == 0 && left == 0 && right == 0) return;
 
     const float y1 = top * boxScale - padding;
@@ -36,17 +38,19 @@ CollisionFeature::CollisionFeature(const GeometryCoordinates& line,
             // used for icon labels that are aligned with the line, but don't curve along it
             const GeometryCoordinate vector = convertPoint<int16_t>(util::unit(convertPoint<double>(line[anchor.segment + 1] - line[anchor.segment])) * length);
             const GeometryCoordinates newLine({ anchorPoint - vector, anchorPoint + vector });
-            bboxifyLabel(newLine, anchorPoint, 0, length, height);
+            bboxifyLabel(store, newLine, anchorPoint, 0, length, height);
         } else {
             // used for text labels that curve along a line
-            bboxifyLabel(line, anchorPoint, anchor.segment, length, height);
+            bboxifyLabel(store, line, anchorPoint, anchor.segment, length, height);
         }
     } else {
-        boxes.emplace_back(anchor.point, x1, y1, x2, y2, std::numeric_limits<float>::infinity());
+        store.emplace_back(anchor.point, x1, y1, x2, y2, std::numeric_limits<float>::infinity());
     }
+
+    boxCount = static_cast<uint32_t>(store.size()) - boxStart;
 }
 
-void CollisionFeature::bboxifyLabel(const GeometryCoordinates& line, GeometryCoordinate& anchorPoint,
+void CollisionFeature::bboxifyLabel(CollisionBoxStore& store, const GeometryCoordinates& line, GeometryCoordinate& anchorPoint,
                                     const int segment, const float labelLength, const float boxSize) {
     const float step = boxSize / 2;
     const unsigned int nBoxes = std::floor(labelLength / step);
@@ -102,7 +106,7 @@ void CollisionFeature::bboxifyLabel(const GeometryCoordinates& line, GeometryCoo
         const float distanceToInnerEdge = std::max(std::fabs(boxDistanceToAnchor - firstBoxOffset) - step / 2, 0.0f);
         const float maxScale = labelLength / 2 / distanceToInnerEdge;
 
-        boxes.emplace_back(boxAnchor, -boxSize / 2, -boxSize / 2, boxSize / 2, boxSize / 2, maxScale);
+        store.emplace_back(boxAnchor, -boxSize / 2, -boxSize / 2, boxSize / 2, boxSize / 2, maxScale);
     }
 }
 
@@ -5,6 +5,7 @@
 #include <mbgl/tile/geometry_tile_data.hpp>
 #include <mbgl/geometry/feature_index.hpp>
 
+#include <cstdint>
 #include <vector>
 
 namespace mbgl {
@@ -31,29 +32,37 @@ public:
     float placementScale = 0.0f;
 };
 
+// All collision boxes of a tile in one contiguous slab. Each CollisionFeature
+// references its boxes by index range, so placement streams over a single
+// array instead of chasing a separate heap allocation per line label.
+using CollisionBoxStore = std::vector<CollisionBox>;
+
 class CollisionFeature {
 public:
     // for text
-    CollisionFeature(const GeometryCoordinates& line,
+    CollisionFeature(CollisionBoxStore& store,
+                     const GeometryCoordinates& line,
                      const Anchor& anchor,
                      const Shaping& shapedText,
                      const float boxScale,
                      const float padding,
                      const style::SymbolPlacementType placement,
                      const IndexedSubfeature& indexedFeature_)
-        : CollisionFeature(line, anchor, shapedText.top, shapedText.bottom, shapedText.left, shapedText.right, boxScale, padding, placement, indexedFeature_, false) {}
+        : CollisionFeature(store, line, anchor, shapedText.top, shapedText.bottom, shapedText.left, shapedText.right, boxScale, padding, placement, indexedFeature_, false) {}
 
     // for icons
-    CollisionFeature(const GeometryCoordinates& line,
+    CollisionFeature(CollisionBoxStore& store,
+                     const GeometryCoordinates& line,
                      const Anchor& anchor,
                      const PositionedIcon& shapedIcon,
                      const float boxScale,
                      const float padding,
                      const style::SymbolPlacementType placement,
                      const IndexedSubfeature& indexedFeature_)
-        : CollisionFeature(line, anchor, shapedIcon.top, shapedIcon.bottom, shapedIcon.left, shapedIcon.right, boxScale, padding, placement, indexedFeature_, true) {}
+        : CollisionFeature(store, line, anchor, shapedIcon.top, shapedIcon.bottom, shapedIcon.left, shapedIcon.right, boxScale, padding, placement, indexedFeature_, true) {}
 
-    CollisionFeature(const GeometryCoordinates& line,
+    CollisionFeature(CollisionBoxStore&,
+                     const GeometryCoordinates& line,
                      const Anchor& anchor,
                      const float top,
                      const float bottom,
@@ -65,11 +74,15 @@ public:
                      IndexedSubfeature,
                      const bool straight);
 
-    std::vector<CollisionBox> boxes;
+    // The feature's boxes within the tile's CollisionBoxStore. Point
+    // placements produce exactly one box; only line placements need more.
+    uint32_t boxStart = 0;
+    uint32_t boxCount = 0;
+
     IndexedSubfeature indexedFeature;
 
 private:
-    void bboxifyLabel(const GeometryCoordinates& line, GeometryCoordinate& anchorPoint,
+    void bboxifyLabel(CollisionBoxStore&, const GeometryCoordinates& line, GeometryCoordinate& anchorPoint,
                       const int segment, const float length, const float height);
 };
 
@@ -1,5 +1,6 @@
 #include <mbgl/text/collision_tile.hpp>
 #include <mbgl/geometry/feature_index.hpp>
+#include <mbgl/math/clamp.hpp>
 #include <mbgl/math/log2.hpp>
 #include <mbgl/util/constants.hpp>
 #include <mbgl/util/math.hpp>
@@ -9,11 +10,27 @@
 #include <mapbox/geometry/envelope.hpp>
 #include <mapbox/geometry/multi_point.hpp>
 
+#include <cassert>
 #include <cmath>
+#include <limits>
+#include <unordered_map>
+#include <unordered_set>
 
 namespace mbgl {
 
-CollisionTile::CollisionTile(PlacementConfig config_) : config(std::move(config_)) {
+namespace {
+
+int16_t clampToInt16(float value) {
+    return static_cast<int16_t>(util::clamp<float>(
+        value, std::numeric_limits<int16_t>::min(), std::numeric_limits<int16_t>::max()));
+}
+
+} // namespace
+
+CollisionTile::CollisionTile(PlacementConfig config_)
+    : config(std::move(config_)),
+      tree(util::EXTENT, 16, 0),
+      ignoredTree(util::EXTENT, 16, 0) {
     // Compute the transformation matrix.
     const float angle_sin = std::sin(config.angle);
     const float angle_cos = std::cos(config.angle);
@@ -68,7 +85,7 @@ float CollisionTile::findPlacementScale(const Point<float>& anchor, const Collis
     return minPlacementScale;
 }
 
-float CollisionTile::placeFeature(const CollisionFeature& feature, bool allowOverlap, bool avoidEdges) {
+float CollisionTile::placeFeature(const CollisionFeature& feature, const CollisionBoxStore& store, bool allowOverlap, bool avoidEdges) {
     static const float infinity = std::numeric_limits<float>::infinity();
     static const std::array<CollisionBox, 4> edges {{
         // left
@@ -83,15 +100,15 @@ float CollisionTile::placeFeature(const CollisionFeature& feature, bool allowOve
 
     float minPlacementScale = minScale;
 
-    for (auto& box : feature.boxes) {
+    for (uint32_t i = 0; i < feature.boxCount; i++) {
+        const CollisionBox& box = store[feature.boxStart + i];
         const auto anchor = util::matrixMultiply(rotationMatrix, box.anchor);
 
         if (!allowOverlap) {
-            for (auto it = tree.qbegin(bgi::intersects(getTreeBox(anchor, box))); it != tree.qend(); ++it) {
-                const CollisionBox& blocking = std::get<1>(*it);
-                Point<float> blockingAnchor = util::matrixMultiply(rotationMatrix, blocking.anchor);
+            for (const CollisionTreeBox& treeBox : tree.query(getTreeBox(anchor, box))) {
+                const CollisionBox& blocking = treeBox.box;
 
-                minPlacementScale = util::max(minPlacementScale, findPlacementScale(anchor, box, blockingAnchor, blocking));
+                minPlacementScale = util::max(minPlacementScale, findPlacementScale(anchor, box, treeBox.projectedAnchor, blocking));
                 if (minPlacementScale >= maxScale) return minPlacementScale;
             }
         }
@@ -118,20 +135,21 @@ float CollisionTile::placeFeature(const CollisionFeature& feature, bool allowOve
     return minPlacementScale;
 }
 
-void CollisionTile::insertFeature(CollisionFeature& feature, float minPlacementScale, bool ignorePlacement) {
-    for (auto& box : feature.boxes) {
-        box.placementScale = minPlacementScale;
+void CollisionTile::insertFeature(const CollisionFeature& feature, CollisionBoxStore& store, float minPlacementScale, bool ignorePlacement) {
+    for (uint32_t i = 0; i < feature.boxCount; i++) {
+        store[feature.boxStart + i].placementScale = minPlacementScale;
     }
 
     if (minPlacementScale < maxScale) {
-        std::vector<CollisionTreeBox> treeBoxes;
-        for (auto& box : feature.boxes) {
-            treeBoxes.emplace_back(getTreeBox(util::matrixMultiply(rotationMatrix, box.anchor), box), box, feature.indexedFeature);
-        }
-        if (ignorePlacement) {
-            ignoredTree.insert(treeBoxes.begin(), treeBoxes.end());
-        } else {
-            tree.insert(treeBoxes.begin(), treeBoxes.end());
+        for (uint32_t i = 0; i < feature.boxCount; i++) {
+            const CollisionBox& box = store[feature.boxStart + i];
+            const auto anchor = util::matrixMultiply(rotationMatrix, box.anchor);
+            const auto bbox = getTreeBox(anchor, box);
+            if (ignorePlacement) {
+                ignoredTree.insert({ box, anchor, feature.indexedFeature }, bbox);
+            } else {
+                tree.insert({ box, anchor, feature.indexedFeature }, bbox);
+            }
         }
     }
 
@@ -141,7 +159,7 @@ void CollisionTile::insertFeature(CollisionFeature& feature, float minPlacementS
 // |(x1,y1)      |             | relative to the tile e.g. when zooming in,
 // |             |             | the symbol gets smaller relative to the tile.
 // |  (x1',y1')  v             |
-// |     +-------+-------+     | The boxes inserted into the tree represents
+// |     +-------+-------+     | The boxes inserted into the grid represents
 // |     |       |       |     | the bounds at the integer zoom level (where
 // |     |       |       |     | the symbol is biggest relative to the tile).
 // |     |       |       |     |
@@ -154,16 +172,18 @@ void CollisionTile::insertFeature(CollisionFeature& feature, float minPlacementS
 // |             |             | calculating the bounds at current zoom level
 // |             |      (x2,y2)| we must unscale the box using its center as
 // +---------------------------+ transform origin.
-Box CollisionTile::getTreeBox(const Point<float>& anchor, const CollisionBox& box, const float scale) {
+CollisionTile::Box CollisionTile::getTreeBox(const Point<float>& anchor, const CollisionBox& box, const float scale) {
     assert(box.x1 <= box.x2 && box.y1 <= box.y2);
+    // Round outwards: the grid is only a broad phase, so boxes may be
+    // slightly too big, but must never be too small.
     return Box{
-        CollisionPoint{
-            anchor.x + box.x1 / scale,
-            anchor.y + box.y1 / scale * yStretch
+        {
+            clampToInt16(std::floor(anchor.x + box.x1 / scale)),
+            clampToInt16(std::floor(anchor.y + box.y1 / scale * yStretch))
         },
-        CollisionPoint{
-            anchor.x + box.x2 / scale,
-            anchor.y + box.y2 / scale * yStretch
+        {
+            clampToInt16(std::ceil(anchor.x + box.x2 / scale)),
+            clampToInt16(std::ceil(anchor.y + box.y2 / scale * yStretch))
         }
     };
 }
@@ -182,45 +202,43 @@ std::vector<IndexedSubfeature> CollisionTile::queryRenderedSymbols(const Geometr
         polygon.push_back(convertPoint<int16_t>(rotated));
     }
 
-    // Predicate for ruling out already seen features.
+    const Box envelope = mapbox::geometry::envelope(polygon);
+
+    // For ruling out already seen features.
     std::unordered_map<std::string, std::unordered_set<std::size_t>> sourceLayerFeatures;
-    auto seenFeature = [&] (const CollisionTreeBox& treeBox) -> bool {
-        const IndexedSubfeature& feature = std::get<2>(treeBox);
-        const auto& seenFeatures = sourceLayerFeatures[feature.sourceLayerName];
-        return seenFeatures.find(feature.index) == seenFeatures.end();
-    };
 
     // Account for the rounding done when updating symbol shader variables.
     const float roundedScale = std::pow(2.0f, std::ceil(util::log2(scale) * 10.0f) / 10.0f);
 
-    // Check if feature is rendered (collision free) at current scale.
-    auto visibleAtScale = [&] (const CollisionTreeBox& treeBox) -> bool {
-        const CollisionBox& box = std::get<1>(treeBox);
-        return roundedScale >= box.placementScale && roundedScale <= box.maxScale;
-    };
+    auto queryTree = [&](const auto& tree_) {
+        for (const CollisionTreeBox& treeBox : tree_.query(envelope)) {
+            const CollisionBox& collisionBox = treeBox.box;
+            const IndexedSubfeature& feature = treeBox.indexedFeature;
 
-    // Check if query polygon intersects with the feature box at current scale.
-    auto intersectsAtScale = [&] (const CollisionTreeBox& treeBox) -> bool {
-        const CollisionBox& collisionBox = std::get<1>(treeBox);
-        const auto anchor = util::matrixMultiply(rotationMatrix, collisionBox.anchor);
-        const int16_t x1 = anchor.x + collisionBox.x1 / scale;
-        const int16_t y1 = anchor.y + collisionBox.y1 / scale * yStretch;
-        const int16_t x2 = anchor.x + collisionBox.x2 / scale;
-        const int16_t y2 = anchor.y + collisionBox.y2 / scale * yStretch;
-        auto bbox = GeometryCoordinates {
-            { x1, y1 }, { x2, y1 }, { x2, y2 }, { x1, y2 }
-        };
-        return util::polygonIntersectsPolygon(polygon, bbox);
-    };
+            // Skip already seen features.
+            auto& seenFeatures = sourceLayerFeatures[feature.sourceLayerName];
+            if (seenFeatures.find(feature.index) != seenFeatures.end()) {
+                continue;
+            }
 
-    auto predicates = bgi::satisfies(seenFeature)
-                   && bgi::satisfies(visibleAtScale)
-                   && bgi::satisfies(intersectsAtScale);
+            // Check if feature is rendered (collision free) at current scale.
+            if (roundedScale < collisionBox.placementScale || roundedScale > collisionBox.maxScale) {
+                continue;
+            }
+
+            // Check if query polygon intersects with the feature box at current scale.
+            const auto& anchor = treeBox.projectedAnchor;
+            const int16_t x1 = anchor.x + collisionBox.x1 / scale;
+            const int16_t y1 = anchor.y + collisionBox.y1 / scale * yStretch;
+            const int16_t x2 = anchor.x + collisionBox.x2 / scale;
+            const int16_t y2 = anchor.y + collisionBox.y2 / scale * yStretch;
+            auto bbox = GeometryCoordinates {
+                { x1, y1 }, { x2, y1 }, { x2, y2 }, { x1, y2 }
+            };
+            if (!util::polygonIntersectsPolygon(polygon, bbox)) {
+                continue;
+            }
 
-    auto queryTree = [&](const auto& tree_) {
-        for (auto it = tree_.qbegin(predicates); it != tree_.qend(); ++it) {
-            const IndexedSubfeature& feature = std::get<2>(*it);
-            auto& seenFeatures = sourceLayerFeatures[feature.sourceLayerName];
             seenFeatures.insert(feature.index);
             result.push_back(feature);
         }
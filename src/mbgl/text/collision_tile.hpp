@@ -3,47 +3,44 @@
 #include <mbgl/text/collision_feature.hpp>
 #include <mbgl/text/placement_config.hpp>
 #include <mbgl/tile/geometry_tile_data.hpp>
+#include <mbgl/util/grid_index.hpp>
 
-#pragma GCC diagnostic push
-#pragma GCC diagnostic ignored "-Wunused-function"
-#pragma GCC diagnostic ignored "-Wunused-parameter"
-#pragma GCC diagnostic ignored "-Wunused-variable"
-#pragma GCC diagnostic ignored "-Wshadow"
-#ifdef __clang__
-#pragma GCC diagnostic ignored "-Wunknown-pragmas"
-#endif
-#pragma GCC diagnostic ignored "-Wpragmas"
-#pragma GCC diagnostic ignored "-Wdeprecated-register"
-#pragma GCC diagnostic ignored "-Wshorten-64-to-32"
-#pragma GCC diagnostic ignored "-Wunused-local-typedefs"
-#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
-#include <boost/geometry.hpp>
-#include <boost/geometry/geometries/point.hpp>
-#include <boost/geometry/geometries/box.hpp>
-#include <boost/geometry/index/rtree.hpp>
-#pragma GCC diagnostic pop
+#include <array>
+#include <utility>
+#include <vector>
 
 namespace mbgl {
 
-namespace bg = boost::geometry;
-namespace bgm = bg::model;
-namespace bgi = bg::index;
-typedef bgm::point<float, 2, bg::cs::cartesian> CollisionPoint;
-typedef bgm::box<CollisionPoint> Box;
-typedef std::tuple<Box, CollisionBox, IndexedSubfeature> CollisionTreeBox;
-typedef bgi::rtree<CollisionTreeBox, bgi::linear<16, 4>> Tree;
-
 class IndexedSubfeature;
 
+// A blocking box as stored in the collision grid, with its anchor already
+// rotated into the tile's placement angle. The tile is built per placement
+// pass with a fixed angle, so projecting once at insertion replaces a matrix
+// multiply for every time the box turns up in a query. Lives at namespace
+// scope so that grid_index.cpp can name it in its explicit instantiation
+// list.
+class CollisionTreeBox {
+public:
+    CollisionBox box;
+    Point<float> projectedAnchor;
+    IndexedSubfeature indexedFeature;
+};
+
 class CollisionTile {
 public:
     explicit CollisionTile(PlacementConfig);
 
-    float placeFeature(const CollisionFeature&, bool allowOverlap, bool avoidEdges);
-    void insertFeature(CollisionFeature&, float minPlacementScale, bool ignorePlacement);
+    float placeFeature(const CollisionFeature&, const CollisionBoxStore&, bool allowOverlap, bool avoidEdges);
+    void insertFeature(const CollisionFeature&, CollisionBoxStore&, float minPlacementScale, bool ignorePlacement);
 
     std::vector<IndexedSubfeature> queryRenderedSymbols(const GeometryCoordinates&, float scale) const;
 
+    // Number of grid queries issued while placing and querying against this
+    // tile, for placement instrumentation.
+    uint64_t gridQueryCount() const {
+        return tree.queryCount() + ignoredTree.queryCount();
+    }
+
     const PlacementConfig config;
 
     const float minScale = 0.5f;
@@ -54,13 +51,15 @@ public:
     std::array<float, 4> reverseRotationMatrix;
 
 private:
+    using Box = GridIndex<CollisionTreeBox>::BBox;
+
     float findPlacementScale(
             const Point<float>& anchor, const CollisionBox& box,
             const Point<float>& blockingAnchor, const CollisionBox& blocking);
     Box getTreeBox(const Point<float>& anchor, const CollisionBox& box, const float scale = 1.0);
 
-    Tree tree;
-    Tree ignoredTree;
+    GridIndex<CollisionTreeBox> tree;
+    GridIndex<CollisionTreeBox> ignoredTree;
 };
 
 } // namespace mbgl
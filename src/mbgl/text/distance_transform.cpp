@@ -0,0 +1,115 @@
+#include <mbgl/text/distance_transform.hpp>
+#include <mbgl/math/clamp.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace mbgl {
+
+namespace {
+
+const double infinity = 1e20;
+
+// One-dimensional squared distance transform of the sampled function f,
+// writing the result to d. v and z are scratch space for the lower envelope
+// of parabolas (section 2 of the Felzenszwalb & Huttenlocher paper).
+void transformColumn(std::vector<double>& f,
+                     std::vector<double>& d,
+                     std::vector<int32_t>& v,
+                     std::vector<double>& z,
+                     const uint32_t n) {
+    v[0] = 0;
+    z[0] = -infinity;
+    z[1] = infinity;
+
+    int32_t k = 0;
+    for (uint32_t q = 1; q < n; q++) {
+        double s = ((f[q] + q * q) - (f[v[k]] + v[k] * v[k])) / (2 * q - 2 * v[k]);
+        while (s <= z[k]) {
+            k--;
+            s = ((f[q] + q * q) - (f[v[k]] + v[k] * v[k])) / (2 * q - 2 * v[k]);
+        }
+        k++;
+        v[k] = q;
+        z[k] = s;
+        z[k + 1] = infinity;
+    }
+
+    k = 0;
+    for (uint32_t q = 0; q < n; q++) {
+        while (z[k + 1] < q) {
+            k++;
+        }
+        const double dx = static_cast<double>(q) - v[k];
+        d[q] = dx * dx + f[v[k]];
+    }
+}
+
+// Two-dimensional squared distance transform, computed separably: first along
+// each column, then along each row of the column result.
+void transform(std::vector<double>& grid, const uint32_t width, const uint32_t height) {
+    const uint32_t n = std::max(width, height);
+    std::vector<double> f(n);
+    std::vector<double> d(n);
+    std::vector<int32_t> v(n);
+    std::vector<double> z(n + 1);
+
+    for (uint32_t x = 0; x < width; x++) {
+        for (uint32_t y = 0; y < height; y++) {
+            f[y] = grid[y * width + x];
+        }
+        transformColumn(f, d, v, z, height);
+        for (uint32_t y = 0; y < height; y++) {
+            grid[y * width + x] = d[y];
+        }
+    }
+
+    for (uint32_t y = 0; y < height; y++) {
+        for (uint32_t x = 0; x < width; x++) {
+            f[x] = grid[y * width + x];
+        }
+        transformColumn(f, d, v, z, width);
+        for (uint32_t x = 0; x < width; x++) {
+            grid[y * width + x] = d[x];
+        }
+    }
+}
+
+} // namespace
+
+AlphaImage transformRasterToSDF(const AlphaImage& raster, const double radius, const double cutoff) {
+    const uint32_t width = raster.size.width;
+    const uint32_t height = raster.size.height;
+    const uint32_t pixels = width * height;
+
+    // Antialiased edge pixels contribute a fractional squared distance, so the
+    // field crosses zero exactly at the shape's edge rather than at a pixel
+    // boundary.
+    std::vector<double> gridOuter(pixels);
+    std::vector<double> gridInner(pixels);
+
+    for (uint32_t i = 0; i < pixels; i++) {
+        const double a = double(raster.data[i]) / 255;
+        gridOuter[i] = a == 1.0 ? 0.0
+                     : a == 0.0 ? infinity
+                     : std::pow(std::max(0.0, 0.5 - a), 2);
+        gridInner[i] = a == 1.0 ? infinity
+                     : a == 0.0 ? 0.0
+                     : std::pow(std::max(0.0, a - 0.5), 2);
+    }
+
+    transform(gridOuter, width, height);
+    transform(gridInner, width, height);
+
+    AlphaImage sdf({ width, height });
+    for (uint32_t i = 0; i < pixels; i++) {
+        const double distance = std::sqrt(gridOuter[i]) - std::sqrt(gridInner[i]);
+        sdf.data[i] = static_cast<uint8_t>(
+            util::clamp(std::round(255.0 - 255.0 * (distance / radius + cutoff)), 0.0, 255.0));
+    }
+
+    return sdf;
+}
+
+} // namespace mbgl
@@ -0,0 +1,19 @@
+#pragma once
+
+#include <mbgl/util/image.hpp>
+
+namespace mbgl {
+
+// Converts a rasterized glyph or icon bitmap into a signed distance field of
+// the same dimensions, suitable for insertion into GlyphAtlas. `radius` is the
+// distance, in pixels, over which the field falls off on either side of the
+// shape's edge; `cutoff` shifts where the edge lands within the encoded 0-255
+// range (the edge is encoded at 255 * (1 - cutoff)).
+//
+// Uses the exact Euclidean distance transform from Felzenszwalb & Huttenlocher,
+// "Distance Transforms of Sampled Functions" (Theory of Computing, 2012) — the
+// same algorithm as mapbox/tiny-sdf. Runs in linear time in the number of
+// pixels; a 30×30 glyph transforms in the tens of microseconds.
+AlphaImage transformRasterToSDF(const AlphaImage& raster, double radius, double cutoff);
+
+} // namespace mbgl
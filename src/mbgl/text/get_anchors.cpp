@@ -2,13 +2,28 @@
 #include <mbgl/text/check_max_angle.hpp>
 #include <mbgl/util/constants.hpp>
 #include <mbgl/util/interpolate.hpp>
+#include <mbgl/util/optional.hpp>
 
 #include <cassert>
 #include <cmath>
 
 namespace mbgl {
 
-static Anchors resample(const GeometryCoordinates& line,
+// Distances from the start of the line to each vertex, so that segment and
+// line lengths are computed once per line and shared by both resampling
+// passes rather than re-deriving a square root per segment per pass.
+static util::ArenaVector<float> cumulativeDistances(util::Arena& arena, const GeometryCoordinates& line) {
+    util::ArenaVector<float> distances(line.size(), util::ArenaAllocator<float>(arena));
+    distances[0] = 0;
+    for (std::size_t i = 0; i + 1 < line.size(); i++) {
+        distances[i + 1] = distances[i] + util::dist<float>(line[i], line[i + 1]);
+    }
+    return distances;
+}
+
+static util::ArenaVector<Anchor> resample(util::Arena& arena,
+                        const GeometryCoordinates& line,
+                        const util::ArenaVector<float>& distances,
                         const float offset,
                         const float spacing,
                         const float angleWindowSize,
@@ -17,25 +32,23 @@ static Anchors resample(const GeometryCoordinates& line,
                         const bool continuedLine,
                         const bool placeAtMiddle) {
     const float halfLabelLength = labelLength / 2.0f;
-    float lineLength = 0;
-    for (auto it = line.begin(), end = line.end() - 1; it != end; it++) {
-        lineLength += util::dist<float>(*(it), *(it + 1));
-    }
+    const float lineLength = distances.back();
 
-    float distance = 0;
     float markedDistance = offset - spacing;
 
-    Anchors anchors;
+    util::ArenaVector<Anchor> anchors{util::ArenaAllocator<Anchor>(arena)};
 
     assert(spacing > 0.0);
 
-    int i = 0;
-    for (auto it = line.begin(), end = line.end() - 1; it != end; it++, i++) {
-        const GeometryCoordinate& a = *(it);
-        const GeometryCoordinate& b = *(it + 1);
+    for (std::size_t i = 0; i + 1 < line.size(); i++) {
+        const GeometryCoordinate& a = line[i];
+        const GeometryCoordinate& b = line[i + 1];
 
-        const float segmentDist = util::dist<float>(a, b);
-        const float angle = util::angle_to(b, a);
+        const float distance = distances[i];
+        const float segmentDist = distances[i + 1] - distance;
+
+        // Only pay for the atan2 when an anchor actually lands on this segment.
+        optional<float> angle;
 
         while (markedDistance + spacing < distance + segmentDist) {
             markedDistance += spacing;
@@ -50,15 +63,17 @@ static Anchors resample(const GeometryCoordinates& line,
             if (x >= 0 && x < util::EXTENT && y >= 0 && y < util::EXTENT &&
                     markedDistance - halfLabelLength >= 0.0f &&
                     markedDistance + halfLabelLength <= lineLength) {
-                Anchor anchor(::round(x), ::round(y), angle, 0.5f, i);
+                if (!angle) {
+                    angle = util::angle_to(b, a);
+                }
 
-                if (!angleWindowSize || checkMaxAngle(line, anchor, labelLength, angleWindowSize, maxAngle)) {
+                Anchor anchor(::round(x), ::round(y), *angle, 0.5f, static_cast<int>(i));
+
+                if (!angleWindowSize || checkMaxAngle(arena, line, anchor, labelLength, angleWindowSize, maxAngle)) {
                     anchors.push_back(anchor);
                 }
             }
         }
-
-        distance += segmentDist;
     }
 
     if (!placeAtMiddle && anchors.empty() && !continuedLine) {
@@ -67,13 +82,14 @@ static Anchors resample(const GeometryCoordinates& line,
         // This has the most effect for short lines in overscaled tiles, since the
         // initial offset used in overscaled tiles is calculated to align labels with positions in
         // parent tiles instead of placing the label as close to the beginning as possible.
-        anchors = resample(line, distance / 2, spacing, angleWindowSize, maxAngle, labelLength, continuedLine, true);
+        anchors = resample(arena, line, distances, lineLength / 2, spacing, angleWindowSize, maxAngle, labelLength, continuedLine, true);
     }
 
     return anchors;
 }
 
-Anchors getAnchors(const GeometryCoordinates& line,
+util::ArenaVector<Anchor> getAnchors(util::Arena& arena,
+                   const GeometryCoordinates& line,
                    float spacing,
                    const float maxAngle,
                    const float textLeft,
@@ -84,7 +100,7 @@ Anchors getAnchors(const GeometryCoordinates& line,
                    const float boxScale,
                    const float overscaling) {
     if (line.empty()) {
-        return {};
+        return util::ArenaVector<Anchor>{util::ArenaAllocator<Anchor>(arena)};
     }
 
     // Resample a line to get anchor points for labels and check that each
@@ -117,7 +133,8 @@ Anchors getAnchors(const GeometryCoordinates& line,
     std::fmod((labelLength / 2 + fixedExtraOffset) * boxScale * overscaling, spacing) :
     std::fmod(spacing / 2 * overscaling, spacing);
 
-    return resample(line, offset, spacing, angleWindowSize, maxAngle, labelLength * boxScale, continuedLine, false);
+    return resample(arena, line, cumulativeDistances(arena, line), offset, spacing, angleWindowSize, maxAngle,
+                    labelLength * boxScale, continuedLine, false);
 }
 
 } // namespace mbgl
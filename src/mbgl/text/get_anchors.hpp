@@ -2,11 +2,15 @@
 
 #include <mbgl/geometry/anchor.hpp>
 #include <mbgl/tile/geometry_tile_data.hpp>
+#include <mbgl/util/arena.hpp>
 #include <mbgl/util/math.hpp>
 
 namespace mbgl {
 
-Anchors getAnchors(const GeometryCoordinates& line,
+// Anchor candidates are layout scratch; the arena backs them and the caller
+// reclaims them wholesale once the symbols are built.
+util::ArenaVector<Anchor> getAnchors(util::Arena&,
+                   const GeometryCoordinates& line,
                    float spacing,
                    const float maxAngle,
                    const float textLeft,
@@ -4,6 +4,7 @@
 #include <mbgl/gl/context.hpp>
 #include <mbgl/util/logging.hpp>
 #include <mbgl/util/platform.hpp>
+#include <mbgl/util/shared_parse_cache.hpp>
 #include <mbgl/storage/file_source.hpp>
 #include <mbgl/storage/resource.hpp>
 #include <mbgl/storage/response.hpp>
@@ -15,6 +16,20 @@ namespace mbgl {
 
 static GlyphAtlasObserver nullObserver;
 
+namespace {
+
+// Decoded glyph ranges, shared across atlases. Several map views of the same
+// style each run their own GlyphAtlas; the range PBFs come out of the file
+// source's caches quickly, but decoding one is not cheap and a style easily
+// touches dozens of ranges. Capacity is generous: a parsed range is a few
+// hundred kilobytes, and 256 of them cover multiple styles' worth of fonts.
+util::SharedParseCache<std::vector<SDFGlyph>>& glyphParseCache() {
+    static util::SharedParseCache<std::vector<SDFGlyph>> cache(256);
+    return cache;
+}
+
+} // namespace
+
 GlyphAtlas::GlyphAtlas(const Size size, FileSource& fileSource_)
     : fileSource(fileSource_),
       observer(&nullObserver),
@@ -60,14 +75,32 @@ void GlyphAtlas::getGlyphs(GlyphRequestor& requestor, GlyphDependencies glyphDep
         Entry& entry = entries[fontStack];
 
         const GlyphIDs& glyphIDs = dependency.second;
-        GlyphRangeSet ranges;
+        std::map<GlyphRange, std::size_t> rangeCounts;
         for (const auto& glyphID : glyphIDs) {
-            ranges.insert(getGlyphRange(glyphID));
+            if (localGlyphRasterizer.canRasterizeGlyph(fontStack, glyphID)) {
+                // Generate the glyph from a platform font instead of fetching
+                // its entire 256 glyph range over the network.
+                if (entry.glyphSet.getSDFs().find(glyphID) == entry.glyphSet.getSDFs().end()) {
+                    entry.glyphSet.insert(localGlyphRasterizer.rasterizeGlyph(fontStack, glyphID));
+                }
+            } else {
+                rangeCounts[getGlyphRange(glyphID)]++;
+            }
         }
 
-        for (const auto& range : ranges) {
-            if (!rangeIsParsed(entry.ranges, range)) {
-                GlyphRequest& request = requestRange(entry, fontStack, range);
+        // Issue range requests in order of how many of the requestor's glyphs
+        // each unblocks, so whatever ordering the transport preserves favors
+        // the ranges that light up the most labels. A rarely used range (a
+        // stray CJK character, say) goes last instead of ahead of the range
+        // carrying the tile's base alphabet.
+        std::vector<std::pair<GlyphRange, std::size_t>> orderedRanges(
+            rangeCounts.begin(), rangeCounts.end());
+        std::stable_sort(orderedRanges.begin(), orderedRanges.end(),
+                         [](const auto& a, const auto& b) { return a.second > b.second; });
+
+        for (const auto& rangeCount : orderedRanges) {
+            if (!rangeIsParsed(entry.ranges, rangeCount.first)) {
+                GlyphRequest& request = requestRange(entry, fontStack, rangeCount.first);
                 request.requestors[&requestor] = dependencies;
             }
         }
@@ -87,36 +120,49 @@ GlyphAtlas::GlyphRequest& GlyphAtlas::requestRange(Entry& entry, const FontStack
         return request;
     }
 
-    request.req = fileSource.request(Resource::glyphs(glyphURL, fontStack, range),
-        [this, &entry, &request, fontStack, range](Response res) {
+    const Resource resource = Resource::glyphs(glyphURL, fontStack, range);
+    const std::string url = resource.url;
+
+    request.req = fileSource.request(resource,
+        [this, &entry, &request, fontStack, range, url](Response res) {
             if (res.error) {
                 observer->onGlyphsError(fontStack, range, std::make_exception_ptr(std::runtime_error(res.error->message)));
             } else if (res.notModified) {
                 return;
             } else {
                 if (!res.noContent) {
-                    std::vector<SDFGlyph> glyphs;
-
-                    try {
-                        glyphs = parseGlyphPBF(range, *res.data);
-                    } catch (...) {
-                        observer->onGlyphsError(fontStack, range, std::current_exception());
-                        return;
+                    std::shared_ptr<const std::vector<SDFGlyph>> glyphs =
+                        glyphParseCache().get(url, { res.data });
+
+                    if (!glyphs) {
+                        try {
+                            glyphs = std::make_shared<const std::vector<SDFGlyph>>(
+                                parseGlyphPBF(range, *res.data));
+                        } catch (...) {
+                            observer->onGlyphsError(fontStack, range, std::current_exception());
+                            return;
+                        }
+                        glyphParseCache().put(url, { res.data }, glyphs);
                     }
 
-                    for (auto& glyph : glyphs) {
-                        entry.glyphSet.insert(std::move(glyph));
+                    for (const auto& glyph : *glyphs) {
+                        SDFGlyph copy;
+                        copy.id = glyph.id;
+                        copy.bitmap = glyph.bitmap.clone();
+                        copy.metrics = glyph.metrics;
+                        entry.glyphSet.insert(std::move(copy));
                     }
                 }
 
                 request.parsed = true;
 
+                // Notify every waiting requestor now rather than once its
+                // whole dependency set has loaded: addGlyphs only reports
+                // ranges that have actually been parsed, and the requestor
+                // tracks per-glyph availability, so each range that arrives
+                // unblocks its share of the tile's labels immediately.
                 for (auto& pair : request.requestors) {
-                    GlyphRequestor& requestor = *pair.first;
-                    const std::shared_ptr<GlyphDependencies>& dependencies = pair.second;
-                    if (dependencies.unique()) {
-                        addGlyphs(requestor, *dependencies);
-                    }
+                    addGlyphs(*pair.first, *pair.second);
                 }
 
                 request.requestors.clear();
@@ -145,8 +191,14 @@ void GlyphAtlas::addGlyphs(GlyphRequestor& requestor, const GlyphDependencies& g
         const auto& sdfs = entry.glyphSet.getSDFs();
 
         for (const auto& glyphID : glyphIDs) {
-            loadedRanges.insert(getGlyphRange(glyphID));
             auto it = sdfs.find(glyphID);
+            // Report the glyph's range as loaded if it was parsed, or if the
+            // glyph was rasterized locally (those have an SDF without their
+            // range ever being fetched). A glyph whose range is still in
+            // flight stays pending at the requestor.
+            if (it != sdfs.end() || rangeIsParsed(entry.ranges, getGlyphRange(glyphID))) {
+                loadedRanges.insert(getGlyphRange(glyphID));
+            }
             if (it == sdfs.end())
                 continue;
 
@@ -178,6 +230,12 @@ void GlyphAtlas::addGlyph(GlyphRequestor& requestor,
     // The glyph is already in this texture.
     if (it != face.end()) {
         GlyphValue& value = it->second;
+        if (value.unused) {
+            // The glyph was unreferenced but still resident; take it off the
+            // eviction queue instead of re-copying its bitmap.
+            unusedGlyphs.erase(*value.unused);
+            value.unused = {};
+        }
         value.ids.insert(&requestor);
         return;
     }
@@ -200,7 +258,7 @@ void GlyphAtlas::addGlyph(GlyphRequestor& requestor,
     width += (4 - width % 4);
     height += (4 - height % 4);
 
-    Rect<uint16_t> rect = bin.allocate(width, height);
+    Rect<uint16_t> rect = allocateRect(width, height);
     if (rect.w == 0) {
         Log::Error(Event::OpenGL, "glyph bitmap overflow");
         return;
@@ -213,34 +271,87 @@ void GlyphAtlas::addGlyph(GlyphRequestor& requestor,
     dirty = true;
 }
 
-void GlyphAtlas::removeGlyphValues(GlyphRequestor& requestor, std::map<uint32_t, GlyphValue>& face) {
-    for (auto it = face.begin(); it != face.end(); /* we advance in the body */) {
-        GlyphValue& value = it->second;
+void GlyphAtlas::removeGlyphValues(GlyphRequestor& requestor, const FontStack& fontStack, std::map<uint32_t, GlyphValue>& face) {
+    for (auto& pair : face) {
+        GlyphValue& value = pair.second;
         value.ids.erase(&requestor);
 
-        if (value.ids.empty()) {
-            const Rect<uint16_t>& rect = value.rect;
+        if (value.ids.empty() && !value.unused) {
+            // Keep the bitmap resident so a tile coming back into view can
+            // reuse it; it is only evicted once the atlas runs out of space.
+            value.unused =
+                unusedGlyphs.insert(unusedGlyphs.end(), UnusedGlyph { fontStack, pair.first });
+        }
+    }
+}
 
-            // Clear out the bitmap.
-            uint8_t *target = image.data.get();
-            for (uint32_t y = 0; y < rect.h; y++) {
-                uint32_t y1 = image.size.width * (rect.y + y) + rect.x;
-                for (uint32_t x = 0; x < rect.w; x++) {
-                    target[y1 + x] = 0;
-                }
-            }
+Rect<uint16_t> GlyphAtlas::allocateRect(const uint16_t width, const uint16_t height) {
+    while (true) {
+        Rect<uint16_t> rect = bin.allocate(width, height);
+        if (rect.w != 0) {
+            return rect;
+        }
+        // Evict glyphs that no tile references anymore, least recently
+        // released first, before spending memory on a larger atlas.
+        if (evictOneUnusedGlyph()) {
+            continue;
+        }
+        if (!grow()) {
+            return rect;
+        }
+    }
+}
+
+bool GlyphAtlas::evictOneUnusedGlyph() {
+    if (unusedGlyphs.empty()) {
+        return false;
+    }
+
+    const UnusedGlyph unused = std::move(unusedGlyphs.front());
+    unusedGlyphs.pop_front();
+
+    auto entryIt = entries.find(unused.fontStack);
+    assert(entryIt != entries.end());
+    std::map<uint32_t, GlyphValue>& face = entryIt->second.glyphValues;
+    auto it = face.find(unused.glyphID);
+    assert(it != face.end());
 
-            bin.release(rect);
+    const Rect<uint16_t>& rect = it->second.rect;
 
-            // Make sure to post-increment the iterator: This will return the
-            // current iterator, but will go to the next position before we
-            // erase the element from the map. That way, the iterator stays
-            // valid.
-            face.erase(it++);
-        } else {
-            ++it;
+    // Clear out the bitmap.
+    uint8_t *target = image.data.get();
+    for (uint32_t y = 0; y < rect.h; y++) {
+        uint32_t y1 = image.size.width * (rect.y + y) + rect.x;
+        for (uint32_t x = 0; x < rect.w; x++) {
+            target[y1 + x] = 0;
         }
     }
+
+    bin.release(rect);
+    face.erase(it);
+    return true;
+}
+
+bool GlyphAtlas::grow() {
+    // Roughly the guaranteed GL_MAX_TEXTURE_SIZE of the smallest devices we
+    // still target.
+    const uint32_t maximumHeight = 4096;
+    if (image.size.height >= maximumHeight) {
+        return false;
+    }
+
+    // Glyph rects are stored in atlas pixels and the shaders divide by the
+    // current atlas size, so existing quads stay valid as the atlas grows.
+    const uint32_t oldHeight = image.size.height;
+    AlphaImage grown({ image.size.width, oldHeight * 2 });
+    AlphaImage::copy(image, grown, { 0, 0 }, { 0, 0 }, image.size);
+    image = std::move(grown);
+    imageMemory.update(image.bytes());
+
+    bin.release({ 0, static_cast<uint16_t>(oldHeight),
+                  static_cast<uint16_t>(image.size.width), static_cast<uint16_t>(oldHeight) });
+    dirty = true;
+    return true;
 }
 
 void GlyphAtlas::removePendingRanges(mbgl::GlyphRequestor& requestor, std::map<GlyphRange, GlyphRequest>& ranges) {
@@ -251,7 +362,7 @@ void GlyphAtlas::removePendingRanges(mbgl::GlyphRequestor& requestor, std::map<G
 
 void GlyphAtlas::removeGlyphs(GlyphRequestor& requestor) {
     for (auto& entry : entries) {
-        removeGlyphValues(requestor, entry.second.glyphValues);
+        removeGlyphValues(requestor, entry.first, entry.second.glyphValues);
         removePendingRanges(requestor, entry.second.ranges);
     }
 }
@@ -4,7 +4,9 @@
 #include <mbgl/text/glyph_atlas_observer.hpp>
 #include <mbgl/text/glyph_range.hpp>
 #include <mbgl/text/glyph_set.hpp>
+#include <mbgl/text/local_glyph_rasterizer.hpp>
 #include <mbgl/geometry/binpack.hpp>
+#include <mbgl/util/memory_stats.hpp>
 #include <mbgl/util/noncopyable.hpp>
 #include <mbgl/util/optional.hpp>
 #include <mbgl/util/font_stack.hpp>
@@ -13,6 +15,7 @@
 #include <mbgl/gl/texture.hpp>
 #include <mbgl/gl/object.hpp>
 
+#include <list>
 #include <string>
 #include <unordered_set>
 #include <unordered_map>
@@ -70,12 +73,26 @@ public:
 private:
     FileSource& fileSource;
     std::string glyphURL;
+    LocalGlyphRasterizer localGlyphRasterizer;
+
+    // A glyph that is no longer referenced by any tile but is kept resident
+    // in the atlas, so tiles coming back into view don't pay for re-copying
+    // its bitmap. Least recently released glyphs are evicted first when the
+    // atlas runs out of space.
+    struct UnusedGlyph {
+        FontStack fontStack;
+        uint32_t glyphID;
+    };
 
     struct GlyphValue {
         GlyphValue(Rect<uint16_t> rect_, GlyphRequestor* id)
             : rect(std::move(rect_)), ids({ id }) {}
         Rect<uint16_t> rect;
         std::unordered_set<GlyphRequestor*> ids;
+
+        // Set while the glyph is unreferenced, pointing at its position in
+        // the eviction queue.
+        optional<std::list<UnusedGlyph>::iterator> unused;
     };
 
     struct GlyphRequest {
@@ -103,13 +120,21 @@ private:
     void addGlyphs(GlyphRequestor&, const GlyphDependencies&);
     void addGlyph(GlyphRequestor&, const FontStack&, const SDFGlyph&);
 
-    void removeGlyphValues(GlyphRequestor&, std::map<uint32_t, GlyphValue>&);
+    void removeGlyphValues(GlyphRequestor&, const FontStack&, std::map<uint32_t, GlyphValue>&);
     void removePendingRanges(GlyphRequestor&, std::map<GlyphRange, GlyphRequest>&);
 
+    // Allocates atlas space, evicting unreferenced glyphs and then growing
+    // the atlas if necessary. Returns a zero-width rect when full.
+    Rect<uint16_t> allocateRect(uint16_t width, uint16_t height);
+    bool evictOneUnusedGlyph();
+    bool grow();
+
     GlyphAtlasObserver* observer = nullptr;
 
     BinPack<uint16_t> bin;
     AlphaImage image;
+    util::TrackedMemory imageMemory { MemoryCategory::Atlases, image.bytes() };
+    std::list<UnusedGlyph> unusedGlyphs;
     bool dirty;
     mbgl::optional<gl::Texture> texture;
 };
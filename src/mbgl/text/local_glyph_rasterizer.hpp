@@ -0,0 +1,38 @@
+#pragma once
+
+#include <mbgl/text/glyph_pbf.hpp>
+#include <mbgl/util/font_stack.hpp>
+#include <mbgl/util/noncopyable.hpp>
+#include <mbgl/util/optional.hpp>
+
+#include <memory>
+#include <string>
+
+namespace mbgl {
+
+// Generates SDF glyphs from locally installed fonts, so that eligible glyphs
+// never require a glyph range request over the network. Only characters whose
+// metrics can be synthesized without full text shaping are eligible (see
+// util::i18n::allowsFixedWidthGlyphGeneration); everything else continues to
+// go through GlyphPBF.
+//
+// The implementation is platform specific: platforms with a font rendering
+// API provide an Impl that rasterizes from system fonts, while the default
+// implementation declines to rasterize anything.
+class LocalGlyphRasterizer : private util::noncopyable {
+public:
+    // fontFamily names the platform font used for locally generated glyphs.
+    // If unset, the platform picks a default, or disables local generation
+    // if it cannot.
+    LocalGlyphRasterizer(const optional<std::string>& fontFamily = {});
+    ~LocalGlyphRasterizer();
+
+    bool canRasterizeGlyph(const FontStack&, GlyphID);
+    SDFGlyph rasterizeGlyph(const FontStack&, GlyphID);
+
+private:
+    class Impl;
+    std::unique_ptr<Impl> impl;
+};
+
+} // namespace mbgl
@@ -0,0 +1,76 @@
+#include <mbgl/text/shaping_cache.hpp>
+
+#include <boost/functional/hash.hpp>
+
+namespace mbgl {
+
+bool ShapingCache::Key::operator==(const Key& other) const {
+    return text == other.text &&
+           fontStack == other.fontStack &&
+           glyphSource == other.glyphSource &&
+           writingMode == other.writingMode &&
+           maxWidth == other.maxWidth &&
+           lineHeight == other.lineHeight &&
+           horizontalAlign == other.horizontalAlign &&
+           verticalAlign == other.verticalAlign &&
+           justify == other.justify &&
+           spacing == other.spacing &&
+           translate == other.translate;
+}
+
+std::size_t ShapingCache::Hash::operator()(const Key& key) const {
+    std::size_t seed = boost::hash_range(key.text.begin(), key.text.end());
+    boost::hash_combine(seed, boost::hash_range(key.fontStack.begin(), key.fontStack.end()));
+    boost::hash_combine(seed, key.glyphSource);
+    boost::hash_combine(seed, underlying_type(key.writingMode));
+    boost::hash_combine(seed, key.maxWidth);
+    boost::hash_combine(seed, key.lineHeight);
+    boost::hash_combine(seed, key.horizontalAlign);
+    boost::hash_combine(seed, key.verticalAlign);
+    boost::hash_combine(seed, key.justify);
+    boost::hash_combine(seed, key.spacing);
+    boost::hash_combine(seed, key.translate.x);
+    boost::hash_combine(seed, key.translate.y);
+    return seed;
+}
+
+ShapingCache& ShapingCache::shared() {
+    static ShapingCache cache;
+    return cache;
+}
+
+ShapingCache::Shard& ShapingCache::shardFor(const Key& key) {
+    return shards[Hash()(key) % shardCount];
+}
+
+optional<Shaping> ShapingCache::get(const Key& key) {
+    Shard& shard = shardFor(key);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+
+    auto it = shard.entries.find(key);
+    if (it == shard.entries.end()) {
+        return {};
+    }
+
+    shard.keys.splice(shard.keys.begin(), shard.keys, it->second.second);
+    return it->second.first;
+}
+
+void ShapingCache::put(const Key& key, const Shaping& shaping) {
+    Shard& shard = shardFor(key);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+
+    if (shard.entries.find(key) != shard.entries.end()) {
+        return;
+    }
+
+    shard.keys.push_front(key);
+    shard.entries.emplace(key, std::make_pair(shaping, shard.keys.begin()));
+
+    if (shard.entries.size() > shardCapacity) {
+        shard.entries.erase(shard.keys.back());
+        shard.keys.pop_back();
+    }
+}
+
+} // namespace mbgl
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <mbgl/text/glyph.hpp>
+#include <mbgl/util/font_stack.hpp>
+#include <mbgl/util/geometry.hpp>
+#include <mbgl/util/noncopyable.hpp>
+#include <mbgl/util/optional.hpp>
+
+#include <array>
+#include <cstdint>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+
+namespace mbgl {
+
+// Caches getShaping results across tiles and layers. Road networks repeat the
+// same street name across dozens of features, so on label-heavy styles most
+// shaping calls reproduce a result that has already been computed. Entries are
+// keyed by everything that influences the result other than the glyph metrics
+// themselves, which are stable for a given font stack within one glyph
+// source; the source's identity is part of the key so that styles sharing a
+// process with identically named fontstacks but different glyph endpoints
+// never exchange shaped metrics.
+//
+// The cache is sharded by key hash so that tile workers shaping concurrently
+// rarely contend on the same mutex. Each shard evicts least recently used
+// entries beyond a fixed capacity.
+class ShapingCache : private util::noncopyable {
+public:
+    struct Key {
+        std::u16string text;
+        FontStack fontStack;
+        // Identity of the glyph source (atlas instance) the metrics came
+        // from; never dereferenced.
+        uintptr_t glyphSource;
+        WritingModeType writingMode;
+        float maxWidth;
+        float lineHeight;
+        float horizontalAlign;
+        float verticalAlign;
+        float justify;
+        float spacing;
+        Point<float> translate;
+
+        bool operator==(const Key&) const;
+    };
+
+    // The shared per-process instance. Safe to use from multiple workers
+    // concurrently.
+    static ShapingCache& shared();
+
+    optional<Shaping> get(const Key&);
+    void put(const Key&, const Shaping&);
+
+private:
+    struct Hash {
+        std::size_t operator()(const Key&) const;
+    };
+
+    struct Shard {
+        std::mutex mutex;
+        // Most recently used keys at the front.
+        std::list<Key> keys;
+        std::unordered_map<Key, std::pair<Shaping, std::list<Key>::iterator>, Hash> entries;
+    };
+
+    static constexpr std::size_t shardCount = 8;
+    static constexpr std::size_t shardCapacity = 256;
+
+    Shard& shardFor(const Key&);
+
+    std::array<Shard, shardCount> shards;
+};
+
+} // namespace mbgl
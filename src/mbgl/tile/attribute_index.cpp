@@ -0,0 +1,111 @@
+#include <mbgl/tile/attribute_index.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace mbgl {
+
+namespace {
+
+// Canonical hash key for a property value under filter equality semantics:
+// the evaluator compares any two non-bool numeric types through double, so
+// all numerics share one keyspace, while bool and string only ever match
+// themselves. Values equality can never match (null, arrays, objects, NaN)
+// get no key at all.
+struct CanonicalKey {
+    optional<std::string> operator()(bool v) const {
+        return std::string(v ? "b1" : "b0");
+    }
+
+    optional<std::string> operator()(uint64_t v) const {
+        return numeric(double(v));
+    }
+
+    optional<std::string> operator()(int64_t v) const {
+        return numeric(double(v));
+    }
+
+    optional<std::string> operator()(double v) const {
+        return numeric(v);
+    }
+
+    optional<std::string> operator()(const std::string& v) const {
+        return "s" + v;
+    }
+
+    template <class T>
+    optional<std::string> operator()(const T&) const {
+        return {};
+    }
+
+    static optional<std::string> numeric(double v) {
+        if (std::isnan(v)) {
+            return {};
+        }
+        if (v == 0) {
+            v = 0; // Collapse -0.0 into 0.0; they compare equal.
+        }
+        std::string key(1 + sizeof(double), 'n');
+        std::memcpy(&key[1], &v, sizeof(double));
+        return key;
+    }
+};
+
+optional<std::string> canonicalKey(const Value& value) {
+    return Value::visit(value, CanonicalKey {});
+}
+
+} // namespace
+
+AttributeIndex::AttributeIndex(std::vector<std::string> attributes_)
+    : attributes(std::move(attributes_)) {
+}
+
+bool AttributeIndex::indexes(const std::string& attribute) const {
+    return std::find(attributes.begin(), attributes.end(), attribute) != attributes.end();
+}
+
+void AttributeIndex::buildLayer(const GeometryTileLayer& layer, const std::string& sourceLayer) {
+    std::size_t featureCount = layer.featureCount();
+    for (std::size_t i = 0; i < featureCount; i++) {
+        auto feature = layer.getFeature(i);
+        for (const auto& attribute : attributes) {
+            optional<Value> value = feature->getValue(attribute);
+            if (!value) {
+                continue;
+            }
+            optional<std::string> key = canonicalKey(*value);
+            if (!key) {
+                continue;
+            }
+            entries[{ sourceLayer, attribute }][*key].push_back(i);
+        }
+    }
+}
+
+const std::vector<std::size_t>& AttributeIndex::query(const GeometryTileLayer& layer,
+                                                      const std::string& sourceLayer,
+                                                      const std::string& attribute,
+                                                      const Value& value) {
+    static const std::vector<std::size_t> empty;
+
+    if (builtLayers.insert(sourceLayer).second) {
+        buildLayer(layer, sourceLayer);
+    }
+
+    optional<std::string> key = canonicalKey(value);
+    if (!key) {
+        return empty;
+    }
+
+    auto attributeIt = entries.find({ sourceLayer, attribute });
+    if (attributeIt == entries.end()) {
+        return empty;
+    }
+
+    auto valueIt = attributeIt->second.find(*key);
+    return valueIt != attributeIt->second.end() ? valueIt->second : empty;
+}
+
+} // namespace mbgl
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <mbgl/tile/geometry_tile_data.hpp>
+#include <mbgl/util/feature.hpp>
+#include <mbgl/util/noncopyable.hpp>
+#include <mbgl/util/optional.hpp>
+
+#include <cstddef>
+#include <map>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace mbgl {
+
+// Hash indexes over the values of selected feature attributes, so that
+// querySourceFeatures can answer an equality filter like ref=I-80 with a
+// probe instead of scanning every feature of a source layer. A layer is
+// indexed on the first probe against it (one scan) and the index is kept
+// for the lifetime of the tile data it was built from.
+class AttributeIndex : private util::noncopyable {
+public:
+    explicit AttributeIndex(std::vector<std::string> attributes_);
+
+    const std::vector<std::string>& indexedAttributes() const {
+        return attributes;
+    }
+
+    bool indexes(const std::string& attribute) const;
+
+    // Positions of the features in `layer` whose `attribute` may equal
+    // `value` under filter equality. The result is a superset of the true
+    // matches — numeric values share one keyspace via double conversion,
+    // mirroring the filter evaluator — so callers re-apply their full
+    // filter to every candidate.
+    const std::vector<std::size_t>& query(const GeometryTileLayer& layer,
+                                          const std::string& sourceLayer,
+                                          const std::string& attribute,
+                                          const Value& value);
+
+private:
+    void buildLayer(const GeometryTileLayer&, const std::string& sourceLayer);
+
+    const std::vector<std::string> attributes;
+
+    // (source layer, attribute) -> canonical value key -> feature positions.
+    std::map<std::pair<std::string, std::string>,
+             std::unordered_map<std::string, std::vector<std::size_t>>> entries;
+    std::set<std::string> builtLayers;
+};
+
+} // namespace mbgl
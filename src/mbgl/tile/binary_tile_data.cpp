@@ -0,0 +1,418 @@
+#include <mbgl/tile/binary_tile_data.hpp>
+
+#include <cstring>
+#include <stdexcept>
+#include <unordered_map>
+#include <utility>
+
+namespace mbgl {
+
+namespace {
+
+// "MBGLTB" + two-digit format version.
+constexpr char magic[8] = { 'M', 'B', 'G', 'L', 'T', 'B', '0', '1' };
+
+enum ValueTag : uint8_t {
+    NullTag = 0,
+    BoolTag = 1,
+    UintTag = 2,
+    IntTag = 3,
+    DoubleTag = 4,
+    StringTag = 5,
+    ArrayTag = 6,
+    ObjectTag = 7,
+};
+
+enum IdentifierTag : uint8_t {
+    NoIdentifier = 0,
+    UintIdentifier = 1,
+    IntIdentifier = 2,
+    DoubleIdentifier = 3,
+    StringIdentifier = 4,
+};
+
+class Reader {
+public:
+    Reader(const char* pos_, const char* end_) : pos(pos_), end(end_) {
+    }
+
+    template <typename T>
+    T read() {
+        T value;
+        require(sizeof(T));
+        std::memcpy(&value, pos, sizeof(T));
+        pos += sizeof(T);
+        return value;
+    }
+
+    std::pair<const char*, uint32_t> readStringRef() {
+        const uint32_t length = read<uint32_t>();
+        require(length);
+        const char* begin = pos;
+        pos += length;
+        return { begin, length };
+    }
+
+    std::string readString() {
+        auto ref = readStringRef();
+        return std::string(ref.first, ref.second);
+    }
+
+    Value readValue() {
+        switch (read<uint8_t>()) {
+        case NullTag:
+            return NullValue();
+        case BoolTag:
+            return read<uint8_t>() != 0;
+        case UintTag:
+            return read<uint64_t>();
+        case IntTag:
+            return read<int64_t>();
+        case DoubleTag:
+            return read<double>();
+        case StringTag:
+            return readString();
+        case ArrayTag: {
+            std::vector<Value> array(read<uint32_t>());
+            for (auto& element : array) {
+                element = readValue();
+            }
+            return array;
+        }
+        case ObjectTag: {
+            std::unordered_map<std::string, Value> object;
+            for (uint32_t i = 0, count = read<uint32_t>(); i < count; i++) {
+                std::string key = readString();
+                object.emplace(std::move(key), readValue());
+            }
+            return object;
+        }
+        default:
+            throw std::runtime_error("unknown binary tile value tag");
+        }
+    }
+
+    void skipValue() {
+        readValue();
+    }
+
+    const char* position() const {
+        return pos;
+    }
+
+private:
+    void require(std::size_t bytes) {
+        if (static_cast<std::size_t>(end - pos) < bytes) {
+            throw std::runtime_error("truncated binary tile");
+        }
+    }
+
+    const char* pos;
+    const char* end;
+};
+
+class Writer {
+public:
+    template <typename T>
+    void write(T value) {
+        out.append(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+
+    void writeString(const std::string& string) {
+        write<uint32_t>(static_cast<uint32_t>(string.size()));
+        out.append(string);
+    }
+
+    void writeValue(const Value& value) {
+        value.match(
+            [&] (NullValue) { write<uint8_t>(NullTag); },
+            [&] (bool v) { write<uint8_t>(BoolTag); write<uint8_t>(v ? 1 : 0); },
+            [&] (uint64_t v) { write<uint8_t>(UintTag); write<uint64_t>(v); },
+            [&] (int64_t v) { write<uint8_t>(IntTag); write<int64_t>(v); },
+            [&] (double v) { write<uint8_t>(DoubleTag); write<double>(v); },
+            [&] (const std::string& v) { write<uint8_t>(StringTag); writeString(v); },
+            [&] (const std::vector<Value>& v) {
+                write<uint8_t>(ArrayTag);
+                write<uint32_t>(static_cast<uint32_t>(v.size()));
+                for (const auto& element : v) {
+                    writeValue(element);
+                }
+            },
+            [&] (const std::unordered_map<std::string, Value>& v) {
+                write<uint8_t>(ObjectTag);
+                write<uint32_t>(static_cast<uint32_t>(v.size()));
+                for (const auto& pair : v) {
+                    writeString(pair.first);
+                    writeValue(pair.second);
+                }
+            });
+    }
+
+    std::string out;
+};
+
+} // namespace
+
+class BinaryTileFeature : public GeometryTileFeature {
+public:
+    BinaryTileFeature(std::shared_ptr<const std::string> data_, const char* begin_, const char* end_)
+        : data(std::move(data_)),
+          begin(begin_),
+          end(end_) {
+        Reader reader(begin, end);
+        type = static_cast<FeatureType>(reader.read<uint8_t>());
+
+        switch (reader.read<uint8_t>()) {
+        case NoIdentifier:
+            break;
+        case UintIdentifier:
+            id = { reader.read<uint64_t>() };
+            break;
+        case IntIdentifier:
+            id = { reader.read<int64_t>() };
+            break;
+        case DoubleIdentifier:
+            id = { reader.read<double>() };
+            break;
+        case StringIdentifier:
+            id = { reader.readString() };
+            break;
+        default:
+            throw std::runtime_error("unknown binary tile identifier tag");
+        }
+
+        const uint32_t geometryOffset = reader.read<uint32_t>();
+        if (geometryOffset > static_cast<std::size_t>(end - begin)) {
+            throw std::runtime_error("truncated binary tile");
+        }
+        geometry = begin + geometryOffset;
+        properties = reader.position();
+    }
+
+    FeatureType getType() const override {
+        return type;
+    }
+
+    optional<Value> getValue(const std::string& key) const override {
+        Reader reader(properties, end);
+        for (uint32_t i = 0, count = reader.read<uint32_t>(); i < count; i++) {
+            auto keyRef = reader.readStringRef();
+            if (keyRef.second == key.size() && std::memcmp(keyRef.first, key.data(), key.size()) == 0) {
+                return reader.readValue();
+            }
+            reader.skipValue();
+        }
+        return optional<Value>();
+    }
+
+    const PropertyMap& getProperties() const override {
+        if (!propertiesCache) {
+            PropertyMap result;
+            Reader reader(properties, end);
+            for (uint32_t i = 0, count = reader.read<uint32_t>(); i < count; i++) {
+                std::string key = reader.readString();
+                result.emplace(std::move(key), reader.readValue());
+            }
+            propertiesCache = std::move(result);
+        }
+        return *propertiesCache;
+    }
+
+    optional<FeatureIdentifier> getID() const override {
+        return id;
+    }
+
+    GeometryCollection getGeometries() const override {
+        Reader reader(geometry, end);
+        GeometryCollection lines;
+        lines.resize(reader.read<uint32_t>());
+        for (auto& line : lines) {
+            line.resize(reader.read<uint32_t>());
+            for (auto& point : line) {
+                point.x = reader.read<int16_t>();
+                point.y = reader.read<int16_t>();
+            }
+        }
+        return lines;
+    }
+
+private:
+    std::shared_ptr<const std::string> data;
+    const char* begin;
+    const char* end;
+    const char* properties;
+    const char* geometry;
+    FeatureType type = FeatureType::Unknown;
+    optional<FeatureIdentifier> id;
+    mutable optional<PropertyMap> propertiesCache;
+};
+
+class BinaryTileLayer : public GeometryTileLayer {
+public:
+    BinaryTileLayer(std::string name_, std::shared_ptr<const std::string> data_,
+                    const char* block_, uint32_t blockLength_)
+        : name(std::move(name_)),
+          data(std::move(data_)),
+          block(block_),
+          blockLength(blockLength_) {
+        Reader reader(block, block + blockLength);
+        count = reader.read<uint32_t>();
+    }
+
+    std::size_t featureCount() const override {
+        return count;
+    }
+
+    std::unique_ptr<GeometryTileFeature> getFeature(std::size_t i) const override {
+        if (i >= count) {
+            throw std::out_of_range("feature index out of range");
+        }
+        Reader reader(block + sizeof(uint32_t) + i * sizeof(uint32_t), block + blockLength);
+        const uint32_t offset = reader.read<uint32_t>();
+        if (offset > blockLength) {
+            throw std::runtime_error("truncated binary tile");
+        }
+        return std::make_unique<BinaryTileFeature>(data, block + offset, block + blockLength);
+    }
+
+    std::string getName() const override {
+        return name;
+    }
+
+private:
+    std::string name;
+    std::shared_ptr<const std::string> data;
+    const char* block;
+    uint32_t blockLength;
+    uint32_t count;
+};
+
+// Holds the layer directory. It is built once in the constructor and immutable
+// afterwards, so clones of the owning BinaryTileData can share it across
+// threads without synchronization.
+class BinaryTileData::Impl {
+public:
+    Impl(std::shared_ptr<const std::string> data_)
+        : data(std::move(data_)) {
+        Reader reader(data->data() + sizeof(magic), data->data() + data->size());
+        for (uint32_t i = 0, layerCount = reader.read<uint32_t>(); i < layerCount; i++) {
+            std::string name = reader.readString();
+            const uint32_t blockLength = reader.read<uint32_t>();
+            const char* block = reader.position();
+            if (blockLength > static_cast<std::size_t>(data->data() + data->size() - block)) {
+                throw std::runtime_error("truncated binary tile");
+            }
+            layers.emplace(std::piecewise_construct,
+                           std::forward_as_tuple(name),
+                           std::forward_as_tuple(name, data, block, blockLength));
+            reader = Reader(block + blockLength, data->data() + data->size());
+        }
+    }
+
+    const GeometryTileLayer* getLayer(const std::string& name) const {
+        auto it = layers.find(name);
+        return it != layers.end() ? &it->second : nullptr;
+    }
+
+private:
+    std::shared_ptr<const std::string> data;
+    std::unordered_map<std::string, BinaryTileLayer> layers;
+};
+
+BinaryTileData::BinaryTileData(std::shared_ptr<const std::string> data)
+    : impl(std::make_shared<Impl>(std::move(data))) {
+}
+
+std::unique_ptr<GeometryTileData> BinaryTileData::clone() const {
+    return std::make_unique<BinaryTileData>(*this);
+}
+
+const GeometryTileLayer* BinaryTileData::getLayer(const std::string& name) const {
+    return impl->getLayer(name);
+}
+
+bool BinaryTileData::isBinaryTile(const std::string& data) {
+    return data.size() >= sizeof(magic) && std::memcmp(data.data(), magic, sizeof(magic)) == 0;
+}
+
+std::string BinaryTileData::encode(const GeometryTileData& tile,
+                                   const std::vector<std::string>& layerNames) {
+    Writer writer;
+    writer.out.append(magic, sizeof(magic));
+
+    std::vector<std::pair<const std::string*, const GeometryTileLayer*>> layers;
+    for (const auto& name : layerNames) {
+        if (const GeometryTileLayer* layer = tile.getLayer(name)) {
+            layers.emplace_back(&name, layer);
+        }
+    }
+
+    writer.write<uint32_t>(static_cast<uint32_t>(layers.size()));
+
+    for (const auto& entry : layers) {
+        const GeometryTileLayer& layer = *entry.second;
+        const std::size_t featureCount = layer.featureCount();
+
+        // Encode the feature records first so the offset table can be written
+        // ahead of them.
+        std::vector<uint32_t> offsets;
+        offsets.reserve(featureCount);
+        Writer features;
+        for (std::size_t i = 0; i < featureCount; i++) {
+            offsets.push_back(static_cast<uint32_t>(
+                sizeof(uint32_t) + featureCount * sizeof(uint32_t) + features.out.size()));
+
+            std::unique_ptr<GeometryTileFeature> feature = layer.getFeature(i);
+            features.write<uint8_t>(static_cast<uint8_t>(feature->getType()));
+
+            if (optional<FeatureIdentifier> id = feature->getID()) {
+                id->match(
+                    [&] (uint64_t v) { features.write<uint8_t>(UintIdentifier); features.write<uint64_t>(v); },
+                    [&] (int64_t v) { features.write<uint8_t>(IntIdentifier); features.write<int64_t>(v); },
+                    [&] (double v) { features.write<uint8_t>(DoubleIdentifier); features.write<double>(v); },
+                    [&] (const std::string& v) { features.write<uint8_t>(StringIdentifier); features.writeString(v); });
+            } else {
+                features.write<uint8_t>(NoIdentifier);
+            }
+
+            // Placeholder for the geometry offset; patched once the property
+            // section length is known.
+            const std::size_t geometryOffsetAt = features.out.size();
+            features.write<uint32_t>(0);
+
+            const PropertyMap& properties = feature->getProperties();
+            features.write<uint32_t>(static_cast<uint32_t>(properties.size()));
+            for (const auto& property : properties) {
+                features.writeString(property.first);
+                features.writeValue(property.second);
+            }
+
+            const uint32_t geometryOffset = static_cast<uint32_t>(
+                features.out.size() - (offsets.back() - sizeof(uint32_t) - featureCount * sizeof(uint32_t)));
+            std::memcpy(&features.out[geometryOffsetAt], &geometryOffset, sizeof(uint32_t));
+
+            const GeometryCollection geometries = feature->getGeometries();
+            features.write<uint32_t>(static_cast<uint32_t>(geometries.size()));
+            for (const auto& line : geometries) {
+                features.write<uint32_t>(static_cast<uint32_t>(line.size()));
+                for (const auto& point : line) {
+                    features.write<int16_t>(point.x);
+                    features.write<int16_t>(point.y);
+                }
+            }
+        }
+
+        writer.writeString(*entry.first);
+        writer.write<uint32_t>(static_cast<uint32_t>(
+            sizeof(uint32_t) + offsets.size() * sizeof(uint32_t) + features.out.size()));
+        writer.write<uint32_t>(static_cast<uint32_t>(featureCount));
+        for (const uint32_t offset : offsets) {
+            writer.write<uint32_t>(offset);
+        }
+        writer.out.append(features.out);
+    }
+
+    return writer.out;
+}
+
+} // namespace mbgl
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <mbgl/tile/geometry_tile_data.hpp>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace mbgl {
+
+/*
+    A pre-decoded, flat binary representation of tile geometry.
+
+    Vector tiles spend a significant share of worker time in pbf varint and
+    zigzag decoding before layout can begin. For fleets that render a fixed
+    style over a fixed tileset, that work is identical on every client, so it
+    can be done once server-side: `encode()` walks already-decoded tile data
+    and writes the features out as flat, host-endian records — coordinates as
+    raw int16 pairs in `util::EXTENT` space, properties as tagged values.
+
+    `BinaryTileData` reads such a blob in place through the regular
+    `GeometryTileData` interface. Layers are located through an offset
+    directory in the header and features through a per-layer offset table, so
+    access is lazy and per-feature decode is a straight memcpy walk with no
+    varint work. `VectorTile::setData` dispatches here when the payload starts
+    with the format's magic bytes.
+*/
+class BinaryTileData : public GeometryTileData {
+public:
+    BinaryTileData(std::shared_ptr<const std::string> data);
+
+    std::unique_ptr<GeometryTileData> clone() const override;
+    const GeometryTileLayer* getLayer(const std::string&) const override;
+
+    // Whether the blob carries the binary tile magic bytes.
+    static bool isBinaryTile(const std::string& data);
+
+    // Serializes the named layers of already-decoded tile data. Layers that
+    // don't exist in the input are skipped.
+    static std::string encode(const GeometryTileData&, const std::vector<std::string>& layerNames);
+
+private:
+    class Impl;
+    std::shared_ptr<Impl> impl;
+};
+
+} // namespace mbgl
@@ -22,7 +22,7 @@ public:
         return apply_visitor(ToFeatureType(), feature.geometry);
     }
 
-    PropertyMap getProperties() const override {
+    const PropertyMap& getProperties() const override {
         return feature.properties;
     }
 
@@ -87,15 +87,23 @@ GeoJSONTile::GeoJSONTile(const OverscaledTileID& overscaledTileID,
 }
 
 void GeoJSONTile::updateData(const mapbox::geometry::feature_collection<int16_t>& features) {
+    if (hasData && features == lastFeatures) {
+        return;
+    }
+    lastFeatures = features;
+    hasData = true;
     setData(std::make_unique<GeoJSONTileData>(features));
 }
 
-void GeoJSONTile::setNecessity(Necessity) {}
+void GeoJSONTile::setNecessity(Necessity necessity) {
+    GeometryTile::setNecessity(necessity);
+}
     
 void GeoJSONTile::querySourceFeatures(
     std::vector<Feature>& result,
-    const style::SourceQueryOptions& options) {
-    
+    const style::SourceQueryOptions& options,
+    const std::vector<std::string>&) {
+
     // Ignore the sourceLayer, there is only one
     auto layer = getData()->getLayer({});
     
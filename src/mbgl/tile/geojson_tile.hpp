@@ -15,13 +15,20 @@ public:
                 std::string sourceID,
                 const style::UpdateParameters&);
 
+    // Replaces the tile's features, skipping relayout when they are unchanged
+    // so that diff-style source updates only re-lay-out affected tiles.
     void updateData(const mapbox::geometry::feature_collection<int16_t>&);
 
     void setNecessity(Necessity) final;
     
     void querySourceFeatures(
         std::vector<Feature>& result,
-        const style::SourceQueryOptions&) override;
+        const style::SourceQueryOptions&,
+        const std::vector<std::string>& indexedAttributes) override;
+
+private:
+    mapbox::geometry::feature_collection<int16_t> lastFeatures;
+    bool hasData = false;
 };
 
 } // namespace mbgl
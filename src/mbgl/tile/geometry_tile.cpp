@@ -1,6 +1,8 @@
 #include <mbgl/tile/geometry_tile.hpp>
 #include <mbgl/tile/geometry_tile_worker.hpp>
 #include <mbgl/tile/geometry_tile_data.hpp>
+#include <mbgl/tile/binary_tile_data.hpp>
+#include <mbgl/tile/attribute_index.hpp>
 #include <mbgl/tile/tile_observer.hpp>
 #include <mbgl/style/update_parameters.hpp>
 #include <mbgl/style/layer_impl.hpp>
@@ -14,11 +16,13 @@
 #include <mbgl/map/transform_state.hpp>
 #include <mbgl/map/query.hpp>
 #include <mbgl/util/run_loop.hpp>
+#include <mbgl/util/startup_timeline.hpp>
 #include <mbgl/style/filter_evaluator.hpp>
 #include <mbgl/style/query.hpp>
 #include <mbgl/util/logging.hpp>
 
 #include <iostream>
+#include <unordered_set>
 
 namespace mbgl {
 
@@ -34,7 +38,8 @@ GeometryTile::GeometryTile(const OverscaledTileID& id_,
       worker(parameters.workerScheduler,
              ActorRef<GeometryTile>(*this, mailbox),
              id_,
-             obsolete,
+             taskScope.token(),
+             reinterpret_cast<uintptr_t>(parameters.style.glyphAtlas.get()),
              parameters.mode),
              glyphAtlas(*parameters.style.glyphAtlas) {
 }
@@ -48,13 +53,24 @@ GeometryTile::~GeometryTile() {
 }
 
 void GeometryTile::cancel() {
-    obsolete = true;
+    taskScope.cancel();
 }
 
 void GeometryTile::setError(std::exception_ptr err) {
     observer->onTileError(*this, err);
 }
 
+void GeometryTile::setNecessity(Necessity necessity) {
+    // A drop to Optional demotes the worker's mailbox rather than cancelling
+    // the task scope: the scope cannot be re-armed, and an optional tile (in
+    // the cache, or briefly off-screen during a pan) is routinely promoted
+    // back to Required, where its in-flight layout is still wanted. Hard
+    // cancellation is reserved for destruction, where the result can never
+    // be consumed.
+    worker.setPriority(necessity == Necessity::Required ? Mailbox::Priority::RenderCritical
+                                                        : Mailbox::Priority::Prefetch);
+}
+
 void GeometryTile::setData(std::unique_ptr<const GeometryTileData> data_) {
     // Mark the tile as pending again if it was complete before to prevent signaling a complete
     // state despite pending parse operations.
@@ -111,16 +127,34 @@ void GeometryTile::redoLayout() {
 }
 
 void GeometryTile::onLayout(LayoutResult result) {
+    util::markStartupMilestone(StartupMilestone::FirstTileParsed);
     availableData = DataAvailability::Some;
     nonSymbolBuckets = std::move(result.nonSymbolBuckets);
+
+    // Reused buckets may carry paint binders the worker rebuilt for changed
+    // data-driven paint values; swap them in now, on the thread that renders.
+    // Shared buckets appear under several layer IDs; repeat commits are no-ops.
+    for (auto& pair : nonSymbolBuckets) {
+        pair.second->commitStagedPaintBinders();
+    }
+
     featureIndex = std::move(result.featureIndex);
     data = std::move(result.tileData);
+    attributeIndex.reset();
     collisionTile.reset();
+
+    // Freshly built buckets carry base paint values; queue the full state set
+    // for replay. Entries already pending (e.g. a clear that has not been
+    // uploaded yet) stay as they are — they are newer.
+    for (const auto& pair : featureStates) {
+        pendingFeatureStates.emplace(pair.first, pair.second);
+    }
+
     observer->onTileChanged(*this);
 }
 
 void GeometryTile::onPlacement(PlacementResult result) {
-    if (result.correlationID == correlationID) {
+    if (result.correlationID == correlationID && result.symbolDependenciesComplete) {
         availableData = DataAvailability::All;
     }
     symbolBuckets = std::move(result.symbolBuckets);
@@ -160,7 +194,7 @@ void GeometryTile::getIcons(IconDependencyMap iconDependencyMap) {
 
 Bucket* GeometryTile::getBucket(const Layer& layer) {
     const auto& buckets = layer.is<SymbolLayer>() ? symbolBuckets : nonSymbolBuckets;
-    const auto it = buckets.find(layer.baseImpl->id);
+    const auto it = buckets.find(layer.baseImpl->internedID());
     if (it == buckets.end()) {
         return nullptr;
     }
@@ -169,10 +203,54 @@ Bucket* GeometryTile::getBucket(const Layer& layer) {
     return it->second.get();
 }
 
+std::size_t GeometryTile::getMemoryUsage() const {
+    std::size_t size = 0;
+
+    // Layers with identical layout share a bucket under several IDs; count
+    // each bucket only once.
+    std::unordered_set<Bucket*> counted;
+    const auto addBuckets = [&] (const std::unordered_map<util::StringID, std::shared_ptr<Bucket>>& buckets) {
+        for (const auto& pair : buckets) {
+            if (counted.insert(pair.second.get()).second) {
+                size += pair.second->getMemoryUsage();
+            }
+        }
+    };
+    addBuckets(nonSymbolBuckets);
+    addBuckets(symbolBuckets);
+
+    if (featureIndex) {
+        size += featureIndex->byteSize();
+    }
+
+    return size;
+}
+
+void GeometryTile::releaseMemory() {
+    // Only needed to answer feature queries; rendering uses the buckets
+    // alone. queryRenderedFeatures() and querySourceFeatures() return
+    // nothing for this tile until the next layout rebuilds these.
+    featureIndex.reset();
+    data.reset();
+    attributeIndex.reset();
+    collisionTile.reset();
+}
+
+optional<std::string> GeometryTile::serializeData(const std::vector<std::string>& layerNames) const {
+    // `data` is reset by releaseMemory() under memory pressure; such tiles
+    // simply drop out of the snapshot and reload normally next session.
+    if (!data) {
+        return {};
+    }
+    return BinaryTileData::encode(*data, layerNames);
+}
+
 void GeometryTile::queryRenderedFeatures(
     std::unordered_map<std::string, std::vector<Feature>>& result,
     const GeometryCoordinates& queryGeometry,
     const TransformState& transformState,
+    const std::unordered_map<std::string, const style::Layer*>& layers,
+    const float additionalQueryRadius,
     const RenderedQueryOptions& options) {
 
     if (!featureIndex || !data) return;
@@ -185,31 +263,124 @@ void GeometryTile::queryRenderedFeatures(
                         options,
                         *data,
                         id.canonical,
-                        style,
+                        layers,
+                        additionalQueryRadius,
                         collisionTile.get());
 }
 
+FeatureQueryData GeometryTile::featureQueryData() const {
+    if (data) {
+        // getLayer parses lazily; force it here, on the map thread, so the
+        // worker-side query only ever reads already-parsed layers instead of
+        // racing the synchronous query path on the lazy caches.
+        data->prepareForQuery();
+    }
+    return { featureIndex, data, collisionTile };
+}
+
+namespace {
+
+// An equality test the attribute index can answer: the filter itself, or a
+// conjunct of a top-level "all". The full filter is re-run on every
+// candidate, so this only has to find one probeable clause.
+const EqualsFilter* findIndexableEquals(const Filter& filter, const AttributeIndex& index) {
+    if (filter.is<EqualsFilter>()) {
+        const auto& equals = filter.get<EqualsFilter>();
+        if (index.indexes(equals.key)) {
+            return &equals;
+        }
+    } else if (filter.is<AllFilter>()) {
+        for (const auto& child : filter.get<AllFilter>().filters) {
+            if (const auto* equals = findIndexableEquals(child, index)) {
+                return equals;
+            }
+        }
+    }
+    return nullptr;
+}
+
+} // namespace
+
+void GeometryTile::setFeatureState(uint64_t featureID, const style::FeatureState& state) {
+    if (state.empty()) {
+        featureStates.erase(featureID);
+    } else {
+        featureStates[featureID] = state;
+    }
+    pendingFeatureStates[featureID] = state;
+}
+
+void GeometryTile::uploadFeatureStates(gl::Context& context) {
+    if (pendingFeatureStates.empty() || !data) {
+        return;
+    }
+
+    // Buckets shared between layers of a layout group appear under several
+    // layer IDs; update each bucket once.
+    std::unordered_set<Bucket*> seen;
+    for (auto& pair : nonSymbolBuckets) {
+        const Layer* layer = style.getLayer(util::internedString(pair.first));
+        if (!layer || !seen.insert(pair.second.get()).second) {
+            continue;
+        }
+        const GeometryTileLayer* geometryLayer = data->getLayer(layer->baseImpl->sourceLayer);
+        if (!geometryLayer) {
+            continue;
+        }
+        pair.second->updateFeatureStates(pendingFeatureStates, *geometryLayer, context);
+    }
+
+    pendingFeatureStates.clear();
+}
+
 void GeometryTile::querySourceFeatures(
     std::vector<Feature>& result,
-    const style::SourceQueryOptions& options) {
+    const style::SourceQueryOptions& options,
+    const std::vector<std::string>& indexedAttributes) {
 
     // Data not yet available
     if (!data) {
         return;
     }
-    
+
     // No source layers, specified, nothing to do
     if (!options.sourceLayers) {
         Log::Warning(Event::General, "At least one sourceLayer required");
         return;
     }
 
+    if (indexedAttributes.empty()) {
+        attributeIndex.reset();
+    } else if (!attributeIndex || attributeIndex->indexedAttributes() != indexedAttributes) {
+        attributeIndex = std::make_unique<AttributeIndex>(indexedAttributes);
+    }
+
     for (auto sourceLayer : *options.sourceLayers) {
         // Go throught all sourceLayers, if any
         // to gather all the features
         auto layer = data->getLayer(sourceLayer);
-        
+
         if (layer) {
+            // Probe the index when the filter pins an indexed attribute to a
+            // value. Every candidate still runs the full filter, so compound
+            // filters and hash-key collisions stay correct.
+            const EqualsFilter* equals = attributeIndex && options.filter
+                ? findIndexableEquals(*options.filter, *attributeIndex)
+                : nullptr;
+
+            if (equals) {
+                for (auto i : attributeIndex->query(*layer, sourceLayer, equals->key, equals->value)) {
+                    auto feature = layer->getFeature(i);
+
+                    if (!(*options.filter)(*feature)) {
+                        continue;
+                    }
+
+                    result.push_back(convertFeature(*feature, id.canonical));
+                }
+                continue;
+            }
+
             auto featureCount = layer->featureCount();
             for (std::size_t i = 0; i < featureCount; i++) {
                 auto feature = layer->getFeature(i);
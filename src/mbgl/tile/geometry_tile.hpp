@@ -6,7 +6,9 @@
 #include <mbgl/text/glyph_atlas.hpp>
 #include <mbgl/text/placement_config.hpp>
 #include <mbgl/util/feature.hpp>
+#include <mbgl/util/interned_string.hpp>
 #include <mbgl/actor/actor.hpp>
+#include <mbgl/actor/task.hpp>
 
 #include <atomic>
 #include <memory>
@@ -17,6 +19,7 @@ namespace mbgl {
 
 class GeometryTileData;
 class FeatureIndex;
+class AttributeIndex;
 class CollisionTile;
 
 namespace style {
@@ -37,6 +40,12 @@ public:
     void setError(std::exception_ptr);
     void setData(std::unique_ptr<const GeometryTileData>);
 
+    // Keeps the worker's scheduling priority in sync with the tile's
+    // necessity, so layout for visible (required) tiles runs before work for
+    // retained off-screen tiles. Subclasses combine this with their loader's
+    // necessity handling.
+    void setNecessity(Necessity) override;
+
     void setPlacementConfig(const PlacementConfig&) override;
     void redoLayout() override;
     
@@ -48,21 +57,34 @@ public:
 
     Bucket* getBucket(const style::Layer&) override;
 
+    std::size_t getMemoryUsage() const override;
+    void releaseMemory() override;
+
+    optional<std::string> serializeData(const std::vector<std::string>& layerNames) const override;
+
     void queryRenderedFeatures(
             std::unordered_map<std::string, std::vector<Feature>>& result,
             const GeometryCoordinates& queryGeometry,
             const TransformState&,
+            const std::unordered_map<std::string, const style::Layer*>& layers,
+            const float additionalQueryRadius,
             const RenderedQueryOptions& options) override;
 
+    FeatureQueryData featureQueryData() const override;
+
     void querySourceFeatures(
         std::vector<Feature>& result,
-        const style::SourceQueryOptions&) override;
+        const style::SourceQueryOptions&,
+        const std::vector<std::string>& indexedAttributes) override;
+
+    void setFeatureState(uint64_t, const style::FeatureState&) override;
+    void uploadFeatureStates(gl::Context&) override;
 
     void cancel() override;
 
     class LayoutResult {
     public:
-        std::unordered_map<std::string, std::shared_ptr<Bucket>> nonSymbolBuckets;
+        std::unordered_map<util::StringID, std::shared_ptr<Bucket>> nonSymbolBuckets;
         std::unique_ptr<FeatureIndex> featureIndex;
         std::unique_ptr<GeometryTileData> tileData;
         uint64_t correlationID;
@@ -71,9 +93,13 @@ public:
 
     class PlacementResult {
     public:
-        std::unordered_map<std::string, std::shared_ptr<Bucket>> symbolBuckets;
+        std::unordered_map<util::StringID, std::shared_ptr<Bucket>> symbolBuckets;
         std::unique_ptr<CollisionTile> collisionTile;
         uint64_t correlationID;
+        // False for a partial placement published while some symbol
+        // dependencies are still in flight; such a result must not mark the
+        // tile complete.
+        bool symbolDependenciesComplete = true;
     };
     void onPlacement(PlacementResult);
 
@@ -89,7 +115,7 @@ private:
     style::Style& style;
 
     // Used to signal the worker that it should abandon parsing this tile as soon as possible.
-    std::atomic<bool> obsolete { false };
+    TaskScope taskScope;
 
     std::shared_ptr<Mailbox> mailbox;
     Actor<GeometryTileWorker> worker;
@@ -101,12 +127,26 @@ private:
     uint64_t correlationID = 0;
     optional<PlacementConfig> requestedConfig;
 
-    std::unordered_map<std::string, std::shared_ptr<Bucket>> nonSymbolBuckets;
-    std::unique_ptr<FeatureIndex> featureIndex;
-    std::unique_ptr<const GeometryTileData> data;
+    std::unordered_map<util::StringID, std::shared_ptr<Bucket>> nonSymbolBuckets;
+
+    // Shared (rather than owned outright) so featureQueryData() can hand an
+    // immutable snapshot to an off-thread query; each is only ever replaced
+    // wholesale by a new layout or placement result, never mutated in place.
+    std::shared_ptr<const FeatureIndex> featureIndex;
+    std::shared_ptr<const GeometryTileData> data;
+
+    // Built against `data` on demand by querySourceFeatures; reset whenever
+    // `data` is replaced so stale feature positions are never probed.
+    std::unique_ptr<AttributeIndex> attributeIndex;
+
+    // All current feature states, and the subset not yet written into the
+    // buckets' attribute buffers. A layout result replays the full set, since
+    // freshly built buckets carry base values only.
+    style::FeatureStates featureStates;
+    style::FeatureStates pendingFeatureStates;
 
-    std::unordered_map<std::string, std::shared_ptr<Bucket>> symbolBuckets;
-    std::unique_ptr<CollisionTile> collisionTile;
+    std::unordered_map<util::StringID, std::shared_ptr<Bucket>> symbolBuckets;
+    std::shared_ptr<const CollisionTile> collisionTile;
 };
 
 } // namespace mbgl
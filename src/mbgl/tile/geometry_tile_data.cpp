@@ -51,6 +51,79 @@ GeometryCollection fixupPolygons(const GeometryCollection& rings) {
     return toGeometryCollection(std::move(multipolygon));
 }
 
+// Squared distance from `p` to the segment `a`-`b`; to the nearer endpoint
+// when the segment is degenerate (as the closing chord of a ring is).
+static double segmentDistanceSquared(const GeometryCoordinate& p,
+                                     const GeometryCoordinate& a,
+                                     const GeometryCoordinate& b) {
+    double x = a.x;
+    double y = a.y;
+    double dx = b.x - x;
+    double dy = b.y - y;
+
+    if (dx != 0 || dy != 0) {
+        const double t = ((p.x - x) * dx + (p.y - y) * dy) / (dx * dx + dy * dy);
+        if (t > 1) {
+            x = b.x;
+            y = b.y;
+        } else if (t > 0) {
+            x += dx * t;
+            y += dy * t;
+        }
+    }
+
+    dx = p.x - x;
+    dy = p.y - y;
+    return dx * dx + dy * dy;
+}
+
+GeometryCoordinates simplify(const GeometryCoordinates& line, double tolerance) {
+    if (line.size() <= 2) {
+        return line;
+    }
+
+    const double toleranceSquared = tolerance * tolerance;
+
+    std::vector<bool> keep(line.size(), false);
+    keep.front() = true;
+    keep.back() = true;
+
+    // The usual recursive formulation overflows the stack on degenerate
+    // input (every vertex kept along a long line); recurse explicitly.
+    std::vector<std::pair<std::size_t, std::size_t>> ranges;
+    ranges.emplace_back(0, line.size() - 1);
+
+    while (!ranges.empty()) {
+        const std::size_t first = ranges.back().first;
+        const std::size_t last = ranges.back().second;
+        ranges.pop_back();
+
+        double maxDistance = toleranceSquared;
+        std::size_t index = 0;
+        for (std::size_t i = first + 1; i < last; i++) {
+            const double distance = segmentDistanceSquared(line[i], line[first], line[last]);
+            if (distance > maxDistance) {
+                maxDistance = distance;
+                index = i;
+            }
+        }
+
+        if (index != 0) {
+            keep[index] = true;
+            ranges.emplace_back(first, index);
+            ranges.emplace_back(index, last);
+        }
+    }
+
+    GeometryCoordinates result;
+    for (std::size_t i = 0; i < line.size(); i++) {
+        if (keep[i]) {
+            result.push_back(line[i]);
+        }
+    }
+    return result;
+}
+
 std::vector<GeometryCollection> classifyRings(const GeometryCollection& rings) {
     std::vector<GeometryCollection> polygons;
 
@@ -3,6 +3,7 @@
 #include <mbgl/util/geometry.hpp>
 #include <mbgl/util/feature.hpp>
 #include <mbgl/util/optional.hpp>
+#include <mbgl/util/small_vector.hpp>
 
 #include <cstdint>
 #include <string>
@@ -18,23 +19,27 @@ class CanonicalTileID;
 // varying from -V...0...+V, where V is the maximum extent applicable.
 using GeometryCoordinate = Point<int16_t>;
 
-class GeometryCoordinates : public std::vector<GeometryCoordinate> {
+// Inline capacities below come from production tile statistics: point layers
+// dominate and carry 1-4 coordinates in a single ring, so both the typical
+// ring and the typical collection fit without a heap allocation.
+class GeometryCoordinates : public util::SmallVector<GeometryCoordinate, 4> {
 public:
     using coordinate_type = int16_t;
 
     GeometryCoordinates() = default;
     GeometryCoordinates(const std::vector<GeometryCoordinate>& v)
-        : std::vector<GeometryCoordinate>(v) {}
+        : util::SmallVector<GeometryCoordinate, 4>(v.begin(), v.end()) {}
     GeometryCoordinates(std::vector<GeometryCoordinate>&& v)
-        : std::vector<GeometryCoordinate>(std::move(v)) {}
+        : util::SmallVector<GeometryCoordinate, 4>(std::make_move_iterator(v.begin()),
+                                                   std::make_move_iterator(v.end())) {}
 
-    using std::vector<GeometryCoordinate>::vector;
+    using util::SmallVector<GeometryCoordinate, 4>::SmallVector;
 };
 
-class GeometryCollection : public std::vector<GeometryCoordinates> {
+class GeometryCollection : public util::SmallVector<GeometryCoordinates, 1> {
 public:
     using coordinate_type = int16_t;
-    using std::vector<GeometryCoordinates>::vector;
+    using util::SmallVector<GeometryCoordinates, 1>::SmallVector;
 };
 
 class GeometryTileFeature {
@@ -42,9 +47,20 @@ public:
     virtual ~GeometryTileFeature() = default;
     virtual FeatureType getType() const = 0;
     virtual optional<Value> getValue(const std::string& key) const = 0;
-    virtual PropertyMap getProperties() const { return PropertyMap(); }
+    // Returns a reference that stays valid for the lifetime of the feature
+    // object; implementations back it by interned storage or a lazily built
+    // cache, so repeated access does not re-copy every property string.
+    virtual const PropertyMap& getProperties() const {
+        static const PropertyMap empty;
+        return empty;
+    }
     virtual optional<FeatureIdentifier> getID() const { return {}; }
     virtual GeometryCollection getGeometries() const = 0;
+
+    // Only meaningful for features of layers with hasKeyTable(); equivalent
+    // to getValue of the key at `keyIndex` in the layer's key table, without
+    // the string lookup.
+    virtual optional<Value> getValueForKeyIndex(uint32_t) const { return {}; }
 };
 
 class GeometryTileLayer {
@@ -53,6 +69,13 @@ public:
     virtual std::size_t featureCount() const = 0;
     virtual std::unique_ptr<GeometryTileFeature> getFeature(std::size_t) const = 0;
     virtual std::string getName() const = 0;
+
+    // Layers that store feature properties through a shared key table (as
+    // vector tile layers do) override these so that filters can resolve
+    // property names to table indices once per layout instead of hashing
+    // strings for every feature.
+    virtual bool hasKeyTable() const { return false; }
+    virtual optional<uint32_t> getKeyIndex(const std::string&) const { return {}; }
 };
 
 class GeometryTileData {
@@ -60,11 +83,22 @@ public:
     virtual ~GeometryTileData() = default;
     virtual std::unique_ptr<GeometryTileData> clone() const = 0;
     virtual const GeometryTileLayer* getLayer(const std::string&) const = 0;
+
+    // Forces any parsing that getLayer defers, so the object can afterwards
+    // be read from several threads at once. Called on the owning thread
+    // before the data is shared with an off-thread query.
+    virtual void prepareForQuery() const {}
 };
 
 // classifies an array of rings into polygons with outer rings and holes
 std::vector<GeometryCollection> classifyRings(const GeometryCollection&);
 
+// Douglas-Peucker simplification: drops every vertex closer than `tolerance`
+// (in tile units) to the chord spanning its neighbors, keeping endpoints, so
+// a closed ring stays closed. Used to thin sub-pixel detail out of overzoomed
+// tiles before bucket emission.
+GeometryCoordinates simplify(const GeometryCoordinates&, double tolerance);
+
 // Truncate polygon to the largest `maxHoles` inner rings by area.
 void limitHoles(GeometryCollection&, uint32_t maxHoles);
 
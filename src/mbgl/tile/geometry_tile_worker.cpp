@@ -6,6 +6,7 @@
 #include <mbgl/sprite/sprite_atlas.hpp>
 #include <mbgl/style/bucket_parameters.hpp>
 #include <mbgl/style/group_by_layout.hpp>
+#include <mbgl/style/compiled_filter.hpp>
 #include <mbgl/style/filter.hpp>
 #include <mbgl/style/filter_evaluator.hpp>
 #include <mbgl/style/layers/symbol_layer.hpp>
@@ -15,7 +16,12 @@
 #include <mbgl/util/constants.hpp>
 #include <mbgl/util/string.hpp>
 #include <mbgl/util/exception.hpp>
+#include <mbgl/util/interned_string.hpp>
+#include <mbgl/util/tile_latency.hpp>
+#include <mbgl/util/trace.hpp>
 
+#include <atomic>
+#include <thread>
 #include <unordered_set>
 
 namespace mbgl {
@@ -25,12 +31,14 @@ using namespace style;
 GeometryTileWorker::GeometryTileWorker(ActorRef<GeometryTileWorker> self_,
                                        ActorRef<GeometryTile> parent_,
                                        OverscaledTileID id_,
-                                       const std::atomic<bool>& obsolete_,
+                                       TaskToken token_,
+                                       uintptr_t glyphAtlasIdentity_,
                                        const MapMode mode_)
     : self(std::move(self_)),
       parent(std::move(parent_)),
       id(std::move(id_)),
-      obsolete(obsolete_),
+      token(std::move(token_)),
+      glyphAtlasIdentity(glyphAtlasIdentity_),
       mode(mode_) {
 }
 
@@ -74,6 +82,7 @@ void GeometryTileWorker::setData(std::unique_ptr<const GeometryTileData> data_,
     try {
         data = std::move(data_);
         correlationID = correlationID_;
+        bucketCache.clear();
 
         switch (state) {
         case Idle:
@@ -95,6 +104,10 @@ void GeometryTileWorker::setData(std::unique_ptr<const GeometryTileData> data_,
 void GeometryTileWorker::setLayers(std::vector<std::unique_ptr<Layer>> layers_, uint64_t correlationID_) {
     try {
         layers = std::move(layers_);
+        // The layers do not change until the next setLayers, so the group
+        // assignment (which serializes every layer's layout state) is
+        // computed once here rather than on every relayout.
+        layoutGroups = groupByLayout(*layers);
         correlationID = correlationID_;
 
         switch (state) {
@@ -261,11 +274,34 @@ void GeometryTileWorker::requestNewIcons(const IconDependencyMap &iconDependenci
     }
 }
 
+namespace {
+
+// Bucket construction for one non-symbol layout group. The bucket is filled on
+// whatever thread runs the task; feature index entries are collected locally
+// and merged on the worker thread after all tasks have joined, so the shared
+// FeatureIndex is only ever touched from one thread.
+struct BucketTask {
+    const GeometryTileLayer& geometryLayer;
+    const Filter& filter;
+    const std::string& sourceLayerID;
+    std::string cacheKey;
+    std::string bucketName;
+    std::vector<std::string> layerIDs;
+    std::shared_ptr<Bucket> bucket;
+    std::vector<std::pair<GeometryCollection, std::size_t>> indexEntries;
+    std::vector<std::pair<std::size_t, std::size_t>> binderEntries;
+    std::exception_ptr error;
+};
+
+} // namespace
+
 void GeometryTileWorker::redoLayout() {
     if (!data || !layers) {
         return;
     }
 
+    const TimePoint layoutStart = Clock::now();
+
     std::vector<std::string> symbolOrder;
     for (auto it = layers->rbegin(); it != layers->rend(); it++) {
         if ((*it)->is<SymbolLayer>()) {
@@ -273,17 +309,18 @@ void GeometryTileWorker::redoLayout() {
         }
     }
 
-    std::unordered_map<std::string, std::unique_ptr<SymbolLayout>> symbolLayoutMap;
-    std::unordered_map<std::string, std::shared_ptr<Bucket>> buckets;
+    std::unordered_map<std::string, SymbolLayoutEntry> symbolLayoutMap;
+    std::unordered_map<util::StringID, std::shared_ptr<Bucket>> buckets;
     auto featureIndex = std::make_unique<FeatureIndex>();
-    BucketParameters parameters { id, mode };
+    BucketParameters parameters { id, mode, token, glyphAtlasIdentity };
     
     GlyphDependencies glyphDependencies;
     IconDependencyMap iconDependencyMap;
 
-    std::vector<std::vector<const Layer*>> groups = groupByLayout(*layers);
-    for (auto& group : groups) {
-        if (obsolete) {
+    std::vector<BucketTask> bucketTasks;
+
+    for (const auto& group : layoutGroups) {
+        if (token.cancelled()) {
             return;
         }
 
@@ -291,7 +328,7 @@ void GeometryTileWorker::redoLayout() {
             continue; // Tile has no data.
         }
 
-        const Layer& leader = *group.at(0);
+        const Layer& leader = *group.layers.at(0);
 
         auto geometryLayer = (*data)->getLayer(leader.baseImpl->sourceLayer);
         if (!geometryLayer) {
@@ -299,39 +336,191 @@ void GeometryTileWorker::redoLayout() {
         }
 
         std::vector<std::string> layerIDs;
-        for (const auto& layer : group) {
+        for (const auto& layer : group.layers) {
             layerIDs.push_back(layer->getID());
         }
 
         featureIndex->setBucketLayerIDs(leader.getID(), layerIDs);
 
         if (leader.is<SymbolLayer>()) {
-            symbolLayoutMap.emplace(leader.getID(),
-                leader.as<SymbolLayer>()->impl->createLayout(parameters, group, *geometryLayer, glyphDependencies, iconDependencyMap));
+            // Collect the group's dependencies into per-layout maps before
+            // merging them into the tile-wide request, so placement can later
+            // tell which layouts a given glyph range or sprite sheet
+            // unblocks.
+            GlyphDependencies layoutGlyphDependencies;
+            IconDependencyMap layoutIconDependencies;
+            auto layout = leader.as<SymbolLayer>()->impl->createLayout(
+                parameters, group.layers, *geometryLayer, layoutGlyphDependencies, layoutIconDependencies);
+
+            std::set<SpriteAtlas*> layoutAtlases;
+            for (const auto& atlasDependency : layoutIconDependencies) {
+                // A layout without icon features has no business waiting on
+                // its sprite sheet: text-only layers place as soon as their
+                // glyphs arrive.
+                if (atlasDependency.second.empty()) {
+                    continue;
+                }
+                layoutAtlases.insert(atlasDependency.first);
+                iconDependencyMap[atlasDependency.first].insert(
+                    atlasDependency.second.begin(), atlasDependency.second.end());
+            }
+            for (const auto& fontDependencies : layoutGlyphDependencies) {
+                glyphDependencies[fontDependencies.first].insert(
+                    fontDependencies.second.begin(), fontDependencies.second.end());
+            }
+
+            symbolLayoutMap.emplace(leader.getID(), SymbolLayoutEntry {
+                std::move(layout), std::move(layoutGlyphDependencies), std::move(layoutAtlases) });
         } else {
-            const Filter& filter = leader.baseImpl->filter;
-            const std::string& sourceLayerID = leader.baseImpl->sourceLayer;
-            std::shared_ptr<Bucket> bucket = leader.baseImpl->createBucket(parameters, group);
+            std::string cacheKey = group.key;
+
+            auto cacheIt = bucketCache.find(cacheKey);
+            if (cacheIt != bucketCache.end()) {
+                // An identical layout over this tile data has been built
+                // before; reuse its bucket and replay its feature index
+                // entries instead of re-tessellating.
+                const CachedBucket& cached = cacheIt->second;
 
-            for (std::size_t i = 0; !obsolete && i < geometryLayer->featureCount(); i++) {
-                std::unique_ptr<GeometryTileFeature> feature = geometryLayer->getFeature(i);
+                for (const auto& entry : *cached.indexEntries) {
+                    featureIndex->insert(entry.first, entry.second, cached.sourceLayerID, leader.getID());
+                }
+
+                if (cached.bucket->hasData()) {
+                    // The geometry still matches, but the bucket's paint
+                    // binders hold data-driven values evaluated from the
+                    // previous layers. Rebuild them here from the retained
+                    // tile data and stage them on the bucket; the tile's
+                    // thread swaps them in when it receives this layout
+                    // result, so the rebind never blocks the foreground.
+                    cached.bucket->stagePaintBinders(group.layers, *geometryLayer, cached.binderEntries);
+
+                    for (const auto& layer : group.layers) {
+                        buckets.emplace(layer->baseImpl->internedID(), cached.bucket);
+                    }
+                }
+                continue;
+            }
 
-                if (!filter(feature->getType(), feature->getID(), [&] (const auto& key) { return feature->getValue(key); }))
+            auto bucket = leader.baseImpl->createBucket(parameters, group.layers);
+            if (!bucket) {
+                // Layer types whose render path hasn't landed yet (heatmap)
+                // produce no bucket; there is nothing to lay out for them.
+                continue;
+            }
+
+            bucketTasks.push_back(BucketTask {
+                *geometryLayer,
+                leader.baseImpl->filter,
+                leader.baseImpl->sourceLayer,
+                std::move(cacheKey),
+                leader.getID(),
+                std::move(layerIDs),
+                std::move(bucket),
+                {},
+                nullptr
+            });
+        }
+    }
+
+    // Buckets for independent layout groups have no data dependencies, so fan
+    // their construction out across a scoped thread team, with this thread
+    // taking part. The shared ThreadPool can't be block-joined from one of its
+    // own threads without risking deadlock when every pool thread is laying
+    // out a tile, so the team is local to this call.
+    // Overzoomed tiles re-render canonical geometry at a magnified scale, so
+    // their vertex budget is set by data that was quantized for a deeper
+    // zoom than is ever shown. Thin it with a tolerance of half a screen
+    // pixel at the tile's display zoom — visually lossless, but it strips
+    // the sub-pixel chains that dominate upload and draw cost at navigation
+    // zoom levels. Tiles at their canonical zoom are left untouched; they
+    // may be rendered scaled up while children load.
+    const uint32_t overscale = id.overscaleFactor();
+    const double simplifyTolerance =
+        overscale > 1 ? util::EXTENT / (util::tileSize * double(overscale)) / 2.0 : 0.0;
+
+    auto runBucketTask = [&] (BucketTask& task) {
+        try {
+            const CompiledFilter filter { task.filter, task.geometryLayer };
+
+            for (std::size_t i = 0; !token.cancelled() && i < task.geometryLayer.featureCount(); i++) {
+                std::unique_ptr<GeometryTileFeature> feature = task.geometryLayer.getFeature(i);
+
+                if (!filter(*feature))
                     continue;
 
                 GeometryCollection geometries = feature->getGeometries();
-                bucket->addFeature(*feature, geometries);
-                featureIndex->insert(geometries, i, sourceLayerID, leader.getID());
+                if (simplifyTolerance > 0 && feature->getType() != FeatureType::Point) {
+                    for (auto& line : geometries) {
+                        line = simplify(line, simplifyTolerance);
+                    }
+                }
+                const std::size_t vertexBegin = task.bucket->vertexCount();
+                task.bucket->addFeature(*feature, geometries);
+                task.indexEntries.emplace_back(std::move(geometries), i);
+                task.binderEntries.emplace_back(i, task.bucket->vertexCount());
+
+                optional<FeatureIdentifier> featureID = feature->getID();
+                if (featureID && featureID->is<uint64_t>()) {
+                    task.bucket->featureVertexRanges.push_back(
+                        { featureID->get<uint64_t>(), i, vertexBegin, task.bucket->vertexCount() });
+                }
             }
+        } catch (...) {
+            task.error = std::current_exception();
+        }
+    };
 
-            if (!bucket->hasData()) {
-                continue;
+    const std::size_t concurrency = std::min<std::size_t>(
+        std::max<std::size_t>(std::thread::hardware_concurrency(), 1), bucketTasks.size());
+
+    if (concurrency > 1) {
+        std::atomic<std::size_t> nextTask { 0 };
+        auto consumeTasks = [&] {
+            for (std::size_t i = nextTask++; i < bucketTasks.size(); i = nextTask++) {
+                runBucketTask(bucketTasks[i]);
             }
+        };
 
-            for (const auto& layer : group) {
-                buckets.emplace(layer->getID(), bucket);
+        std::vector<std::thread> team;
+        team.reserve(concurrency - 1);
+        for (std::size_t i = 0; i < concurrency - 1; ++i) {
+            team.emplace_back(consumeTasks);
+        }
+        consumeTasks();
+        for (auto& thread : team) {
+            thread.join();
+        }
+    } else {
+        for (auto& task : bucketTasks) {
+            runBucketTask(task);
+        }
+    }
+
+    for (auto& task : bucketTasks) {
+        if (task.error) {
+            std::rethrow_exception(task.error);
+        }
+
+        for (const auto& entry : task.indexEntries) {
+            featureIndex->insert(entry.first, entry.second, task.sourceLayerID, task.bucketName);
+        }
+
+        if (task.bucket->hasData()) {
+            for (const auto& layerID : task.layerIDs) {
+                buckets.emplace(util::internString(layerID), task.bucket);
             }
         }
+
+        bucketCache.emplace(std::move(task.cacheKey), CachedBucket {
+            task.bucket,
+            task.sourceLayerID,
+            std::make_shared<const std::vector<std::pair<GeometryCollection, std::size_t>>>(std::move(task.indexEntries)),
+            std::move(task.binderEntries)
+        });
+    }
+
+    if (token.cancelled()) {
+        return;
     }
 
     symbolLayouts.clear();
@@ -345,6 +534,13 @@ void GeometryTileWorker::redoLayout() {
     requestNewGlyphs(glyphDependencies);
     requestNewIcons(iconDependencyMap);
 
+    const TimePoint layoutEnd = Clock::now();
+    util::recordTileStageLatency(TileStage::Layout, layoutEnd - layoutStart);
+    if (util::isTracing()) {
+        util::recordTraceEvent("layout", layoutStart, layoutEnd, correlationID,
+                               util::toString(id).c_str());
+    }
+
     parent.invoke(&GeometryTile::onLayout, GeometryTile::LayoutResult {
         std::move(buckets),
         std::move(featureIndex),
@@ -356,8 +552,8 @@ void GeometryTileWorker::redoLayout() {
 }
 
 bool GeometryTileWorker::hasPendingSymbolLayouts() const {
-    for (const auto& symbolLayout : symbolLayouts) {
-        if (symbolLayout->state == SymbolLayout::Pending) {
+    for (const auto& entry : symbolLayouts) {
+        if (entry.layout->state == SymbolLayout::Pending) {
             return true;
         }
     }
@@ -365,6 +561,26 @@ bool GeometryTileWorker::hasPendingSymbolLayouts() const {
     return false;
 }
 
+bool GeometryTileWorker::symbolLayoutIsReady(const SymbolLayoutEntry& entry) const {
+    for (const auto& fontDependencies : entry.glyphDependencies) {
+        auto pendingFontGlyphs = pendingGlyphDependencies.find(fontDependencies.first);
+        if (pendingFontGlyphs == pendingGlyphDependencies.end()) {
+            continue;
+        }
+        for (auto glyphID : fontDependencies.second) {
+            if (pendingFontGlyphs->second.find(glyphID) != pendingFontGlyphs->second.end()) {
+                return false;
+            }
+        }
+    }
+    for (auto* atlas : entry.iconDependencies) {
+        if (pendingIconDependencies.find(atlas) != pendingIconDependencies.end()) {
+            return false;
+        }
+    }
+    return true;
+}
+
 bool GeometryTileWorker::hasPendingSymbolDependencies() const {
     for (auto& glyphDependency : pendingGlyphDependencies) {
         if (!glyphDependency.second.empty()) {
@@ -376,37 +592,79 @@ bool GeometryTileWorker::hasPendingSymbolDependencies() const {
 
 
 void GeometryTileWorker::attemptPlacement() {
-    if (!data || !layers || !placementConfig || hasPendingSymbolDependencies()) {
+    if (!data || !layers || !placementConfig) {
         return;
     }
-    
+
+    // While some dependencies are still in flight, place the layouts whose
+    // own dependencies have arrived instead of holding every label hostage to
+    // the slowest glyph range. The partial result is published and replaced
+    // wholesale once the remaining dependencies come in — the same bucket
+    // swap that placement already performs on every rotation. Still-image
+    // renders are one-shot and must not emit a frame with missing labels, so
+    // they keep waiting for the full set.
+    const bool complete = !hasPendingSymbolDependencies();
+    if (!complete) {
+        if (mode != MapMode::Continuous) {
+            return;
+        }
+        bool anyPlaceable = false;
+        for (const auto& entry : symbolLayouts) {
+            if (entry.layout->state == SymbolLayout::Placed || symbolLayoutIsReady(entry)) {
+                anyPlaceable = true;
+                break;
+            }
+        }
+        if (!anyPlaceable) {
+            return;
+        }
+    }
+
+    const TimePoint placementStart = Clock::now();
+
     auto collisionTile = std::make_unique<CollisionTile>(*placementConfig);
-    std::unordered_map<std::string, std::shared_ptr<Bucket>> buckets;
+    std::unordered_map<util::StringID, std::shared_ptr<Bucket>> buckets;
 
-    for (auto& symbolLayout : symbolLayouts) {
-        if (obsolete) {
+    for (auto& entry : symbolLayouts) {
+        if (token.cancelled()) {
             return;
         }
-        
-        if (symbolLayout->state == SymbolLayout::Pending) {
-            symbolLayout->prepare(glyphPositions,icons);
-            symbolLayout->state = SymbolLayout::Placed;
+
+        SymbolLayout& symbolLayout = *entry.layout;
+
+        if (symbolLayout.state == SymbolLayout::Pending) {
+            if (!complete && !symbolLayoutIsReady(entry)) {
+                // Layouts skipped here keep collision priority over later
+                // layers once they arrive, because the tile-wide replacement
+                // re-places everything in style order.
+                continue;
+            }
+            symbolLayout.prepare(glyphPositions, icons, bidi);
+            symbolLayout.state = SymbolLayout::Placed;
         }
-        
-        if (!symbolLayout->hasSymbolInstances()) {
+
+        if (!symbolLayout.hasSymbolInstances()) {
             continue;
         }
 
-        std::shared_ptr<Bucket> bucket = symbolLayout->place(*collisionTile);
-        for (const auto& pair : symbolLayout->layerPaintProperties) {
-            buckets.emplace(pair.first, bucket);
+        std::shared_ptr<Bucket> bucket = symbolLayout.place(*collisionTile);
+        for (const auto& pair : symbolLayout.layerPaintProperties) {
+            buckets.emplace(util::internString(pair.first), bucket);
         }
     }
 
+    const TimePoint placementEnd = Clock::now();
+    util::recordTileStageLatency(TileStage::Placement, placementEnd - placementStart);
+    if (util::isTracing()) {
+        util::recordTraceEvent("placement", placementStart, placementEnd, correlationID,
+                               util::toString(id).c_str());
+    }
+
     parent.invoke(&GeometryTile::onPlacement, GeometryTile::PlacementResult {
         std::move(buckets),
         std::move(collisionTile),
-        correlationID
+        correlationID,
+        complete
     });
 }
 
@@ -2,17 +2,26 @@
 
 #include <mbgl/map/mode.hpp>
 #include <mbgl/tile/tile_id.hpp>
+#include <mbgl/tile/geometry_tile_data.hpp>
 #include <mbgl/sprite/sprite_atlas.hpp>
+#include <mbgl/text/bidi.hpp>
 #include <mbgl/text/glyph.hpp>
 #include <mbgl/text/placement_config.hpp>
 #include <mbgl/actor/actor_ref.hpp>
+#include <mbgl/actor/task.hpp>
+#include <mbgl/style/group_by_layout.hpp>
 #include <mbgl/util/optional.hpp>
 
 #include <atomic>
+#include <cstdint>
 #include <memory>
+#include <set>
+#include <string>
+#include <unordered_map>
 
 namespace mbgl {
 
+class Bucket;
 class GeometryTile;
 class GeometryTileData;
 class GlyphAtlas;
@@ -27,7 +36,8 @@ public:
     GeometryTileWorker(ActorRef<GeometryTileWorker> self,
                        ActorRef<GeometryTile> parent,
                        OverscaledTileID,
-                       const std::atomic<bool>&,
+                       TaskToken,
+                       uintptr_t glyphAtlasIdentity,
                        const MapMode);
     ~GeometryTileWorker();
 
@@ -52,11 +62,23 @@ private:
     bool hasPendingSymbolDependencies() const;
     bool hasPendingSymbolLayouts() const;
 
+    // A symbol layout together with the glyph and icon dependencies its
+    // features produced, so placement can tell which layouts are unblocked
+    // while other layouts' dependencies are still in flight.
+    struct SymbolLayoutEntry {
+        std::unique_ptr<SymbolLayout> layout;
+        GlyphDependencies glyphDependencies;
+        std::set<SpriteAtlas*> iconDependencies;
+    };
+
+    bool symbolLayoutIsReady(const SymbolLayoutEntry&) const;
+
     ActorRef<GeometryTileWorker> self;
     ActorRef<GeometryTile> parent;
 
     const OverscaledTileID id;
-    const std::atomic<bool>& obsolete;
+    const TaskToken token;
+    const uintptr_t glyphAtlasIdentity;
     const MapMode mode;
 
     enum State {
@@ -74,7 +96,32 @@ private:
     optional<std::unique_ptr<const GeometryTileData>> data;
     optional<PlacementConfig> placementConfig;
 
-    std::vector<std::unique_ptr<SymbolLayout>> symbolLayouts;
+    // Group assignment for the current layers, computed once in setLayers and
+    // reused by every subsequent relayout (e.g. when only the data changes).
+    std::vector<style::LayoutGroup> layoutGroups;
+
+    // Layout results for non-symbol layout groups, keyed by the group
+    // leader's layout key (style::layoutKey). Lets setLayers reuse previously
+    // built buckets when the incoming layers produce an identical layout,
+    // e.g. when toggling between style classes. Invalidated whenever the tile
+    // data changes.
+    struct CachedBucket {
+        std::shared_ptr<Bucket> bucket;
+        std::string sourceLayerID;
+        std::shared_ptr<const std::vector<std::pair<GeometryCollection, std::size_t>>> indexEntries;
+        // (feature index, bucket vertex count after the feature was added);
+        // lets a cache hit rebuild the data-driven paint binders against the
+        // retained tile data without re-tessellating.
+        std::vector<std::pair<std::size_t, std::size_t>> binderEntries;
+    };
+    std::unordered_map<std::string, CachedBucket> bucketCache;
+
+    // A single pair of ICU transform objects, shared by all symbol layouts on
+    // this worker; ubidi_open is expensive enough to show up when every layer
+    // pays for its own. Only used from the worker's thread.
+    BiDi bidi;
+
+    std::vector<SymbolLayoutEntry> symbolLayouts;
     GlyphDependencies pendingGlyphDependencies;
     IconDependencyMap pendingIconDependencies;
     GlyphPositionMap glyphPositions;
@@ -8,7 +8,10 @@
 #include <mbgl/storage/response.hpp>
 #include <mbgl/storage/file_source.hpp>
 #include <mbgl/renderer/raster_bucket.hpp>
+#include <mbgl/util/constants.hpp>
+#include <mbgl/util/image.hpp>
 #include <mbgl/util/run_loop.hpp>
+#include <mbgl/util/startup_timeline.hpp>
 
 namespace mbgl {
 
@@ -16,7 +19,8 @@ RasterTile::RasterTile(const OverscaledTileID& id_,
                        const style::UpdateParameters& parameters,
                        const Tileset& tileset)
     : Tile(id_),
-      loader(*this, id_, parameters, tileset),
+      loader(*this, id_, parameters, tileset, std::string(imageAcceptHeader())),
+      displaySize(static_cast<uint32_t>(util::tileSize * parameters.pixelRatio)),
       mailbox(std::make_shared<Mailbox>(*util::RunLoop::Get())),
       worker(parameters.workerScheduler,
              ActorRef<RasterTile>(*this, mailbox)) {
@@ -36,10 +40,11 @@ void RasterTile::setData(std::shared_ptr<const std::string> data,
                              optional<Timestamp> expires_) {
     modified = modified_;
     expires = expires_;
-    worker.invoke(&RasterTileWorker::parse, data);
+    worker.invoke(&RasterTileWorker::parse, data, displaySize);
 }
 
 void RasterTile::onParsed(std::unique_ptr<Bucket> result) {
+    util::markStartupMilestone(StartupMilestone::FirstTileParsed);
     bucket = std::move(result);
     availableData = bucket ? DataAvailability::All : DataAvailability::None;
     observer->onTileChanged(*this);
@@ -55,6 +60,10 @@ Bucket* RasterTile::getBucket(const style::Layer&) {
     return bucket.get();
 }
 
+std::size_t RasterTile::getMemoryUsage() const {
+    return bucket ? bucket->getMemoryUsage() : 0;
+}
+
 void RasterTile::setNecessity(Necessity necessity) {
     loader.setNecessity(necessity);
 }
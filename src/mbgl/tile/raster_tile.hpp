@@ -31,12 +31,18 @@ public:
     void cancel() override;
     Bucket* getBucket(const style::Layer&) override;
 
+    std::size_t getMemoryUsage() const override;
+
     void onParsed(std::unique_ptr<Bucket> result);
     void onError(std::exception_ptr);
 
 private:
     TileLoader<RasterTile> loader;
 
+    // Physical size at which this tile is displayed; passed to the decoder as
+    // a downsampling hint for oversized sources.
+    const uint32_t displaySize;
+
     std::shared_ptr<Mailbox> mailbox;
     Actor<RasterTileWorker> worker;
 
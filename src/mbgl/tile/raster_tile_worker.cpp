@@ -2,7 +2,10 @@
 #include <mbgl/tile/raster_tile.hpp>
 #include <mbgl/renderer/raster_bucket.hpp>
 #include <mbgl/actor/actor.hpp>
+#include <mbgl/util/compressed_image.hpp>
 #include <mbgl/util/premultiply.hpp>
+#include <mbgl/util/tile_latency.hpp>
+#include <mbgl/util/trace.hpp>
 
 namespace mbgl {
 
@@ -10,14 +13,29 @@ RasterTileWorker::RasterTileWorker(ActorRef<RasterTileWorker>, ActorRef<RasterTi
     : parent(std::move(parent_)) {
 }
 
-void RasterTileWorker::parse(std::shared_ptr<const std::string> data) {
+void RasterTileWorker::parse(std::shared_ptr<const std::string> data, uint32_t displaySize) {
     if (!data) {
         parent.invoke(&RasterTile::onParsed, nullptr); // No data; empty tile.
         return;
     }
 
     try {
-        auto bucket = std::make_unique<RasterBucket>(util::unpremultiply(decodeImage(*data)));
+        if (isCompressedImage(*data)) {
+            // ETC2 payloads skip decoding entirely and are uploaded as-is.
+            auto bucket = std::make_unique<RasterBucket>(decodeCompressedImage(data));
+            parent.invoke(&RasterTile::onParsed, std::move(bucket));
+            return;
+        }
+
+        // Let the decoder downsample sources that are larger than the size at
+        // which the tile is displayed (e.g. high-dpi assets on a low-dpi
+        // screen), halving decode time and texture memory.
+        const TimePoint decodeStart = Clock::now();
+        auto image = decodeImage(*data, displaySize);
+        const TimePoint decodeEnd = Clock::now();
+        util::recordTileStageLatency(TileStage::RasterDecode, decodeEnd - decodeStart);
+        util::recordTraceEvent("raster decode", decodeStart, decodeEnd);
+        auto bucket = std::make_unique<RasterBucket>(util::unpremultiply(std::move(image)));
         parent.invoke(&RasterTile::onParsed, std::move(bucket));
     } catch (...) {
         parent.invoke(&RasterTile::onError, std::current_exception());
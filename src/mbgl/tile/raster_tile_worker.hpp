@@ -2,6 +2,7 @@
 
 #include <mbgl/actor/actor_ref.hpp>
 
+#include <cstdint>
 #include <memory>
 #include <string>
 
@@ -13,7 +14,7 @@ class RasterTileWorker {
 public:
     RasterTileWorker(ActorRef<RasterTileWorker>, ActorRef<RasterTile>);
 
-    void parse(std::shared_ptr<const std::string> data);
+    void parse(std::shared_ptr<const std::string> data, uint32_t displaySize);
 
 private:
     ActorRef<RasterTile> parent;
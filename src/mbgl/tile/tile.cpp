@@ -34,10 +34,13 @@ void Tile::queryRenderedFeatures(
         std::unordered_map<std::string, std::vector<Feature>>&,
         const GeometryCoordinates&,
         const TransformState&,
+        const std::unordered_map<std::string, const style::Layer*>&,
+        const float,
         const RenderedQueryOptions&) {}
 
 void Tile::querySourceFeatures(
         std::vector<Feature>&,
-        const style::SourceQueryOptions&) {}
+        const style::SourceQueryOptions&,
+        const std::vector<std::string>&) {}
 
 } // namespace mbgl
@@ -8,12 +8,14 @@
 #include <mbgl/tile/tile_id.hpp>
 #include <mbgl/renderer/bucket.hpp>
 #include <mbgl/tile/geometry_tile_data.hpp>
+#include <mbgl/map/feature_query.hpp>
 #include <mbgl/storage/resource.hpp>
 
 #include <string>
 #include <memory>
 #include <functional>
 #include <unordered_map>
+#include <vector>
 
 namespace mbgl {
 
@@ -52,15 +54,62 @@ public:
     virtual void setPlacementConfig(const PlacementConfig&) {}
     virtual void redoLayout() {}
 
+    // Approximate bytes this tile holds in bucket vertex/index storage and
+    // ancillary indexes. The tile cache budgets retained tiles by this value,
+    // since tiles vary by orders of magnitude in size.
+    virtual std::size_t getMemoryUsage() const {
+        return 0;
+    }
+
+    // Under memory pressure, release CPU-side data that is not required for
+    // rendering — GPU buffers stay alive so the tile remains renderable.
+    // Feature queries against the tile may come up empty until the next
+    // layout regenerates the released structures.
+    virtual void releaseMemory() {}
+
+    // Session snapshot support. serializeData re-encodes the tile's retained
+    // parsed data in the pre-decoded binary tile format, restricted to the
+    // named source layers; seedData feeds such a blob into a freshly created
+    // tile so its first layout runs without waiting for the network. Both
+    // default to unsupported.
+    virtual optional<std::string> serializeData(const std::vector<std::string>&) const {
+        return {};
+    }
+    virtual void seedData(std::shared_ptr<const std::string>) {}
+
+    // The raw encoded bytes this tile was last populated from, if the tile
+    // kind retains them. Overscaled variants of a tile share their canonical
+    // data, so the source seeds a newly created variant from a sibling's raw
+    // data instead of fetching and decoding the same bytes again.
+    virtual std::shared_ptr<const std::string> getRawData() const {
+        return nullptr;
+    }
+
     virtual void queryRenderedFeatures(
             std::unordered_map<std::string, std::vector<Feature>>& result,
             const GeometryCoordinates& queryGeometry,
             const TransformState&,
+            const std::unordered_map<std::string, const style::Layer*>& layers,
+            const float additionalQueryRadius,
             const RenderedQueryOptions& options);
 
+    // Shares the tile's immutable query state for off-thread execution.
+    // Default-constructed (null) members mean the tile has nothing queryable.
+    virtual FeatureQueryData featureQueryData() const {
+        return {};
+    }
+
     virtual void querySourceFeatures(
             std::vector<Feature>& result,
-            const style::SourceQueryOptions&);
+            const style::SourceQueryOptions&,
+            const std::vector<std::string>& indexedAttributes);
+
+    // Feature-state: per-feature key/value overlays consulted when
+    // data-driven paint values are evaluated. setFeatureState accumulates
+    // changes (an empty state clears the feature); uploadFeatureStates
+    // rewrites the affected attribute ranges during the frame's upload pass.
+    virtual void setFeatureState(uint64_t, const style::FeatureState&) {}
+    virtual void uploadFeatureStates(gl::Context&) {}
 
     void setTriedOptional();
 
@@ -1,5 +1,8 @@
 #include <mbgl/tile/tile_cache.hpp>
 #include <mbgl/tile/tile.hpp>
+#include <mbgl/algorithm/tile_eviction.hpp>
+#include <mbgl/util/memory_stats.hpp>
+#include <mbgl/util/performance_counters.hpp>
 
 #include <cassert>
 
@@ -7,23 +10,26 @@ namespace mbgl {
 
 void TileCache::setSize(size_t size_) {
     size = size_;
-
-    while (orderedKeys.size() > size) {
-        auto key = orderedKeys.front();
-        orderedKeys.pop_front();
-        tiles.erase(key);
-    }
-
+    evict();
     assert(orderedKeys.size() <= size);
 }
 
+void TileCache::setMaxByteSize(size_t maximumByteSize_) {
+    maximumByteSize = maximumByteSize_;
+    evict();
+}
+
 void TileCache::add(const OverscaledTileID& key, std::unique_ptr<Tile> tile) {
     if (!tile->isRenderable() || !size) {
         return;
     }
 
+    const size_t byteSize = tile->getMemoryUsage();
+
     // insert new or query existing tile
-    if (tiles.emplace(key, std::move(tile)).second) {
+    if (tiles.emplace(key, Entry { std::move(tile), byteSize }).second) {
+        totalByteSize += byteSize;
+        util::recordMemoryAllocation(MemoryCategory::TileCache, byteSize);
         // remove existing tile key
         orderedKeys.remove(key);
     }
@@ -31,10 +37,8 @@ void TileCache::add(const OverscaledTileID& key, std::unique_ptr<Tile> tile) {
     // (re-)insert tile key as newest
     orderedKeys.push_back(key);
 
-    // purge oldest key/tile if necessary
-    if (orderedKeys.size() > size) {
-        get(orderedKeys.front());
-    }
+    // purge oldest keys/tiles if necessary
+    evict();
 
     assert(orderedKeys.size() <= size);
 }
@@ -44,11 +48,19 @@ std::unique_ptr<Tile> TileCache::get(const OverscaledTileID& key) {
     std::unique_ptr<Tile> tile;
 
     auto it = tiles.find(key);
+    util::recordCacheLookup(CacheKind::TileCache, it != tiles.end());
     if (it != tiles.end()) {
-        tile = std::move(it->second);
+        tile = std::move(it->second.tile);
+        totalByteSize -= it->second.byteSize;
+        util::recordMemoryDeallocation(MemoryCategory::TileCache, it->second.byteSize);
         tiles.erase(it);
         orderedKeys.remove(key);
         assert(tile->isRenderable());
+
+        if (revisits.size() >= 2048) {
+            revisits.clear();
+        }
+        ++revisits[key];
     }
 
     return tile;
@@ -61,6 +73,68 @@ bool TileCache::has(const OverscaledTileID& key) {
 void TileCache::clear() {
     orderedKeys.clear();
     tiles.clear();
+    util::recordMemoryDeallocation(MemoryCategory::TileCache, totalByteSize);
+    totalByteSize = 0;
+}
+
+void TileCache::forEach(const std::function<void (Tile&)>& fn) {
+    for (auto& pair : tiles) {
+        fn(*pair.second.tile);
+    }
+}
+
+void TileCache::reduceMemoryUse() {
+    util::recordMemoryDeallocation(MemoryCategory::TileCache, totalByteSize);
+    totalByteSize = 0;
+    for (auto& pair : tiles) {
+        pair.second.tile->releaseMemory();
+        pair.second.byteSize = pair.second.tile->getMemoryUsage();
+        totalByteSize += pair.second.byteSize;
+    }
+    util::recordMemoryAllocation(MemoryCategory::TileCache, totalByteSize);
+    evict();
+}
+
+void TileCache::setEvictionContext(double zoom, double centerX, double centerY) {
+    evictionContext = EvictionContext { zoom, centerX, centerY };
+}
+
+uint32_t TileCache::getRevisits(const OverscaledTileID& key) const {
+    auto it = revisits.find(key);
+    return it != revisits.end() ? it->second : 0;
+}
+
+void TileCache::evict() {
+    // The newest tile is evicted as well when it alone exceeds the byte
+    // budget — retaining it would starve everything else anyway.
+    while (!orderedKeys.empty() &&
+           (orderedKeys.size() > size || totalByteSize > maximumByteSize)) {
+        auto victim = orderedKeys.begin();
+
+        // With a viewport context, evict the tile least likely to be
+        // revisited instead of the oldest one; on ties the older tile goes
+        // first. The cache is small enough that a linear scan per eviction
+        // is cheaper than maintaining an ordered structure.
+        if (evictionContext) {
+            double victimScore = 0;
+            for (auto it = orderedKeys.begin(); it != orderedKeys.end(); ++it) {
+                const double score = algorithm::tileEvictionScore(
+                    *it, evictionContext->zoom, evictionContext->centerX,
+                    evictionContext->centerY, getRevisits(*it));
+                if (it == orderedKeys.begin() || score > victimScore) {
+                    victimScore = score;
+                    victim = it;
+                }
+            }
+        }
+
+        auto it = tiles.find(*victim);
+        assert(it != tiles.end());
+        totalByteSize -= it->second.byteSize;
+        util::recordMemoryDeallocation(MemoryCategory::TileCache, it->second.byteSize);
+        tiles.erase(it);
+        orderedKeys.erase(victim);
+    }
 }
 
 } // namespace mbgl
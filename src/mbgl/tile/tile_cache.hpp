@@ -1,7 +1,9 @@
 #pragma once
 
 #include <mbgl/tile/tile_id.hpp>
+#include <mbgl/util/optional.hpp>
 
+#include <functional>
 #include <list>
 #include <memory>
 #include <map>
@@ -16,16 +18,64 @@ public:
 
     void setSize(size_t);
     size_t getSize() const { return size; };
+    void setMaxByteSize(size_t);
+    size_t getMaxByteSize() const { return maximumByteSize; };
+    size_t getByteSize() const { return totalByteSize; };
     void add(const OverscaledTileID& key, std::unique_ptr<Tile> data);
     std::unique_ptr<Tile> get(const OverscaledTileID& key);
     bool has(const OverscaledTileID& key);
     void clear();
 
+    // Drops CPU-side copies from retained tiles while keeping their GPU
+    // buffers, so they stay cheap to revive. Evicts tiles that are still
+    // over budget afterwards.
+    void reduceMemoryUse();
+
+    // Visits every retained tile. Used to keep cached tiles' feature state
+    // current, so they revive with correct attribute values.
+    void forEach(const std::function<void (Tile&)>&);
+
+    // Makes eviction prefer tiles the current viewport is unlikely to
+    // revisit (see algorithm::tileEvictionScore) over plain LRU order.
+    // Without a context, eviction falls back to oldest-first.
+    void setEvictionContext(double zoom, double centerX, double centerY);
+
 private:
-    std::map<OverscaledTileID, std::unique_ptr<Tile>> tiles;
+    void evict();
+    uint32_t getRevisits(const OverscaledTileID& key) const;
+
+    struct Entry {
+        std::unique_ptr<Tile> tile;
+
+        // Snapshot of the tile's getMemoryUsage() while it is retained;
+        // usage can only shrink while cached, so the budget errs on the
+        // conservative side.
+        size_t byteSize;
+    };
+
+    struct EvictionContext {
+        double zoom;
+        double centerX;
+        double centerY;
+    };
+
+    std::map<OverscaledTileID, Entry> tiles;
     std::list<OverscaledTileID> orderedKeys;
 
+    optional<EvictionContext> evictionContext;
+
+    // How often each tile has been revived from the cache; reviving predicts
+    // future revisits (zooming out and back in is the most common gesture).
+    // Bounded so stats from long sessions cannot grow without limit.
+    std::map<OverscaledTileID, uint32_t> revisits;
+
     size_t size;
+
+    // Tiles vary by orders of magnitude in memory (an empty ocean tile vs. a
+    // dense downtown tile), so the count limit alone is a poor proxy for
+    // memory use; the byte budget bounds the worst case.
+    size_t maximumByteSize = 32 * 1024 * 1024;
+    size_t totalByteSize = 0;
 };
 
 } // namespace mbgl
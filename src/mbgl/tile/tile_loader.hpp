@@ -1,6 +1,7 @@
 #pragma once
 
 #include <mbgl/util/noncopyable.hpp>
+#include <mbgl/util/chrono.hpp>
 #include <mbgl/storage/resource.hpp>
 #include <mbgl/tile/tile.hpp>
 
@@ -21,7 +22,8 @@ public:
     TileLoader(T&,
                const OverscaledTileID&,
                const style::UpdateParameters&,
-               const Tileset&);
+               const Tileset&,
+               optional<std::string> accept = {});
     ~TileLoader();
 
     using Necessity = Resource::Necessity;
@@ -57,6 +59,10 @@ private:
     Resource resource;
     FileSource& fileSource;
     std::unique_ptr<AsyncRequest> request;
+
+    // When the pending request was issued; feeds the network latency
+    // histogram once its response arrives.
+    TimePoint requestStart = TimePoint::min();
 };
 
 } // namespace mbgl
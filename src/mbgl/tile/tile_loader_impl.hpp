@@ -3,7 +3,10 @@
 #include <mbgl/tile/tile_loader.hpp>
 #include <mbgl/storage/file_source.hpp>
 #include <mbgl/style/update_parameters.hpp>
+#include <mbgl/util/startup_timeline.hpp>
+#include <mbgl/util/tile_latency.hpp>
 #include <mbgl/util/tileset.hpp>
+#include <mbgl/util/trace.hpp>
 
 #include <cassert>
 
@@ -13,7 +16,8 @@ template <typename T>
 TileLoader<T>::TileLoader(T& tile_,
                           const OverscaledTileID& id,
                           const style::UpdateParameters& parameters,
-                          const Tileset& tileset)
+                          const Tileset& tileset,
+                          optional<std::string> accept)
     : tile(tile_),
       necessity(Necessity::Optional),
       resource(Resource::tile(
@@ -25,6 +29,7 @@ TileLoader<T>::TileLoader(T& tile_,
         tileset.scheme)),
       fileSource(parameters.fileSource) {
     assert(!request);
+    resource.accept = std::move(accept);
     if (fileSource.supportsOptionalRequests()) {
         // When supported, the first request is always optional, even if the TileLoader
         // is marked as required. That way, we can let the first optional request continue
@@ -52,6 +57,8 @@ void TileLoader<T>::loadOptional() {
     assert(!request);
 
     resource.necessity = Resource::Optional;
+    util::markStartupMilestone(StartupMilestone::FirstTileRequested);
+    requestStart = Clock::now();
     request = fileSource.request(resource, [this](Response res) {
         request.reset();
 
@@ -89,6 +96,16 @@ void TileLoader<T>::makeOptional() {
 
 template <typename T>
 void TileLoader<T>::loadedData(const Response& res) {
+    if (requestStart != TimePoint::min()) {
+        const TimePoint requestEnd = Clock::now();
+        util::recordTileStageLatency(TileStage::Network, requestEnd - requestStart);
+        if (util::isTracing()) {
+            util::recordTraceEvent("network", requestStart, requestEnd, 0,
+                                   util::toString(tile.id).c_str());
+        }
+        requestStart = TimePoint::min();
+    }
+
     if (res.error && res.error->reason != Response::Error::Reason::NotFound) {
         tile.setError(std::make_exception_ptr(std::runtime_error(res.error->message)));
     } else if (res.notModified) {
@@ -108,6 +125,8 @@ void TileLoader<T>::loadRequired() {
     assert(!request);
 
     resource.necessity = Resource::Required;
+    util::markStartupMilestone(StartupMilestone::FirstTileRequested);
+    requestStart = Clock::now();
     request = fileSource.request(resource, [this](Response res) { loadedData(res); });
 }
 
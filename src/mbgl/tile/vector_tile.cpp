@@ -1,84 +1,84 @@
 #include <mbgl/tile/vector_tile.hpp>
+#include <mbgl/tile/vector_tile_data.hpp>
 #include <mbgl/tile/tile_loader_impl.hpp>
-#include <mbgl/tile/geometry_tile_data.hpp>
+#include <mbgl/tile/binary_tile_data.hpp>
 
 #include <protozero/pbf_reader.hpp>
 
+#include <iterator>
+#include <map>
+#include <memory>
+#include <mutex>
 #include <unordered_map>
 #include <functional>
 #include <utility>
 
 namespace mbgl {
 
-class VectorTileLayer;
-
-using packed_iter_type = protozero::iterator_range<protozero::pbf_reader::const_uint32_iterator>;
-
-struct VectorTileLayerData {
-    VectorTileLayerData(std::shared_ptr<const std::string>);
-    
-    // Hold a reference to the underlying pbf data that backs the lazily-built
-    // components of the owning VectorTileLayer and VectorTileFeature objects
-    std::shared_ptr<const std::string> data;
-    
-    uint32_t version = 1;
-    uint32_t extent = 4096;
-    std::unordered_map<std::string, uint32_t> keysMap;
-    std::vector<std::reference_wrapper<const std::string>> keys;
-    std::vector<Value> values;
-};
-
-class VectorTileFeature : public GeometryTileFeature {
+namespace {
+
+// Parsed layers shared process-wide, keyed by the identity of the raw pbf
+// blob and the layer name. Styles commonly reference the same tileset from
+// several sources (with different layer filters); their tiles then receive
+// the same response data buffer, and this registry lets them share a single
+// parse of each layer instead of repeating it per source. A VectorTileLayer
+// is immutable once constructed, so sharing across threads is safe. Entries
+// are weak: a layer stays registered only while some tile still holds it,
+// and expired slots are swept when the registry grows.
+class SharedVectorTileLayers {
 public:
-    VectorTileFeature(protozero::pbf_reader, std::shared_ptr<VectorTileLayerData> layerData);
-
-    FeatureType getType() const override { return type; }
-    optional<Value> getValue(const std::string&) const override;
-    std::unordered_map<std::string,Value> getProperties() const override;
-    optional<FeatureIdentifier> getID() const override;
-    GeometryCollection getGeometries() const override;
-
-private:
-    std::shared_ptr<VectorTileLayerData> layerData;
-    optional<FeatureIdentifier> id;
-    FeatureType type = FeatureType::Unknown;
-    packed_iter_type tags_iter;
-    packed_iter_type geometry_iter;
-};
-    
-class VectorTileLayer : public GeometryTileLayer {
-public:
-    VectorTileLayer(protozero::pbf_reader, std::shared_ptr<const std::string>);
-
-    std::size_t featureCount() const override { return features.size(); }
-    std::unique_ptr<GeometryTileFeature> getFeature(std::size_t) const override;
-    std::string getName() const override;
+    using Key = std::pair<const void*, std::string>;
+
+    template <typename ParseFn>
+    std::shared_ptr<const VectorTileLayer> obtain(Key key, ParseFn&& parse) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            auto it = entries.find(key);
+            if (it != entries.end()) {
+                if (auto layer = it->second.lock()) {
+                    return layer;
+                }
+            }
+        }
 
-private:
-    friend class VectorTileData;
-    friend class VectorTileFeature;
+        // Parse outside the lock so concurrent workers aren't serialized on
+        // it; when two race on the same layer, the first registration wins.
+        std::shared_ptr<const VectorTileLayer> layer = parse();
 
-    std::string name;
-    std::vector<protozero::pbf_reader> features;
-    std::shared_ptr<VectorTileLayerData> data;
-};
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = entries.find(key);
+        if (it != entries.end()) {
+            if (auto existing = it->second.lock()) {
+                return existing;
+            }
+            it->second = layer;
+            return layer;
+        }
 
-class VectorTileData : public GeometryTileData {
-public:
-    VectorTileData(std::shared_ptr<const std::string> data);
+        if (entries.size() >= maximumEntries) {
+            for (auto sweepIt = entries.begin(); sweepIt != entries.end();) {
+                sweepIt = sweepIt->second.expired() ? entries.erase(sweepIt)
+                                                    : std::next(sweepIt);
+            }
+        }
 
-    std::unique_ptr<GeometryTileData> clone() const override {
-        return std::make_unique<VectorTileData>(*this);
+        entries.emplace(std::move(key), layer);
+        return layer;
     }
 
-    const GeometryTileLayer* getLayer(const std::string&) const override;
-
 private:
-    std::shared_ptr<const std::string> data;
-    mutable bool parsed = false;
-    mutable std::unordered_map<std::string, VectorTileLayer> layers;
+    std::mutex mutex;
+    std::map<Key, std::weak_ptr<const VectorTileLayer>> entries;
+    static constexpr std::size_t maximumEntries = 512;
 };
 
+SharedVectorTileLayers& sharedVectorTileLayers() {
+    static SharedVectorTileLayers registry;
+    return registry;
+}
+
+} // namespace
+
 VectorTile::VectorTile(const OverscaledTileID& id_,
                        std::string sourceID_,
                        const style::UpdateParameters& parameters,
@@ -88,6 +88,7 @@ VectorTile::VectorTile(const OverscaledTileID& id_,
 }
 
 void VectorTile::setNecessity(Necessity necessity) {
+    GeometryTile::setNecessity(necessity);
     loader.setNecessity(necessity);
 }
 
@@ -96,8 +97,22 @@ void VectorTile::setData(std::shared_ptr<const std::string> data_,
                          optional<Timestamp> expires_) {
     modified = modified_;
     expires = expires_;
+    rawData = data_;
+
+    if (!data_) {
+        GeometryTile::setData(nullptr);
+    } else if (BinaryTileData::isBinaryTile(*data_)) {
+        // Pre-baked tile: decoded geometry in flat binary form.
+        GeometryTile::setData(std::make_unique<BinaryTileData>(data_));
+    } else {
+        GeometryTile::setData(std::make_unique<VectorTileData>(data_));
+    }
+}
 
-    GeometryTile::setData(data_ ? std::make_unique<VectorTileData>(data_) : nullptr);
+void VectorTile::seedData(std::shared_ptr<const std::string> data_) {
+    // Seeded data carries no modified/expires timestamps, so the loader still
+    // treats the tile as stale and refreshes it through the normal path.
+    setData(std::move(data_), {}, {});
 }
 
 Value parseValue(protozero::pbf_reader data) {
@@ -155,45 +170,60 @@ optional<Value> VectorTileFeature::getValue(const std::string& key) const {
         return optional<Value>();
     }
 
-    auto start_itr = tags_iter.begin();
-    const auto & end_itr = tags_iter.end();
-    while (start_itr != end_itr) {
-        uint32_t tag_key = static_cast<uint32_t>(*start_itr++);
+    return getValueForKeyIndex(keyIter->second);
+}
 
-        if (layerData->keysMap.size() <= tag_key) {
-            throw std::runtime_error("feature referenced out of range key");
-        }
+const std::vector<std::pair<uint32_t, uint32_t>>& VectorTileFeature::getTags() const {
+    if (!tags) {
+        std::vector<std::pair<uint32_t, uint32_t>> decoded;
+        auto start_itr = tags_iter.begin();
+        const auto & end_itr = tags_iter.end();
+        while (start_itr != end_itr) {
+            uint32_t tag_key = static_cast<uint32_t>(*start_itr++);
 
-        if (start_itr == end_itr) {
-            throw std::runtime_error("uneven number of feature tag ids");
-        }
+            if (layerData->keysMap.size() <= tag_key) {
+                throw std::runtime_error("feature referenced out of range key");
+            }
+
+            if (start_itr == end_itr) {
+                throw std::runtime_error("uneven number of feature tag ids");
+            }
+
+            uint32_t tag_val = static_cast<uint32_t>(*start_itr++);
+            if (layerData->values.size() <= tag_val) {
+                throw std::runtime_error("feature referenced out of range value");
+            }
 
-        uint32_t tag_val = static_cast<uint32_t>(*start_itr++);;
-        if (layerData->values.size() <= tag_val) {
-            throw std::runtime_error("feature referenced out of range value");
+            decoded.emplace_back(tag_key, tag_val);
         }
+        tags = std::move(decoded);
+    }
+
+    return *tags;
+}
 
-        if (tag_key == keyIter->second) {
-            return layerData->values[tag_val];
+optional<Value> VectorTileFeature::getValueForKeyIndex(uint32_t keyIndex) const {
+    for (const auto& tag : getTags()) {
+        if (tag.first == keyIndex) {
+            return layerData->values[tag.second];
         }
     }
 
     return optional<Value>();
 }
 
-std::unordered_map<std::string,Value> VectorTileFeature::getProperties() const {
-    std::unordered_map<std::string,Value> properties;
-    auto start_itr = tags_iter.begin();
-    const auto & end_itr = tags_iter.end();
-    while (start_itr != end_itr) {
-        uint32_t tag_key = static_cast<uint32_t>(*start_itr++);
-        if (start_itr == end_itr) {
-            throw std::runtime_error("uneven number of feature tag ids");
+const PropertyMap& VectorTileFeature::getProperties() const {
+    if (!properties) {
+        const auto& decoded = getTags();
+        PropertyMap result;
+        result.reserve(decoded.size());
+        for (const auto& tag : decoded) {
+            result.emplace(layerData->keys[tag.first], layerData->values[tag.second]);
         }
-        uint32_t tag_val = static_cast<uint32_t>(*start_itr++);
-        properties[layerData->keys.at(tag_key)] = layerData->values.at(tag_val);
+        properties = std::move(result);
     }
-    return properties;
+
+    return *properties;
 }
 
 optional<FeatureIdentifier> VectorTileFeature::getID() const {
@@ -201,45 +231,84 @@ optional<FeatureIdentifier> VectorTileFeature::getID() const {
 }
 
 GeometryCollection VectorTileFeature::getGeometries() const {
-    uint8_t cmd = 1;
-    uint32_t length = 0;
+    const float scale = float(util::EXTENT) / layerData->extent;
+
+    // First pass: walk the command stream without decoding coordinates —
+    // advancing the packed iterator only skips varint bytes — to learn how
+    // many rings there are and how many points each one holds. The second
+    // pass then appends into exactly-sized vectors; growth of unreserved
+    // rings used to dominate geometry decode time on dense road tiles.
+    std::vector<uint32_t> ringSizes;
+    {
+        uint32_t current = 0;
+        auto g_itr = geometry_iter.begin();
+        while (g_itr != geometry_iter.end()) {
+            const uint32_t cmd_length = static_cast<uint32_t>(*g_itr++);
+            const uint8_t cmd = cmd_length & 0x7;
+            const uint32_t length = cmd_length >> 3;
+
+            if (cmd == 1) { // moveTo
+                for (uint32_t i = 0; i < length; i++) {
+                    if (current > 0) {
+                        ringSizes.push_back(current);
+                    }
+                    current = 1;
+                }
+                std::advance(g_itr, 2 * length);
+            } else if (cmd == 2) { // lineTo
+                current += length;
+                std::advance(g_itr, 2 * length);
+            } else if (cmd == 7) { // closePolygon
+                if (current > 0) {
+                    ++current;
+                }
+            } else {
+                throw std::runtime_error("unknown command");
+            }
+        }
+        ringSizes.push_back(current);
+    }
+
     int32_t x = 0;
     int32_t y = 0;
-    const float scale = float(util::EXTENT) / layerData->extent;
 
     GeometryCollection lines;
+    lines.reserve(ringSizes.size());
 
+    std::size_t ring = 0;
     lines.emplace_back();
+    lines.back().reserve(ringSizes[0]);
     GeometryCoordinates* line = &lines.back();
 
     auto g_itr = geometry_iter.begin();
     while (g_itr != geometry_iter.end()) {
-        if (length == 0) {
-            uint32_t cmd_length = static_cast<uint32_t>(*g_itr++);
-            cmd = cmd_length & 0x7;
-            length = cmd_length >> 3;
-        }
-
-        --length;
-
-        if (cmd == 1 || cmd == 2) {
-            x += protozero::decode_zigzag32(static_cast<uint32_t>(*g_itr++));
-            y += protozero::decode_zigzag32(static_cast<uint32_t>(*g_itr++));
-
-            if (cmd == 1 && !line->empty()) { // moveTo
-                lines.emplace_back();
-                line = &lines.back();
+        const uint32_t cmd_length = static_cast<uint32_t>(*g_itr++);
+        const uint8_t cmd = cmd_length & 0x7;
+        const uint32_t length = cmd_length >> 3;
+
+        if (cmd == 1) { // moveTo
+            for (uint32_t i = 0; i < length; i++) {
+                if (!line->empty()) {
+                    lines.emplace_back();
+                    line = &lines.back();
+                    line->reserve(ringSizes[++ring]);
+                }
+                x += protozero::decode_zigzag32(static_cast<uint32_t>(*g_itr++));
+                y += protozero::decode_zigzag32(static_cast<uint32_t>(*g_itr++));
+                line->emplace_back(::round(x * scale), ::round(y * scale));
             }
-
-            line->emplace_back(::round(x * scale), ::round(y * scale));
-
-        } else if (cmd == 7) { // closePolygon
+        } else if (cmd == 2) { // lineTo
+            // Decode the whole run of zigzag pairs without re-dispatching on
+            // the command for every vertex.
+            for (uint32_t i = 0; i < length; i++) {
+                x += protozero::decode_zigzag32(static_cast<uint32_t>(*g_itr++));
+                y += protozero::decode_zigzag32(static_cast<uint32_t>(*g_itr++));
+                line->emplace_back(::round(x * scale), ::round(y * scale));
+            }
+        } else { // closePolygon; the first pass rejected every other command
             if (!line->empty()) {
                 line->push_back((*line)[0]);
             }
-
-        } else {
-            throw std::runtime_error("unknown command");
         }
     }
 
@@ -254,20 +323,54 @@ VectorTileData::VectorTileData(std::shared_ptr<const std::string> data_)
     : data(std::move(data_)) {
 }
 
-const GeometryTileLayer* VectorTileData::getLayer(const std::string& name) const {
-    if (!parsed) {
-        parsed = true;
-        protozero::pbf_reader tile_pbf(*data);
-        while (tile_pbf.next(3)) {
-            VectorTileLayer layer(tile_pbf.get_message(), data);
-            layers.emplace(layer.name, std::move(layer));
+void VectorTileData::scanLayerBoundaries() const {
+    if (parsed) {
+        return;
+    }
+
+    // Scan the tile once to find the layer boundaries, but defer parsing
+    // the layer contents (keys, values, feature offsets) until a layer is
+    // actually requested, so bucket construction can begin as soon as the
+    // first requested layer has been parsed instead of after the whole
+    // tile has been.
+    parsed = true;
+    protozero::pbf_reader tile_pbf(*data);
+    while (tile_pbf.next(3)) {
+        protozero::pbf_reader layer_pbf = tile_pbf.get_message();
+        protozero::pbf_reader name_pbf = layer_pbf;
+        while (name_pbf.next(1)) {
+            layerMessages.emplace(name_pbf.get_string(), layer_pbf);
+            break;
         }
     }
+}
+
+void VectorTileData::prepareForQuery() const {
+    // Materialize every layer so that getLayer calls from an off-thread
+    // query are pure map lookups, never racing the synchronous query path
+    // on the lazy caches above.
+    scanLayerBoundaries();
+    for (const auto& pair : layerMessages) {
+        getLayer(pair.first);
+    }
+}
+
+const GeometryTileLayer* VectorTileData::getLayer(const std::string& name) const {
+    scanLayerBoundaries();
 
     auto it = layers.find(name);
     if (it != layers.end()) {
-        return &it->second;
+        return it->second.get();
+    }
+
+    auto messageIt = layerMessages.find(name);
+    if (messageIt != layerMessages.end()) {
+        auto layer = sharedVectorTileLayers().obtain({ data.get(), name }, [&] {
+            return std::make_shared<const VectorTileLayer>(messageIt->second, data);
+        });
+        return layers.emplace(name, std::move(layer)).first->second.get();
     }
+
     return nullptr;
 }
 
@@ -316,4 +419,12 @@ std::string VectorTileLayer::getName() const {
     return name;
 }
 
+optional<uint32_t> VectorTileLayer::getKeyIndex(const std::string& key) const {
+    auto it = data->keysMap.find(key);
+    if (it == data->keysMap.end()) {
+        return {};
+    }
+    return it->second;
+}
+
 } // namespace mbgl
@@ -23,8 +23,15 @@ public:
                  optional<Timestamp> modified,
                  optional<Timestamp> expires);
 
+    void seedData(std::shared_ptr<const std::string>) override;
+
+    std::shared_ptr<const std::string> getRawData() const override {
+        return rawData;
+    }
+
 private:
     TileLoader<VectorTile> loader;
+    std::shared_ptr<const std::string> rawData;
 };
 
 } // namespace mbgl
@@ -0,0 +1,63 @@
+#include <mbgl/util/arena.hpp>
+
+namespace mbgl {
+namespace util {
+
+Arena::Arena(std::size_t chunkSize_) : chunkSize(chunkSize_) {
+}
+
+Arena::~Arena() = default;
+
+void* Arena::allocate(std::size_t bytes, std::size_t alignment) {
+    assert(alignment != 0 && (alignment & (alignment - 1)) == 0);
+
+    // Requests that could never fit in a chunk get dedicated storage, freed
+    // on reset rather than retained.
+    if (bytes + alignment > chunkSize) {
+        oversize.emplace_back(new char[bytes + alignment]);
+        void* p = oversize.back().get();
+        std::size_t space = bytes + alignment;
+        return std::align(alignment, bytes, p, space);
+    }
+
+    for (;;) {
+        if (cursor) {
+            void* p = cursor;
+            std::size_t space = end - cursor;
+            if (void* aligned = std::align(alignment, bytes, p, space)) {
+                cursor = static_cast<char*>(aligned) + bytes;
+                return aligned;
+            }
+        }
+        nextChunk();
+    }
+}
+
+void Arena::nextChunk() {
+    if (cursor) {
+        ++currentChunk;
+    }
+    if (currentChunk == chunks.size()) {
+        chunks.emplace_back(new char[chunkSize]);
+    }
+    cursor = chunks[currentChunk].get();
+    end = cursor + chunkSize;
+}
+
+void Arena::reset() {
+    oversize.clear();
+    currentChunk = 0;
+    if (chunks.empty()) {
+        cursor = end = nullptr;
+    } else {
+        cursor = chunks.front().get();
+        end = cursor + chunkSize;
+    }
+}
+
+std::size_t Arena::capacity() const {
+    return chunks.size() * chunkSize;
+}
+
+} // namespace util
+} // namespace mbgl
@@ -0,0 +1,87 @@
+#pragma once
+
+#include <mbgl/util/noncopyable.hpp>
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace mbgl {
+namespace util {
+
+// Bump allocator for short-lived scratch memory. Allocations advance a cursor
+// through fixed-size chunks; individual frees are no-ops and everything is
+// released at once by reset(). Chunks are retained across resets, so a
+// steady-state consumer — e.g. a tile layout that produces a similar amount of
+// scratch per pass — stops touching malloc entirely after warm-up. Not
+// thread-safe; each worker owns its own arena.
+class Arena : private noncopyable {
+public:
+    Arena(std::size_t chunkSize_ = 64 * 1024);
+    ~Arena();
+
+    // Returns uninitialized storage of the given size and alignment. The
+    // alignment must be a power of two no larger than the chunk size.
+    void* allocate(std::size_t bytes, std::size_t alignment);
+
+    // Invalidates all outstanding allocations. Regular chunks are kept for
+    // reuse; oversize allocations are freed.
+    void reset();
+
+    // Bytes of retained chunk storage, for sizing diagnostics.
+    std::size_t capacity() const;
+
+private:
+    void nextChunk();
+
+    using Chunk = std::unique_ptr<char[]>;
+
+    const std::size_t chunkSize;
+    std::vector<Chunk> chunks;
+    std::vector<Chunk> oversize;
+    std::size_t currentChunk = 0;
+    char* cursor = nullptr;
+    char* end = nullptr;
+};
+
+// Standard allocator adapter over an Arena. deallocate() is a no-op; memory
+// comes back when the arena is reset. Allocators compare equal iff they share
+// an arena.
+template <typename T>
+class ArenaAllocator {
+public:
+    using value_type = T;
+
+    ArenaAllocator(Arena& arena_) : arena(&arena_) {}
+
+    template <typename U>
+    ArenaAllocator(const ArenaAllocator<U>& other) : arena(other.arena) {}
+
+    T* allocate(std::size_t n) {
+        return static_cast<T*>(arena->allocate(n * sizeof(T), alignof(T)));
+    }
+
+    void deallocate(T*, std::size_t) {
+        // Freed wholesale by Arena::reset().
+    }
+
+    Arena* arena;
+};
+
+template <typename T, typename U>
+bool operator==(const ArenaAllocator<T>& a, const ArenaAllocator<U>& b) {
+    return a.arena == b.arena;
+}
+
+template <typename T, typename U>
+bool operator!=(const ArenaAllocator<T>& a, const ArenaAllocator<U>& b) {
+    return a.arena != b.arena;
+}
+
+template <typename T>
+using ArenaVector = std::vector<T, ArenaAllocator<T>>;
+
+} // namespace util
+} // namespace mbgl
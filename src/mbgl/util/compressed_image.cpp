@@ -0,0 +1,68 @@
+#include <mbgl/util/compressed_image.hpp>
+
+#include <stdexcept>
+
+namespace mbgl {
+
+namespace {
+
+constexpr std::size_t pkmHeaderSize = 16;
+
+// PKM 20 header fields are big-endian uint16's.
+uint16_t readUint16BE(const std::string& data, std::size_t offset) {
+    return static_cast<uint16_t>(static_cast<uint8_t>(data[offset]) << 8 |
+                                 static_cast<uint8_t>(data[offset + 1]));
+}
+
+} // namespace
+
+bool isCompressedImage(const std::string& data) {
+    return data.size() >= pkmHeaderSize && data.compare(0, 6, "PKM 20") == 0;
+}
+
+CompressedImage decodeCompressedImage(std::shared_ptr<const std::string> payload) {
+    if (!isCompressedImage(*payload)) {
+        throw std::runtime_error("compressed image is not a PKM 20 container");
+    }
+
+    CompressedImage image;
+
+    // 1 = ETC2_RGB, 3 = ETC2_RGBA; the remaining codes are ETC1, punchthrough
+    // alpha, and the R11/RG11 data formats, none of which we accept.
+    const uint16_t format = readUint16BE(*payload, 6);
+    std::size_t blockSize;
+    switch (format) {
+    case 1:
+        image.format = CompressedImage::Format::ETC2RGB8;
+        blockSize = 8;
+        break;
+    case 3:
+        image.format = CompressedImage::Format::ETC2RGBA8;
+        blockSize = 16;
+        break;
+    default:
+        throw std::runtime_error("unsupported PKM texture format");
+    }
+
+    // The encoded size is the visible size padded up to whole 4×4 blocks.
+    const uint16_t encodedWidth = readUint16BE(*payload, 8);
+    const uint16_t encodedHeight = readUint16BE(*payload, 10);
+    const uint16_t width = readUint16BE(*payload, 12);
+    const uint16_t height = readUint16BE(*payload, 14);
+    if (width == 0 || height == 0 ||
+        encodedWidth != ((width + 3) & ~3) || encodedHeight != ((height + 3) & ~3)) {
+        throw std::runtime_error("mismatched PKM image size");
+    }
+
+    image.size = { width, height };
+    image.dataOffset = pkmHeaderSize;
+    image.dataSize = (encodedWidth / 4) * (encodedHeight / 4) * blockSize;
+    if (payload->size() < image.dataOffset + image.dataSize) {
+        throw std::runtime_error("truncated PKM image data");
+    }
+
+    image.payload = std::move(payload);
+    return image;
+}
+
+} // namespace mbgl
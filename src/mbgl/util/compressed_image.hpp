@@ -0,0 +1,45 @@
+#pragma once
+
+#include <mbgl/util/size.hpp>
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace mbgl {
+
+// A compressed texture payload that is handed to the GPU as-is. Unlike
+// Image<>, the pixel data cannot be decoded on the CPU; the original
+// container payload is retained and uploaded directly with
+// glCompressedTexImage2D. Only ETC2 data in a PKM 20 container is currently
+// recognized.
+class CompressedImage {
+public:
+    enum class Format : uint8_t {
+        ETC2RGB8,
+        ETC2RGBA8,
+    };
+
+    Size size = { 0, 0 };
+    Format format = Format::ETC2RGB8;
+
+    const void* data() const {
+        return payload->data() + dataOffset;
+    }
+
+    std::size_t dataSize = 0;
+
+    // The container file; the texture data starts at `dataOffset`.
+    std::shared_ptr<const std::string> payload;
+    std::size_t dataOffset = 0;
+};
+
+// Whether the given payload starts with a compressed texture container we
+// recognize.
+bool isCompressedImage(const std::string&);
+
+// Parses a PKM 20 container. Throws std::runtime_error if the payload is
+// malformed, truncated, or uses a texture format we don't support.
+CompressedImage decodeCompressedImage(std::shared_ptr<const std::string> payload);
+
+} // namespace mbgl
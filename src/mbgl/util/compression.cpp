@@ -2,6 +2,8 @@
 
 #include <zlib.h>
 
+#include <algorithm>
+#include <cstdint>
 #include <cstdio>
 #include <cstring>
 #include <stdexcept>
@@ -67,25 +69,50 @@ std::string decompress(const std::string &raw) {
     memset(&inflate_stream, 0, sizeof(inflate_stream));
 
     // TODO: reuse z_streams
-    if (inflateInit(&inflate_stream) != Z_OK) {
+    // 32 + MAX_WBITS enables automatic zlib/gzip header detection; our own
+    // database blobs are zlib-wrapped, but network payloads may be gzip.
+    if (inflateInit2(&inflate_stream, 32 + MAX_WBITS) != Z_OK) {
         throw std::runtime_error("failed to initialize inflate");
     }
 
     inflate_stream.next_in = (Bytef *)raw.data();
     inflate_stream.avail_in = uInt(raw.size());
 
+    // A gzip trailer records the uncompressed size (ISIZE, modulo 2^32) in
+    // its last four bytes; use it to size the result exactly, so the common
+    // case is a single allocation that inflate fills in one pass. zlib
+    // streams carry no such hint, so size those for a typical ~4:1 deflate
+    // ratio. Either way inflate writes directly into the result — no
+    // intermediate stack buffer — and the buffer grows geometrically in the
+    // rare case the guess falls short.
+    std::size_t sizeHint;
+    if (raw.size() >= 18 && static_cast<uint8_t>(raw[0]) == 0x1f &&
+        static_cast<uint8_t>(raw[1]) == 0x8b) {
+        sizeHint = static_cast<uint32_t>(static_cast<uint8_t>(raw[raw.size() - 4])) |
+                   static_cast<uint32_t>(static_cast<uint8_t>(raw[raw.size() - 3])) << 8 |
+                   static_cast<uint32_t>(static_cast<uint8_t>(raw[raw.size() - 2])) << 16 |
+                   static_cast<uint32_t>(static_cast<uint8_t>(raw[raw.size() - 1])) << 24;
+        sizeHint = std::max<std::size_t>(sizeHint, 64);
+        // ISIZE comes from untrusted response bytes: a tiny crafted payload
+        // declaring 4 GB must not preallocate it. Deflate tops out around
+        // 1:1000, so cap the hint at a generous multiple of the compressed
+        // size and let geometric growth serve honest payloads beyond it.
+        sizeHint = std::min<std::size_t>(sizeHint, raw.size() * 64);
+    } else {
+        sizeHint = std::max<std::size_t>(raw.size() * 4, 1024);
+    }
+
     std::string result;
-    char out[15384];
+    result.resize(sizeHint);
 
     int code;
     do {
-        inflate_stream.next_out = reinterpret_cast<Bytef *>(out);
-        inflate_stream.avail_out = sizeof(out);
-        code = inflate(&inflate_stream, 0);
-        // result.append(out, sizeof(out) - inflate_stream.avail_out);
-        if (result.size() < inflate_stream.total_out) {
-            result.append(out, inflate_stream.total_out - result.size());
+        if (inflate_stream.total_out == result.size()) {
+            result.resize(result.size() * 2);
         }
+        inflate_stream.next_out = reinterpret_cast<Bytef *>(&result[inflate_stream.total_out]);
+        inflate_stream.avail_out = uInt(result.size() - inflate_stream.total_out);
+        code = inflate(&inflate_stream, 0);
     } while (code == Z_OK);
 
     inflateEnd(&inflate_stream);
@@ -94,6 +121,7 @@ std::string decompress(const std::string &raw) {
         throw std::runtime_error(inflate_stream.msg ? inflate_stream.msg : "decompression error");
     }
 
+    result.resize(inflate_stream.total_out);
     return result;
 }
 } // namespace util
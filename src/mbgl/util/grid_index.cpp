@@ -1,9 +1,8 @@
 #include <mbgl/util/grid_index.hpp>
 #include <mbgl/geometry/feature_index.hpp>
+#include <mbgl/text/collision_tile.hpp>
 #include <mbgl/math/minmax.hpp>
 
-#include <unordered_set>
-
 namespace mbgl {
 
 
@@ -18,6 +17,7 @@ GridIndex<T>::GridIndex(int32_t extent_, int32_t n_, int32_t padding_) :
     max(extent + double(padding) / n * extent)
     {
         cells.resize(d * d);
+        cellOccupancy.resize((d * d + 63) / 64);
     }
 
 template <class T>
@@ -34,6 +34,7 @@ void GridIndex<T>::insert(T&& t, const BBox& bbox) {
         for (y = cy1; y <= cy2; ++y) {
             cellIndex = d * y + x;
             cells[cellIndex].push_back(uid);
+            cellOccupancy[cellIndex >> 6] |= uint64_t(1) << (cellIndex & 63);
         }
     }
 
@@ -43,30 +44,48 @@ void GridIndex<T>::insert(T&& t, const BBox& bbox) {
 template <class T>
 std::vector<T> GridIndex<T>::query(const BBox& queryBBox) const {
     std::vector<T> result;
-    std::unordered_set<size_t> seenUids;
 
     auto cx1 = convertToCellCoord(queryBBox.min.x);
     auto cy1 = convertToCellCoord(queryBBox.min.y);
     auto cx2 = convertToCellCoord(queryBBox.max.x);
     auto cy2 = convertToCellCoord(queryBBox.max.y);
 
+    // Elements spanning several cells would be reported once per cell; a
+    // seen mask dedupes them. The mask is per-query stack state rather than
+    // a member so that concurrent queries — the async feature query executes
+    // on a worker while the synchronous path stays on the map thread — never
+    // write shared index state. A query covering a single cell cannot see
+    // duplicates.
+    const bool needsDedupe = cx1 != cx2 || cy1 != cy2;
+    std::vector<bool> seen;
+    if (needsDedupe) {
+        seen.resize(elements.size(), false);
+    }
+    queries.fetch_add(1, std::memory_order_relaxed);
+
     int32_t x, y, cellIndex;
     for (x = cx1; x <= cx2; ++x) {
         for (y = cy1; y <= cy2; ++y) {
             cellIndex = d * y + x;
+            if (!(cellOccupancy[cellIndex >> 6] & (uint64_t(1) << (cellIndex & 63)))) {
+                continue;
+            }
             for (auto uid : cells[cellIndex]) {
-                if (seenUids.count(uid) == 0) {
-                    seenUids.insert(uid);
+                if (needsDedupe) {
+                    if (seen[uid]) {
+                        continue;
+                    }
+                    seen[uid] = true;
+                }
 
-                    auto& pair = elements.at(uid);
-                    auto& bbox = pair.second;
-                    if (queryBBox.min.x <= bbox.max.x &&
-                        queryBBox.min.y <= bbox.max.y &&
-                        queryBBox.max.x >= bbox.min.x &&
-                        queryBBox.max.y >= bbox.min.y) {
+                auto& pair = elements[uid];
+                auto& bbox = pair.second;
+                if (queryBBox.min.x <= bbox.max.x &&
+                    queryBBox.min.y <= bbox.max.y &&
+                    queryBBox.max.x >= bbox.min.x &&
+                    queryBBox.max.y >= bbox.min.y) {
 
-                        result.push_back(pair.first);
-                    }
+                    result.push_back(pair.first);
                 }
             }
         }
@@ -76,10 +95,22 @@ std::vector<T> GridIndex<T>::query(const BBox& queryBBox) const {
 }
 
 
+template <class T>
+std::size_t GridIndex<T>::byteSize() const {
+    std::size_t size = elements.capacity() * sizeof(std::pair<T, BBox>)
+        + cells.capacity() * sizeof(std::vector<size_t>)
+        + cellOccupancy.capacity() * sizeof(uint64_t);
+    for (const auto& cell : cells) {
+        size += cell.capacity() * sizeof(size_t);
+    }
+    return size;
+}
+
 template <class T>
 int32_t GridIndex<T>::convertToCellCoord(int32_t x) const {
     return util::max(0.0, util::min(d - 1.0, std::floor(x * scale) + padding));
 }
 
 template class GridIndex<IndexedSubfeature>;
+template class GridIndex<CollisionTreeBox>;
 } // namespace mbgl
@@ -3,6 +3,7 @@
 #include <mapbox/geometry/point.hpp>
 #include <mapbox/geometry/box.hpp>
 
+#include <atomic>
 #include <cstdint>
 #include <cstddef>
 #include <vector>
@@ -19,6 +20,20 @@ public:
     void insert(T&& t, const BBox&);
     std::vector<T> query(const BBox&) const;
 
+    bool empty() const {
+        return elements.empty();
+    }
+
+    // Approximate heap footprint of the index, used for cache accounting.
+    // Inline storage only; strings inside elements are not followed.
+    std::size_t byteSize() const;
+
+    // Number of queries answered since construction, for placement
+    // instrumentation.
+    uint64_t queryCount() const {
+        return queries.load(std::memory_order_relaxed);
+    }
+
 private:
     int32_t convertToCellCoord(int32_t x) const;
 
@@ -33,6 +48,14 @@ private:
     std::vector<std::pair<T, BBox>> elements;
     std::vector<std::vector<size_t>> cells;
 
+    // One bit per cell, set when the cell holds at least one element, so
+    // queries skip empty cells without touching their vectors.
+    std::vector<uint64_t> cellOccupancy;
+
+    // Query counter for instrumentation only. Atomic because the async
+    // feature query path runs queries off the owning thread; relaxed, since
+    // it is only ever read as a whole-run total.
+    mutable std::atomic<uint64_t> queries { 0 };
 };
 
 } // namespace mbgl
@@ -1,18 +1,27 @@
 #include <mbgl/util/http_timeout.hpp>
 #include <mbgl/util/constants.hpp>
+#include <mbgl/storage/network_quality.hpp>
+
+#include <random>
 
 namespace mbgl {
 namespace http {
 
 Duration errorRetryTimeout(Response::Error::Reason failedRequestReason, uint32_t failedRequests, optional<Timestamp> retryAfter) {
 
+    // On a network already measured as poor, retry one doubling later from
+    // the start: piling retries onto a saturated link creates the very
+    // timeout storm the backoff is meant to resolve.
+    const uint32_t penalty = NetworkQuality::Get() == NetworkQuality::Level::Poor ? 1 : 0;
+
     if (failedRequestReason == Response::Error::Reason::Server) {
         // Retry after one second three times, then start exponential backoff.
-        return Seconds(failedRequests <= 3 ? 1 : 1u << std::min(failedRequests - 3, 31u));
+        return Seconds(failedRequests <= 3 ? 1u << penalty
+                                           : 1u << std::min(failedRequests - 3 + penalty, 31u));
     } else if (failedRequestReason == Response::Error::Reason::Connection) {
         // Immediate exponential backoff.
         assert(failedRequests > 0);
-        return Seconds(1u << std::min(failedRequests - 1, 31u));
+        return Seconds(1u << std::min(failedRequests - 1 + penalty, 31u));
     } else if (failedRequestReason == Response::Error::Reason::RateLimit) {
         if (retryAfter) {
             return *retryAfter - util::now();
@@ -36,5 +45,32 @@ Duration expirationTimeout(optional<Timestamp> expires, uint32_t expiredRequests
     }
 }
 
+Duration revalidationTimeout(Duration expirationTimeout_, Duration staleWhileRevalidate) {
+    if (expirationTimeout_ == Duration::max()) {
+        return expirationTimeout_;
+    }
+
+    // Within the stale-while-revalidate window a stale resource keeps being
+    // served from cache; its revalidation fires when the window closes,
+    // batched with everything else that went stale in the same window.
+    if (expirationTimeout_ < staleWhileRevalidate) {
+        expirationTimeout_ = staleWhileRevalidate;
+    }
+
+    // Jitter the timer by up to 1/8th of the wait (capped at 30 seconds), so
+    // that resources which expire together — a whole tile pyramid fetched in
+    // one burst — don't all hit the server in the same instant.
+    const Duration::rep bound = std::min<Duration::rep>(
+        expirationTimeout_.count() / 8,
+        std::chrono::duration_cast<Duration>(Seconds(30)).count());
+
+    if (bound > 0) {
+        thread_local std::mt19937 generator{std::random_device{}()};
+        expirationTimeout_ += Duration(std::uniform_int_distribution<Duration::rep>(0, bound)(generator));
+    }
+
+    return expirationTimeout_;
+}
+
 } // namespace http
 } // namespace mbgl
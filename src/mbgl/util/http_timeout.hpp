@@ -11,5 +11,12 @@ Duration errorRetryTimeout(Response::Error::Reason failedRequestReason, uint32_t
 
 Duration expirationTimeout(optional<Timestamp> expires, uint32_t expiredRequests);
 
+// Adjusts a conditional revalidation timer: a resource stale by less than the
+// stale-while-revalidate window keeps being served from cache and revalidates
+// when the window closes, and non-immediate timers are jittered so resources
+// that expired together revalidate as a loose cluster instead of a
+// synchronized spike.
+Duration revalidationTimeout(Duration expirationTimeout, Duration staleWhileRevalidate);
+
 } // namespace http
 } // namespace mbgl
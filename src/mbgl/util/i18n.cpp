@@ -1,5 +1,7 @@
 #include "i18n.hpp"
 
+#include <array>
+#include <cstdint>
 #include <map>
 
 namespace {
@@ -316,7 +318,33 @@ namespace mbgl {
 namespace util {
 namespace i18n {
 
-bool allowsWordBreaking(char16_t chr) {
+namespace {
+
+/** A presence bitmap over the Basic Multilingual Plane. The classifications
+    below walk dozens of block ranges per codepoint, and shaping queries them
+    for every character of every label. Building the answers into an 8 KB
+    bitmap on first use turns each query into a single L1-resident load and
+    mask, while the block predicates above stay the readable source of truth. */
+class CodepointSet {
+public:
+    template <typename Classify>
+    explicit CodepointSet(Classify classify) {
+        for (uint32_t chr = 0; chr <= 0xFFFF; chr++) {
+            if (classify(static_cast<char16_t>(chr))) {
+                bits[chr >> 5] |= 1u << (chr & 31);
+            }
+        }
+    }
+
+    bool contains(char16_t chr) const {
+        return (bits[chr >> 5] >> (chr & 31)) & 1;
+    }
+
+private:
+    std::array<uint32_t, 2048> bits = {};
+};
+
+bool classifyWordBreaking(char16_t chr) {
     return (chr == 0x0a      /* newline */
             || chr == 0x20   /* space */
             || chr == 0x26   /* ampersand */
@@ -332,16 +360,7 @@ bool allowsWordBreaking(char16_t chr) {
             || chr == 0x2013 /* en dash */);
 }
 
-bool allowsIdeographicBreaking(const std::u16string& string) {
-    for (char16_t chr : string) {
-        if (!allowsIdeographicBreaking(chr)) {
-            return false;
-        }
-    }
-    return true;
-}
-
-bool allowsIdeographicBreaking(char16_t chr) {
+bool classifyIdeographicBreaking(char16_t chr) {
     // Allow U+2027 "Interpunct" for hyphenation of Chinese words
     if (chr == 0x2027)
         return true;
@@ -374,13 +393,12 @@ bool allowsIdeographicBreaking(char16_t chr) {
     //        || isInCJKCompatibilityIdeographsSupplement(chr));
 }
 
-bool allowsVerticalWritingMode(const std::u16string& string) {
-    for (char32_t chr : string) {
-        if (hasUprightVerticalOrientation(chr)) {
-            return true;
-        }
-    }
-    return false;
+bool classifyFixedWidthGlyphGeneration(char16_t chr) {
+    // Characters in these blocks are drawn as fixed-width squares, so their
+    // metrics can be synthesized from the font's nominal advance without
+    // text shaping. Notably absent: halfwidth forms and combining characters.
+    return isInCJKUnifiedIdeographs(chr) || isInHiragana(chr) || isInKatakana(chr) ||
+           isInHangulSyllables(chr);
 }
 
 // The following logic comes from
@@ -389,7 +407,7 @@ bool allowsVerticalWritingMode(const std::u16string& string) {
 // upright in vertical text but does not distinguish between upright and
 // “neutral” characters.
 
-bool hasUprightVerticalOrientation(char16_t chr) {
+bool classifyUprightVerticalOrientation(char16_t chr) {
     if (chr == u'˪' || chr == u'˫')
         return true;
 
@@ -474,7 +492,7 @@ bool hasUprightVerticalOrientation(char16_t chr) {
     return false;
 }
 
-bool hasNeutralVerticalOrientation(char16_t chr) {
+bool classifyNeutralVerticalOrientation(char16_t chr) {
     if (isInLatin1Supplement(chr)) {
         if (chr == u'§' || chr == u'©' || chr == u'®' || chr == u'±' || chr == u'¼' ||
             chr == u'½' || chr == u'¾' || chr == u'×' || chr == u'÷') {
@@ -525,6 +543,51 @@ bool hasNeutralVerticalOrientation(char16_t chr) {
     return false;
 }
 
+} // namespace
+
+bool allowsWordBreaking(char16_t chr) {
+    static const CodepointSet set(classifyWordBreaking);
+    return set.contains(chr);
+}
+
+bool allowsIdeographicBreaking(const std::u16string& string) {
+    for (char16_t chr : string) {
+        if (!allowsIdeographicBreaking(chr)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool allowsIdeographicBreaking(char16_t chr) {
+    static const CodepointSet set(classifyIdeographicBreaking);
+    return set.contains(chr);
+}
+
+bool allowsFixedWidthGlyphGeneration(char16_t chr) {
+    static const CodepointSet set(classifyFixedWidthGlyphGeneration);
+    return set.contains(chr);
+}
+
+bool allowsVerticalWritingMode(const std::u16string& string) {
+    for (char32_t chr : string) {
+        if (hasUprightVerticalOrientation(chr)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool hasUprightVerticalOrientation(char16_t chr) {
+    static const CodepointSet set(classifyUprightVerticalOrientation);
+    return set.contains(chr);
+}
+
+bool hasNeutralVerticalOrientation(char16_t chr) {
+    static const CodepointSet set(classifyNeutralVerticalOrientation);
+    return set.contains(chr);
+}
+
 bool hasRotatedVerticalOrientation(char16_t chr) {
     return !(hasUprightVerticalOrientation(chr) || hasNeutralVerticalOrientation(chr));
 }
@@ -19,6 +19,11 @@ bool allowsIdeographicBreaking(const std::u16string& string);
     by the given Unicode codepoint due to ideographic breaking. */
 bool allowsIdeographicBreaking(char16_t chr);
 
+/** Returns whether the given Unicode codepoint identifies a fixed-width
+    ideographic character whose glyph metrics can be synthesized locally
+    without text shaping, making it eligible for local glyph generation. */
+bool allowsFixedWidthGlyphGeneration(char16_t chr);
+
 /** Returns whether any substring of the given string can be drawn as vertical
     text with upright glyphs. */
 bool allowsVerticalWritingMode(const std::u16string& string);
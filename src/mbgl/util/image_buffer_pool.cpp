@@ -0,0 +1,122 @@
+#include <mbgl/util/image_buffer_pool.hpp>
+
+#include <cstring>
+#include <map>
+#include <mutex>
+#include <vector>
+
+namespace mbgl {
+namespace util {
+namespace {
+
+// Every buffer is prefixed by a header recording its capacity, so the deleter
+// can find its size class (and the allocation base) without a side table. The
+// header is max_align_t-sized to keep the pixel data suitably aligned.
+constexpr std::size_t headerSize = alignof(std::max_align_t);
+
+// Buffers below this size bypass the pool: sprite icons and other small
+// images are cheap to allocate and would crowd out tile-sized buffers.
+constexpr std::size_t minimumPooledBytes = 64 * 1024;
+
+// Upper bound on idle memory retained across all size classes.
+constexpr std::size_t maximumRetainedBytes = 32 * 1024 * 1024;
+
+// Requests are rounded up to power-of-two size classes so that e.g. @2x and
+// plain 512px tiles each recycle within their own class.
+std::size_t capacityFor(std::size_t bytes) {
+    if (bytes < minimumPooledBytes) {
+        return bytes;
+    }
+    std::size_t capacity = minimumPooledBytes;
+    while (capacity < bytes) {
+        capacity *= 2;
+    }
+    return capacity;
+}
+
+class ImageBufferPool {
+public:
+    ~ImageBufferPool() {
+        shrink();
+    }
+
+    uint8_t* allocate(std::size_t bytes) {
+        const std::size_t capacity = capacityFor(bytes);
+        if (capacity >= minimumPooledBytes) {
+            std::lock_guard<std::mutex> lock(mutex);
+            auto it = freeLists.find(capacity);
+            if (it != freeLists.end() && !it->second.empty()) {
+                uint8_t* base = it->second.back();
+                it->second.pop_back();
+                retainedBytes -= capacity;
+                // Match the value-initialization fresh allocations get.
+                std::memset(base + headerSize, 0, bytes);
+                return base + headerSize;
+            }
+        }
+
+        auto* base = new uint8_t[headerSize + capacity]();
+        std::memcpy(base, &capacity, sizeof(capacity));
+        return base + headerSize;
+    }
+
+    void release(uint8_t* data) {
+        uint8_t* base = data - headerSize;
+        std::size_t capacity;
+        std::memcpy(&capacity, base, sizeof(capacity));
+
+        if (capacity >= minimumPooledBytes) {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (retainedBytes + capacity <= maximumRetainedBytes) {
+                freeLists[capacity].push_back(base);
+                retainedBytes += capacity;
+                return;
+            }
+        }
+
+        delete[] base;
+    }
+
+    void shrink() {
+        std::map<std::size_t, std::vector<uint8_t*>> idle;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            idle.swap(freeLists);
+            retainedBytes = 0;
+        }
+        for (const auto& freeList : idle) {
+            for (uint8_t* base : freeList.second) {
+                delete[] base;
+            }
+        }
+    }
+
+private:
+    std::mutex mutex;
+    std::map<std::size_t, std::vector<uint8_t*>> freeLists;
+    std::size_t retainedBytes = 0;
+};
+
+ImageBufferPool& imageBufferPool() {
+    static ImageBufferPool pool;
+    return pool;
+}
+
+} // namespace
+
+void ImageBufferDeleter::operator()(uint8_t* data) const {
+    if (data) {
+        imageBufferPool().release(data);
+    }
+}
+
+ImageBuffer allocateImageBuffer(std::size_t bytes) {
+    return ImageBuffer(imageBufferPool().allocate(bytes));
+}
+
+void shrinkImageBufferPool() {
+    imageBufferPool().shrink();
+}
+
+} // namespace util
+} // namespace mbgl
@@ -0,0 +1,49 @@
+#include <mbgl/util/interned_string.hpp>
+
+#include <cassert>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace mbgl {
+namespace util {
+
+namespace {
+
+std::mutex mutex;
+
+std::unordered_map<std::string, StringID>& handles() {
+    static auto& map = *new std::unordered_map<std::string, StringID>();
+    return map;
+}
+
+// Strings are heap-allocated individually so the references handed out by
+// internedString() survive rehashing of the tables.
+std::vector<std::unique_ptr<const std::string>>& strings() {
+    static auto& list = *new std::vector<std::unique_ptr<const std::string>>();
+    return list;
+}
+
+} // namespace
+
+StringID internString(const std::string& string) {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = handles().find(string);
+    if (it != handles().end()) {
+        return it->second;
+    }
+    strings().push_back(std::make_unique<const std::string>(string));
+    const StringID handle = static_cast<StringID>(strings().size());
+    handles().emplace(string, handle);
+    return handle;
+}
+
+const std::string& internedString(StringID handle) {
+    std::lock_guard<std::mutex> lock(mutex);
+    assert(handle != 0 && handle <= strings().size());
+    return *strings()[handle - 1];
+}
+
+} // namespace util
+} // namespace mbgl
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+namespace mbgl {
+namespace util {
+
+// Integer handle for an interned string. Handles are process-wide: equal
+// strings intern to equal handles on every thread, so identifiers that key
+// hot-path lookups — layer IDs keying per-frame bucket lookups — hash and
+// compare as plain integers instead of full strings. Handle 0 is never
+// issued.
+using StringID = std::uint32_t;
+
+// Returns the handle for `string`, interning it on first sight.
+StringID internString(const std::string& string);
+
+// The string a handle was issued for. The reference stays valid for the
+// lifetime of the process; interned strings are never released.
+const std::string& internedString(StringID);
+
+// One-shot cache for a lazily resolved handle. Copies start unresolved, so a
+// holder copied alongside its string member re-resolves against the copy's
+// own (possibly different) string.
+class CachedStringID {
+public:
+    CachedStringID() = default;
+    CachedStringID(const CachedStringID&) {}
+    CachedStringID& operator=(const CachedStringID&) {
+        cached.store(0, std::memory_order_relaxed);
+        return *this;
+    }
+
+    StringID get(const std::string& string) const {
+        StringID handle = cached.load(std::memory_order_relaxed);
+        if (handle == 0) {
+            handle = internString(string);
+            cached.store(handle, std::memory_order_relaxed);
+        }
+        return handle;
+    }
+
+private:
+    mutable std::atomic<StringID> cached { 0 };
+};
+
+} // namespace util
+} // namespace mbgl
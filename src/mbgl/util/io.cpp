@@ -2,15 +2,39 @@
 
 #include <cstdio>
 #include <cerrno>
-#include <iostream>
-#include <sstream>
-#include <fstream>
 
+#include <sys/stat.h>
+#include <sys/types.h>
 #include <unistd.h>
 
 namespace mbgl {
 namespace util {
 
+namespace {
+
+// Reads a whole regular file into a single exactly-sized allocation. Sizing
+// the result up front from fstat avoids the growing intermediate buffer of a
+// stream read, which transiently double-buffers large files on the heap.
+bool readFileContents(const std::string& filename, std::string& data) {
+    FILE* fd = fopen(filename.c_str(), "rb");
+    if (!fd) {
+        return false;
+    }
+
+    struct stat stats;
+    if (fstat(fileno(fd), &stats) != 0 || !S_ISREG(stats.st_mode)) {
+        fclose(fd);
+        return false;
+    }
+
+    data.resize(static_cast<std::string::size_type>(stats.st_size));
+    const bool complete = fread(&data[0], sizeof(char), data.size(), fd) == data.size();
+    fclose(fd);
+    return complete;
+}
+
+} // namespace
+
 void write_file(const std::string &filename, const std::string &data) {
     FILE *fd = fopen(filename.c_str(), "wb");
     if (fd) {
@@ -22,24 +46,19 @@ void write_file(const std::string &filename, const std::string &data) {
 }
 
 std::string read_file(const std::string &filename) {
-    std::ifstream file(filename);
-    if (file.good()) {
-        std::stringstream data;
-        data << file.rdbuf();
-        return data.str();
-    } else {
+    std::string data;
+    if (!readFileContents(filename, data)) {
         throw std::runtime_error(std::string("Cannot read file ") + filename);
     }
+    return data;
 }
 
 optional<std::string> readFile(const std::string &filename) {
-    std::ifstream file(filename);
-    if (file.good()) {
-        std::stringstream data;
-        data << file.rdbuf();
-        return data.str();
+    std::string data;
+    if (!readFileContents(filename, data)) {
+        return {};
     }
-    return {};
+    return data;
 }
 
 void deleteFile(const std::string& filename) {
@@ -0,0 +1,73 @@
+#include "itoa.hpp"
+
+#include <cstring>
+
+namespace mbgl {
+namespace util {
+
+namespace {
+
+// Two digits per division halves the number of divides compared to the
+// classic digit-at-a-time loop, and the pair lookup replaces the per-digit
+// arithmetic with a table read.
+const char digitPairs[] =
+    "00010203040506070809"
+    "10111213141516171819"
+    "20212223242526272829"
+    "30313233343536373839"
+    "40414243444546474849"
+    "50515253545556575859"
+    "60616263646566676869"
+    "70717273747576777879"
+    "80818283848586878889"
+    "90919293949596979899";
+
+} // namespace
+
+char* itoa(uint32_t value, char* buffer) {
+    // Digits are produced least-significant first into the end of a scratch
+    // buffer, then copied forward in one go.
+    char scratch[10];
+    char* pos = scratch + sizeof(scratch);
+
+    while (value >= 100) {
+        const uint32_t pair = (value % 100) * 2;
+        value /= 100;
+        *--pos = digitPairs[pair + 1];
+        *--pos = digitPairs[pair];
+    }
+
+    if (value >= 10) {
+        const uint32_t pair = value * 2;
+        *--pos = digitPairs[pair + 1];
+        *--pos = digitPairs[pair];
+    } else {
+        *--pos = static_cast<char>('0' + value);
+    }
+
+    const size_t length = scratch + sizeof(scratch) - pos;
+    std::memcpy(buffer, pos, length);
+    return buffer + length;
+}
+
+char* itoa(int32_t value, char* buffer) {
+    uint32_t unsignedValue = static_cast<uint32_t>(value);
+    if (value < 0) {
+        *buffer++ = '-';
+        unsignedValue = ~unsignedValue + 1;
+    }
+    return itoa(unsignedValue, buffer);
+}
+
+std::string itoa(uint32_t value) {
+    char buffer[11];
+    return { buffer, itoa(value, buffer) };
+}
+
+std::string itoa(int32_t value) {
+    char buffer[11];
+    return { buffer, itoa(value, buffer) };
+}
+
+} // end namespace util
+} // end namespace mbgl
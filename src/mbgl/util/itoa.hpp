@@ -0,0 +1,19 @@
+#pragma once
+
+#include <string>
+
+namespace mbgl {
+namespace util {
+
+// Fast decimal integer formatting, complementing dtoa. Writes the value's
+// decimal representation into the buffer — which must have room for 11
+// characters — and returns a pointer one past the last character written.
+// No terminating null is appended.
+char* itoa(uint32_t value, char* buffer);
+char* itoa(int32_t value, char* buffer);
+
+std::string itoa(uint32_t value);
+std::string itoa(int32_t value);
+
+} // end namespace util
+} // end namespace mbgl
@@ -24,6 +24,12 @@
 
 #include <cmath>
 
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__aarch64__)
+#include <arm_neon.h>
+#endif
+
 namespace mbgl {
 
 namespace matrix {
@@ -47,6 +53,9 @@ void identity(mat4& out) {
     out[15] = 1.0f;
 }
 
+// Kept scalar: the cofactor expansion has no clean two-lane structure — the
+// shuffles outweigh the arithmetic — and it runs once per camera change or
+// query, not per tile per frame like multiply() and transformMat4().
 bool invert(mat4& out, mat4& a) {
     double a00 = a[0], a01 = a[1], a02 = a[2], a03 = a[3],
           a10 = a[4], a11 = a[5], a12 = a[6], a13 = a[7],
@@ -304,6 +313,55 @@ void scale(mat4& out, const mat4& a, double x, double y, double z) {
 }
 
 void multiply(mat4& out, const mat4& a, const mat4& b) {
+#if defined(__SSE2__)
+    // Two lanes per register cover a row in halves. The additions keep the
+    // scalar path's association so both produce bitwise-identical results.
+    const __m128d a0l = _mm_loadu_pd(&a[0]),  a0h = _mm_loadu_pd(&a[2]);
+    const __m128d a1l = _mm_loadu_pd(&a[4]),  a1h = _mm_loadu_pd(&a[6]);
+    const __m128d a2l = _mm_loadu_pd(&a[8]),  a2h = _mm_loadu_pd(&a[10]);
+    const __m128d a3l = _mm_loadu_pd(&a[12]), a3h = _mm_loadu_pd(&a[14]);
+
+    for (int i = 0; i < 16; i += 4) {
+        const __m128d b0 = _mm_set1_pd(b[i]);
+        const __m128d b1 = _mm_set1_pd(b[i + 1]);
+        const __m128d b2 = _mm_set1_pd(b[i + 2]);
+        const __m128d b3 = _mm_set1_pd(b[i + 3]);
+        __m128d lo = _mm_mul_pd(b0, a0l);
+        __m128d hi = _mm_mul_pd(b0, a0h);
+        lo = _mm_add_pd(lo, _mm_mul_pd(b1, a1l));
+        hi = _mm_add_pd(hi, _mm_mul_pd(b1, a1h));
+        lo = _mm_add_pd(lo, _mm_mul_pd(b2, a2l));
+        hi = _mm_add_pd(hi, _mm_mul_pd(b2, a2h));
+        lo = _mm_add_pd(lo, _mm_mul_pd(b3, a3l));
+        hi = _mm_add_pd(hi, _mm_mul_pd(b3, a3h));
+        _mm_storeu_pd(&out[i], lo);
+        _mm_storeu_pd(&out[i + 2], hi);
+    }
+#elif defined(__aarch64__)
+    // Double-precision NEON is AArch64-only. Separate multiplies and adds
+    // (no fused multiply-add) match the scalar path's rounding.
+    const float64x2_t a0l = vld1q_f64(&a[0]),  a0h = vld1q_f64(&a[2]);
+    const float64x2_t a1l = vld1q_f64(&a[4]),  a1h = vld1q_f64(&a[6]);
+    const float64x2_t a2l = vld1q_f64(&a[8]),  a2h = vld1q_f64(&a[10]);
+    const float64x2_t a3l = vld1q_f64(&a[12]), a3h = vld1q_f64(&a[14]);
+
+    for (int i = 0; i < 16; i += 4) {
+        const float64x2_t b0 = vdupq_n_f64(b[i]);
+        const float64x2_t b1 = vdupq_n_f64(b[i + 1]);
+        const float64x2_t b2 = vdupq_n_f64(b[i + 2]);
+        const float64x2_t b3 = vdupq_n_f64(b[i + 3]);
+        float64x2_t lo = vmulq_f64(b0, a0l);
+        float64x2_t hi = vmulq_f64(b0, a0h);
+        lo = vaddq_f64(lo, vmulq_f64(b1, a1l));
+        hi = vaddq_f64(hi, vmulq_f64(b1, a1h));
+        lo = vaddq_f64(lo, vmulq_f64(b2, a2l));
+        hi = vaddq_f64(hi, vmulq_f64(b2, a2h));
+        lo = vaddq_f64(lo, vmulq_f64(b3, a3l));
+        hi = vaddq_f64(hi, vmulq_f64(b3, a3h));
+        vst1q_f64(&out[i], lo);
+        vst1q_f64(&out[i + 2], hi);
+    }
+#else
     double a00 = a[0], a01 = a[1], a02 = a[2], a03 = a[3],
           a10 = a[4], a11 = a[5], a12 = a[6], a13 = a[7],
           a20 = a[8], a21 = a[9], a22 = a[10], a23 = a[11],
@@ -333,13 +391,52 @@ void multiply(mat4& out, const mat4& a, const mat4& b) {
     out[13] = b0 * a01 + b1 * a11 + b2 * a21 + b3 * a31;
     out[14] = b0 * a02 + b1 * a12 + b2 * a22 + b3 * a32;
     out[15] = b0 * a03 + b1 * a13 + b2 * a23 + b3 * a33;
+#endif
 }
 
 void transformMat4(vec4& out, const vec4& a, const mat4& m) {
-    out[0] = m[0] * a[0] + m[4] * a[1] + m[8] * a[2] + m[12] * a[3];
-    out[1] = m[1] * a[0] + m[5] * a[1] + m[9] * a[2] + m[13] * a[3];
-    out[2] = m[2] * a[0] + m[6] * a[1] + m[10] * a[2] + m[14] * a[3];
-    out[3] = m[3] * a[0] + m[7] * a[1] + m[11] * a[2] + m[15] * a[3];
+#if defined(__SSE2__)
+    // Same column-broadcast scheme as multiply() above, for a single vector.
+    // The components are broadcast before anything is stored, so `out` may
+    // alias `a`, as it does in the per-point projection paths.
+    const __m128d x = _mm_set1_pd(a[0]);
+    const __m128d y = _mm_set1_pd(a[1]);
+    const __m128d z = _mm_set1_pd(a[2]);
+    const __m128d w = _mm_set1_pd(a[3]);
+
+    __m128d lo = _mm_mul_pd(x, _mm_loadu_pd(&m[0]));
+    __m128d hi = _mm_mul_pd(x, _mm_loadu_pd(&m[2]));
+    lo = _mm_add_pd(lo, _mm_mul_pd(y, _mm_loadu_pd(&m[4])));
+    hi = _mm_add_pd(hi, _mm_mul_pd(y, _mm_loadu_pd(&m[6])));
+    lo = _mm_add_pd(lo, _mm_mul_pd(z, _mm_loadu_pd(&m[8])));
+    hi = _mm_add_pd(hi, _mm_mul_pd(z, _mm_loadu_pd(&m[10])));
+    lo = _mm_add_pd(lo, _mm_mul_pd(w, _mm_loadu_pd(&m[12])));
+    hi = _mm_add_pd(hi, _mm_mul_pd(w, _mm_loadu_pd(&m[14])));
+    _mm_storeu_pd(&out[0], lo);
+    _mm_storeu_pd(&out[2], hi);
+#elif defined(__aarch64__)
+    const float64x2_t x = vdupq_n_f64(a[0]);
+    const float64x2_t y = vdupq_n_f64(a[1]);
+    const float64x2_t z = vdupq_n_f64(a[2]);
+    const float64x2_t w = vdupq_n_f64(a[3]);
+
+    float64x2_t lo = vmulq_f64(x, vld1q_f64(&m[0]));
+    float64x2_t hi = vmulq_f64(x, vld1q_f64(&m[2]));
+    lo = vaddq_f64(lo, vmulq_f64(y, vld1q_f64(&m[4])));
+    hi = vaddq_f64(hi, vmulq_f64(y, vld1q_f64(&m[6])));
+    lo = vaddq_f64(lo, vmulq_f64(z, vld1q_f64(&m[8])));
+    hi = vaddq_f64(hi, vmulq_f64(z, vld1q_f64(&m[10])));
+    lo = vaddq_f64(lo, vmulq_f64(w, vld1q_f64(&m[12])));
+    hi = vaddq_f64(hi, vmulq_f64(w, vld1q_f64(&m[14])));
+    vst1q_f64(&out[0], lo);
+    vst1q_f64(&out[2], hi);
+#else
+    const double x = a[0], y = a[1], z = a[2], w = a[3];
+    out[0] = m[0] * x + m[4] * y + m[8] * z + m[12] * w;
+    out[1] = m[1] * x + m[5] * y + m[9] * z + m[13] * w;
+    out[2] = m[2] * x + m[6] * y + m[10] * z + m[14] * w;
+    out[3] = m[3] * x + m[7] * y + m[11] * z + m[15] * w;
+#endif
 }
 
 } // namespace matrix
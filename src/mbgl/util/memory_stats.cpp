@@ -0,0 +1,60 @@
+#include <mbgl/util/memory_stats.hpp>
+
+#include <atomic>
+
+namespace mbgl {
+namespace util {
+
+namespace {
+
+struct Counter {
+    std::atomic<uint64_t> current { 0 };
+    std::atomic<uint64_t> peak { 0 };
+
+    void raisePeak(uint64_t value) {
+        uint64_t previous = peak.load();
+        while (previous < value && !peak.compare_exchange_weak(previous, value)) {
+        }
+    }
+};
+
+std::array<Counter, MemoryStats::categoryCount> counters;
+
+Counter& counterFor(MemoryCategory category) {
+    return counters[static_cast<std::size_t>(category)];
+}
+
+} // namespace
+
+void recordMemoryAllocation(MemoryCategory category, std::size_t bytes) {
+    Counter& counter = counterFor(category);
+    counter.raisePeak(counter.current += bytes);
+}
+
+void recordMemoryDeallocation(MemoryCategory category, std::size_t bytes) {
+    counterFor(category).current -= bytes;
+}
+
+void setMemoryUsage(MemoryCategory category, std::size_t bytes) {
+    Counter& counter = counterFor(category);
+    counter.current = bytes;
+    counter.raisePeak(bytes);
+}
+
+MemoryStats getMemoryStats() {
+    MemoryStats stats;
+    for (std::size_t i = 0; i < MemoryStats::categoryCount; i++) {
+        stats.currentBytes[i] = counters[i].current.load();
+        stats.peakBytes[i] = counters[i].peak.load();
+    }
+    return stats;
+}
+
+void resetMemoryPeaks() {
+    for (auto& counter : counters) {
+        counter.peak = counter.current.load();
+    }
+}
+
+} // namespace util
+} // namespace mbgl
@@ -0,0 +1,35 @@
+#include <mbgl/util/performance_counters.hpp>
+
+#include <atomic>
+
+namespace mbgl {
+namespace util {
+
+namespace {
+
+std::atomic<uint64_t> queueDepth { 0 };
+std::array<std::atomic<uint64_t>, PerformanceCounters::cacheKindCount> hits {};
+std::array<std::atomic<uint64_t>, PerformanceCounters::cacheKindCount> misses {};
+
+} // namespace
+
+void setWorkerQueueDepth(std::size_t depth) {
+    queueDepth = depth;
+}
+
+void recordCacheLookup(CacheKind kind, bool hit) {
+    (hit ? hits : misses)[static_cast<std::size_t>(kind)]++;
+}
+
+PerformanceCounters getPerformanceCounters() {
+    PerformanceCounters counters;
+    counters.workerQueueDepth = queueDepth.load();
+    for (std::size_t i = 0; i < PerformanceCounters::cacheKindCount; i++) {
+        counters.cacheHits[i] = hits[i].load();
+        counters.cacheMisses[i] = misses[i].load();
+    }
+    return counters;
+}
+
+} // namespace util
+} // namespace mbgl
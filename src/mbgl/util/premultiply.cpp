@@ -2,6 +2,12 @@
 
 #include <cmath>
 
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__aarch64__)
+#include <arm_neon.h>
+#endif
+
 namespace mbgl {
 namespace util {
 
@@ -12,7 +18,61 @@ PremultipliedImage premultiply(UnassociatedImage&& src) {
     dst.data = std::move(src.data);
 
     uint8_t* data = dst.data.get();
-    for (size_t i = 0; i < dst.bytes(); i += 4) {
+    const size_t bytes = dst.bytes();
+    size_t i = 0;
+
+    // Both vector paths compute (x * a + 127) / 255 in 16-bit lanes using the
+    // identity v / 255 == (v + 1 + (v >> 8)) >> 8, which is exact for
+    // v <= 65152 (= 255 * 255 + 127), so they match the scalar loop bitwise.
+    // Any remainder falls through to the scalar loop below.
+#if defined(__SSE2__)
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i bias = _mm_set1_epi16(127);
+    const __m128i one = _mm_set1_epi16(1);
+    // Keeps the r, g, b lanes of a widened pixel pair; zero in the alpha lanes.
+    const __m128i rgbMask = _mm_set_epi16(0, -1, -1, -1, 0, -1, -1, -1);
+
+    for (; i + 16 <= bytes; i += 16) {
+        const __m128i px = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        const __m128i lo = _mm_unpacklo_epi8(px, zero);
+        const __m128i hi = _mm_unpackhi_epi8(px, zero);
+
+        const __m128i alphaLo =
+            _mm_shufflehi_epi16(_mm_shufflelo_epi16(lo, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3));
+        const __m128i alphaHi =
+            _mm_shufflehi_epi16(_mm_shufflelo_epi16(hi, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3));
+
+        __m128i mulLo = _mm_add_epi16(_mm_mullo_epi16(lo, alphaLo), bias);
+        __m128i mulHi = _mm_add_epi16(_mm_mullo_epi16(hi, alphaHi), bias);
+
+        mulLo = _mm_srli_epi16(_mm_add_epi16(_mm_add_epi16(mulLo, one), _mm_srli_epi16(mulLo, 8)), 8);
+        mulHi = _mm_srli_epi16(_mm_add_epi16(_mm_add_epi16(mulHi, one), _mm_srli_epi16(mulHi, 8)), 8);
+
+        // Take r, g, b from the product and the untouched alpha from the source.
+        const __m128i outLo = _mm_or_si128(_mm_and_si128(mulLo, rgbMask), _mm_andnot_si128(rgbMask, lo));
+        const __m128i outHi = _mm_or_si128(_mm_and_si128(mulHi, rgbMask), _mm_andnot_si128(rgbMask, hi));
+
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(data + i), _mm_packus_epi16(outLo, outHi));
+    }
+#elif defined(__aarch64__)
+    const uint16x8_t bias = vdupq_n_u16(127);
+    const uint16x8_t one = vdupq_n_u16(1);
+
+    for (; i + 32 <= bytes; i += 32) {
+        uint8x8x4_t px = vld4_u8(data + i);
+        const uint8x8_t a = px.val[3];
+
+        for (int channel = 0; channel < 3; channel++) {
+            uint16x8_t v = vaddq_u16(vmull_u8(px.val[channel], a), bias);
+            v = vsraq_n_u16(vaddq_u16(v, one), v, 8);
+            px.val[channel] = vshrn_n_u16(v, 8);
+        }
+
+        vst4_u8(data + i, px);
+    }
+#endif
+
+    for (; i < bytes; i += 4) {
         uint8_t& r = data[i + 0];
         uint8_t& g = data[i + 1];
         uint8_t& b = data[i + 2];
@@ -37,7 +97,9 @@ UnassociatedImage unpremultiply(PremultipliedImage&& src) {
         uint8_t& g = data[i + 1];
         uint8_t& b = data[i + 2];
         uint8_t& a = data[i + 3];
-        if (a) {
+        // Fully opaque and fully transparent pixels — the bulk of most
+        // images — divide to themselves.
+        if (a && a != 255) {
             r = (255 * r + (a / 2)) / a;
             g = (255 * g + (a / 2)) / a;
             b = (255 * b + (a / 2)) / a;
@@ -0,0 +1,106 @@
+#pragma once
+
+#include <mbgl/util/performance_counters.hpp>
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace mbgl {
+namespace util {
+
+/*
+ * Process-wide memo of parse results, shared by every map view in the
+ * process. An application showing several simultaneous views of the same
+ * style downloads each glyph range and sprite sheet once (the file source's
+ * caches see to that), but without this cache every view would still decode
+ * the response again for itself.
+ *
+ * Entries are keyed by the resource URL and validated against the identity
+ * of the response buffer(s) they were parsed from: the file source hands the
+ * same std::shared_ptr<const std::string> to every consumer of a cached
+ * response, so pointer equality proves the bytes are unchanged. A refreshed
+ * or revalidated resource arrives in a new buffer and simply misses, which
+ * makes staleness impossible by construction — no TTL or ETag bookkeeping.
+ *
+ * Thread-safe; results are returned as shared_ptr-to-const and may be read
+ * from any thread.
+ */
+template <class T>
+class SharedParseCache {
+public:
+    using Source = std::shared_ptr<const std::string>;
+
+    explicit SharedParseCache(std::size_t capacity_ = 64)
+        : capacity(capacity_) {
+    }
+
+    /*
+     * Return the cached parse for `key` if it was produced from exactly the
+     * given response buffers, or nullptr.
+     */
+    std::shared_ptr<const T> get(const std::string& key, std::initializer_list<Source> sources) {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = entries.find(key);
+        if (it == entries.end() || !matches(it->second, sources)) {
+            recordCacheLookup(CacheKind::ParseCache, false);
+            return nullptr;
+        }
+        recordCacheLookup(CacheKind::ParseCache, true);
+        it->second.used = ++counter;
+        return it->second.parsed;
+    }
+
+    void put(const std::string& key, std::initializer_list<Source> sources, std::shared_ptr<const T> parsed) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (entries.find(key) == entries.end() && entries.size() >= capacity) {
+            evict();
+        }
+        Entry& entry = entries[key];
+        entry.sources.assign(sources.begin(), sources.end());
+        entry.parsed = std::move(parsed);
+        entry.used = ++counter;
+    }
+
+private:
+    struct Entry {
+        // Held weakly so the cache never pins response buffers; an expired
+        // source can no longer be matched, which is exactly right.
+        std::vector<std::weak_ptr<const std::string>> sources;
+        std::shared_ptr<const T> parsed;
+        uint64_t used = 0;
+    };
+
+    static bool matches(const Entry& entry, const std::initializer_list<Source>& sources) {
+        if (entry.sources.size() != sources.size()) {
+            return false;
+        }
+        auto it = sources.begin();
+        for (const auto& source : entry.sources) {
+            if (source.lock() != *it++) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    void evict() {
+        auto oldest = entries.begin();
+        for (auto it = entries.begin(); it != entries.end(); ++it) {
+            if (it->second.used < oldest->second.used) {
+                oldest = it;
+            }
+        }
+        entries.erase(oldest);
+    }
+
+    const std::size_t capacity;
+    uint64_t counter = 0;
+    std::unordered_map<std::string, Entry> entries;
+    std::mutex mutex;
+};
+
+} // namespace util
+} // namespace mbgl
@@ -0,0 +1,361 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace mbgl {
+namespace util {
+
+// std::vector lookalike that stores up to N elements inline before touching
+// the heap. Intended for containers that are created in large numbers and
+// almost always tiny — e.g. the one or two coordinates of a point feature —
+// where the per-container heap allocation, not the element work, dominates.
+// Unlike std::vector, moving a SmallVector whose contents are inline moves
+// the elements, so iterators and element pointers do not survive a move.
+template <typename T, std::size_t N>
+class SmallVector {
+    static_assert(N > 0, "inline capacity must be positive");
+
+public:
+    using value_type = T;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using reference = T&;
+    using const_reference = const T&;
+    using pointer = T*;
+    using const_pointer = const T*;
+    using iterator = T*;
+    using const_iterator = const T*;
+    using reverse_iterator = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+    SmallVector() = default;
+
+    explicit SmallVector(size_type count) {
+        resize(count);
+    }
+
+    SmallVector(size_type count, const T& value) {
+        reserve(count);
+        for (size_type i = 0; i < count; ++i) {
+            new (data_ + size_) T(value);
+            ++size_;
+        }
+    }
+
+    template <typename InputIt,
+              typename = typename std::enable_if<std::is_convertible<
+                  typename std::iterator_traits<InputIt>::iterator_category,
+                  std::input_iterator_tag>::value>::type>
+    SmallVector(InputIt first, InputIt last) {
+        append(first, last);
+    }
+
+    SmallVector(std::initializer_list<T> init) {
+        append(init.begin(), init.end());
+    }
+
+    SmallVector(const SmallVector& other) {
+        append(other.begin(), other.end());
+    }
+
+    SmallVector(SmallVector&& other) noexcept(std::is_nothrow_move_constructible<T>::value) {
+        takeFrom(std::move(other));
+    }
+
+    SmallVector& operator=(const SmallVector& other) {
+        if (this != &other) {
+            clear();
+            append(other.begin(), other.end());
+        }
+        return *this;
+    }
+
+    SmallVector& operator=(SmallVector&& other) noexcept(std::is_nothrow_move_constructible<T>::value) {
+        if (this != &other) {
+            deallocate();
+            takeFrom(std::move(other));
+        }
+        return *this;
+    }
+
+    SmallVector& operator=(std::initializer_list<T> init) {
+        clear();
+        append(init.begin(), init.end());
+        return *this;
+    }
+
+    ~SmallVector() {
+        deallocate();
+    }
+
+    reference at(size_type i) {
+        if (i >= size_) throw std::out_of_range("SmallVector::at");
+        return data_[i];
+    }
+    const_reference at(size_type i) const {
+        if (i >= size_) throw std::out_of_range("SmallVector::at");
+        return data_[i];
+    }
+
+    reference operator[](size_type i) { assert(i < size_); return data_[i]; }
+    const_reference operator[](size_type i) const { assert(i < size_); return data_[i]; }
+
+    reference front() { assert(size_); return data_[0]; }
+    const_reference front() const { assert(size_); return data_[0]; }
+    reference back() { assert(size_); return data_[size_ - 1]; }
+    const_reference back() const { assert(size_); return data_[size_ - 1]; }
+
+    pointer data() { return data_; }
+    const_pointer data() const { return data_; }
+
+    iterator begin() { return data_; }
+    const_iterator begin() const { return data_; }
+    const_iterator cbegin() const { return data_; }
+    iterator end() { return data_ + size_; }
+    const_iterator end() const { return data_ + size_; }
+    const_iterator cend() const { return data_ + size_; }
+
+    reverse_iterator rbegin() { return reverse_iterator(end()); }
+    const_reverse_iterator rbegin() const { return const_reverse_iterator(end()); }
+    reverse_iterator rend() { return reverse_iterator(begin()); }
+    const_reverse_iterator rend() const { return const_reverse_iterator(begin()); }
+
+    bool empty() const { return size_ == 0; }
+    size_type size() const { return size_; }
+    size_type capacity() const { return capacity_; }
+    size_type max_size() const { return std::numeric_limits<size_type>::max() / sizeof(T); }
+
+    void reserve(size_type newCapacity) {
+        if (newCapacity > capacity_) {
+            grow(newCapacity);
+        }
+    }
+
+    void clear() {
+        destroy(0);
+    }
+
+    template <typename... Args>
+    reference emplace_back(Args&&... args) {
+        if (size_ == capacity_) {
+            return growAndEmplaceBack(std::forward<Args>(args)...);
+        }
+        new (data_ + size_) T(std::forward<Args>(args)...);
+        return data_[size_++];
+    }
+
+    void push_back(const T& value) { emplace_back(value); }
+    void push_back(T&& value) { emplace_back(std::move(value)); }
+
+    void pop_back() {
+        assert(size_);
+        data_[--size_].~T();
+    }
+
+    void resize(size_type count) {
+        if (count < size_) {
+            destroy(count);
+        } else {
+            reserve(count);
+            while (size_ < count) {
+                new (data_ + size_) T();
+                ++size_;
+            }
+        }
+    }
+
+    void resize(size_type count, const T& value) {
+        if (count < size_) {
+            destroy(count);
+        } else {
+            reserve(count);
+            while (size_ < count) {
+                new (data_ + size_) T(value);
+                ++size_;
+            }
+        }
+    }
+
+    iterator insert(const_iterator pos, const T& value) {
+        const T* addr = std::addressof(value);
+        return insert(pos, addr, addr + 1);
+    }
+
+    iterator insert(const_iterator pos, T&& value) {
+        const size_type index = pos - data_;
+        if (pos == end()) {
+            emplace_back(std::move(value));
+            return data_ + index;
+        }
+        T* addr = std::addressof(value);
+        return insert(pos, std::make_move_iterator(addr), std::make_move_iterator(addr + 1));
+    }
+
+    // Inserting a range of the vector into itself is not supported, matching
+    // std::vector.
+    template <typename InputIt,
+              typename = typename std::enable_if<std::is_convertible<
+                  typename std::iterator_traits<InputIt>::iterator_category,
+                  std::input_iterator_tag>::value>::type>
+    iterator insert(const_iterator pos, InputIt first, InputIt last) {
+        const size_type index = pos - data_;
+        assert(index <= size_);
+        if (pos == end()) {
+            append(first, last);
+            return data_ + index;
+        }
+        SmallVector rebuilt;
+        rebuilt.reserve(size_);
+        rebuilt.append(std::make_move_iterator(data_), std::make_move_iterator(data_ + index));
+        rebuilt.append(first, last);
+        rebuilt.append(std::make_move_iterator(data_ + index), std::make_move_iterator(data_ + size_));
+        *this = std::move(rebuilt);
+        return data_ + index;
+    }
+
+    iterator erase(const_iterator pos) {
+        return erase(pos, pos + 1);
+    }
+
+    iterator erase(const_iterator first, const_iterator last) {
+        const size_type index = first - data_;
+        const size_type count = last - first;
+        assert(index + count <= size_);
+        if (count == 0) {
+            return data_ + index;
+        }
+        std::move(data_ + index + count, data_ + size_, data_ + index);
+        destroy(size_ - count);
+        return data_ + index;
+    }
+
+    void swap(SmallVector& other) {
+        if (usingHeap() && other.usingHeap()) {
+            std::swap(data_, other.data_);
+            std::swap(size_, other.size_);
+            std::swap(capacity_, other.capacity_);
+        } else {
+            SmallVector tmp(std::move(*this));
+            *this = std::move(other);
+            other = std::move(tmp);
+        }
+    }
+
+private:
+    T* inlineData() { return reinterpret_cast<T*>(&inlineStorage); }
+    bool usingHeap() const { return capacity_ > N; }
+
+    // Destroys all elements past newSize.
+    void destroy(size_type newSize) {
+        while (size_ > newSize) {
+            data_[--size_].~T();
+        }
+    }
+
+    // Destroys all elements and returns any heap buffer, leaving the vector
+    // in a moved-from state.
+    void deallocate() {
+        destroy(0);
+        if (usingHeap()) {
+            ::operator delete(data_);
+            data_ = inlineData();
+            capacity_ = N;
+        }
+    }
+
+    void takeFrom(SmallVector&& other) {
+        if (other.usingHeap()) {
+            data_ = other.data_;
+            size_ = other.size_;
+            capacity_ = other.capacity_;
+            other.data_ = other.inlineData();
+            other.size_ = 0;
+            other.capacity_ = N;
+        } else {
+            for (size_type i = 0; i < other.size_; ++i) {
+                new (data_ + i) T(std::move(other.data_[i]));
+            }
+            size_ = other.size_;
+            other.destroy(0);
+        }
+    }
+
+    template <typename InputIt>
+    void append(InputIt first, InputIt last) {
+        for (; first != last; ++first) {
+            emplace_back(*first);
+        }
+    }
+
+    void grow(size_type minimumCapacity) {
+        size_type newCapacity = std::max(capacity_ * 2, minimumCapacity);
+        T* newData = static_cast<T*>(::operator new(newCapacity * sizeof(T)));
+        for (size_type i = 0; i < size_; ++i) {
+            new (newData + i) T(std::move(data_[i]));
+            data_[i].~T();
+        }
+        if (usingHeap()) {
+            ::operator delete(data_);
+        }
+        data_ = newData;
+        capacity_ = newCapacity;
+    }
+
+    // Out-of-line growth path for emplace_back. The new element is
+    // constructed before the old ones move, so emplacing an element of the
+    // vector itself stays valid, as it does for std::vector.
+    template <typename... Args>
+    reference growAndEmplaceBack(Args&&... args) {
+        size_type newCapacity = capacity_ * 2;
+        T* newData = static_cast<T*>(::operator new(newCapacity * sizeof(T)));
+        new (newData + size_) T(std::forward<Args>(args)...);
+        for (size_type i = 0; i < size_; ++i) {
+            new (newData + i) T(std::move(data_[i]));
+            data_[i].~T();
+        }
+        if (usingHeap()) {
+            ::operator delete(data_);
+        }
+        data_ = newData;
+        capacity_ = newCapacity;
+        return data_[size_++];
+    }
+
+    typename std::aligned_storage<sizeof(T) * N, alignof(T)>::type inlineStorage;
+    T* data_ = inlineData();
+    size_type size_ = 0;
+    size_type capacity_ = N;
+};
+
+template <typename T, std::size_t N1, std::size_t N2>
+bool operator==(const SmallVector<T, N1>& a, const SmallVector<T, N2>& b) {
+    return a.size() == b.size() && std::equal(a.begin(), a.end(), b.begin());
+}
+
+template <typename T, std::size_t N1, std::size_t N2>
+bool operator!=(const SmallVector<T, N1>& a, const SmallVector<T, N2>& b) {
+    return !(a == b);
+}
+
+template <typename T, std::size_t N1, std::size_t N2>
+bool operator<(const SmallVector<T, N1>& a, const SmallVector<T, N2>& b) {
+    return std::lexicographical_compare(a.begin(), a.end(), b.begin(), b.end());
+}
+
+template <typename T, std::size_t N>
+void swap(SmallVector<T, N>& a, SmallVector<T, N>& b) {
+    a.swap(b);
+}
+
+} // namespace util
+} // namespace mbgl
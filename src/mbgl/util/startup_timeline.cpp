@@ -0,0 +1,40 @@
+#include <mbgl/util/startup_timeline.hpp>
+
+#include <mutex>
+
+namespace mbgl {
+namespace util {
+
+namespace {
+
+std::mutex mutex;
+StartupTimeline timeline;
+TimePoint epoch = Clock::now();
+
+} // namespace
+
+void markStartupMilestone(StartupMilestone milestone) {
+    const TimePoint now = Clock::now();
+    const std::size_t index = static_cast<std::size_t>(milestone);
+
+    std::lock_guard<std::mutex> lock(mutex);
+    if (timeline.recorded[index]) {
+        return;
+    }
+    timeline.recorded[index] = true;
+    timeline.sinceEpoch[index] = now - epoch;
+}
+
+StartupTimeline getStartupTimeline() {
+    std::lock_guard<std::mutex> lock(mutex);
+    return timeline;
+}
+
+void resetStartupTimeline() {
+    std::lock_guard<std::mutex> lock(mutex);
+    timeline = StartupTimeline();
+    epoch = Clock::now();
+}
+
+} // namespace util
+} // namespace mbgl
@@ -130,6 +130,9 @@ Thread<Object>::Thread(const ThreadContext& context, Args&&... args) {
 
         if (context.priority == ThreadPriority::Low) {
             platform::makeThreadLowPriority();
+            // Low priority threads do background I/O (file sources, SQLite);
+            // keep them off the performance cores on big.LITTLE parts.
+            platform::bindThreadToEfficiencyCores();
         }
 
         run(std::move(params), std::index_sequence_for<Args...>{});
@@ -3,7 +3,11 @@
 #include <mbgl/util/interpolate.hpp>
 #include <mbgl/map/transform_state.hpp>
 
+#include <array>
+#include <cmath>
 #include <functional>
+#include <list>
+#include <mutex>
 
 namespace mbgl {
 
@@ -124,6 +128,66 @@ std::vector<UnwrappedTileID> tileCover(const Point<double>& tl,
     return result;
 }
 
+// The viewport cover is recomputed for every source on every updateTiles
+// call — every frame during an animation — although the result only changes
+// when a corner of the viewport moves by a meaningful fraction of a tile.
+// Recent covers are therefore memoized, keyed by the corner projections
+// quantized to 1/64th of a tile; camera motion below that threshold reuses
+// the previous cover. The cover is computed from the quantized corners, so
+// the result is a pure function of the key, at the cost of a tile on the
+// outermost viewport sliver appearing up to 1/64th of a tile late. A handful
+// of entries suffices since sources only differ by tile zoom within a frame.
+class TileCoverCache {
+public:
+    static constexpr double quantum = 64.0;
+    static constexpr std::size_t maximumEntries = 8;
+
+    using Key = std::array<int64_t, 11>;
+
+    static Key key(const std::array<Point<double>, 5>& points, int32_t z) {
+        Key k;
+        k[0] = z;
+        for (std::size_t i = 0; i < points.size(); i++) {
+            k[1 + 2 * i] = std::llround(points[i].x * quantum);
+            k[2 + 2 * i] = std::llround(points[i].y * quantum);
+        }
+        return k;
+    }
+
+    static Point<double> quantized(const Key& k, std::size_t i) {
+        return { k[1 + 2 * i] / quantum, k[2 + 2 * i] / quantum };
+    }
+
+    bool get(const Key& k, std::vector<UnwrappedTileID>& result) {
+        std::lock_guard<std::mutex> lock(mutex);
+        for (auto it = entries.begin(); it != entries.end(); ++it) {
+            if (it->first == k) {
+                entries.splice(entries.begin(), entries, it);
+                result = it->second;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void put(const Key& k, std::vector<UnwrappedTileID> cover) {
+        std::lock_guard<std::mutex> lock(mutex);
+        entries.emplace_front(k, std::move(cover));
+        if (entries.size() > maximumEntries) {
+            entries.pop_back();
+        }
+    }
+
+private:
+    std::mutex mutex;
+    std::list<std::pair<Key, std::vector<UnwrappedTileID>>> entries;
+};
+
+TileCoverCache& tileCoverCache() {
+    static TileCoverCache cache;
+    return cache;
+}
+
 } // namespace
 
 int32_t coveringZoomLevel(double zoom, SourceType type, uint16_t size) {
@@ -160,13 +224,29 @@ std::vector<UnwrappedTileID> tileCover(const TransformState& state, int32_t z) {
 
     const double w = state.getSize().width;
     const double h = state.getSize().height;
-    return tileCover(
+    const std::array<Point<double>, 5> corners {{
         TileCoordinate::fromScreenCoordinate(state, z, { 0,   0   }).p,
         TileCoordinate::fromScreenCoordinate(state, z, { w,   0   }).p,
         TileCoordinate::fromScreenCoordinate(state, z, { w,   h   }).p,
         TileCoordinate::fromScreenCoordinate(state, z, { 0,   h   }).p,
         TileCoordinate::fromScreenCoordinate(state, z, { w/2, h/2 }).p,
+    }};
+
+    const TileCoverCache::Key key = TileCoverCache::key(corners, z);
+    std::vector<UnwrappedTileID> result;
+    if (tileCoverCache().get(key, result)) {
+        return result;
+    }
+
+    result = tileCover(
+        TileCoverCache::quantized(key, 0),
+        TileCoverCache::quantized(key, 1),
+        TileCoverCache::quantized(key, 2),
+        TileCoverCache::quantized(key, 3),
+        TileCoverCache::quantized(key, 4),
         z);
+    tileCoverCache().put(key, result);
+    return result;
 }
 
 } // namespace util
@@ -0,0 +1,44 @@
+#include <mbgl/util/tile_latency.hpp>
+
+#include <algorithm>
+#include <mutex>
+
+namespace mbgl {
+namespace util {
+
+namespace {
+
+std::mutex statsMutex;
+TileLatencyStats stats;
+
+} // namespace
+
+void recordTileStageLatency(TileStage stage, Duration elapsed) {
+    const auto count = std::chrono::duration_cast<Milliseconds>(elapsed).count();
+    const uint64_t ms = count > 0 ? static_cast<uint64_t>(count) : 0;
+
+    std::size_t bucket = 0;
+    while (bucket + 1 < TileStageHistogram::bucketCount && (1ull << bucket) <= ms) {
+        bucket++;
+    }
+
+    std::lock_guard<std::mutex> lock(statsMutex);
+    TileStageHistogram& histogram = stats.stages[static_cast<std::size_t>(stage)];
+    histogram.counts[bucket]++;
+    histogram.samples++;
+    histogram.totalMilliseconds += ms;
+    histogram.maxMilliseconds = std::max(histogram.maxMilliseconds, ms);
+}
+
+TileLatencyStats getTileLatencyStats() {
+    std::lock_guard<std::mutex> lock(statsMutex);
+    return stats;
+}
+
+void resetTileLatencyStats() {
+    std::lock_guard<std::mutex> lock(statsMutex);
+    stats = TileLatencyStats();
+}
+
+} // namespace util
+} // namespace mbgl
@@ -2,6 +2,7 @@
 
 #include <map>
 #include <string>
+#include <vector>
 #include <algorithm>
 
 namespace mbgl {
@@ -37,5 +38,78 @@ std::string replaceTokens(const std::string &source, const Lookup &lookup) {
     return result;
 }
 
+// Compiled form of a {token} template. The template string is parsed into a
+// list of literal spans and token names once, so repeated substitution — once
+// per feature during symbol layout — is a gather-and-concat instead of a
+// re-parse. The grammar matches replaceTokens: an unterminated or nested
+// brace is literal text.
+class TokenTemplate {
+public:
+    TokenTemplate(const std::string& source) {
+        auto pos = source.begin();
+        const auto end = source.end();
+
+        while (pos != end) {
+            auto brace = std::find(pos, end, '{');
+            appendLiteral(pos, brace);
+            pos = brace;
+            if (pos != end) {
+                for (brace++; brace != end && tokenReservedChars.find(*brace) == std::string::npos; brace++);
+                if (brace != end && *brace == '}') {
+                    segments.push_back({ { pos + 1, brace }, true });
+                    pos = brace + 1;
+                } else {
+                    appendLiteral(pos, brace);
+                    pos = brace;
+                }
+            }
+        }
+
+        for (const auto& segment : segments) {
+            literalSize += segment.isToken ? 0 : segment.text.size();
+        }
+    }
+
+    bool hasTokens() const {
+        return std::any_of(segments.begin(), segments.end(),
+                           [](const Segment& segment) { return segment.isToken; });
+    }
+
+    template <typename Lookup>
+    std::string apply(const Lookup& lookup) const {
+        std::string result;
+        result.reserve(literalSize);
+        for (const auto& segment : segments) {
+            if (segment.isToken) {
+                result.append(lookup(segment.text));
+            } else {
+                result.append(segment.text);
+            }
+        }
+        return result;
+    }
+
+private:
+    struct Segment {
+        std::string text;
+        bool isToken;
+    };
+
+    template <typename Iterator>
+    void appendLiteral(Iterator begin, Iterator end) {
+        if (begin == end) {
+            return;
+        }
+        if (!segments.empty() && !segments.back().isToken) {
+            segments.back().text.append(begin, end);
+        } else {
+            segments.push_back({ { begin, end }, false });
+        }
+    }
+
+    std::vector<Segment> segments;
+    std::size_t literalSize = 0;
+};
+
 } // end namespace util
 } // end namespace mbgl
@@ -0,0 +1,164 @@
+#include <mbgl/util/trace.hpp>
+#include <mbgl/util/platform.hpp>
+
+#include <atomic>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <vector>
+
+namespace mbgl {
+namespace util {
+
+namespace {
+
+struct TraceEvent {
+    const char* name;
+    int64_t startMicroseconds;
+    int64_t durationMicroseconds;
+    uint64_t correlationID;
+    char detail[32];
+};
+
+// One buffer per thread, written only by its owner. The slot array is
+// allocated at full capacity up front so slots never move; the owner fills a
+// slot and then publishes it with a release store of the new count, which
+// the serializer pairs with an acquire load. When the buffer fills up,
+// further events are counted as dropped rather than wrapping, so a capture
+// never contains partially overwritten slots.
+struct ThreadBuffer {
+    static constexpr std::size_t capacity = 1 << 16;
+
+    explicit ThreadBuffer(std::string threadName_)
+        : threadName(std::move(threadName_)), events(capacity) {
+    }
+
+    const std::string threadName;
+    std::vector<TraceEvent> events;
+    std::atomic<std::size_t> count { 0 };
+    std::atomic<std::size_t> dropped { 0 };
+};
+
+std::atomic<bool> tracing { false };
+
+// The registry keeps buffers of exited threads alive so their events still
+// appear in the capture. It is locked only when a thread records its first
+// event and when a capture starts or stops — never on the append path.
+std::mutex registryMutex;
+std::vector<std::shared_ptr<ThreadBuffer>>& registry() {
+    static std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+    return buffers;
+}
+
+ThreadBuffer& localBuffer() {
+    thread_local std::shared_ptr<ThreadBuffer> buffer = [] {
+        auto created = std::make_shared<ThreadBuffer>(platform::getCurrentThreadName());
+        std::lock_guard<std::mutex> lock(registryMutex);
+        registry().push_back(created);
+        return created;
+    }();
+    return *buffer;
+}
+
+int64_t toMicroseconds(TimePoint time) {
+    return std::chrono::duration_cast<std::chrono::microseconds>(time.time_since_epoch()).count();
+}
+
+} // namespace
+
+void startTracing() {
+    // Resetting a count while its owner finishes an append that raced the
+    // previous stopTracing() can resurrect up to one already-written event
+    // into the new capture; the slots below the published count are always
+    // fully written, so the capture stays well-formed.
+    std::lock_guard<std::mutex> lock(registryMutex);
+    for (const auto& buffer : registry()) {
+        buffer->count = 0;
+        buffer->dropped = 0;
+    }
+    tracing = true;
+}
+
+bool isTracing() {
+    return tracing.load(std::memory_order_relaxed);
+}
+
+void recordTraceEvent(const char* name, TimePoint start, TimePoint end,
+                      uint64_t correlationID, const char* detail) {
+    if (!isTracing()) {
+        return;
+    }
+
+    ThreadBuffer& buffer = localBuffer();
+    const std::size_t index = buffer.count.load(std::memory_order_relaxed);
+    if (index >= ThreadBuffer::capacity) {
+        buffer.dropped++;
+        return;
+    }
+
+    TraceEvent& event = buffer.events[index];
+    event.name = name;
+    event.startMicroseconds = toMicroseconds(start);
+    event.durationMicroseconds = toMicroseconds(end) - event.startMicroseconds;
+    event.correlationID = correlationID;
+    event.detail[0] = '\0';
+    if (detail) {
+        std::strncpy(event.detail, detail, sizeof(event.detail) - 1);
+        event.detail[sizeof(event.detail) - 1] = '\0';
+    }
+
+    buffer.count.store(index + 1, std::memory_order_release);
+}
+
+std::string stopTracing() {
+    tracing = false;
+
+    std::lock_guard<std::mutex> lock(registryMutex);
+
+    // Event names, thread names, and tile ids contain no characters that
+    // need JSON escaping, so the serializer writes them verbatim.
+    std::ostringstream json;
+    json << "{\"traceEvents\":[";
+
+    bool first = true;
+    uint64_t tid = 0;
+    for (const auto& buffer : registry()) {
+        ++tid;
+
+        if (!first) {
+            json << ",";
+        }
+        first = false;
+        json << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << tid
+             << ",\"args\":{\"name\":\"" << buffer->threadName << "\"}}";
+
+        const std::size_t count = buffer->count.load(std::memory_order_acquire);
+        for (std::size_t i = 0; i < count; i++) {
+            const TraceEvent& event = buffer->events[i];
+            json << ",{\"name\":\"" << event.name << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << tid
+                 << ",\"ts\":" << event.startMicroseconds
+                 << ",\"dur\":" << event.durationMicroseconds;
+            if (event.correlationID != 0 || event.detail[0] != '\0') {
+                json << ",\"args\":{";
+                if (event.detail[0] != '\0') {
+                    json << "\"tile\":\"" << event.detail << "\"";
+                    if (event.correlationID != 0) {
+                        json << ",";
+                    }
+                }
+                if (event.correlationID != 0) {
+                    json << "\"correlation\":" << event.correlationID;
+                }
+                json << "}";
+            }
+            json << "}";
+        }
+    }
+
+    json << "]}";
+    return json.str();
+}
+
+} // namespace util
+} // namespace mbgl
@@ -18,6 +18,18 @@ struct TypeCons<T, TypeList<Ts...>> {
     using Type = TypeList<T, Ts...>;
 };
 
+template <class, class>
+struct TypeListContains;
+
+template <class T>
+struct TypeListContains<TypeList<>, T> : std::false_type {};
+
+template <class T, class U, class... Us>
+struct TypeListContains<TypeList<U, Us...>, T> : TypeListContains<TypeList<Us...>, T> {};
+
+template <class T, class... Us>
+struct TypeListContains<TypeList<T, Us...>, T> : std::true_type {};
+
 template <class, template <class> class>
 struct TypeFilter;
 
@@ -37,4 +49,7 @@ struct TypeFilter<TypeList<T, Ts...>, Predicate> {
 template <class TypeList, template <class> class Predicate>
 using FilteredTypeList = typename detail::TypeFilter<TypeList, Predicate>::Type;
 
+template <class TypeList, class T>
+using TypeListContains = detail::TypeListContains<TypeList, T>;
+
 } // namespace mbgl
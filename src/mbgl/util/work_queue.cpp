@@ -9,6 +9,11 @@ namespace util {
 WorkQueue::WorkQueue() : runLoop(RunLoop::Get()) {
 }
 
+WorkQueue::WorkQueue(std::size_t capacity_)
+    : capacity(capacity_),
+      runLoop(RunLoop::Get()) {
+}
+
 WorkQueue::~WorkQueue() {
     assert(runLoop == RunLoop::Get());
 
@@ -19,10 +24,30 @@ WorkQueue::~WorkQueue() {
 }
 
 void WorkQueue::push(std::function<void()>&& fn) {
-    std::lock_guard<std::mutex> lock(queueMutex);
+    std::function<void(bool)> notify;
+
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+
+        auto workRequest = runLoop->invokeCancellable(std::bind(&WorkQueue::pop, this, std::move(fn)));
+        queue.push(std::move(workRequest));
+
+        if (capacity > 0 && !saturated && queue.size() >= capacity) {
+            saturated = true;
+            notify = backpressureCallback;
+        }
+    }
+
+    // Invoked outside the lock: the callback typically reaches back into the
+    // producer, which may well push again.
+    if (notify) {
+        notify(true);
+    }
+}
 
-    auto workRequest = runLoop->invokeCancellable(std::bind(&WorkQueue::pop, this, std::move(fn)));
-    queue.push(std::move(workRequest));
+void WorkQueue::setBackpressureCallback(std::function<void(bool)> callback) {
+    std::lock_guard<std::mutex> lock(queueMutex);
+    backpressureCallback = std::move(callback);
 }
 
 void WorkQueue::pop(const std::function<void()>& fn) {
@@ -30,8 +55,23 @@ void WorkQueue::pop(const std::function<void()>& fn) {
 
     fn();
 
-    std::lock_guard<std::mutex> lock(queueMutex);
-    queue.pop();
+    std::function<void(bool)> notify;
+
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        queue.pop();
+
+        // Release only once the backlog has halved, so producers are not
+        // toggled on and off around the boundary.
+        if (saturated && queue.size() <= capacity / 2) {
+            saturated = false;
+            notify = backpressureCallback;
+        }
+    }
+
+    if (notify) {
+        notify(false);
+    }
 }
 
 } // namespace util
@@ -20,6 +20,15 @@ class RunLoop;
 class WorkQueue : private util::noncopyable {
 public:
     WorkQueue();
+
+    // A bounded queue: when the number of pending closures reaches
+    // `capacity`, the backpressure callback (if any) is invoked with `true`;
+    // once the backlog drains to half the capacity it is invoked with
+    // `false`. Closures are never dropped — the callback is a signal for
+    // producers to pause low-priority work instead of piling up a backlog
+    // that is paid back as one long catch-up stall.
+    explicit WorkQueue(std::size_t capacity);
+
     ~WorkQueue();
 
     // Push a closure to the queue. It is advised to
@@ -27,12 +36,21 @@ public:
     // that owns the queue to avoid use after free errors.
     void push(std::function<void()>&&);
 
+    // The callback may fire on whichever thread pushed the saturating
+    // closure (with `true`) or on the owning thread as the backlog drains
+    // (with `false`).
+    void setBackpressureCallback(std::function<void(bool)>);
+
 private:
     void pop(const std::function<void()>&);
 
     std::queue<std::unique_ptr<AsyncRequest>> queue;
     std::mutex queueMutex;
 
+    const std::size_t capacity = 0;
+    bool saturated = false;
+    std::function<void(bool)> backpressureCallback;
+
     RunLoop* runLoop;
 };
 
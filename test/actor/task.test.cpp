@@ -0,0 +1,102 @@
+#include <mbgl/actor/actor.hpp>
+#include <mbgl/actor/task.hpp>
+#include <mbgl/util/default_thread_pool.hpp>
+
+#include <mbgl/test/util.hpp>
+
+#include <functional>
+#include <future>
+
+using namespace mbgl;
+
+TEST(TaskScope, CancelledTokenDropsQueuedMessages) {
+    // Cancelling a scope drops guarded messages that are already queued,
+    // without affecting unguarded messages on the same mailbox.
+
+    struct Test {
+        std::promise<void>& running;
+        std::future<void>& resume;
+
+        Test(ActorRef<Test>, std::promise<void>& running_, std::future<void>& resume_)
+            : running(running_),
+              resume(resume_) {
+        }
+
+        void block() {
+            running.set_value();
+            resume.wait();
+        }
+
+        void receive() {
+            FAIL() << "Should not be delivered after cancellation";
+        }
+
+        void end(std::promise<void>& ended) {
+            ended.set_value();
+        }
+    };
+
+    ThreadPool pool { 1 };
+
+    std::promise<void> running;
+    std::future<void> runningFuture = running.get_future();
+    std::promise<void> resume;
+    std::future<void> resumeFuture = resume.get_future();
+
+    TaskScope scope;
+    Actor<Test> test(pool, std::ref(running), std::ref(resumeFuture));
+
+    // Occupy the worker so the guarded message is still queued when we cancel.
+    test.invoke(&Test::block);
+    runningFuture.wait();
+
+    test.self().invokeGuarded(scope.token(), &Test::receive);
+    scope.cancel();
+
+    // Cancelled tokens also stop messages from being queued at all.
+    test.self().invokeGuarded(scope.token(), &Test::receive);
+
+    std::promise<void> ended;
+    std::future<void> endedFuture = ended.get_future();
+    test.invoke(&Test::end, std::ref(ended));
+
+    resume.set_value();
+    endedFuture.wait();
+}
+
+TEST(TaskScope, InvokeWithReplyDeliversResult) {
+    struct Worker {
+        Worker(ActorRef<Worker>) {
+        }
+
+        int square(int x) {
+            return x * x;
+        }
+    };
+
+    struct Receiver {
+        std::promise<int>& result;
+
+        Receiver(ActorRef<Receiver>, std::promise<int>& result_)
+            : result(result_) {
+        }
+
+        void receive(int value) {
+            result.set_value(value);
+        }
+    };
+
+    ThreadPool pool { 1 };
+    TaskScope scope;
+
+    std::promise<int> result;
+    std::future<int> resultFuture = result.get_future();
+
+    Actor<Worker> worker(pool);
+    Actor<Receiver> receiver(pool, std::ref(result));
+
+    worker.self().invokeWithReply(scope.token(), receiver.self(), &Receiver::receive,
+                                  &Worker::square, 7);
+
+    EXPECT_EQ(49, resultFuture.get());
+}
@@ -0,0 +1,96 @@
+#include <mbgl/test/util.hpp>
+
+#include <mbgl/algorithm/clip_id_cache.hpp>
+
+using namespace mbgl;
+
+namespace {
+
+struct Renderable {
+    ClipID clip;
+    bool used = true;
+};
+
+} // end namespace
+
+TEST(ClipIDCache, ReplaysUnchangedFrame) {
+    std::map<UnwrappedTileID, Renderable> renderables{
+        { UnwrappedTileID{ 1, 0, 0 }, Renderable{ ClipID{ "00000011", "00000001" } } },
+        { UnwrappedTileID{ 1, 0, 1 }, Renderable{ ClipID{ "00000011", "00000010" } } },
+    };
+    std::vector<std::map<UnwrappedTileID, Renderable>*> maps{ &renderables };
+
+    algorithm::ClipIDCache cache;
+    EXPECT_FALSE(cache.reuse(maps));
+
+    cache.capture(maps, { { UnwrappedTileID{ 1, 0, 0 }, ClipID{ "00000011", "00000001" } },
+                          { UnwrappedTileID{ 1, 0, 1 }, ClipID{ "00000011", "00000010" } } });
+
+    // A fresh frame starts with empty clip IDs; reuse() restores them.
+    for (auto& pair : renderables) {
+        pair.second.clip = {};
+    }
+    ASSERT_TRUE(cache.reuse(maps));
+    EXPECT_EQ(ClipID("00000011", "00000001"), renderables.at(UnwrappedTileID{ 1, 0, 0 }).clip);
+    EXPECT_EQ(ClipID("00000011", "00000010"), renderables.at(UnwrappedTileID{ 1, 0, 1 }).clip);
+    EXPECT_EQ(2u, cache.getStencils().size());
+}
+
+TEST(ClipIDCache, MissesOnChangedTileSet) {
+    std::map<UnwrappedTileID, Renderable> renderables{
+        { UnwrappedTileID{ 1, 0, 0 }, Renderable{ ClipID{ "00000011", "00000001" } } },
+        { UnwrappedTileID{ 1, 0, 1 }, Renderable{ ClipID{ "00000011", "00000010" } } },
+    };
+    std::vector<std::map<UnwrappedTileID, Renderable>*> maps{ &renderables };
+
+    algorithm::ClipIDCache cache;
+    cache.capture(maps, {});
+
+    // An added tile invalidates the cache and leaves all clips untouched.
+    renderables.emplace(UnwrappedTileID{ 1, 1, 0 }, Renderable{ {} });
+    EXPECT_FALSE(cache.reuse(maps));
+    EXPECT_EQ(ClipID("00000011", "00000001"), renderables.at(UnwrappedTileID{ 1, 0, 0 }).clip);
+    EXPECT_TRUE(renderables.at(UnwrappedTileID{ 1, 1, 0 }).clip.reference.none());
+
+    // So does a removed tile.
+    renderables.erase(UnwrappedTileID{ 1, 1, 0 });
+    renderables.erase(UnwrappedTileID{ 1, 0, 1 });
+    EXPECT_FALSE(cache.reuse(maps));
+}
+
+TEST(ClipIDCache, MissesOnChangedUsedFlags) {
+    std::map<UnwrappedTileID, Renderable> renderables{
+        { UnwrappedTileID{ 1, 0, 0 }, Renderable{ {} } },
+        { UnwrappedTileID{ 1, 0, 1 }, Renderable{ {}, false } },
+    };
+    std::vector<std::map<UnwrappedTileID, Renderable>*> maps{ &renderables };
+
+    algorithm::ClipIDCache cache;
+    cache.capture(maps, {});
+
+    ASSERT_TRUE(cache.reuse(maps));
+
+    // A tile flipping to used changes the sequence even though the map's key
+    // set is identical.
+    renderables.at(UnwrappedTileID{ 1, 0, 1 }).used = true;
+    EXPECT_FALSE(cache.reuse(maps));
+}
+
+TEST(ClipIDCache, MissesOnChangedSourceCount) {
+    std::map<UnwrappedTileID, Renderable> renderables1{
+        { UnwrappedTileID{ 0, 0, 0 }, Renderable{ {} } },
+    };
+    std::map<UnwrappedTileID, Renderable> renderables2{
+        { UnwrappedTileID{ 0, 0, 0 }, Renderable{ {} } },
+    };
+    std::vector<std::map<UnwrappedTileID, Renderable>*> maps{ &renderables1 };
+
+    algorithm::ClipIDCache cache;
+    cache.capture(maps, {});
+
+    maps.push_back(&renderables2);
+    EXPECT_FALSE(cache.reuse(maps));
+
+    cache.capture(maps, {});
+    EXPECT_TRUE(cache.reuse(maps));
+}
@@ -1,6 +1,7 @@
 #include <mbgl/test/util.hpp>
 
 #include <mbgl/algorithm/generate_clip_ids_impl.hpp>
+#include <mbgl/util/arena.hpp>
 
 using namespace mbgl;
 
@@ -58,7 +59,8 @@ TEST(GenerateClipIDs, ParentAndFourChildren) {
         { UnwrappedTileID{ 1, 1, 1 }, Renderable{ {} } },
     };
 
-    algorithm::ClipIDGenerator generator;
+    util::Arena arena;
+    algorithm::ClipIDGenerator generator(arena);
     generator.update(renderables);
 
     EXPECT_EQ(decltype(renderables)({
@@ -90,7 +92,8 @@ TEST(GenerateClipIDs, ParentAndFourChildrenNegative) {
         { UnwrappedTileID{ 0, -1, 0 }, Renderable{ {} } },
     };
 
-    algorithm::ClipIDGenerator generator;
+    util::Arena arena;
+    algorithm::ClipIDGenerator generator(arena);
     generator.update(renderables);
 
     EXPECT_EQ(decltype(renderables)({
@@ -121,7 +124,8 @@ TEST(GenerateClipIDs, NegativeParentAndMissingLevel) {
         { UnwrappedTileID{ 2, -2, 0 }, Renderable{ {} } },
     };
 
-    algorithm::ClipIDGenerator generator;
+    util::Arena arena;
+    algorithm::ClipIDGenerator generator(arena);
     generator.update(renderables);
 
     EXPECT_EQ(decltype(renderables)({
@@ -157,16 +161,17 @@ TEST(GenerateClipIDs, SevenOnSameLevel) {
         { UnwrappedTileID{ 2, 2, 0 }, Renderable{ {} } },
     };
 
-    algorithm::ClipIDGenerator generator;
+    util::Arena arena;
+    algorithm::ClipIDGenerator generator(arena);
     generator.update(renderables);
     EXPECT_EQ(decltype(renderables)({
                   { UnwrappedTileID{ 2, 0, 0 }, Renderable{ ClipID{ "00000111", "00000001" } } },
                   { UnwrappedTileID{ 2, 0, 1 }, Renderable{ ClipID{ "00000111", "00000010" } } },
-                  { UnwrappedTileID{ 2, 0, 2 }, Renderable{ ClipID{ "00000111", "00000011" } } },
-                  { UnwrappedTileID{ 2, 1, 0 }, Renderable{ ClipID{ "00000111", "00000100" } } },
-                  { UnwrappedTileID{ 2, 1, 1 }, Renderable{ ClipID{ "00000111", "00000101" } } },
-                  { UnwrappedTileID{ 2, 1, 2 }, Renderable{ ClipID{ "00000111", "00000110" } } },
-                  { UnwrappedTileID{ 2, 2, 0 }, Renderable{ ClipID{ "00000111", "00000111" } } },
+                  { UnwrappedTileID{ 2, 0, 2 }, Renderable{ ClipID{ "00000111", "00000001" } } },
+                  { UnwrappedTileID{ 2, 1, 0 }, Renderable{ ClipID{ "00000111", "00000011" } } },
+                  { UnwrappedTileID{ 2, 1, 1 }, Renderable{ ClipID{ "00000111", "00000100" } } },
+                  { UnwrappedTileID{ 2, 1, 2 }, Renderable{ ClipID{ "00000111", "00000011" } } },
+                  { UnwrappedTileID{ 2, 2, 0 }, Renderable{ ClipID{ "00000111", "00000001" } } },
               }),
               renderables);
 
@@ -174,11 +179,11 @@ TEST(GenerateClipIDs, SevenOnSameLevel) {
     EXPECT_EQ(decltype(stencils)({
                   { UnwrappedTileID{ 2, 0, 0 }, ClipID{ "00000111", "00000001" } },
                   { UnwrappedTileID{ 2, 0, 1 }, ClipID{ "00000111", "00000010" } },
-                  { UnwrappedTileID{ 2, 0, 2 }, ClipID{ "00000111", "00000011" } },
-                  { UnwrappedTileID{ 2, 1, 0 }, ClipID{ "00000111", "00000100" } },
-                  { UnwrappedTileID{ 2, 1, 1 }, ClipID{ "00000111", "00000101" } },
-                  { UnwrappedTileID{ 2, 1, 2 }, ClipID{ "00000111", "00000110" } },
-                  { UnwrappedTileID{ 2, 2, 0 }, ClipID{ "00000111", "00000111" } },
+                  { UnwrappedTileID{ 2, 0, 2 }, ClipID{ "00000111", "00000001" } },
+                  { UnwrappedTileID{ 2, 1, 0 }, ClipID{ "00000111", "00000011" } },
+                  { UnwrappedTileID{ 2, 1, 1 }, ClipID{ "00000111", "00000100" } },
+                  { UnwrappedTileID{ 2, 1, 2 }, ClipID{ "00000111", "00000011" } },
+                  { UnwrappedTileID{ 2, 2, 0 }, ClipID{ "00000111", "00000001" } },
               }),
               stencils);
 }
@@ -205,36 +210,37 @@ TEST(GenerateClipIDs, MultipleLevels) {
         // end subtiles of (2/1/0)
     };
 
-    algorithm::ClipIDGenerator generator;
+    util::Arena arena;
+    algorithm::ClipIDGenerator generator(arena);
     generator.update(renderables);
     ASSERT_EQ(decltype(renderables)({
-                  { UnwrappedTileID{ 2, 0, 0 }, Renderable{ ClipID{ "00001111", "00000001" } } },
-                  { UnwrappedTileID{ 2, 1, 0 }, Renderable{ ClipID{ "00001111", "00000010" } } },
-                  { UnwrappedTileID{ 3, 0, 0 }, Renderable{ ClipID{ "00001111", "00000011" } } },
-                  { UnwrappedTileID{ 3, 0, 1 }, Renderable{ ClipID{ "00001111", "00000100" } } },
-                  { UnwrappedTileID{ 3, 1, 0 }, Renderable{ ClipID{ "00001111", "00000101" } } },
-                  { UnwrappedTileID{ 3, 1, 1 }, Renderable{ ClipID{ "00001111", "00000110" } } },
-                  { UnwrappedTileID{ 3, 2, 0 }, Renderable{ ClipID{ "00001111", "00000111" } } },
-                  { UnwrappedTileID{ 3, 2, 1 }, Renderable{ ClipID{ "00001111", "00001000" } } },
-                  { UnwrappedTileID{ 4, 0, 2 }, Renderable{ ClipID{ "00001111", "00001001" } } },
-                  { UnwrappedTileID{ 4, 0, 3 }, Renderable{ ClipID{ "00001111", "00001010" } } },
-                  { UnwrappedTileID{ 4, 1, 2 }, Renderable{ ClipID{ "00001111", "00001011" } } },
-                  { UnwrappedTileID{ 4, 1, 3 }, Renderable{ ClipID{ "00001111", "00001100" } } },
+                  { UnwrappedTileID{ 2, 0, 0 }, Renderable{ ClipID{ "00000111", "00000001" } } },
+                  { UnwrappedTileID{ 2, 1, 0 }, Renderable{ ClipID{ "00000111", "00000010" } } },
+                  { UnwrappedTileID{ 3, 0, 0 }, Renderable{ ClipID{ "00000111", "00000010" } } },
+                  { UnwrappedTileID{ 3, 0, 1 }, Renderable{ ClipID{ "00000111", "00000011" } } },
+                  { UnwrappedTileID{ 3, 1, 0 }, Renderable{ ClipID{ "00000111", "00000100" } } },
+                  { UnwrappedTileID{ 3, 1, 1 }, Renderable{ ClipID{ "00000111", "00000101" } } },
+                  { UnwrappedTileID{ 3, 2, 0 }, Renderable{ ClipID{ "00000111", "00000011" } } },
+                  { UnwrappedTileID{ 3, 2, 1 }, Renderable{ ClipID{ "00000111", "00000110" } } },
+                  { UnwrappedTileID{ 4, 0, 2 }, Renderable{ ClipID{ "00000111", "00000100" } } },
+                  { UnwrappedTileID{ 4, 0, 3 }, Renderable{ ClipID{ "00000111", "00000010" } } },
+                  { UnwrappedTileID{ 4, 1, 2 }, Renderable{ ClipID{ "00000111", "00000110" } } },
+                  { UnwrappedTileID{ 4, 1, 3 }, Renderable{ ClipID{ "00000111", "00000111" } } },
               }),
               renderables);
 
     const auto stencils = generator.getStencils();
     EXPECT_EQ(decltype(stencils)({
-                  { UnwrappedTileID{ 2, 1, 0 }, ClipID{ "00001111", "00000010" } },
-                  { UnwrappedTileID{ 3, 0, 0 }, ClipID{ "00001111", "00000011" } },
-                  { UnwrappedTileID{ 3, 1, 0 }, ClipID{ "00001111", "00000101" } },
-                  { UnwrappedTileID{ 3, 1, 1 }, ClipID{ "00001111", "00000110" } },
-                  { UnwrappedTileID{ 3, 2, 0 }, ClipID{ "00001111", "00000111" } },
-                  { UnwrappedTileID{ 3, 2, 1 }, ClipID{ "00001111", "00001000" } },
-                  { UnwrappedTileID{ 4, 0, 2 }, ClipID{ "00001111", "00001001" } },
-                  { UnwrappedTileID{ 4, 0, 3 }, ClipID{ "00001111", "00001010" } },
-                  { UnwrappedTileID{ 4, 1, 2 }, ClipID{ "00001111", "00001011" } },
-                  { UnwrappedTileID{ 4, 1, 3 }, ClipID{ "00001111", "00001100" } },
+                  { UnwrappedTileID{ 2, 1, 0 }, ClipID{ "00000111", "00000010" } },
+                  { UnwrappedTileID{ 3, 0, 0 }, ClipID{ "00000111", "00000010" } },
+                  { UnwrappedTileID{ 3, 1, 0 }, ClipID{ "00000111", "00000100" } },
+                  { UnwrappedTileID{ 3, 1, 1 }, ClipID{ "00000111", "00000101" } },
+                  { UnwrappedTileID{ 3, 2, 0 }, ClipID{ "00000111", "00000011" } },
+                  { UnwrappedTileID{ 3, 2, 1 }, ClipID{ "00000111", "00000110" } },
+                  { UnwrappedTileID{ 4, 0, 2 }, ClipID{ "00000111", "00000100" } },
+                  { UnwrappedTileID{ 4, 0, 3 }, ClipID{ "00000111", "00000010" } },
+                  { UnwrappedTileID{ 4, 1, 2 }, ClipID{ "00000111", "00000110" } },
+                  { UnwrappedTileID{ 4, 1, 3 }, ClipID{ "00000111", "00000111" } },
               }),
               stencils);
 }
@@ -256,37 +262,38 @@ TEST(GenerateClipIDs, Bug206) {
         { UnwrappedTileID{ 10, 164, 396 }, Renderable{ {} } },
     };
 
-    algorithm::ClipIDGenerator generator;
+    util::Arena arena;
+    algorithm::ClipIDGenerator generator(arena);
     generator.update(renderables);
     EXPECT_EQ(
         decltype(renderables)({
-            { UnwrappedTileID{ 10, 162, 395 }, Renderable{ ClipID{ "00001111", "00000001" } } },
-            { UnwrappedTileID{ 10, 162, 396 }, Renderable{ ClipID{ "00001111", "00000010" } } },
-            { UnwrappedTileID{ 10, 163, 395 }, Renderable{ ClipID{ "00001111", "00000011" } } },
-            { UnwrappedTileID{ 10, 163, 396 }, Renderable{ ClipID{ "00001111", "00000100" } } },
-            { UnwrappedTileID{ 10, 164, 395 }, Renderable{ ClipID{ "00001111", "00000101" } } },
-            { UnwrappedTileID{ 10, 164, 396 }, Renderable{ ClipID{ "00001111", "00000110" } } },
-            { UnwrappedTileID{ 11, 326, 791 }, Renderable{ ClipID{ "00001111", "00000111" } } },
-            { UnwrappedTileID{ 12, 654, 1582 }, Renderable{ ClipID{ "00001111", "00001000" } } },
-            { UnwrappedTileID{ 12, 654, 1583 }, Renderable{ ClipID{ "00001111", "00001001" } } },
-            { UnwrappedTileID{ 12, 655, 1582 }, Renderable{ ClipID{ "00001111", "00001010" } } },
-            { UnwrappedTileID{ 12, 655, 1583 }, Renderable{ ClipID{ "00001111", "00001011" } } },
+            { UnwrappedTileID{ 10, 162, 395 }, Renderable{ ClipID{ "00000111", "00000001" } } },
+            { UnwrappedTileID{ 10, 162, 396 }, Renderable{ ClipID{ "00000111", "00000010" } } },
+            { UnwrappedTileID{ 10, 163, 395 }, Renderable{ ClipID{ "00000111", "00000011" } } },
+            { UnwrappedTileID{ 10, 163, 396 }, Renderable{ ClipID{ "00000111", "00000100" } } },
+            { UnwrappedTileID{ 10, 164, 395 }, Renderable{ ClipID{ "00000111", "00000001" } } },
+            { UnwrappedTileID{ 10, 164, 396 }, Renderable{ ClipID{ "00000111", "00000010" } } },
+            { UnwrappedTileID{ 11, 326, 791 }, Renderable{ ClipID{ "00000111", "00000101" } } },
+            { UnwrappedTileID{ 12, 654, 1582 }, Renderable{ ClipID{ "00000111", "00000001" } } },
+            { UnwrappedTileID{ 12, 654, 1583 }, Renderable{ ClipID{ "00000111", "00000010" } } },
+            { UnwrappedTileID{ 12, 655, 1582 }, Renderable{ ClipID{ "00000111", "00000100" } } },
+            { UnwrappedTileID{ 12, 655, 1583 }, Renderable{ ClipID{ "00000111", "00000101" } } },
         }),
         renderables);
 
     const auto stencils = generator.getStencils();
     EXPECT_EQ(decltype(stencils)({
-                  { UnwrappedTileID{ 10, 162, 395 }, ClipID{ "00001111", "00000001" } },
-                  { UnwrappedTileID{ 10, 162, 396 }, ClipID{ "00001111", "00000010" } },
-                  { UnwrappedTileID{ 10, 163, 395 }, ClipID{ "00001111", "00000011" } },
-                  { UnwrappedTileID{ 10, 163, 396 }, ClipID{ "00001111", "00000100" } },
-                  { UnwrappedTileID{ 10, 164, 395 }, ClipID{ "00001111", "00000101" } },
-                  { UnwrappedTileID{ 10, 164, 396 }, ClipID{ "00001111", "00000110" } },
-                  { UnwrappedTileID{ 11, 326, 791 }, ClipID{ "00001111", "00000111" } },
-                  { UnwrappedTileID{ 12, 654, 1582 }, ClipID{ "00001111", "00001000" } },
-                  { UnwrappedTileID{ 12, 654, 1583 }, ClipID{ "00001111", "00001001" } },
-                  { UnwrappedTileID{ 12, 655, 1582 }, ClipID{ "00001111", "00001010" } },
-                  { UnwrappedTileID{ 12, 655, 1583 }, ClipID{ "00001111", "00001011" } },
+                  { UnwrappedTileID{ 10, 162, 395 }, ClipID{ "00000111", "00000001" } },
+                  { UnwrappedTileID{ 10, 162, 396 }, ClipID{ "00000111", "00000010" } },
+                  { UnwrappedTileID{ 10, 163, 395 }, ClipID{ "00000111", "00000011" } },
+                  { UnwrappedTileID{ 10, 163, 396 }, ClipID{ "00000111", "00000100" } },
+                  { UnwrappedTileID{ 10, 164, 395 }, ClipID{ "00000111", "00000001" } },
+                  { UnwrappedTileID{ 10, 164, 396 }, ClipID{ "00000111", "00000010" } },
+                  { UnwrappedTileID{ 11, 326, 791 }, ClipID{ "00000111", "00000101" } },
+                  { UnwrappedTileID{ 12, 654, 1582 }, ClipID{ "00000111", "00000001" } },
+                  { UnwrappedTileID{ 12, 654, 1583 }, ClipID{ "00000111", "00000010" } },
+                  { UnwrappedTileID{ 12, 655, 1582 }, ClipID{ "00000111", "00000100" } },
+                  { UnwrappedTileID{ 12, 655, 1583 }, ClipID{ "00000111", "00000101" } },
               }),
               stencils);
 }
@@ -315,7 +322,8 @@ TEST(GenerateClipIDs, MultipleSources) {
         { UnwrappedTileID{ 2, 1, 1 }, Renderable{ {} } },
     };
 
-    algorithm::ClipIDGenerator generator;
+    util::Arena arena;
+    algorithm::ClipIDGenerator generator(arena);
     generator.update(renderables1);
     generator.update(renderables2);
     generator.update(renderables3);
@@ -366,7 +374,8 @@ TEST(GenerateClipIDs, DuplicateIDs) {
         { UnwrappedTileID{ 2, 0, 1 }, Renderable{ {} } },
     };
 
-    algorithm::ClipIDGenerator generator;
+    util::Arena arena;
+    algorithm::ClipIDGenerator generator(arena);
     generator.update(renderables1);
     generator.update(renderables2);
     EXPECT_EQ(decltype(renderables1)({
@@ -401,28 +410,80 @@ TEST(GenerateClipIDs, SecondSourceHasParentOfFirstSource) {
         { UnwrappedTileID{ 0, 0, 0 }, Renderable{ {} } },
     };
 
-    algorithm::ClipIDGenerator generator;
+    util::Arena arena;
+    algorithm::ClipIDGenerator generator(arena);
     generator.update(renderables1);
     generator.update(renderables2);
     generator.update(renderables3);
+    // The single-tile sources have nothing to conflict with, so their tiles
+    // render without any stencil clipping.
     EXPECT_EQ(decltype(renderables1)({
-                  { UnwrappedTileID{ 1, 0, 0 }, Renderable{ ClipID{ "00000001", "00000001" } } },
+                  { UnwrappedTileID{ 1, 0, 0 }, Renderable{ ClipID{ "00000000", "00000000" } } },
               }),
               renderables1);
     EXPECT_EQ(decltype(renderables2)({
-                  { UnwrappedTileID{ 0, 0, 0 }, Renderable{ ClipID{ "00000010", "00000010" } } },
-                  { UnwrappedTileID{ 1, 0, 0 }, Renderable{ ClipID{ "00000011", "00000001" } } },
+                  { UnwrappedTileID{ 0, 0, 0 }, Renderable{ ClipID{ "00000011", "00000001" } } },
+                  { UnwrappedTileID{ 1, 0, 0 }, Renderable{ ClipID{ "00000011", "00000010" } } },
               }),
               renderables2);
     EXPECT_EQ(decltype(renderables3)({
-                  { UnwrappedTileID{ 0, 0, 0 }, Renderable{ ClipID{ "00000100", "00000100" } } },
+                  { UnwrappedTileID{ 0, 0, 0 }, Renderable{ ClipID{ "00000000", "00000000" } } },
               }),
               renderables3);
 
     const auto stencils = generator.getStencils();
     EXPECT_EQ(decltype(stencils)({
-                  { UnwrappedTileID{ 0, 0, 0 }, ClipID{ "00000110", "00000110" } },
-                  { UnwrappedTileID{ 1, 0, 0 }, ClipID{ "00000111", "00000101" } },
+                  { UnwrappedTileID{ 0, 0, 0 }, ClipID{ "00000011", "00000001" } },
+                  { UnwrappedTileID{ 1, 0, 0 }, ClipID{ "00000011", "00000010" } },
+              }),
+              stencils);
+}
+
+TEST(GenerateClipIDs, IsolatedTilesSkipClipping) {
+    // None of these tiles can overlap on screen: same zoom, more than a tile
+    // apart. No stencil bits are allocated and no masks need to be drawn.
+    std::map<UnwrappedTileID, Renderable> renderables{
+        { UnwrappedTileID{ 4, 2, 2 }, Renderable{ {} } },
+        { UnwrappedTileID{ 4, 7, 2 }, Renderable{ {} } },
+        { UnwrappedTileID{ 4, 2, 9 }, Renderable{ {} } },
+    };
+
+    util::Arena arena;
+    algorithm::ClipIDGenerator generator(arena);
+    generator.update(renderables);
+    EXPECT_EQ(decltype(renderables)({
+                  { UnwrappedTileID{ 4, 2, 2 }, Renderable{ ClipID{ "00000000", "00000000" } } },
+                  { UnwrappedTileID{ 4, 2, 9 }, Renderable{ ClipID{ "00000000", "00000000" } } },
+                  { UnwrappedTileID{ 4, 7, 2 }, Renderable{ ClipID{ "00000000", "00000000" } } },
+              }),
+              renderables);
+
+    EXPECT_TRUE(generator.getStencils().empty());
+}
+
+TEST(GenerateClipIDs, MixedIsolatedAndConflicting) {
+    // The parent/child pair needs clipping; the far-away tile does not, and
+    // it neither consumes a reference nor widens the stencil band.
+    std::map<UnwrappedTileID, Renderable> renderables{
+        { UnwrappedTileID{ 2, 0, 0 }, Renderable{ {} } },
+        { UnwrappedTileID{ 3, 0, 0 }, Renderable{ {} } },
+        { UnwrappedTileID{ 2, 3, 3 }, Renderable{ {} } },
+    };
+
+    util::Arena arena;
+    algorithm::ClipIDGenerator generator(arena);
+    generator.update(renderables);
+    EXPECT_EQ(decltype(renderables)({
+                  { UnwrappedTileID{ 2, 0, 0 }, Renderable{ ClipID{ "00000011", "00000001" } } },
+                  { UnwrappedTileID{ 2, 3, 3 }, Renderable{ ClipID{ "00000000", "00000000" } } },
+                  { UnwrappedTileID{ 3, 0, 0 }, Renderable{ ClipID{ "00000011", "00000010" } } },
+              }),
+              renderables);
+
+    const auto stencils = generator.getStencils();
+    EXPECT_EQ(decltype(stencils)({
+                  { UnwrappedTileID{ 2, 0, 0 }, ClipID{ "00000011", "00000001" } },
+                  { UnwrappedTileID{ 3, 0, 0 }, ClipID{ "00000011", "00000010" } },
               }),
               stencils);
 }
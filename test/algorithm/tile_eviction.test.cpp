@@ -0,0 +1,44 @@
+#include <mbgl/test/util.hpp>
+
+#include <mbgl/algorithm/tile_eviction.hpp>
+
+using namespace mbgl;
+using namespace mbgl::algorithm;
+
+// Viewport centered in the middle of the world at z4.
+static constexpr double zoom = 4;
+static constexpr double cx = 0.5;
+static constexpr double cy = 0.5;
+
+TEST(TileEviction, PrefersViewportLineage) {
+    // The parent of the viewport center outscores (i.e. outlives) a tile at
+    // the current zoom on the far side of the world: zooming out and back in
+    // revisits the parent, panning across the world is rare.
+    EXPECT_LT(tileEvictionScore({ 3, 3, 3 }, zoom, cx, cy, 0),
+              tileEvictionScore({ 4, 0, 0 }, zoom, cx, cy, 0));
+
+    // Any ancestor of the center has a zero distance term, so its score only
+    // grows with the zoom delta.
+    EXPECT_LT(tileEvictionScore({ 2, 1, 1 }, zoom, cx, cy, 0),
+              tileEvictionScore({ 0, 0, 0 }, zoom, cx, cy, 0));
+}
+
+TEST(TileEviction, DistanceInOwnUnits) {
+    // Tiles at the same zoom score by distance from the viewport center.
+    EXPECT_LT(tileEvictionScore({ 4, 8, 8 }, zoom, cx, cy, 0),
+              tileEvictionScore({ 4, 12, 8 }, zoom, cx, cy, 0));
+    EXPECT_LT(tileEvictionScore({ 4, 12, 8 }, zoom, cx, cy, 0),
+              tileEvictionScore({ 4, 15, 8 }, zoom, cx, cy, 0));
+}
+
+TEST(TileEviction, RevisitsDiscount) {
+    // A revived tile outlives an identical cold one...
+    const OverscaledTileID farTile { 4, 15, 15 };
+    EXPECT_LT(tileEvictionScore(farTile, zoom, cx, cy, 4),
+              tileEvictionScore(farTile, zoom, cx, cy, 0));
+
+    // ...but the discount is logarithmic, so a moderately revisited tile on
+    // the far side of the world still goes before the center's own lineage.
+    EXPECT_LT(tileEvictionScore({ 3, 3, 3 }, zoom, cx, cy, 0),
+              tileEvictionScore(farTile, zoom, cx, cy, 7));
+}
@@ -1226,3 +1226,44 @@ TEST(UpdateRenderables, RepeatedRenderWithMissingOptionals) {
               }),
               log);
 }
+
+TEST(UpdateRenderables, LookupCountScalesLinearly) {
+    // The parent ascent is amortized by the `checked` set: each distinct
+    // ancestor is looked up at most once per updateRenderables() call, so the
+    // total number of data-source lookups stays linear in the number of ideal
+    // tiles even when the cache is completely cold. Guard against a
+    // regression to per-tile full-depth ascents.
+    const uint8_t zoom = 10;
+    auto countLookups = [&](uint32_t width) {
+        MockSource source;
+        for (uint32_t x = 0; x < width; ++x) {
+            for (uint32_t y = 0; y < width; ++y) {
+                source.idealTiles.emplace(UnwrappedTileID{ zoom, x, y });
+            }
+        }
+
+        uint64_t lookups = 0;
+        algorithm::updateRenderables(
+            [&](const auto& id) {
+                lookups++;
+                auto it = source.dataTiles.find(id);
+                return it != source.dataTiles.end() ? it->second.get() : nullptr;
+            },
+            [&](const auto& id) { return source.createTileData(id); },
+            [](auto&, Resource::Necessity) {}, [](const auto&, auto&) {}, source.idealTiles,
+            source.zoomRange, zoom);
+        return lookups;
+    };
+
+    // One ideal lookup and four child lookups per tile, plus one amortized
+    // ascent lookup per distinct ancestor: at most n/3 across the block and
+    // one per remaining zoom level above it.
+    for (const uint32_t width : { 4, 8, 16 }) {
+        const uint64_t n = width * width;
+        EXPECT_GE(6 * n + zoom, countLookups(width));
+    }
+
+    // Quadrupling the ideal tile count must not grow the lookup count more
+    // than proportionally.
+    EXPECT_GE(5 * countLookups(8), countLookups(16));
+}
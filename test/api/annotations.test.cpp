@@ -167,6 +167,36 @@ TEST(Annotations, AddMultiple) {
     test.checkRendering("add_multiple");
 }
 
+TEST(Annotations, AddBatch) {
+    AnnotationTest test;
+
+    test.map.setStyleJSON(util::read_file("test/fixtures/api/empty.json"));
+    test.map.addAnnotationIcon("default_marker", namedMarker("default_marker.png"));
+
+    AnnotationIDs ids = test.map.addAnnotations({
+        SymbolAnnotation { Point<double> { -10, 0 }, "default_marker" },
+        SymbolAnnotation { Point<double> { 10, 0 }, "default_marker" }
+    });
+    EXPECT_EQ(2u, ids.size());
+
+    test.checkRendering("add_multiple");
+}
+
+TEST(Annotations, RemoveBatch) {
+    AnnotationTest test;
+
+    test.map.setStyleJSON(util::read_file("test/fixtures/api/empty.json"));
+    test.map.addAnnotationIcon("default_marker", namedMarker("default_marker.png"));
+    AnnotationIDs ids = test.map.addAnnotations({
+        SymbolAnnotation { Point<double> { 0, 0 }, "default_marker" }
+    });
+
+    test::render(test.map, test.view);
+
+    test.map.removeAnnotations(ids);
+    test.checkRendering("remove_point");
+}
+
 TEST(Annotations, NonImmediateAdd) {
     AnnotationTest test;
 
@@ -1,7 +1,9 @@
 #include <mbgl/test/util.hpp>
+#include <mbgl/test/stub_geometry_tile_feature.hpp>
 
 #include <mbgl/renderer/circle_bucket.hpp>
 #include <mbgl/renderer/fill_bucket.hpp>
+#include <mbgl/renderer/fill_extrusion_bucket.hpp>
 #include <mbgl/renderer/line_bucket.hpp>
 #include <mbgl/renderer/symbol_bucket.hpp>
 #include <mbgl/style/bucket_parameters.hpp>
@@ -19,6 +21,40 @@ TEST(Buckets, CircleBucket) {
 TEST(Buckets, FillBucket) {
     FillBucket bucket { { {0, 0, 0}, MapMode::Still }, {} };
     ASSERT_FALSE(bucket.hasData());
+    ASSERT_FALSE(bucket.coversTile());
+}
+
+TEST(Buckets, FillBucketCoversTile) {
+    FillBucket bucket { { {0, 0, 0}, MapMode::Still }, {} };
+    StubGeometryTileFeature feature { {} };
+    feature.type = FeatureType::Polygon;
+
+    // A triangle does not cover the tile; a rectangle containing the full
+    // extent does.
+    bucket.addFeature(feature, {{ { 0, 0 }, { 8192, 0 }, { 0, 8192 } }});
+    ASSERT_FALSE(bucket.coversTile());
+
+    bucket.addFeature(feature, {{ { -128, -128 }, { 8320, -128 }, { 8320, 8320 }, { -128, 8320 } }});
+    ASSERT_TRUE(bucket.coversTile());
+}
+
+TEST(Buckets, FillExtrusionBucket) {
+    FillExtrusionBucket bucket { { {0, 0, 0}, MapMode::Still }, {} };
+    ASSERT_FALSE(bucket.hasData());
+}
+
+TEST(Buckets, FillExtrusionBucketSharedWallVertices) {
+    FillExtrusionBucket bucket { { {0, 0, 0}, MapMode::Still }, {} };
+    StubGeometryTileFeature feature { {} };
+    feature.type = FeatureType::Polygon;
+
+    // A square away from the tile border: each of the four walls is a quad
+    // of four vertices shared by its two triangles, and the roof reuses each
+    // ring vertex once — 20 vertices in total, where a per-face emission
+    // would need 36.
+    bucket.addFeature(feature, {{ { 16, 16 }, { 48, 16 }, { 48, 48 }, { 16, 48 } }});
+    ASSERT_TRUE(bucket.hasData());
+    ASSERT_EQ(20u, bucket.vertexCount());
 }
 
 TEST(Buckets, LineBucket) {
@@ -0,0 +1,83 @@
+#include <mbgl/test/util.hpp>
+
+#include <mbgl/gl/index_buffer.hpp>
+#include <mbgl/gl/vertex_buffer.hpp>
+
+using namespace mbgl;
+
+namespace {
+
+struct TestVertex {
+    int16_t x;
+    int16_t y;
+};
+
+} // namespace
+
+TEST(VertexVector, CopySharesStorage) {
+    gl::VertexVector<TestVertex> a;
+    a.emplace_back(TestVertex { 1, 2 });
+    a.emplace_back(TestVertex { 3, 4 });
+
+    gl::VertexVector<TestVertex> b = a;
+    EXPECT_EQ(a.data(), b.data());
+    EXPECT_EQ(2u, b.vertexSize());
+}
+
+TEST(VertexVector, MutationDetachesSharedStorage) {
+    gl::VertexVector<TestVertex> a;
+    a.emplace_back(TestVertex { 1, 2 });
+
+    gl::VertexVector<TestVertex> b = a;
+    b.emplace_back(TestVertex { 3, 4 });
+    EXPECT_NE(a.data(), b.data());
+    EXPECT_EQ(1u, a.vertexSize());
+    EXPECT_EQ(2u, b.vertexSize());
+
+    gl::VertexVector<TestVertex> c = a;
+    c.mutableData()[0].x = 9;
+    EXPECT_EQ(1, a.data()[0].x);
+    EXPECT_EQ(9, c.data()[0].x);
+}
+
+TEST(VertexVector, TryShareWithRequiresIdenticalContents) {
+    gl::VertexVector<TestVertex> a;
+    gl::VertexVector<TestVertex> b;
+    a.emplace_back(TestVertex { 1, 2 });
+    b.emplace_back(TestVertex { 1, 2 });
+
+    EXPECT_TRUE(b.tryShareWith(a));
+    EXPECT_EQ(a.data(), b.data());
+
+    gl::VertexVector<TestVertex> c;
+    c.emplace_back(TestVertex { 5, 6 });
+    EXPECT_FALSE(c.tryShareWith(a));
+    EXPECT_NE(a.data(), c.data());
+}
+
+TEST(VertexVector, MoveReleasesStorage) {
+    gl::VertexVector<TestVertex> a;
+    a.emplace_back(TestVertex { 1, 2 });
+
+    // Uploads move the vector into gl::Context::createVertexBuffer, which
+    // takes it by value: the CPU-side slab is released with the moved-from
+    // vector once the data is on the GPU.
+    gl::VertexVector<TestVertex> consumed = std::move(a);
+    EXPECT_TRUE(a.empty());
+    EXPECT_EQ(nullptr, a.data());
+    EXPECT_EQ(1u, consumed.vertexSize());
+}
+
+TEST(IndexVector, CopySharesAndMutationDetaches) {
+    gl::IndexVector<gl::Triangles> a;
+    a.emplace_back(0, 1, 2);
+
+    gl::IndexVector<gl::Triangles> b = a;
+    EXPECT_EQ(a.data(), b.data());
+    EXPECT_TRUE(b.tryShareWith(a));
+
+    b.emplace_back(2, 1, 0);
+    EXPECT_NE(a.data(), b.data());
+    EXPECT_EQ(3u, a.indexSize());
+    EXPECT_EQ(6u, b.indexSize());
+}
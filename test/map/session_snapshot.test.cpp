@@ -0,0 +1,66 @@
+#include <mbgl/test/util.hpp>
+#include <mbgl/map/session_snapshot.hpp>
+
+using namespace mbgl;
+
+TEST(SessionSnapshot, RoundTrip) {
+    SessionSnapshot snapshot;
+    snapshot.latLng = LatLng(38.9, -77.0);
+    snapshot.zoom = 11.5;
+    snapshot.bearing = 24.0;
+    snapshot.pitch = 30.0;
+    snapshot.styleURL = "mapbox://styles/mapbox/streets-v9";
+    snapshot.styleJSONHash = SessionSnapshot::hashJSON("{\"version\":8}");
+    snapshot.sources.push_back(SessionSnapshot::SourceEntry {
+        "composite",
+        {
+            SessionSnapshot::TileEntry { OverscaledTileID(11, 11, 602, 783), "tile a" },
+            SessionSnapshot::TileEntry { OverscaledTileID(12, 11, 602, 783), "tile b" },
+        },
+    });
+    snapshot.sources.push_back(SessionSnapshot::SourceEntry { "empty", {} });
+
+    optional<SessionSnapshot> decoded = SessionSnapshot::decode(snapshot.encode());
+    ASSERT_TRUE(bool(decoded));
+
+    EXPECT_EQ(snapshot.latLng.latitude, decoded->latLng.latitude);
+    EXPECT_EQ(snapshot.latLng.longitude, decoded->latLng.longitude);
+    EXPECT_EQ(snapshot.zoom, decoded->zoom);
+    EXPECT_EQ(snapshot.bearing, decoded->bearing);
+    EXPECT_EQ(snapshot.pitch, decoded->pitch);
+    EXPECT_EQ(snapshot.styleURL, decoded->styleURL);
+    EXPECT_EQ(snapshot.styleJSONHash, decoded->styleJSONHash);
+
+    ASSERT_EQ(2u, decoded->sources.size());
+    EXPECT_EQ("composite", decoded->sources[0].sourceID);
+    ASSERT_EQ(2u, decoded->sources[0].tiles.size());
+    EXPECT_EQ(OverscaledTileID(11, 11, 602, 783), decoded->sources[0].tiles[0].id);
+    EXPECT_EQ("tile a", decoded->sources[0].tiles[0].data);
+    EXPECT_EQ(OverscaledTileID(12, 11, 602, 783), decoded->sources[0].tiles[1].id);
+    EXPECT_EQ("tile b", decoded->sources[0].tiles[1].data);
+    EXPECT_EQ("empty", decoded->sources[1].sourceID);
+    EXPECT_TRUE(decoded->sources[1].tiles.empty());
+}
+
+TEST(SessionSnapshot, RejectsInvalidBlobs) {
+    EXPECT_FALSE(bool(SessionSnapshot::decode("")));
+    EXPECT_FALSE(bool(SessionSnapshot::decode("not a snapshot")));
+
+    // A wrong format version in the magic bytes must fail to decode.
+    std::string blob = SessionSnapshot().encode();
+    blob[7] = '9';
+    EXPECT_FALSE(bool(SessionSnapshot::decode(blob)));
+
+    // Truncation anywhere in the payload must fail, not read out of bounds.
+    blob = SessionSnapshot().encode();
+    for (std::size_t size = 8; size < blob.size(); size++) {
+        EXPECT_FALSE(bool(SessionSnapshot::decode(blob.substr(0, size))));
+    }
+}
+
+TEST(SessionSnapshot, HashJSON) {
+    EXPECT_EQ(SessionSnapshot::hashJSON("{\"version\":8}"),
+              SessionSnapshot::hashJSON("{\"version\":8}"));
+    EXPECT_NE(SessionSnapshot::hashJSON("{\"version\":8}"),
+              SessionSnapshot::hashJSON("{\"version\":9}"));
+}
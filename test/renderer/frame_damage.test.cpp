@@ -0,0 +1,147 @@
+#include <mbgl/test/util.hpp>
+
+#include <mbgl/renderer/frame_damage.hpp>
+#include <mbgl/util/constants.hpp>
+
+using namespace mbgl;
+
+namespace {
+
+// Maps the tile extent quad onto the given fraction of the viewport, anchored
+// at the bottom-left corner.
+mat4 tileMatrixCovering(double fraction) {
+    mat4 matrix;
+    matrix::ortho(matrix, 0, util::EXTENT / fraction, 0, util::EXTENT / fraction, -1, 1);
+    return matrix;
+}
+
+} // namespace
+
+TEST(FrameDamage, UnknownBufferAgeForcesFullRepaint) {
+    FrameDamage damage;
+
+    damage.beginFrame(tileMatrixCovering(1), false);
+    damage.addTile(UnwrappedTileID{ 0, 0, 0 }, tileMatrixCovering(1), false);
+    EXPECT_FALSE(damage.scissorRegion(0, { 100, 100 }));
+    damage.endFrame();
+}
+
+TEST(FrameDamage, UnchangedFrameHasEmptyDamage) {
+    FrameDamage damage;
+    const mat4 proj = tileMatrixCovering(1);
+
+    damage.beginFrame(proj, false);
+    damage.addTile(UnwrappedTileID{ 0, 0, 0 }, tileMatrixCovering(1), true);
+    damage.endFrame();
+
+    damage.beginFrame(proj, false);
+    damage.addTile(UnwrappedTileID{ 0, 0, 0 }, tileMatrixCovering(1), false);
+    const auto region = damage.scissorRegion(1, { 100, 100 });
+    ASSERT_TRUE(bool(region));
+    EXPECT_EQ(0u, region->size.width);
+    EXPECT_EQ(0u, region->size.height);
+    damage.endFrame();
+}
+
+TEST(FrameDamage, ChangedTileDamagesItsRegion) {
+    FrameDamage damage;
+    const mat4 proj = tileMatrixCovering(1);
+
+    damage.beginFrame(proj, false);
+    damage.addTile(UnwrappedTileID{ 1, 0, 0 }, tileMatrixCovering(2), false);
+    damage.endFrame();
+
+    // The tile covers the bottom-left quarter of a 100x100 framebuffer; its
+    // damage is that quarter plus a pixel of slack.
+    damage.beginFrame(proj, false);
+    damage.addTile(UnwrappedTileID{ 1, 0, 0 }, tileMatrixCovering(2), true);
+    const auto region = damage.scissorRegion(1, { 100, 100 });
+    ASSERT_TRUE(bool(region));
+    EXPECT_EQ(0, region->x);
+    EXPECT_EQ(0, region->y);
+    EXPECT_EQ(51u, region->size.width);
+    EXPECT_EQ(51u, region->size.height);
+    damage.endFrame();
+}
+
+TEST(FrameDamage, DisappearedTileDamagesItsRegion) {
+    FrameDamage damage;
+    const mat4 proj = tileMatrixCovering(1);
+
+    damage.beginFrame(proj, false);
+    damage.addTile(UnwrappedTileID{ 1, 0, 0 }, tileMatrixCovering(2), false);
+    damage.endFrame();
+
+    damage.beginFrame(proj, false);
+    const auto region = damage.scissorRegion(1, { 100, 100 });
+    ASSERT_TRUE(bool(region));
+    EXPECT_EQ(51u, region->size.width);
+    damage.endFrame();
+}
+
+TEST(FrameDamage, CameraChangeInvalidatesHistory) {
+    FrameDamage damage;
+
+    damage.beginFrame(tileMatrixCovering(1), false);
+    damage.addTile(UnwrappedTileID{ 0, 0, 0 }, tileMatrixCovering(1), false);
+    damage.endFrame();
+
+    damage.beginFrame(tileMatrixCovering(2), false);
+    damage.addTile(UnwrappedTileID{ 0, 0, 0 }, tileMatrixCovering(2), false);
+    EXPECT_FALSE(damage.scissorRegion(1, { 100, 100 }));
+    damage.endFrame();
+}
+
+TEST(FrameDamage, OlderBufferAccumulatesDamage) {
+    FrameDamage damage;
+    const mat4 proj = tileMatrixCovering(1);
+
+    // The very first frame is always fully damaged; prime the history with a
+    // clean one.
+    damage.beginFrame(proj, false);
+    damage.addTile(UnwrappedTileID{ 1, 0, 0 }, tileMatrixCovering(2), false);
+    damage.endFrame();
+    damage.beginFrame(proj, false);
+    damage.addTile(UnwrappedTileID{ 1, 0, 0 }, tileMatrixCovering(2), false);
+    damage.endFrame();
+
+    damage.beginFrame(proj, false);
+    damage.addTile(UnwrappedTileID{ 1, 0, 0 }, tileMatrixCovering(2), true);
+    damage.endFrame();
+
+    damage.beginFrame(proj, false);
+    damage.addTile(UnwrappedTileID{ 1, 0, 0 }, tileMatrixCovering(2), false);
+
+    // Age 1 only sees this (unchanged) frame; age 2 also includes the
+    // previous frame's upload.
+    auto region = damage.scissorRegion(1, { 100, 100 });
+    ASSERT_TRUE(bool(region));
+    EXPECT_EQ(0u, region->size.width);
+
+    region = damage.scissorRegion(2, { 100, 100 });
+    ASSERT_TRUE(bool(region));
+    EXPECT_EQ(51u, region->size.width);
+
+    // An age beyond the recorded history cannot be reconstructed.
+    EXPECT_FALSE(damage.scissorRegion(9, { 100, 100 }));
+    damage.endFrame();
+}
+
+TEST(FrameDamage, TileIntersectsScissorRegion) {
+    FrameDamage damage;
+    const mat4 proj = tileMatrixCovering(1);
+
+    damage.beginFrame(proj, false);
+    damage.addTile(UnwrappedTileID{ 1, 0, 0 }, tileMatrixCovering(2), false);
+
+    // The tile covers the bottom-left quarter of a 100x100 framebuffer.
+    EXPECT_TRUE(damage.tileIntersects(UnwrappedTileID{ 1, 0, 0 },
+                                      { 0, 0, { 51, 51 } }, { 100, 100 }));
+    EXPECT_FALSE(damage.tileIntersects(UnwrappedTileID{ 1, 0, 0 },
+                                       { 60, 60, { 40, 40 } }, { 100, 100 }));
+
+    // Tiles that were not recorded always count as intersecting.
+    EXPECT_TRUE(damage.tileIntersects(UnwrappedTileID{ 1, 1, 0 },
+                                      { 60, 60, { 40, 40 } }, { 100, 100 }));
+    damage.endFrame();
+}
@@ -30,6 +30,21 @@ public:
     ResponseFunction spriteJSONResponse;
     ResponseFunction spriteImageResponse;
 
+    // Cached tileset hooks; the defaults (miss every lookup, record nothing)
+    // match a file source without persistent storage.
+    std::function<optional<Tileset> (const std::string&)> tilesetResponse;
+    std::function<void (const std::string&, const Tileset&, optional<Timestamp>)> tilesetPut;
+
+    optional<Tileset> getCachedTileset(const std::string& url) override {
+        return tilesetResponse ? tilesetResponse(url) : optional<Tileset>();
+    }
+
+    void putCachedTileset(const std::string& url, const Tileset& tileset, optional<Timestamp> expires) override {
+        if (tilesetPut) {
+            tilesetPut(url, tileset, expires);
+        }
+    }
+
 private:
     // The default behavior is to throw if no per-kind callback has been set.
     optional<Response> defaultResponse(const Resource&);
@@ -2,6 +2,7 @@
 
 #include <mbgl/map/map.hpp>
 #include <mbgl/gl/offscreen_view.hpp>
+#include <mbgl/gl/headless_backend.hpp>
 #include <mbgl/gl/headless_display.hpp>
 #include <mbgl/util/logging.hpp>
 #include <mbgl/util/image.hpp>
@@ -100,7 +101,8 @@ Server::~Server() {
 }
 
 std::shared_ptr<HeadlessDisplay> sharedDisplay() {
-    static auto display = std::make_shared<HeadlessDisplay>();
+    // Retains the process-wide display for the lifetime of the test run.
+    static auto display = HeadlessBackend::getSharedDisplay();
     return display;
 }
 
@@ -169,3 +169,69 @@ TEST(AssetFileSource, URLEncoding) {
 
     loop.run();
 }
+
+// A root pointing at a regular file is served as a zip archive, independent
+// of how getFileSourceRoot() resolves.
+TEST(AssetFileSource, ZipArchive) {
+    util::RunLoop loop;
+
+    AssetFileSource fs("test/fixtures/storage/assets.zip");
+
+    std::unique_ptr<AsyncRequest> req = fs.request({ Resource::Unknown, "asset://nonempty" }, [&](Response res) {
+        req.reset();
+        EXPECT_EQ(nullptr, res.error);
+        ASSERT_TRUE(res.data.get());
+        EXPECT_EQ("content is here\n", *res.data);
+        loop.stop();
+    });
+
+    loop.run();
+}
+
+TEST(AssetFileSource, ZipArchiveEmptyFile) {
+    util::RunLoop loop;
+
+    AssetFileSource fs("test/fixtures/storage/assets.zip");
+
+    std::unique_ptr<AsyncRequest> req = fs.request({ Resource::Unknown, "asset://empty" }, [&](Response res) {
+        req.reset();
+        EXPECT_EQ(nullptr, res.error);
+        ASSERT_TRUE(res.data.get());
+        EXPECT_EQ("", *res.data);
+        loop.stop();
+    });
+
+    loop.run();
+}
+
+TEST(AssetFileSource, ZipArchiveNonExistentFile) {
+    util::RunLoop loop;
+
+    AssetFileSource fs("test/fixtures/storage/assets.zip");
+
+    std::unique_ptr<AsyncRequest> req = fs.request({ Resource::Unknown, "asset://does_not_exist" }, [&](Response res) {
+        req.reset();
+        ASSERT_NE(nullptr, res.error);
+        EXPECT_EQ(Response::Error::Reason::NotFound, res.error->reason);
+        ASSERT_FALSE(res.data.get());
+        loop.stop();
+    });
+
+    loop.run();
+}
+
+TEST(AssetFileSource, ZipArchiveReadDirectory) {
+    util::RunLoop loop;
+
+    AssetFileSource fs("test/fixtures/storage/assets.zip");
+
+    std::unique_ptr<AsyncRequest> req = fs.request({ Resource::Unknown, "asset://directory" }, [&](Response res) {
+        req.reset();
+        ASSERT_NE(nullptr, res.error);
+        EXPECT_EQ(Response::Error::Reason::NotFound, res.error->reason);
+        ASSERT_FALSE(res.data.get());
+        loop.stop();
+    });
+
+    loop.run();
+}
@@ -0,0 +1,70 @@
+#include <mbgl/test/util.hpp>
+
+#include <mbgl/storage/network_quality.hpp>
+
+using namespace mbgl;
+
+TEST(NetworkQuality, UnknownUntilEnoughSamples) {
+    NetworkQuality::Reset();
+    EXPECT_EQ(NetworkQuality::Level::Unknown, NetworkQuality::Get());
+
+    NetworkQuality::RecordTransfer(100 * 1024, Milliseconds(100));
+    EXPECT_EQ(NetworkQuality::Level::Unknown, NetworkQuality::Get());
+
+    NetworkQuality::Reset();
+}
+
+TEST(NetworkQuality, ClassifiesFastTransfersAsGood) {
+    NetworkQuality::Reset();
+
+    // 100 KB in 100ms: 1 MB/s at 100ms latency.
+    for (int i = 0; i < 8; i++) {
+        NetworkQuality::RecordTransfer(100 * 1024, Milliseconds(100));
+    }
+
+    EXPECT_EQ(NetworkQuality::Level::Good, NetworkQuality::Get());
+    EXPECT_LE(Milliseconds(99), NetworkQuality::GetLatency());
+    EXPECT_GE(NetworkQuality::GetDownstreamBandwidth(), 1000u * 1024u);
+
+    NetworkQuality::Reset();
+}
+
+TEST(NetworkQuality, ClassifiesSlowTransfersAsPoor) {
+    NetworkQuality::Reset();
+
+    // 16 KB in 2 seconds: 8 KB/s at 2s latency — a loaded 2G link.
+    for (int i = 0; i < 8; i++) {
+        NetworkQuality::RecordTransfer(16 * 1024, Seconds(2));
+    }
+
+    EXPECT_EQ(NetworkQuality::Level::Poor, NetworkQuality::Get());
+
+    NetworkQuality::Reset();
+}
+
+TEST(NetworkQuality, SmallTransfersOnlyUpdateLatency) {
+    NetworkQuality::Reset();
+
+    // Validation-sized responses at high latency classify the network on
+    // latency alone; no bandwidth conclusion is drawn from them.
+    for (int i = 0; i < 8; i++) {
+        NetworkQuality::RecordTransfer(200, Milliseconds(1500));
+    }
+
+    EXPECT_EQ(NetworkQuality::Level::Poor, NetworkQuality::Get());
+    EXPECT_EQ(0u, NetworkQuality::GetDownstreamBandwidth());
+
+    NetworkQuality::Reset();
+}
+
+TEST(NetworkQuality, RecoversAfterReset) {
+    NetworkQuality::Reset();
+
+    for (int i = 0; i < 8; i++) {
+        NetworkQuality::RecordTransfer(16 * 1024, Seconds(2));
+    }
+    EXPECT_EQ(NetworkQuality::Level::Poor, NetworkQuality::Get());
+
+    NetworkQuality::Reset();
+    EXPECT_EQ(NetworkQuality::Level::Unknown, NetworkQuality::Get());
+}
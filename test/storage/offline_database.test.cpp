@@ -258,6 +258,107 @@ TEST(OfflineDatabase, PutTileNotFound) {
     EXPECT_FALSE(res->data.get());
 }
 
+TEST(OfflineDatabase, PutBatch) {
+    using namespace mbgl;
+
+    OfflineDatabase db(":memory:");
+
+    std::vector<std::pair<Resource, Response>> batch;
+
+    for (unsigned i = 0; i < 4; i++) {
+        Resource resource { Resource::Style, "http://example.com/" + util::toString(i) };
+        Response response;
+        response.data = std::make_shared<std::string>("data" + util::toString(i));
+        batch.emplace_back(resource, response);
+    }
+
+    // The last write for a URL wins, just as with individual puts.
+    Response update;
+    update.data = std::make_shared<std::string>("updated");
+    batch.emplace_back(Resource { Resource::Style, "http://example.com/0" }, update);
+
+    db.putBatch(batch);
+
+    for (unsigned i = 1; i < 4; i++) {
+        auto res = db.get({ Resource::Style, "http://example.com/" + util::toString(i) });
+        ASSERT_TRUE(bool(res));
+        EXPECT_EQ("data" + util::toString(i), *res->data);
+    }
+
+    auto res = db.get({ Resource::Style, "http://example.com/0" });
+    ASSERT_TRUE(bool(res));
+    EXPECT_EQ("updated", *res->data);
+}
+
+TEST(OfflineDatabase, PutGetTileset) {
+    using namespace mbgl;
+
+    OfflineDatabase db(":memory:");
+
+    const std::string url = "http://example.com/tilejson";
+    EXPECT_FALSE(bool(db.getTileset(url)));
+
+    Tileset tileset;
+    tileset.tiles = { "http://example.com/{z}-{x}-{y}.vector.pbf" };
+    tileset.zoomRange = { 2, 14 };
+    tileset.attribution = "attribution";
+    tileset.scheme = Tileset::Scheme::TMS;
+
+    db.putTileset(url, tileset, util::now() + Seconds(60));
+
+    auto result = db.getTileset(url);
+    ASSERT_TRUE(bool(result));
+    EXPECT_EQ(tileset.tiles, result->tiles);
+    EXPECT_EQ(tileset.zoomRange.min, result->zoomRange.min);
+    EXPECT_EQ(tileset.zoomRange.max, result->zoomRange.max);
+    EXPECT_EQ(tileset.attribution, result->attribution);
+    EXPECT_EQ(Tileset::Scheme::TMS, result->scheme);
+
+    // Replacing an entry keeps one row per URL and serves the latest manifest.
+    tileset.tiles = { "http://example.com/v2/{z}-{x}-{y}.vector.pbf" };
+    db.putTileset(url, tileset, util::now() + Seconds(60));
+    result = db.getTileset(url);
+    ASSERT_TRUE(bool(result));
+    EXPECT_EQ(tileset.tiles, result->tiles);
+
+    // An expired entry is still served — the caller revalidates regardless —
+    // but not one expired past the grace period.
+    db.putTileset(url, tileset, util::now() - Seconds(60));
+    EXPECT_TRUE(bool(db.getTileset(url)));
+
+    db.putTileset(url, tileset, util::now() - Seconds(60 * 60 * 24 * 30));
+    EXPECT_FALSE(bool(db.getTileset(url)));
+}
+
+TEST(OfflineDatabase, PutRegionResources) {
+    using namespace mbgl;
+
+    OfflineDatabase db(":memory:");
+    OfflineRegion region = db.createRegion(
+        OfflineRegionDefinition { "http://example.com/style", LatLngBounds::hull({1, 2}, {3, 4}), 5, 6, 2.0 },
+        OfflineRegionMetadata {});
+
+    Response response;
+    response.data = std::make_shared<std::string>("data");
+
+    std::vector<std::pair<Resource, Response>> batch;
+    batch.emplace_back(Resource::style("http://example.com/"), response);
+    batch.emplace_back(Resource::tile("http://example.com/", 1.0, 0, 0, 0, Tileset::Scheme::XYZ), response);
+
+    OfflineRegionStatus status;
+    db.putRegionResources(region.getID(), batch, status);
+
+    // The batch write updates the passed-in status to the same totals that
+    // individual putRegionResource calls would have produced.
+    OfflineRegionStatus completed = db.getRegionCompletedStatus(region.getID());
+    EXPECT_EQ(2u, status.completedResourceCount);
+    EXPECT_EQ(completed.completedResourceCount, status.completedResourceCount);
+    EXPECT_EQ(completed.completedResourceSize, status.completedResourceSize);
+    EXPECT_EQ(1u, status.completedTileCount);
+    EXPECT_EQ(completed.completedTileCount, status.completedTileCount);
+    EXPECT_EQ(completed.completedTileSize, status.completedTileSize);
+}
+
 TEST(OfflineDatabase, CreateRegion) {
     using namespace mbgl;
 
@@ -343,6 +444,44 @@ TEST(OfflineDatabase, DeleteRegion) {
     ASSERT_EQ(0u, db.listRegions().size());
 }
 
+TEST(OfflineDatabase, TEST_REQUIRES_WRITE(MergeDatabase)) {
+    using namespace mbgl;
+
+    createDir("test/fixtures/offline_database");
+    deleteFile("test/fixtures/offline_database/side.db");
+
+    Response response;
+    response.data = std::make_shared<std::string>("data");
+
+    // Build a "pre-baked pack": a separate database holding one region.
+    {
+        OfflineDatabase side("test/fixtures/offline_database/side.db");
+        OfflineRegion region = side.createRegion(
+            OfflineRegionDefinition { "http://example.com/style", LatLngBounds::hull({1, 2}, {3, 4}), 5, 6, 2.0 },
+            OfflineRegionMetadata {{ 1, 2, 3 }});
+        side.putRegionResource(region.getID(), Resource::style("http://example.com/"), response);
+        side.putRegionResource(region.getID(), Resource::tile("http://example.com/", 1.0, 0, 0, 0, Tileset::Scheme::XYZ), response);
+    }
+
+    OfflineDatabase db(":memory:");
+
+    // A copy of one of the pack's resources already cached here survives the merge.
+    db.put(Resource::style("http://example.com/"), response);
+
+    auto merged = db.mergeDatabase("test/fixtures/offline_database/side.db");
+    ASSERT_EQ(1u, merged.size());
+    EXPECT_EQ("http://example.com/style", merged[0].getDefinition().styleURL);
+    EXPECT_EQ(OfflineRegionMetadata({ 1, 2, 3 }), merged[0].getMetadata());
+
+    OfflineRegionStatus status = db.getRegionCompletedStatus(merged[0].getID());
+    EXPECT_EQ(2u, status.completedResourceCount);
+    EXPECT_EQ(1u, status.completedTileCount);
+
+    // Merging the same pack again neither duplicates the region nor its resources.
+    EXPECT_EQ(0u, db.mergeDatabase("test/fixtures/offline_database/side.db").size());
+    EXPECT_EQ(1u, db.listRegions().size());
+}
+
 TEST(OfflineDatabase, CreateRegionInfiniteMaxZoom) {
     using namespace mbgl;
 
@@ -627,31 +766,24 @@ static std::string databaseJournalMode(const std::string& path) {
     return stmt.get<std::string>(0);
 }
 
-static int databaseSyncMode(const std::string& path) {
-    mapbox::sqlite::Database db(path, mapbox::sqlite::ReadOnly);
-    mapbox::sqlite::Statement stmt = db.prepare("pragma synchronous");
-    stmt.run();
-    return stmt.get<int>(0);
-}
-
 TEST(OfflineDatabase, MigrateFromV2Schema) {
     using namespace mbgl;
 
     // v2.db is a v2 database containing a single offline region with a small number of resources.
 
-    deleteFile("test/fixtures/offline_database/v5.db");
-    writeFile("test/fixtures/offline_database/v5.db", util::read_file("test/fixtures/offline_database/v2.db"));
+    deleteFile("test/fixtures/offline_database/v7.db");
+    writeFile("test/fixtures/offline_database/v7.db", util::read_file("test/fixtures/offline_database/v2.db"));
 
     {
-        OfflineDatabase db("test/fixtures/offline_database/v5.db", 0);
+        OfflineDatabase db("test/fixtures/offline_database/v7.db", 0);
         auto regions = db.listRegions();
         for (auto& region : regions) {
             db.deleteRegion(std::move(region));
         }
     }
 
-    EXPECT_EQ(5, databaseUserVersion("test/fixtures/offline_database/v5.db"));
-    EXPECT_LT(databasePageCount("test/fixtures/offline_database/v5.db"),
+    EXPECT_EQ(7, databaseUserVersion("test/fixtures/offline_database/v7.db"));
+    EXPECT_LT(databasePageCount("test/fixtures/offline_database/v7.db"),
               databasePageCount("test/fixtures/offline_database/v2.db"));
 }
 
@@ -660,18 +792,18 @@ TEST(OfflineDatabase, MigrateFromV3Schema) {
 
     // v3.db is a v3 database, migrated from v2.
 
-    deleteFile("test/fixtures/offline_database/v5.db");
-    writeFile("test/fixtures/offline_database/v5.db", util::read_file("test/fixtures/offline_database/v3.db"));
+    deleteFile("test/fixtures/offline_database/v7.db");
+    writeFile("test/fixtures/offline_database/v7.db", util::read_file("test/fixtures/offline_database/v3.db"));
 
     {
-        OfflineDatabase db("test/fixtures/offline_database/v5.db", 0);
+        OfflineDatabase db("test/fixtures/offline_database/v7.db", 0);
         auto regions = db.listRegions();
         for (auto& region : regions) {
             db.deleteRegion(std::move(region));
         }
     }
 
-    EXPECT_EQ(5, databaseUserVersion("test/fixtures/offline_database/v5.db"));
+    EXPECT_EQ(7, databaseUserVersion("test/fixtures/offline_database/v7.db"));
 }
 
 TEST(OfflineDatabase, MigrateFromV4Schema) {
@@ -679,22 +811,19 @@ TEST(OfflineDatabase, MigrateFromV4Schema) {
 
     // v4.db is a v4 database, migrated from v2 & v3. This database used `journal_mode = WAL` and `synchronous = NORMAL`.
 
-    deleteFile("test/fixtures/offline_database/v5.db");
-    writeFile("test/fixtures/offline_database/v5.db", util::read_file("test/fixtures/offline_database/v4.db"));
+    deleteFile("test/fixtures/offline_database/v7.db");
+    writeFile("test/fixtures/offline_database/v7.db", util::read_file("test/fixtures/offline_database/v4.db"));
 
     {
-        OfflineDatabase db("test/fixtures/offline_database/v5.db", 0);
+        OfflineDatabase db("test/fixtures/offline_database/v7.db", 0);
         auto regions = db.listRegions();
         for (auto& region : regions) {
             db.deleteRegion(std::move(region));
         }
     }
 
-    EXPECT_EQ(5, databaseUserVersion("test/fixtures/offline_database/v5.db"));
-
-    // Journal mode should be DELETE after migration to v5.
-    EXPECT_EQ("delete", databaseJournalMode("test/fixtures/offline_database/v5.db"));
+    EXPECT_EQ(7, databaseUserVersion("test/fixtures/offline_database/v7.db"));
 
-    // Synchronous setting should be FULL (2) after migration to v5.
-    EXPECT_EQ(2, databaseSyncMode("test/fixtures/offline_database/v5.db"));
+    // Journal mode should be WAL after migration to v7.
+    EXPECT_EQ("wal", databaseJournalMode("test/fixtures/offline_database/v7.db"));
 }
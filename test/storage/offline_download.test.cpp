@@ -242,6 +242,62 @@ TEST(OfflineDownload, Activate) {
     test.loop.run();
 }
 
+TEST(OfflineDownload, AmbientPreload) {
+    OfflineTest test;
+    OfflineDownload download("http://127.0.0.1:3000/style.json", 1.0, test.db, test.fileSource);
+
+    test.fileSource.styleResponse = [&] (const Resource& resource) {
+        EXPECT_EQ("http://127.0.0.1:3000/style.json", resource.url);
+        return test.response("style.json");
+    };
+
+    test.fileSource.spriteImageResponse = [&] (const Resource& resource) {
+        EXPECT_EQ("http://127.0.0.1:3000/sprite.png", resource.url);
+        return test.response("sprite.png");
+    };
+
+    test.fileSource.spriteJSONResponse = [&] (const Resource& resource) {
+        EXPECT_EQ("http://127.0.0.1:3000/sprite.json", resource.url);
+        return test.response("sprite.json");
+    };
+
+    test.fileSource.glyphsResponse = [&] (const Resource&) {
+        return test.response("glyph.pbf");
+    };
+
+    test.fileSource.sourceResponse = [&] (const Resource& resource) {
+        EXPECT_EQ("http://127.0.0.1:3000/streets.json", resource.url);
+        return test.response("streets.json");
+    };
+
+    test.fileSource.tileResponse = [&] (const Resource&) {
+        ADD_FAILURE() << "Preloads must not request tiles";
+        return test.response("0-0-0.vector.pbf");
+    };
+
+    auto observer = std::make_unique<MockObserver>();
+
+    observer->statusChangedFn = [&] (OfflineRegionStatus status) {
+        if (status.complete() && status.downloadState == OfflineRegionDownloadState::Inactive) {
+            // 256 glyph ranges, style, source, sprite image, and sprite JSON
+            // — but no tiles.
+            EXPECT_EQ(260u, status.completedResourceCount);
+            EXPECT_EQ(0u, status.completedTileCount);
+
+            // Preloaded resources are served from the ambient cache.
+            EXPECT_TRUE(bool(test.db.get(Resource::style("http://127.0.0.1:3000/style.json"))));
+            EXPECT_TRUE(bool(test.db.get(Resource::source("http://127.0.0.1:3000/streets.json"))));
+
+            test.loop.stop();
+        }
+    };
+
+    download.setObserver(std::move(observer));
+    download.setState(OfflineRegionDownloadState::Active);
+
+    test.loop.run();
+}
+
 TEST(OfflineDownload, DoesNotFloodTheFileSourceWithRequests) {
     FakeFileSource fileSource;
     OfflineTest test;
@@ -262,7 +318,7 @@ TEST(OfflineDownload, DoesNotFloodTheFileSourceWithRequests) {
     fileSource.respond(Resource::Kind::Style, test.response("style.json"));
     test.loop.runOnce();
 
-    EXPECT_EQ(HTTPFileSource::maximumConcurrentRequests(), fileSource.requests.size());
+    EXPECT_EQ(OfflineDownload::maximumOverlappingRequests, fileSource.requests.size());
 }
 
 TEST(OfflineDownload, GetStatusNoResources) {
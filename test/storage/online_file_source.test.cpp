@@ -405,6 +405,45 @@ TEST(OnlineFileSource, TEST_REQUIRES_SERVER(RateLimitDefault)) {
     loop.run();
 }
 
+TEST(OnlineFileSource, TEST_REQUIRES_SERVER(TransferRateLimit)) {
+    util::RunLoop loop;
+    OnlineFileSource fs;
+
+    // "Hello World!" is 12 bytes; a 20 B/s budget leaves 8 bytes in the
+    // bucket after the first transfer, which admits a regular request but
+    // keeps a low-priority one below its half-burst admission threshold
+    // until the bucket refills.
+    fs.setTransferRateLimit(Resource::Unknown, 20);
+
+    Resource low { Resource::Unknown, "http://127.0.0.1:3000/test?low" };
+    low.priority = Resource::Priority::Low;
+
+    optional<TimePoint> regularCompleted;
+    std::unique_ptr<AsyncRequest> lowReq;
+    std::unique_ptr<AsyncRequest> regularReq;
+
+    auto first = fs.request({ Resource::Unknown, "http://127.0.0.1:3000/test?first" }, [&](Response res) {
+        EXPECT_EQ(nullptr, res.error);
+
+        lowReq = fs.request(low, [&](Response lowRes) {
+            EXPECT_EQ(nullptr, lowRes.error);
+            ASSERT_TRUE(bool(regularCompleted));
+            // The low-priority transfer had to wait out roughly half a burst
+            // period that the regular one did not.
+            EXPECT_GE(Clock::now() - *regularCompleted, Milliseconds(250));
+            loop.stop();
+        });
+
+        regularReq = fs.request({ Resource::Unknown, "http://127.0.0.1:3000/test?regular" }, [&](Response regularRes) {
+            EXPECT_EQ(nullptr, regularRes.error);
+            EXPECT_FALSE(bool(regularCompleted));
+            regularCompleted = Clock::now();
+        });
+    });
+
+    loop.run();
+}
+
 TEST(OnlineFileSource, ChangeAPIBaseURL){
     util::RunLoop loop;
     OnlineFileSource fs;
@@ -0,0 +1,99 @@
+#include <mbgl/test/util.hpp>
+#include <mbgl/test/stub_geometry_tile_feature.hpp>
+
+#include <mbgl/style/compiled_filter.hpp>
+
+using namespace mbgl;
+using namespace mbgl::style;
+
+using namespace std::string_literals;
+
+namespace {
+
+// A layer with a key table, like a vector tile layer. Features answer only
+// indexed lookups; a string lookup means the filter was not compiled against
+// the table.
+class KeyedStubLayer : public GeometryTileLayer {
+public:
+    KeyedStubLayer(std::vector<std::string> keys_)
+        : keys(std::move(keys_)) {
+    }
+
+    std::size_t featureCount() const override { return 0; }
+    std::unique_ptr<GeometryTileFeature> getFeature(std::size_t) const override { return nullptr; }
+    std::string getName() const override { return "keyed"; }
+
+    bool hasKeyTable() const override { return true; }
+
+    optional<uint32_t> getKeyIndex(const std::string& key) const override {
+        for (uint32_t i = 0; i < keys.size(); ++i) {
+            if (keys[i] == key) {
+                return i;
+            }
+        }
+        return {};
+    }
+
+private:
+    std::vector<std::string> keys;
+};
+
+class KeyedStubFeature : public GeometryTileFeature {
+public:
+    KeyedStubFeature(std::vector<optional<Value>> values_)
+        : values(std::move(values_)) {
+    }
+
+    FeatureType getType() const override { return FeatureType::Point; }
+    GeometryCollection getGeometries() const override { return {}; }
+
+    optional<Value> getValue(const std::string& key) const override {
+        ADD_FAILURE() << "string lookup of '" << key << "' on a layer with a key table";
+        return {};
+    }
+
+    optional<Value> getValueForKeyIndex(uint32_t keyIndex) const override {
+        return values.at(keyIndex);
+    }
+
+private:
+    std::vector<optional<Value>> values;
+};
+
+class UnkeyedStubLayer : public GeometryTileLayer {
+public:
+    std::size_t featureCount() const override { return 0; }
+    std::unique_ptr<GeometryTileFeature> getFeature(std::size_t) const override { return nullptr; }
+    std::string getName() const override { return "unkeyed"; }
+};
+
+} // namespace
+
+TEST(CompiledFilter, ResolvesKeysToTableIndices) {
+    const KeyedStubLayer layer {{ "name"s, "class"s }};
+    const Filter filter = EqualsFilter { "class", "park"s };
+    const CompiledFilter compiled { filter, layer };
+
+    EXPECT_TRUE(compiled(KeyedStubFeature {{ {}, { "park"s } }}));
+    EXPECT_FALSE(compiled(KeyedStubFeature {{ {}, { "road"s } }}));
+    EXPECT_FALSE(compiled(KeyedStubFeature {{ {}, {} }}));
+}
+
+TEST(CompiledFilter, AnswersAbsentKeysFromTheTable) {
+    const KeyedStubLayer layer {{ "name"s }};
+    const Filter has = HasFilter { "class" };
+    const Filter notHas = NotHasFilter { "class" };
+
+    // The key is not in the table, so the feature is never consulted.
+    EXPECT_FALSE(CompiledFilter(has, layer)(KeyedStubFeature {{ {} }}));
+    EXPECT_TRUE(CompiledFilter(notHas, layer)(KeyedStubFeature {{ {} }}));
+}
+
+TEST(CompiledFilter, FallsBackWithoutKeyTable) {
+    const UnkeyedStubLayer layer;
+    const Filter filter = EqualsFilter { "class", "park"s };
+    const CompiledFilter compiled { filter, layer };
+
+    EXPECT_TRUE(compiled(StubGeometryTileFeature { PropertyMap {{ "class", "park"s }} }));
+    EXPECT_FALSE(compiled(StubGeometryTileFeature { PropertyMap {{ "class", "road"s }} }));
+}
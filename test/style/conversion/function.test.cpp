@@ -4,6 +4,8 @@
 #include <mbgl/style/rapidjson_conversion.hpp>
 #include <mbgl/style/conversion/constant.hpp>
 #include <mbgl/style/conversion/function.hpp>
+#include <mbgl/style/conversion/property_value.hpp>
+#include <mbgl/style/conversion/data_driven_property_value.hpp>
 #include <mbgl/util/rapidjson.hpp>
 
 using namespace mbgl;
@@ -54,3 +56,70 @@ TEST(StyleConversion, Function) {
     ASSERT_FALSE(fn9);
     ASSERT_EQ("function base must be a number", error.message);
 }
+
+TEST(StyleConversion, FunctionConstantFolding) {
+    Error error;
+
+    auto parseValue = [&](const std::string& src) {
+        JSDocument doc;
+        doc.Parse<0>(src);
+        return convert<PropertyValue<float>, JSValue>(doc, error);
+    };
+
+    // A single-stop camera function produces its stop value at every zoom
+    // level, so it folds to a plain constant.
+    auto v1 = parseValue("{\"stops\":[[12,3]]}");
+    ASSERT_TRUE(bool(v1));
+    ASSERT_TRUE(v1->isConstant());
+    ASSERT_EQ(3.0f, v1->asConstant());
+
+    auto v2 = parseValue("{\"type\":\"interval\",\"stops\":[[12,3]]}");
+    ASSERT_TRUE(bool(v2));
+    ASSERT_TRUE(v2->isConstant());
+    ASSERT_EQ(3.0f, v2->asConstant());
+
+    auto v3 = parseValue("{\"stops\":[[12,3],[15,5]]}");
+    ASSERT_TRUE(bool(v3));
+    ASSERT_TRUE(v3->isCameraFunction());
+
+    auto parseDataDrivenValue = [&](const std::string& src) {
+        JSDocument doc;
+        doc.Parse<0>(src);
+        return convert<DataDrivenPropertyValue<float>, JSValue>(doc, error);
+    };
+
+    auto isConstant = [](const DataDrivenPropertyValue<float>& value) {
+        return value.match([](const float&) { return true; },
+                           [](const auto&) { return false; });
+    };
+
+    auto v4 = parseDataDrivenValue("{\"stops\":[[12,3]]}");
+    ASSERT_TRUE(bool(v4));
+    ASSERT_TRUE(isConstant(*v4));
+
+    // A single-stop source function is constant only when features outside
+    // the stop domain fall back to the same value.
+    auto v5 = parseDataDrivenValue(
+        "{\"property\":\"foo\",\"stops\":[[12,3]],\"default\":3}");
+    ASSERT_TRUE(bool(v5));
+    ASSERT_TRUE(isConstant(*v5));
+
+    auto v6 = parseDataDrivenValue(
+        "{\"property\":\"foo\",\"stops\":[[12,3]],\"default\":7}");
+    ASSERT_TRUE(bool(v6));
+    ASSERT_FALSE(isConstant(*v6));
+    ASSERT_TRUE(v6->isDataDriven());
+
+    auto v7 = parseDataDrivenValue("{\"property\":\"foo\",\"stops\":[[12,3]]}");
+    ASSERT_TRUE(bool(v7));
+    ASSERT_FALSE(isConstant(*v7));
+
+    auto v8 = parseDataDrivenValue(
+        "{\"property\":\"foo\",\"type\":\"categorical\",\"stops\":[[\"bar\",3]],\"default\":3}");
+    ASSERT_TRUE(bool(v8));
+    ASSERT_TRUE(isConstant(*v8));
+
+    auto v9 = parseDataDrivenValue("{\"property\":\"foo\",\"type\":\"identity\"}");
+    ASSERT_TRUE(bool(v9));
+    ASSERT_FALSE(isConstant(*v9));
+}
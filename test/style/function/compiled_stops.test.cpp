@@ -0,0 +1,50 @@
+#include <mbgl/test/util.hpp>
+
+#include <mbgl/style/function/compiled_stops.hpp>
+#include <mbgl/style/function/source_function.hpp>
+
+using namespace mbgl;
+using namespace mbgl::style;
+
+TEST(CompiledStops, ExponentialEquivalence) {
+    for (const float base : { 1.0f, 1.75f }) {
+        const ExponentialStops<float> stops {
+            {{ 0.0f, 0.0f }, { 10.0f, 100.0f }, { 25.0f, 150.0f }},
+            base
+        };
+        const CompiledExponentialStops<float> compiled { stops };
+
+        // Below, between, on, and above the stops.
+        for (const double z : { -1.0, 0.0, 4.2, 10.0, 17.9, 25.0, 30.0 }) {
+            EXPECT_FLOAT_EQ(*stops.evaluate(Value(z)), *compiled.evaluate(Value(z)));
+        }
+
+        EXPECT_EQ(*stops.evaluate(Value(std::string("x"))),
+                  *compiled.evaluate(Value(std::string("x"))));
+    }
+}
+
+TEST(CompiledStops, IntervalEquivalence) {
+    const IntervalStops<float> stops {
+        {{ 0.0f, 1.0f }, { 10.0f, 2.0f }, { 25.0f, 3.0f }}
+    };
+    const CompiledIntervalStops<float> compiled { stops };
+
+    for (const double z : { -1.0, 0.0, 4.2, 10.0, 17.9, 25.0, 30.0 }) {
+        EXPECT_EQ(*stops.evaluate(Value(z)), *compiled.evaluate(Value(z)));
+    }
+
+    EXPECT_FALSE(compiled.evaluate(Value(std::string("x"))));
+}
+
+TEST(CompiledStops, CompilesInterpolatingStopsOnly) {
+    SourceFunction<float>::Stops exponential = ExponentialStops<float> {{{ 0.0f, 1.0f }}};
+    SourceFunction<float>::Stops interval = IntervalStops<float> {{{ 0.0f, 1.0f }}};
+    SourceFunction<float>::Stops categorical = CategoricalStops<float> {{{ int64_t(1), 1.0f }}};
+    SourceFunction<float>::Stops identity = IdentityStops<float> {};
+
+    EXPECT_TRUE(bool(compileStops<float>(exponential)));
+    EXPECT_TRUE(bool(compileStops<float>(interval)));
+    EXPECT_FALSE(bool(compileStops<float>(categorical)));
+    EXPECT_FALSE(bool(compileStops<float>(identity)));
+}
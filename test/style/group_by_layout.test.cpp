@@ -14,7 +14,18 @@ TEST(GroupByLayout, Related) {
     layers.push_back(std::make_unique<LineLayer>("b", "source"));
     auto result = groupByLayout(layers);
     ASSERT_EQ(1u, result.size());
-    ASSERT_EQ(2u, result[0].size());
+    ASSERT_EQ(2u, result[0].layers.size());
+    ASSERT_EQ(layoutKey(*layers[0]), result[0].key);
+}
+
+TEST(GroupByLayout, RelatedPaintOnlyVariants) {
+    std::vector<std::unique_ptr<Layer>> layers;
+    layers.push_back(std::make_unique<LineLayer>("a", "source"));
+    layers.push_back(std::make_unique<LineLayer>("b", "source"));
+    layers[0]->as<LineLayer>()->setLineColor({ Color::red() });
+    auto result = groupByLayout(layers);
+    ASSERT_EQ(1u, result.size());
+    ASSERT_EQ(2u, result[0].layers.size());
 }
 
 TEST(GroupByLayout, UnrelatedType) {
@@ -131,3 +131,45 @@ TEST(UnevaluatedPaintProperty, EvaluateDataDrivenValue) {
     ASSERT_FALSE(evaluate(t1, 0ms).isConstant()) <<
         "A paint property transition to a data-driven evaluates immediately to the final value (see https://github.com/mapbox/mapbox-gl-native/issues/8237).";
 }
+
+TEST(UnevaluatedPaintProperty, NeedsEvaluation) {
+    UnevaluatedPaintProperty<PropertyValue<float>> constant {
+        PropertyValue<float>(1.0f),
+        UnevaluatedPaintProperty<PropertyValue<float>>(),
+        TransitionOptions(),
+        TimePoint::min()
+    };
+
+    // A zoom-constant value needs evaluating exactly once.
+    ASSERT_TRUE(constant.needsEvaluation());
+    evaluate(constant);
+    ASSERT_FALSE(constant.needsEvaluation());
+
+    TransitionOptions transition;
+    transition.duration = { 1000ms };
+
+    UnevaluatedPaintProperty<PropertyValue<float>> transitioning {
+        PropertyValue<float>(2.0f),
+        std::move(constant),
+        transition,
+        TimePoint::min()
+    };
+
+    // An active transition changes the result every frame until it ends.
+    ASSERT_TRUE(transitioning.needsEvaluation());
+    evaluate(transitioning, 500ms);
+    ASSERT_TRUE(transitioning.needsEvaluation());
+    evaluate(transitioning, 1500ms);
+    ASSERT_FALSE(transitioning.needsEvaluation());
+
+    UnevaluatedPaintProperty<PropertyValue<float>> zoomDependent {
+        PropertyValue<float>(CameraFunction<float>(ExponentialStops<float> {{{ 0.0f, 0.0f }, { 1.0f, 1.0f }}})),
+        UnevaluatedPaintProperty<PropertyValue<float>>(),
+        TransitionOptions(),
+        TimePoint::min()
+    };
+
+    // Camera functions follow the zoom and are never skipped.
+    evaluate(zoomDependent);
+    ASSERT_TRUE(zoomDependent.needsEvaluation());
+}
@@ -144,6 +144,58 @@ TEST(Source, LoadingCorrupt) {
     test.run();
 }
 
+TEST(Source, LoadingFromCachedTileset) {
+    SourceTest test;
+
+    Tileset cached;
+    cached.tiles = { "cached/{z}-{x}-{y}.vector.pbf" };
+    cached.zoomRange = { 0, 14 };
+
+    test.fileSource.tilesetResponse = [&] (const std::string& url) {
+        EXPECT_EQ("url", url);
+        return cached;
+    };
+
+    bool revalidated = false;
+    test.fileSource.sourceResponse = [&] (const Resource& resource) {
+        EXPECT_EQ("url", resource.url);
+        revalidated = true;
+        Response response;
+        response.data = std::make_unique<std::string>(
+            R"TILEJSON({ "tiles": [ "cached/{z}-{x}-{y}.vector.pbf" ], "maxzoom": 14 })TILEJSON");
+        return response;
+    };
+
+    bool stored = false;
+    test.fileSource.tilesetPut = [&] (const std::string& url, const Tileset& tileset, optional<Timestamp>) {
+        EXPECT_EQ("url", url);
+        EXPECT_EQ(cached.tiles, tileset.tiles);
+        stored = true;
+    };
+
+    // Fires synchronously from the cached manifest, then again once the
+    // revalidation response has been parsed.
+    test.observer.sourceLoaded = [&] (Source&) {
+        if (revalidated) {
+            test.end();
+        }
+    };
+
+    VectorSource source("source", "url");
+    source.baseImpl->setObserver(&test.observer);
+    source.baseImpl->loadDescription(test.fileSource);
+
+    // The cached manifest loads the source without waiting for the response.
+    EXPECT_TRUE(source.baseImpl->loaded);
+    ASSERT_TRUE(bool(source.getZoomRange()));
+    EXPECT_EQ(14u, source.getZoomRange()->max);
+
+    test.run();
+
+    // The revalidated manifest was written back to the cache.
+    EXPECT_TRUE(stored);
+}
+
 TEST(Source, RasterTileEmpty) {
     SourceTest test;
 
@@ -5,6 +5,7 @@
 #include <mbgl/style/source_impl.hpp>
 #include <mbgl/style/sources/vector_source.hpp>
 #include <mbgl/style/layer.hpp>
+#include <mbgl/style/layers/background_layer.hpp>
 #include <mbgl/util/io.hpp>
 #include <mbgl/util/run_loop.hpp>
 
@@ -78,9 +79,11 @@ TEST(Style, UnusedSourceActiveViaClassUpdate) {
     style.cascade(now, MapMode::Still);
     style.recalculate(0, now, MapMode::Still);
 
+    // Re-setting an identical style diffs onto the existing objects, so the
+    // source keeps its loaded description instead of starting over.
     unusedSource = style.getSource("unusedsource");
     EXPECT_TRUE(unusedSource);
-    EXPECT_FALSE(unusedSource->baseImpl->isLoaded());
+    EXPECT_TRUE(unusedSource->baseImpl->isLoaded());
 }
 
 TEST(Style, Properties) {
@@ -117,6 +120,61 @@ TEST(Style, Properties) {
     ASSERT_EQ(0, style.getDefaultPitch());
 }
 
+TEST(Style, SetJSONDiff) {
+    util::RunLoop loop;
+
+    StubFileSource fileSource;
+    Style style { fileSource, 1.0 };
+
+    style.setJSON(R"STYLE({
+        "version": 8,
+        "sources": {
+            "kept": { "type": "vector", "url": "mapbox://mapbox.mapbox-terrain-v2" },
+            "removed": { "type": "vector", "url": "mapbox://mapbox.mapbox-terrain-v2" }
+        },
+        "layers": [
+            { "id": "untouched", "type": "background", "paint": { "background-opacity": 0.5 } },
+            { "id": "repainted", "type": "background", "paint": { "background-opacity": 0.5 } },
+            { "id": "rebuilt", "type": "background", "minzoom": 5 }
+        ]
+    })STYLE");
+
+    const Source* keptSource = style.getSource("kept");
+    const Layer* untouchedLayer = style.getLayer("untouched");
+    const Layer* rebuiltLayer = style.getLayer("rebuilt");
+    ASSERT_TRUE(keptSource);
+    ASSERT_TRUE(untouchedLayer);
+    ASSERT_TRUE(rebuiltLayer);
+
+    style.setJSON(R"STYLE({
+        "version": 8,
+        "sources": {
+            "kept": { "type": "vector", "url": "mapbox://mapbox.mapbox-terrain-v2" }
+        },
+        "layers": [
+            { "id": "untouched", "type": "background", "paint": { "background-opacity": 0.5 } },
+            { "id": "repainted", "type": "background", "paint": { "background-opacity": 0.8 } },
+            { "id": "rebuilt", "type": "background", "minzoom": 7 }
+        ]
+    })STYLE");
+
+    // Identical definitions map onto the existing objects.
+    EXPECT_EQ(keptSource, style.getSource("kept"));
+    EXPECT_EQ(untouchedLayer, style.getLayer("untouched"));
+
+    // A paint-only delta carries the new values without a structural rebuild.
+    Layer* repainted = style.getLayer("repainted");
+    ASSERT_TRUE(repainted);
+    EXPECT_EQ(PropertyValue<float> { 0.8f },
+              repainted->as<BackgroundLayer>()->getBackgroundOpacity());
+
+    // A structural change (minzoom) replaces the layer object.
+    EXPECT_NE(rebuiltLayer, style.getLayer("rebuilt"));
+
+    // Sources absent from the incoming style are removed.
+    EXPECT_FALSE(style.getSource("removed"));
+}
+
 TEST(Style, DuplicateSource) {
     util::RunLoop loop;
 
@@ -134,3 +192,33 @@ TEST(Style, DuplicateSource) {
         // Expected
     }
 }
+
+TEST(Style, MoveLayer) {
+    util::RunLoop loop;
+
+    StubFileSource fileSource;
+    Style style { fileSource, 1.0 };
+
+    style.addLayer(std::make_unique<BackgroundLayer>("a"));
+    style.addLayer(std::make_unique<BackgroundLayer>("b"));
+    style.addLayer(std::make_unique<BackgroundLayer>("c"));
+
+    // Move to the top.
+    style.moveLayer("a");
+    auto layers = style.getLayers();
+    ASSERT_EQ(3u, layers.size());
+    EXPECT_EQ("b", layers[0]->getID());
+    EXPECT_EQ("c", layers[1]->getID());
+    EXPECT_EQ("a", layers[2]->getID());
+
+    // Move before another layer.
+    style.moveLayer("c", std::string("b"));
+    layers = style.getLayers();
+    EXPECT_EQ("c", layers[0]->getID());
+    EXPECT_EQ("b", layers[1]->getID());
+    EXPECT_EQ("a", layers[2]->getID());
+
+    // Moving an unknown layer changes nothing.
+    style.moveLayer("d");
+    ASSERT_EQ(3u, style.getLayers().size());
+}
@@ -2,6 +2,7 @@
 #include <mbgl/test/fixture_log_observer.hpp>
 
 #include <mbgl/style/parser.hpp>
+#include <mbgl/style/layers/background_layer.hpp>
 #include <mbgl/util/io.hpp>
 #include <mbgl/util/enum.hpp>
 #include <mbgl/util/string.hpp>
@@ -93,6 +94,38 @@ INSTANTIATE_TEST_CASE_P(StyleParser, StyleParserTest, ::testing::ValuesIn([] {
     return names;
 }()));
 
+TEST(StyleParser, RepeatedParsesYieldIndependentLayers) {
+    const std::string json = R"STYLE({
+        "version": 8,
+        "layers": [{
+            "id": "background",
+            "type": "background",
+            "paint": { "background-opacity": 0.5 }
+        }]
+    })STYLE";
+
+    style::Parser first;
+    ASSERT_FALSE(first.parse(json));
+    ASSERT_EQ(1u, first.layers.size());
+
+    // A second parse of the same JSON is served from the layer snapshot
+    // cache; it must still produce equivalent but independent layer objects.
+    style::Parser second;
+    ASSERT_FALSE(second.parse(json));
+    ASSERT_EQ(1u, second.layers.size());
+
+    ASSERT_EQ("background", second.layers[0]->getID());
+    ASSERT_NE(first.layers[0]->baseImpl.get(), second.layers[0]->baseImpl.get());
+
+    auto* firstLayer = first.layers[0]->as<style::BackgroundLayer>();
+    auto* secondLayer = second.layers[0]->as<style::BackgroundLayer>();
+    ASSERT_NE(nullptr, secondLayer);
+    ASSERT_EQ(firstLayer->getBackgroundOpacity(), secondLayer->getBackgroundOpacity());
+
+    secondLayer->setBackgroundOpacity({ 1.0f });
+    ASSERT_NE(firstLayer->getBackgroundOpacity(), secondLayer->getBackgroundOpacity());
+}
+
 TEST(StyleParser, FontStacks) {
     style::Parser parser;
     parser.parse(util::read_file("test/fixtures/style_parser/font_stacks.json"));
@@ -0,0 +1,60 @@
+#include <mbgl/text/distance_transform.hpp>
+
+#include <mbgl/test/util.hpp>
+
+using namespace mbgl;
+
+namespace {
+
+AlphaImage makeSquare(uint32_t imageSize, uint32_t squareSize) {
+    AlphaImage raster({ imageSize, imageSize });
+    const uint32_t offset = (imageSize - squareSize) / 2;
+    for (uint32_t y = offset; y < offset + squareSize; y++) {
+        for (uint32_t x = offset; x < offset + squareSize; x++) {
+            raster.data[y * imageSize + x] = 255;
+        }
+    }
+    return raster;
+}
+
+} // namespace
+
+TEST(DistanceTransform, EmptyRaster) {
+    AlphaImage raster({ 8, 8 });
+    AlphaImage sdf = transformRasterToSDF(raster, 3, 0.25);
+
+    ASSERT_EQ(raster.size, sdf.size);
+
+    // With no shape anywhere, every pixel is maximally outside.
+    for (uint32_t i = 0; i < 8 * 8; i++) {
+        EXPECT_EQ(0, sdf.data[i]);
+    }
+}
+
+TEST(DistanceTransform, SolidSquare) {
+    const uint32_t imageSize = 16;
+    AlphaImage sdf = transformRasterToSDF(makeSquare(imageSize, 8), 3, 0.25);
+
+    // The field decreases monotonically from the center of the square
+    // outwards along a scanline through the middle.
+    const uint32_t y = imageSize / 2;
+    for (uint32_t x = imageSize / 2; x < imageSize - 1; x++) {
+        EXPECT_GE(sdf.data[y * imageSize + x], sdf.data[y * imageSize + x + 1]);
+    }
+
+    // Pixels inside the shape encode above the cutoff; far outside pixels
+    // encode below it.
+    const uint8_t edge = 255 * (1 - 0.25);
+    EXPECT_GT(sdf.data[y * imageSize + y], edge);
+    EXPECT_LT(sdf.data[y * imageSize], edge);
+}
+
+TEST(DistanceTransform, EdgeValue) {
+    // An antialiased pixel with 50% coverage sits exactly on the shape's
+    // edge, so it encodes a distance of zero: 255 * (1 - cutoff).
+    AlphaImage raster({ 8, 8 });
+    raster.data[4 * 8 + 4] = 128;
+
+    AlphaImage sdf = transformRasterToSDF(raster, 3, 0.25);
+    EXPECT_NEAR(255 * (1 - 0.25), sdf.data[4 * 8 + 4], 1);
+}
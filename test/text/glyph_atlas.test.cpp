@@ -19,6 +19,7 @@ public:
     GlyphAtlas glyphAtlas{ { 32, 32 }, fileSource };
     GlyphPositionMap glyphPositions;
     GlyphRangeSet loadedRanges;
+    std::size_t notificationCount = 0;
 
     void run(const std::string& url, const FontStack& fontStack, const GlyphRangeSet& glyphRanges) {
         // Squelch logging.
@@ -50,6 +51,7 @@ public:
     virtual void onGlyphsAvailable(GlyphPositionMap positions, GlyphRangeSet _loadedRanges) {
         glyphPositions = std::move(positions);
         loadedRanges = std::move(_loadedRanges);
+        notificationCount++;
     }
 };
 
@@ -84,6 +86,40 @@ TEST(GlyphAtlas, LoadingSuccess) {
         {{0, 255}, {256, 511}});
 }
 
+TEST(GlyphAtlas, NotifiesPerRange) {
+    GlyphAtlasTest test;
+
+    test.fileSource.glyphsResponse = [&] (const Resource&) {
+        Response response;
+        response.data = std::make_shared<std::string>(util::read_file("test/fixtures/resources/glyphs.pbf"));
+        return response;
+    };
+
+    test.observer.glyphsError = [&] (const FontStack&, const GlyphRange&, std::exception_ptr) {
+        FAIL();
+        test.end();
+    };
+
+    test.observer.glyphsLoaded = [&] (const FontStack&, const GlyphRange&) {
+        if (!test.hasGlyphRanges({{"Test Stack"}}, {{0, 255}, {256, 511}}))
+            return;
+
+        // Each range delivered its own notification instead of the requestor
+        // hearing nothing until the whole dependency set was in, and the
+        // final one reports both ranges as loaded.
+        EXPECT_EQ(2u, test.notificationCount);
+        EXPECT_NE(test.loadedRanges.end(), test.loadedRanges.find({0, 255}));
+        EXPECT_NE(test.loadedRanges.end(), test.loadedRanges.find({256, 511}));
+
+        test.end();
+    };
+
+    test.run(
+        "test/fixtures/resources/glyphs.pbf",
+        {{"Test Stack"}},
+        {{0, 255}, {256, 511}});
+}
+
 TEST(GlyphAtlas, LoadingFail) {
     GlyphAtlasTest test;
 
@@ -275,3 +275,32 @@ TEST(getIconQuads, style) {
     }
 }
 
+TEST(QuantizedSymbolQuad, RoundTrip) {
+    SymbolQuad quad({ -8.25f, -6.5f }, { 7.75f, -6.5f }, { -8.25f, 5.0f }, { 7.5f, 5.0f },
+                    Rect<uint16_t>(4, 8, 16, 12), 0.0f, static_cast<float>(M_PI / 2),
+                    { 512.0f, 1024.0f }, 0.5f, 2.0f, WritingModeType::Horizontal);
+
+    QuantizedSymbolQuad quantized(quad);
+
+    // Corner offsets are stored in 1/64 px, matching the precision
+    // SymbolLayoutAttributes::vertex() writes to the GPU.
+    ASSERT_EQ(quantized.tl.x, -528);
+    ASSERT_EQ(quantized.tl.y, -416);
+    ASSERT_EQ(quantized.br.x, 480);
+    ASSERT_EQ(quantized.br.y, 320);
+    ASSERT_EQ(quantized.tl.x / 64.0f, quad.tl.x);
+    ASSERT_EQ(quantized.tl.y / 64.0f, quad.tl.y);
+    ASSERT_EQ(quantized.br.x / 64.0f, quad.br.x);
+    ASSERT_EQ(quantized.br.y / 64.0f, quad.br.y);
+
+    ASSERT_EQ(quantized.anchorPoint.x, 512);
+    ASSERT_EQ(quantized.anchorPoint.y, 1024);
+    ASSERT_EQ(quantized.tex, quad.tex);
+    ASSERT_EQ(quantized.minScale, 0.5f);
+    ASSERT_EQ(quantized.maxScale, 2.0f);
+
+    // Glyph angle is pre-encoded to the byte the vertex format uses.
+    ASSERT_EQ(quantized.glyphAngle, 64);
+    ASSERT_EQ(quantized.writingMode, WritingModeType::Horizontal);
+}
+
@@ -58,9 +58,10 @@ TEST(AnnotationTile, Issue8289) {
     auto collisionTile = std::make_unique<CollisionTile>(PlacementConfig());
 
     IndexedSubfeature subfeature { 0, "", "", 0 };
-    CollisionFeature feature(GeometryCoordinates(), Anchor(0, 0, 0, 0), -5, 5, -5, 5, 1, 0, style::SymbolPlacementType::Point, subfeature, false);
-    collisionTile->insertFeature(feature, 0, true);
-    collisionTile->placeFeature(feature, false, false);
+    CollisionBoxStore collisionBoxes;
+    CollisionFeature feature(collisionBoxes, GeometryCoordinates(), Anchor(0, 0, 0, 0), -5, 5, -5, 5, 1, 0, style::SymbolPlacementType::Point, subfeature, false);
+    collisionTile->insertFeature(feature, collisionBoxes, 0, true);
+    collisionTile->placeFeature(feature, collisionBoxes, false, false);
 
     tile.onPlacement(GeometryTile::PlacementResult {
         {},
@@ -79,9 +80,10 @@ TEST(AnnotationTile, Issue8289) {
     std::unordered_map<std::string, std::vector<Feature>> result;
     GeometryCoordinates queryGeometry {{ Point<int16_t>(0, 0) }};
     TransformState transformState;
+    std::unordered_map<std::string, const style::Layer*> layers;
     RenderedQueryOptions options;
 
-    tile.queryRenderedFeatures(result, queryGeometry, transformState, options);
+    tile.queryRenderedFeatures(result, queryGeometry, transformState, layers, 0, options);
 
     EXPECT_TRUE(result.empty());
 }
@@ -0,0 +1,100 @@
+#include <mbgl/test/util.hpp>
+
+#include <mbgl/tile/attribute_index.hpp>
+
+#include <memory>
+
+using namespace mbgl;
+
+namespace {
+
+class StubFeature : public GeometryTileFeature {
+public:
+    StubFeature(PropertyMap properties_)
+        : properties(std::move(properties_)) {
+    }
+
+    FeatureType getType() const override {
+        return FeatureType::Point;
+    }
+
+    optional<Value> getValue(const std::string& key) const override {
+        auto it = properties.find(key);
+        if (it == properties.end()) {
+            return {};
+        }
+        return it->second;
+    }
+
+    GeometryCollection getGeometries() const override {
+        return {};
+    }
+
+private:
+    const PropertyMap properties;
+};
+
+class StubLayer : public GeometryTileLayer {
+public:
+    std::size_t featureCount() const override {
+        return features.size();
+    }
+
+    std::unique_ptr<GeometryTileFeature> getFeature(std::size_t i) const override {
+        return std::make_unique<StubFeature>(features.at(i));
+    }
+
+    std::string getName() const override {
+        return "stub";
+    }
+
+    std::vector<PropertyMap> features;
+};
+
+} // namespace
+
+TEST(AttributeIndex, Indexes) {
+    AttributeIndex index({ "ref" });
+    EXPECT_TRUE(index.indexes("ref"));
+    EXPECT_FALSE(index.indexes("name"));
+}
+
+TEST(AttributeIndex, StringEquality) {
+    StubLayer layer;
+    layer.features.push_back({{ "ref", std::string("I-80") }});
+    layer.features.push_back({{ "ref", std::string("I-5") }});
+    layer.features.push_back({{ "name", std::string("I-80") }});
+
+    AttributeIndex index({ "ref" });
+    auto matches = index.query(layer, "road", "ref", std::string("I-80"));
+    ASSERT_EQ(1u, matches.size());
+    EXPECT_EQ(0u, matches[0]);
+
+    EXPECT_TRUE(index.query(layer, "road", "ref", std::string("I-15")).empty());
+}
+
+TEST(AttributeIndex, NumericTypesShareOneKeyspace) {
+    // Filter equality compares non-bool numerics through double, so a probe
+    // with any numeric type must find values stored as any other.
+    StubLayer layer;
+    layer.features.push_back({{ "lanes", int64_t(5) }});
+    layer.features.push_back({{ "lanes", uint64_t(5) }});
+    layer.features.push_back({{ "lanes", double(5) }});
+    layer.features.push_back({{ "lanes", std::string("5") }});
+    layer.features.push_back({{ "lanes", true }});
+
+    AttributeIndex index({ "lanes" });
+    EXPECT_EQ(3u, index.query(layer, "road", "lanes", int64_t(5)).size());
+    EXPECT_EQ(3u, index.query(layer, "road", "lanes", double(5)).size());
+    EXPECT_EQ(1u, index.query(layer, "road", "lanes", std::string("5")).size());
+    EXPECT_EQ(1u, index.query(layer, "road", "lanes", true).size());
+    EXPECT_TRUE(index.query(layer, "road", "lanes", false).empty());
+}
+
+TEST(AttributeIndex, SignedZero) {
+    StubLayer layer;
+    layer.features.push_back({{ "elevation", double(0) }});
+
+    AttributeIndex index({ "elevation" });
+    EXPECT_EQ(1u, index.query(layer, "contour", "elevation", double(-0.0)).size());
+}
@@ -0,0 +1,121 @@
+#include <mbgl/test/util.hpp>
+#include <mbgl/tile/binary_tile_data.hpp>
+
+#include <memory>
+
+using namespace mbgl;
+
+namespace {
+
+class StubFeature : public GeometryTileFeature {
+public:
+    StubFeature(FeatureType type_, optional<FeatureIdentifier> id_, PropertyMap properties_,
+                GeometryCollection geometry_)
+        : type(type_),
+          id(std::move(id_)),
+          properties(std::move(properties_)),
+          geometry(std::move(geometry_)) {
+    }
+
+    FeatureType getType() const override { return type; }
+    optional<Value> getValue(const std::string& key) const override {
+        auto it = properties.find(key);
+        return it != properties.end() ? optional<Value>(it->second) : optional<Value>();
+    }
+    const PropertyMap& getProperties() const override { return properties; }
+    optional<FeatureIdentifier> getID() const override { return id; }
+    GeometryCollection getGeometries() const override { return geometry; }
+
+private:
+    FeatureType type;
+    optional<FeatureIdentifier> id;
+    PropertyMap properties;
+    GeometryCollection geometry;
+};
+
+class StubLayer : public GeometryTileLayer {
+public:
+    StubLayer(std::string name_) : name(std::move(name_)) {
+    }
+
+    std::size_t featureCount() const override { return features.size(); }
+    std::unique_ptr<GeometryTileFeature> getFeature(std::size_t i) const override {
+        return std::make_unique<StubFeature>(features.at(i));
+    }
+    std::string getName() const override { return name; }
+
+    std::string name;
+    std::vector<StubFeature> features;
+};
+
+class StubData : public GeometryTileData {
+public:
+    std::unique_ptr<GeometryTileData> clone() const override {
+        return nullptr;
+    }
+    const GeometryTileLayer* getLayer(const std::string& name) const override {
+        for (const auto& layer : layers) {
+            if (layer.name == name) {
+                return &layer;
+            }
+        }
+        return nullptr;
+    }
+
+    std::vector<StubLayer> layers;
+};
+
+} // namespace
+
+TEST(BinaryTileData, RoundTrip) {
+    StubData stub;
+    stub.layers.emplace_back("roads");
+    stub.layers.back().features.emplace_back(
+        FeatureType::LineString,
+        optional<FeatureIdentifier>(FeatureIdentifier(uint64_t(7))),
+        PropertyMap {{ "class", std::string("motorway") }, { "oneway", true }},
+        GeometryCollection {{ { 0, 0 }, { 100, 200 }, { -5, 4096 } }});
+    stub.layers.emplace_back("poi");
+    stub.layers.back().features.emplace_back(
+        FeatureType::Point,
+        optional<FeatureIdentifier>(),
+        PropertyMap {{ "rank", uint64_t(3) }},
+        GeometryCollection {{ { 12, 34 } }});
+
+    const std::string encoded = BinaryTileData::encode(stub, { "roads", "poi", "missing" });
+    ASSERT_TRUE(BinaryTileData::isBinaryTile(encoded));
+
+    BinaryTileData tile(std::make_shared<const std::string>(encoded));
+
+    EXPECT_EQ(nullptr, tile.getLayer("missing"));
+
+    const GeometryTileLayer* roads = tile.getLayer("roads");
+    ASSERT_NE(nullptr, roads);
+    EXPECT_EQ("roads", roads->getName());
+    ASSERT_EQ(1u, roads->featureCount());
+
+    std::unique_ptr<GeometryTileFeature> road = roads->getFeature(0);
+    EXPECT_EQ(FeatureType::LineString, road->getType());
+    ASSERT_TRUE(bool(road->getID()));
+    EXPECT_EQ(FeatureIdentifier(uint64_t(7)), *road->getID());
+    EXPECT_EQ(optional<Value>(Value(std::string("motorway"))), road->getValue("class"));
+    EXPECT_EQ(optional<Value>(Value(true)), road->getValue("oneway"));
+    EXPECT_FALSE(bool(road->getValue("nonexistent")));
+    EXPECT_EQ(2u, road->getProperties().size());
+    EXPECT_EQ((GeometryCollection {{ { 0, 0 }, { 100, 200 }, { -5, 4096 } }}),
+              road->getGeometries());
+
+    const GeometryTileLayer* poi = tile.getLayer("poi");
+    ASSERT_NE(nullptr, poi);
+    ASSERT_EQ(1u, poi->featureCount());
+    std::unique_ptr<GeometryTileFeature> point = poi->getFeature(0);
+    EXPECT_EQ(FeatureType::Point, point->getType());
+    EXPECT_FALSE(bool(point->getID()));
+    EXPECT_EQ(optional<Value>(Value(uint64_t(3))), point->getValue("rank"));
+    EXPECT_EQ((GeometryCollection {{ { 12, 34 } }}), point->getGeometries());
+}
+
+TEST(BinaryTileData, RejectsNonBinaryPayload) {
+    EXPECT_FALSE(BinaryTileData::isBinaryTile(""));
+    EXPECT_FALSE(BinaryTileData::isBinaryTile("not a binary tile"));
+}
@@ -105,3 +105,38 @@ TEST(GeometryTileData, limitHoles3) {
     ASSERT_EQ(original.at(3), polygon.at(2));
 
 }
+
+TEST(GeometryTileData, SimplifyDropsNearCollinearPoints) {
+    const GeometryCoordinates simplified = simplify(
+        { {0, 0}, {10, 1}, {20, 0}, {30, -1}, {40, 0} }, 2.0);
+
+    // Every interior point is within tolerance of the chord.
+    ASSERT_EQ(2u, simplified.size());
+    ASSERT_EQ(GeometryCoordinate(0, 0), simplified.front());
+    ASSERT_EQ(GeometryCoordinate(40, 0), simplified.back());
+}
+
+TEST(GeometryTileData, SimplifyKeepsSignificantPoints) {
+    // The peak deviates far from the chord and survives; its flanks sit on
+    // (or within tolerance of) the chords to the peak and are dropped.
+    const GeometryCoordinates simplified = simplify(
+        { {0, 0}, {10, 25}, {20, 50}, {30, 24}, {40, 0} }, 2.0);
+
+    ASSERT_EQ((GeometryCoordinates { {0, 0}, {20, 50}, {40, 0} }), simplified);
+}
+
+TEST(GeometryTileData, SimplifyKeepsClosedRingsClosed) {
+    const GeometryCoordinates ring {
+        {0, 0}, {1, 20}, {0, 40}, {20, 41}, {40, 40}, {41, 20}, {40, 0}, {20, 1}, {0, 0}
+    };
+    const GeometryCoordinates simplified = simplify(ring, 2.0);
+
+    ASSERT_EQ(simplified.front(), simplified.back());
+    // The wobbly edge midpoints are within tolerance; the corners are not.
+    ASSERT_EQ(5u, simplified.size());
+}
+
+TEST(GeometryTileData, SimplifyLeavesShortLinesAlone) {
+    const GeometryCoordinates segment { {0, 0}, {3, 3} };
+    ASSERT_EQ(segment, simplify(segment, 100.0));
+}
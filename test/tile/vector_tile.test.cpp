@@ -13,6 +13,7 @@
 #include <mbgl/text/collision_tile.hpp>
 #include <mbgl/geometry/feature_index.hpp>
 #include <mbgl/annotation/annotation_manager.hpp>
+#include <mbgl/util/interned_string.hpp>
 
 #include <memory>
 
@@ -69,7 +70,7 @@ TEST(VectorTile, Issue7615) {
     // Simulate placement of a symbol layer.
     tile.onPlacement(GeometryTile::PlacementResult {
         {{
-            symbolLayer.getID(),
+            util::internString(symbolLayer.getID()),
             symbolBucket
         }},
         nullptr,
@@ -93,5 +94,23 @@ TEST(VectorTile, Issue8542) {
 
     // Query before data is set
     std::vector<Feature> result;
-    tile.querySourceFeatures(result, { { {"layer"} }, {} });
+    tile.querySourceFeatures(result, { { {"layer"} }, {} }, {});
+}
+
+TEST(VectorTile, RawDataSharedAcrossOverscale) {
+    VectorTileTest test;
+    VectorTile tile(OverscaledTileID(17, { 15, 16384, 16384 }), "source", test.updateParameters,
+                    test.tileset);
+
+    EXPECT_FALSE(tile.getRawData());
+
+    auto data = std::make_shared<const std::string>("");
+    tile.setData(data, {}, {});
+
+    // Another overscaled variant of the same canonical tile can be seeded
+    // from this buffer instead of fetching and decoding the same bytes.
+    EXPECT_EQ(data, tile.getRawData());
+
+    tile.setData(nullptr, {}, {});
+    EXPECT_FALSE(tile.getRawData());
 }
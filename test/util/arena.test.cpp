@@ -0,0 +1,74 @@
+#include <mbgl/test/util.hpp>
+
+#include <mbgl/util/arena.hpp>
+
+#include <cstring>
+#include <numeric>
+
+using namespace mbgl;
+
+TEST(Arena, AllocationsAreAlignedAndDisjoint) {
+    util::Arena arena;
+
+    char* a = static_cast<char*>(arena.allocate(13, 1));
+    double* d = static_cast<double*>(arena.allocate(sizeof(double), alignof(double)));
+
+    EXPECT_EQ(0u, reinterpret_cast<uintptr_t>(d) % alignof(double));
+
+    // Writing to one allocation must not touch the other.
+    std::memset(a, 0xAB, 13);
+    *d = 1.5;
+    EXPECT_EQ('\xAB', a[12]);
+    EXPECT_EQ(1.5, *d);
+}
+
+TEST(Arena, ResetRetainsChunkCapacity) {
+    util::Arena arena{1024};
+
+    for (std::size_t i = 0; i < 64; ++i) {
+        arena.allocate(128, 8);
+    }
+    const std::size_t warm = arena.capacity();
+    EXPECT_GT(warm, 0u);
+
+    // A second pass of the same shape must be satisfied from retained chunks.
+    arena.reset();
+    for (std::size_t i = 0; i < 64; ++i) {
+        arena.allocate(128, 8);
+    }
+    EXPECT_EQ(warm, arena.capacity());
+}
+
+TEST(Arena, OversizeAllocationsAreNotRetained) {
+    util::Arena arena{256};
+
+    char* big = static_cast<char*>(arena.allocate(4096, 8));
+    std::memset(big, 0, 4096);
+
+    // Dedicated oversize storage does not count towards retained capacity.
+    const std::size_t retained = arena.capacity();
+    arena.reset();
+    EXPECT_EQ(retained, arena.capacity());
+}
+
+TEST(Arena, BacksStandardContainers) {
+    util::Arena arena;
+
+    util::ArenaVector<int> values{util::ArenaAllocator<int>(arena)};
+    for (int i = 0; i < 1000; ++i) {
+        values.push_back(i);
+    }
+    EXPECT_EQ(499500, std::accumulate(values.begin(), values.end(), 0));
+}
+
+TEST(Arena, AllocatorsCompareEqualOnlyWithinAnArena) {
+    util::Arena a;
+    util::Arena b;
+
+    util::ArenaAllocator<int> ai(a);
+    util::ArenaAllocator<double> ad(a);
+    util::ArenaAllocator<int> bi(b);
+
+    EXPECT_TRUE(ai == ad);
+    EXPECT_TRUE(ai != bi);
+}
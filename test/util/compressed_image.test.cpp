@@ -0,0 +1,61 @@
+#include <mbgl/test/util.hpp>
+
+#include <mbgl/util/compressed_image.hpp>
+
+using namespace mbgl;
+
+namespace {
+
+// Builds a PKM 20 container with the given format code, size, and a
+// zero-filled data section of the correct length.
+std::string makePKM(uint16_t format, uint16_t width, uint16_t height, std::size_t blockSize) {
+    const uint16_t encodedWidth = (width + 3) & ~3;
+    const uint16_t encodedHeight = (height + 3) & ~3;
+
+    std::string data = "PKM 20";
+    for (uint16_t value : { format, encodedWidth, encodedHeight, width, height }) {
+        data.push_back(static_cast<char>(value >> 8));
+        data.push_back(static_cast<char>(value & 0xFF));
+    }
+    data.resize(data.size() + (encodedWidth / 4) * (encodedHeight / 4) * blockSize);
+    return data;
+}
+
+} // namespace
+
+TEST(CompressedImage, RecognizesPKM) {
+    EXPECT_TRUE(isCompressedImage(makePKM(1, 4, 4, 8)));
+    EXPECT_FALSE(isCompressedImage("PKM 10"));
+    EXPECT_FALSE(isCompressedImage("\x89PNG"));
+    EXPECT_FALSE(isCompressedImage(""));
+}
+
+TEST(CompressedImage, DecodeETC2RGB) {
+    CompressedImage image =
+        decodeCompressedImage(std::make_shared<std::string>(makePKM(1, 6, 10, 8)));
+    EXPECT_EQ(CompressedImage::Format::ETC2RGB8, image.format);
+    EXPECT_EQ(6u, image.size.width);
+    EXPECT_EQ(10u, image.size.height);
+    EXPECT_EQ(2u * 3u * 8u, image.dataSize);
+}
+
+TEST(CompressedImage, DecodeETC2RGBA) {
+    CompressedImage image =
+        decodeCompressedImage(std::make_shared<std::string>(makePKM(3, 512, 512, 16)));
+    EXPECT_EQ(CompressedImage::Format::ETC2RGBA8, image.format);
+    EXPECT_EQ(512u, image.size.width);
+    EXPECT_EQ(128u * 128u * 16u, image.dataSize);
+}
+
+TEST(CompressedImage, RejectsUnsupportedFormat) {
+    // 0 is ETC1, which we don't accept even though it shares the container.
+    EXPECT_THROW(decodeCompressedImage(std::make_shared<std::string>(makePKM(0, 4, 4, 8))),
+                 std::runtime_error);
+}
+
+TEST(CompressedImage, RejectsTruncatedData) {
+    std::string data = makePKM(1, 16, 16, 8);
+    data.resize(data.size() - 1);
+    EXPECT_THROW(decodeCompressedImage(std::make_shared<std::string>(data)),
+                 std::runtime_error);
+}
@@ -55,3 +55,22 @@ TEST(HttpRetry, ExpiredNotSet) {
     // No expires header set
     ASSERT_EQ(Duration::max(), expirationTimeout({}, 0));
 }
+
+TEST(HttpRetry, RevalidationWindow) {
+    // A zero window keeps already-stale resources revalidating immediately.
+    ASSERT_EQ(Duration::zero(), revalidationTimeout(Duration::zero(), Duration::zero()));
+
+    // Within the window, revalidation is deferred to the window edge, plus up
+    // to 1/8th jitter.
+    Duration deferred = revalidationTimeout(Duration::zero(), Seconds(8));
+    ASSERT_GE(deferred, Seconds(8));
+    ASSERT_LE(deferred, Seconds(9));
+
+    // Non-immediate timers are jittered but never shortened.
+    Duration jittered = revalidationTimeout(Seconds(80), Duration::zero());
+    ASSERT_GE(jittered, Seconds(80));
+    ASSERT_LE(jittered, Seconds(90));
+
+    // No timer, no revalidation.
+    ASSERT_EQ(Duration::max(), revalidationTimeout(Duration::max(), Seconds(8)));
+}
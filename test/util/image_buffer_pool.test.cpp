@@ -0,0 +1,50 @@
+#include <mbgl/test/util.hpp>
+
+#include <mbgl/util/image_buffer_pool.hpp>
+
+#include <algorithm>
+
+using namespace mbgl;
+
+TEST(ImageBufferPool, RecyclesTileSizedBuffers) {
+    util::shrinkImageBufferPool();
+
+    const std::size_t bytes = 512 * 512 * 4;
+    auto buffer = util::allocateImageBuffer(bytes);
+    uint8_t* pointer = buffer.get();
+    buffer[0] = 255;
+    buffer.reset();
+
+    auto recycled = util::allocateImageBuffer(bytes);
+    EXPECT_EQ(pointer, recycled.get());
+}
+
+TEST(ImageBufferPool, BuffersAreZeroFilled) {
+    util::shrinkImageBufferPool();
+
+    const std::size_t bytes = 512 * 512 * 4;
+
+    // Dirty a buffer and return it to the pool.
+    {
+        auto buffer = util::allocateImageBuffer(bytes);
+        std::fill(buffer.get(), buffer.get() + bytes, 255);
+    }
+
+    // The recycled buffer must look like a fresh value-initialized one.
+    auto buffer = util::allocateImageBuffer(bytes);
+    for (std::size_t i = 0; i < bytes; i++) {
+        ASSERT_EQ(0, buffer[i]);
+    }
+}
+
+TEST(ImageBufferPool, ShrinkReleasesIdleBuffers) {
+    util::shrinkImageBufferPool();
+
+    const std::size_t bytes = 512 * 512 * 4;
+    util::allocateImageBuffer(bytes).reset();
+    util::shrinkImageBufferPool();
+
+    // Allocation keeps working after a shrink.
+    auto buffer = util::allocateImageBuffer(bytes);
+    EXPECT_NE(nullptr, buffer.get());
+}
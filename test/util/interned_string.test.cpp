@@ -0,0 +1,47 @@
+#include <mbgl/test/util.hpp>
+#include <mbgl/util/interned_string.hpp>
+
+using namespace mbgl;
+
+TEST(InternedString, EqualStringsShareHandles) {
+    const util::StringID a = util::internString("background");
+    const util::StringID b = util::internString("background");
+    const util::StringID c = util::internString("water");
+
+    EXPECT_NE(0u, a);
+    EXPECT_EQ(a, b);
+    EXPECT_NE(a, c);
+}
+
+TEST(InternedString, RoundTrip) {
+    const util::StringID handle = util::internString("round-trip");
+    const std::string& resolved = util::internedString(handle);
+
+    EXPECT_EQ("round-trip", resolved);
+
+    // The reference is stable: interning more strings must not invalidate it.
+    util::internString("round-trip-2");
+    EXPECT_EQ("round-trip", resolved);
+    EXPECT_EQ(&resolved, &util::internedString(handle));
+}
+
+TEST(InternedString, CachedStringIDResolvesOnce) {
+    util::CachedStringID cache;
+    EXPECT_EQ(util::internString("cached"), cache.get("cached"));
+    EXPECT_EQ(cache.get("cached"), cache.get("cached"));
+}
+
+TEST(InternedString, CachedStringIDCopyStartsUnresolved) {
+    util::CachedStringID cache;
+    cache.get("original");
+
+    // A copied cache re-resolves against its holder's own string, mirroring
+    // Layer::Impl clones that receive a new id after the copy.
+    util::CachedStringID copy(cache);
+    EXPECT_EQ(util::internString("renamed"), copy.get("renamed"));
+
+    util::CachedStringID assigned;
+    assigned.get("other");
+    assigned = cache;
+    EXPECT_EQ(util::internString("renamed"), assigned.get("renamed"));
+}
@@ -0,0 +1,51 @@
+#include <mbgl/test/util.hpp>
+
+#include <mbgl/util/itoa.hpp>
+
+#include <cstdint>
+#include <limits>
+
+using namespace mbgl;
+
+TEST(Itoa, Unsigned) {
+    EXPECT_EQ("0", util::itoa(0u));
+    EXPECT_EQ("9", util::itoa(9u));
+    EXPECT_EQ("10", util::itoa(10u));
+    EXPECT_EQ("99", util::itoa(99u));
+    EXPECT_EQ("100", util::itoa(100u));
+    EXPECT_EQ("101", util::itoa(101u));
+    EXPECT_EQ("999", util::itoa(999u));
+    EXPECT_EQ("1000", util::itoa(1000u));
+    EXPECT_EQ("123456789", util::itoa(123456789u));
+    EXPECT_EQ("4294967295", util::itoa(std::numeric_limits<uint32_t>::max()));
+}
+
+TEST(Itoa, Signed) {
+    EXPECT_EQ("0", util::itoa(0));
+    EXPECT_EQ("1", util::itoa(1));
+    EXPECT_EQ("-1", util::itoa(-1));
+    EXPECT_EQ("-9", util::itoa(-9));
+    EXPECT_EQ("-10", util::itoa(-10));
+    EXPECT_EQ("-100", util::itoa(-100));
+    EXPECT_EQ("32768", util::itoa(32768));
+    EXPECT_EQ("-32768", util::itoa(-32768));
+    EXPECT_EQ("2147483647", util::itoa(std::numeric_limits<int32_t>::max()));
+    EXPECT_EQ("-2147483648", util::itoa(std::numeric_limits<int32_t>::min()));
+}
+
+TEST(Itoa, MatchesToString) {
+    for (uint32_t i = 0; i < 100000; i++) {
+        ASSERT_EQ(std::to_string(i), util::itoa(i));
+    }
+    // Exercise carries across each power of ten.
+    uint32_t magnitude = 10;
+    while (true) {
+        ASSERT_EQ(std::to_string(magnitude - 1), util::itoa(magnitude - 1));
+        ASSERT_EQ(std::to_string(magnitude), util::itoa(magnitude));
+        ASSERT_EQ(std::to_string(magnitude + 1), util::itoa(magnitude + 1));
+        if (magnitude > std::numeric_limits<uint32_t>::max() / 10) {
+            break;
+        }
+        magnitude *= 10;
+    }
+}
@@ -0,0 +1,150 @@
+#include <mbgl/test/util.hpp>
+#include <mbgl/util/mat4.hpp>
+
+using namespace mbgl;
+
+namespace {
+
+// Deterministic pseudo-random doubles in [-10, 10], so the suite exercises
+// the SIMD paths with varied values but failures reproduce exactly.
+class ValueSequence {
+public:
+    double next() {
+        state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+        return (double((state >> 11) & 0xFFFFFFFF) / double(0xFFFFFFFF)) * 20.0 - 10.0;
+    }
+
+    mat4 nextMatrix() {
+        mat4 m;
+        for (auto& value : m) {
+            value = next();
+        }
+        return m;
+    }
+
+private:
+    uint64_t state = 0x2545F4914F6CDD1DULL;
+};
+
+// Plain scalar references for the operations with vectorized backends. The
+// SIMD paths order their operations to match scalar rounding, so the
+// tolerance mostly guards against a backend diverging from that contract.
+mat4 referenceMultiply(const mat4& a, const mat4& b) {
+    mat4 out;
+    for (int i = 0; i < 4; i++) {
+        for (int j = 0; j < 4; j++) {
+            out[i * 4 + j] = b[i * 4] * a[j] + b[i * 4 + 1] * a[4 + j] +
+                             b[i * 4 + 2] * a[8 + j] + b[i * 4 + 3] * a[12 + j];
+        }
+    }
+    return out;
+}
+
+vec4 referenceTransform(const vec4& a, const mat4& m) {
+    vec4 out;
+    for (int j = 0; j < 4; j++) {
+        out[j] = m[j] * a[0] + m[4 + j] * a[1] + m[8 + j] * a[2] + m[12 + j] * a[3];
+    }
+    return out;
+}
+
+constexpr double tolerance = 1e-9;
+
+} // namespace
+
+TEST(Mat4, MultiplyMatchesScalarReference) {
+    ValueSequence values;
+
+    for (int iteration = 0; iteration < 100; iteration++) {
+        const mat4 a = values.nextMatrix();
+        const mat4 b = values.nextMatrix();
+
+        mat4 out;
+        matrix::multiply(out, a, b);
+
+        const mat4 expected = referenceMultiply(a, b);
+        for (int i = 0; i < 16; i++) {
+            EXPECT_NEAR(expected[i], out[i], tolerance) << "element " << i;
+        }
+    }
+}
+
+TEST(Mat4, MultiplyIdentity) {
+    ValueSequence values;
+    const mat4 a = values.nextMatrix();
+
+    mat4 id;
+    matrix::identity(id);
+
+    mat4 out;
+    matrix::multiply(out, a, id);
+    EXPECT_EQ(a, out);
+
+    matrix::multiply(out, id, a);
+    EXPECT_EQ(a, out);
+}
+
+TEST(Mat4, TransformMat4MatchesScalarReference) {
+    ValueSequence values;
+
+    for (int iteration = 0; iteration < 100; iteration++) {
+        const mat4 m = values.nextMatrix();
+        const vec4 a = { { values.next(), values.next(), values.next(), values.next() } };
+
+        vec4 out;
+        matrix::transformMat4(out, a, m);
+
+        const vec4 expected = referenceTransform(a, m);
+        for (int i = 0; i < 4; i++) {
+            EXPECT_NEAR(expected[i], out[i], tolerance) << "component " << i;
+        }
+    }
+}
+
+TEST(Mat4, TransformMat4Aliased) {
+    ValueSequence values;
+    const mat4 m = values.nextMatrix();
+
+    vec4 p = { { values.next(), values.next(), values.next(), values.next() } };
+    const vec4 expected = referenceTransform(p, m);
+
+    // Writing into the input vector must be safe.
+    matrix::transformMat4(p, p, m);
+    for (int i = 0; i < 4; i++) {
+        EXPECT_NEAR(expected[i], p[i], tolerance) << "component " << i;
+    }
+}
+
+TEST(Mat4, InvertRoundTrip) {
+    ValueSequence values;
+
+    for (int iteration = 0; iteration < 100; iteration++) {
+        mat4 a = values.nextMatrix();
+
+        mat4 inverted;
+        if (matrix::invert(inverted, a)) {
+            // A randomly filled matrix is almost surely invertible; a
+            // singular draw is skipped rather than failed.
+            continue;
+        }
+
+        mat4 product;
+        matrix::multiply(product, a, inverted);
+
+        mat4 id;
+        matrix::identity(id);
+        for (int i = 0; i < 16; i++) {
+            // The round trip compounds error from both operations; the bound
+            // is correspondingly looser than the single-operation tolerance.
+            EXPECT_NEAR(id[i], product[i], 1e-6) << "element " << i;
+        }
+    }
+}
+
+TEST(Mat4, InvertSingular) {
+    mat4 singular;
+    singular.fill(0.0);
+
+    mat4 out;
+    EXPECT_TRUE(matrix::invert(out, singular));
+}
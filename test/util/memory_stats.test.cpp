@@ -0,0 +1,74 @@
+#include <mbgl/util/memory_stats.hpp>
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+using namespace mbgl;
+
+// The counters are process-wide and other tests in this binary allocate
+// through them, so every expectation here is phrased as a delta against a
+// baseline taken at the start of the test.
+
+TEST(MemoryStats, RecordsAllocationsAndDeallocations) {
+    const uint64_t baseline = util::getMemoryStats().forCategory(MemoryCategory::Buckets);
+
+    util::recordMemoryAllocation(MemoryCategory::Buckets, 1024);
+    EXPECT_EQ(baseline + 1024, util::getMemoryStats().forCategory(MemoryCategory::Buckets));
+
+    util::recordMemoryDeallocation(MemoryCategory::Buckets, 1024);
+    EXPECT_EQ(baseline, util::getMemoryStats().forCategory(MemoryCategory::Buckets));
+}
+
+TEST(MemoryStats, PeakPersistsUntilReset) {
+    util::recordMemoryAllocation(MemoryCategory::Atlases, 4096);
+    util::recordMemoryDeallocation(MemoryCategory::Atlases, 4096);
+
+    const MemoryStats stats = util::getMemoryStats();
+    EXPECT_GE(stats.peakForCategory(MemoryCategory::Atlases),
+              stats.forCategory(MemoryCategory::Atlases) + 4096);
+
+    util::resetMemoryPeaks();
+
+    const MemoryStats reset = util::getMemoryStats();
+    EXPECT_EQ(reset.forCategory(MemoryCategory::Atlases),
+              reset.peakForCategory(MemoryCategory::Atlases));
+}
+
+TEST(MemoryStats, TrackedMemoryFollowsOwnerLifetime) {
+    const uint64_t baseline = util::getMemoryStats().forCategory(MemoryCategory::Atlases);
+
+    {
+        util::TrackedMemory tracked { MemoryCategory::Atlases, 512 };
+        EXPECT_EQ(baseline + 512, util::getMemoryStats().forCategory(MemoryCategory::Atlases));
+
+        tracked.update(2048);
+        EXPECT_EQ(baseline + 2048, util::getMemoryStats().forCategory(MemoryCategory::Atlases));
+    }
+
+    EXPECT_EQ(baseline, util::getMemoryStats().forCategory(MemoryCategory::Atlases));
+}
+
+TEST(MemoryStats, TrackingAllocatorAttributesContainerStorage) {
+    const uint64_t baseline = util::getMemoryStats().forCategory(MemoryCategory::Buckets);
+
+    {
+        std::vector<uint32_t, util::TrackingAllocator<uint32_t, MemoryCategory::Buckets>> v;
+        v.reserve(100);
+        EXPECT_GE(util::getMemoryStats().forCategory(MemoryCategory::Buckets),
+                  baseline + 100 * sizeof(uint32_t));
+    }
+
+    EXPECT_EQ(baseline, util::getMemoryStats().forCategory(MemoryCategory::Buckets));
+}
+
+TEST(MemoryStats, SetOverwritesSampledCategory) {
+    util::setMemoryUsage(MemoryCategory::Database, 123456);
+    EXPECT_EQ(123456u, util::getMemoryStats().forCategory(MemoryCategory::Database));
+
+    util::setMemoryUsage(MemoryCategory::Database, 1000);
+    EXPECT_EQ(1000u, util::getMemoryStats().forCategory(MemoryCategory::Database));
+
+    // Lowering the current value must not lower the recorded peak.
+    EXPECT_GE(util::getMemoryStats().peakForCategory(MemoryCategory::Database), 123456u);
+}
@@ -26,7 +26,7 @@ public:
         }
         return {};
     };
-    std::unordered_map<std::string,Value> getProperties() const override { return properties; };
+    const PropertyMap& getProperties() const override { return properties; };
     optional<FeatureIdentifier> getID() const override { return id; };
     GeometryCollection getGeometries() const override { return geometry; };
     
@@ -0,0 +1,32 @@
+#include <mbgl/util/performance_counters.hpp>
+
+#include <gtest/gtest.h>
+
+using namespace mbgl;
+
+// The counters are process-wide and other tests in this binary run through
+// the instrumented code paths, so every expectation here is phrased as a
+// delta against a baseline taken at the start of the test.
+
+TEST(PerformanceCounters, CountsCacheLookupsPerKind) {
+    const PerformanceCounters baseline = util::getPerformanceCounters();
+
+    util::recordCacheLookup(CacheKind::TileCache, true);
+    util::recordCacheLookup(CacheKind::TileCache, false);
+    util::recordCacheLookup(CacheKind::TileCache, false);
+    util::recordCacheLookup(CacheKind::ParseCache, true);
+
+    const PerformanceCounters counters = util::getPerformanceCounters();
+    EXPECT_EQ(baseline.hitsFor(CacheKind::TileCache) + 1, counters.hitsFor(CacheKind::TileCache));
+    EXPECT_EQ(baseline.missesFor(CacheKind::TileCache) + 2, counters.missesFor(CacheKind::TileCache));
+    EXPECT_EQ(baseline.hitsFor(CacheKind::ParseCache) + 1, counters.hitsFor(CacheKind::ParseCache));
+    EXPECT_EQ(baseline.missesFor(CacheKind::ParseCache), counters.missesFor(CacheKind::ParseCache));
+}
+
+TEST(PerformanceCounters, QueueDepthIsAGauge) {
+    util::setWorkerQueueDepth(7);
+    EXPECT_EQ(7u, util::getPerformanceCounters().workerQueueDepth);
+
+    util::setWorkerQueueDepth(0);
+    EXPECT_EQ(0u, util::getPerformanceCounters().workerQueueDepth);
+}
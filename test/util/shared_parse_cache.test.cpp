@@ -0,0 +1,82 @@
+#include <mbgl/test/util.hpp>
+
+#include <mbgl/util/shared_parse_cache.hpp>
+
+#include <string>
+#include <vector>
+
+using namespace mbgl;
+
+namespace {
+
+std::shared_ptr<const std::string> makeSource(const char* data) {
+    return std::make_shared<const std::string>(data);
+}
+
+} // namespace
+
+TEST(SharedParseCache, ReturnsSameParseForSameBuffer) {
+    util::SharedParseCache<std::vector<int>> cache;
+    auto source = makeSource("payload");
+
+    EXPECT_EQ(nullptr, cache.get("http://example.com/a", { source }));
+
+    auto parsed = std::make_shared<const std::vector<int>>(std::vector<int>{ 1, 2, 3 });
+    cache.put("http://example.com/a", { source }, parsed);
+
+    EXPECT_EQ(parsed, cache.get("http://example.com/a", { source }));
+}
+
+TEST(SharedParseCache, MissesWhenBufferChanges) {
+    util::SharedParseCache<std::vector<int>> cache;
+    auto source = makeSource("payload");
+
+    cache.put("http://example.com/a", { source },
+              std::make_shared<const std::vector<int>>());
+
+    // Same bytes, different buffer: a refreshed response must re-parse.
+    EXPECT_EQ(nullptr, cache.get("http://example.com/a", { makeSource("payload") }));
+}
+
+TEST(SharedParseCache, MissesWhenBufferExpires) {
+    util::SharedParseCache<std::vector<int>> cache;
+    auto source = makeSource("payload");
+
+    cache.put("http://example.com/a", { source },
+              std::make_shared<const std::vector<int>>());
+    source.reset();
+
+    EXPECT_EQ(nullptr, cache.get("http://example.com/a", { makeSource("payload") }));
+}
+
+TEST(SharedParseCache, ValidatesAllSources) {
+    util::SharedParseCache<std::vector<int>> cache;
+    auto image = makeSource("image");
+    auto json = makeSource("json");
+
+    auto parsed = std::make_shared<const std::vector<int>>();
+    cache.put("http://example.com/sprite", { image, json }, parsed);
+
+    EXPECT_EQ(parsed, cache.get("http://example.com/sprite", { image, json }));
+    EXPECT_EQ(nullptr, cache.get("http://example.com/sprite", { image, makeSource("json") }));
+    EXPECT_EQ(nullptr, cache.get("http://example.com/sprite", { image }));
+}
+
+TEST(SharedParseCache, EvictsLeastRecentlyUsed) {
+    util::SharedParseCache<std::vector<int>> cache(2);
+    auto a = makeSource("a");
+    auto b = makeSource("b");
+    auto c = makeSource("c");
+
+    cache.put("a", { a }, std::make_shared<const std::vector<int>>());
+    cache.put("b", { b }, std::make_shared<const std::vector<int>>());
+
+    // Touch "a" so "b" becomes the eviction candidate.
+    EXPECT_NE(nullptr, cache.get("a", { a }));
+
+    cache.put("c", { c }, std::make_shared<const std::vector<int>>());
+
+    EXPECT_NE(nullptr, cache.get("a", { a }));
+    EXPECT_EQ(nullptr, cache.get("b", { b }));
+    EXPECT_NE(nullptr, cache.get("c", { c }));
+}
@@ -0,0 +1,104 @@
+#include <mbgl/test/util.hpp>
+
+#include <mbgl/util/small_vector.hpp>
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+using namespace mbgl;
+
+TEST(SmallVector, StaysInlineUpToCapacity) {
+    util::SmallVector<int, 4> v{1, 2, 3};
+    EXPECT_EQ(3u, v.size());
+    EXPECT_EQ(4u, v.capacity());
+
+    const int* inlineData = v.data();
+    v.push_back(4);
+    EXPECT_EQ(inlineData, v.data());
+
+    // The fifth element spills to the heap.
+    v.push_back(5);
+    EXPECT_NE(inlineData, v.data());
+    EXPECT_EQ(5, v.back());
+    EXPECT_EQ(1, v.front());
+}
+
+TEST(SmallVector, HandlesNonTrivialElements) {
+    util::SmallVector<std::string, 2> v;
+    for (int i = 0; i < 100; ++i) {
+        v.push_back("element " + std::to_string(i));
+    }
+    EXPECT_EQ(100u, v.size());
+    EXPECT_EQ("element 0", v[0]);
+    EXPECT_EQ("element 99", v[99]);
+
+    v.erase(v.begin() + 1, v.begin() + 99);
+    EXPECT_EQ(2u, v.size());
+    EXPECT_EQ("element 99", v[1]);
+
+    v.clear();
+    EXPECT_TRUE(v.empty());
+}
+
+TEST(SmallVector, CopyAndMove) {
+    util::SmallVector<std::string, 2> heap{"a", "b", "c"};
+    util::SmallVector<std::string, 2> copy(heap);
+    EXPECT_TRUE(copy == heap);
+
+    // Moving heap contents steals the buffer and empties the source.
+    util::SmallVector<std::string, 2> moved(std::move(heap));
+    EXPECT_TRUE(moved == copy);
+    EXPECT_TRUE(heap.empty());
+
+    // Moving inline contents moves the elements.
+    util::SmallVector<std::string, 2> small{"x"};
+    util::SmallVector<std::string, 2> movedSmall(std::move(small));
+    EXPECT_EQ(1u, movedSmall.size());
+    EXPECT_EQ("x", movedSmall[0]);
+}
+
+TEST(SmallVector, InsertAndErase) {
+    util::SmallVector<int, 2> v{1, 4};
+    const std::vector<int> middle{2, 3};
+    v.insert(v.begin() + 1, middle.begin(), middle.end());
+    EXPECT_TRUE(v == (util::SmallVector<int, 2>{1, 2, 3, 4}));
+
+    v.erase(v.begin());
+    EXPECT_EQ(2, v.front());
+
+    // Appending one of the vector's own elements survives reallocation.
+    util::SmallVector<int, 2> self{10, 20};
+    self.push_back(self[0]);
+    EXPECT_EQ(10, self[2]);
+}
+
+TEST(SmallVector, WorksWithStandardAlgorithms) {
+    util::SmallVector<int, 2> v{5, 1, 4, 2, 3};
+    std::sort(v.begin(), v.end());
+    EXPECT_TRUE(v == (util::SmallVector<int, 2>{1, 2, 3, 4, 5}));
+
+    std::nth_element(v.begin(), v.begin() + 2, v.end(), std::greater<int>());
+    EXPECT_EQ(3, v[2]);
+}
+
+TEST(SmallVector, Nesting) {
+    util::SmallVector<util::SmallVector<int, 4>, 1> nested;
+    nested.emplace_back();
+    nested.back().push_back(1);
+    nested.push_back({2, 3});
+    EXPECT_EQ(2u, nested.size());
+    EXPECT_EQ(3, nested[1][1]);
+
+    auto moved = std::move(nested);
+    EXPECT_EQ(1, moved[0][0]);
+    EXPECT_EQ(2, moved[1][0]);
+}
+
+TEST(SmallVector, Swap) {
+    util::SmallVector<int, 2> small{1};
+    util::SmallVector<int, 2> big{1, 2, 3, 4, 5};
+    swap(small, big);
+    EXPECT_EQ(5u, small.size());
+    EXPECT_EQ(1u, big.size());
+}
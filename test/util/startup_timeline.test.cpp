@@ -0,0 +1,64 @@
+#include <mbgl/test/util.hpp>
+
+#include <mbgl/util/startup_timeline.hpp>
+
+#include <thread>
+
+using namespace mbgl;
+
+// The startup timeline is process-wide, so each test resets it first to get a
+// clean epoch.
+
+TEST(StartupTimeline, StartsEmpty) {
+    util::resetStartupTimeline();
+
+    const StartupTimeline timeline = util::getStartupTimeline();
+    EXPECT_FALSE(timeline.isRecorded(StartupMilestone::FileSourceReady));
+    EXPECT_FALSE(timeline.isRecorded(StartupMilestone::StyleParsed));
+    EXPECT_FALSE(timeline.isRecorded(StartupMilestone::FirstTileRequested));
+    EXPECT_FALSE(timeline.isRecorded(StartupMilestone::FirstTileParsed));
+    EXPECT_FALSE(timeline.isRecorded(StartupMilestone::FirstTileUploaded));
+    EXPECT_FALSE(timeline.isRecorded(StartupMilestone::FirstFrame));
+}
+
+TEST(StartupTimeline, FirstCallWins) {
+    util::resetStartupTimeline();
+
+    util::markStartupMilestone(StartupMilestone::StyleParsed);
+    const Duration first = util::getStartupTimeline().forMilestone(StartupMilestone::StyleParsed);
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    util::markStartupMilestone(StartupMilestone::StyleParsed);
+
+    const StartupTimeline timeline = util::getStartupTimeline();
+    EXPECT_TRUE(timeline.isRecorded(StartupMilestone::StyleParsed));
+    EXPECT_EQ(first, timeline.forMilestone(StartupMilestone::StyleParsed));
+}
+
+TEST(StartupTimeline, MilestonesAreOrderedByWallClock) {
+    util::resetStartupTimeline();
+
+    util::markStartupMilestone(StartupMilestone::FirstTileRequested);
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    util::markStartupMilestone(StartupMilestone::FirstTileParsed);
+
+    const StartupTimeline timeline = util::getStartupTimeline();
+    EXPECT_GE(timeline.forMilestone(StartupMilestone::FirstTileRequested), Duration::zero());
+    EXPECT_GT(timeline.forMilestone(StartupMilestone::FirstTileParsed),
+              timeline.forMilestone(StartupMilestone::FirstTileRequested));
+}
+
+TEST(StartupTimeline, ResetClearsMilestonesAndRestartsEpoch) {
+    util::resetStartupTimeline();
+
+    util::markStartupMilestone(StartupMilestone::FirstFrame);
+    ASSERT_TRUE(util::getStartupTimeline().isRecorded(StartupMilestone::FirstFrame));
+
+    util::resetStartupTimeline();
+    EXPECT_FALSE(util::getStartupTimeline().isRecorded(StartupMilestone::FirstFrame));
+
+    // A milestone marked right after a reset is close to the new epoch.
+    util::markStartupMilestone(StartupMilestone::FirstFrame);
+    EXPECT_LT(util::getStartupTimeline().forMilestone(StartupMilestone::FirstFrame),
+              std::chrono::seconds(1));
+}
@@ -0,0 +1,47 @@
+#include <mbgl/util/tile_latency.hpp>
+
+#include <gtest/gtest.h>
+
+using namespace mbgl;
+
+TEST(TileLatency, RecordsIntoPowerOfTwoBuckets) {
+    util::resetTileLatencyStats();
+
+    util::recordTileStageLatency(TileStage::Layout, Milliseconds(0));
+    util::recordTileStageLatency(TileStage::Layout, Milliseconds(1));
+    util::recordTileStageLatency(TileStage::Layout, Milliseconds(3));
+    util::recordTileStageLatency(TileStage::Layout, Milliseconds(100));
+
+    const TileLatencyStats stats = util::getTileLatencyStats();
+    const TileStageHistogram& layout = stats.forStage(TileStage::Layout);
+
+    EXPECT_EQ(4u, layout.samples);
+    EXPECT_EQ(104u, layout.totalMilliseconds);
+    EXPECT_EQ(100u, layout.maxMilliseconds);
+    EXPECT_EQ(1u, layout.counts[0]); // < 1ms
+    EXPECT_EQ(1u, layout.counts[1]); // [1, 2)
+    EXPECT_EQ(1u, layout.counts[2]); // [2, 4)
+    EXPECT_EQ(1u, layout.counts[7]); // [64, 128)
+
+    // Other stages are untouched.
+    EXPECT_EQ(0u, stats.forStage(TileStage::Network).samples);
+}
+
+TEST(TileLatency, OverflowGoesToLastBucket) {
+    util::resetTileLatencyStats();
+
+    util::recordTileStageLatency(TileStage::Upload, Milliseconds(1 << 20));
+
+    const TileStageHistogram& upload =
+        util::getTileLatencyStats().forStage(TileStage::Upload);
+    EXPECT_EQ(1u, upload.counts[TileStageHistogram::bucketCount - 1]);
+}
+
+TEST(TileLatency, Reset) {
+    util::recordTileStageLatency(TileStage::Placement, Milliseconds(5));
+    util::resetTileLatencyStats();
+
+    const TileLatencyStats stats = util::getTileLatencyStats();
+    EXPECT_EQ(0u, stats.forStage(TileStage::Placement).samples);
+    EXPECT_EQ(0u, stats.forStage(TileStage::Placement).totalMilliseconds);
+}
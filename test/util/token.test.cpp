@@ -48,3 +48,29 @@ TEST(Token, replaceTokens) {
         return "";
     }));
 }
+
+TEST(Token, TokenTemplate) {
+    auto apply = [](const std::string& source) {
+        return mbgl::util::TokenTemplate(source).apply([](const std::string& token) -> std::string {
+            if (token == "name") return "14th St NW";
+            if (token == "num") return "500";
+            return "";
+        });
+    };
+
+    EXPECT_EQ("literal", apply("literal"));
+    EXPECT_EQ("14th St NW", apply("{name}"));
+    EXPECT_EQ("", apply("{notset}"));
+    EXPECT_EQ("500 m", apply("{num} m"));
+    EXPECT_EQ("500 to 14th St NW", apply("{num} to {name}"));
+
+    // Malformed templates follow the replaceTokens grammar: unterminated or
+    // nested braces are literal text.
+    EXPECT_EQ("{unterminated", apply("{unterminated"));
+    EXPECT_EQ("{14th St NW", apply("{{name}"));
+    EXPECT_EQ("a { b", apply("a { b"));
+
+    EXPECT_FALSE(mbgl::util::TokenTemplate("plain text").hasTokens());
+    EXPECT_FALSE(mbgl::util::TokenTemplate("{unterminated").hasTokens());
+    EXPECT_TRUE(mbgl::util::TokenTemplate("{name}").hasTokens());
+}
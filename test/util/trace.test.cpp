@@ -0,0 +1,65 @@
+#include <mbgl/util/trace.hpp>
+
+#include <gtest/gtest.h>
+
+#include <thread>
+
+using namespace mbgl;
+
+TEST(Trace, RecordsNothingWhenStopped) {
+    util::startTracing();
+    util::stopTracing();
+
+    EXPECT_FALSE(util::isTracing());
+    util::recordTraceEvent("ignored", Clock::now(), Clock::now());
+
+    util::startTracing();
+    const std::string json = util::stopTracing();
+    EXPECT_EQ(std::string::npos, json.find("ignored"));
+}
+
+TEST(Trace, SerializesCompleteEventsWithArguments) {
+    util::startTracing();
+    EXPECT_TRUE(util::isTracing());
+
+    const TimePoint start = Clock::now();
+    util::recordTraceEvent("layout", start, start + Milliseconds(5), 7, "14/8192/5461=>14");
+
+    const std::string json = util::stopTracing();
+    EXPECT_FALSE(util::isTracing());
+
+    EXPECT_NE(std::string::npos, json.find("\"name\":\"layout\""));
+    EXPECT_NE(std::string::npos, json.find("\"ph\":\"X\""));
+    EXPECT_NE(std::string::npos, json.find("\"dur\":5000"));
+    EXPECT_NE(std::string::npos, json.find("\"tile\":\"14/8192/5461=>14\""));
+    EXPECT_NE(std::string::npos, json.find("\"correlation\":7"));
+}
+
+TEST(Trace, ScopeRecordsOnDestruction) {
+    util::startTracing();
+
+    {
+        util::TraceScope scope("scoped work");
+    }
+
+    const std::string json = util::stopTracing();
+    EXPECT_NE(std::string::npos, json.find("\"name\":\"scoped work\""));
+}
+
+TEST(Trace, CollectsEventsAcrossThreads) {
+    util::startTracing();
+
+    util::recordTraceEvent("main thread work", Clock::now(), Clock::now());
+
+    std::thread worker([] {
+        util::recordTraceEvent("worker thread work", Clock::now(), Clock::now());
+    });
+    worker.join();
+
+    const std::string json = util::stopTracing();
+
+    // Each thread contributes its own track, announced by a metadata event.
+    EXPECT_NE(std::string::npos, json.find("\"name\":\"main thread work\""));
+    EXPECT_NE(std::string::npos, json.find("\"name\":\"worker thread work\""));
+    EXPECT_NE(std::string::npos, json.find("\"ph\":\"M\""));
+}
@@ -0,0 +1,33 @@
+#include <mbgl/test/util.hpp>
+
+#include <mbgl/util/utf.hpp>
+
+using namespace mbgl;
+
+TEST(UTF, Conversion) {
+    EXPECT_EQ(u"", util::utf8_to_utf16::convert(""));
+    EXPECT_EQ(u"Market Street", util::utf8_to_utf16::convert("Market Street"));
+    EXPECT_EQ(u"Mapbox © 2017", util::utf8_to_utf16::convert("Mapbox © 2017"));
+    EXPECT_EQ(u"中华人民共和国", util::utf8_to_utf16::convert("中华人民共和国"));
+    EXPECT_EQ(u"日本橋三丁目", util::utf8_to_utf16::convert("日本橋三丁目"));
+    EXPECT_EQ(u"서울특별시", util::utf8_to_utf16::convert("서울특별시"));
+
+    // Codepoints beyond the BMP become surrogate pairs.
+    EXPECT_EQ(std::u16string({ 0xD83D, 0xDE00 }), util::utf8_to_utf16::convert("\xF0\x9F\x98\x80"));
+
+    // Strings long enough to cross the sixteen-byte ASCII fast path boundary
+    // in the middle of a multi-byte sequence.
+    EXPECT_EQ(u"AAAAAAAAAAAAAAA中BBBBBBBBBBBBBBB",
+              util::utf8_to_utf16::convert("AAAAAAAAAAAAAAA中BBBBBBBBBBBBBBB"));
+}
+
+TEST(UTF, MalformedInput) {
+    // Malformed sequences decode to the replacement character instead of
+    // throwing: a corrupt label must not abort tile layout.
+    EXPECT_EQ(u"�", util::utf8_to_utf16::convert("\x80"));                 // stray continuation
+    EXPECT_EQ(u"a�b", util::utf8_to_utf16::convert("a\xC3" "b"));          // truncated 2-byte
+    EXPECT_EQ(u"�", util::utf8_to_utf16::convert("\xE4\xB8"));             // truncated 3-byte
+    EXPECT_EQ(u"�", util::utf8_to_utf16::convert("\xC0\xAF"));             // overlong encoding
+    EXPECT_EQ(u"�", util::utf8_to_utf16::convert("\xED\xA0\x80"));         // encoded surrogate
+    EXPECT_EQ(u"�", util::utf8_to_utf16::convert("\xF4\x90\x80\x80"));     // beyond U+10FFFF
+}
@@ -42,6 +42,51 @@ TEST(WorkQueue, push) {
     loop.run();
 }
 
+TEST(WorkQueue, backpressure) {
+    RunLoop loop;
+
+    WorkQueue queue { 4 };
+
+    int saturations = 0;
+    int releases = 0;
+
+    queue.setBackpressureCallback([&](bool saturated) {
+        if (saturated) {
+            ++saturations;
+        } else {
+            ++releases;
+        }
+    });
+
+    auto work = [] {};
+
+    // Crossing the capacity signals exactly once, even when pushing further.
+    queue.push(work);
+    queue.push(work);
+    queue.push(work);
+    ASSERT_EQ(0, saturations);
+    queue.push(work);
+    ASSERT_EQ(1, saturations);
+    queue.push(work);
+    queue.push(work);
+    ASSERT_EQ(1, saturations);
+    ASSERT_EQ(0, releases);
+
+    // Draining to half the capacity releases the backpressure.
+    loop.runOnce();
+    ASSERT_EQ(1, releases);
+
+    // The cycle can repeat once released.
+    queue.push(work);
+    queue.push(work);
+    queue.push(work);
+    queue.push(work);
+    ASSERT_EQ(2, saturations);
+
+    loop.runOnce();
+    ASSERT_EQ(2, releases);
+}
+
 TEST(WorkQueue, cancel) {
     RunLoop loop;
 